@@ -1797,11 +1797,27 @@ static future<> do_batch_write(service::storage_proxy& proxy,
     });
     if (!needs_lwt) {
         // Do a normal write, without LWT:
-        std::vector<mutation> mutations;
-        mutations.reserve(mutation_builders.size());
+        // Multiple mutations may be destined for the same partition, adding
+        // or deleting different items of one partition. Merge them into one
+        // mutation per partition, so each partition is written with a single
+        // replica write, and hand all of them to one mutate() call, which
+        // dispatches the writes to the different partitions in parallel,
+        // under a shared timeout and permit.
+        std::unordered_map<schema_decorated_key, mutation, schema_decorated_key_hash, schema_decorated_key_equal>
+            key_mutations(1, schema_decorated_key_hash{}, schema_decorated_key_equal{});
         api::timestamp_type now = api::new_timestamp();
         for (auto& b : mutation_builders) {
-            mutations.push_back(b.second.build(b.first, now));
+            auto dk = dht::decorate_key(*b.first, b.second.pk());
+            auto m = b.second.build(b.first, now);
+            auto [it, added] = key_mutations.try_emplace(schema_decorated_key{b.first, dk}, std::move(m));
+            if (!added) {
+                it->second.apply(std::move(m));
+            }
+        }
+        std::vector<mutation> mutations;
+        mutations.reserve(key_mutations.size());
+        for (auto& e : key_mutations) {
+            mutations.push_back(std::move(e.second));
         }
         return proxy.mutate(std::move(mutations),
                 db::consistency_level::LOCAL_QUORUM,
@@ -668,30 +668,50 @@ struct shard_iterator {
 
     utils::UUID table;
     utils::UUID threshold;
+    // The key under which the replicas keep the suspended querier of the
+    // previous get_records poll of this iterator (see querier_cache). We
+    // carry it in the opaque iterator string so the next poll can resume
+    // the cached querier instead of paying full read path setup again.
+    // Null for iterators which have not performed a read yet.
+    utils::UUID query_uuid;
     shard_id shard;
     bool inclusive;
 
     shard_iterator(const sstring&);
 
-    shard_iterator(utils::UUID t, shard_id i, utils::UUID th, bool inclusive)
+    shard_iterator(utils::UUID t, shard_id i, utils::UUID th, bool inclusive, utils::UUID query_uuid = utils::UUID())
         : table(t)
         , threshold(th)
+        , query_uuid(query_uuid)
         , shard(i)
         , inclusive(inclusive)
     {}
     friend std::ostream& operator<<(std::ostream& os, const shard_iterator& id) {
-        return os << (id.inclusive ? inclusive_marker : exclusive_marker) << std::hex
+        os << (id.inclusive ? inclusive_marker : exclusive_marker) << std::hex
             << id.table
             << ':' << id.threshold
-            << ':' << id.shard
             ;
+        // Only emitted when set, so iterators handed out by
+        // get_shard_iterator keep the old, shorter format.
+        if (id.query_uuid != utils::UUID()) {
+            os << ':' << id.query_uuid;
+        }
+        return os << ':' << id.shard;
     }
 };
 
-shard_iterator::shard_iterator(const sstring& s) 
+// The optional query_uuid segment can be told apart from the shard segment
+// by its first character: a UUID starts with a (lowercase) hex digit, while
+// the shard segment starts with shard_id::marker ('H').
+shard_iterator::shard_iterator(const sstring& s)
     : table(s.substr(1, uuid_str_length))
     , threshold(s.substr(2 + uuid_str_length, uuid_str_length))
-    , shard(s.substr(3 + 2 * uuid_str_length))
+    , query_uuid(s.at(3 + 2 * uuid_str_length) == shard_id::marker
+        ? utils::UUID()
+        : utils::UUID(s.substr(3 + 2 * uuid_str_length, uuid_str_length)))
+    , shard(s.at(3 + 2 * uuid_str_length) == shard_id::marker
+        ? s.substr(3 + 2 * uuid_str_length)
+        : s.substr(4 + 3 * uuid_str_length))
     , inclusive(s.at(0) == inclusive_marker)
 {
     if (s.at(0) != inclusive_marker && s.at(0) != exclusive_marker) {
@@ -890,11 +910,18 @@ future<executor::request_return_type> executor::get_records(client_state& client
     if (opts.postimage()) {
         ++mul;
     }
+    // Resume the querier the replicas kept suspended after the previous poll
+    // of this iterator, if any; otherwise pick a fresh key under which the
+    // replicas will cache the querier for the next poll. This is the same
+    // mechanism CQL paging uses, so an aggressively polling consumer doesn't
+    // pay full read path setup on every GetRecords call.
+    auto query_uuid = iter.query_uuid != utils::UUID() ? iter.query_uuid : utils::make_random_uuid();
+    auto first_page = query::is_first_page(iter.query_uuid == utils::UUID());
     auto command = ::make_lw_shared<query::read_command>(schema->id(), schema->version(), partition_slice, _proxy.get_max_result_size(partition_slice),
-            query::row_limit(limit * mul));
+            query::row_limit(limit * mul), query::partition_limit::max, gc_clock::now(), std::nullopt, query_uuid, first_page);
 
     return _proxy.query(schema, std::move(command), std::move(partition_ranges), cl, service::storage_proxy::coordinator_query_options(default_timeout(), std::move(permit), client_state)).then(
-            [this, schema, partition_slice = std::move(partition_slice), selection = std::move(selection), start_time = std::move(start_time), limit, key_names = std::move(key_names), attr_names = std::move(attr_names), type, iter, high_ts] (service::storage_proxy::coordinator_query_result qr) mutable {       
+            [this, schema, partition_slice = std::move(partition_slice), selection = std::move(selection), start_time = std::move(start_time), limit, key_names = std::move(key_names), attr_names = std::move(attr_names), type, iter, high_ts, query_uuid] (service::storage_proxy::coordinator_query_result qr) mutable {
         cql3::selection::result_set_builder builder(*selection, gc_clock::now(), cql_serialization_format::latest());
         query::result_view::consume(*qr.query_result, partition_slice, cql3::selection::result_set_builder::visitor(builder, *schema, *selection));
 
@@ -1011,7 +1038,7 @@ future<executor::request_return_type> executor::get_records(client_state& client
 
         if (nrecords != 0) {
             // #9642. Set next iterators threshold to > last
-            shard_iterator next_iter(iter.table, iter.shard, *timestamp, false);
+            shard_iterator next_iter(iter.table, iter.shard, *timestamp, false, query_uuid);
             // Note that here we unconditionally return NextShardIterator,
             // without checking if maybe we reached the end-of-shard. If the
             // shard did end, then the next read will have nrecords == 0 and
@@ -1024,7 +1051,7 @@ future<executor::request_return_type> executor::get_records(client_state& client
         // ugh. figure out if we are and end-of-shard
         auto normal_token_owners = _proxy.get_token_metadata_ptr()->count_normal_token_owners();
         
-        return _sdks.cdc_current_generation_timestamp({ normal_token_owners }).then([this, iter, high_ts, start_time, ret = std::move(ret)](db_clock::time_point ts) mutable {
+        return _sdks.cdc_current_generation_timestamp({ normal_token_owners }).then([this, iter, high_ts, start_time, query_uuid, ret = std::move(ret)](db_clock::time_point ts) mutable {
             auto& shard = iter.shard;            
 
             if (shard.time < ts && ts < high_ts) {
@@ -1033,12 +1060,15 @@ future<executor::request_return_type> executor::get_records(client_state& client
                 // "set to null". Our test test_streams_closed_read
                 // confirms that by "null" they meant not set at all.
             } else {
-                // We could have return the same iterator again, but we did
+                // We could have returned the same iterator again, but we did
                 // a search from it until high_ts and found nothing, so we
-                // can also start the next search from high_ts.
-                // TODO: but why? It's simpler just to leave the iterator be.
-                shard_iterator next_iter(iter.table, iter.shard, utils::UUID_gen::min_time_UUID(high_ts.time_since_epoch()), true);
-                rjson::add(ret, "NextShardIterator", iter);
+                // can also start the next search from high_ts. This also
+                // means the next poll starts exactly where the querier the
+                // replicas cached under query_uuid stopped, so a caught-up
+                // consumer resumes it instead of re-reading from the old
+                // threshold on every poll.
+                shard_iterator next_iter(iter.table, iter.shard, utils::UUID_gen::min_time_UUID(high_ts.time_since_epoch()), true, query_uuid);
+                rjson::add(ret, "NextShardIterator", next_iter);
             }
             _stats.api_operations.get_records_latency.add(std::chrono::steady_clock::now() - start_time);
             return make_ready_future<executor::request_return_type>(make_jsonable(std::move(ret)));
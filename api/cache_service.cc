@@ -22,6 +22,7 @@
 #include "cache_service.hh"
 #include "api/api-doc/cache_service.json.hh"
 #include "column_family.hh"
+#include "db/cache_warmup.hh"
 
 namespace api {
 using namespace json;
@@ -139,10 +140,12 @@ void set_cache_service(http_context& ctx, routes& r) {
         return make_ready_future<json::json_return_type>(json_void());
     });
 
-    cs::save_caches.set(r, [](std::unique_ptr<request> req) {
-        // TBD
-        unimplemented();
-        return make_ready_future<json::json_return_type>(json_void());
+    cs::save_caches.set(r, [&ctx](std::unique_ptr<request> req) {
+        return ctx.db.invoke_on_all([] (database& db) {
+            return db::save_row_cache_hot_sets(db);
+        }).then([] {
+            return make_ready_future<json::json_return_type>(json_void());
+        });
     });
 
     cs::get_key_capacity.set(r, [] (std::unique_ptr<request> req) {
@@ -0,0 +1,86 @@
+/*
+ * Copyright (C) 2021-present ScyllaDB
+ */
+
+/*
+ * This file is part of Scylla.
+ *
+ * Scylla is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Scylla is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Scylla.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "api/api-doc/cpu_profiler.json.hh"
+#include "api/cpu_profiler.hh"
+
+#include <seastar/http/exception.hh>
+#include <seastar/core/future-util.hh>
+#include <seastar/core/smp.hh>
+
+#include "utils/cpu_profiler.hh"
+
+namespace api {
+
+namespace hf = httpd::cpu_profiler_json;
+
+void set_cpu_profiler(http_context& ctx, routes& r) {
+
+    hf::start_cpu_profiler.set(r, [](std::unique_ptr<request> req) {
+        auto period_param = req->get_query_param("period_ms");
+        auto period_ms = period_param.empty() ? 10 : atoi(period_param.c_str());
+        if (period_ms <= 0) {
+            throw bad_param_exception("period_ms must be a positive integer");
+        }
+        return smp::invoke_on_all([period_ms] {
+            utils::get_local_cpu_profiler().start(std::chrono::milliseconds(period_ms));
+        }).then([] {
+            return make_ready_future<json::json_return_type>(json::json_void());
+        });
+    });
+
+    hf::stop_cpu_profiler.set(r, [](std::unique_ptr<request> req) {
+        return smp::invoke_on_all([] {
+            utils::get_local_cpu_profiler().stop();
+        }).then([] {
+            return make_ready_future<json::json_return_type>(json::json_void());
+        });
+    });
+
+    hf::get_cpu_profile.set(r, [](std::unique_ptr<request> req) {
+        return map_reduce(smp::all_cpus(), [] (unsigned cpu) {
+            return smp::submit_to(cpu, [] {
+                auto prof = utils::get_local_cpu_profiler().drain();
+                std::vector<sstring> lines;
+                lines.reserve(prof.stacks.size() + 1);
+                for (auto& s : prof.stacks) {
+                    sstring frames;
+                    for (auto addr : s.frames) {
+                        frames += format(" 0x{:x}", addr);
+                    }
+                    lines.push_back(format("{} {} {}{}", this_shard_id(), s.sched_group_name, s.count, frames));
+                }
+                if (prof.dropped) {
+                    lines.push_back(format("{} dropped {}", this_shard_id(), prof.dropped));
+                }
+                return lines;
+            });
+        }, std::vector<sstring>(), [] (std::vector<sstring> acc, std::vector<sstring> shard_lines) {
+            acc.insert(acc.end(), std::make_move_iterator(shard_lines.begin()), std::make_move_iterator(shard_lines.end()));
+            return acc;
+        }).then([] (std::vector<sstring> lines) {
+            return make_ready_future<json::json_return_type>(lines);
+        });
+    });
+
+}
+
+} // namespace api
@@ -35,6 +35,14 @@ permissions_cache::permissions_cache(const permissions_cache_config& c, service&
 }
 
 future<permission_set> permissions_cache::get(const role_or_anonymous& maybe_role, const resource& r) {
+    // The common case is a cached entry, which resolves to a ready future
+    // with a single hash lookup - no copies of the role name and resource
+    // into a key pair, and no continuation state. Only a miss (or an entry
+    // under its first load) takes the allocating path below.
+    auto vp = _cache.find(key_view{maybe_role, r}, key_view_hasher(), key_view_equal());
+    if (vp) {
+        return make_ready_future<permission_set>(*vp);
+    }
     return do_with(key_type(maybe_role, r), [this](const auto& k) {
         return _cache.get(k);
     });
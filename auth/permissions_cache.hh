@@ -74,6 +74,29 @@ class permissions_cache final {
 
     using key_type = typename cache_type::key_type;
 
+    // A non-owning view of a key, for looking up an existing entry without
+    // copying the role name and the resource into a key pair. Hashes
+    // identically to utils::tuple_hash over the key pair.
+    struct key_view {
+        const role_or_anonymous& maybe_role;
+        const resource& r;
+    };
+
+    struct key_view_hasher {
+        size_t operator()(const key_view& kv) const {
+            return utils::hash_combine(std::hash<role_or_anonymous>()(kv.maybe_role), std::hash<resource>()(kv.r));
+        }
+    };
+
+    struct key_view_equal {
+        bool operator()(const key_type& k, const key_view& kv) const {
+            return k.first == kv.maybe_role && k.second == kv.r;
+        }
+        bool operator()(const key_view& kv, const key_type& k) const {
+            return operator()(k, kv);
+        }
+    };
+
     cache_type _cache;
 
 public:
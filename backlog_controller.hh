@@ -71,8 +71,22 @@ protected:
     // updating shares for an I/O class may contact another shard and returns a future.
     future<> _inflight_update;
 
+    // Optional foreground I/O pressure signal in [0, 1]. When engaged, the
+    // controller scales its output down while the pressure is high, so the
+    // controlled work fills I/O troughs instead of competing with foreground
+    // reads during peaks, no matter how large the backlog is.
+    std::function<float()> _io_pressure;
+    // Hysteresis state: throttling engages when the pressure crosses the high
+    // watermark and releases only after it falls below the low one, so shares
+    // don't oscillate while the pressure hovers around a single threshold.
+    bool _io_throttled = false;
+    static constexpr float _io_pressure_high = 0.75f;
+    static constexpr float _io_pressure_low = 0.50f;
+
     virtual void update_controller(float quota);
 
+    float throttled(float shares);
+
     void adjust();
 
     backlog_controller(seastar::scheduling_group sg, const ::io_priority_class& iop, std::chrono::milliseconds interval,
@@ -102,6 +116,9 @@ protected:
     virtual ~backlog_controller() {}
 public:
     backlog_controller(backlog_controller&&) = default;
+    void set_io_pressure_source(std::function<float()> source) {
+        _io_pressure = std::move(source);
+    }
     float backlog_of_shares(float shares) const;
     seastar::scheduling_group sg() {
         return _scheduling_group;
@@ -206,6 +206,7 @@ public:
         , _size(0)
         , _initial_chunk_size(o._initial_chunk_size)
     {
+        reserve(o.size());
         append(o);
     }
 
@@ -331,8 +332,25 @@ public:
         return _size == 0;
     }
 
+    // Pre-allocates the first chunk so that the next `size` bytes of writes
+    // don't allocate, sparing the geometric growth sequence and the chunk
+    // chaining it causes when the final size is known up front.
+    // Has an effect only before the first write; the chunk chain cannot be
+    // grown in place later without invalidating the placeholders already
+    // handed out.
     void reserve(size_t size) {
-        // FIXME: implement
+        if (!_begin && size) {
+            auto alloc_size = std::min(size + sizeof(chunk), size_t(max_alloc_size()));
+            auto space = malloc(alloc_size);
+            if (!space) {
+                throw std::bad_alloc();
+            }
+            auto new_chunk = std::unique_ptr<chunk>(new (space) chunk());
+            new_chunk->offset = 0;
+            new_chunk->size = alloc_size - sizeof(chunk);
+            _begin = std::move(new_chunk);
+            _current = _begin.get();
+        }
     }
 
     void append(const bytes_ostream& o) {
@@ -114,6 +114,13 @@ class cache_flat_mutation_reader final : public flat_mutation_reader::impl {
     flat_mutation_reader* _underlying = nullptr;
     flat_mutation_reader_opt _underlying_holder;
 
+    // Fragments read from the underlying reader which were not yet populated
+    // into cache nor pushed to the buffer. Populating them in batches
+    // amortizes the cost of entering the LSA update section, which dominates
+    // population cost during large range scans.
+    std::vector<mutation_fragment> _population_batch;
+    static constexpr size_t max_population_batch_size = 32;
+
     future<> do_fill_buffer();
     future<> ensure_underlying();
     void copy_from_cache_to_buffer();
@@ -140,10 +147,21 @@ class cache_flat_mutation_reader final : public flat_mutation_reader::impl {
     // Returns false if it failed and range cannot be populated.
     // Assumes can_populate().
     bool ensure_population_lower_bound();
-    void maybe_add_to_cache(const mutation_fragment& mf);
     void maybe_add_to_cache(const clustering_row& cr);
     void maybe_add_to_cache(const range_tombstone& rt);
     void maybe_add_to_cache(const static_row& sr);
+    // Variants of maybe_add_to_cache() which assume the caller already
+    // checked can_populate() and entered the update section.
+    // The clustering row variant takes an optional insertion hint pointing
+    // right after the previously inserted row and returns a hint for the
+    // next insertion, so that consecutive rows of a batch don't pay a
+    // tree search each.
+    mutation_partition::rows_type::iterator add_to_cache_locked(const clustering_row& cr,
+            std::optional<mutation_partition::rows_type::iterator> hint = std::nullopt);
+    void add_to_cache_locked(const range_tombstone& rt);
+    // Populates cache with all fragments accumulated in _population_batch
+    // within a single update section and moves them to the buffer.
+    void flush_population_batch();
     void maybe_set_static_row_continuous();
     void finish_reader() {
         push_mutation_fragment(*_schema, _permit, partition_end());
@@ -345,10 +363,13 @@ future<> cache_flat_mutation_reader::read_from_underlying() {
         [this] { return _state != state::reading_from_underlying || is_buffer_full(); },
         [this] (mutation_fragment mf) {
             _read_context.cache().on_row_miss();
-            maybe_add_to_cache(mf);
-            add_to_buffer(std::move(mf));
+            _population_batch.emplace_back(std::move(mf));
+            if (_population_batch.size() >= max_population_batch_size) {
+                flush_population_batch();
+            }
         },
         [this] {
+            flush_population_batch();
             _state = state::reading_from_cache;
             _lsa_manager.run_in_update_section([this] {
                 auto same_pos = _next_row.maybe_refresh();
@@ -461,14 +482,37 @@ void cache_flat_mutation_reader::maybe_update_continuity() {
 }
 
 inline
-void cache_flat_mutation_reader::maybe_add_to_cache(const mutation_fragment& mf) {
-    if (mf.is_range_tombstone()) {
-        maybe_add_to_cache(mf.as_range_tombstone());
+void cache_flat_mutation_reader::flush_population_batch() {
+    if (_population_batch.empty()) {
+        return;
+    }
+    if (can_populate()) {
+        auto population_start = utils::time_estimated_histogram::clock::now();
+        _lsa_manager.run_in_update_section_with_allocator([this] {
+            // Fragments arrive in clustering order, so each insertion can use
+            // the position right after the previous one as a hint and avoid
+            // a tree search per row.
+            std::optional<mutation_partition::rows_type::iterator> hint;
+            for (mutation_fragment& mf : _population_batch) {
+                if (mf.is_range_tombstone()) {
+                    add_to_cache_locked(mf.as_range_tombstone());
+                    hint = std::nullopt;
+                } else {
+                    assert(mf.is_clustering_row());
+                    hint = add_to_cache_locked(mf.as_clustering_row(), hint);
+                }
+            }
+        });
+        _snp->tracker()->on_population_batch(utils::time_estimated_histogram::clock::now() - population_start);
     } else {
-        assert(mf.is_clustering_row());
-        const clustering_row& cr = mf.as_clustering_row();
-        maybe_add_to_cache(cr);
+        _last_row = nullptr;
+        _population_range_starts_before_all_rows = false;
+        _read_context.cache().on_mispopulate();
+    }
+    for (mutation_fragment& mf : _population_batch) {
+        add_to_buffer(std::move(mf));
     }
+    _population_batch.clear();
 }
 
 inline
@@ -479,37 +523,45 @@ void cache_flat_mutation_reader::maybe_add_to_cache(const clustering_row& cr) {
         _read_context.cache().on_mispopulate();
         return;
     }
-    clogger.trace("csm {}: populate({})", fmt::ptr(this), clustering_row::printer(*_schema, cr));
     _lsa_manager.run_in_update_section_with_allocator([this, &cr] {
-        mutation_partition& mp = _snp->version()->partition();
-        rows_entry::tri_compare cmp(*_schema);
-
-        if (_read_context.digest_requested()) {
-            cr.cells().prepare_hash(*_schema, column_kind::regular_column);
-        }
-        auto new_entry = alloc_strategy_unique_ptr<rows_entry>(
-            current_allocator().construct<rows_entry>(*_schema, cr.key(), cr.as_deletable_row()));
-        new_entry->set_continuous(false);
-        auto it = _next_row.iterators_valid() ? _next_row.get_iterator_in_latest_version()
-                                              : mp.clustered_rows().lower_bound(cr.key(), cmp);
-        auto insert_result = mp.mutable_clustered_rows().insert_before_hint(it, std::move(new_entry), cmp);
-        it = insert_result.first;
-        if (insert_result.second) {
-            _snp->tracker()->insert(*it);
-        }
+        add_to_cache_locked(cr);
+    });
+}
 
-        rows_entry& e = *it;
-        if (ensure_population_lower_bound()) {
-            clogger.trace("csm {}: set_continuous({})", fmt::ptr(this), e.position());
-            e.set_continuous(true);
-        } else {
-            _read_context.cache().on_mispopulate();
-        }
-        with_allocator(standard_allocator(), [&] {
-            _last_row = partition_snapshot_row_weakref(*_snp, it, true);
-        });
-        _population_range_starts_before_all_rows = false;
+inline
+mutation_partition::rows_type::iterator
+cache_flat_mutation_reader::add_to_cache_locked(const clustering_row& cr, std::optional<mutation_partition::rows_type::iterator> hint) {
+    clogger.trace("csm {}: populate({})", fmt::ptr(this), clustering_row::printer(*_schema, cr));
+    mutation_partition& mp = _snp->version()->partition();
+    rows_entry::tri_compare cmp(*_schema);
+
+    if (_read_context.digest_requested()) {
+        cr.cells().prepare_hash(*_schema, column_kind::regular_column);
+    }
+    auto new_entry = alloc_strategy_unique_ptr<rows_entry>(
+        current_allocator().construct<rows_entry>(*_schema, cr.key(), cr.as_deletable_row()));
+    new_entry->set_continuous(false);
+    auto it = hint                      ? *hint
+            : _next_row.iterators_valid() ? _next_row.get_iterator_in_latest_version()
+                                          : mp.clustered_rows().lower_bound(cr.key(), cmp);
+    auto insert_result = mp.mutable_clustered_rows().insert_before_hint(it, std::move(new_entry), cmp);
+    it = insert_result.first;
+    if (insert_result.second) {
+        _snp->tracker()->insert(*it);
+    }
+
+    rows_entry& e = *it;
+    if (ensure_population_lower_bound()) {
+        clogger.trace("csm {}: set_continuous({})", fmt::ptr(this), e.position());
+        e.set_continuous(true);
+    } else {
+        _read_context.cache().on_mispopulate();
+    }
+    with_allocator(standard_allocator(), [&] {
+        _last_row = partition_snapshot_row_weakref(*_snp, it, true);
     });
+    _population_range_starts_before_all_rows = false;
+    return std::next(it);
 }
 
 inline
@@ -733,15 +785,20 @@ void cache_flat_mutation_reader::add_range_tombstone_to_buffer(range_tombstone&&
 inline
 void cache_flat_mutation_reader::maybe_add_to_cache(const range_tombstone& rt) {
     if (can_populate()) {
-        clogger.trace("csm {}: maybe_add_to_cache({})", fmt::ptr(this), rt);
         _lsa_manager.run_in_update_section_with_allocator([&] {
-            _snp->version()->partition().mutable_row_tombstones().apply_monotonically(*_schema, rt);
+            add_to_cache_locked(rt);
         });
     } else {
         _read_context.cache().on_mispopulate();
     }
 }
 
+inline
+void cache_flat_mutation_reader::add_to_cache_locked(const range_tombstone& rt) {
+    clogger.trace("csm {}: maybe_add_to_cache({})", fmt::ptr(this), rt);
+    _snp->version()->partition().mutable_row_tombstones().apply_monotonically(*_schema, rt);
+}
+
 inline
 void cache_flat_mutation_reader::maybe_add_to_cache(const static_row& sr) {
     if (can_populate()) {
@@ -24,6 +24,7 @@
 #include "mutation_partition_view.hh"
 #include "mutation_partition_visitor.hh"
 #include "mutation_partition_serializer.hh"
+#include "partition_builder.hh"
 #include "counters.hh"
 #include "converting_mutation_partition_applier.hh"
 #include "hashing_partition_visitor.hh"
@@ -79,9 +80,12 @@ mutation canonical_mutation::to_mutation(schema_ptr s) const {
     mutation m(std::move(s), std::move(pk));
 
     if (version == m.schema()->version()) {
+        // The partition is freshly constructed, so build it straight from the
+        // serialized form instead of materializing an intermediate partition
+        // and merging it in, like the version-mismatch branch below does.
         auto partition_view = mutation_partition_view::from_view(mv.partition());
-        mutation_application_stats app_stats;
-        m.partition().apply(*m.schema(), partition_view, *m.schema(), app_stats);
+        partition_builder b(*m.schema(), m.partition());
+        partition_view.accept(*m.schema(), b);
     } else {
         column_mapping cm = mv.mapping();
         converting_mutation_partition_applier v(cm, *m.schema(), m.partition());
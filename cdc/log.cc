@@ -21,6 +21,7 @@
 
 #include <utility>
 #include <algorithm>
+#include <set>
 
 #include <boost/range/irange.hpp>
 #include <boost/algorithm/string/predicate.hpp>
@@ -1578,86 +1579,142 @@ public:
         if (p.clustered_rows().empty() && p.static_row().empty()) {
             return make_ready_future<lw_shared_ptr<cql3::untyped_result_set>>();
         }
+        return pre_image_select(_ctx, _schema, client_state, write_cl, {&m});
+    }
+
+    // Issues the preimage query for one or more mutations of the same table,
+    // combining their partitions into a single multi-partition read, so a
+    // group of same-table writes shares one read path invocation. A group of
+    // more than one mutation may only contain mutations with clustering rows
+    // (the static-row-only form needs a per-partition row limit that a
+    // combined read cannot express), and the shared result set must be
+    // filtered by partition when loaded back - see
+    // load_preimage_results_into_state().
+    static future<lw_shared_ptr<cql3::untyped_result_set>> pre_image_select(
+            db_context ctx,
+            schema_ptr schema,
+            service::client_state& client_state,
+            db::consistency_level write_cl,
+            std::vector<const mutation*> muts)
+    {
+        const auto& s = *schema;
 
-        dht::partition_range_vector partition_ranges{dht::partition_range(m.decorated_key())};
+        dht::partition_range_vector partition_ranges;
+        partition_ranges.reserve(muts.size());
+        for (const mutation* m : muts) {
+            partition_ranges.emplace_back(dht::partition_range(m->decorated_key()));
+        }
 
-        auto&& pc = _schema->partition_key_columns();
-        auto&& cc = _schema->clustering_key_columns();
+        auto&& pc = s.partition_key_columns();
+        auto&& cc = s.clustering_key_columns();
+
+        bool any_static_row = false;
+        bool only_static_rows = true;
+        bool any_clustered_rows = false;
+        bool has_row_delete = false;
+        for (const mutation* m : muts) {
+            auto& p = m->partition();
+            any_static_row |= !p.static_row().empty();
+            only_static_rows &= !p.static_row().empty() && p.clustered_rows().empty();
+            any_clustered_rows |= !p.clustered_rows().empty();
+            has_row_delete |= std::any_of(p.clustered_rows().begin(), p.clustered_rows().end(), [] (const rows_entry& re) {
+                return re.row().deleted_at();
+            });
+        }
 
         std::vector<query::clustering_range> bounds;
         uint64_t row_limit = query::max_rows;
 
-        const bool has_only_static_row = !p.static_row().empty() && p.clustered_rows().empty();
-        if (cc.empty() || has_only_static_row) {
+        if (cc.empty() || only_static_rows) {
             bounds.push_back(query::clustering_range::make_open_ended_both_sides());
-            if (has_only_static_row) {
+            if (only_static_rows) {
                 row_limit = 1;
             }
         } else {
-            for (const rows_entry& r : p.clustered_rows()) {
-                auto& ck = r.key();
+            // Collect the clustering keys of all the mutations. With more
+            // than one mutation they must be deduplicated and put back in
+            // clustering order, since the slice applies to every partition
+            // in the query.
+            std::set<clustering_key, clustering_key::less_compare> keys{clustering_key::less_compare(s)};
+            for (const mutation* m : muts) {
+                for (const rows_entry& r : m->partition().clustered_rows()) {
+                    keys.insert(r.key());
+                }
+            }
+            for (const auto& ck : keys) {
                 bounds.push_back(query::clustering_range::make_singular(ck));
             }
         }
 
         std::vector<const column_definition*> columns;
-        columns.reserve(_schema->all_columns().size());
+        columns.reserve(s.all_columns().size());
 
         std::transform(pc.begin(), pc.end(), std::back_inserter(columns), [](auto& c) { return &c; });
         std::transform(cc.begin(), cc.end(), std::back_inserter(columns), [](auto& c) { return &c; });
 
         query::column_id_vector static_columns, regular_columns;
 
-        // TODO: this assumes all mutations touch the same set of columns. This might not be true, and we may need to do more horrible set operation here.
-        if (!p.static_row().empty()) {
+        if (any_static_row) {
             // for postimage we need everything...
-            if (_schema->cdc_options().postimage() || _schema->cdc_options().full_preimage()) {
-                for (const column_definition& c: _schema->static_columns()) {
+            if (s.cdc_options().postimage() || s.cdc_options().full_preimage()) {
+                for (const column_definition& c: s.static_columns()) {
                     static_columns.emplace_back(c.id);
                     columns.emplace_back(&c);
                 }
             } else {
-                p.static_row().get().for_each_cell([&] (column_id id, const atomic_cell_or_collection&) {
-                    auto& cdef =_schema->column_at(column_kind::static_column, id);
+                std::set<column_id> ids;
+                for (const mutation* m : muts) {
+                    m->partition().static_row().get().for_each_cell([&] (column_id id, const atomic_cell_or_collection&) {
+                        ids.insert(id);
+                    });
+                }
+                for (auto id : ids) {
                     static_columns.emplace_back(id);
-                    columns.emplace_back(&cdef);
-                });
+                    columns.emplace_back(&s.column_at(column_kind::static_column, id));
+                }
             }
         }
-        if (!p.clustered_rows().empty()) {
-            const bool has_row_delete = std::any_of(p.clustered_rows().begin(), p.clustered_rows().end(), [] (const rows_entry& re) {
-                return re.row().deleted_at();
-            });
+        if (any_clustered_rows) {
             // for postimage we need everything...
-            if (has_row_delete || _schema->cdc_options().postimage() || _schema->cdc_options().full_preimage()) {
-                for (const column_definition& c: _schema->regular_columns()) {
+            if (has_row_delete || s.cdc_options().postimage() || s.cdc_options().full_preimage()) {
+                for (const column_definition& c: s.regular_columns()) {
                     regular_columns.emplace_back(c.id);
                     columns.emplace_back(&c);
                 }
             } else {
-                p.clustered_rows().begin()->row().cells().for_each_cell([&] (column_id id, const atomic_cell_or_collection&) {
-                    const auto& cdef =_schema->column_at(column_kind::regular_column, id);
+                // TODO: this assumes all the rows of a mutation touch the same set of columns.
+                // This might not be true, and we may need to do more horrible set operation here.
+                std::set<column_id> ids;
+                for (const mutation* m : muts) {
+                    auto& p = m->partition();
+                    if (!p.clustered_rows().empty()) {
+                        p.clustered_rows().begin()->row().cells().for_each_cell([&] (column_id id, const atomic_cell_or_collection&) {
+                            ids.insert(id);
+                        });
+                    }
+                }
+                for (auto id : ids) {
                     regular_columns.emplace_back(id);
-                    columns.emplace_back(&cdef);
-                });
+                    columns.emplace_back(&s.column_at(column_kind::regular_column, id));
+                }
             }
         }
-        
-        auto selection = cql3::selection::selection::for_columns(_schema, std::move(columns));
+
+        auto selection = cql3::selection::selection::for_columns(schema, std::move(columns));
 
         auto opts = selection->get_query_options();
         opts.set(query::partition_slice::option::collections_as_maps);
-        opts.set_if<query::partition_slice::option::always_return_static_content>(!p.static_row().empty());
+        opts.set_if<query::partition_slice::option::always_return_static_content>(any_static_row);
 
         auto partition_slice = query::partition_slice(std::move(bounds), std::move(static_columns), std::move(regular_columns), std::move(opts));
-        const auto max_result_size = _ctx._proxy.get_max_result_size(partition_slice);
-        auto command = ::make_lw_shared<query::read_command>(_schema->id(), _schema->version(), partition_slice, query::max_result_size(max_result_size), query::row_limit(row_limit));
+        const auto max_result_size = ctx._proxy.get_max_result_size(partition_slice);
+        auto command = ::make_lw_shared<query::read_command>(s.id(), s.version(), partition_slice, query::max_result_size(max_result_size), query::row_limit(row_limit));
 
         const auto select_cl = adjust_cl(write_cl);
 
       try {
-        return _ctx._proxy.query(_schema, std::move(command), std::move(partition_ranges), select_cl, service::storage_proxy::coordinator_query_options(default_timeout(), empty_service_permit(), client_state)).then(
-                [s = _schema, partition_slice = std::move(partition_slice), selection = std::move(selection)] (service::storage_proxy::coordinator_query_result qr) -> lw_shared_ptr<cql3::untyped_result_set> {
+        return ctx._proxy.query(schema, std::move(command), std::move(partition_ranges), select_cl, service::storage_proxy::coordinator_query_options(default_timeout(), empty_service_permit(), client_state)).then(
+                [s = std::move(schema), partition_slice = std::move(partition_slice), selection = std::move(selection)] (service::storage_proxy::coordinator_query_result qr) -> lw_shared_ptr<cql3::untyped_result_set> {
             return make_lw_shared<cql3::untyped_result_set>(*s, std::move(qr.query_result), *selection, partition_slice);
         });
       } catch (exceptions::unavailable_exception& e) {
@@ -1669,17 +1726,44 @@ public:
       }
     }
 
-    // Note: this assumes that the results are from one partition only
-    void load_preimage_results_into_state(lw_shared_ptr<cql3::untyped_result_set> preimage_set, bool static_only) {
+    // Reconstructs the partition key of a preimage result row and checks
+    // whether it belongs to this transformer's partition. Used to split the
+    // shared result set of a combined preimage query (see pre_image_select())
+    // back into its per-partition parts.
+    bool preimage_row_in_partition(const cql3::untyped_result_set_row& row) const {
+        std::vector<managed_bytes> pk_parts;
+        pk_parts.reserve(_schema->partition_key_size());
+        for (auto& c : _schema->partition_key_columns()) {
+            auto v = row.get_view_opt(c.name_as_text());
+            if (!v) {
+                return false;
+            }
+            pk_parts.emplace_back(managed_bytes(*v));
+        }
+        return partition_key::from_exploded(std::move(pk_parts)).equal(*_schema, _dk.key());
+    }
+
+    // When `shared` is set the result set came from a combined preimage query
+    // and may contain rows of other partitions; only the rows of this
+    // transformer's partition are loaded. Otherwise the results are assumed
+    // to be from one partition only.
+    void load_preimage_results_into_state(lw_shared_ptr<cql3::untyped_result_set> preimage_set, bool static_only, bool shared) {
+        auto in_partition = [&] (const cql3::untyped_result_set_row& row) {
+            return !shared || preimage_row_in_partition(row);
+        };
+
         // static row
-        if (!preimage_set->empty()) {
+        for (const auto& row : *preimage_set) {
+            if (!in_partition(row)) {
+                continue;
+            }
             // There may be some static row data
-            const auto& row = preimage_set->front();
             for (auto& c : _schema->static_columns()) {
                 if (auto maybe_cell_view = get_preimage_col_value(c, &row)) {
                     _static_row_state[&c] = std::move(*maybe_cell_view);
                 }
             }
+            break;
         }
 
         if (static_only) {
@@ -1688,6 +1772,9 @@ public:
 
         // clustering rows
         for (const auto& row : *preimage_set) {
+            if (!in_partition(row)) {
+                continue;
+            }
             // Construct the clustering key for this row
             std::vector<managed_bytes> ck_parts;
             ck_parts.reserve(_schema->clustering_key_size());
@@ -1757,9 +1844,57 @@ cdc::cdc_service::impl::augment_mutation_call(lowres_clock::time_point timeout,
     tracing::trace(tr_state, "CDC: Started generating mutations for log rows");
     mutations.reserve(2 * mutations.size());
 
-    return do_with(std::move(mutations), service::query_state(service::client_state::for_internal_calls(), empty_service_permit()), operation_details{},
-            [this, timeout, i, tr_state = std::move(tr_state), write_cl] (std::vector<mutation>& mutations, service::query_state& qs, operation_details& details) {
-        return transform_mutations(mutations, 1, [this, &mutations, timeout, &qs, tr_state = tr_state, &details, write_cl] (int idx) mutable {
+    using shared_preimage_map = std::unordered_map<size_t, lw_shared_ptr<cql3::untyped_result_set>>;
+
+    return do_with(std::move(mutations), service::query_state(service::client_state::for_internal_calls(), empty_service_permit()), operation_details{}, shared_preimage_map{},
+            [this, timeout, i, tr_state = std::move(tr_state), write_cl] (std::vector<mutation>& mutations, service::query_state& qs, operation_details& details, shared_preimage_map& shared_preimages) {
+        // Coalesce the preimage selects of same-table mutations into one
+        // combined multi-partition query per table, sharing a single read
+        // path invocation. Mutations with only a static row keep their
+        // individual query - it needs a row limit that the combined form
+        // cannot express.
+        std::vector<std::vector<size_t>> groups;
+        {
+            std::unordered_map<const ::schema*, size_t> group_of;
+            for (size_t idx = 0; idx < mutations.size(); ++idx) {
+                auto s = mutations[idx].schema();
+                if (!s->cdc_options().enabled() || !(s->cdc_options().preimage() || s->cdc_options().postimage())) {
+                    continue;
+                }
+                if (mutations[idx].partition().clustered_rows().empty()) {
+                    continue;
+                }
+                auto [it, added] = group_of.try_emplace(s.get(), groups.size());
+                if (added) {
+                    groups.emplace_back();
+                }
+                groups[it->second].push_back(idx);
+            }
+            std::erase_if(groups, [] (const std::vector<size_t>& g) { return g.size() < 2; });
+        }
+        return parallel_for_each(std::move(groups), [this, &mutations, &qs, &shared_preimages, write_cl] (std::vector<size_t> group) {
+            auto s = mutations[group.front()].schema();
+            std::vector<const mutation*> muts;
+            muts.reserve(group.size());
+            for (auto idx : group) {
+                muts.push_back(&mutations[idx]);
+            }
+            return transformer::pre_image_select(_ctxt, std::move(s), qs.get_client_state(), write_cl, std::move(muts)).then_wrapped(
+                    [this, &shared_preimages, group = std::move(group)] (future<lw_shared_ptr<cql3::untyped_result_set>> f) {
+                auto& cdc_stats = _ctxt._proxy.get_cdc_stats();
+                cdc_stats.counters_total.preimage_selects++;
+                if (f.failed()) {
+                    cdc_stats.counters_failed.preimage_selects++;
+                    return make_exception_future<>(f.get_exception());
+                }
+                auto rs = f.get0();
+                for (auto idx : group) {
+                    shared_preimages.emplace(idx, rs);
+                }
+                return make_ready_future<>();
+            });
+        }).then([this, &mutations, &qs, &details, &shared_preimages, tr_state, write_cl] {
+        return transform_mutations(mutations, 1, [this, &mutations, &qs, tr_state = tr_state, &details, &shared_preimages, write_cl] (int idx) mutable {
             auto& m = mutations[idx];
             auto s = m.schema();
 
@@ -1770,10 +1905,12 @@ cdc::cdc_service::impl::augment_mutation_call(lowres_clock::time_point timeout,
             transformer trans(_ctxt, s, m.decorated_key());
 
             auto f = make_ready_future<lw_shared_ptr<cql3::untyped_result_set>>(nullptr);
-            if (s->cdc_options().preimage() || s->cdc_options().postimage()) {
-                // Note: further improvement here would be to coalesce the pre-image selects into one
-                // iff a batch contains several modifications to the same table. Otoh, batch is rare(?)
-                // so this is premature.
+            bool shared_preimage = false;
+            if (auto it = shared_preimages.find(idx); it != shared_preimages.end()) {
+                // The preimage was already read by the combined per-table query above.
+                shared_preimage = true;
+                f = make_ready_future<lw_shared_ptr<cql3::untyped_result_set>>(it->second);
+            } else if (s->cdc_options().preimage() || s->cdc_options().postimage()) {
                 tracing::trace(tr_state, "CDC: Selecting preimage for {}", m.decorated_key());
                 f = trans.pre_image_select(qs.get_client_state(), write_cl, m).then_wrapped([this] (future<lw_shared_ptr<cql3::untyped_result_set>> f) {
                     auto& cdc_stats = _ctxt._proxy.get_cdc_stats();
@@ -1787,14 +1924,14 @@ cdc::cdc_service::impl::augment_mutation_call(lowres_clock::time_point timeout,
                 tracing::trace(tr_state, "CDC: Preimage not enabled for the table, not querying current value of {}", m.decorated_key());
             }
 
-            return f.then([trans = std::move(trans), &mutations, idx, tr_state, &details] (lw_shared_ptr<cql3::untyped_result_set> rs) mutable {
+            return f.then([trans = std::move(trans), &mutations, idx, tr_state, &details, shared_preimage] (lw_shared_ptr<cql3::untyped_result_set> rs) mutable {
                 auto& m = mutations[idx];
                 auto& s = m.schema();
 
                 if (rs) {
                     const auto& p = m.partition();
                     const bool static_only = !p.static_row().empty() && p.clustered_rows().empty();
-                    trans.load_preimage_results_into_state(std::move(rs), static_only);
+                    trans.load_preimage_results_into_state(std::move(rs), static_only, shared_preimage);
                 }
 
                 const bool preimage = s->cdc_options().preimage();
@@ -1823,6 +1960,7 @@ cdc::cdc_service::impl::augment_mutation_call(lowres_clock::time_point timeout,
             auto tracker = make_lw_shared<cdc::operation_result_tracker>(_ctxt._proxy.get_cdc_stats(), details);
             return make_ready_future<std::tuple<std::vector<mutation>, lw_shared_ptr<cdc::operation_result_tracker>>>(std::make_tuple(std::move(mutations), std::move(tracker)));
         });
+        });
     });
 }
 
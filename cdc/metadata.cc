@@ -68,6 +68,59 @@ cdc::stream_id get_stream(
     return get_stream(*it, tok);
 }
 
+// Bias to map the signed token space onto an unsigned one, so token prefix
+// bits can be used directly as a bucket index.
+static uint64_t biased_token(dht::token tok) {
+    return uint64_t(tok.raw()) + (uint64_t(1) << 63);
+}
+
+void cdc::metadata::maybe_rebuild_stream_index(api::timestamp_type gen_ts, const cdc::topology_description& gen) {
+    if (_stream_index.gen_timestamp == gen_ts) {
+        return;
+    }
+
+    const auto& entries = gen.entries();
+    // Aim at ~2 buckets per entry so lookups take at most a few forward
+    // steps, capped so the table stays small even for huge generations.
+    constexpr unsigned max_bits = 16;
+    unsigned bits = 1;
+    while (bits < max_bits && (size_t(1) << bits) < 2 * entries.size()) {
+        ++bits;
+    }
+
+    stream_index index;
+    index.shift = 64 - bits;
+    index.first_entry.resize(size_t(1) << bits);
+    size_t e = 0;
+    for (size_t b = 0; b < index.first_entry.size(); ++b) {
+        const uint64_t bucket_start = uint64_t(b) << index.shift;
+        while (e < entries.size() && biased_token(entries[e].token_range_end) < bucket_start) {
+            ++e;
+        }
+        index.first_entry[b] = e;
+    }
+    index.gen_timestamp = gen_ts;
+    _stream_index = std::move(index);
+}
+
+cdc::stream_id cdc::metadata::stream_for(const std::vector<cdc::token_range_description>& entries, dht::token tok) const {
+    if (entries.empty()) {
+        on_internal_error(cdc_log, "stream_for: entries empty");
+    }
+
+    // Entries before the bucket's first_entry end strictly before the
+    // bucket starts, so they cannot cover `tok`; step forward from there.
+    size_t i = _stream_index.first_entry[biased_token(tok) >> _stream_index.shift];
+    while (i < entries.size() && entries[i].token_range_end < tok) {
+        ++i;
+    }
+    if (i == entries.size()) {
+        i = 0;
+    }
+
+    return ::get_stream(entries[i], tok);
+}
+
 cdc::metadata::container_t::const_iterator cdc::metadata::gen_used_at(api::timestamp_type ts) const {
     auto it = _gens.upper_bound(ts);
     if (it == _gens.begin()) {
@@ -138,7 +191,8 @@ cdc::stream_id cdc::metadata::get_stream(api::timestamp_type ts, dht::token tok)
     }
 
     auto& gen = *it->second;
-    auto ret = ::get_stream(gen.entries(), tok);
+    maybe_rebuild_stream_index(it->first, gen);
+    auto ret = stream_for(gen.entries(), tok);
     _last_stream_timestamp = ts;
     return ret;
 }
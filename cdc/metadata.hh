@@ -22,6 +22,7 @@
 #pragma once
 
 #include <map>
+#include <vector>
 
 #include "db_clock.hh"
 #include "timestamp.hh"
@@ -53,7 +54,24 @@ class metadata final {
     /* The timestamp used in the last successful `get_stream` call. */
     api::timestamp_type _last_stream_timestamp = api::missing_timestamp;
 
+    /* Flat lookup table accelerating `get_stream` for the generation it is
+     * currently serving from. Buckets are indexed by the top bits of the
+     * token; each bucket holds the position of the first entry whose range
+     * can contain a token from that bucket, so the per-write lookup is an
+     * array access plus at most a few forward steps instead of a binary
+     * search over all entries. Rebuilt whenever the used generation changes.
+     */
+    struct stream_index {
+        api::timestamp_type gen_timestamp = api::missing_timestamp;
+        unsigned shift = 64;
+        std::vector<uint32_t> first_entry;
+    };
+    stream_index _stream_index;
+
     container_t::const_iterator gen_used_at(api::timestamp_type ts) const;
+
+    void maybe_rebuild_stream_index(api::timestamp_type gen_ts, const topology_description& gen);
+    stream_id stream_for(const std::vector<token_range_description>& entries, dht::token tok) const;
 public:
     /* Is a generation with the given timestamp already known or superseded by a newer generation? */
     bool known_or_obsolete(db_clock::time_point) const;
@@ -137,7 +137,10 @@ private:
         column_id id;
     };
 
-    class cell_entry : public bi::unordered_set_base_hook<bi::link_mode<bi::auto_unlink>>,
+    // store_hash caches the xx_hash of the cell address in the hook, so
+    // rehashing doesn't recompute it and lookups compare the cached hashes
+    // before falling back to the (much more expensive) position comparison.
+    class cell_entry : public bi::unordered_set_base_hook<bi::link_mode<bi::auto_unlink>, bi::store_hash<true>>,
                        public enable_lw_shared_from_this<cell_entry> {
         partition_entry& _parent;
         cell_address _address;
@@ -223,10 +226,11 @@ private:
         };
     };
 
-    class partition_entry : public bi::unordered_set_base_hook<bi::link_mode<bi::auto_unlink>> {
+    class partition_entry : public bi::unordered_set_base_hook<bi::link_mode<bi::auto_unlink>, bi::store_hash<true>> {
         using cells_type = bi::unordered_set<cell_entry,
                                              bi::equal<cell_entry::equal_compare>,
                                              bi::hash<cell_entry::hasher>,
+                                             bi::compare_hash<true>,
                                              bi::constant_time_size<false>>;
 
         static constexpr size_t initial_bucket_count = 16;
@@ -313,6 +317,7 @@ private:
     using partitions_type = bi::unordered_set<partition_entry,
                                               bi::equal<partition_entry::equal_compare>,
                                               bi::hash<partition_entry::hasher>,
+                                              bi::compare_hash<true>,
                                               bi::constant_time_size<false>>;
 
     static constexpr size_t initial_bucket_count = 4 * 1024;
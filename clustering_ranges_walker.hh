@@ -63,6 +63,30 @@ private:
         return true;
     }
 
+    // Jumps to the first range which ends after pos. The ranges are sorted
+    // and disjoint so this is a binary search, unlike advance_to_next_range()
+    // which steps one range at a time. Only valid when the current range
+    // comes from _current_range; the caller must make sure nothing needs to
+    // be emitted for the skipped ranges.
+    void skip_to_first_range_ending_after(position_in_partition_view pos, const position_in_partition::less_compare& less) {
+        auto it = std::partition_point(_current_range.begin(), _current_range.end(), [&] (const query::clustering_range& rng) {
+            return !less(pos, position_in_partition_view::for_range_end(rng));
+        });
+        if (it == _current_range.begin()) {
+            return;
+        }
+        _current_range.advance_begin(std::distance(_current_range.begin(), it));
+        _in_current = false;
+        _past_current = false;
+        ++_change_counter;
+        if (!_current_range) {
+            _current_end = _current_start = position_in_partition_view::after_all_clustered_rows();
+        } else {
+            _current_start = position_in_partition_view::for_range_start(_current_range.front());
+            _current_end = position_in_partition_view::for_range_end(_current_range.front());
+        }
+    }
+
     void set_current_positions() {
         _using_clustering_range = false;
          if (!_with_static_row) {
@@ -167,6 +191,14 @@ public:
         auto prev_tombstone = _tombstone;
         _tombstone = new_tombstone;
 
+        // With no active range tombstone there is nothing to emit for ranges
+        // which pos is past, so jump straight to the first range which ends
+        // after pos instead of stepping through them one by one. This matters
+        // for slices with many disjoint ranges (e.g. large IN restrictions).
+        if (!prev_tombstone && _using_clustering_range && !less(pos, _current_end)) {
+            skip_to_first_range_ending_after(pos, less);
+        }
+
         do {
             if (!_in_current && less(pos, _current_start)) {
                 break;
@@ -206,6 +238,12 @@ public:
     bool advance_to(position_in_partition_view start, position_in_partition_view end) {
         position_in_partition::less_compare less(_schema);
 
+        // No tombstone tracking here, so ranges the start is past can be
+        // skipped with a binary search.
+        if (_using_clustering_range && !less(start, _current_end)) {
+            skip_to_first_range_ending_after(start, less);
+        }
+
         do {
             if (!less(_current_start, end)) {
                 break;
@@ -218,6 +256,38 @@ public:
         return false;
     }
 
+    // Classifies a whole buffer of positions in one pass.
+    // Equivalent to calling the single-position bool advance_to() for each
+    // position in turn and collecting the results, but hoists the per-call
+    // setup. One bool per position is appended to `contained`.
+    // The positions must be sorted and monotonic also with respect to
+    // positions passed to advance_to().
+    // Breaks the tracking of current range tombstone, so don't use if you
+    // also use the advance_to() overload which tracks tombstones.
+    void advance_to(const std::vector<position_in_partition_view>& positions, std::vector<bool>& contained) {
+        position_in_partition::less_compare less(_schema);
+        contained.reserve(contained.size() + positions.size());
+
+        for (const auto& pos : positions) {
+            bool c = false;
+            if (_using_clustering_range && !less(pos, _current_end)) {
+                skip_to_first_range_ending_after(pos, less);
+            }
+            do {
+                if (!_in_current && less(pos, _current_start)) {
+                    break;
+                }
+                _in_current = true;
+                if (less(pos, _current_end)) {
+                    c = true;
+                    break;
+                }
+                _past_current = true;
+            } while (advance_to_next_range());
+            contained.push_back(c);
+        }
+    }
+
     // Returns true if the range tombstone expressed by start and end (as in position_range) overlaps
     // with clustering ranges.
     // No monotonicity restrictions on argument values across calls.
@@ -230,18 +300,12 @@ public:
             return false;
         }
 
-        for (const auto& rng : _current_range) {
-            auto range_start = position_in_partition_view::for_range_start(rng);
-            if (!less(range_start, end)) {
-                return false;
-            }
-            auto range_end = position_in_partition_view::for_range_end(rng);
-            if (less(start, range_end)) {
-                return true;
-            }
-        }
-
-        return false;
+        // The ranges are sorted and disjoint, so the first range which ends
+        // after `start` is the only candidate for overlapping [start, end).
+        auto it = std::partition_point(_current_range.begin(), _current_range.end(), [&] (const query::clustering_range& rng) {
+            return !less(start, position_in_partition_view::for_range_end(rng));
+        });
+        return it != _current_range.end() && less(position_in_partition_view::for_range_start(*it), end);
     }
 
     // Intersects rt with query ranges. The first overlap is returned and the rest is applied to dst.
@@ -257,9 +321,19 @@ public:
 
         std::optional<range_tombstone> first;
 
-        for (const auto& rng : _current_range) {
+        // Skip, with a binary search, the ranges which end before rt starts;
+        // they cannot overlap with it.
+        auto begin = std::partition_point(_current_range.begin(), _current_range.end(), [&] (const query::clustering_range& rng) {
+            return !less(rt.position(), position_in_partition_view::for_range_end(rng));
+        });
+
+        for (const auto& rng : boost::make_iterator_range(begin, _current_range.end())) {
             auto range_start = position_in_partition_view::for_range_start(rng);
             auto range_end = position_in_partition_view::for_range_end(rng);
+            if (!less(range_start, rt.end_position())) {
+                // This and all following ranges start after rt ends.
+                break;
+            }
             if (!less(rt.position(), range_start) && !less(range_end, rt.end_position())) {
                 // Fully enclosed by this range.
                 assert(!first);
@@ -186,6 +186,7 @@ bool collection_mutation_description::compact_and_expire(column_id id, row_tombs
     }
     t.apply(base_tomb.regular());
     utils::chunked_vector<std::pair<bytes, atomic_cell>> survivors;
+    survivors.reserve(cells.size());
     utils::chunked_vector<std::pair<bytes, atomic_cell>> losers;
     for (auto&& name_and_cell : cells) {
         atomic_cell& cell = name_and_cell.second;
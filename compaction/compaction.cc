@@ -51,6 +51,7 @@
 #include <boost/algorithm/string/join.hpp>
 
 #include <seastar/core/future-util.hh>
+#include <seastar/core/memory.hh>
 #include <seastar/core/scheduling.hh>
 #include <seastar/core/coroutine.hh>
 #include <seastar/util/closeable.hh>
@@ -167,22 +168,59 @@ std::ostream& operator<<(std::ostream& os, pretty_printed_throughput tp) {
     return os;
 }
 
+// Caches the per-interval work of get_max_purgeable_timestamp(). The set of
+// overlapping non-compacting sstables is constant within one interval of the
+// incremental selector, so it is filtered and sorted once per interval and
+// reused until the compaction's cursor crosses valid_until. It must be
+// invalidated whenever the selector is replaced or the compacting set
+// changes.
+struct max_purgeable_cache {
+    // Overlapping non-compacting sstables for the current interval, sorted
+    // by ascending min_timestamp, so a lookup can stop at the first sstable
+    // whose bloom filter reports the key: no later candidate can lower the
+    // result.
+    std::vector<shared_sstable> candidates;
+    std::optional<dht::ring_position_ext> valid_until;
+
+    void invalidate() {
+        valid_until.reset();
+    }
+};
+
+// Note that the compactor already caches the result of this function for the
+// whole partition (see compact_mutation_state::can_gc()), making the per-cell
+// check a single integer compare. The cache here removes the repeated per
+// partition selection, key hashing and bloom probing wherever the overlap
+// structure makes them redundant: partitions falling in intervals with no
+// candidate sstables resolve without touching the key at all.
 static api::timestamp_type get_max_purgeable_timestamp(const table_state& table_s, sstable_set::incremental_selector& selector,
-        const std::unordered_set<shared_sstable>& compacting_set, const dht::decorated_key& dk) {
-    auto timestamp = api::max_timestamp;
-    std::optional<utils::hashed_key> hk;
-    for (auto&& sst : boost::range::join(selector.select(dk).sstables, table_s.compacted_undeleted_sstables())) {
-        if (compacting_set.contains(sst)) {
-            continue;
-        }
-        if (!hk) {
-            hk = sstables::sstable::make_hashed_key(*table_s.schema(), dk.key());
+        const std::unordered_set<shared_sstable>& compacting_set, max_purgeable_cache& cache, const dht::decorated_key& dk) {
+    dht::ring_position_comparator cmp(*table_s.schema());
+    if (!cache.valid_until || cmp(dk, *cache.valid_until) >= 0) {
+        // selection.next_position is only valid until the next call to
+        // select(), so take an owning copy.
+        auto selection = selector.select(dk);
+        cache.valid_until = dht::ring_position_ext(selection.next_position);
+        cache.candidates.clear();
+        for (auto&& sst : boost::range::join(selection.sstables, table_s.compacted_undeleted_sstables())) {
+            if (!compacting_set.contains(sst)) {
+                cache.candidates.push_back(sst);
+            }
         }
-        if (sst->filter_has_key(*hk)) {
-            timestamp = std::min(timestamp, sst->get_stats_metadata().min_timestamp);
+        boost::sort(cache.candidates, [] (const shared_sstable& x, const shared_sstable& y) {
+            return x->get_stats_metadata().min_timestamp < y->get_stats_metadata().min_timestamp;
+        });
+    }
+    if (cache.candidates.empty()) {
+        return api::max_timestamp;
+    }
+    auto hk = sstables::sstable::make_hashed_key(*table_s.schema(), dk.key());
+    for (auto&& sst : cache.candidates) {
+        if (sst->filter_has_key(hk)) {
+            return sst->get_stats_metadata().min_timestamp;
         }
     }
-    return timestamp;
+    return api::max_timestamp;
 }
 
 static std::vector<shared_sstable> get_uncompacting_sstables(const table_state& table_s, std::vector<shared_sstable> sstables) {
@@ -450,15 +488,23 @@ protected:
     compaction_sstable_replacer_fn _replacer;
     utils::UUID _run_identifier;
     ::io_priority_class _io_priority;
+    // When engaged, the input reader is restricted to this partition range.
+    // Set for sub-jobs of a major compaction split across token sub-ranges.
+    std::optional<dht::partition_range> _range;
     // optional clone of sstable set to be used for expiration purposes, so it will be set if expiration is enabled.
     std::optional<sstable_set> _sstable_set;
     // used to incrementally calculate max purgeable timestamp, as we iterate through decorated keys.
     std::optional<sstable_set::incremental_selector> _selector;
     std::unordered_set<shared_sstable> _compacting_for_max_purgeable_func;
+    // caches the overlapping non-compacting sstables for the selector's current interval.
+    max_purgeable_cache _max_purgeable_cache;
     // Garbage collected sstables that are sealed but were not added to SSTable set yet.
     std::vector<shared_sstable> _unused_garbage_collected_sstables;
     // Garbage collected sstables that were added to SSTable set and should be eventually removed from it.
     std::vector<shared_sstable> _used_garbage_collected_sstables;
+    // When engaged, all output writers compress with this instead of the schema's
+    // compressor. Set by maybe_train_compression_dictionary().
+    compressor_ptr _compressor;
     utils::observable<> _stop_request_observable;
 private:
     compaction_data& init_compaction_data(compaction_data& cdata, const compaction_descriptor& descriptor) const {
@@ -479,6 +525,7 @@ protected:
         , _replacer(std::move(descriptor.replacer))
         , _run_identifier(descriptor.run_identifier)
         , _io_priority(descriptor.io_priority)
+        , _range(std::move(descriptor.range))
         , _sstable_set(std::move(descriptor.all_sstables_snapshot))
         , _selector(_sstable_set ? _sstable_set->make_incremental_selector() : std::optional<sstable_set::incremental_selector>{})
         , _compacting_for_max_purgeable_func(std::unordered_set<shared_sstable>(_sstables.begin(), _sstables.end()))
@@ -527,6 +574,7 @@ protected:
         cfg.run_identifier = _run_identifier;
         cfg.replay_position = _rp;
         cfg.sstable_level = _sstable_level;
+        cfg.compressor = _compressor;
         return cfg;
     }
 
@@ -560,6 +608,7 @@ protected:
         sstable_writer_config cfg = _table_s.configure_writer("garbage_collection");
         cfg.run_identifier = _run_identifier;
         cfg.monitor = monitor.get();
+        cfg.compressor = _compressor;
         auto writer = sst->get_writer(*schema(), partitions_per_sstable(), cfg, get_encoding_stats(), priority);
         return compaction_writer(std::move(monitor), std::move(writer), std::move(sst));
     }
@@ -662,6 +711,70 @@ private:
 
         _ms_metadata.min_timestamp = timestamp_tracker.min();
         _ms_metadata.max_timestamp = timestamp_tracker.max();
+
+        maybe_adjust_compression_for_backlog();
+        maybe_train_compression_dictionary();
+    }
+
+    // If the table's compressor exposes a speed/ratio trade-off (e.g. zstd
+    // with a compression level band), re-tune it for the current compaction
+    // backlog: compress harder while the backlog is low, cheaper when
+    // compaction is falling behind and throughput matters more than ratio.
+    // The chosen tuning lands in the output sstables' compression parameters.
+    void maybe_adjust_compression_for_backlog() {
+        auto c = schema()->get_compressor_params().get_compressor();
+        if (!c) {
+            return;
+        }
+        // Normalize the table's backlog the way the compaction controller
+        // does, relative to the shard's memory, saturating at the controller's
+        // upper control region. This under-reports pressure coming from other
+        // tables, which only errs towards better compression.
+        auto backlog = _table_s.get_compaction_strategy().get_backlog_tracker().backlog();
+        auto pressure = float(std::min(backlog / (seastar::memory::stats().total_memory() * 1.5), 1.0));
+        if (auto adjusted = c->adjust_for_backlog(pressure)) {
+            log_debug("Compressing output with {} re-tuned for backlog pressure {:.2f}", adjusted->name(), pressure);
+            _compressor = std::move(adjusted);
+        }
+    }
+
+    // If the table's compressor asks for a dictionary (e.g. zstd with
+    // dictionary_training enabled), train one on chunk-sized samples spread
+    // evenly across the input sstables. The trained compressor is used by all
+    // output writers and persisted in each output sstable's CompressionInfo,
+    // so the read path picks it up without any negotiation. Training is best
+    // effort: on any failure we fall back to the plain schema compressor.
+    void maybe_train_compression_dictionary() {
+        // Train on top of the backlog-adjusted compressor, if any, so the
+        // dictionary is digested at the level we'll actually compress with.
+        auto c = _compressor ? _compressor : schema()->get_compressor_params().get_compressor();
+        if (!c || !c->wants_dictionary_training() || _sstables.empty()) {
+            return;
+        }
+        try {
+            // Keeps the training set around two orders of magnitude larger
+            // than the dictionary, with a bounded read budget (8 MiB).
+            static constexpr size_t sample_size = 4096;
+            static constexpr size_t max_samples = 2048;
+            std::vector<bytes> samples;
+            auto samples_per_sstable = std::max(max_samples / _sstables.size(), size_t(1));
+            for (auto& sst : _sstables) {
+                auto data_size = sst->data_size();
+                auto stride = std::max<uint64_t>(data_size / samples_per_sstable, sample_size);
+                for (uint64_t pos = 0; pos + sample_size <= data_size && samples.size() < max_samples; pos += stride) {
+                    auto buf = sst->data_read(pos, sample_size, _io_priority, _permit).get0();
+                    samples.emplace_back(reinterpret_cast<const bytes::value_type*>(buf.get()), buf.size());
+                }
+            }
+            if (auto trained = c->train_dictionary(samples)) {
+                log_debug("Trained compression dictionary on {} samples from {} input sstable(s)", samples.size(), _sstables.size());
+                _compressor = std::move(trained);
+            } else {
+                log_debug("Compression dictionary training yielded nothing; compressing with plain {}", c->name());
+            }
+        } catch (...) {
+            log_debug("Compression dictionary training failed: {}", std::current_exception());
+        }
     }
 
     future<> consume() {
@@ -740,7 +853,7 @@ private:
             };
         }
         return [this] (const dht::decorated_key& dk) {
-            return get_max_purgeable_timestamp(_table_s, *_selector, _compacting_for_max_purgeable_func, dk);
+            return get_max_purgeable_timestamp(_table_s, *_selector, _compacting_for_max_purgeable_func, _max_purgeable_cache, dk);
         };
     }
 
@@ -921,7 +1034,7 @@ public:
     flat_mutation_reader make_sstable_reader() const override {
         return _compacting->make_local_shard_sstable_reader(_schema,
                 _permit,
-                query::full_partition_range,
+                _range ? *_range : query::full_partition_range,
                 _schema->full_slice(),
                 _io_priority,
                 tracing::trace_state_ptr(),
@@ -984,6 +1097,8 @@ private:
                 // Fully expired sstable is not actually compacted, therefore it's not present in the compacting set.
                 _compacting->erase(sst);
             });
+            // Released sstables become eligible as purgeability candidates again.
+            _max_purgeable_cache.invalidate();
             // Make sure SSTable created by garbage collected writer is made available
             // before exhausted SSTable is released, so to prevent data resurrection.
             _stop_request_observable();
@@ -1035,6 +1150,7 @@ private:
             }
         }
         _selector.emplace(_sstable_set->make_incremental_selector());
+        _max_purgeable_cache.invalidate();
         _cdata.pending_replacements.clear();
     }
 };
@@ -1676,6 +1792,20 @@ static future<compaction_result> scrub_sstables_validate_mode(sstables::compacti
 
     clogger.info("Finished scrubbing in validate mode {} - sstable(s) are {}", sstables_list_msg, valid ? "valid" : "invalid");
 
+    if (!valid) {
+        // The content of the sstables cannot be trusted. Move the files into
+        // the quarantine subdirectory: the node keeps serving from the
+        // already-open handles, but the sstables won't be picked up again on
+        // the next restart, and the files are preserved for manual inspection
+        // or recovery.
+        for (const auto& sst : descriptor.sstables) {
+            if (sst->marked_for_deletion()) {
+                continue;
+            }
+            co_await sst->move_to_quarantine();
+        }
+    }
+
     co_return compaction_result {
         .new_sstables = {},
         .ended_at = db_clock::now(),
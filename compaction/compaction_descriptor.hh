@@ -148,6 +148,10 @@ struct compaction_descriptor {
     uint64_t max_sstable_bytes;
     // Run identifier of output sstables.
     utils::UUID run_identifier;
+    // When engaged, restricts the compaction to this partition range. Used to
+    // split a major compaction into concurrent sub-jobs over disjoint token
+    // sub-ranges, each producing its own fragment(s) of the shared output run.
+    std::optional<dht::partition_range> range;
     // Calls compaction manager's task for this compaction to release reference to exhausted sstables.
     std::function<void(const std::vector<shared_sstable>& exhausted_sstables)> release_exhausted;
     // The options passed down to the compaction code.
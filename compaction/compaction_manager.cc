@@ -31,6 +31,7 @@
 #include "locator/abstract_replication_strategy.hh"
 #include "utils/fb_utilities.hh"
 #include "utils/UUID_gen.hh"
+#include <atomic>
 #include <cmath>
 #include <boost/algorithm/cxx11/any_of.hpp>
 
@@ -263,6 +264,49 @@ compaction_manager::compaction_state& compaction_manager::get_compaction_state(t
     }
 }
 
+// Evenly splits the token ring into `parallelism` disjoint partition ranges
+// by recursively halving it at token midpoints.
+static dht::partition_range_vector major_compaction_subranges(unsigned parallelism) {
+    std::vector<dht::token_range> token_ranges;
+    token_ranges.push_back(dht::token_range::make_open_ended_both_sides());
+    while (token_ranges.size() < parallelism) {
+        std::vector<dht::token_range> split;
+        split.reserve(token_ranges.size() * 2);
+        for (auto& r : token_ranges) {
+            auto left = r.start() ? r.start()->value() : dht::minimum_token();
+            auto right = r.end() ? r.end()->value() : dht::maximum_token();
+            auto mid = dht::token::midpoint(left, right);
+            split.push_back(dht::token_range(r.start(), dht::token_range::bound(mid, true)));
+            split.push_back(dht::token_range(dht::token_range::bound(mid, false), r.end()));
+        }
+        token_ranges = std::move(split);
+    }
+    dht::partition_range_vector ranges;
+    ranges.reserve(token_ranges.size());
+    for (auto& r : token_ranges) {
+        ranges.push_back(dht::to_partition_range(std::move(r)));
+    }
+    return ranges;
+}
+
+// A major compaction is one long serial merge and on its own rarely keeps a
+// modern disk busy. Big jobs are split into concurrent sub-jobs over disjoint
+// token sub-ranges so their reads and writes overlap, but only while every
+// sub-job still gets enough data to be worth its own merge and writer state.
+static unsigned major_compaction_parallelism(const sstables::compaction_descriptor& descriptor) {
+    static constexpr uint64_t min_sub_job_bytes = 1UL << 30;
+    static constexpr unsigned max_parallelism = 4;
+    uint64_t input_bytes = 0;
+    for (auto& sst : descriptor.sstables) {
+        input_bytes += sst->data_size();
+    }
+    unsigned parallelism = 1;
+    while (parallelism < max_parallelism && input_bytes / (parallelism * 2) >= min_sub_job_bytes) {
+        parallelism *= 2;
+    }
+    return parallelism;
+}
+
 future<> compaction_manager::perform_major_compaction(table* t) {
     if (_state != state::enabled) {
         return make_ready_future<>();
@@ -298,7 +342,23 @@ future<> compaction_manager::perform_major_compaction(table* t) {
             return do_with(std::move(user_initiated), [this, t, descriptor = std::move(descriptor), task] (compaction_backlog_tracker& bt) mutable {
                 register_backlog_tracker(bt);
                 return with_scheduling_group(_compaction_controller.sg(), [this, t, descriptor = std::move(descriptor), task] () mutable {
-                    return t->compact_sstables(std::move(descriptor), task->compaction_data);
+                    auto parallelism = major_compaction_parallelism(descriptor);
+                    if (parallelism == 1) {
+                        return t->compact_sstables(std::move(descriptor), task->compaction_data);
+                    }
+                    // The sub-jobs all write fragments of the same output run.
+                    std::vector<sstables::compaction_descriptor> sub_descriptors;
+                    sub_descriptors.reserve(parallelism);
+                    for (auto& range : major_compaction_subranges(parallelism)) {
+                        sstables::compaction_descriptor sub(descriptor.sstables, descriptor.all_sstables_snapshot,
+                                descriptor.io_priority, descriptor.level, descriptor.max_sstable_bytes, descriptor.run_identifier);
+                        sub.range = std::move(range);
+                        sub.release_exhausted = descriptor.release_exhausted;
+                        sub_descriptors.push_back(std::move(sub));
+                    }
+                    cmlog.info0("Splitting major compaction of {}.{} into {} concurrent token sub-ranges",
+                            t->schema()->ks_name(), t->schema()->cf_name(), parallelism);
+                    return t->parallel_compact_sstables(std::move(sub_descriptors), task->compaction_data);
                 });
             }).then([compacting = std::move(compacting)] {});
         });
@@ -416,6 +476,36 @@ future<> compaction_manager::task_stop(lw_shared_ptr<compaction_manager::task> t
     });
 }
 
+// Per-shard normalized backlogs, each written by its owner shard and read by
+// every shard. Accessed with relaxed atomics: the values only steer share
+// allocation, so slightly stale reads are fine.
+static std::atomic<float>* shard_normalized_backlogs() {
+    static std::vector<std::atomic<float>> backlogs(smp::count);
+    return backlogs.data();
+}
+
+// Compaction work cannot migrate between shards -- sstables and their
+// replacement in the set are shard-private -- so a shard with a deep backlog
+// can only be helped by letting it drain faster. Amplify the controller
+// input of a shard whose backlog stands above the current all-shard average,
+// so the worst shard claims more CPU and disk shares precisely when its
+// neighbours don't need theirs, instead of every shard sizing itself as if
+// it were alone on the node.
+static float cross_shard_balanced_backlog(float b) {
+    auto backlogs = shard_normalized_backlogs();
+    backlogs[this_shard_id()].store(b, std::memory_order_relaxed);
+    float total = 0;
+    for (unsigned i = 0; i < smp::count; i++) {
+        total += backlogs[i].load(std::memory_order_relaxed);
+    }
+    auto mean = total / smp::count;
+    static constexpr float max_boost = 2.0f;
+    if (mean <= 0 || b <= mean) {
+        return b;
+    }
+    return b * std::min(b / mean, max_boost);
+}
+
 compaction_manager::compaction_manager(compaction_scheduling_group csg, maintenance_scheduling_group msg, size_t available_memory, abort_source& as)
     : _compaction_controller(csg.cpu, csg.io, 250ms, [this, available_memory] () -> float {
         _last_backlog = backlog();
@@ -427,7 +517,7 @@ compaction_manager::compaction_manager(compaction_scheduling_group csg, maintena
             // all strategies.
             return compaction_controller::normalization_factor;
         }
-        return b;
+        return cross_shard_balanced_backlog(b);
     })
     , _backlog_manager(_compaction_controller)
     , _maintenance_sg(msg)
@@ -596,6 +686,8 @@ void compaction_manager::really_do_stop() {
 
     _state = state::stopped;
     cmlog.info("Asked to stop");
+    // Stop advertising backlog to the other shards' controllers.
+    shard_normalized_backlogs()[this_shard_id()].store(0, std::memory_order_relaxed);
     // Reset the metrics registry
     _metrics.clear();
     _stop_future.emplace(stop_ongoing_compactions("shutdown").then([this] () mutable {
@@ -321,6 +321,13 @@ public:
         _backlog_manager.register_backlog_tracker(backlog_tracker);
     }
 
+    // Engages a foreground I/O pressure feedback signal on the compaction
+    // controller, making it yield shares to foreground reads during pressure
+    // peaks; see backlog_controller::set_io_pressure_source().
+    void set_io_pressure_source(std::function<float()> source) {
+        _compaction_controller.set_io_pressure_source(std::move(source));
+    }
+
     // Propagate replacement of sstables to all ongoing compaction of a given table
     void propagate_replacement(table* t, const std::vector<sstables::shared_sstable>& removed, const std::vector<sstables::shared_sstable>& added);
 
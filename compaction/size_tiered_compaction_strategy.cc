@@ -41,6 +41,9 @@ size_tiered_compaction_strategy_options::size_tiered_compaction_strategy_options
 
     tmp_value = compaction_strategy_impl::get_value(options, COLD_READS_TO_OMIT_KEY);
     cold_reads_to_omit = property_definitions::to_double(COLD_READS_TO_OMIT_KEY, tmp_value, DEFAULT_COLD_READS_TO_OMIT);
+
+    tmp_value = compaction_strategy_impl::get_value(options, SSTABLE_SIZE_IN_MB_KEY);
+    sstable_size_in_mb = property_definitions::to_long(SSTABLE_SIZE_IN_MB_KEY, tmp_value, DEFAULT_SSTABLE_SIZE_IN_MB);
 }
 
 size_tiered_compaction_strategy_options::size_tiered_compaction_strategy_options() {
@@ -48,6 +51,7 @@ size_tiered_compaction_strategy_options::size_tiered_compaction_strategy_options
     bucket_low = DEFAULT_BUCKET_LOW;
     bucket_high = DEFAULT_BUCKET_HIGH;
     cold_reads_to_omit = DEFAULT_COLD_READS_TO_OMIT;
+    sstable_size_in_mb = DEFAULT_SSTABLE_SIZE_IN_MB;
 }
 
 std::vector<std::pair<sstables::shared_sstable, uint64_t>>
@@ -167,15 +171,24 @@ size_tiered_compaction_strategy::get_sstables_for_compaction(table_state& table_
 
     auto buckets = get_buckets(candidates);
 
+    // Bounding the fragment size makes the job incremental: the output becomes
+    // a run of fragments, and input sstables are released as soon as the data
+    // written so far covers them, instead of only when the whole job finishes.
+    auto max_sstable_bytes = _options.sstable_size_in_mb
+            ? _options.sstable_size_in_mb * 1024 * 1024
+            : compaction_descriptor::default_max_sstable_bytes;
+
     if (is_any_bucket_interesting(buckets, min_threshold)) {
         std::vector<sstables::shared_sstable> most_interesting = most_interesting_bucket(std::move(buckets), min_threshold, max_threshold);
-        return sstables::compaction_descriptor(std::move(most_interesting), table_s.get_sstable_set(), service::get_local_compaction_priority());
+        return sstables::compaction_descriptor(std::move(most_interesting), table_s.get_sstable_set(), service::get_local_compaction_priority(),
+                compaction_descriptor::default_level, max_sstable_bytes);
     }
 
     // If we are not enforcing min_threshold explicitly, try any pair of SStables in the same tier.
     if (!table_s.compaction_enforce_min_threshold() && is_any_bucket_interesting(buckets, 2)) {
         std::vector<sstables::shared_sstable> most_interesting = most_interesting_bucket(std::move(buckets), 2, max_threshold);
-        return sstables::compaction_descriptor(std::move(most_interesting), table_s.get_sstable_set(), service::get_local_compaction_priority());
+        return sstables::compaction_descriptor(std::move(most_interesting), table_s.get_sstable_set(), service::get_local_compaction_priority(),
+                compaction_descriptor::default_level, max_sstable_bytes);
     }
 
     // if there is no sstable to compact in standard way, try compacting single sstable whose droppable tombstone
@@ -195,7 +208,8 @@ size_tiered_compaction_strategy::get_sstables_for_compaction(table_state& table_
         auto it = std::min_element(sstables.begin(), sstables.end(), [] (auto& i, auto& j) {
             return i->get_stats_metadata().min_timestamp < j->get_stats_metadata().min_timestamp;
         });
-        return sstables::compaction_descriptor({ *it }, table_s.get_sstable_set(), service::get_local_compaction_priority());
+        return sstables::compaction_descriptor({ *it }, table_s.get_sstable_set(), service::get_local_compaction_priority(),
+                compaction_descriptor::default_level, max_sstable_bytes);
     }
     return sstables::compaction_descriptor();
 }
@@ -33,15 +33,26 @@ class size_tiered_compaction_strategy_options {
     static constexpr double DEFAULT_BUCKET_LOW = 0.5;
     static constexpr double DEFAULT_BUCKET_HIGH = 1.5;
     static constexpr double DEFAULT_COLD_READS_TO_OMIT = 0.05;
+    // 0 means unlimited, i.e. a compaction writes one sstable per output run.
+    static constexpr uint64_t DEFAULT_SSTABLE_SIZE_IN_MB = 0;
     const sstring MIN_SSTABLE_SIZE_KEY = "min_sstable_size";
     const sstring BUCKET_LOW_KEY = "bucket_low";
     const sstring BUCKET_HIGH_KEY = "bucket_high";
     const sstring COLD_READS_TO_OMIT_KEY = "cold_reads_to_omit";
+    const sstring SSTABLE_SIZE_IN_MB_KEY = "sstable_size_in_mb";
 
     uint64_t min_sstable_size = DEFAULT_MIN_SSTABLE_SIZE;
     double bucket_low = DEFAULT_BUCKET_LOW;
     double bucket_high = DEFAULT_BUCKET_HIGH;
     double cold_reads_to_omit =  DEFAULT_COLD_READS_TO_OMIT;
+    // When set, compactions write their output as a run of fragments of
+    // roughly this size instead of a single big sstable. As each fragment
+    // seals, input sstables whose token range was fully consumed are
+    // released, so once the inputs themselves are fragmented runs the
+    // temporary disk space needed by a job drops from the whole input size
+    // to about one fragment per input run, and the job can be stopped with
+    // correspondingly less work to redo.
+    uint64_t sstable_size_in_mb = DEFAULT_SSTABLE_SIZE_IN_MB;
 public:
     size_tiered_compaction_strategy_options(const std::map<sstring, sstring>& options);
 
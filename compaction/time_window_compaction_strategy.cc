@@ -236,7 +236,15 @@ time_window_compaction_strategy::get_sstables_for_compaction(table_state& table_
     // Find fully expired SSTables. Those will be included no matter what.
     std::unordered_set<shared_sstable> expired;
 
-    if (db_clock::now() - _last_expired_check > _options.expired_sstable_check_frequency) {
+    // The full expiration check walks the overlap graph, which is why it is
+    // rate limited. A metadata-only pre-scan tells us whether it could find
+    // anything at all: when no candidate's max_local_deletion_time has
+    // passed, the check is skipped altogether regardless of the timer, so
+    // TTL-only tables pay nothing between expirations.
+    auto maybe_expired = std::any_of(candidates.begin(), candidates.end(), [&gc_before] (const shared_sstable& sst) {
+        return sst->get_max_local_deletion_time() < gc_before;
+    });
+    if (maybe_expired && db_clock::now() - _last_expired_check > _options.expired_sstable_check_frequency) {
         clogger.debug("TWCS expired check sufficiently far in the past, checking for fully expired SSTables");
         expired = table_s.fully_expired_sstables(candidates);
         _last_expired_check = db_clock::now();
@@ -279,8 +287,13 @@ time_window_compaction_strategy::get_next_non_expired_sstables(table_state& tabl
 
     // if there is no sstable to compact in standard way, try compacting single sstable whose droppable tombstone
     // ratio is greater than threshold.
+    // Sstables already fully past their deletion time are excluded: either
+    // the expiration pass will soon unlink them without reading them, or
+    // overlap with older live data is blocking that, in which case a rewrite
+    // couldn't purge anything either and would just cycle dead data through
+    // the disk.
     auto e = boost::range::remove_if(non_expiring_sstables, [this, &gc_before] (const shared_sstable& sst) -> bool {
-        return !worth_dropping_tombstones(sst, gc_before);
+        return sst->get_max_local_deletion_time() < gc_before || !worth_dropping_tombstones(sst, gc_before);
     });
     non_expiring_sstables.erase(e, non_expiring_sstables.end());
     if (non_expiring_sstables.empty()) {
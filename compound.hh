@@ -39,6 +39,7 @@ private:
     const std::vector<data_type> _types;
     const bool _byte_order_equal;
     const bool _byte_order_comparable;
+    const bool _all_fixed_size;
     const bool _is_reversed;
 public:
     static constexpr bool is_prefixable = AllowPrefixes == allow_prefixes::yes;
@@ -51,7 +52,25 @@ public:
         , _byte_order_equal(std::all_of(_types.begin(), _types.end(), [] (const auto& t) {
                 return t->is_byte_order_equal();
             }))
-        , _byte_order_comparable(false)
+        , _byte_order_comparable([this] {
+                // Each component is serialized prefixed with a 16-bit length, so
+                // a variable-length component would have its length compared
+                // before its value; only fixed-length components can be part of
+                // a memcmp-comparable compound. Note that empty values still
+                // order correctly: the length prefix makes them compare before
+                // any non-empty value, matching the types' comparators.
+                // A reversed component flips the comparison direction, which
+                // compare() only handles for singular compounds.
+                if (_types.size() > 1 && std::any_of(_types.begin(), _types.end(), [] (const auto& t) { return t->is_reversed(); })) {
+                    return false;
+                }
+                return std::all_of(_types.begin(), _types.end(), [] (const auto& t) {
+                    return t->is_byte_order_comparable() && t->value_length_if_fixed().has_value();
+                });
+            }())
+        , _all_fixed_size(std::all_of(_types.begin(), _types.end(), [] (const auto& t) {
+                return t->value_length_if_fixed().has_value();
+            }))
         , _is_reversed(_types.size() == 1 && _types[0]->is_reversed())
     { }
 
@@ -263,10 +282,43 @@ public:
                 return compare_unsigned(b1, b2);
             }
         }
-        return lexicographical_tri_compare(_types.begin(), _types.end(),
-            begin(b1), end(b1), begin(b2), end(b2), [] (auto&& type, auto&& v1, auto&& v2) {
-                return type->compare(v1, v2);
-            });
+        auto general_compare = [&] {
+            return lexicographical_tri_compare(_types.begin(), _types.end(),
+                begin(b1), end(b1), begin(b2), end(b2), [] (auto&& type, auto&& v1, auto&& v2) {
+                    return type->compare(v1, v2);
+                });
+        };
+        if (_all_fixed_size) {
+            // All components have a fixed size, so instead of parsing the
+            // length-prefixed stream both keys can be sliced at precomputed
+            // offsets, with one bounds check per component pair. Keys can
+            // still be proper prefixes of the component sequence, and a
+            // stored length can deviate from the declared one (empty
+            // values), in which case we defer to the parsing path.
+            bytes_view v1 = b1;
+            bytes_view v2 = b2;
+            for (const auto& t : _types) {
+                if (v1.empty() || v2.empty()) {
+                    return (!v1.empty()) <=> (!v2.empty());
+                }
+                const size_t len = *t->value_length_if_fixed();
+                if (v1.size() < sizeof(size_type) + len || v2.size() < sizeof(size_type) + len) {
+                    return general_compare();
+                }
+                const auto l1 = read_simple<size_type>(v1);
+                const auto l2 = read_simple<size_type>(v2);
+                if (l1 != len || l2 != len) {
+                    return general_compare();
+                }
+                if (auto c = t->compare(bytes_view(v1.data(), len), bytes_view(v2.data(), len)); c != 0) {
+                    return c;
+                }
+                v1.remove_prefix(len);
+                v2.remove_prefix(len);
+            }
+            return std::strong_ordering::equal;
+        }
+        return general_compare();
     }
     // Retruns true iff given prefix has no missing components
     bool is_full(managed_bytes_view v) const {
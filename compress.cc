@@ -73,6 +73,18 @@ std::map<sstring, sstring> compressor::options() const {
     return {};
 }
 
+bool compressor::wants_dictionary_training() const {
+    return false;
+}
+
+compressor::ptr_type compressor::train_dictionary(const std::vector<bytes>&) const {
+    return nullptr;
+}
+
+compressor::ptr_type compressor::adjust_for_backlog(float) const {
+    return nullptr;
+}
+
 compressor::ptr_type compressor::create(const sstring& name, const opt_getter& opts) {
     if (name.empty()) {
         return {};
@@ -23,11 +23,13 @@
 
 #include <map>
 #include <set>
+#include <vector>
 
 #include <seastar/core/future.hh>
 #include <seastar/core/shared_ptr.hh>
 #include <seastar/core/sstring.hh>
 
+#include "bytes.hh"
 #include "exceptions/exceptions.hh"
 
 
@@ -55,6 +57,29 @@ public:
      */
     virtual size_t compress_max_size(size_t input_len) const = 0;
 
+    /**
+     * Returns true if this compressor wants a dictionary trained on samples
+     * of the data it is about to compress (see train_dictionary()).
+     */
+    virtual bool wants_dictionary_training() const;
+    /**
+     * Trains a compression dictionary on the given sample buffers and returns
+     * a new compressor instance using it, or null if training is unsupported
+     * or failed (e.g. too few samples). The dictionary is carried in the
+     * returned instance's options(), so it is persisted along with the other
+     * compression parameters and recovered on the decompression side.
+     */
+    virtual ptr_type train_dictionary(const std::vector<bytes>& samples) const;
+
+    /**
+     * Returns a copy of this compressor re-tuned for the given backlog
+     * pressure in [0, 1] (0 = idle, 1 = heavily backlogged), or null if the
+     * compressor has no configured trade-off between speed and ratio. The
+     * chosen tuning is carried in the returned instance's options(), so it
+     * is persisted along with the other compression parameters.
+     */
+    virtual ptr_type adjust_for_backlog(float pressure) const;
+
     /**
      * Returns accepted option names for this compressor
      */
@@ -112,6 +137,9 @@ public:
     ~compression_parameters();
 
     compressor_ptr get_compressor() const { return _compressor; }
+    // Replaces the compressor, e.g. with a dictionary-trained instance of
+    // the same algorithm. Other parameters (chunk length etc.) are kept.
+    void set_compressor(compressor_ptr c) { _compressor = std::move(c); }
     int32_t chunk_length() const { return _chunk_length.value_or(int(DEFAULT_CHUNK_LENGTH)); }
     double crc_check_chance() const { return _crc_check_chance.value_or(double(DEFAULT_CRC_CHECK_CHANCE)); }
 
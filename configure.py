@@ -553,6 +553,7 @@ perf_tests = set([
     'test/perf/perf_idl',
     'test/perf/perf_vint',
     'test/perf/perf_big_decimal',
+    'test/perf/perf_base64',
 ])
 
 raft_tests = set([
@@ -728,6 +729,7 @@ scylla_core = (['database.cc',
                 'compaction/leveled_compaction_strategy.cc',
                 'compaction/time_window_compaction_strategy.cc',
                 'compaction/compaction_manager.cc',
+                'sstables/component_io_stats.cc',
                 'sstables/integrity_checked_file_impl.cc',
                 'sstables/prepended_input_stream.cc',
                 'sstables/m_format_read_helpers.cc',
@@ -819,6 +821,7 @@ scylla_core = (['database.cc',
                 'cql3/statements/list_service_level_attachments_statement.cc',
                 'cql3/update_parameters.cc',
                 'cql3/util.cc',
+                'cql3/fast_cql_parser.cc',
                 'cql3/ut_name.cc',
                 'cql3/role_name.cc',
                 'thrift/handler.cc',
@@ -869,6 +872,7 @@ scylla_core = (['database.cc',
                 'db/commitlog/commitlog.cc',
                 'db/commitlog/commitlog_replayer.cc',
                 'db/commitlog/commitlog_entry.cc',
+                'db/cache_warmup.cc',
                 'db/data_listeners.cc',
                 'db/hints/manager.cc',
                 'db/hints/resource_manager.cc',
@@ -934,6 +938,7 @@ scylla_core = (['database.cc',
                 'locator/ec2_multi_region_snitch.cc',
                 'locator/gce_snitch.cc',
                 'message/messaging_service.cc',
+                'message/stream_compressor.cc',
                 'service/client_state.cc',
                 'service/storage_service.cc',
                 'service/misc_services.cc',
@@ -1005,6 +1010,10 @@ scylla_core = (['database.cc',
                 'utils/like_matcher.cc',
                 'utils/error_injection.cc',
                 'utils/build_id.cc',
+                'utils/numa_locality.cc',
+                'utils/cpu_profiler.cc',
+                'utils/stall_fingerprints.cc',
+                'utils/write_path_trace.cc',
                 'mutation_writer/timestamp_based_splitting_writer.cc',
                 'mutation_writer/shard_based_splitting_writer.cc',
                 'mutation_writer/partition_based_splitting_writer.cc',
@@ -1060,6 +1069,8 @@ api = ['api/api.cc',
        Json2Code('api/api-doc/config.json'),
        'api/error_injection.cc',
        Json2Code('api/api-doc/error_injection.json'),
+       'api/cpu_profiler.cc',
+       Json2Code('api/api-doc/cpu_profiler.json'),
        ]
 
 alternator = [
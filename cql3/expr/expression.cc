@@ -382,11 +382,15 @@ bool like(const column_value& cv, const raw_value_view& pattern, const column_va
                 format("LIKE is allowed only on string types, which {} is not", cv.col->name_as_text()));
     }
     auto value = get_value(cv, bag);
-    // TODO: reuse matchers.
     if (pattern && value) {
         return value->with_linearized([&pattern] (bytes_view linearized_value) {
             return pattern.with_linearized([linearized_value] (bytes_view linearized_pattern) {
-                return like_matcher(linearized_pattern)(linearized_value);
+                // Reuse the matcher across rows: reset() keeps the compiled
+                // pattern when it hasn't changed, which is the common case
+                // when filtering a query.
+                static thread_local like_matcher matcher(linearized_pattern);
+                matcher.reset(linearized_pattern);
+                return matcher(linearized_value);
             });
         });
     } else {
@@ -0,0 +1,739 @@
+/*
+ * Copyright (C) 2021-present ScyllaDB
+ */
+
+/*
+ * This file is part of Scylla.
+ *
+ * Scylla is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Scylla is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Scylla.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "cql3/fast_cql_parser.hh"
+
+#include "cql3/attributes.hh"
+#include "cql3/cf_name.hh"
+#include "cql3/column_identifier.hh"
+#include "cql3/expr/expression.hh"
+#include "cql3/operation_impl.hh"
+#include "cql3/selection/raw_selector.hh"
+#include "cql3/single_column_relation.hh"
+#include "cql3/statements/raw/delete_statement.hh"
+#include "cql3/statements/raw/insert_statement.hh"
+#include "cql3/statements/raw/select_statement.hh"
+#include "cql3/statements/raw/update_statement.hh"
+
+#include <algorithm>
+#include <cctype>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+namespace cql3 {
+
+namespace {
+
+// Thrown whenever the query steps outside the supported subset. The top-level
+// entry point translates it into a nullptr return, i.e. "use the full parser".
+struct fallback_to_antlr {};
+
+[[noreturn]] void fail() {
+    throw fallback_to_antlr();
+}
+
+// Words that the ANTLR lexer turns into keyword tokens and that the grammar
+// does not accept back as identifiers (i.e. everything that is not covered by
+// unreserved_keyword in Cql.g). The native type names are unreserved in the
+// grammar, but it rewrites them to their canonical spelling when they are used
+// as identifiers; rather than replicating that quirk we treat them as reserved
+// and let such queries take the general path.
+const std::unordered_set<std::string_view> reserved_words = {
+    "add", "allow", "alter", "and", "apply", "asc", "ascii", "authorize",
+    "batch", "begin", "bigint", "blob", "boolean", "by",
+    "cast", "columnfamily", "counter", "create",
+    "date", "decimal", "default", "delete", "desc", "describe", "double",
+    "drop", "duration",
+    "empty", "entries",
+    "false", "float", "from", "full",
+    "grant",
+    "if", "in", "index", "inet", "infinity", "insert", "int", "into", "is",
+    "keyspace",
+    "limit",
+    "materialized", "modify",
+    "nan", "norecursive", "not", "null",
+    "of", "on", "or", "order",
+    "primary",
+    "rename", "replace", "revoke",
+    "schema", "scylla_clustering_bound", "scylla_counter_shard_list",
+    "scylla_timeuuid_list_index", "select", "set", "smallint",
+    "table", "text", "time", "timestamp", "timeuuid", "tinyint", "to",
+    "token", "true", "truncate",
+    "unlogged", "unset", "update", "use", "using", "uuid",
+    "varchar", "varint", "view",
+    "where", "with",
+};
+
+enum class tk {
+    end,
+    word,           // unquoted identifier or keyword
+    quoted_name,    // "..." (text holds the unescaped content)
+    string_literal, // '...' (text holds the unescaped content)
+    integer,
+    floating_point,
+    hexnumber,
+    uuid,
+    qmark,
+    colon,
+    comma,
+    dot,
+    semicolon,
+    star,
+    lparen,
+    rparen,
+    eq,
+    lt,
+    lte,
+    gt,
+    gte,
+    neq,
+};
+
+struct token {
+    tk kind;
+    std::string_view raw;   // the token as it appears in the query
+    sstring text;           // unescaped content for quoted tokens
+};
+
+bool is_hex_digit(char c) {
+    return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F');
+}
+
+bool is_word_char(char c) {
+    return std::isalnum(static_cast<unsigned char>(c)) || c == '_';
+}
+
+// Matches the fixed-width UUID token of the lexer (8-4-4-4-12 hex digits).
+bool is_uuid_at(std::string_view s) {
+    if (s.size() < 36) {
+        return false;
+    }
+    for (size_t i = 0; i < 36; ++i) {
+        if (i == 8 || i == 13 || i == 18 || i == 23) {
+            if (s[i] != '-') {
+                return false;
+            }
+        } else if (!is_hex_digit(s[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Case-insensitive comparison of a token against a (lower-case) keyword.
+bool word_is(const token& t, std::string_view kw) {
+    if (t.kind != tk::word || t.raw.size() != kw.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < kw.size(); ++i) {
+        if (std::tolower(static_cast<unsigned char>(t.raw[i])) != kw[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool is_reserved(const token& t) {
+    sstring lowered(t.raw);
+    std::transform(lowered.begin(), lowered.end(), lowered.begin(), ::tolower);
+    return reserved_words.contains(std::string_view(lowered));
+}
+
+class fast_parser {
+    std::vector<token> _tokens;
+    size_t _pos = 0;
+    // Bind markers in order of appearance, nullptr for anonymous ones;
+    // mirrors _bind_variables of the generated parser.
+    std::vector<::shared_ptr<column_identifier>> _bind_var_names;
+public:
+    explicit fast_parser(std::string_view query) {
+        lex(query);
+    }
+
+    std::unique_ptr<statements::raw::parsed_statement> parse() {
+        std::unique_ptr<statements::raw::parsed_statement> stmt;
+        auto& t = peek();
+        if (word_is(t, "select")) {
+            stmt = parse_select();
+        } else if (word_is(t, "insert")) {
+            stmt = parse_insert();
+        } else if (word_is(t, "update")) {
+            stmt = parse_update();
+        } else if (word_is(t, "delete")) {
+            stmt = parse_delete();
+        } else {
+            fail();
+        }
+        stmt->set_bound_variables(_bind_var_names);
+        return stmt;
+    }
+
+private:
+    void lex(std::string_view s);
+
+    void add(tk kind, std::string_view raw, sstring text = {}) {
+        _tokens.push_back(token{kind, raw, std::move(text)});
+    }
+
+    const token& peek() const {
+        return _tokens[_pos];
+    }
+
+    const token& advance() {
+        auto& t = _tokens[_pos];
+        if (t.kind != tk::end) {
+            ++_pos;
+        }
+        return t;
+    }
+
+    bool accept(tk kind) {
+        if (peek().kind != kind) {
+            return false;
+        }
+        ++_pos;
+        return true;
+    }
+
+    void expect(tk kind) {
+        if (!accept(kind)) {
+            fail();
+        }
+    }
+
+    bool try_keyword(std::string_view kw) {
+        if (!word_is(peek(), kw)) {
+            return false;
+        }
+        ++_pos;
+        return true;
+    }
+
+    void expect_keyword(std::string_view kw) {
+        if (!try_keyword(kw)) {
+            fail();
+        }
+    }
+
+    expr::expression new_bind_variable(::shared_ptr<column_identifier> name, expr::bind_variable::shape_type shape) {
+        auto marker = expr::bind_variable{shape, int32_t(_bind_var_names.size())};
+        _bind_var_names.push_back(std::move(name));
+        return marker;
+    }
+
+    // A name part usable wherever the grammar accepts IDENT, QUOTED_NAME or an
+    // unreserved keyword. Returns the identifier text and whether to keep case.
+    std::pair<sstring, bool> parse_name() {
+        auto& t = peek();
+        if (t.kind == tk::word && !is_reserved(t)) {
+            advance();
+            return {sstring(t.raw), false};
+        }
+        if (t.kind == tk::quoted_name) {
+            advance();
+            return {t.text, true};
+        }
+        fail();
+    }
+
+    ::shared_ptr<column_identifier::raw> parse_column_identifier() {
+        auto [text, keep_case] = parse_name();
+        return ::make_shared<column_identifier::raw>(std::move(text), keep_case);
+    }
+
+    ::shared_ptr<column_identifier> parse_identifier() {
+        auto [text, keep_case] = parse_name();
+        return ::make_shared<column_identifier>(std::move(text), keep_case);
+    }
+
+    cf_name parse_cf_name() {
+        cf_name name;
+        auto [text, keep_case] = parse_name();
+        if (accept(tk::dot)) {
+            name.set_keyspace(text, keep_case);
+            auto [cf, cf_keep_case] = parse_name();
+            name.set_column_family(cf, cf_keep_case);
+        } else {
+            name.set_column_family(text, keep_case);
+        }
+        return name;
+    }
+
+    expr::expression parse_term() {
+        auto& t = peek();
+        switch (t.kind) {
+        case tk::string_literal:
+            advance();
+            return expr::untyped_constant{expr::untyped_constant::string, t.text};
+        case tk::integer:
+            advance();
+            return expr::untyped_constant{expr::untyped_constant::integer, sstring(t.raw)};
+        case tk::floating_point:
+            advance();
+            return expr::untyped_constant{expr::untyped_constant::floating_point, sstring(t.raw)};
+        case tk::hexnumber:
+            advance();
+            return expr::untyped_constant{expr::untyped_constant::hex, sstring(t.raw)};
+        case tk::uuid:
+            advance();
+            return expr::untyped_constant{expr::untyped_constant::uuid, sstring(t.raw)};
+        case tk::qmark:
+            advance();
+            return new_bind_variable(nullptr, expr::bind_variable::shape_type::scalar);
+        case tk::colon:
+            advance();
+            return new_bind_variable(parse_identifier(), expr::bind_variable::shape_type::scalar);
+        case tk::word:
+            if (word_is(t, "true") || word_is(t, "false")) {
+                advance();
+                return expr::untyped_constant{expr::untyped_constant::boolean, sstring(t.raw)};
+            }
+            if (word_is(t, "null")) {
+                advance();
+                return expr::null{};
+            }
+            // Function calls, durations, NaN/Infinity, ... - not supported.
+            fail();
+        default:
+            // Collections, tuples and the like never get this far - their
+            // punctuation is already rejected by the lexer.
+            fail();
+        }
+    }
+
+    // The intValue rule: an undecorated integer or a bind marker.
+    expr::expression parse_int_value() {
+        auto& t = peek();
+        switch (t.kind) {
+        case tk::integer:
+            advance();
+            return expr::untyped_constant{expr::untyped_constant::integer, sstring(t.raw)};
+        case tk::qmark:
+            advance();
+            return new_bind_variable(nullptr, expr::bind_variable::shape_type::scalar);
+        case tk::colon:
+            advance();
+            return new_bind_variable(parse_identifier(), expr::bind_variable::shape_type::scalar);
+        default:
+            fail();
+        }
+    }
+
+    relation_ptr parse_relation() {
+        auto name = parse_column_identifier();
+        expr::oper_t op;
+        switch (peek().kind) {
+        case tk::eq:  op = expr::oper_t::EQ; break;
+        case tk::lt:  op = expr::oper_t::LT; break;
+        case tk::lte: op = expr::oper_t::LTE; break;
+        case tk::gt:  op = expr::oper_t::GT; break;
+        case tk::gte: op = expr::oper_t::GTE; break;
+        case tk::neq: op = expr::oper_t::NEQ; break;
+        default:
+            if (try_keyword("in")) {
+                return parse_in_relation(std::move(name));
+            }
+            // TOKEN, IS NOT NULL, CONTAINS, LIKE, collection element access
+            // and multi-column relations take the general path.
+            fail();
+        }
+        advance();
+        return ::make_shared<single_column_relation>(std::move(name), op, parse_term());
+    }
+
+    relation_ptr parse_in_relation(::shared_ptr<column_identifier::raw> name) {
+        if (accept(tk::qmark)) {
+            auto marker = new_bind_variable(nullptr, expr::bind_variable::shape_type::scalar_in);
+            return ::make_shared<single_column_relation>(std::move(name), expr::oper_t::IN, std::move(marker));
+        }
+        if (accept(tk::colon)) {
+            auto marker = new_bind_variable(parse_identifier(), expr::bind_variable::shape_type::scalar_in);
+            return ::make_shared<single_column_relation>(std::move(name), expr::oper_t::IN, std::move(marker));
+        }
+        expect(tk::lparen);
+        std::vector<expr::expression> values;
+        if (peek().kind != tk::rparen) {
+            do {
+                values.push_back(parse_term());
+            } while (accept(tk::comma));
+        }
+        expect(tk::rparen);
+        return single_column_relation::create_in_relation(std::move(name), std::move(values));
+    }
+
+    std::vector<relation_ptr> parse_where_clause() {
+        std::vector<relation_ptr> relations;
+        do {
+            relations.push_back(parse_relation());
+        } while (try_keyword("and"));
+        return relations;
+    }
+
+    void parse_using_clause(attributes::raw& attrs) {
+        do {
+            if (try_keyword("timestamp")) {
+                attrs.timestamp = parse_int_value();
+            } else if (try_keyword("ttl")) {
+                attrs.time_to_live = parse_int_value();
+            } else {
+                // USING TIMEOUT takes a duration term.
+                fail();
+            }
+        } while (try_keyword("and"));
+    }
+
+    // Trailing semicolons followed by end of input, as in the query rule.
+    void parse_end() {
+        while (accept(tk::semicolon)) {
+        }
+        if (peek().kind != tk::end) {
+            fail();
+        }
+    }
+
+    ::shared_ptr<selection::raw_selector> parse_selector() {
+        auto id = parse_column_identifier();
+        if (peek().kind == tk::lparen || peek().kind == tk::dot) {
+            // A function call or a field selection.
+            fail();
+        }
+        ::shared_ptr<column_identifier> alias;
+        if (try_keyword("as")) {
+            alias = parse_identifier();
+        }
+        return ::make_shared<selection::raw_selector>(expr::unresolved_identifier{std::move(id)}, std::move(alias));
+    }
+
+    std::unique_ptr<statements::raw::select_statement> parse_select() {
+        expect_keyword("select");
+        bool is_json = try_keyword("json");
+        bool is_distinct = try_keyword("distinct");
+        std::vector<::shared_ptr<selection::raw_selector>> select_clause;
+        if (!accept(tk::star)) {
+            do {
+                select_clause.push_back(parse_selector());
+            } while (accept(tk::comma));
+        }
+        expect_keyword("from");
+        auto name = parse_cf_name();
+        std::vector<relation_ptr> where_clause;
+        if (try_keyword("where")) {
+            where_clause = parse_where_clause();
+        }
+        if (word_is(peek(), "group")) {
+            fail();
+        }
+        statements::raw::select_statement::parameters::orderings_type orderings;
+        if (try_keyword("order")) {
+            expect_keyword("by");
+            do {
+                auto c = parse_column_identifier();
+                bool reversed = try_keyword("desc");
+                if (!reversed) {
+                    try_keyword("asc");
+                }
+                orderings.emplace_back(std::move(c), reversed);
+            } while (accept(tk::comma));
+        }
+        std::optional<expr::expression> per_partition_limit;
+        if (try_keyword("per")) {
+            expect_keyword("partition");
+            expect_keyword("limit");
+            per_partition_limit = parse_int_value();
+        }
+        std::optional<expr::expression> limit;
+        if (try_keyword("limit")) {
+            limit = parse_int_value();
+        }
+        bool allow_filtering = false;
+        if (try_keyword("allow")) {
+            expect_keyword("filtering");
+            allow_filtering = true;
+        }
+        bool bypass_cache = false;
+        if (try_keyword("bypass")) {
+            expect_keyword("cache");
+            bypass_cache = true;
+        }
+        if (word_is(peek(), "using")) {
+            // USING TIMEOUT
+            fail();
+        }
+        parse_end();
+        auto params = make_lw_shared<statements::raw::select_statement::parameters>(
+                std::move(orderings), is_distinct, allow_filtering, is_json, bypass_cache);
+        return std::make_unique<statements::raw::select_statement>(std::move(name), std::move(params),
+                std::move(select_clause), std::move(where_clause), std::move(limit),
+                std::move(per_partition_limit),
+                std::vector<::shared_ptr<column_identifier::raw>>(),
+                std::make_unique<attributes::raw>());
+    }
+
+    std::unique_ptr<statements::raw::insert_statement> parse_insert() {
+        expect_keyword("insert");
+        expect_keyword("into");
+        auto name = parse_cf_name();
+        // The INSERT JSON form takes the general path.
+        expect(tk::lparen);
+        std::vector<::shared_ptr<column_identifier::raw>> column_names;
+        do {
+            column_names.push_back(parse_column_identifier());
+        } while (accept(tk::comma));
+        expect(tk::rparen);
+        expect_keyword("values");
+        expect(tk::lparen);
+        std::vector<expr::expression> values;
+        do {
+            values.push_back(parse_term());
+        } while (accept(tk::comma));
+        expect(tk::rparen);
+        bool if_not_exists = false;
+        if (try_keyword("if")) {
+            expect_keyword("not");
+            expect_keyword("exists");
+            if_not_exists = true;
+        }
+        auto attrs = std::make_unique<attributes::raw>();
+        if (try_keyword("using")) {
+            parse_using_clause(*attrs);
+        }
+        parse_end();
+        return std::make_unique<statements::raw::insert_statement>(std::move(name), std::move(attrs),
+                std::move(column_names), std::move(values), if_not_exists);
+    }
+
+    std::unique_ptr<statements::raw::update_statement> parse_update() {
+        expect_keyword("update");
+        auto name = parse_cf_name();
+        auto attrs = std::make_unique<attributes::raw>();
+        if (try_keyword("using")) {
+            parse_using_clause(*attrs);
+        }
+        expect_keyword("set");
+        std::vector<std::pair<::shared_ptr<column_identifier::raw>, std::unique_ptr<operation::raw_update>>> operations;
+        do {
+            auto key = parse_column_identifier();
+            // Setting the same column twice needs the compatibility check of
+            // the general parser.
+            for (auto& [id, op] : operations) {
+                if (*id == *key) {
+                    fail();
+                }
+            }
+            expect(tk::eq);
+            operations.emplace_back(std::move(key), std::make_unique<operation::set_value>(parse_term()));
+        } while (accept(tk::comma));
+        expect_keyword("where");
+        auto where_clause = parse_where_clause();
+        if (word_is(peek(), "if")) {
+            // LWT conditions
+            fail();
+        }
+        parse_end();
+        return std::make_unique<statements::raw::update_statement>(std::move(name), std::move(attrs),
+                std::move(operations), std::move(where_clause),
+                statements::raw::modification_statement::conditions_vector(), false);
+    }
+
+    std::unique_ptr<statements::raw::delete_statement> parse_delete() {
+        expect_keyword("delete");
+        std::vector<std::unique_ptr<operation::raw_deletion>> deletions;
+        if (!word_is(peek(), "from")) {
+            do {
+                auto c = parse_column_identifier();
+                if (peek().kind == tk::dot) {
+                    // Field deletion; element deletion is already rejected by
+                    // the lexer ('[').
+                    fail();
+                }
+                deletions.push_back(std::make_unique<operation::column_deletion>(std::move(c)));
+            } while (accept(tk::comma));
+        }
+        expect_keyword("from");
+        auto name = parse_cf_name();
+        auto attrs = std::make_unique<attributes::raw>();
+        if (try_keyword("using")) {
+            parse_using_clause(*attrs);
+        }
+        expect_keyword("where");
+        auto where_clause = parse_where_clause();
+        if (word_is(peek(), "if")) {
+            fail();
+        }
+        parse_end();
+        return std::make_unique<statements::raw::delete_statement>(std::move(name), std::move(attrs),
+                std::move(deletions), std::move(where_clause),
+                statements::raw::modification_statement::conditions_vector(), false);
+    }
+};
+
+void fast_parser::lex(std::string_view s) {
+    size_t i = 0;
+    while (i < s.size()) {
+        char c = s[i];
+        if (c == ' ' || c == '\t' || c == '\r' || c == '\n') {
+            ++i;
+            continue;
+        }
+        // UUIDs first - both words and numbers can start with hex digits.
+        if (is_hex_digit(c) && is_uuid_at(s.substr(i))) {
+            add(tk::uuid, s.substr(i, 36));
+            i += 36;
+            continue;
+        }
+        if (std::isalpha(static_cast<unsigned char>(c))) {
+            size_t j = i + 1;
+            while (j < s.size() && is_word_char(s[j])) {
+                ++j;
+            }
+            add(tk::word, s.substr(i, j - i));
+            i = j;
+            continue;
+        }
+        if (c == '0' && i + 1 < s.size() && (s[i + 1] == 'x' || s[i + 1] == 'X')) {
+            size_t j = i + 2;
+            while (j < s.size() && is_hex_digit(s[j])) {
+                ++j;
+            }
+            if (j < s.size() && is_word_char(s[j])) {
+                fail();
+            }
+            add(tk::hexnumber, s.substr(i, j - i));
+            i = j;
+            continue;
+        }
+        if (std::isdigit(static_cast<unsigned char>(c))
+                || (c == '-' && i + 1 < s.size() && std::isdigit(static_cast<unsigned char>(s[i + 1])))) {
+            size_t j = i + (c == '-');
+            while (j < s.size() && std::isdigit(static_cast<unsigned char>(s[j]))) {
+                ++j;
+            }
+            bool is_float = false;
+            if (j < s.size() && s[j] == '.') {
+                is_float = true;
+                ++j;
+                while (j < s.size() && std::isdigit(static_cast<unsigned char>(s[j]))) {
+                    ++j;
+                }
+            }
+            if (j < s.size() && (s[j] == 'e' || s[j] == 'E')) {
+                size_t k = j + 1;
+                if (k < s.size() && (s[k] == '+' || s[k] == '-')) {
+                    ++k;
+                }
+                if (k < s.size() && std::isdigit(static_cast<unsigned char>(s[k]))) {
+                    is_float = true;
+                    j = k;
+                    while (j < s.size() && std::isdigit(static_cast<unsigned char>(s[j]))) {
+                        ++j;
+                    }
+                }
+            }
+            if (j < s.size() && is_word_char(s[j])) {
+                // Durations and other number-prefixed tokens.
+                fail();
+            }
+            add(is_float ? tk::floating_point : tk::integer, s.substr(i, j - i));
+            i = j;
+            continue;
+        }
+        if (c == '\'' || c == '"') {
+            size_t j = i + 1;
+            std::string text;
+            while (true) {
+                if (j == s.size()) {
+                    fail(); // unterminated literal
+                }
+                if (s[j] == c) {
+                    if (j + 1 < s.size() && s[j + 1] == c) {
+                        // A doubled quote stands for itself.
+                        text += c;
+                        j += 2;
+                        continue;
+                    }
+                    ++j;
+                    break;
+                }
+                text += s[j++];
+            }
+            if (c == '"' && text.empty()) {
+                fail(); // QUOTED_NAME requires at least one character
+            }
+            add(c == '\'' ? tk::string_literal : tk::quoted_name, s.substr(i, j - i), sstring(text));
+            i = j;
+            continue;
+        }
+        switch (c) {
+        case '?': add(tk::qmark, s.substr(i, 1)); break;
+        case ':': add(tk::colon, s.substr(i, 1)); break;
+        case ',': add(tk::comma, s.substr(i, 1)); break;
+        case '.': add(tk::dot, s.substr(i, 1)); break;
+        case ';': add(tk::semicolon, s.substr(i, 1)); break;
+        case '*': add(tk::star, s.substr(i, 1)); break;
+        case '(': add(tk::lparen, s.substr(i, 1)); break;
+        case ')': add(tk::rparen, s.substr(i, 1)); break;
+        case '=': add(tk::eq, s.substr(i, 1)); break;
+        case '<':
+            if (i + 1 < s.size() && s[i + 1] == '=') {
+                add(tk::lte, s.substr(i, 2));
+                ++i;
+            } else {
+                add(tk::lt, s.substr(i, 1));
+            }
+            break;
+        case '>':
+            if (i + 1 < s.size() && s[i + 1] == '=') {
+                add(tk::gte, s.substr(i, 2));
+                ++i;
+            } else {
+                add(tk::gt, s.substr(i, 1));
+            }
+            break;
+        case '!':
+            if (i + 1 < s.size() && s[i + 1] == '=') {
+                add(tk::neq, s.substr(i, 2));
+                ++i;
+            } else {
+                fail();
+            }
+            break;
+        default:
+            // Everything else - comments, pg-style strings, collection
+            // punctuation, arithmetic - is outside the subset.
+            fail();
+        }
+        ++i;
+    }
+    add(tk::end, std::string_view());
+}
+
+} // anonymous namespace
+
+std::unique_ptr<statements::raw::parsed_statement> try_fast_parse(std::string_view query) {
+    try {
+        return fast_parser(query).parse();
+    } catch (const fallback_to_antlr&) {
+        return nullptr;
+    }
+}
+
+}
@@ -0,0 +1,42 @@
+/*
+ * Copyright (C) 2021-present ScyllaDB
+ */
+
+/*
+ * This file is part of Scylla.
+ *
+ * Scylla is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Scylla is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Scylla.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "cql3/statements/raw/parsed_statement.hh"
+
+#include <memory>
+#include <string_view>
+
+namespace cql3 {
+
+/// Hand-written recursive-descent parser for the common shapes of
+/// SELECT/INSERT/UPDATE/DELETE statements. It builds exactly the same raw
+/// statement AST as the ANTLR-generated parser but avoids the allocation and
+/// indirection overhead of the generated code.
+///
+/// Returns nullptr whenever the query uses any construct outside the
+/// supported subset (or is not even valid CQL); the caller is then expected
+/// to run the full ANTLR parser, which remains the single authority on what
+/// is and is not accepted.
+std::unique_ptr<statements::raw::parsed_statement> try_fast_parse(std::string_view query);
+
+}
@@ -95,8 +95,7 @@ public:
                 encoded_row.write("\\\"", 2);
             }
             encoded_row.write("\": ", 3);
-            sstring row_sstring = to_json_string(*_selector_types[i], parameters[i]);
-            encoded_row.write(row_sstring.c_str(), row_sstring.size());
+            to_json(*_selector_types[i], parameters[i], encoded_row);
         }
         encoded_row.write("}", 1);
         return bytes(encoded_row.linearize());
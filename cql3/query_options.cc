@@ -54,13 +54,13 @@ thread_local const query_options::specific_options query_options::specific_optio
 
 thread_local query_options query_options::DEFAULT{default_cql_config,
     db::consistency_level::ONE, std::nullopt,
-    std::vector<cql3::raw_value_view>(), false, query_options::specific_options::DEFAULT, cql_serialization_format::latest()};
+    cql3::raw_value_view_vector(), false, query_options::specific_options::DEFAULT, cql_serialization_format::latest()};
 
 query_options::query_options(const cql_config& cfg,
                            db::consistency_level consistency,
                            std::optional<std::vector<sstring_view>> names,
                            std::vector<cql3::raw_value> values,
-                           std::vector<cql3::raw_value_view> value_views,
+                           cql3::raw_value_view_vector value_views,
                            bool skip_metadata,
                            specific_options options,
                            cql_serialization_format sf)
@@ -97,7 +97,7 @@ query_options::query_options(const cql_config& cfg,
 query_options::query_options(const cql_config& cfg,
                              db::consistency_level consistency,
                              std::optional<std::vector<sstring_view>> names,
-                             std::vector<cql3::raw_value_view> value_views,
+                             cql3::raw_value_view_vector value_views,
                              bool skip_metadata,
                              specific_options options,
                              cql_serialization_format sf)
@@ -162,7 +162,7 @@ void query_options::prepare(const std::vector<lw_shared_ptr<column_specification
     }
 
     auto& names = *_names;
-    std::vector<cql3::raw_value_view> ordered_values;
+    cql3::raw_value_view_vector ordered_values;
     ordered_values.reserve(specs.size());
     for (auto&& spec : specs) {
         auto& spec_name = spec->name->text();
@@ -178,6 +178,7 @@ void query_options::prepare(const std::vector<lw_shared_ptr<column_specification
 
 void query_options::fill_value_views()
 {
+    _value_views.reserve(_values.size());
     for (auto&& value : _values) {
         _value_views.emplace_back(value.to_view());
     }
@@ -78,7 +78,7 @@ private:
     const db::consistency_level _consistency;
     const std::optional<std::vector<sstring_view>> _names;
     std::vector<cql3::raw_value> _values;
-    std::vector<cql3::raw_value_view> _value_views;
+    cql3::raw_value_view_vector _value_views;
     const bool _skip_metadata;
     const specific_options _options;
     cql_serialization_format _cql_serialization_format;
@@ -147,14 +147,14 @@ public:
                            db::consistency_level consistency,
                            std::optional<std::vector<sstring_view>> names,
                            std::vector<cql3::raw_value> values,
-                           std::vector<cql3::raw_value_view> value_views,
+                           cql3::raw_value_view_vector value_views,
                            bool skip_metadata,
                            specific_options options,
                            cql_serialization_format sf);
     explicit query_options(const cql_config& cfg,
                            db::consistency_level consistency,
                            std::optional<std::vector<sstring_view>> names,
-                           std::vector<cql3::raw_value_view> value_views,
+                           cql3::raw_value_view_vector value_views,
                            bool skip_metadata,
                            specific_options options,
                            cql_serialization_format sf);
@@ -256,7 +256,7 @@ public:
         return _names;
     }
 
-    const std::vector<cql3::raw_value_view>& get_values() const noexcept {
+    const cql3::raw_value_view_vector& get_values() const noexcept {
         return _value_views;
     }
 
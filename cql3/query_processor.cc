@@ -45,6 +45,7 @@
 
 #include "cql3/CqlParser.hpp"
 #include "cql3/error_collector.hh"
+#include "cql3/fast_cql_parser.hh"
 #include "cql3/statements/batch_statement.hh"
 #include "cql3/statements/modification_statement.hh"
 #include "cql3/util.hh"
@@ -52,6 +53,7 @@
 #include "db/config.hh"
 #include "database.hh"
 #include "hashers.hh"
+#include "utils/write_path_trace.hh"
 
 namespace cql3 {
 
@@ -338,6 +340,12 @@ query_processor::query_processor(service::storage_proxy& proxy, database& db, se
                             sm::description("Counts the total number of LOGGED batches that were executed as UNLOGGED "
                                             "batches.")),
 
+                    sm::make_derive(
+                            "batches_mutation_build_time",
+                            _cql_stats.batches_mutation_build_time_us,
+                            sm::description("Total time (in microseconds) spent building the mutations of CQL BATCH "
+                                            "requests; divide by the batches count for the average per batch.")),
+
                     sm::make_derive(
                             "rows_read",
                             _cql_stats.rows_read,
@@ -606,7 +614,10 @@ prepared_cache_key_type query_processor::compute_thrift_id(
 
 std::unique_ptr<prepared_statement>
 query_processor::get_statement(const sstring_view& query, const service::client_state& client_state) {
+    auto tslot = utils::get_local_write_path_tracer().begin();
     std::unique_ptr<raw::parsed_statement> statement = parse_statement(query);
+    tslot.mark(utils::write_path_tracer::stage::parse);
+    utils::get_local_write_path_tracer().end(tslot);
 
     // Set keyspace for statement that require login
     auto cf_stmt = dynamic_cast<raw::cf_statement*>(statement.get());
@@ -622,6 +633,12 @@ query_processor::get_statement(const sstring_view& query, const service::client_
 std::unique_ptr<raw::parsed_statement>
 query_processor::parse_statement(const sstring_view& query) {
     try {
+        // Common statement shapes are parsed by a hand-written parser, which
+        // is much cheaper than the ANTLR-generated one; it builds the same
+        // AST and returns nullptr for anything outside its subset.
+        if (auto statement = try_fast_parse(query)) {
+            return statement;
+        }
         auto statement = util::do_with_parser(query,  std::mem_fn(&cql3_parser::CqlParser::query));
         if (!statement) {
             throw exceptions::syntax_exception("Parsing failed");
@@ -446,6 +446,43 @@ statement_restrictions::statement_restrictions(database& db,
         _clustering_prefix_restrictions = extract_clustering_prefix_restrictions(*_where, _schema);
         _partition_range_restrictions = extract_partition_range(*_where, _schema);
     }
+    // Analyze the structure of the extracted restrictions now, so that
+    // executions of the prepared statement don't have to rediscover it each
+    // time (see get_partition_key_ranges() and get_clustering_bounds()).
+    if (_partition_range_is_simple && !_partition_range_restrictions.empty()
+            && !has_token(_partition_range_restrictions[0])
+            && _partition_range_restrictions.size() == _schema->partition_key_size()) {
+        _compiled_pk_eqs.reserve(_partition_range_restrictions.size());
+        for (size_t i = 0; i < _partition_range_restrictions.size(); ++i) {
+            auto* binop = expr::as_if<expr::binary_operator>(&_partition_range_restrictions[i]);
+            const expr::column_value* cv;
+            if (!binop || binop->op != expr::oper_t::EQ || !(cv = expr::as_if<expr::column_value>(&binop->lhs))) {
+                // Not a lone EQ (e.g. a conjunction of several EQs on the same
+                // column); leave it to the generic path.
+                _compiled_pk_eqs.clear();
+                break;
+            }
+            _compiled_pk_eqs.push_back(compiled_pk_eq{_schema->position(*cv->col), i});
+        }
+    }
+    if (!_clustering_prefix_restrictions.empty()
+            && find_binop(_clustering_prefix_restrictions[0], expr::is_multi_column)) {
+        _ck_prefix_is_multi_column = true;
+        for (const auto& r : _clustering_prefix_restrictions) {
+            const auto& binop = expr::as<expr::binary_operator>(r);
+            if (expr::is_clustering_order(binop)) {
+                _ck_prefix_has_raw_bounds = true;
+                break;
+            }
+            for (const auto& element : expr::as<expr::tuple_constructor>(binop.lhs).elements) {
+                if (expr::as<expr::column_value>(element).col->type->is_reversed()) {
+                    _ck_prefix_all_natural = false;
+                } else {
+                    _ck_prefix_all_reverse = false;
+                }
+            }
+        }
+    }
     auto& cf = db.find_column_family(schema);
     auto& sim = cf.get_index_manager();
     const expr::allow_local_index allow_local(
@@ -782,8 +819,20 @@ dht::partition_range_vector partition_ranges_from_singles(
         }
     }
     cartesian_product cp(column_values);
-    dht::partition_range_vector ranges(product_size);
-    std::transform(cp.begin(), cp.end(), ranges.begin(), std::bind_front(range_from_bytes, std::ref(schema)));
+    // Materialize the keys first and tokenize them as a batch, which lets
+    // the partitioner hash several keys in parallel.
+    std::vector<partition_key> keys;
+    keys.reserve(product_size);
+    for (auto&& pk : cp) {
+        keys.push_back(partition_key::from_exploded(pk));
+    }
+    auto tokens = schema.get_partitioner().get_tokens(schema, keys);
+    dht::partition_range_vector ranges;
+    ranges.reserve(product_size);
+    for (size_t i = 0; i < keys.size(); ++i) {
+        query::ring_position pos(std::move(tokens[i]), std::move(keys[i]));
+        ranges.push_back(dht::partition_range::make_singular(std::move(pos)));
+    }
     return ranges;
 }
 
@@ -805,6 +854,22 @@ dht::partition_range_vector partition_ranges_from_EQs(
 
 } // anonymous namespace
 
+/// Computes the partition-key range from restrictions precompiled into _compiled_pk_eqs,
+/// evaluating just the RHS term of each column's EQ.  Gives the same result as
+/// partition_ranges_from_EQs() (see possible_lhs_values() for the EQ case it inlines).
+dht::partition_range_vector statement_restrictions::compiled_partition_key_ranges(const query_options& options) const {
+    std::vector<managed_bytes> pk_value(_schema->partition_key_size());
+    for (const auto& eq : _compiled_pk_eqs) {
+        const auto& binop = expr::as<expr::binary_operator>(_partition_range_restrictions[eq.expr_idx]);
+        auto val = expr::evaluate(binop.rhs, options).value.to_managed_bytes_opt();
+        if (!val) {
+            return {}; // All NULL comparisons fail; no column values match.
+        }
+        pk_value[eq.position] = std::move(*val);
+    }
+    return {range_from_bytes(*_schema, pk_value)};
+}
+
 dht::partition_range_vector statement_restrictions::get_partition_key_ranges(const query_options& options) const {
     if (_partition_range_restrictions.empty()) {
         return {dht::partition_range::make_open_ended_both_sides()};
@@ -816,6 +881,8 @@ dht::partition_range_vector statement_restrictions::get_partition_key_ranges(con
                     format("Unexpected size of token restrictions: {}", _partition_range_restrictions.size()));
         }
         return partition_ranges_from_token(_partition_range_restrictions[0], options);
+    } else if (!_compiled_pk_eqs.empty()) {
+        return compiled_partition_key_ranges(options);
     } else if (_partition_range_is_simple) {
         // Special case to avoid extra allocations required for a Cartesian product.
         return partition_ranges_from_EQs(_partition_range_restrictions, options, *_schema);
@@ -1427,22 +1494,12 @@ std::vector<query::clustering_range> statement_restrictions::get_clustering_boun
     if (_clustering_prefix_restrictions.empty()) {
         return {query::clustering_range::make_open_ended_both_sides()};
     }
-    if (find_binop(_clustering_prefix_restrictions[0], expr::is_multi_column)) {
-        bool all_natural = true, all_reverse = true; ///< Whether column types are reversed or natural.
-        for (auto& r : _clustering_prefix_restrictions) { // TODO: move to constructor, do only once.
-            using namespace expr;
-            const auto& binop = expr::as<binary_operator>(r);
-            if (is_clustering_order(binop)) {
-                return {range_from_raw_bounds(_clustering_prefix_restrictions, options, *_schema)};
-            }
-            for (auto& element : expr::as<tuple_constructor>(binop.lhs).elements) {
-                auto& cv = expr::as<column_value>(element);
-                if (cv.col->type->is_reversed()) {
-                    all_natural = false;
-                } else {
-                    all_reverse = false;
-                }
-            }
+    if (_ck_prefix_is_multi_column) {
+        // Whether column types are reversed or natural was determined once, at
+        // preparation time.
+        const bool all_natural = _ck_prefix_all_natural, all_reverse = _ck_prefix_all_reverse;
+        if (_ck_prefix_has_raw_bounds) {
+            return {range_from_raw_bounds(_clustering_prefix_restrictions, options, *_schema)};
         }
         auto bounds = get_multi_column_clustering_bounds(options, _schema, _clustering_prefix_restrictions);
         if (!all_natural && !all_reverse) {
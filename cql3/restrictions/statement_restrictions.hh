@@ -141,6 +141,28 @@ private:
 
     bool _partition_range_is_simple; ///< False iff _partition_range_restrictions imply a Cartesian product.
 
+    /// A single-column EQ restriction on a partition column, precompiled from
+    /// _partition_range_restrictions at preparation time.
+    struct compiled_pk_eq {
+        size_t position; ///< The column's position in the partition key.
+        size_t expr_idx; ///< Index of the restriction in _partition_range_restrictions.
+    };
+
+    /// When every _partition_range_restrictions element is a lone EQ binary operator, one
+    /// compiled_pk_eq per partition column; empty otherwise.  Lets get_partition_key_ranges()
+    /// compute the (single) partition range by just evaluating the RHS terms, without
+    /// re-walking the restriction trees on every execution.
+    std::vector<compiled_pk_eq> _compiled_pk_eqs;
+
+    /// Prepare-time analysis of _clustering_prefix_restrictions, so that
+    /// get_clustering_bounds() does not redo it on every execution.
+    bool _ck_prefix_is_multi_column = false; ///< True iff the atoms are multi-column.
+    bool _ck_prefix_has_raw_bounds = false; ///< True iff some atom is a clustering-order comparison.
+    bool _ck_prefix_all_natural = true; ///< True iff no restricted clustering column is reversed.
+    bool _ck_prefix_all_reverse = true; ///< True iff every restricted clustering column is reversed.
+
+    dht::partition_range_vector compiled_partition_key_ranges(const query_options& options) const;
+
 public:
     /**
      * Creates a new empty <code>StatementRestrictions</code>.
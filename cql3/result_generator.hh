@@ -39,7 +39,10 @@ private:
     class query_result_visitor {
         const schema& _schema;
         std::vector<bytes> _partition_key;
-        std::vector<bytes> _clustering_key;
+        // Views into the clustering key passed to accept_new_row(), valid
+        // only for the duration of that call - which is the only place they
+        // are read. This avoids copying the key of every row.
+        std::vector<managed_bytes_view> _clustering_key;
         uint64_t _partition_row_count = 0;
         uint64_t _total_row_count = 0;
         Visitor& _visitor;
@@ -68,7 +71,10 @@ private:
 
         void accept_new_row(const clustering_key& key, query::result_row_view static_row,
                             query::result_row_view row) {
-            _clustering_key = key.explode(_schema);
+            _clustering_key.clear();
+            for (managed_bytes_view c : key.components()) {
+                _clustering_key.push_back(c);
+            }
             accept_new_row(static_row, row);
         }
         void accept_new_row(query::result_row_view static_row, query::result_row_view row) {
@@ -82,7 +88,7 @@ private:
                     break;
                 case column_kind::clustering_key:
                     if (_clustering_key.size() > def->component_index()) {
-                        _visitor.accept_value(query::result_bytes_view(bytes_view(_clustering_key[def->component_index()])));
+                        _visitor.accept_value(_clustering_key[def->component_index()]);
                     } else {
                         _visitor.accept_value(std::nullopt);
                     }
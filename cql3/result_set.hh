@@ -41,6 +41,7 @@
 
 #pragma once
 
+#include <optional>
 #include <vector>
 #include "utils/chunked_vector.hh"
 #include "enum_set.hh"
@@ -85,6 +86,16 @@ public:
             : _names(std::move(names))
             , _column_count(_names.size())
         { }
+
+        // The serialized form of the column specifications, as they appear in
+        // the native protocol's result-set metadata. Filled in by the
+        // transport the first time this column set is put on the wire, so
+        // that subsequent responses of the same (usually prepared) statement
+        // append ready-made bytes instead of re-encoding every column
+        // specification. Valid because the column set doesn't change once
+        // the statement is prepared, and the encoding of this section doesn't
+        // depend on the protocol version or per-page flags.
+        std::optional<bytes> _encoded_specs;
     };
 private:
     flag_enum_set _flags;
@@ -122,6 +133,12 @@ public:
     const std::vector<lw_shared_ptr<column_specification>>& get_names() const {
         return _column_info->_names;
     }
+
+    // The transport's cache of the serialized column specifications, shared
+    // by all metadata objects (and hence all responses) of one statement.
+    std::optional<bytes>& encoded_column_specs() const {
+        return _column_info->_encoded_specs;
+    }
 };
 
 ::shared_ptr<const cql3::metadata> make_empty_metadata();
@@ -235,6 +252,9 @@ public:
         }
         _current_row.emplace_back(value->linearize());
     }
+    void accept_value(managed_bytes_view value) {
+        _current_row.emplace_back(value.linearize());
+    }
     void end_row() {
         _result.add_row(std::exchange(_current_row, { }));
     }
@@ -42,6 +42,7 @@
 #include "scalar_function_selector.hh"
 #include "to_string.hh"
 #include "cql3/selection/selector_factories.hh"
+#include "cql3/functions/aggregate_fcts.hh"
 
 namespace cql3 {
 
@@ -98,6 +99,10 @@ abstract_function_selector::new_factory(shared_ptr<functions::function> fun, sha
         virtual bool is_aggregate_selector_factory() const override {
             return _fun->is_aggregate() || _factories->contains_only_aggregate_functions();
         }
+
+        virtual bool is_count_rows_selector_factory() const override {
+            return _fun->name() == functions::function_name::native_function(functions::aggregate_fcts::COUNT_ROWS_FUNCTION_NAME);
+        }
     };
 
     return make_shared<fun_selector_factory>(std::move(fun), std::move(factories));
@@ -51,6 +51,7 @@
 #include "cql3/query_options.hh"
 #include "cql3/restrictions/multi_column_restriction.hh"
 #include "cql3/restrictions/statement_restrictions.hh"
+#include "utils/serialization.hh"
 
 namespace cql3 {
 
@@ -190,6 +191,12 @@ protected:
 class selection_with_processing : public selection {
 private:
     ::shared_ptr<selector_factories> _factories;
+    // When every selector merely forwards a column or its writetime/ttl, the
+    // whole selection is compiled at prepare time into this flat program and
+    // executed by flattened_selectors without any per-row virtual dispatch.
+    // Empty when some selector (a function call, an aggregate, ...) cannot be
+    // flattened.
+    std::vector<selector::factory::flattened_step> _flattened_program;
 public:
     selection_with_processing(schema_ptr schema, std::vector<const column_definition*> columns,
             std::vector<lw_shared_ptr<column_specification>> metadata, ::shared_ptr<selector_factories> factories)
@@ -197,18 +204,113 @@ public:
             factories->contains_write_time_selector_factory(),
             factories->contains_ttl_selector_factory())
         , _factories(std::move(factories))
+        , _flattened_program(compile_flattened_program(*_factories))
     { }
 
     virtual uint32_t add_column_for_post_processing(const column_definition& c) override {
         uint32_t index = selection::add_column_for_post_processing(c);
         _factories->add_selector_for_post_processing(c, index);
+        _flattened_program = compile_flattened_program(*_factories);
         return index;
     }
 
     virtual bool is_aggregate() const override {
         return _factories->does_aggregation();
     }
+
+    virtual bool is_count() const override {
+        return std::distance(_factories->begin(), _factories->end()) == 1
+                && (*_factories->begin())->is_count_rows_selector_factory();
+    }
 protected:
+    static std::vector<selector::factory::flattened_step> compile_flattened_program(const selector_factories& factories) {
+        std::vector<selector::factory::flattened_step> program;
+        for (auto&& factory : factories) {
+            auto step = factory->as_flattened_step();
+            if (!step) {
+                return {};
+            }
+            program.push_back(*step);
+        }
+        return program;
+    }
+
+    // Executes a flattened selection program with a single switch per output
+    // column instead of two virtual calls per selector per row.
+    class flattened_selectors : public selectors {
+    private:
+        using step = selector::factory::flattened_step;
+        std::vector<step> _program;
+        std::vector<bytes_opt> _current;
+        bool _first = true; ///< Whether the next row we receive is the first in its group.
+    public:
+        explicit flattened_selectors(std::vector<step> program)
+            : _program(std::move(program))
+        { }
+
+        virtual bool requires_thread() const override { return false; }
+
+        virtual bool is_aggregate() const override { return false; }
+
+        virtual void reset() override {
+            _current.clear();
+            _first = true;
+        }
+
+        virtual std::vector<bytes_opt> get_output_row(cql_serialization_format sf) override {
+            return std::move(_current);
+        }
+
+        virtual void add_input_row(cql_serialization_format sf, result_set_builder& rs) override {
+            if (_first) {
+                _current.clear();
+                _current.reserve(_program.size());
+                for (auto& s : _program) {
+                    _current.emplace_back(evaluate(s, rs));
+                }
+                _first = false;
+            } else {
+                // GROUP BY calls add_input_row() repeatedly without reset() in
+                // between. Column values keep the first value of the group,
+                // like simple_selectors, while writetime/ttl selectors have
+                // always been overwritten by every row - keep both behaviors.
+                for (size_t i = 0; i < _program.size(); i++) {
+                    if (_program[i].kind != step::op::column) {
+                        _current[i] = evaluate(_program[i], rs);
+                    }
+                }
+            }
+        }
+    private:
+        static bytes_opt evaluate(const step& s, result_set_builder& rs) {
+            switch (s.kind) {
+            case step::op::column:
+                return (*rs.current)[s.idx];
+            case step::op::writetime: {
+                int64_t ts = rs.timestamp_of(s.idx);
+                if (ts == api::missing_timestamp) {
+                    return std::nullopt;
+                }
+                bytes b(bytes::initialized_later(), 8);
+                auto i = b.begin();
+                serialize_int64(i, ts);
+                return b;
+            }
+            case step::op::ttl: {
+                int32_t ttl = rs.ttl_of(s.idx);
+                if (ttl <= 0) {
+                    return std::nullopt;
+                }
+                bytes b(bytes::initialized_later(), 4);
+                auto i = b.begin();
+                serialize_int32(i, ttl);
+                return b;
+            }
+            }
+            abort();
+        }
+    };
+
     class selectors_with_processing : public selectors {
     private:
         ::shared_ptr<selector_factories> _factories;
@@ -252,6 +354,9 @@ protected:
     };
 
     std::unique_ptr<selectors> new_selectors() const override  {
+        if (!_flattened_program.empty()) {
+            return std::make_unique<flattened_selectors>(_flattened_program);
+        }
         return std::make_unique<selectors_with_processing>(_factories);
     }
 };
@@ -430,6 +535,8 @@ result_set_builder::restrictions_filter::restrictions_filter(::shared_ptr<restri
     , _options(options)
     , _skip_pk_restrictions(!_restrictions->pk_restrictions_need_filtering())
     , _skip_ck_restrictions(!_restrictions->ck_restrictions_need_filtering())
+    , _multi_column_clustering_restrictions(
+            bool(dynamic_pointer_cast<restrictions::multi_column_restriction>(_restrictions->get_clustering_columns_restrictions())))
     , _remaining(remaining)
     , _schema(schema)
     , _per_partition_limit(per_partition_limit)
@@ -449,17 +556,19 @@ bool result_set_builder::restrictions_filter::do_filter(const selection& selecti
         return false;
     }
 
-    auto clustering_columns_restrictions = _restrictions->get_clustering_columns_restrictions();
-    if (dynamic_pointer_cast<cql3::restrictions::multi_column_restriction>(clustering_columns_restrictions)) {
-        clustering_key_prefix ckey = clustering_key_prefix::from_exploded(clustering_key);
+    if (_multi_column_clustering_restrictions) {
         return expr::is_satisfied_by(
-                clustering_columns_restrictions->expression,
+                _restrictions->get_clustering_columns_restrictions()->expression,
                 partition_key, clustering_key, static_row, row, selection, _options);
     }
 
     auto static_row_iterator = static_row.iterator();
     auto row_iterator = row ? std::optional<query::result_row_view::iterator_type>(row->iterator()) : std::nullopt;
-    auto non_pk_restrictions_map = _restrictions->get_non_pk_restriction();
+    // Note: these maps are looked up per row (and per column); take them by
+    // reference, copying unordered_maps here dominated filtering scans.
+    const auto& non_pk_restrictions_map = _restrictions->get_non_pk_restriction();
+    const auto& partition_key_restrictions_map = _restrictions->get_single_column_partition_key_restrictions();
+    const auto& clustering_key_restrictions_map = _restrictions->get_single_column_clustering_key_restrictions();
     for (auto&& cdef : selection.get_columns()) {
         switch (cdef->kind) {
         case column_kind::static_column:
@@ -485,7 +594,6 @@ bool result_set_builder::restrictions_filter::do_filter(const selection& selecti
             if (_skip_pk_restrictions) {
                 continue;
             }
-            auto partition_key_restrictions_map = _restrictions->get_single_column_partition_key_restrictions();
             auto restr_it = partition_key_restrictions_map.find(cdef);
             if (restr_it == partition_key_restrictions_map.end()) {
                 continue;
@@ -502,7 +610,6 @@ bool result_set_builder::restrictions_filter::do_filter(const selection& selecti
             if (_skip_ck_restrictions) {
                 continue;
             }
-            auto clustering_key_restrictions_map = _restrictions->get_single_column_clustering_key_restrictions();
             auto restr_it = clustering_key_restrictions_map.find(cdef);
             if (restr_it == clustering_key_restrictions_map.end()) {
                 continue;
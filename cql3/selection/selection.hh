@@ -173,6 +173,14 @@ public:
 
     virtual bool is_aggregate() const = 0;
 
+    /**
+     * Checks if this selection is a lone <code>COUNT(*)</code>, whose value can be
+     * computed from per-page row counts without visiting the rows.
+     */
+    virtual bool is_count() const {
+        return false;
+    }
+
     /**
      * Checks that selectors are either all aggregates or that none of them is.
      *
@@ -244,6 +252,9 @@ public:
         const query_options& _options;
         const bool _skip_pk_restrictions;
         const bool _skip_ck_restrictions;
+        // Whether the clustering restrictions are multi-column; evaluated once
+        // here instead of through a dynamic_pointer_cast on every row.
+        const bool _multi_column_clustering_restrictions;
         mutable bool _current_partition_key_does_not_match = false;
         mutable bool _current_static_row_does_not_match = false;
         mutable uint64_t _rows_dropped = 0;
@@ -177,6 +177,16 @@ public:
         return false;
     }
 
+    /**
+     * Checks if this factory creates <code>COUNT(*)</code> selectors instances.
+     *
+     * @return <code>true</code> if this factory creates <code>COUNT(*)</code> selectors instances,
+     * <code>false</code> otherwise
+     */
+    virtual bool is_count_rows_selector_factory() const {
+        return false;
+    }
+
     /**
      * Returns the name of the column corresponding to the output value of the selector instances created by
      * this factory.
@@ -191,6 +201,26 @@ public:
      * @return the selector output type
      */
     virtual data_type get_return_type() const = 0;
+
+    /**
+     * Describes a selector that merely forwards one input column, or its
+     * writetime or TTL, to the output row.
+     */
+    struct flattened_step {
+        enum class op : uint8_t { column, writetime, ttl };
+        op kind;
+        uint32_t idx; ///< Index of the input column in the queried columns.
+    };
+
+    /**
+     * Returns a <code>flattened_step</code> describing the selectors created by this factory,
+     * or an empty optional if they cannot be described by one. When every factory of a
+     * selection can be flattened the selection is executed as a flat program instead of a
+     * chain of virtual selector calls (see selection.cc).
+     */
+    virtual std::optional<flattened_step> as_flattened_step() const {
+        return std::nullopt;
+    }
 };
 
 }
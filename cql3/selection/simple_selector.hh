@@ -68,6 +68,10 @@ public:
         return _type;
     }
 
+    virtual std::optional<flattened_step> as_flattened_step() const override {
+        return flattened_step{flattened_step::op::column, _idx};
+    }
+
     virtual ::shared_ptr<selector> new_instance() const override;
 };
 
@@ -82,6 +82,11 @@ public:
             virtual bool is_ttl_selector_factory() const override {
                 return !_is_writetime;
             }
+
+            virtual std::optional<flattened_step> as_flattened_step() const override {
+                return flattened_step{_is_writetime ? flattened_step::op::writetime : flattened_step::op::ttl,
+                        uint32_t(_idx)};
+            }
         };
         return ::make_shared<wtots_factory>(std::move(column_name), idx, is_writetime);
     }
@@ -77,6 +77,8 @@ batch_statement::batch_statement(int bound_terms, type type_,
     , _bound_terms(bound_terms), _type(type_), _statements(std::move(statements))
     , _attrs(std::move(attrs))
     , _has_conditions(boost::algorithm::any_of(_statements, [] (auto&& s) { return s.statement->has_conditions(); }))
+    , _build_mutations_in_parallel(type_ != type::COUNTER
+            && boost::algorithm::all_of(_statements, [] (auto&& s) { return !s.statement->is_order_dependent(); }))
     , _stats(stats)
 {
     validate();
@@ -191,13 +193,13 @@ const std::vector<batch_statement::single_statement>& batch_statement::get_state
 
 future<std::vector<mutation>> batch_statement::get_mutations(service::storage_proxy& storage, const query_options& options,
         db::timeout_clock::time_point timeout, bool local, api::timestamp_type now, service::query_state& query_state) const {
-    // Do not process in parallel because operations like list append/prepend depend on execution order.
+    // How many statements are built concurrently when the batch is order-independent.
+    constexpr size_t build_concurrency = 10;
+    auto build_start = std::chrono::steady_clock::now();
     using mutation_set_type = std::unordered_set<mutation, mutation_hash_by_key, mutation_equals_by_key>;
     return do_with(mutation_set_type(), [this, &storage, &options, timeout, now, local, &query_state] (auto& result) mutable {
         result.reserve(_statements.size());
-        return do_for_each(boost::make_counting_iterator<size_t>(0),
-                           boost::make_counting_iterator<size_t>(_statements.size()),
-                           [this, &storage, &options, now, local, &result, timeout, &query_state] (size_t i) {
+        auto build_statement_mutations = [this, &storage, &options, now, local, &result, timeout, &query_state] (size_t i) {
             auto&& statement = _statements[i].statement;
             statement->inc_cql_stats(query_state.get_client_state().is_internal());
             auto&& statement_options = options.for_statement(i);
@@ -213,7 +215,15 @@ future<std::vector<mutation>> batch_statement::get_mutations(service::storage_pr
                     }
                 }
             });
-        }).then([&result] {
+        };
+        auto first = boost::make_counting_iterator<size_t>(0);
+        auto last = boost::make_counting_iterator<size_t>(_statements.size());
+        // Operations like list append/prepend depend on execution order, so only batches
+        // made entirely of order-independent statements are processed in parallel.
+        auto built = _build_mutations_in_parallel
+                ? max_concurrent_for_each(first, last, build_concurrency, std::move(build_statement_mutations))
+                : do_for_each(first, last, std::move(build_statement_mutations));
+        return built.then([&result] {
             // can't use range adaptors, because we want to move
             auto vresult = std::vector<mutation>();
             vresult.reserve(result.size());
@@ -222,6 +232,10 @@ future<std::vector<mutation>> batch_statement::get_mutations(service::storage_pr
             }
             return vresult;
         });
+    }).then([this, build_start] (std::vector<mutation> ms) {
+        _stats.batches_mutation_build_time_us += std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::steady_clock::now() - build_start).count();
+        return ms;
     });
 }
 
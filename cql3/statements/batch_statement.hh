@@ -101,6 +101,11 @@ private:
     // any statement in the batch has IF EXISTS, we must return
     // all columns of the table, including the primary key.
     column_set _columns_of_cas_result_set;
+    // True if the batch mutations can be built in parallel: non-counter
+    // batches whose every statement is order-independent (see
+    // modification_statement::is_order_dependent()). Pre-computed during
+    // statement prepare.
+    bool _build_mutations_in_parallel;
     cql_stats& _stats;
 public:
     /**
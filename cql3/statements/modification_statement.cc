@@ -584,6 +584,9 @@ void modification_statement::add_operation(::shared_ptr<operation> op) {
         _sets_regular_columns = true;
         _selects_a_collection |= op->column.type->is_collection();
     }
+    if (op->column.type->is_list() && op->column.type->is_multi_cell()) {
+        _has_operations_on_lists = true;
+    }
     if (op->requires_read()) {
         _requires_read = true;
         _columns_to_read.set(op->column.ordinal_id);
@@ -113,6 +113,9 @@ private:
     // True if any of update operations requires a prefetch.
     // Pre-computed during statement prepare.
     bool _requires_read = false;
+    // True if any of update operations modifies a non-frozen list.
+    // Pre-computed during statement prepare.
+    bool _has_operations_on_lists = false;
     bool _if_not_exists = false;
     bool _if_exists = false;
 
@@ -219,6 +222,11 @@ public:
     // a prefetch of the old cell.
     bool requires_read() const { return _requires_read; }
 
+    // True if the outcome of this statement depends on when it is executed
+    // relative to other statements: operations that read the previous value,
+    // and list append/prepend, whose cells are keyed by the time of execution.
+    bool is_order_dependent() const { return _requires_read || _has_operations_on_lists; }
+
     // Columns used in this statement conditions or operations.
     const column_set& columns_to_read() const { return _columns_to_read; }
 
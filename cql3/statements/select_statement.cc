@@ -164,6 +164,13 @@ select_statement::select_statement(schema_ptr schema,
     _opts.set_if<query::partition_slice::option::bypass_cache>(_parameters->bypass_cache());
     _opts.set_if<query::partition_slice::option::distinct>(_parameters->is_distinct());
     _opts.set_if<query::partition_slice::option::reversed>(_is_reversed);
+
+    if (!_per_partition_limit && !_restrictions->has_clustering_columns_restriction() && !_is_reversed) {
+        // Nothing in the slice can depend on the bound values - build it once
+        // here instead of on every execution. The passed options only matter
+        // for the CQL serialization format, which is fixed up per execution.
+        _slice_template = make_partition_slice(query_options::DEFAULT);
+    }
 }
 
 db::timeout_clock::duration select_statement::get_timeout(const service::client_state& state, const query_options& options) const {
@@ -214,6 +221,12 @@ const sstring& select_statement::column_family() const {
 query::partition_slice
 select_statement::make_partition_slice(const query_options& options) const
 {
+    if (_slice_template) {
+        auto slice = *_slice_template;
+        slice.set_cql_format(options.get_cql_serialization_format());
+        return slice;
+    }
+
     query::column_id_vector static_columns;
     query::column_id_vector regular_columns;
 
@@ -369,6 +382,25 @@ select_statement::do_execute(service::storage_proxy& proxy,
                     ::make_shared<cql_transport::messages::result_message::bounce_to_shard>(shard,
                         std::move(const_cast<cql3::query_options&>(options).take_cached_pk_function_calls())));
         }
+    } else if (state.bounce_to_shard_allowed()
+            && key_ranges.size() == 1 && query::is_single_partition(key_ranges.front())) {
+        // Non-shard-aware drivers land single-partition reads on arbitrary
+        // shards. If this node is a replica for the partition, move the whole
+        // request to the shard owning the local data (the smp queues batch
+        // these messages per poll), so the read is coordinated next to the
+        // data instead of doing a cross-shard data round trip per page.
+        // This is deterministic on the target shard: bound values come from
+        // the replayed frame and non-pure function calls in the partition key
+        // restrictions travel through the cached-function-values mechanism,
+        // so no second bounce can happen.
+        auto token = key_ranges[0].start()->value().as_decorated_key().token();
+        unsigned shard = dht::shard_of(*_schema, token);
+        if (this_shard_id() != shard && proxy.is_local_replica(*_schema, token)) {
+            proxy.get_stats().replica_cross_shard_ops++;
+            return make_ready_future<shared_ptr<cql_transport::messages::result_message>>(
+                    ::make_shared<cql_transport::messages::result_message::bounce_to_shard>(shard,
+                        std::move(const_cast<cql3::query_options&>(options).take_cached_pk_function_calls())));
+        }
     }
 
     if (!aggregate && !_restrictions_need_filtering && (page_size <= 0
@@ -383,6 +415,29 @@ select_statement::do_execute(service::storage_proxy& proxy,
     auto p = service::pager::query_pagers::pager(_schema, _selection,
             state, options, command, std::move(key_ranges), _restrictions_need_filtering ? _restrictions : nullptr);
 
+    // A lone COUNT(*) needs only the per-page row counts, which the replicas
+    // already compute; sum them up without pulling the rows through the
+    // selector pipeline.
+    if (_selection->is_count() && !has_group_by() && !_restrictions_need_filtering && !_parameters->is_distinct()) {
+        return do_with(uint64_t(0), std::move(p), [this, page_size, now, timeout] (uint64_t& count, std::unique_ptr<service::pager::query_pager>& p) {
+            return do_until([&p] { return p->is_exhausted(); },
+                    [&p, &count, page_size, now, timeout] {
+                        // Internal pages never reach the client, so let the
+                        // pager grow them for fast scans of small rows.
+                        return p->fetch_page_row_count(p->internal_page_size(page_size), now, timeout).then([&count] (uint64_t rows) {
+                            count += rows;
+                        });
+                    }
+            ).then([this, &count] {
+                auto rs = std::make_unique<result_set>(::make_shared<metadata>(*_selection->get_result_metadata()));
+                rs->add_row({ long_type->decompose(int64_t(count)) });
+                update_stats_rows_read(rs->size());
+                auto msg = ::make_shared<cql_transport::messages::result_message::rows>(result(std::move(rs)));
+                return shared_ptr<cql_transport::messages::result_message>(std::move(msg));
+            });
+        });
+    }
+
     if (aggregate || nonpaged_filtering) {
         return do_with(
                 cql3::selection::result_set_builder(*_selection, now,
@@ -390,7 +445,9 @@ select_statement::do_execute(service::storage_proxy& proxy,
                 [this, page_size, now, timeout](auto& builder, std::unique_ptr<service::pager::query_pager>& p) {
                     return do_until([&p] {return p->is_exhausted();},
                             [&p, &builder, page_size, now, timeout] {
-                                return p->fetch_page(builder, page_size, now, timeout);
+                                // As above: these pages are internal, so they
+                                // may grow beyond the client's page size.
+                                return p->fetch_page(builder, p->internal_page_size(page_size), now, timeout);
                             }
                     ).then([this, &p, &builder] {
                         return builder.with_thread_if_needed([this, &p, &builder] {
@@ -663,18 +720,30 @@ indexed_table_select_statement::do_execute_base_query(
             }
             next_iteration_size = std::min<size_t>({next_iteration_size, keys.size() - already_done, max_base_table_query_concurrency});
             auto key_it_end = key_it + next_iteration_size;
-            auto command = ::make_lw_shared<query::read_command>(*cmd);
+
+            // Group this iteration's keys by partition, so that all the rows
+            // needed from one partition are fetched with a single command
+            // sent to its replicas. The keys arrive in index order, which
+            // keeps the rows of each partition adjacent.
+            struct partition_group {
+                const primary_key* head;
+                std::vector<query::clustering_range> row_ranges;
+            };
+            std::vector<partition_group> groups;
+            for (auto it = key_it; it != key_it_end; ++it) {
+                if (groups.empty() || !groups.back().head->partition.equal(*_schema, it->partition)) {
+                    groups.push_back(partition_group{&*it, {}});
+                }
+                if (it->clustering) {
+                    groups.back().row_ranges.push_back(query::clustering_range::make_singular(it->clustering));
+                }
+            }
 
             query::result_merger oneshot_merger(cmd->get_row_limit(), query::max_partitions);
-            return map_reduce(key_it, key_it_end, [this, &proxy, &state, &options, cmd, timeout] (auto& key) {
+            return map_reduce(groups.begin(), groups.end(), [this, &proxy, &state, &options, cmd, timeout] (partition_group& group) {
                 auto command = ::make_lw_shared<query::read_command>(*cmd);
-                // for each partition, read just one clustering row (TODO: can
-                // get all needed rows of one partition at once.)
-                command->slice._row_ranges.clear();
-                if (key.clustering) {
-                    command->slice._row_ranges.push_back(query::clustering_range::make_singular(key.clustering));
-                }
-                return proxy.query(_schema, command, {dht::partition_range::make_singular(key.partition)}, options.get_consistency(), {timeout, state.get_permit(), state.get_client_state(), state.get_trace_state()})
+                command->slice._row_ranges = std::move(group.row_ranges);
+                return proxy.query(_schema, command, {dht::partition_range::make_singular(group.head->partition)}, options.get_consistency(), {timeout, state.get_permit(), state.get_client_state(), state.get_trace_state()})
                 .then([] (service::storage_proxy::coordinator_query_result qr) {
                     return std::move(qr.query_result);
                 });
@@ -1068,15 +1137,52 @@ indexed_table_select_statement::do_execute(service::storage_proxy& proxy,
     // the paging state between requesting data from replicas.
     const bool aggregate = _selection->is_aggregate() || has_group_by();
     if (aggregate) {
-        return do_with(cql3::selection::result_set_builder(*_selection, now, options.get_cql_serialization_format(), *_group_by_cell_indices), std::make_unique<cql3::query_options>(cql3::query_options(options)),
-                [this, &options, &proxy, &state, now, whole_partitions, partition_slices] (cql3::selection::result_set_builder& builder, std::unique_ptr<cql3::query_options>& internal_options) {
+        // State of the speculative read-ahead of the next index page, issued
+        // while the base rows of the current page are still being fetched,
+        // so the index and base latencies overlap instead of stacking. The
+        // speculation assumes the base fetch consumes the whole index page;
+        // when it does not (a short read or the page size limit), the next
+        // index page must be read from an earlier position, so the
+        // speculative result is waited for and dropped.
+        struct index_readahead {
+            std::optional<future<std::tuple<dht::partition_range_vector, lw_shared_ptr<const service::pager::paging_state>>>> next_partition_ranges;
+            std::optional<future<std::tuple<std::vector<primary_key>, lw_shared_ptr<const service::pager::paging_state>>>> next_primary_keys;
+            // The view paging state the speculative read was started from,
+            // and the options object keeping it alive while the read runs.
+            lw_shared_ptr<const service::pager::paging_state> speculated_from;
+            std::unique_ptr<cql3::query_options> options;
+
+            future<> discard() {
+                auto f = make_ready_future<>();
+                if (next_partition_ranges) {
+                    f = std::move(*next_partition_ranges).then_wrapped([opts = std::move(options)] (auto&& r) { r.ignore_ready_future(); });
+                    next_partition_ranges.reset();
+                } else if (next_primary_keys) {
+                    f = std::move(*next_primary_keys).then_wrapped([opts = std::move(options)] (auto&& r) { r.ignore_ready_future(); });
+                    next_primary_keys.reset();
+                }
+                speculated_from = nullptr;
+                return f;
+            }
+        };
+
+        return do_with(cql3::selection::result_set_builder(*_selection, now, options.get_cql_serialization_format(), *_group_by_cell_indices), std::make_unique<cql3::query_options>(cql3::query_options(options)), index_readahead{},
+                [this, &options, &proxy, &state, now, whole_partitions, partition_slices] (cql3::selection::result_set_builder& builder, std::unique_ptr<cql3::query_options>& internal_options, index_readahead& readahead) {
             // page size is set to the internal count page size, regardless of the user-provided value
             internal_options.reset(new cql3::query_options(std::move(internal_options), options.get_paging_state(), internal_paging_size));
-            return repeat([this, &builder, &options, &internal_options, &proxy, &state, now, whole_partitions, partition_slices] () {
-                auto consume_results = [this, &builder, &options, &internal_options, &proxy, &state] (foreign_ptr<lw_shared_ptr<query::result>> results, lw_shared_ptr<query::read_command> cmd, lw_shared_ptr<const service::pager::paging_state> paging_state) {
+            return repeat([this, &builder, &options, &internal_options, &readahead, &proxy, &state, now, whole_partitions, partition_slices] () {
+                auto consume_results = [this, &builder, &options, &internal_options, &readahead, &proxy, &state] (foreign_ptr<lw_shared_ptr<query::result>> results, lw_shared_ptr<query::read_command> cmd, lw_shared_ptr<const service::pager::paging_state> paging_state) {
                     if (paging_state) {
                         paging_state = generate_view_paging_state_from_base_query_results(paging_state, results, proxy, state, options);
                     }
+                    auto speculation_settled = make_ready_future<>();
+                    if (readahead.speculated_from && readahead.speculated_from != paging_state) {
+                        // generate_view_paging_state_from_base_query_results() returns its
+                        // argument unchanged exactly when the base fetch consumed the whole
+                        // index page. Here it didn't, so the speculatively read next page
+                        // starts at the wrong position and has to be dropped.
+                        speculation_settled = readahead.discard();
+                    }
                     internal_options.reset(new cql3::query_options(std::move(internal_options), paging_state ? make_lw_shared<service::pager::paging_state>(*paging_state) : nullptr));
                     if (_restrictions_need_filtering) {
                         _stats.filtered_rows_read_total += *results->row_count();
@@ -1086,32 +1192,74 @@ indexed_table_select_statement::do_execute(service::storage_proxy& proxy,
                         query::result_view::consume(*results, cmd->slice, cql3::selection::result_set_builder::visitor(builder, *_schema, *_selection));
                     }
                     bool has_more_pages = paging_state && paging_state->get_remaining() > 0;
-                    return stop_iteration(!has_more_pages);
+                    return speculation_settled.then([has_more_pages] {
+                        return stop_iteration(!has_more_pages);
+                    });
+                };
+
+                // Starts the speculative read of the next index page, overlapping it
+                // with the base table fetch of the current one.
+                auto start_readahead = [this, &options, &readahead, &proxy, &state, whole_partitions, partition_slices] (const lw_shared_ptr<const service::pager::paging_state>& paging_state) {
+                    readahead.speculated_from = nullptr;
+                    if (!paging_state || paging_state->get_remaining() == 0) {
+                        return;
+                    }
+                    readahead.speculated_from = paging_state;
+                    readahead.options = std::make_unique<cql3::query_options>(std::make_unique<cql3::query_options>(cql3::query_options(options)), make_lw_shared<service::pager::paging_state>(*paging_state), internal_paging_size);
+                    if (whole_partitions || partition_slices) {
+                        readahead.next_partition_ranges = find_index_partition_ranges(proxy, state, *readahead.options);
+                    } else {
+                        readahead.next_primary_keys = find_index_clustering_rows(proxy, state, *readahead.options);
+                    }
                 };
 
                 if (whole_partitions || partition_slices) {
-                    return find_index_partition_ranges(proxy, state, *internal_options).then_unpack(
-                            [this, now, &state, &internal_options, &proxy, consume_results = std::move(consume_results)] (dht::partition_range_vector partition_ranges, lw_shared_ptr<const service::pager::paging_state> paging_state) {
+                    auto f = [&] {
+                        if (readahead.next_partition_ranges) {
+                            auto f = std::move(*readahead.next_partition_ranges);
+                            readahead.next_partition_ranges.reset();
+                            return f;
+                        }
+                        return find_index_partition_ranges(proxy, state, *internal_options);
+                    }();
+                    return f.then_unpack(
+                            [this, now, &state, &internal_options, &proxy, consume_results = std::move(consume_results), start_readahead = std::move(start_readahead)] (dht::partition_range_vector partition_ranges, lw_shared_ptr<const service::pager::paging_state> paging_state) {
+                        start_readahead(paging_state);
                         return do_execute_base_query(proxy, std::move(partition_ranges), state, *internal_options, now, paging_state)
                         .then_unpack([paging_state, consume_results = std::move(consume_results)](foreign_ptr<lw_shared_ptr<query::result>> results, lw_shared_ptr<query::read_command> cmd) {
                             return consume_results(std::move(results), std::move(cmd), std::move(paging_state));
                         });
                     });
                 } else {
-                    return find_index_clustering_rows(proxy, state, *internal_options).then_unpack(
-                            [this, now, &state, &internal_options, &proxy, consume_results = std::move(consume_results)] (std::vector<primary_key> primary_keys, lw_shared_ptr<const service::pager::paging_state> paging_state) {
+                    auto f = [&] {
+                        if (readahead.next_primary_keys) {
+                            auto f = std::move(*readahead.next_primary_keys);
+                            readahead.next_primary_keys.reset();
+                            return f;
+                        }
+                        return find_index_clustering_rows(proxy, state, *internal_options);
+                    }();
+                    return f.then_unpack(
+                            [this, now, &state, &internal_options, &proxy, consume_results = std::move(consume_results), start_readahead = std::move(start_readahead)] (std::vector<primary_key> primary_keys, lw_shared_ptr<const service::pager::paging_state> paging_state) {
+                        start_readahead(paging_state);
                         return this->do_execute_base_query(proxy, std::move(primary_keys), state, *internal_options, now, paging_state)
                         .then_unpack([paging_state, consume_results = std::move(consume_results)](foreign_ptr<lw_shared_ptr<query::result>> results, lw_shared_ptr<query::read_command> cmd) {
                             return consume_results(std::move(results), std::move(cmd), std::move(paging_state));
                         });
                     });
                 }
-            }).then([this, &builder] () {
-                auto rs = builder.build();
-                update_stats_rows_read(rs->size());
-                _stats.filtered_rows_matched_total += _restrictions_need_filtering ? rs->size() : 0;
-                auto msg = ::make_shared<cql_transport::messages::result_message::rows>(result(std::move(rs)));
-                return make_ready_future<shared_ptr<cql_transport::messages::result_message>>(std::move(msg));
+            }).then_wrapped([this, &builder, &readahead] (future<> f) {
+                // If the loop ended with a speculative index read still in flight
+                // (e.g. it failed with an exception), wait for that read before
+                // unwinding: it references state owned by our caller.
+                return readahead.discard().then([this, &builder, f = std::move(f)] () mutable {
+                    f.get();
+                    auto rs = builder.build();
+                    update_stats_rows_read(rs->size());
+                    _stats.filtered_rows_matched_total += _restrictions_need_filtering ? rs->size() : 0;
+                    auto msg = ::make_shared<cql_transport::messages::result_message::rows>(result(std::move(rs)));
+                    return make_ready_future<shared_ptr<cql_transport::messages::result_message>>(std::move(msg));
+                });
             });
         });
     }
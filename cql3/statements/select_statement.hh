@@ -101,6 +101,10 @@ protected:
     ordering_comparator_type _ordering_comparator;
 
     query::partition_slice::option_set _opts;
+    // Set at prepare time when no part of the slice depends on the bound
+    // values; make_partition_slice() then only copies it and fixes up the
+    // CQL serialization format instead of re-evaluating the restrictions.
+    std::optional<query::partition_slice> _slice_template;
     cql_stats& _stats;
     const ks_selector _ks_sel;
     bool _range_scan = false;
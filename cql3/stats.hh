@@ -73,6 +73,7 @@ struct cql_stats {
     uint64_t batches_pure_logged = 0;
     uint64_t batches_pure_unlogged = 0;
     uint64_t batches_unlogged_from_logged = 0;
+    uint64_t batches_mutation_build_time_us = 0;
     uint64_t rows_read = 0;
     uint64_t reverse_queries = 0;
 
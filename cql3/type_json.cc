@@ -36,52 +36,54 @@ static inline bool is_control_char(char c) {
     return c >= 0 && c <= 0x1F;
 }
 
-static inline bool needs_escaping(const sstring& s) {
+static inline bool needs_escaping(std::string_view s) {
     return std::any_of(s.begin(), s.end(), [](char c) {return is_control_char(c) || c == '"' || c == '\\';});
 }
 
-
-static sstring quote_json_string(const sstring& value) {
+static void write_json_string(bytes_ostream& out, std::string_view value) {
     if (!needs_escaping(value)) {
-        return format("\"{}\"", value);
+        out.write("\"", 1);
+        out.write(value.data(), value.size());
+        out.write("\"", 1);
+        return;
     }
-    std::ostringstream oss;
-    oss << std::hex << std::uppercase << std::setfill('0');
-    oss.put('"');
+    static constexpr char hex_digits[] = "0123456789ABCDEF";
+    out.write("\"", 1);
     for (char c : value) {
         switch (c) {
         case '"':
-            oss.put('\\').put('"');
+            out.write("\\\"", 2);
             break;
         case '\\':
-            oss.put('\\').put('\\');
+            out.write("\\\\", 2);
             break;
         case '\b':
-            oss.put('\\').put('b');
+            out.write("\\b", 2);
             break;
         case '\f':
-            oss.put('\\').put('f');
+            out.write("\\f", 2);
             break;
         case '\n':
-            oss.put('\\').put('n');
+            out.write("\\n", 2);
             break;
         case '\r':
-            oss.put('\\').put('r');
+            out.write("\\r", 2);
             break;
         case '\t':
-            oss.put('\\').put('t');
+            out.write("\\t", 2);
             break;
         default:
             if (is_control_char(c)) {
-                oss.put('\\').put('u') << std::setw(4) << static_cast<int>(c);
+                // Control characters are below 0x20, so the two high digits are always zero.
+                char buf[6] = { '\\', 'u', '0', '0', hex_digits[(c >> 4) & 0xF], hex_digits[c & 0xF] };
+                out.write(buf, sizeof(buf));
             } else {
-                oss.put(c);
+                out.write(&c, 1);
             }
             break;
         }
     }
-    oss.put('"');
-    return oss.str();
+    out.write("\"", 1);
 }
 
 static int64_t to_int64_t(const rjson::value& value) {
@@ -296,189 +298,204 @@ template <typename T> static T compose_value(const integer_type_impl<T>& t, byte
     return read_be<T>(reinterpret_cast<const char*>(bv.data()));
 }
 
-static sstring to_json_string_aux(const map_type_impl& t, bytes_view bv) {
-    std::ostringstream out;
+static void write_string(bytes_ostream& out, std::string_view s) {
+    out.write(s.data(), s.size());
+}
+
+static void to_json_aux(const map_type_impl& t, bytes_view bv, bytes_ostream& out) {
     auto sf = cql_serialization_format::internal();
 
-    out << '{';
+    out.write("{", 1);
     auto size = read_collection_size(bv, sf);
     for (int i = 0; i < size; ++i) {
         auto kb = read_collection_value(bv, sf);
         auto vb = read_collection_value(bv, sf);
 
         if (i > 0) {
-            out << ", ";
+            out.write(", ", 2);
         }
 
         // Valid keys in JSON map must be quoted strings
         sstring string_key = to_json_string(*t.get_keys_type(), kb);
         bool is_unquoted = string_key.empty() || string_key[0] != '"';
         if (is_unquoted) {
-            out << '"';
+            out.write("\"", 1);
         }
-        out << string_key;
+        write_string(out, string_key);
         if (is_unquoted) {
-            out << '"';
+            out.write("\"", 1);
         }
-        out << ": ";
-        out << to_json_string(*t.get_values_type(), vb);
+        out.write(": ", 2);
+        to_json(*t.get_values_type(), vb, out);
     }
-    out << '}';
-    return out.str();
+    out.write("}", 1);
 }
 
-static sstring to_json_string_aux(const set_type_impl& t, bytes_view bv) {
+static void to_json_aux(const set_type_impl& t, bytes_view bv, bytes_ostream& out) {
     using llpdi = listlike_partial_deserializing_iterator;
-    std::ostringstream out;
     bool first = true;
     auto sf = cql_serialization_format::internal();
-    out << '[';
+    out.write("[", 1);
     managed_bytes_view mbv(bv);
     std::for_each(llpdi::begin(mbv, sf), llpdi::end(mbv, sf), [&first, &out, &t] (const managed_bytes_view& e) {
         if (first) {
             first = false;
         } else {
-            out << ", ";
+            out.write(", ", 2);
         }
-        out << to_json_string(*t.get_elements_type(), e);
+        to_json(*t.get_elements_type(), e, out);
     });
-    out << ']';
-    return out.str();
+    out.write("]", 1);
 }
 
-static sstring to_json_string_aux(const list_type_impl& t, bytes_view bv) {
+static void to_json_aux(const list_type_impl& t, bytes_view bv, bytes_ostream& out) {
     using llpdi = listlike_partial_deserializing_iterator;
-    std::ostringstream out;
     bool first = true;
     auto sf = cql_serialization_format::internal();
-    out << '[';
+    out.write("[", 1);
     managed_bytes_view mbv(bv);
     std::for_each(llpdi::begin(mbv, sf), llpdi::end(mbv, sf), [&first, &out, &t] (const managed_bytes_view& e) {
         if (first) {
             first = false;
         } else {
-            out << ", ";
+            out.write(", ", 2);
         }
-        out << to_json_string(*t.get_elements_type(), e);
+        to_json(*t.get_elements_type(), e, out);
     });
-    out << ']';
-    return out.str();
+    out.write("]", 1);
 }
 
-static sstring to_json_string_aux(const tuple_type_impl& t, bytes_view bv) {
-    std::ostringstream out;
-    out << '[';
+static void to_json_aux(const tuple_type_impl& t, bytes_view bv, bytes_ostream& out) {
+    out.write("[", 1);
 
     auto ti = t.all_types().begin();
     auto vi = tuple_deserializing_iterator::start(bv);
     while (ti != t.all_types().end() && vi != tuple_deserializing_iterator::finish(bv)) {
         if (ti != t.all_types().begin()) {
-            out << ", ";
+            out.write(", ", 2);
         }
         if (*vi) {
-            // TODO(sarna): We can avoid copying if to_json_string accepted bytes_view
-            out << to_json_string(**ti, **vi);
+            to_json(**ti, **vi, out);
         } else {
-            out << "null";
+            out.write("null", 4);
         }
         ++ti;
         ++vi;
     }
 
-    out << ']';
-    return out.str();
+    out.write("]", 1);
 }
 
-static sstring to_json_string_aux(const user_type_impl& t, bytes_view bv) {
-    std::ostringstream out;
-    out << '{';
+static void to_json_aux(const user_type_impl& t, bytes_view bv, bytes_ostream& out) {
+    out.write("{", 1);
 
     auto ti = t.all_types().begin();
     auto vi = tuple_deserializing_iterator::start(bv);
     int i = 0;
     while (ti != t.all_types().end() && vi != tuple_deserializing_iterator::finish(bv)) {
         if (ti != t.all_types().begin()) {
-            out << ", ";
+            out.write(", ", 2);
         }
-        out << quote_json_string(t.field_name_as_string(i)) << ": ";
+        write_json_string(out, t.field_name_as_string(i));
+        out.write(": ", 2);
         if (*vi) {
-            //TODO(sarna): We can avoid copying if to_json_string accepted bytes_view
-            out << to_json_string(**ti, **vi);
+            to_json(**ti, **vi, out);
         } else {
-            out << "null";
+            out.write("null", 4);
         }
         ++ti;
         ++i;
         ++vi;
     }
 
-    out << '}';
-    return out.str();
+    out.write("}", 1);
 }
 
 namespace {
-struct to_json_string_visitor {
+struct to_json_visitor {
     bytes_view bv;
-    sstring operator()(const reversed_type_impl& t) { return to_json_string(*t.underlying_type(), bv); }
-    template <typename T> sstring operator()(const integer_type_impl<T>& t) { return to_sstring(compose_value(t, bv)); }
-    template <typename T> sstring operator()(const floating_type_impl<T>& t) {
+    bytes_ostream& out;
+    void operator()(const reversed_type_impl& t) { to_json(*t.underlying_type(), bv, out); }
+    template <typename T> void operator()(const integer_type_impl<T>& t) { write_string(out, to_sstring(compose_value(t, bv))); }
+    template <typename T> void operator()(const floating_type_impl<T>& t) {
         if (bv.empty()) {
             throw exceptions::invalid_request_exception("Cannot create JSON string - deserialization error");
         }
         auto v = t.deserialize(bv);
         T d = value_cast<T>(v);
         if (std::isnan(d) || std::isinf(d)) {
-            return "null";
+            out.write("null", 4);
+            return;
         }
-        return to_sstring(d);
-    }
-    sstring operator()(const uuid_type_impl& t) { return quote_json_string(t.to_string(bv)); }
-    sstring operator()(const inet_addr_type_impl& t) { return quote_json_string(t.to_string(bv)); }
-    sstring operator()(const string_type_impl& t) { return quote_json_string(t.to_string(bv)); }
-    sstring operator()(const bytes_type_impl& t) { return quote_json_string("0x" + t.to_string(bv)); }
-    sstring operator()(const boolean_type_impl& t) { return t.to_string(bv); }
-    sstring operator()(const timestamp_date_base_class& t) { return quote_json_string(t.to_string(bv)); }
-    sstring operator()(const timeuuid_type_impl& t) { return quote_json_string(t.to_string(bv)); }
-    sstring operator()(const map_type_impl& t) { return to_json_string_aux(t, bv); }
-    sstring operator()(const set_type_impl& t) { return to_json_string_aux(t, bv); }
-    sstring operator()(const list_type_impl& t) { return to_json_string_aux(t, bv); }
-    sstring operator()(const tuple_type_impl& t) { return to_json_string_aux(t, bv); }
-    sstring operator()(const user_type_impl& t) { return to_json_string_aux(t, bv); }
-    sstring operator()(const simple_date_type_impl& t) { return quote_json_string(t.to_string(bv)); }
-    sstring operator()(const time_type_impl& t) { return t.to_string(bv); }
-    sstring operator()(const empty_type_impl& t) { return "null"; }
-    sstring operator()(const duration_type_impl& t) {
+        write_string(out, to_sstring(d));
+    }
+    void operator()(const uuid_type_impl& t) { write_json_string(out, t.to_string(bv)); }
+    void operator()(const inet_addr_type_impl& t) { write_json_string(out, t.to_string(bv)); }
+    void operator()(const string_type_impl& t) {
+        // The serialized form of a string is the string itself, so quote and
+        // escape it straight from the cell bytes.
+        write_json_string(out, std::string_view(reinterpret_cast<const char*>(bv.data()), bv.size()));
+    }
+    void operator()(const bytes_type_impl& t) {
+        // Hex digits never need escaping.
+        out.write("\"0x", 3);
+        write_string(out, t.to_string(bv));
+        out.write("\"", 1);
+    }
+    void operator()(const boolean_type_impl& t) { write_string(out, t.to_string(bv)); }
+    void operator()(const timestamp_date_base_class& t) { write_json_string(out, t.to_string(bv)); }
+    void operator()(const timeuuid_type_impl& t) { write_json_string(out, t.to_string(bv)); }
+    void operator()(const map_type_impl& t) { to_json_aux(t, bv, out); }
+    void operator()(const set_type_impl& t) { to_json_aux(t, bv, out); }
+    void operator()(const list_type_impl& t) { to_json_aux(t, bv, out); }
+    void operator()(const tuple_type_impl& t) { to_json_aux(t, bv, out); }
+    void operator()(const user_type_impl& t) { to_json_aux(t, bv, out); }
+    void operator()(const simple_date_type_impl& t) { write_json_string(out, t.to_string(bv)); }
+    void operator()(const time_type_impl& t) { write_string(out, t.to_string(bv)); }
+    void operator()(const empty_type_impl& t) { out.write("null", 4); }
+    void operator()(const duration_type_impl& t) {
         auto v = t.deserialize(bv);
         if (v.is_null()) {
             throw exceptions::invalid_request_exception("Cannot create JSON string - deserialization error");
         }
-        return quote_json_string(t.to_string(bv));
+        write_json_string(out, t.to_string(bv));
     }
-    sstring operator()(const counter_type_impl& t) {
+    void operator()(const counter_type_impl& t) {
         // It will be called only from cql3 layer while processing query results.
-        return to_json_string(*counter_cell_view::total_value_type(), bv);
+        to_json(*counter_cell_view::total_value_type(), bv, out);
     }
-    sstring operator()(const decimal_type_impl& t) {
+    void operator()(const decimal_type_impl& t) {
         if (bv.empty()) {
             throw exceptions::invalid_request_exception("Cannot create JSON string - deserialization error");
         }
         auto v = t.deserialize(bv);
-        return value_cast<big_decimal>(v).to_string();
+        write_string(out, value_cast<big_decimal>(v).to_string());
     }
-    sstring operator()(const varint_type_impl& t) {
+    void operator()(const varint_type_impl& t) {
         if (bv.empty()) {
             throw exceptions::invalid_request_exception("Cannot create JSON string - deserialization error");
         }
         auto v = t.deserialize(bv);
-        return value_cast<utils::multiprecision_int>(v).str();
+        write_string(out, value_cast<utils::multiprecision_int>(v).str());
     }
 };
 }
 
+void to_json(const abstract_type& t, bytes_view bv, bytes_ostream& out) {
+    visit(t, to_json_visitor{bv, out});
+}
+
+void to_json(const abstract_type& t, const managed_bytes_view& mbv, bytes_ostream& out) {
+    visit(t, to_json_visitor{linearized(mbv), out});
+}
+
 sstring to_json_string(const abstract_type& t, bytes_view bv) {
-    return visit(t, to_json_string_visitor{bv});
+    bytes_ostream out;
+    visit(t, to_json_visitor{bv, out});
+    auto v = out.linearize();
+    return sstring(reinterpret_cast<const char*>(v.data()), v.size());
 }
 
 sstring to_json_string(const abstract_type& t, const managed_bytes_view& mbv) {
-    return visit(t, to_json_string_visitor{linearized(mbv)});
+    return to_json_string(t, bytes_view(linearized(mbv)));
 }
@@ -23,11 +23,25 @@
 
 #include "types.hh"
 #include "utils/rjson.hh"
+#include "bytes_ostream.hh"
 
 bytes from_json_object(const abstract_type &t, const rjson::value& value, cql_serialization_format sf);
 sstring to_json_string(const abstract_type &t, bytes_view bv);
 sstring to_json_string(const abstract_type &t, const managed_bytes_view& bv);
 
+// Streaming variants of to_json_string(). They append the JSON representation
+// of the value directly to \c out, avoiding an intermediate string per value.
+void to_json(const abstract_type& t, bytes_view bv, bytes_ostream& out);
+void to_json(const abstract_type& t, const managed_bytes_view& bv, bytes_ostream& out);
+
+inline void to_json(const abstract_type& t, const bytes_opt& b, bytes_ostream& out) {
+    if (b) {
+        to_json(t, bytes_view(*b), out);
+    } else {
+        out.write("null", 4);
+    }
+}
+
 inline sstring to_json_string(const abstract_type &t, const bytes& b) {
     return to_json_string(t, bytes_view(b));
 }
@@ -120,6 +120,9 @@ struct cql3::untyped_result_set::visitor {
     void accept_value(const query::result_bytes_view& v) {
         tmp.emplace_back(v.linearize());
     }
+    void accept_value(managed_bytes_view v) {
+        tmp.emplace_back(v.linearize());
+    }
     void end_row() {
         rows.emplace_back(untyped_result_set_row(index, meta, std::exchange(tmp, {})));
     }
@@ -32,6 +32,7 @@
 
 #include "utils/fragmented_temporary_buffer.hh"
 #include "utils/overloaded_functor.hh"
+#include "utils/small_vector.hh"
 
 namespace cql3 {
 
@@ -174,6 +175,11 @@ public:
     friend class raw_value;
 };
 
+/// The list of bind variable values of a single request. Almost always short,
+/// so the elements are stored inline to avoid a short-lived allocation on
+/// every request.
+using raw_value_view_vector = utils::small_vector<raw_value_view, 8>;
+
 /// \brief Raw CQL protocol value.
 ///
 /// The `raw_value` type represents an uninterpreted value from the CQL wire
@@ -60,10 +60,12 @@
 #include "utils/fb_utilities.hh"
 #include "utils/stall_free.hh"
 #include "utils/fmt-compat.hh"
+#include "utils/write_path_trace.hh"
 
 #include "db/timeout_clock.hh"
 #include "db/large_data_handler.hh"
 #include "db/data_listeners.hh"
+#include "db/hot_partition_mirror.hh"
 
 #include "user_types_metadata.hh"
 #include <seastar/core/shared_ptr_incomplete.hh>
@@ -386,7 +388,43 @@ database::database(const db::config& cfg, database_config dbcfg, service::migrat
     local_schema_registry().init(*this); // TODO: we're never unbound.
     setup_metrics();
 
+    if (auto sample_frequency = _cfg.continuous_toppartitions_sample_frequency()) {
+        _toppartitions_monitor = std::make_unique<db::toppartitions_monitor>(*this, sample_frequency);
+    }
+
+    if (_cfg.hot_partition_read_mirroring_threshold()) {
+        _hot_partition_tracker = std::make_unique<db::hot_partition_version_tracker>(*this);
+    }
+
+    if (auto threshold_mb = _cfg.large_partition_write_warning_threshold_mb()) {
+        _large_write_monitor = std::make_unique<db::large_write_monitor>(*this, uint64_t(threshold_mb) * 1024 * 1024);
+    }
+
+    _compaction_manager->set_io_pressure_source([this] () -> float {
+        // Fraction of the sstable read concurrency budget consumed by
+        // foreground reads, saturating once reads queue up behind the
+        // semaphore. A full budget means the disk is busy serving
+        // foreground work and compaction should yield to it.
+        if (_read_concurrency_sem.is_unlimited()) {
+            return 0.0f;
+        }
+        if (_read_concurrency_sem.waiters()) {
+            return 1.0f;
+        }
+        auto initial = _read_concurrency_sem.initial_resources().count;
+        auto available = _read_concurrency_sem.available_resources().count;
+        return initial > 0 ? float(initial - available) / initial : 0.0f;
+    });
+
     _row_cache_tracker.set_compaction_scheduling_group(dbcfg.memory_compaction_scheduling_group);
+    _row_cache_tracker.set_index_cache_fraction(_cfg.index_cache_fraction());
+    _row_cache_tracker.set_max_version_chain_depth(_cfg.cache_max_version_chain_depth());
+    if (_cfg.row_cache_admission_filter()) {
+        // Size the sketch to roughly one tracked key per 4KB of shard
+        // memory, which over-provisions it relative to what the cache can
+        // actually hold.
+        _row_cache_tracker.enable_admission_filter(memory::stats().total_memory() / 4096);
+    }
 
     setup_scylla_memory_diagnostics_producer();
     if (_dbcfg.sstables_format) {
@@ -402,7 +440,7 @@ void backlog_controller::adjust() {
     auto backlog = _current_backlog();
 
     if (backlog >= _control_points.back().input) {
-        update_controller(_control_points.back().output);
+        update_controller(throttled(_control_points.back().output));
         return;
     }
 
@@ -416,7 +454,23 @@ void backlog_controller::adjust() {
     control_point& cp = _control_points[idx];
     control_point& last = _control_points[idx - 1];
     float result = last.output + (backlog - last.input) * (cp.output - last.output)/(cp.input - last.input);
-    update_controller(result);
+    update_controller(throttled(result));
+}
+
+float backlog_controller::throttled(float shares) {
+    if (!_io_pressure) {
+        return shares;
+    }
+    auto pressure = std::clamp(_io_pressure(), 0.0f, 1.0f);
+    if (_io_throttled ? pressure < _io_pressure_low : pressure > _io_pressure_high) {
+        _io_throttled = !_io_throttled;
+    }
+    if (!_io_throttled) {
+        return shares;
+    }
+    // Yield to foreground reads, but never go below the idle output so the
+    // backlog keeps draining, just slowly.
+    return std::max(_control_points.front().output, shares * (1.0f - pressure));
 }
 
 float backlog_controller::backlog_of_shares(float shares) const {
@@ -447,6 +501,32 @@ void backlog_controller::update_controller(float shares) {
     _inflight_update = _io_priority.update_shares(uint32_t(shares));
 }
 
+void
+dirty_memory_manager::update_rates() {
+    // EWMA smoothing factor. With 100ms samples this averages over roughly
+    // the last few seconds, long enough to ride out per-batch jitter but
+    // short enough to react to a sustained ingest burst within one flush.
+    constexpr double alpha = 0.1;
+    const double period = std::chrono::duration_cast<std::chrono::duration<double>>(_rate_sample_period).count();
+
+    uint64_t flushed = _dirty_bytes_flushed_total - _last_sampled_flushed_total;
+    _last_sampled_flushed_total = _dirty_bytes_flushed_total;
+    size_t virtual_dirty = virtual_dirty_memory();
+    // Gross ingestion over the interval is the growth of virtual dirty plus
+    // whatever flushing released from it in the same interval. Can dip below
+    // zero when a flushed memtable is disposed of; clamp, since disposal is
+    // not negative ingest.
+    int64_t ingested = int64_t(virtual_dirty) - int64_t(_last_sampled_virtual_dirty) + int64_t(flushed);
+    _last_sampled_virtual_dirty = virtual_dirty;
+
+    _flush_rate += alpha * (flushed / period - _flush_rate);
+    _ingest_rate += alpha * (std::max<int64_t>(ingested, 0) / period - _ingest_rate);
+
+    if (predicted_hard_limit_headroom() <= 0) {
+        _should_flush.signal();
+    }
+}
+
 void
 dirty_memory_manager::setup_collectd(sstring namestr) {
     namespace sm = seastar::metrics;
@@ -459,6 +539,20 @@ dirty_memory_manager::setup_collectd(sstring namestr) {
 
         sm::make_gauge(namestr +"_virtual_dirty_bytes", [this] { return virtual_dirty_memory(); },
                        sm::description("Holds the size of used memory in bytes. Compare it to \"dirty_bytes\" to see how many memory is wasted (neither used nor available).")),
+
+        sm::make_gauge(namestr + "_dirty_ingest_bandwidth", [this] { return ingest_bandwidth(); },
+                       sm::description("Smoothed rate, in bytes per second, at which writes accumulate dirty memory in memtables.")),
+
+        sm::make_gauge(namestr + "_dirty_flush_bandwidth", [this] { return flush_bandwidth(); },
+                       sm::description("Smoothed rate, in bytes per second, at which flushing releases dirty memory.")),
+
+        sm::make_gauge(namestr + "_dirty_headroom_bytes", [this] { return hard_limit_headroom(); },
+                       sm::description("Bytes of dirty memory that can still accumulate before writes are throttled.")),
+
+        sm::make_gauge(namestr + "_predicted_dirty_headroom_bytes", [this] { return predicted_hard_limit_headroom(); },
+                       sm::description("Projected \"dirty_headroom_bytes\" at the end of one flush cycle, assuming current ingest and flush bandwidths. "
+                                       "When this drops to zero a flush is started even if the soft limit hasn't been reached yet. "
+                                       "Negative values mean flushing can't keep up with ingest and writes are expected to throttle.")),
     });
 }
 
@@ -821,23 +915,45 @@ future<> database::parse_system_tables(distributed<service::storage_proxy>& prox
     });
 }
 
+const std::string database::system_commitlog_filename_prefix("SystemLog-");
+
 future<>
 database::init_commitlog() {
     if (_commitlog) {
         return make_ready_future<>();
     }
 
-    return db::commitlog::create_commitlog(db::commitlog::config::from_db_config(_cfg, _dbcfg.available_memory)).then([this](db::commitlog&& log) {
-        _commitlog = std::make_unique<db::commitlog>(std::move(log));
-        _commitlog->add_flush_handler([this](db::cf_id_type id, db::replay_position pos) {
+    auto add_flush_handler = [this] (db::commitlog& log) {
+        log.add_flush_handler([this, cl = &log] (db::cf_id_type id, db::replay_position pos) {
             if (!_column_families.contains(id)) {
                 // the CF has been removed.
-                _commitlog->discard_completed_segments(id);
+                cl->discard_completed_segments(id);
                 return;
             }
             // Initiate a background flush. Waited upon in `stop()`.
             (void)_column_families[id]->flush(pos);
         }).release(); // we have longer life time than CL. Ignore reg anchor
+    };
+
+    auto cfg = db::commitlog::config::from_db_config(_cfg, _dbcfg.available_memory);
+    return db::commitlog::create_commitlog(cfg).then([this, cfg, add_flush_handler] (db::commitlog&& log) mutable {
+        _commitlog = std::make_unique<db::commitlog>(std::move(log));
+        add_flush_handler(*_commitlog);
+        // System tables get a commitlog domain of their own, so that the
+        // segment references of these small-but-frequently-written tables
+        // do not force premature flushes of large user memtables (and user
+        // write bursts do not force flushes of system tables). The domain
+        // shares the commitlog directory with the main one; its segments
+        // are told apart by their filename prefix. Since the tables using
+        // it are small, so is the domain's disk quota.
+        cfg.fname_prefix = system_commitlog_filename_prefix;
+        cfg.metrics_category_name = "system-commitlog";
+        cfg.commitlog_total_space_in_mb = std::min<uint64_t>(cfg.commitlog_total_space_in_mb, 16 * cfg.commitlog_segment_size_in_mb);
+        cfg.max_reserve_segments = 2;
+        return db::commitlog::create_commitlog(std::move(cfg));
+    }).then([this, add_flush_handler] (db::commitlog&& log) {
+        _system_commitlog = std::make_unique<db::commitlog>(std::move(log));
+        add_flush_handler(*_system_commitlog);
     });
 }
 
@@ -886,7 +1002,8 @@ void database::add_column_family(keyspace& ks, schema_ptr schema, column_family:
 
     lw_shared_ptr<column_family> cf;
     if (cfg.enable_commitlog && _commitlog) {
-       cf = make_lw_shared<column_family>(schema, std::move(cfg), *_commitlog, *_compaction_manager, *_cl_stats, _row_cache_tracker);
+       db::commitlog& cl = cfg.use_system_commitlog ? *_system_commitlog : *_commitlog;
+       cf = make_lw_shared<column_family>(schema, std::move(cfg), cl, *_compaction_manager, *_cl_stats, _row_cache_tracker);
     } else {
        cf = make_lw_shared<column_family>(schema, std::move(cfg), column_family::no_commitlog(), *_compaction_manager, *_cl_stats, _row_cache_tracker);
     }
@@ -1120,6 +1237,7 @@ keyspace::make_column_family_config(const schema& s, const database& db) const {
     cfg.enable_disk_reads = _config.enable_disk_reads;
     cfg.enable_disk_writes = _config.enable_disk_writes;
     cfg.enable_commitlog = _config.enable_commitlog;
+    cfg.use_system_commitlog = _config.use_system_commitlog;
     cfg.enable_cache = _config.enable_cache;
     cfg.enable_dangerous_direct_import_of_cassandra_counters = _config.enable_dangerous_direct_import_of_cassandra_counters;
     cfg.compaction_enforce_min_threshold = _config.compaction_enforce_min_threshold;
@@ -1135,7 +1253,9 @@ keyspace::make_column_family_config(const schema& s, const database& db) const {
     cfg.streaming_scheduling_group = _config.streaming_scheduling_group;
     cfg.statement_scheduling_group = _config.statement_scheduling_group;
     cfg.enable_metrics_reporting = db_config.enable_keyspace_column_family_metrics();
+    cfg.latency_metrics_table_limit = db_config.table_latency_metrics_limit();
     cfg.reversed_reads_auto_bypass_cache = db_config.reversed_reads_auto_bypass_cache;
+    cfg.cache_update_concurrency = db_config.cache_update_concurrency();
 
     // avoid self-reporting
     if (is_system_table(s)) {
@@ -1296,6 +1416,9 @@ future<> database::create_in_memory_keyspace(const lw_shared_ptr<keyspace_metada
         kscfg.enable_cache = _cfg.enable_cache();
         // don't make system keyspace writes wait for user writes (if under pressure)
         kscfg.dirty_memory_manager = &_system_dirty_memory_manager;
+        // ...and keep their commitlog segment references from forcing flushes
+        // of (potentially huge) user memtables, and vice versa
+        kscfg.use_system_commitlog = true;
     }
     keyspace ks(ksm, std::move(kscfg), erm_factory);
     co_await ks.create_replication_strategy(get_shared_token_metadata(), ksm->strategy_options());
@@ -1690,6 +1813,7 @@ future<mutation> database::do_apply_counter_update(column_family& cf, const froz
 }
 
 future<> dirty_memory_manager::shutdown() {
+    _rate_sampler.cancel();
     _db_shutdown_requested = true;
     _should_flush.signal();
     return std::move(_waiting_flush).then([this] {
@@ -1853,9 +1977,14 @@ future<> database::apply_with_commitlog(schema_ptr s, column_family& cf, utils::
         db::commitlog::force_sync sync) {
     auto cl = cf.commitlog();
     if (cl != nullptr && cf.durable_writes()) {
+        auto tslot = utils::get_local_write_path_tracer().begin();
         commitlog_entry_writer cew(s, m, sync);
-        return cf.commitlog()->add_entry(uuid, cew, timeout).then([&m, this, s, timeout, cl](db::rp_handle h) {
-            return this->apply_in_memory(m, s, std::move(h), timeout).handle_exception(maybe_handle_reorder);
+        return cf.commitlog()->add_entry(uuid, cew, timeout).then([&m, this, s, timeout, cl, tslot](db::rp_handle h) mutable {
+            tslot.mark(utils::write_path_tracer::stage::commitlog_sync);
+            return this->apply_in_memory(m, s, std::move(h), timeout).handle_exception(maybe_handle_reorder).finally([tslot] () mutable {
+                tslot.mark(utils::write_path_tracer::stage::memtable_apply);
+                utils::get_local_write_path_tracer().end(tslot);
+            });
         });
     }
     return apply_in_memory(m, std::move(s), {}, timeout);
@@ -1968,6 +2097,7 @@ database::make_keyspace_config(const keyspace_metadata& ksm) {
     cfg.streaming_scheduling_group = _dbcfg.streaming_scheduling_group;
     cfg.statement_scheduling_group = _dbcfg.statement_scheduling_group;
     cfg.enable_metrics_reporting = _cfg.enable_keyspace_column_family_metrics();
+    cfg.latency_metrics_table_limit = _cfg.table_latency_metrics_limit();
 
     cfg.view_update_concurrency_semaphore = &_view_update_concurrency_sem;
     cfg.view_update_concurrency_semaphore_limit = max_memory_pending_view_updates();
@@ -2095,10 +2225,16 @@ future<> database::stop() {
     if (_commitlog) {
         co_await _commitlog->shutdown();
     }
+    if (_system_commitlog) {
+        co_await _system_commitlog->shutdown();
+    }
     co_await _view_update_concurrency_sem.wait(max_memory_pending_view_updates());
     if (_commitlog) {
         co_await _commitlog->release();
     }
+    if (_system_commitlog) {
+        co_await _system_commitlog->release();
+    }
     co_await _system_dirty_memory_manager.shutdown();
     co_await _dirty_memory_manager.shutdown();
     co_await _memtable_controller.shutdown();
@@ -2122,6 +2258,21 @@ future<> database::flush(const sstring& ksname, const sstring& cfname) {
     return cf.flush();
 }
 
+future<> database::validate_all_sstables() {
+    // Hold the table objects so concurrent drops don't invalidate the iteration.
+    auto tables = boost::copy_range<std::vector<lw_shared_ptr<table>>>(_column_families | boost::adaptors::map_values);
+    return do_with(std::move(tables), [this] (std::vector<lw_shared_ptr<table>>& tables) {
+        return do_for_each(tables, [this] (lw_shared_ptr<table>& t) {
+            return _compaction_manager->perform_sstable_scrub_validate_mode(&*t).handle_exception([&t] (std::exception_ptr ex) {
+                // Validation of corrupt sstables reports through the log and
+                // quarantine; an exception here means the job itself could not
+                // run (e.g. we are shutting down). Continue with other tables.
+                dblog.warn("Background validation of {}.{} could not run: {}", t->schema()->ks_name(), t->schema()->cf_name(), ex);
+            });
+        });
+    });
+}
+
 future<> database::truncate(sstring ksname, sstring cfname, timestamp_func tsf) {
     auto& ks = find_keyspace(ksname);
     auto& cf = find_column_family(ksname, cfname);
@@ -2313,17 +2464,55 @@ future<> database::flush_system_column_families() {
 }
 
 future<> database::drain() {
-    // Interrupt on going compaction and shutdown to prevent further compaction
-    co_await _compaction_manager->drain();
+    // Interrupt on going compaction and shutdown to prevent further compaction.
+    // The manager stops accepting new jobs right away, so the wind-down of the
+    // running ones can overlap the memtable flushes below -- the two longest
+    // phases of drain are independent of each other.
+    auto stop_compactions = _compaction_manager->drain();
 
     // flush the system ones after all the rest are done, just in case flushing modifies any system state
     // like CASSANDRA-5151. don't bother with progress tracking since system data is tiny.
     co_await _stop_barrier.arrive_and_wait();
     co_await flush_non_system_column_families();
+    co_await std::move(stop_compactions);
+    co_await _stop_barrier.arrive_and_wait();
+    // Everything in the main commitlog is now covered by sstables. Shut it
+    // down before recording that fact below, so that no late write can sneak
+    // into a segment after it was deemed fully flushed.
+    co_await _commitlog->shutdown();
+    co_await _stop_barrier.arrive_and_wait();
+    if (this_shard_id() == 0) {
+        co_await record_clean_commitlog_shutdown();
+    }
     co_await _stop_barrier.arrive_and_wait();
     co_await flush_system_column_families();
     co_await _stop_barrier.arrive_and_wait();
-    co_await _commitlog->shutdown();
+    co_await _system_commitlog->shutdown();
+}
+
+future<> database::record_clean_commitlog_shutdown() {
+    try {
+        // The remaining main-commitlog segments, of all shards, are fully
+        // covered by sstables at this point, so replay may skip them on the
+        // next start. The record is made durable by the system table flush
+        // which follows in drain(). Segment ids grow monotonically across
+        // restarts and a recorded segment is never written to again, so the
+        // record never needs to be invalidated: a crash in a later run only
+        // produces segments with higher ids.
+        auto descs = co_await _commitlog->list_existing_descriptors();
+        db::segment_id_type max_base_id = 0;
+        for (auto& d : descs) {
+            max_base_id = std::max(max_base_id, db::replay_position(d.id).base_id());
+        }
+        auto prev = co_await db::system_keyspace::get_commitlog_clean_shutdown_record();
+        if (max_base_id > prev.value_or(0)) {
+            co_await db::system_keyspace::save_commitlog_clean_shutdown_record(max_base_id);
+            dblog.info("Recorded clean commitlog shutdown at segment id {}", max_base_id);
+        }
+    } catch (...) {
+        // The record is purely an optimization for the next restart's replay.
+        dblog.warn("Failed to record clean commitlog shutdown: {}", std::current_exception());
+    }
 }
 
 std::ostream& operator<<(std::ostream& os, const user_types_metadata& m) {
@@ -126,6 +126,9 @@ class config;
 class extensions;
 class rp_handle;
 class data_listeners;
+class toppartitions_monitor;
+class hot_partition_version_tracker;
+class large_write_monitor;
 class large_data_handler;
 
 future<> system_keyspace_make(distributed<database>& db, distributed<service::storage_service>& ss, sharded<gms::gossiper>& g, db::config& cfg);
@@ -364,6 +367,9 @@ public:
         bool enable_disk_reads = true;
         bool enable_cache = true;
         bool enable_commitlog = true;
+        // Write to the database's system commitlog domain instead of the
+        // main one (see database::init_commitlog()).
+        bool use_system_commitlog = false;
         bool enable_incremental_backups = false;
         utils::updateable_value<bool> compaction_enforce_min_threshold{false};
         bool enable_dangerous_direct_import_of_cassandra_counters = false;
@@ -378,6 +384,9 @@ public:
         seastar::scheduling_group statement_scheduling_group;
         seastar::scheduling_group streaming_scheduling_group;
         bool enable_metrics_reporting = false;
+        // When full per-table metrics are disabled, still export read/write
+        // latency histograms for up to this many tables on this shard.
+        unsigned latency_metrics_table_limit = 0;
         sstables::sstables_manager* sstables_manager;
         db::timeout_semaphore* view_update_concurrency_semaphore;
         size_t view_update_concurrency_semaphore_limit;
@@ -385,6 +394,7 @@ public:
         // Not really table-specific (it's a global configuration parameter), but stored here
         // for easy access from `table` member functions:
         utils::updateable_value<bool> reversed_reads_auto_bypass_cache{true};
+        unsigned cache_update_concurrency = 1;
     };
     struct no_commitlog {};
 
@@ -457,6 +467,9 @@ private:
     std::unique_ptr<cell_locker> _counter_cell_locks; // Memory-intensive; allocate only when needed.
     void set_metrics();
     seastar::metrics::metric_groups _metrics;
+    // True if this table took one of the capped per-table latency histogram
+    // slots (see config::latency_metrics_table_limit).
+    bool _uses_latency_metrics_slot = false;
 
     // holds average cache hit rate of all shards
     // recalculated periodically
@@ -705,6 +718,13 @@ public:
     flat_mutation_reader make_streaming_reader(schema_ptr schema, reader_permit permit, const dht::partition_range& range,
             lw_shared_ptr<sstables::sstable_set> sstables) const;
 
+    // Like the partition_range_vector overload above, but skips the given
+    // sstables. Used by file-based streaming, which transfers the excluded
+    // sstables verbatim.
+    flat_mutation_reader make_streaming_reader(schema_ptr schema, reader_permit permit,
+            const dht::partition_range_vector& ranges,
+            sstables::sstable_list excluded) const;
+
     sstables::shared_sstable make_streaming_sstable_for_write(std::optional<sstring> subdir = {});
     sstables::shared_sstable make_streaming_staging_sstable() {
         return make_streaming_sstable_for_write("staging");
@@ -823,6 +843,10 @@ public:
     future<> compact_all_sstables();
     // Compact all sstables provided in the vector.
     future<> compact_sstables(sstables::compaction_descriptor descriptor, sstables::compaction_data& cdata);
+    // Run several compaction sub-jobs concurrently, each covering a disjoint
+    // partition range of the same input sstables, together forming one
+    // logical compaction. Replacement is coordinated across the sub-jobs.
+    future<> parallel_compact_sstables(std::vector<sstables::compaction_descriptor> descriptors, sstables::compaction_data& cdata);
 
     future<bool> snapshot_exists(sstring name);
 
@@ -1157,6 +1181,7 @@ public:
         std::vector<sstring> all_datadirs;
         sstring datadir;
         bool enable_commitlog = true;
+        bool use_system_commitlog = false;
         bool enable_disk_reads = true;
         bool enable_disk_writes = true;
         bool enable_cache = true;
@@ -1174,6 +1199,7 @@ public:
         seastar::scheduling_group statement_scheduling_group;
         seastar::scheduling_group streaming_scheduling_group;
         bool enable_metrics_reporting = false;
+        unsigned latency_metrics_table_limit = 0;
         db::timeout_semaphore* view_update_concurrency_semaphore = nullptr;
         size_t view_update_concurrency_semaphore_limit;
     };
@@ -1370,6 +1396,7 @@ private:
         flat_hash_map<std::pair<sstring, sstring>, utils::UUID, utils::tuple_hash, string_pair_eq>;
     ks_cf_to_uuid_t _ks_cf_to_uuid;
     std::unique_ptr<db::commitlog> _commitlog;
+    std::unique_ptr<db::commitlog> _system_commitlog;
     utils::updateable_value_source<utils::UUID> _version;
     uint32_t _schema_change_count = 0;
     // compaction_manager object is referenced by all column families of a database.
@@ -1390,6 +1417,12 @@ private:
 
     friend db::data_listeners;
     std::unique_ptr<db::data_listeners> _data_listeners;
+    // Must be declared after _data_listeners: the monitor's listener installs itself there.
+    std::unique_ptr<db::toppartitions_monitor> _toppartitions_monitor;
+    // Same ordering requirement as the toppartitions monitor.
+    std::unique_ptr<db::hot_partition_version_tracker> _hot_partition_tracker;
+    // Same ordering requirement as the toppartitions monitor.
+    std::unique_ptr<db::large_write_monitor> _large_write_monitor;
 
     service::migration_notifier& _mnotifier;
     gms::feature_service& _feat;
@@ -1401,6 +1434,9 @@ private:
     utils::cross_shard_barrier _stop_barrier;
 
 public:
+    // Filename prefix of segments belonging to the system commitlog domain.
+    // They share the commitlog directory with the main domain's segments.
+    static const std::string system_commitlog_filename_prefix;
     future<> init_commitlog();
     const gms::feature_service& features() const { return _feat; }
     future<> apply_in_memory(const frozen_mutation& m, schema_ptr m_schema, db::rp_handle&&, db::timeout_clock::time_point timeout);
@@ -1419,6 +1455,9 @@ public:
 private:
     future<> flush_non_system_column_families();
     future<> flush_system_column_families();
+    // Persists the clean-shutdown commitlog watermark during drain, letting
+    // replay skip the remaining, fully-flushed segments on the next start.
+    future<> record_clean_commitlog_shutdown();
 
     using system_keyspace = bool_class<struct system_keyspace_tag>;
     future<> create_in_memory_keyspace(const lw_shared_ptr<keyspace_metadata>& ksm, locator::effective_replication_map_factory& erm_factory, system_keyspace system);
@@ -1483,6 +1522,9 @@ public:
     db::commitlog* commitlog() const {
         return _commitlog.get();
     }
+    db::commitlog* system_commitlog() const {
+        return _system_commitlog.get();
+    }
 
     seastar::scheduling_group get_statement_scheduling_group() const { return _dbcfg.statement_scheduling_group; }
     seastar::scheduling_group get_streaming_scheduling_group() const { return _dbcfg.streaming_scheduling_group; }
@@ -1495,6 +1537,14 @@ public:
     }
 
     const locator::shared_token_metadata& get_shared_token_metadata() const { return _shared_token_metadata; }
+    // Keeps the token_metadata version alive for as long as the returned
+    // pointer is held, so it is safe to use across yields. Readers get a
+    // consistent snapshot; writers publish new versions with a pointer swap.
+    locator::token_metadata_ptr get_token_metadata_ptr() const { return _shared_token_metadata.get(); }
+    // The returned reference is only guaranteed to be valid until the next
+    // yield: a topology change may publish a new version and drop the one
+    // this reference points into. Use get_token_metadata_ptr() to hold a
+    // snapshot across yields.
     const locator::token_metadata& get_token_metadata() const { return *_shared_token_metadata.get(); }
 
     service::migration_notifier& get_notifier() { return _mnotifier; }
@@ -1625,6 +1675,12 @@ public:
     future<> flush_all_memtables();
     future<> flush(const sstring& ks, const sstring& cf);
 
+    // Validates all sstables of all tables on this shard, one table at a
+    // time, quarantining sstables found corrupt. Runs in the maintenance
+    // scheduling group; used for the background validation pass after boot
+    // (validate_sstables_after_boot).
+    future<> validate_all_sstables();
+
     // See #937. Truncation now requires a callback to get a time stamp
     // that must be guaranteed to be the same for all shards.
     typedef std::function<future<db_clock::time_point>()> timestamp_func;
@@ -1642,6 +1698,11 @@ public:
         return _dirty_memory_manager.region_group();
     }
 
+    // Fraction of the dirty memory throttle threshold currently in use, in [0, 1].
+    double dirty_memory_pressure() const {
+        return double(_dirty_memory_manager.virtual_dirty_memory()) / _dirty_memory_manager.throttle_threshold();
+    }
+
     std::unordered_set<sstring> get_initial_tokens();
     std::optional<gms::inet_address> get_replace_address();
     bool is_replacing();
@@ -1670,6 +1731,12 @@ public:
         return *_data_listeners;
     }
 
+    // Engaged only when hot partition read mirroring is enabled, see
+    // db/hot_partition_mirror.hh.
+    db::hot_partition_version_tracker* hot_partition_tracker() const {
+        return _hot_partition_tracker.get();
+    }
+
     // Get the maximum result size for an unlimited query, appropriate for the
     // query class, which is deduced from the current scheduling group.
     query::max_result_size get_unlimited_query_max_result_size() const;
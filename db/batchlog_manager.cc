@@ -38,6 +38,7 @@
  * along with Scylla.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <algorithm>
 #include <chrono>
 #include <seastar/core/future-util.hh>
 #include <seastar/core/do_with.hh>
@@ -77,6 +78,7 @@ static logging::logger blogger("batchlog_manager");
 
 const uint32_t db::batchlog_manager::replay_interval;
 const uint32_t db::batchlog_manager::page_size;
+const uint32_t db::batchlog_manager::max_replay_concurrency;
 
 db::batchlog_manager::batchlog_manager(cql3::query_processor& qp, batchlog_manager_config config)
         : _qp(qp)
@@ -98,18 +100,15 @@ future<> db::batchlog_manager::do_batch_log_replay() {
         auto gate_holder = bm._gate.hold();
         auto sem_units = co_await get_units(bm._sem, 1);
 
-        auto dest = bm._cpu++ % smp::count;
-        blogger.debug("Batchlog replay on shard {}: starts", dest);
-        if (dest == 0) {
-            co_await bm.replay_all_failed_batches();
-        } else {
-            co_await bm.container().invoke_on(dest, [] (auto& bm) {
-                return with_gate(bm._gate, [&bm] {
-                    return bm.replay_all_failed_batches();
-                });
+        blogger.debug("Batchlog replay: starts");
+        // Each shard replays only the batches it owns (by the token of the
+        // batch id), so the shards can run in parallel without overlapping.
+        co_await bm.container().invoke_on_all([] (auto& bm) {
+            return with_gate(bm._gate, [&bm] {
+                return bm.replay_all_failed_batches();
             });
-        }
-        blogger.debug("Batchlog replay on shard {}: done", dest);
+        });
+        blogger.debug("Batchlog replay: done");
     });
 }
 
@@ -132,12 +131,12 @@ future<> db::batchlog_manager::batchlog_replay_loop() {
 }
 
 future<> db::batchlog_manager::start() {
-    // Since replay is a "node global" operation, we should not attempt to do
-    // it in parallel on each shard. It will just overlap/interfere.  To
+    // Since replay is a "node global" operation, we should not attempt to
+    // run two replay cycles concurrently. They would just overlap/interfere. To
     // simplify syncing between batchlog_replay_loop and user initiated replay operations,
-    // we use the _sem on shard zero only. Replaying batchlog can
-    // generate a lot of work, so we distrute the real work on all cpus with
-    // round-robin scheduling.
+    // we use the _sem on shard zero only. Within one cycle the work is
+    // partitioned by the owning shard of each batch id, so all cpus replay
+    // their own batches in parallel.
     if (this_shard_id() == 0) {
         _started = batchlog_replay_loop();
     }
@@ -292,23 +291,64 @@ future<> db::batchlog_manager::replay_all_failed_batches() {
         });
     };
 
-    return seastar::with_gate(_gate, [this, batch = std::move(batch)] {
+    auto batchlog_schema = _qp.db().find_schema(system_keyspace::NAME, system_keyspace::BATCHLOG);
+
+    // The scan itself only reads ids and timestamps; the batch data blob is
+    // fetched separately, and only for the entries which are actually due for
+    // replay. A periodic cycle with nothing due thus avoids reading the data.
+    auto process = [this, batch = std::move(batch), batchlog_schema = std::move(batchlog_schema)] (const cql3::untyped_result_set::row& row) {
+        auto written_at = row.get_as<db_clock::time_point>("written_at");
+        auto id = row.get_as<utils::UUID>("id");
+        if (db_clock::now() < written_at + get_batch_log_timeout()) {
+            blogger.debug("Skipping replay of {}, too fresh", id);
+            return make_ready_future<>();
+        }
+        // Every shard scans the whole (id-ordered) batchlog, but replays only
+        // the batches it owns, so the shards replay in parallel without overlap.
+        auto token = dht::get_token(*batchlog_schema, partition_key::from_singular(*batchlog_schema, id));
+        if (dht::shard_of(*batchlog_schema, token) != this_shard_id()) {
+            return make_ready_future<>();
+        }
+        sstring query = format("SELECT id, data, written_at, version FROM {}.{} WHERE id = ?", system_keyspace::NAME, system_keyspace::BATCHLOG);
+        return _qp.execute_internal(query, {id}).then([batch] (::shared_ptr<cql3::untyped_result_set> rs) {
+            if (rs->empty()) {
+                // the batch was replayed and deleted by someone else in the meantime
+                return make_ready_future<>();
+            }
+            return batch(rs->one());
+        });
+    };
+
+    // Replay batches in parallel, but keep the parallelism in check: allow
+    // roughly as many concurrent replays as fit into one batchlog timeout at
+    // the current mean write latency, so that an already slow cluster is not
+    // swamped with replay writes on top of the regular load.
+    auto replay_concurrency = [this] () -> size_t {
+        auto mean_write_latency_us = _qp.proxy().get_stats().write.hist.mean; // microseconds
+        if (mean_write_latency_us <= 0) {
+            return max_replay_concurrency;
+        }
+        auto timeout_us = std::chrono::duration_cast<std::chrono::microseconds>(get_batch_log_timeout()).count();
+        return std::clamp<size_t>(timeout_us / mean_write_latency_us, 1, max_replay_concurrency);
+    };
+
+    return seastar::with_gate(_gate, [this, process = std::move(process), replay_concurrency = std::move(replay_concurrency)] {
         blogger.debug("Started replayAllFailedBatches (cpu {})", this_shard_id());
 
         typedef ::shared_ptr<cql3::untyped_result_set> page_ptr;
-        sstring query = format("SELECT id, data, written_at, version FROM {}.{} LIMIT {:d}", system_keyspace::NAME, system_keyspace::BATCHLOG, page_size);
-        return _qp.execute_internal(query).then([this, batch = std::move(batch)](page_ptr page) {
-            return do_with(std::move(page), [this, batch = std::move(batch)](page_ptr & page) mutable {
-                return repeat([this, &page, batch = std::move(batch)]() mutable {
+        sstring query = format("SELECT id, written_at FROM {}.{} LIMIT {:d}", system_keyspace::NAME, system_keyspace::BATCHLOG, page_size);
+        return _qp.execute_internal(query).then([this, process = std::move(process), replay_concurrency = std::move(replay_concurrency)](page_ptr page) {
+            return do_with(std::move(page), [this, process = std::move(process), replay_concurrency = std::move(replay_concurrency)](page_ptr & page) mutable {
+                return repeat([this, &page, process = std::move(process), replay_concurrency = std::move(replay_concurrency)]() mutable {
                     if (page->empty()) {
                         return make_ready_future<stop_iteration>(stop_iteration::yes);
                     }
                     auto id = page->back().get_as<utils::UUID>("id");
-                    return parallel_for_each(*page, batch).then([this, &page, id]() {
+                    return max_concurrent_for_each(*page, replay_concurrency(), process).then([this, &page, id]() {
                         if (page->size() < page_size) {
                             return make_ready_future<stop_iteration>(stop_iteration::yes); // we've exhausted the batchlog, next query would be empty.
                         }
-                        sstring query = format("SELECT id, data, written_at, version FROM {}.{} WHERE token(id) > token(?) LIMIT {:d}",
+                        sstring query = format("SELECT id, written_at FROM {}.{} WHERE token(id) > token(?) LIMIT {:d}",
                                 system_keyspace::NAME,
                                 system_keyspace::BATCHLOG,
                                 page_size);
@@ -77,6 +77,7 @@ class batchlog_manager : public peering_sharded_service<batchlog_manager> {
 private:
     static constexpr uint32_t replay_interval = 60 * 1000; // milliseconds
     static constexpr uint32_t page_size = 128; // same as HHOM, for now, w/out using any heuristics. TODO: set based on avg batch size.
+    static constexpr uint32_t max_replay_concurrency = 32; // per-shard bound on batches replayed in parallel
 
     using clock_type = lowres_clock;
 
@@ -94,7 +95,6 @@ private:
     std::chrono::milliseconds _delay;
     semaphore _sem{1};
     seastar::gate _gate;
-    unsigned _cpu = 0;
     seastar::abort_source _stop;
 
     future<> replay_all_failed_batches();
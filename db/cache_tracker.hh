@@ -21,12 +21,15 @@
 
 #pragma once
 
+#include "utils/estimated_histogram.hh"
+#include "utils/frequency_sketch.hh"
 #include "utils/lru.hh"
 #include "utils/logalloc.hh"
 #include "partition_version.hh"
 #include "mutation_cleaner.hh"
 
 #include <seastar/core/metrics_registration.hh>
+#include <seastar/util/noncopyable_function.hh>
 
 #include <stdint.h>
 
@@ -79,6 +82,16 @@ public:
         uint64_t pinned_dirty_memory_overload;
         uint64_t range_tombstone_reads;
         uint64_t row_tombstone_reads;
+        uint64_t partition_admissions;
+        uint64_t partition_admission_rejections;
+        uint64_t index_evictions;
+        uint64_t version_chain_flattens;
+
+        // Duration of population batches (the LSA update section in which
+        // fragments from the underlying reader are inserted into cache).
+        utils::time_estimated_histogram population_latency;
+        // Duration of single eviction steps performed on memory pressure.
+        utils::time_estimated_histogram eviction_latency;
 
         uint64_t active_reads() const {
             return reads - reads_done;
@@ -89,8 +102,26 @@ private:
     seastar::metrics::metric_groups _metrics;
     logalloc::region _region;
     lru _lru;
+    // Separate eviction domain for sstable index pages (partition index
+    // pages and index file page cache). Index pages are more expensive to
+    // rebuild per byte than data rows, so they are evicted only while they
+    // exceed their configured share of the region, or when there's nothing
+    // else left to evict.
+    lru _index_lru;
+    // Returns the number of bytes currently held by the index domain.
+    // Registered by the sstables layer, which owns the index caches.
+    noncopyable_function<size_t()> _index_bytes_source;
+    double _index_cache_fraction = 0.2;
     mutation_cleaner _garbage;
     mutation_cleaner _memtable_cleaner;
+    // When engaged, tracks approximate partition access frequencies and
+    // gates admission of new partitions into cache, so that one-off scans
+    // don't evict the frequently-read set.
+    std::optional<utils::frequency_sketch> _admission_sketch;
+    // Reads of a cached partition whose version chain is deeper than this
+    // hand the chain over to the cleaner for background flattening.
+    // 0 disables proactive flattening.
+    unsigned _max_version_chain_depth = 8;
 private:
     void setup_metrics();
 public:
@@ -110,6 +141,17 @@ public:
     void on_partition_merge() noexcept;
     void on_partition_hit() noexcept;
     void on_partition_miss() noexcept;
+    // Enables the TinyLFU-style admission filter, sized to track
+    // approximately tracked_keys distinct partitions.
+    void enable_admission_filter(size_t tracked_keys);
+    bool has_admission_filter() const noexcept { return bool(_admission_sketch); }
+    // Records a read access to a partition with the given raw token,
+    // for frequency estimation.
+    void on_partition_access(int64_t raw_token) noexcept;
+    // Decides whether a partition missing from cache should be admitted on
+    // population. Must be called before on_partition_access() for this read,
+    // so that a key's first access doesn't count towards its own admission.
+    bool should_admit(int64_t raw_token) noexcept;
     void on_partition_eviction() noexcept;
     void on_row_eviction() noexcept;
     void on_row_hit() noexcept;
@@ -132,6 +174,13 @@ public:
     const stats& get_stats() const noexcept { return _stats; }
     void set_compaction_scheduling_group(seastar::scheduling_group);
     lru& get_lru() { return _lru; }
+    lru& get_index_lru() { return _index_lru; }
+    void set_index_cache_fraction(double fraction) { _index_cache_fraction = fraction; }
+    unsigned max_version_chain_depth() const noexcept { return _max_version_chain_depth; }
+    void set_max_version_chain_depth(unsigned depth) { _max_version_chain_depth = depth; }
+    void on_version_chain_flatten() noexcept { ++_stats.version_chain_flattens; }
+    void on_population_batch(utils::time_estimated_histogram::duration d) { _stats.population_latency.add(d); }
+    void register_index_bytes_source(noncopyable_function<size_t()> src) { _index_bytes_source = std::move(src); }
 };
 
 inline
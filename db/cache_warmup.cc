@@ -0,0 +1,199 @@
+/*
+ * Copyright (C) 2021-present ScyllaDB
+ */
+
+/*
+ * This file is part of Scylla.
+ *
+ * Scylla is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Scylla is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Scylla.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <seastar/core/byteorder.hh>
+#include <seastar/core/coroutine.hh>
+#include <seastar/core/file.hh>
+#include <seastar/core/fstream.hh>
+#include <seastar/core/loop.hh>
+#include <seastar/core/seastar.hh>
+
+#include "db/cache_warmup.hh"
+#include "db/timeout_clock.hh"
+#include "database.hh"
+#include "log.hh"
+
+namespace db {
+
+static logging::logger cwlogger("cache_warmup");
+
+static constexpr uint32_t hot_set_magic = 0x53434853; // "SCHS"
+static constexpr uint32_t hot_set_version = 1;
+
+// Limits the number of partitions being read back concurrently during
+// warm-up, so that warming doesn't starve the startup process of I/O.
+static constexpr size_t warmup_concurrency = 16;
+
+static sstring hot_set_filename(const column_family& cf) {
+    return format("{}/hot-keys-{}.bin", cf.dir(), this_shard_id());
+}
+
+static future<> write_u32(output_stream<char>& out, uint32_t v) {
+    v = cpu_to_le(v);
+    return out.write(reinterpret_cast<const char*>(&v), sizeof(v));
+}
+
+static future<std::optional<uint32_t>> read_u32(input_stream<char>& in) {
+    return in.read_exactly(sizeof(uint32_t)).then([] (temporary_buffer<char> buf) {
+        if (buf.size() != sizeof(uint32_t)) {
+            return std::optional<uint32_t>();
+        }
+        uint32_t v;
+        std::copy_n(buf.get(), sizeof(v), reinterpret_cast<char*>(&v));
+        return std::optional<uint32_t>(le_to_cpu(v));
+    });
+}
+
+future<> save_row_cache_hot_set(column_family& cf, size_t max_keys) {
+    auto keys = cf.get_row_cache().cached_partition_keys(max_keys);
+    auto path = hot_set_filename(cf);
+    auto tmp_path = path + ".tmp";
+    file f = co_await open_file_dma(tmp_path, open_flags::wo | open_flags::create | open_flags::truncate);
+    auto out = co_await make_file_output_stream(std::move(f));
+    std::exception_ptr ex;
+    try {
+        co_await write_u32(out, hot_set_magic);
+        co_await write_u32(out, hot_set_version);
+        co_await write_u32(out, keys.size());
+        for (auto& dk : keys) {
+            bytes b = to_bytes(dk.key().representation());
+            co_await write_u32(out, b.size());
+            co_await out.write(reinterpret_cast<const char*>(b.data()), b.size());
+        }
+        co_await out.flush();
+    } catch (...) {
+        ex = std::current_exception();
+    }
+    co_await out.close();
+    if (ex) {
+        std::rethrow_exception(ex);
+    }
+    co_await rename_file(tmp_path, path);
+    co_await sync_directory(cf.dir());
+    cwlogger.debug("Saved {} cached partition keys for {}.{}", keys.size(),
+            cf.schema()->ks_name(), cf.schema()->cf_name());
+}
+
+future<> save_row_cache_hot_sets(database& db) {
+    size_t max_keys = db.get_config().row_cache_keys_to_save();
+    std::vector<lw_shared_ptr<column_family>> tables;
+    tables.reserve(db.get_column_families().size());
+    for (auto& [uuid, cf] : db.get_column_families()) {
+        tables.push_back(cf);
+    }
+    for (auto& cf : tables) {
+        try {
+            co_await save_row_cache_hot_set(*cf, max_keys);
+        } catch (...) {
+            cwlogger.warn("Failed to save row cache hot set for {}.{}: {}",
+                    cf->schema()->ks_name(), cf->schema()->cf_name(), std::current_exception());
+        }
+    }
+}
+
+static future<> warm_table(database& db, lw_shared_ptr<column_family> cf) {
+    auto path = hot_set_filename(*cf);
+    if (!co_await file_exists(path)) {
+        co_return;
+    }
+    file f = co_await open_file_dma(path, open_flags::ro);
+    auto in = make_file_input_stream(std::move(f));
+    std::vector<dht::decorated_key> keys;
+    std::exception_ptr ex;
+    try {
+        auto magic = co_await read_u32(in);
+        auto version = co_await read_u32(in);
+        auto count = co_await read_u32(in);
+        if (magic != hot_set_magic || version != hot_set_version || !count) {
+            cwlogger.warn("Ignoring malformed hot set file {}", path);
+        } else {
+            auto s = cf->schema();
+            keys.reserve(*count);
+            for (uint32_t i = 0; i < *count; ++i) {
+                auto len = co_await read_u32(in);
+                if (!len) {
+                    break; // Truncated file, warm with what we have.
+                }
+                auto buf = co_await in.read_exactly(*len);
+                if (buf.size() != *len) {
+                    break;
+                }
+                auto pk = partition_key::from_bytes(bytes(reinterpret_cast<const int8_t*>(buf.get()), buf.size()));
+                auto dk = dht::decorate_key(*s, std::move(pk));
+                // The checkpoint may come from a run with a different shard
+                // count. Keys which moved to another shard are warmed by the
+                // owner of that shard's file, or not at all.
+                if (dht::shard_of(*s, dk.token()) == this_shard_id()) {
+                    keys.push_back(std::move(dk));
+                }
+            }
+        }
+    } catch (...) {
+        ex = std::current_exception();
+    }
+    co_await in.close();
+    if (ex) {
+        std::rethrow_exception(ex);
+    }
+    co_await max_concurrent_for_each(keys, warmup_concurrency, [&db, &cf] (const dht::decorated_key& dk) -> future<> {
+        try {
+            auto timeout = timeout_clock::now() + std::chrono::seconds(5);
+            auto permit = co_await db.obtain_reader_permit(*cf, "cache-warmup", timeout);
+            auto range = dht::partition_range::make_singular(dk);
+            auto rd = cf->get_row_cache().make_reader(cf->schema(), std::move(permit), range);
+            std::exception_ptr rd_ex;
+            try {
+                while (co_await rd()) {
+                    // Drain the reader; reading through the cache populates it.
+                }
+            } catch (...) {
+                rd_ex = std::current_exception();
+            }
+            co_await rd.close();
+            if (rd_ex) {
+                std::rethrow_exception(rd_ex);
+            }
+        } catch (...) {
+            cwlogger.debug("Failed to warm partition {} of {}.{}: {}", dk,
+                    cf->schema()->ks_name(), cf->schema()->cf_name(), std::current_exception());
+        }
+    });
+    cwlogger.info("Warmed {} partitions of {}.{}", keys.size(),
+            cf->schema()->ks_name(), cf->schema()->cf_name());
+}
+
+future<> warm_row_caches(database& db) {
+    std::vector<lw_shared_ptr<column_family>> tables;
+    tables.reserve(db.get_column_families().size());
+    for (auto& [uuid, cf] : db.get_column_families()) {
+        tables.push_back(cf);
+    }
+    for (auto& cf : tables) {
+        try {
+            co_await warm_table(db, cf);
+        } catch (...) {
+            cwlogger.warn("Failed to warm row cache of {}.{}: {}",
+                    cf->schema()->ks_name(), cf->schema()->cf_name(), std::current_exception());
+        }
+    }
+}
+
+}
@@ -0,0 +1,59 @@
+/*
+ * Copyright (C) 2021-present ScyllaDB
+ */
+
+/*
+ * This file is part of Scylla.
+ *
+ * Scylla is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Scylla is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Scylla.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <seastar/core/future.hh>
+#include "seastarx.hh"
+
+class database;
+class table;
+using column_family = table;
+
+namespace db {
+
+// Row cache hot-set checkpointing.
+//
+// The contents of the row cache are lost on restart and re-warming it from
+// sstables can take a long time, during which read latencies are elevated.
+// To speed this up, the set of partition keys currently present in the cache
+// (not the data itself) can be checkpointed to a small per-shard file in the
+// table directory. On startup, before the node starts serving CQL traffic,
+// the saved keys are replayed through the regular read path at limited
+// concurrency, re-populating the cache from sstables.
+//
+// The checkpoint is advisory: missing, truncated or stale files are ignored,
+// and keys which no longer belong to this shard are skipped.
+
+// Saves the hot set of every table on this shard.
+future<> save_row_cache_hot_sets(database& db);
+
+// Saves the set of partition keys currently cached for the given table into
+// <table dir>/hot-keys-<shard>.bin. At most max_keys keys are saved;
+// 0 means no limit.
+future<> save_row_cache_hot_set(column_family& cf, size_t max_keys);
+
+// Re-populates row caches of all tables on this shard from previously saved
+// hot-set checkpoints by reading the saved keys through the regular read
+// path. Errors on individual keys or tables are logged and ignored.
+future<> warm_row_caches(database& db);
+
+}
@@ -80,6 +80,7 @@
 #include "log.hh"
 #include "commitlog_entry.hh"
 #include "commitlog_extensions.hh"
+#include "compress.hh"
 #include "service/priority_manager.hh"
 #include "serializer.hh"
 
@@ -133,10 +134,12 @@ db::commitlog::config db::commitlog::config::from_db_config(const db::config& cf
     c.commitlog_total_space_in_mb = cfg.commitlog_total_space_in_mb() >= 0 ? cfg.commitlog_total_space_in_mb() : (shard_available_memory * smp::count) >> 20;
     c.commitlog_segment_size_in_mb = cfg.commitlog_segment_size_in_mb();
     c.commitlog_sync_period_in_ms = cfg.commitlog_sync_period_in_ms();
+    c.commitlog_sync_batch_window_in_ms = cfg.commitlog_sync_batch_window_in_ms();
     c.mode = cfg.commitlog_sync() == "batch" ? sync_mode::BATCH : sync_mode::PERIODIC;
     c.extensions = &cfg.extensions();
     c.reuse_segments = cfg.commitlog_reuse_segments();
     c.use_o_dsync = cfg.commitlog_use_o_dsync();
+    c.compress_entries = cfg.commitlog_compress_entries();
     c.allow_going_over_size_limit = !cfg.commitlog_use_hard_size_limit();
 
     return c;
@@ -302,6 +305,53 @@ public:
         _request_controller.signal(size);
     }
 
+    // Adaptive group-commit controller ("batch" sync mode). Tracks EWMAs of
+    // disk sync latency and sync request inter-arrival time, and derives a
+    // window to wait for more writers to join a sync before it is issued.
+    // The window is only non-zero while the configured batch window leaves
+    // latency budget to spare beyond the expected sync itself, and while
+    // requests arrive often enough that waiting actually grows the batch.
+    std::chrono::microseconds _sync_latency_ewma{0};
+    std::chrono::microseconds _sync_interarrival_ewma{0};
+    std::optional<std::chrono::steady_clock::time_point> _last_sync_request;
+
+    static std::chrono::microseconds ewma_add(std::chrono::microseconds ewma, std::chrono::microseconds sample) {
+        // first sample seeds the average, then alpha = 1/8
+        return ewma == std::chrono::microseconds(0) ? sample : ewma + (sample - ewma) / 8;
+    }
+
+    void account_sync_request() {
+        auto now = std::chrono::steady_clock::now();
+        if (_last_sync_request) {
+            _sync_interarrival_ewma = ewma_add(_sync_interarrival_ewma, std::chrono::duration_cast<std::chrono::microseconds>(now - *_last_sync_request));
+        }
+        _last_sync_request = now;
+    }
+
+    void account_sync_latency(std::chrono::microseconds latency) {
+        _sync_latency_ewma = ewma_add(_sync_latency_ewma, latency);
+    }
+
+    std::chrono::microseconds next_batch_window() const {
+        using namespace std::chrono_literals;
+        if (_sync_latency_ewma == 0us || _sync_interarrival_ewma == 0us) {
+            // no signal yet - sync immediately
+            return 0us;
+        }
+        // Budget for added latency: the configured window minus a rough
+        // p99 estimate (2x mean) of the sync we pay in any case.
+        auto budget = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::milliseconds(cfg.commitlog_sync_batch_window_in_ms)) - 2 * _sync_latency_ewma;
+        if (budget <= 0us || _sync_interarrival_ewma >= budget) {
+            // Either the disk alone eats the latency target, or requests
+            // arrive so rarely that waiting would add latency for nothing.
+            return 0us;
+        }
+        // Waiting for about two average arrivals captures the bulk of a
+        // burst; waiting longer than the sync itself can at most halve the
+        // sync count while doubling latency, so cap there as well.
+        return std::min({budget, _sync_latency_ewma, 2 * _sync_interarrival_ewma});
+    }
+
     template<typename T, typename R = typename T::result_type>
     requires std::derived_from<T, db::commitlog::entry_writer> && std::same_as<R, decltype(std::declval<T>().result())>
     future<R> allocate_when_possible(T writer, db::timeout_clock::time_point timeout);
@@ -323,6 +373,8 @@ public:
         // size allocated on disk - i.e. files created (new, reserve, recycled)
         uint64_t total_size_on_disk = 0;
         uint64_t requests_blocked_memory = 0;
+        uint64_t batch_delayed_syncs = 0;
+        uint64_t batch_delay_us = 0;
     };
 
     stats totals;
@@ -406,6 +458,7 @@ public:
     using buffer_type = fragmented_temporary_buffer;
 
     buffer_type acquire_buffer(size_t s, size_t align);
+    void release_buffer(buffer_type&&, size_t align);
     temporary_buffer<char> allocate_single_buffer(size_t, size_t);
 
     future<std::vector<descriptor>> list_descriptors(sstring dir);
@@ -447,6 +500,12 @@ private:
     uint64_t _new_counter = 0;
     std::optional<size_t> _disk_write_alignment;
     seastar::semaphore _reserve_recalculation_guard;
+    // DMA-aligned fragments recycled from cycled-out buffers once their
+    // write completed, so steady-state segment writing does not pay for an
+    // aligned allocation per cycle.
+    static constexpr size_t max_spare_buffers = 8;
+    std::vector<temporary_buffer<char>> _spare_buffers;
+    size_t _spare_buffers_alignment = 0;
 };
 
 template<typename T>
@@ -747,7 +806,9 @@ public:
         }
 
         try {
+            auto start = std::chrono::steady_clock::now();
             co_await _file.flush();
+            _segment_manager->account_sync_latency(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start));
             // TODO: retry/ignore/fail/stop - optional behaviour in origin.
             // we fast-fail the whole commit.
             _flush_pos = std::max(pos, _flush_pos);
@@ -904,6 +965,9 @@ public:
                 co_await do_flush(top);
             }
         });
+
+        // the write is done with the buffer; let its fragments be reused.
+        _segment_manager->release_buffer(std::move(buf), _alignment);
         co_return me;
     }
 
@@ -918,6 +982,7 @@ public:
          */
         auto me = shared_from_this();
         auto fp = _file_pos;
+        _segment_manager->account_sync_request();
         try {
             co_await _pending_ops.wait_for_pending(timeout);
             if (fp != _file_pos) {
@@ -936,6 +1001,15 @@ public:
                     co_await do_flush(fp);
                 }
             } else {
+                // Adaptive group commit: when the latency budget allows it,
+                // wait a short window for more writers to join this sync, so
+                // moderate load produces fewer, larger disk syncs.
+                auto window = _segment_manager->next_batch_window();
+                if (window > std::chrono::microseconds(0) && timeout - timeout_clock::now() > 2 * window) {
+                    co_await seastar::sleep(window);
+                    ++_segment_manager->totals.batch_delayed_syncs;
+                    _segment_manager->totals.batch_delay_us += window.count();
+                }
                 // It is ok to leave the sync behind on timeout because there will be at most one
                 // such sync, all later allocations will block on _pending_ops until it is done.
                 co_await with_timeout(timeout, sync());
@@ -976,7 +1050,9 @@ public:
         }
 
         const auto size = writer.size(*this);
-        const auto s = size + writer.num_entries * entry_overhead_size + (writer.num_entries > 1 ? multi_entry_overhead_size : 0u); // total size
+        // version 3 entries carry a uint32_t compression marker in front of the payload
+        const auto per_entry_overhead = entry_overhead_size + (compress_entries() ? sizeof(uint32_t) : 0u);
+        const auto s = size + writer.num_entries * per_entry_overhead + (writer.num_entries > 1 ? multi_entry_overhead_size : 0u); // total size
 
         _segment_manager->sanity_check_size(s);
 
@@ -1010,6 +1086,41 @@ public:
 
         std::optional<crc32_nbo> mecrc;
 
+        // For version 3 segments, serialize and compress the entry payloads
+        // up front: the multi-entry header and the entry headers hold on-disk
+        // sizes, which are only known once compression has run. Payloads
+        // that do not shrink are stored raw, with a zero marker.
+        struct entry_payload {
+            temporary_buffer<char> data;
+            uint32_t uncompressed; // zero -> stored raw
+        };
+        std::vector<entry_payload> payloads;
+        auto actual_size = s;
+        if (compress_entries()) {
+            payloads.reserve(writer.num_entries);
+            actual_size = writer.num_entries > 1 ? multi_entry_overhead_size : 0u;
+            for (size_t entry = 0; entry < writer.num_entries; ++entry) {
+                auto entry_size = writer.num_entries == 1 ? size : writer.size(*this, entry);
+                temporary_buffer<char> raw(entry_size);
+                std::vector<temporary_buffer<char>> frags;
+                frags.emplace_back(raw.share());
+                fragmented_temporary_buffer scratch(std::move(frags), entry_size);
+                auto sout = scratch.get_ostream();
+                writer.write(*this, sout, entry);
+
+                auto& lz4 = *compressor::lz4;
+                temporary_buffer<char> compressed(lz4.compress_max_size(entry_size));
+                auto clen = lz4.compress(raw.get(), entry_size, compressed.get_write(), compressed.size());
+                if (clen < entry_size) {
+                    compressed.trim(clen);
+                    payloads.push_back(entry_payload{std::move(compressed), uint32_t(entry_size)});
+                } else {
+                    payloads.push_back(entry_payload{std::move(raw), 0});
+                }
+                actual_size += payloads.back().data.size() + per_entry_overhead;
+            }
+        }
+
         // if this is multi-entry write, we need to add an extra header + crc
         // the header and crc formula is:
         // header:
@@ -1022,16 +1133,18 @@ public:
         if (writer.num_entries > 1) {
             mecrc.emplace();
             write<uint32_t>(out, multi_entry_size_magic);
-            write<uint32_t>(out, s);
+            write<uint32_t>(out, uint32_t(actual_size));
             mecrc->process(multi_entry_size_magic);
-            mecrc->process(uint32_t(s));
+            mecrc->process(uint32_t(actual_size));
             write<uint32_t>(out, mecrc->checksum());
         }
 
         for (size_t entry = 0; entry < writer.num_entries; ++entry) {
             replay_position rp(_desc.id, position());
             auto id = writer.id(entry);
-            auto entry_size = writer.num_entries == 1 ? size : writer.size(*this, entry);
+            auto entry_size = compress_entries()
+                    ? payloads[entry].data.size() + sizeof(uint32_t)
+                    : (writer.num_entries == 1 ? size : writer.size(*this, entry));
             auto es = entry_size + entry_overhead_size;
 
             _cf_dirty[id]++; // increase use count for cf.
@@ -1045,12 +1158,20 @@ public:
             write<uint32_t>(out, crc.checksum());
 
             // actual data
-            auto entry_out = out.write_substream(entry_size);
-            auto entry_data = entry_out.to_input_stream();
-            writer.write(*this, entry_out, entry);
-            entry_data.with_stream([&] (auto data_str) {
-                crc.process_fragmented(ser::buffer_view<typename std::vector<temporary_buffer<char>>::iterator>(data_str));
-            });
+            if (compress_entries()) {
+                auto& p = payloads[entry];
+                write<uint32_t>(out, p.uncompressed);
+                crc.process(p.uncompressed);
+                out.write(p.data.get(), p.data.size());
+                crc.process(reinterpret_cast<const uint8_t*>(p.data.get()), p.data.size());
+            } else {
+                auto entry_out = out.write_substream(entry_size);
+                auto entry_data = entry_out.to_input_stream();
+                writer.write(*this, entry_out, entry);
+                entry_data.with_stream([&] (auto data_str) {
+                    crc.process_fragmented(ser::buffer_view<typename std::vector<temporary_buffer<char>>::iterator>(data_str));
+                });
+            }
 
             auto checksum = crc.checksum();
             write<uint32_t>(out, checksum);
@@ -1066,6 +1187,12 @@ public:
             write<uint32_t>(out, mecrc->checksum());
         }
 
+        if (actual_size < s) {
+            // compression made the entries consume less buffer space than
+            // was accounted for above; give the surplus back right away.
+            _segment_manager->notify_memory_written(s - actual_size);
+        }
+
         ++_segment_manager->totals.allocation_count;
         ++_num_allocs;
 
@@ -1086,6 +1213,12 @@ public:
         return position_type(_file_pos + buffer_position());
     }
 
+    // Version 3 segments carry a compression marker in front of every
+    // entry payload (see descriptor::segment_version_3).
+    bool compress_entries() const {
+        return _desc.ver >= descriptor::segment_version_3;
+    }
+
     size_t file_position() const {
         return _file_pos;
     }
@@ -1302,7 +1435,15 @@ db::commitlog::segment_manager::list_descriptors(sstring dirname) {
             try {
                 result.emplace_back(de.name, cfg.fname_prefix);
             } catch (std::domain_error& e) {
-                clogger.warn(e.what());
+                // Several commitlog domains can share a directory, telling
+                // their segments apart by filename prefix. A name that looks
+                // like a segment of another domain is not our problem.
+                static const std::regex segment_rx("(?:Recycled-)?[a-zA-Z]+" + descriptor::SEPARATOR + "\\d+(" + descriptor::SEPARATOR + "\\d+)?" + descriptor::FILENAME_EXTENSION);
+                if (std::regex_match(std::string(de.name), segment_rx)) {
+                    clogger.debug("Ignoring foreign commitlog segment {}", de.name);
+                } else {
+                    clogger.warn(e.what());
+                }
             }
         }
     });
@@ -1326,6 +1467,19 @@ future<> db::commitlog::segment_manager::init() {
     _timer.set_callback(std::bind(&segment_manager::on_timer, this));
     auto delay = this_shard_id() * std::ceil(double(cfg.commitlog_sync_period_in_ms) / smp::count);
     clogger.trace("Delaying timer loop {} ms", delay);
+    // Pre-warm the segment reserve. new_segment() only grows the reserve
+    // after a writer already found it empty, i.e. after a rollover stall
+    // happened, so an ingest burst on a fresh commitlog pays segment
+    // creation latency once per reserve increment. Raising the reserve
+    // target up front lets the replenisher pre-allocate (or claim recycled)
+    // segments in the background before they are needed. Bounded by the
+    // per-shard disk budget so small commitlogs are not filled with
+    // reserve files.
+    auto warm_reserve = std::min<size_t>(cfg.max_reserve_segments, disk_usage_threshold / (max_size * 4));
+    if (warm_reserve > _reserve_segments.max_size()) {
+        clogger.trace("Pre-warming segment reserve to {} segments", warm_reserve);
+        _reserve_segments.set_max_size(warm_reserve);
+    }
     // We need to wait until we have scanned all other segments to actually start serving new
     // segments. We are ready now
     _reserve_replenisher = replenish_reserve();
@@ -1395,6 +1549,19 @@ void db::commitlog::segment_manager::create_counters(const sstring& metrics_cate
 
         sm::make_gauge("memory_buffer_bytes", totals.buffer_list_bytes,
                        sm::description("Holds the total number of bytes in internal memory buffers.")),
+
+        sm::make_gauge("batch_commit_window_us", [this] { return next_batch_window().count(); },
+                       sm::description("Holds the current adaptive group-commit window in microseconds. "
+                                       "Zero means disk syncs are issued immediately. "
+                                       "Only meaningful in \"batch\" sync mode.")),
+
+        sm::make_derive("batch_commit_delayed", totals.batch_delayed_syncs,
+                       sm::description("Counts a number of disk syncs that waited an adaptive group-commit window for more writes to join the batch. "
+                                       "Divide alloc by flush to get the achieved batch size.")),
+
+        sm::make_derive("batch_commit_delay_us", totals.batch_delay_us,
+                       sm::description("Counts the total latency in microseconds added by adaptive group commit. "
+                                       "Divide this value by batch_commit_delayed to get the average added latency per delayed sync.")),
     });
 }
 
@@ -1569,7 +1736,7 @@ future<> db::commitlog::segment_manager::rename_file(sstring from, sstring to) c
 
 future<db::commitlog::segment_manager::sseg_ptr> db::commitlog::segment_manager::allocate_segment() {
     for (;;) {
-        descriptor d(next_id(), cfg.fname_prefix);
+        descriptor d(next_id(), cfg.fname_prefix, cfg.compress_entries ? descriptor::segment_version_3 : descriptor::segment_version_2);
         auto dst = filename(d);
         auto flags = open_flags::wo;
         if (cfg.use_o_dsync) {
@@ -1797,6 +1964,7 @@ future<> db::commitlog::segment_manager::shutdown() {
 
             _timer.cancel(); // no more timer calls
             _shutdown = true; // no re-arm, no create new segments.
+            _spare_buffers.clear();
 
             // do a discard + delete sweep to force 
             // gate holder (i.e. replenish) to wake up
@@ -2120,6 +2288,11 @@ uint64_t db::commitlog::segment_manager::get_num_active_segments() const {
 }
 
 temporary_buffer<char> db::commitlog::segment_manager::allocate_single_buffer(size_t s, size_t alignment) {
+    if (!_spare_buffers.empty() && alignment == _spare_buffers_alignment && s == _spare_buffers.back().size()) {
+        auto b = std::move(_spare_buffers.back());
+        _spare_buffers.pop_back();
+        return b;
+    }
     return temporary_buffer<char>::aligned(alignment, s);
 }
 
@@ -2136,6 +2309,26 @@ db::commitlog::segment_manager::buffer_type db::commitlog::segment_manager::acqu
     return fragmented_temporary_buffer(std::move(buffers), s);
 }
 
+void db::commitlog::segment_manager::release_buffer(buffer_type&& b, size_t alignment) {
+    if (_shutdown) {
+        return;
+    }
+    if (alignment != _spare_buffers_alignment) {
+        // files with different write alignments are rare (if they exist at
+        // all); not worth keeping more than one pool.
+        _spare_buffers.clear();
+        _spare_buffers_alignment = alignment;
+    }
+    for (auto& f : std::move(b).release()) {
+        if (_spare_buffers.size() >= max_spare_buffers) {
+            break;
+        }
+        if (f.size() == segment::default_size) {
+            _spare_buffers.emplace_back(std::move(f));
+        }
+    }
+}
+
 /**
  * Add mutation.
  */
@@ -2517,7 +2710,44 @@ db::commitlog::read_log_file(sstring filename, sstring pfx, seastar::io_priority
 
         using produce_func = std::function<future<>(buffer_and_replay_position, uint32_t)>;
 
+        // Strips the version 3 compression marker and uncompresses the
+        // payload when it was stored compressed.
+        static fragmented_temporary_buffer maybe_uncompress_entry(fragmented_temporary_buffer buf) {
+            auto in = buf.get_istream();
+            auto uncompressed_size = read<uint32_t>(in);
+            buf.remove_prefix(sizeof(uint32_t));
+            if (uncompressed_size == 0) {
+                // stored raw
+                return buf;
+            }
+            // linearize the compressed payload for the codec
+            temporary_buffer<char> compressed(buf.size_bytes());
+            size_t off = 0;
+            for (auto&& frag : fragmented_temporary_buffer::view(buf)) {
+                std::copy_n(reinterpret_cast<const char*>(frag.data()), frag.size(), compressed.get_write() + off);
+                off += frag.size();
+            }
+            temporary_buffer<char> data(uncompressed_size);
+            compressor::lz4->uncompress(compressed.get(), compressed.size(), data.get_write(), uncompressed_size);
+            std::vector<temporary_buffer<char>> fragments;
+            fragments.emplace_back(std::move(data));
+            return fragmented_temporary_buffer(std::move(fragments), uncompressed_size);
+        }
+
         future<> produce(buffer_and_replay_position bar) {
+            if (d.ver >= descriptor::segment_version_3) {
+                auto size = bar.buffer.size_bytes();
+                try {
+                    bar.buffer = maybe_uncompress_entry(std::move(bar.buffer));
+                } catch (...) {
+                    // the entry passed its checksum, so this is either a
+                    // corruption the crc missed or a bug. treat like any
+                    // other broken entry: note it and move on.
+                    clogger.debug("Segment entry at {} failed to uncompress. Skipping {} bytes: {}", bar.position, size, std::current_exception());
+                    corrupt_size += size;
+                    co_return;
+                }
+            }
             try {
                 co_await func(std::move(bar));
             } catch (...) {
@@ -126,6 +126,10 @@ public:
         std::optional<uint64_t> commitlog_flush_threshold_in_mb = {};
         uint64_t commitlog_segment_size_in_mb = 32;
         uint64_t commitlog_sync_period_in_ms = 10 * 1000; //TODO: verify default!
+        // In "batch" sync mode, upper bound on the latency a write can see
+        // from group commit: the adaptive batching window plus the sync
+        // itself must fit within this budget.
+        uint64_t commitlog_sync_batch_window_in_ms = 10 * 1000;
         // Max number of segments to keep in pre-alloc reserve.
         // Not (yet) configurable from scylla.conf.
         uint64_t max_reserve_segments = 12;
@@ -139,6 +143,10 @@ public:
 
         bool reuse_segments = true;
         bool use_o_dsync = false;
+        // Compress entries with LZ4 before they are written to the segment
+        // buffer (creates version 3 segments). Trades a little CPU on the
+        // write path for commitlog bandwidth.
+        bool compress_entries = false;
         bool warn_about_segments_left_on_disk_after_shutdown = true;
         bool allow_going_over_size_limit = true;
 
@@ -165,6 +173,10 @@ public:
 
         static inline constexpr uint32_t segment_version_1 = 1u;
         static inline constexpr uint32_t segment_version_2 = 2u;
+        // Like version 2, but every entry payload is prefixed with a
+        // uint32_t holding the uncompressed size of an LZ4-compressed
+        // payload, or zero if the payload is stored raw.
+        static inline constexpr uint32_t segment_version_3 = 3u;
 
         descriptor(descriptor&&) noexcept = default;
         descriptor(const descriptor&) = default;
@@ -48,9 +48,13 @@ void commitlog_entry_writer::serialize(Output& out) const {
 }
 
 void commitlog_entry_writer::compute_size() {
-    seastar::measuring_output_stream ms;
-    serialize(ms);
-    _size = ms.size();
+    auto& cached = _with_schema ? _size_with_schema : _size_without_schema;
+    if (cached == std::numeric_limits<size_t>::max()) {
+        seastar::measuring_output_stream ms;
+        serialize(ms);
+        cached = ms.size();
+    }
+    _size = cached;
 }
 
 void commitlog_entry_writer::write(typename seastar::memory_output_stream<std::vector<temporary_buffer<char>>::iterator>& out) const {
@@ -46,6 +46,13 @@ private:
     const frozen_mutation& _mutation;
     bool _with_schema = true;
     size_t _size = std::numeric_limits<size_t>::max();
+    // Cached size() results for the with/without schema variants. Segment
+    // allocation can flip set_with_schema() several times for one entry
+    // (e.g. when retrying on a fresh segment), and measuring an entry with
+    // schema walks the whole column mapping, so measure each variant at
+    // most once.
+    size_t _size_with_schema = std::numeric_limits<size_t>::max();
+    size_t _size_without_schema = std::numeric_limits<size_t>::max();
     force_sync _sync;
 private:
     template<typename Output>
@@ -47,6 +47,9 @@
 
 #include <seastar/core/future.hh>
 #include <seastar/core/sharded.hh>
+#include <seastar/core/gate.hh>
+#include <seastar/core/semaphore.hh>
+#include <seastar/core/loop.hh>
 
 #include "commitlog.hh"
 #include "commitlog_replayer.hh"
@@ -113,7 +116,34 @@ public:
         return _column_mappings.stop();
     }
 
-    future<> process(stats*, commitlog::buffer_and_replay_position buf_rp) const;
+    // How many segments a shard replays concurrently, how many decoded
+    // mutations are grouped into one cross-shard application call, and how
+    // many such batches may be in flight per segment. Waiting for a batch
+    // slot applies back-pressure to the segment reader.
+    static constexpr unsigned segment_replay_concurrency = 2;
+    static constexpr size_t apply_batch_size = 32;
+    static constexpr size_t max_inflight_batches = 8;
+
+    // A decoded entry waiting to be shipped to its owning shard.
+    struct pending_entry {
+        commitlog_entry_reader cer;
+        replay_position rp;
+        const column_mapping* cm;
+    };
+
+    // Per-segment replay pipeline state: entries are decoded as the segment
+    // is read and collected into per-shard batches, which are applied in the
+    // background while reading continues.
+    struct replay_state {
+        stats s;
+        seastar::gate gate;
+        semaphore units { max_inflight_batches };
+        std::unordered_map<unsigned, std::vector<pending_entry>> batches;
+    };
+
+    future<> process(lw_shared_ptr<replay_state>, commitlog::buffer_and_replay_position buf_rp) const;
+    future<> flush_batch(lw_shared_ptr<replay_state>, unsigned shard, std::vector<pending_entry>) const;
+    future<> apply_mutation(database&, pending_entry&) const;
     future<stats> recover(sstring file, const sstring& fname_prefix) const;
 
     typedef std::unordered_map<utils::UUID, replay_position> rp_map;
@@ -139,6 +169,12 @@ public:
         _rpm;
     shard_rp_map
         _min_pos;
+    // Watermark from the last clean shutdown: every data commitlog segment
+    // with a base id not greater than this was fully flushed, and can be
+    // skipped without reading. Applies to the data commitlog only - the
+    // record itself is written to the system domain during drain.
+    std::optional<segment_id_type>
+        _clean_shutdown_base_id;
 };
 
 db::commitlog_replayer::impl::impl(seastar::sharded<database>& db)
@@ -205,6 +241,13 @@ future<> db::commitlog_replayer::impl::init() {
                 rlogger.debug("replay position for shard/uuid {}/{}: {}", p1.first, p2.first, p2.second);
             }
         }
+    }).then([this] {
+        return db::system_keyspace::get_commitlog_clean_shutdown_record().then([this](std::optional<uint64_t> rec) {
+            if (rec) {
+                rlogger.debug("Clean shutdown recorded at segment id {}", *rec);
+            }
+            _clean_shutdown_base_id = rec;
+        });
     });
 }
 
@@ -213,6 +256,13 @@ db::commitlog_replayer::impl::recover(sstring file, const sstring& fname_prefix)
     assert(_column_mappings.local_is_initialized());
 
     replay_position rp{commitlog::descriptor(file, fname_prefix)};
+
+    if (_clean_shutdown_base_id && std::string_view(fname_prefix) == commitlog::descriptor::FILENAME_PREFIX
+            && rp.base_id() <= *_clean_shutdown_base_id) {
+        rlogger.debug("skipping replay of {}, fully flushed before clean shutdown at {}", file, *_clean_shutdown_base_id);
+        return make_ready_future<stats>();
+    }
+
     auto gp = min_pos(rp.shard_id());
 
     if (rp.id < gp.id) {
@@ -224,24 +274,39 @@ db::commitlog_replayer::impl::recover(sstring file, const sstring& fname_prefix)
         p = gp.pos;
     }
 
-    auto s = make_lw_shared<stats>();
+    auto state = make_lw_shared<replay_state>();
     auto& exts = _db.local().extensions();
 
     return db::commitlog::read_log_file(file, fname_prefix, service::get_local_commitlog_priority(),
-            std::bind(&impl::process, this, s.get(), std::placeholders::_1),
-            p, &exts).then_wrapped([s](future<> f) {
+            [this, state](commitlog::buffer_and_replay_position buf_rp) {
+                return process(state, std::move(buf_rp));
+            },
+            p, &exts).then_wrapped([this, state](future<> f) {
+        std::exception_ptr ep;
         try {
             f.get();
         } catch (commitlog::segment_data_corruption_error& e) {
-            s->corrupt_bytes += e.bytes();
+            state->s.corrupt_bytes += e.bytes();
         } catch (...) {
-            throw;
+            ep = std::current_exception();
         }
-        return make_ready_future<stats>(*s);
+        // Flush any partial batches, then wait for all in-flight
+        // applications, also on error - they reference our state.
+        auto batches = std::exchange(state->batches, {});
+        return parallel_for_each(batches, [this, state](std::pair<const unsigned, std::vector<pending_entry>>& p) {
+            return flush_batch(state, p.first, std::move(p.second));
+        }).then([state] {
+            return state->gate.close();
+        }).then([state, ep = std::move(ep)]() -> future<stats> {
+            if (ep) {
+                return make_exception_future<stats>(std::move(ep));
+            }
+            return make_ready_future<stats>(state->s);
+        });
     });
 }
 
-future<> db::commitlog_replayer::impl::process(stats* s, commitlog::buffer_and_replay_position buf_rp) const {
+future<> db::commitlog_replayer::impl::process(lw_shared_ptr<replay_state> state, commitlog::buffer_and_replay_position buf_rp) const {
     auto&& buf = buf_rp.buffer;
     auto&& rp = buf_rp.position;
     try {
@@ -263,7 +328,7 @@ future<> db::commitlog_replayer::impl::process(stats* s, commitlog::buffer_and_r
         auto shard_id = rp.shard_id();
         if (rp < min_pos(shard_id)) {
             rlogger.trace("entry {} is less than global min position. skipping", rp);
-            s->skipped_mutations++;
+            state->s.skipped_mutations++;
             return make_ready_future<>();
         }
 
@@ -271,60 +336,21 @@ future<> db::commitlog_replayer::impl::process(stats* s, commitlog::buffer_and_r
         auto cf_rp = cf_min_pos(uuid, shard_id);
         if (rp <= cf_rp) {
             rlogger.trace("entry {} at {} is younger than recorded replay position {}. skipping", fm.column_family_id(), rp, cf_rp);
-            s->skipped_mutations++;
+            state->s.skipped_mutations++;
             return make_ready_future<>();
         }
 
         auto shard = _db.local().shard_of(fm);
-        return _db.invoke_on(shard, [this, cer = std::move(cer), &src_cm, rp, shard, s] (database& db) mutable -> future<> {
-            auto& fm = cer.mutation();
-            // TODO: might need better verification that the deserialized mutation
-            // is schema compatible. My guess is that just applying the mutation
-            // will not do this.
-            auto& cf = db.find_column_family(fm.column_family_id());
-
-            if (rlogger.is_enabled(logging::log_level::debug)) {
-                rlogger.debug("replaying at {} v={} {}:{} at {}", fm.column_family_id(), fm.schema_version(),
-                        cf.schema()->ks_name(), cf.schema()->cf_name(), rp);
-            }
-            if (const auto err = validation::is_cql_key_invalid(*cf.schema(), fm.key()); err) {
-                throw std::runtime_error(fmt::format("found entry with invalid key {} at {} v={} {}:{} at {}: {}.", fm.key(), fm.column_family_id(),
-                        fm.schema_version(), cf.schema()->ks_name(), cf.schema()->cf_name(), rp, *err));
-            }
-            // Removed forwarding "new" RP. Instead give none/empty.
-            // This is what origin does, and it should be fine.
-            // The end result should be that once sstables are flushed out
-            // their "replay_position" attribute will be empty, which is
-            // lower than anything the new session will produce.
-            if (cf.schema()->version() != fm.schema_version()) {
-                auto& local_cm = _column_mappings.local().map;
-                auto cm_it = local_cm.try_emplace(fm.schema_version(), src_cm).first;
-                const column_mapping& cm = cm_it->second;
-                mutation m(cf.schema(), fm.decorated_key(*cf.schema()));
-                converting_mutation_partition_applier v(cm, *cf.schema(), m.partition());
-                fm.partition().accept(cm, v);
-                return do_with(std::move(m), [&db, &cf] (const mutation& m) {
-                    return db.apply_in_memory(m, cf, db::rp_handle(), db::no_timeout);
-                });
-            } else {
-                return do_with(std::move(cer).mutation(), [&](const frozen_mutation& m) {
-                    return db.apply_in_memory(m, cf.schema(), db::rp_handle(), db::no_timeout);
-                });
-            }
-        }).then_wrapped([s] (future<> f) {
-            try {
-                f.get();
-                s->applied_mutations++;
-            } catch (...) {
-                s->invalid_mutations++;
-                // TODO: write mutation to file like origin.
-                rlogger.warn("error replaying: {}", std::current_exception());
-            }
-        });
+        auto& batch = state->batches[shard];
+        batch.emplace_back(pending_entry{std::move(cer), rp, &src_cm});
+        if (batch.size() >= apply_batch_size) {
+            return flush_batch(state, shard, std::exchange(batch, {}));
+        }
+        return make_ready_future<>();
     } catch (no_such_column_family&) {
         // No such CF now? Origin just ignores this.
     } catch (...) {
-        s->invalid_mutations++;
+        state->s.invalid_mutations++;
         // TODO: write mutation to file like origin.
         rlogger.warn("error replaying: {}", std::current_exception());
     }
@@ -332,6 +358,80 @@ future<> db::commitlog_replayer::impl::process(stats* s, commitlog::buffer_and_r
     return make_ready_future<>();
 }
 
+future<> db::commitlog_replayer::impl::flush_batch(lw_shared_ptr<replay_state> state, unsigned shard, std::vector<pending_entry> batch) const {
+    // Waiting for a batch slot here stalls the segment reader once
+    // max_inflight_batches are outstanding.
+    return get_units(state->units, 1).then([this, state, shard, batch = std::move(batch)] (semaphore_units<> units) mutable {
+        gate::holder holder(state->gate);
+        auto size = batch.size();
+        // Apply in the background; reading and decoding run ahead meanwhile.
+        (void)_db.invoke_on(shard, [this, batch = std::move(batch)] (database& db) mutable {
+            return do_with(std::move(batch), std::pair<uint64_t, uint64_t>{}, [this, &db] (std::vector<pending_entry>& batch, std::pair<uint64_t, uint64_t>& counts) {
+                return do_for_each(batch, [this, &db, &counts] (pending_entry& e) {
+                    return futurize_invoke([this, &db, &e] { return apply_mutation(db, e); }).then_wrapped([&counts] (future<> f) {
+                        try {
+                            f.get();
+                            counts.first++;
+                        } catch (no_such_column_family&) {
+                            // No such CF now? Origin just ignores this.
+                        } catch (...) {
+                            counts.second++;
+                            // TODO: write mutation to file like origin.
+                            rlogger.warn("error replaying: {}", std::current_exception());
+                        }
+                    });
+                }).then([&counts] {
+                    return make_ready_future<std::pair<uint64_t, uint64_t>>(counts);
+                });
+            });
+        }).then([state] (std::pair<uint64_t, uint64_t> counts) {
+            state->s.applied_mutations += counts.first;
+            state->s.invalid_mutations += counts.second;
+        }).handle_exception([state, size] (std::exception_ptr ep) {
+            state->s.invalid_mutations += size;
+            rlogger.warn("error replaying batch: {}", ep);
+        }).finally([units = std::move(units), holder = std::move(holder)] {});
+    });
+}
+
+future<> db::commitlog_replayer::impl::apply_mutation(database& db, pending_entry& e) const {
+    auto& fm = e.cer.mutation();
+    auto rp = e.rp;
+    // TODO: might need better verification that the deserialized mutation
+    // is schema compatible. My guess is that just applying the mutation
+    // will not do this.
+    auto& cf = db.find_column_family(fm.column_family_id());
+
+    if (rlogger.is_enabled(logging::log_level::debug)) {
+        rlogger.debug("replaying at {} v={} {}:{} at {}", fm.column_family_id(), fm.schema_version(),
+                cf.schema()->ks_name(), cf.schema()->cf_name(), rp);
+    }
+    if (const auto err = validation::is_cql_key_invalid(*cf.schema(), fm.key()); err) {
+        throw std::runtime_error(fmt::format("found entry with invalid key {} at {} v={} {}:{} at {}: {}.", fm.key(), fm.column_family_id(),
+                fm.schema_version(), cf.schema()->ks_name(), cf.schema()->cf_name(), rp, *err));
+    }
+    // Removed forwarding "new" RP. Instead give none/empty.
+    // This is what origin does, and it should be fine.
+    // The end result should be that once sstables are flushed out
+    // their "replay_position" attribute will be empty, which is
+    // lower than anything the new session will produce.
+    if (cf.schema()->version() != fm.schema_version()) {
+        auto& local_cm = _column_mappings.local().map;
+        auto cm_it = local_cm.try_emplace(fm.schema_version(), *e.cm).first;
+        const column_mapping& cm = cm_it->second;
+        mutation m(cf.schema(), fm.decorated_key(*cf.schema()));
+        converting_mutation_partition_applier v(cm, *cf.schema(), m.partition());
+        fm.partition().accept(cm, v);
+        return do_with(std::move(m), [&db, &cf] (const mutation& m) {
+            return db.apply_in_memory(m, cf, db::rp_handle(), db::no_timeout);
+        });
+    } else {
+        return do_with(std::move(e.cer).mutation(), [&](const frozen_mutation& m) {
+            return db.apply_in_memory(m, cf.schema(), db::rp_handle(), db::no_timeout);
+        });
+    }
+}
+
 db::commitlog_replayer::commitlog_replayer(seastar::sharded<database>& db)
     : _impl(std::make_unique<impl>(db))
 {}
@@ -370,24 +470,25 @@ future<> db::commitlog_replayer::recover(std::vector<sstring> files, sstring fna
             return map_reduce(smp::all_cpus(), [this, map, &fname_prefix] (unsigned id) {
                 return smp::submit_to(id, [this, id, map, &fname_prefix] () {
                     auto total = ::make_lw_shared<impl::stats>();
-                    // TODO: or something. For now, we do this serialized per shard,
-                    // to reduce mutation congestion. We could probably (says avi)
-                    // do 2 segments in parallel or something, but lets use this first.
+                    // Replay a couple of segments in parallel. Mutation application is
+                    // commutative (timestamps decide), so ordering across segments does
+                    // not matter, and the overlap hides the read latency of the next
+                    // segment behind application of the current one.
                     auto range = map->equal_range(id);
-                    return do_for_each(range.first, range.second, [this, total, &fname_prefix] (const std::pair<unsigned, sstring>& p) {
+                    return max_concurrent_for_each(range.first, range.second, impl::segment_replay_concurrency, [this, total, &fname_prefix] (const std::pair<unsigned, sstring>& p) {
                         auto&f = p.second;
                         rlogger.debug("Replaying {}", f);
                         return _impl->recover(f, fname_prefix).then([f, total](impl::stats stats) {
                             if (stats.corrupt_bytes != 0) {
                                 rlogger.warn("Corrupted file: {}. {} bytes skipped.", f, stats.corrupt_bytes);
                             }
-                            rlogger.debug("Log replay of {} complete, {} replayed mutations ({} invalid, {} skipped)"
+                            *total += stats;
+                            rlogger.info("Log replay of {} complete, {} replayed mutations so far ({} invalid, {} skipped)"
                                             , f
-                                            , stats.applied_mutations
-                                            , stats.invalid_mutations
-                                            , stats.skipped_mutations
+                                            , total->applied_mutations
+                                            , total->invalid_mutations
+                                            , total->skipped_mutations
                             );
-                            *total += stats;
                         });
                     }).then([total] {
                         return make_ready_future<impl::stats>(*total);
@@ -373,6 +373,9 @@ db::config::config(std::shared_ptr<db::extensions> exts)
         "Log a warning when writing cells larger than this value")
     , compaction_rows_count_warning_threshold(this, "compaction_rows_count_warning_threshold", value_status::Used, 100000,
         "Log a warning when writing a number of rows larger than this value")
+    , large_partition_write_warning_threshold_mb(this, "large_partition_write_warning_threshold_mb", value_status::Used, 0,
+        "Log a warning as soon as the write path has accumulated more than this many megabytes for a single partition, instead of waiting"
+        " for the partition to reach a flush or compaction. Detection is approximate (per shard, since startup). Set to 0 (the default) to disable.")
     /* Common memtable settings */
     , memtable_total_space_in_mb(this, "memtable_total_space_in_mb", value_status::Invalid, 0,
         "Specifies the total memory used for all memtables on a node. This replaces the per-table storage settings memtable_operations_in_millions and memtable_throughput_in_mb.")
@@ -420,6 +423,8 @@ db::config::config(std::shared_ptr<db::extensions> exts)
         "Whether or not to re-use commitlog segments when finished instead of deleting them. Can improve commitlog latency on some file systems.\n")
     , commitlog_use_o_dsync(this, "commitlog_use_o_dsync", value_status::Used, true,
         "Whether or not to use O_DSYNC mode for commitlog segments IO. Can improve commitlog latency on some file systems.\n")
+    , commitlog_compress_entries(this, "commitlog_compress_entries", value_status::Used, false,
+        "Whether or not to compress commitlog entries with LZ4 before they are written. Reduces commitlog bandwidth, which competes with memtable flush bandwidth on the same disks, at the cost of a little CPU on the write path.\n")
     , commitlog_use_hard_size_limit(this, "commitlog_use_hard_size_limit", value_status::Used, false,
         "Whether or not to use a hard size limit for commitlog disk usage. Default is false. Enabling this can cause latency spikes, whereas the default can lead to occasional disk usage peaks.\n")
     /* Compaction settings */
@@ -435,6 +440,7 @@ db::config::config(std::shared_ptr<db::extensions> exts)
     , sstable_preemptive_open_interval_in_mb(this, "sstable_preemptive_open_interval_in_mb", value_status::Unused, 50,
         "When compacting, the replacement opens SSTables before they are completely written and uses in place of the prior SSTables for any range previously written. This setting helps to smoothly transfer reads between the SSTables by reducing page cache churn and keeps hot rows hot.")
     , defragment_memory_on_idle(this, "defragment_memory_on_idle", value_status::Used, false, "When set to true, will defragment memory when the cpu is idle.  This reduces the amount of work Scylla performs when processing client requests.")
+    , defragment_memory_target_occupancy(this, "defragment_memory_target_occupancy", value_status::Used, 1.0, "Occupancy fraction at which idle-time defragmentation considers a memory region compacted enough and leaves it alone. Lower values make idle defragmentation cheaper but less thorough; 1.0 compacts regions as long as forward progress is possible. Only relevant when defragment_memory_on_idle is true.")
     /* Memtable settings */
     , memtable_allocation_type(this, "memtable_allocation_type", value_status::Invalid, "heap_buffers",
         "Specify the way Cassandra allocates and manages memtable memory. See Off-heap memtables in Cassandra 2.1. Options are:\n"
@@ -517,8 +523,18 @@ db::config::config(std::shared_ptr<db::extensions> exts)
     , key_cache_size_in_mb(this, "key_cache_size_in_mb", value_status::Unused, 100,
         "A global cache setting for tables. It is the maximum size of the key cache in memory. To disable set to 0.\n"
         "Related information: nodetool setcachecapacity.")
-    , row_cache_keys_to_save(this, "row_cache_keys_to_save", value_status::Unused, 0,
-        "Number of keys from the row cache to save.")
+    , row_cache_keys_to_save(this, "row_cache_keys_to_save", value_status::Used, 0,
+        "Number of keys from the row cache to save when saving the cache hot set. 0 means all.")
+    , row_cache_warmup_on_startup(this, "row_cache_warmup_on_startup", value_status::Used, false,
+        "Re-populate the row cache on startup from hot-set checkpoints saved with the save_caches REST API, before the node starts serving CQL traffic.")
+    , row_cache_admission_filter(this, "row_cache_admission_filter", value_status::Used, false,
+        "Gate admission of partitions into the row cache with a TinyLFU-style frequency filter, so that one-off scans don't evict the frequently read set. Frequently read partitions get cached on their second miss rather than the first.")
+    , index_cache_fraction(this, "index_cache_fraction", value_status::Used, 0.2,
+        "Fraction of the cache memory which sstable index pages may occupy before they start being evicted. Below this share, data rows are evicted first and index pages stay resident.")
+    , cache_max_version_chain_depth(this, "cache_max_version_chain_depth", value_status::Used, 8,
+        "Reads of a cached partition whose version chain is deeper than this hand the chain over for background flattening, so hot partitions converge to single-version reads. 0 disables proactive flattening.")
+    , cache_update_concurrency(this, "cache_update_concurrency", value_status::Used, 1,
+        "Number of fibers used to merge a flushed memtable into the row cache, each owning a disjoint token sub-range. 1 keeps the update serial. Rounded down to a power of two, capped at 8.")
     , row_cache_size_in_mb(this, "row_cache_size_in_mb", value_status::Unused, 0,
         "Maximum size of the row cache in memory. Row cache can save more time than key_cache_size_in_mb, but is space-intensive because it contains the entire row. Use the row cache only for hot rows or static rows. If you reduce the size, you may not get you hottest keys loaded on start up.")
     , row_cache_save_period(this, "row_cache_save_period", value_status::Unused, 0,
@@ -583,8 +599,12 @@ db::config::config(std::shared_ptr<db::extensions> exts)
         "\tall: All traffic is compressed.\n"
         "\tdc : Traffic between data centers is compressed.\n"
         "\tnone : No compression.")
+    , internode_compression_zstd_dictionary(this, "internode_compression_zstd_dictionary", value_status::Used, false,
+        "When internode_compression applies to a streaming or repair connection, train a zstd dictionary on the first megabytes of the session and compress the rest of it with the dictionary instead of LZ4. Falls back to LZ4 when the peer does not support it.")
     , inter_dc_tcp_nodelay(this, "inter_dc_tcp_nodelay", value_status::Used, false,
         "Enable or disable tcp_nodelay for inter-data center communication. When disabled larger, but fewer, network packets are sent. This reduces overhead from the TCP protocol itself. However, if cross data-center responses are blocked, it will increase latency.")
+    , write_coalescing_window_in_us(this, "write_coalescing_window_in_us", value_status::Used, 0,
+        "Delay, in microseconds, for which the coordinator holds small writes bound for the same replica so they can be sent as one inter-node message with per-write acknowledgements. Trades up to this much extra write latency for fewer, larger messages. Set to 0 (the default) to disable write coalescing. Takes effect only once the whole cluster supports the COALESCED_MUTATIONS feature.")
     , streaming_socket_timeout_in_ms(this, "streaming_socket_timeout_in_ms", value_status::Unused, 0,
         "Enable or disable socket timeout for streaming operations. When a timeout occurs during streaming, streaming is retried from the start of the current file. Avoid setting this value too low, as it can result in a significant amount of data re-streaming.")
     /* Native transport (CQL Binary Protocol) */
@@ -609,6 +629,9 @@ db::config::config(std::shared_ptr<db::extensions> exts)
         "Idle threads are stopped after 30 seconds.\n")
     , native_transport_max_frame_size_in_mb(this, "native_transport_max_frame_size_in_mb", value_status::Unused, 256,
         "The maximum size of allowed frame. Frame (requests) larger than this are rejected as invalid.")
+    , native_transport_min_compression_size(this, "native_transport_min_compression_size", value_status::Used, 64,
+        "The minimum response frame size (in bytes) that is compressed when the client negotiated compression. "
+        "Smaller frames are sent uncompressed, as the compression overhead exceeds the network savings for them.")
     /* RPC (remote procedure call) settings */
     /* Settings for configuring and tuning client connections. */
     , broadcast_rpc_address(this, "broadcast_rpc_address", value_status::Used, {/* unset */},
@@ -649,8 +672,8 @@ db::config::config(std::shared_ptr<db::extensions> exts)
         "Related information: About hinted handoff writes")
     , max_hinted_handoff_concurrency(this, "max_hinted_handoff_concurrency", liveness::LiveUpdate, value_status::Used, 0,
         "Maximum concurrency allowed for sending hints. The concurrency is divided across shards and rounded up if not divisible by the number of shards. By default (or when set to 0), concurrency of 8*shard_count will be used.")
-    , hinted_handoff_throttle_in_kb(this, "hinted_handoff_throttle_in_kb", value_status::Unused, 1024,
-        "Maximum throttle per delivery thread in kilobytes per second. This rate reduces proportionally to the number of nodes in the cluster. For example, if there are two nodes in the cluster, each delivery thread will use the maximum rate. If there are three, each node will throttle to half of the maximum, since the two nodes are expected to deliver hints simultaneously.")
+    , hinted_handoff_throttle_in_kb(this, "hinted_handoff_throttle_in_kb", value_status::Used, 1024,
+        "Maximum hint replay rate in kilobytes per second, per node; the rate is divided evenly across shards. Set to 0 to disable pacing.")
     , max_hint_window_in_ms(this, "max_hint_window_in_ms", value_status::Used, 10800000,
         "Maximum amount of time that hints are generates hints for an unresponsive node. After this interval, new hints are no longer generated until the node is back up and responsive. If the node goes down again, a new interval begins. This setting can prevent a sudden demand for resources when a node is brought back online and the rest of the cluster attempts to replay a large volume of hinted writes.\n"
         "Related information: Failure detection and recovery")
@@ -773,6 +796,7 @@ db::config::config(std::shared_ptr<db::extensions> exts)
     , override_decommission(this, "override_decommission", value_status::Used, false, "Set true to force a decommissioned node to join the cluster")
     , enable_repair_based_node_ops(this, "enable_repair_based_node_ops", liveness::LiveUpdate, value_status::Used, true, "Set true to use enable repair based node operations instead of streaming based")
     , allowed_repair_based_node_ops(this, "allowed_repair_based_node_ops", liveness::LiveUpdate, value_status::Used, "replace", "A comma separated list of node operations which are allowed to enable repair based node operations. The operations can be bootstrap, replace, removenode, decommission and rebuild")
+    , enable_file_based_streaming(this, "enable_file_based_streaming", liveness::LiveUpdate, value_status::Used, false, "Set true to transfer whole sstable files during bootstrap, rebuild and replace streaming when the whole cluster supports it, instead of reading and re-writing the data as mutations on both sides. Tables with materialized views or CDC, and clusters with heterogeneous shard configurations, always use mutation based streaming")
     , ring_delay_ms(this, "ring_delay_ms", value_status::Used, 30 * 1000, "Time a node waits to hear from other nodes before joining the ring in milliseconds. Same as -Dcassandra.ring_delay_ms in cassandra.")
     , shadow_round_ms(this, "shadow_round_ms", value_status::Used, 300 * 1000, "The maximum gossip shadow round time. Can be used to reduce the gossip feature check time during node boot up.")
     , fd_max_interval_ms(this, "fd_max_interval_ms", value_status::Used, 2 * 1000, "The maximum failure_detector interval time in milliseconds. Interval larger than the maximum will be ignored. Larger cluster may need to increase the default.")
@@ -795,8 +819,20 @@ db::config::config(std::shared_ptr<db::extensions> exts)
     , large_memory_allocation_warning_threshold(this, "large_memory_allocation_warning_threshold", value_status::Used, size_t(1) << 20, "Warn about memory allocations above this size; set to zero to disable")
     , enable_deprecated_partitioners(this, "enable_deprecated_partitioners", value_status::Used, false, "Enable the byteordered and random partitioners. These partitioners are deprecated and will be removed in a future version.")
     , enable_keyspace_column_family_metrics(this, "enable_keyspace_column_family_metrics", value_status::Used, false, "Enable per keyspace and per column family metrics reporting")
+    , table_latency_metrics_limit(this, "table_latency_metrics_limit", value_status::Used, 0, "Export replica-side read and write latency histograms for up to this many user tables per shard, even when enable_keyspace_column_family_metrics is disabled."
+        " Slots are taken in table creation order and freed when a table is dropped, keeping metric cardinality bounded on nodes with many tables. Set to 0 (the default) to disable.")
+    , write_trace_sample_rate(this, "write_trace_sample_rate", value_status::Used, 0, "Record per-stage nanosecond timings (parse, route, replica send, commitlog sync, memtable apply, ack) for one in every N writes and aggregate them into per-stage latency histograms."
+        " Much cheaper than full tracing and safe to keep enabled. Set to 0 (the default) to disable.")
+    , continuous_toppartitions_sample_frequency(this, "continuous_toppartitions_sample_frequency", value_status::Used, 0, "Keep an always-on, sampled toppartitions sketch on every shard and publish the hit count of the hottest partition as metrics."
+        " Every Nth partition read and write is recorded, so larger values mean lower overhead and lower accuracy. Set to 0 (the default) to disable.")
+    , hot_partition_read_mirroring_threshold(this, "hot_partition_read_mirroring_threshold", value_status::Used, 0,
+        "Number of reads of the same partition a shard has to forward to another local shard within one second before it starts mirroring"
+        " that partition's read results, serving further identical reads from a write-version-validated local snapshot."
+        " Restores intra-node scaling for read-hot partitions. Set to 0 (the default) to disable.")
     , enable_sstable_data_integrity_check(this, "enable_sstable_data_integrity_check", value_status::Used, false, "Enable interposer which checks for integrity of every sstable write."
         " Performance is affected to some extent as a result. Useful to help debugging problems that may arise at another layers.")
+    , enable_sstable_blocked_bloom_filter(this, "enable_sstable_blocked_bloom_filter", value_status::Used, false, "Write sstable bloom filters with a cache-line blocked layout, making a filter lookup cost a single cache miss instead of one per hash."
+        " Sstables written with it cannot be read by nodes running versions without this feature (including Cassandra), so only enable it once the whole cluster has been upgraded and no downgrade is planned.")
     , enable_sstable_key_validation(this, "enable_sstable_key_validation", value_status::Used, ENABLE_SSTABLE_KEY_VALIDATION, "Enable validation of partition and clustering keys monotonicity"
         " Performance is affected to some extent as a result. Useful to help debugging problems that may arise at another layers.")
     , cpu_scheduler(this, "cpu_scheduler", value_status::Used, true, "Enable cpu scheduling")
@@ -820,8 +856,13 @@ db::config::config(std::shared_ptr<db::extensions> exts)
     , max_memory_for_unlimited_query_hard_limit(this, "max_memory_for_unlimited_query_hard_limit", "max_memory_for_unlimited_query", liveness::LiveUpdate, value_status::Used, (uint64_t(100) << 20),
             "Maximum amount of memory a query, whose memory consumption is not naturally limited, is allowed to consume, e.g. non-paged and reverse queries. "
             "This is the hard limit, queries violating this limit will be aborted.")
-    , initial_sstable_loading_concurrency(this, "initial_sstable_loading_concurrency", value_status::Used, 4u,
-            "Maximum amount of sstables to load in parallel during initialization. A higher number can lead to more memory consumption. You should not need to touch this")
+    , initial_sstable_loading_concurrency(this, "initial_sstable_loading_concurrency", value_status::Used, 16u,
+            "Maximum amount of sstables to load in parallel during initialization, per shard. Opening an sstable is a sequence of small component reads, so"
+            " a reasonably high concurrency is needed to keep the disk busy; a higher number can lead to more memory consumption. You should not need to touch this")
+    , validate_sstables_after_boot(this, "validate_sstables_after_boot", value_status::Used, false,
+            "After the node starts serving, validate all sstables in the background, like nodetool scrub in validate mode does, and quarantine sstables found"
+            " corrupt. This catches on-disk corruption soon after a restart without delaying the restart-to-serving time. Startup only ever reads sstable"
+            " metadata, so this option does not make booting any faster - it only adds a check which would otherwise not run at all")
     , enable_3_1_0_compatibility_mode(this, "enable_3_1_0_compatibility_mode", value_status::Used, false,
         "Set to true if the cluster was initially installed from 3.1.0. If it was upgraded from an earlier version,"
         " or installed from a later version, leave this set to false. This adjusts the communication protocol to"
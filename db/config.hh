@@ -168,6 +168,7 @@ public:
     named_value<uint32_t> compaction_large_row_warning_threshold_mb;
     named_value<uint32_t> compaction_large_cell_warning_threshold_mb;
     named_value<uint32_t> compaction_rows_count_warning_threshold;
+    named_value<uint32_t> large_partition_write_warning_threshold_mb;
     named_value<uint32_t> memtable_total_space_in_mb;
     named_value<uint32_t> concurrent_reads;
     named_value<uint32_t> concurrent_writes;
@@ -183,6 +184,7 @@ public:
     named_value<int64_t> commitlog_total_space_in_mb;
     named_value<bool> commitlog_reuse_segments;
     named_value<bool> commitlog_use_o_dsync;
+    named_value<bool> commitlog_compress_entries;
     named_value<bool> commitlog_use_hard_size_limit;
     named_value<bool> compaction_preheat_key_cache;
     named_value<uint32_t> concurrent_compactors;
@@ -190,6 +192,7 @@ public:
     named_value<bool> preheat_kernel_page_cache;
     named_value<uint32_t> sstable_preemptive_open_interval_in_mb;
     named_value<bool> defragment_memory_on_idle;
+    named_value<double> defragment_memory_target_occupancy;
     named_value<sstring> memtable_allocation_type;
     named_value<double> memtable_cleanup_threshold;
     named_value<uint32_t> file_cache_size_in_mb;
@@ -220,6 +223,11 @@ public:
     named_value<uint32_t> key_cache_save_period;
     named_value<uint32_t> key_cache_size_in_mb;
     named_value<uint32_t> row_cache_keys_to_save;
+    named_value<bool> row_cache_warmup_on_startup;
+    named_value<bool> row_cache_admission_filter;
+    named_value<double> index_cache_fraction;
+    named_value<uint32_t> cache_max_version_chain_depth;
+    named_value<uint32_t> cache_update_concurrency;
     named_value<uint32_t> row_cache_size_in_mb;
     named_value<uint32_t> row_cache_save_period;
     named_value<sstring> memory_allocator;
@@ -239,7 +247,9 @@ public:
     named_value<uint32_t> internode_send_buff_size_in_bytes;
     named_value<uint32_t> internode_recv_buff_size_in_bytes;
     named_value<sstring> internode_compression;
+    named_value<bool> internode_compression_zstd_dictionary;
     named_value<bool> inter_dc_tcp_nodelay;
+    named_value<uint32_t> write_coalescing_window_in_us;
     named_value<uint32_t> streaming_socket_timeout_in_ms;
     named_value<bool> start_native_transport;
     named_value<uint16_t> native_transport_port;
@@ -248,6 +258,7 @@ public:
     named_value<uint16_t> native_shard_aware_transport_port_ssl;
     named_value<uint32_t> native_transport_max_threads;
     named_value<uint32_t> native_transport_max_frame_size_in_mb;
+    named_value<uint32_t> native_transport_min_compression_size;
     named_value<sstring> broadcast_rpc_address;
     named_value<uint16_t> rpc_port;
     named_value<bool> start_rpc;
@@ -300,6 +311,7 @@ public:
     named_value<bool> override_decommission;
     named_value<bool> enable_repair_based_node_ops;
     named_value<sstring> allowed_repair_based_node_ops;
+    named_value<bool> enable_file_based_streaming;
     named_value<uint32_t> ring_delay_ms;
     named_value<uint32_t> shadow_round_ms;
     named_value<uint32_t> fd_max_interval_ms;
@@ -321,7 +333,12 @@ public:
     named_value<size_t> large_memory_allocation_warning_threshold;
     named_value<bool> enable_deprecated_partitioners;
     named_value<bool> enable_keyspace_column_family_metrics;
+    named_value<uint32_t> table_latency_metrics_limit;
+    named_value<uint32_t> write_trace_sample_rate;
+    named_value<uint32_t> continuous_toppartitions_sample_frequency;
+    named_value<uint32_t> hot_partition_read_mirroring_threshold;
     named_value<bool> enable_sstable_data_integrity_check;
+    named_value<bool> enable_sstable_blocked_bloom_filter;
     named_value<bool> enable_sstable_key_validation;
     named_value<bool> cpu_scheduler;
     named_value<bool> view_building;
@@ -336,6 +353,7 @@ public:
     named_value<uint64_t> max_memory_for_unlimited_query_soft_limit;
     named_value<uint64_t> max_memory_for_unlimited_query_hard_limit;
     named_value<unsigned> initial_sstable_loading_concurrency;
+    named_value<bool> validate_sstables_after_boot;
     named_value<bool> enable_3_1_0_compatibility_mode;
     named_value<bool> enable_user_defined_functions;
     named_value<unsigned> user_defined_function_time_limit_ms;
@@ -23,6 +23,9 @@
 #include "database.hh"
 #include "db_clock.hh"
 
+#include <seastar/core/metrics.hh>
+
+#include <algorithm>
 #include <tuple>
 
 extern logging::logger dblog;
@@ -64,7 +67,8 @@ toppartitions_item_key::operator sstring() const {
 }
 
 toppartitions_data_listener::toppartitions_data_listener(database& db, std::unordered_set<std::tuple<sstring, sstring>, utils::tuple_hash> table_filters,
-        std::unordered_set<sstring> keyspace_filters) : _db(db), _table_filters(std::move(table_filters)), _keyspace_filters(std::move(keyspace_filters)) {
+        std::unordered_set<sstring> keyspace_filters, unsigned sample_frequency)
+        : _db(db), _table_filters(std::move(table_filters)), _keyspace_filters(std::move(keyspace_filters)), _sample_frequency(sample_frequency) {
     dblog.debug("toppartitions_data_listener: installing {}", fmt::ptr(this));
     _db.data_listeners().install(this);
 }
@@ -87,8 +91,9 @@ flat_mutation_reader toppartitions_data_listener::on_read(const schema_ptr& s, c
         dblog.trace("toppartitions_data_listener::on_read: {}.{}", s->ks_name(), s->cf_name());
         return make_filtering_reader(std::move(rd), [zis = this->weak_from_this(), &range, &slice, s = std::move(s)] (const dht::decorated_key& dk) {
             // The data query may be executing after the toppartitions_data_listener object has been removed, so check
-            if (zis) {
+            if (zis && zis->should_sample()) {
                 zis->_top_k_read.append(toppartitions_item_key{s, dk});
+                zis->_subrange_reads[subrange_of(dk.token())]++;
             }
             return true;
         });
@@ -98,11 +103,17 @@ flat_mutation_reader toppartitions_data_listener::on_read(const schema_ptr& s, c
 }
 
 void toppartitions_data_listener::on_write(const schema_ptr& s, const frozen_mutation& m) {
+    if (!should_sample()) {
+        return;
+    }
+
     bool include_all = _table_filters.empty() && _keyspace_filters.empty();
-    
+
     if (include_all || _keyspace_filters.contains(s->ks_name()) || _table_filters.contains({s->ks_name(), s->cf_name()})) {
         dblog.trace("toppartitions_data_listener::on_write: {}.{}", s->ks_name(), s->cf_name());
-        _top_k_write.append(toppartitions_item_key{s, m.decorated_key(*s)});
+        auto dk = m.decorated_key(*s);
+        _subrange_writes[subrange_of(dk.token())]++;
+        _top_k_write.append(toppartitions_item_key{s, dk});
     }
 }
 
@@ -126,6 +137,142 @@ toppartitions_data_listener::localize(const global_top_k::results& r) {
     return n;
 }
 
+toppartitions_monitor::toppartitions_monitor(database& db, unsigned sample_frequency)
+        : _listener(db, {}, {}, sample_frequency)
+        , _sample_frequency(sample_frequency)
+        , _timer([this] { harvest(); }) {
+    namespace sm = seastar::metrics;
+    _metrics.add_group("database", {
+        sm::make_gauge("top_partition_read_hits", [this] { return _top_read_hits; },
+            sm::description("Estimated number of reads which hit the hottest partition of this shard during the last harvest window of the"
+                            " continuous toppartitions monitor. Use a toppartitions query to learn the identity of the partition.")),
+        sm::make_gauge("top_partition_write_hits", [this] { return _top_write_hits; },
+            sm::description("Estimated number of writes which hit the hottest partition of this shard during the last harvest window of the"
+                            " continuous toppartitions monitor. Use a toppartitions query to learn the identity of the partition.")),
+        sm::make_gauge("top_subrange_read_hits", [this] { return _top_subrange_reads; },
+            sm::description("Estimated number of reads which hit the hottest token sub-range of this shard during the last harvest window"
+                            " of the continuous toppartitions monitor.")),
+        sm::make_gauge("top_subrange_write_hits", [this] { return _top_subrange_writes; },
+            sm::description("Estimated number of writes which hit the hottest token sub-range of this shard during the last harvest window"
+                            " of the continuous toppartitions monitor.")),
+    });
+    _timer.arm_periodic(harvest_period);
+}
+
+void toppartitions_monitor::harvest() {
+    auto top_count = [this] (toppartitions_data_listener::top_k& sketch) -> uint64_t {
+        uint64_t hits = 0;
+        if (sketch.valid()) {
+            auto res = sketch.top(1);
+            if (!res.empty()) {
+                // Scale the sampled count back to an estimate of the actual number of operations.
+                hits = uint64_t(res[0].count) * _sample_frequency;
+            }
+        }
+        sketch.reset();
+        return hits;
+    };
+    _top_read_hits = top_count(_listener._top_k_read);
+    _top_write_hits = top_count(_listener._top_k_write);
+    _top_subrange_reads = 0;
+    _top_subrange_writes = 0;
+    for (size_t i = 0; i < toppartitions_data_listener::subrange_count; ++i) {
+        // Scale the sampled counts back to estimates of the actual number of operations.
+        _subrange_reads[i] = std::exchange(_listener._subrange_reads[i], 0) * _sample_frequency;
+        _subrange_writes[i] = std::exchange(_listener._subrange_writes[i], 0) * _sample_frequency;
+        _top_subrange_reads = std::max(_top_subrange_reads, _subrange_reads[i]);
+        _top_subrange_writes = std::max(_top_subrange_writes, _subrange_writes[i]);
+    }
+    if (_top_read_hits || _top_write_hits) {
+        dblog.debug("toppartitions_monitor: ~{} reads and ~{} writes to the hottest partition in the last {}s",
+                _top_read_hits, _top_write_hits, harvest_period.count());
+        for (const auto& sr : hottest_subranges(3)) {
+            dblog.debug("toppartitions_monitor: sub-range {}: ~{} reads, ~{} writes", sr.range, sr.reads, sr.writes);
+        }
+    }
+}
+
+std::vector<toppartitions_monitor::subrange_load> toppartitions_monitor::hottest_subranges(size_t n) const {
+    std::vector<size_t> idx;
+    for (size_t i = 0; i < toppartitions_data_listener::subrange_count; ++i) {
+        if (_subrange_reads[i] || _subrange_writes[i]) {
+            idx.push_back(i);
+        }
+    }
+    n = std::min(n, idx.size());
+    std::partial_sort(idx.begin(), idx.begin() + n, idx.end(), [this] (size_t a, size_t b) {
+        return _subrange_reads[a] + _subrange_writes[a] > _subrange_reads[b] + _subrange_writes[b];
+    });
+    idx.resize(n);
+    std::vector<subrange_load> res;
+    res.reserve(n);
+    for (auto i : idx) {
+        // Sub-range i covers the raw tokens whose top subrange_count_bits bits
+        // (with the sign bit flipped) equal i. The unsigned arithmetic wraps
+        // such that the last bucket's upper bound lands on the maximum token.
+        constexpr auto shift = 64 - toppartitions_data_listener::subrange_count_bits;
+        auto lo = dht::token::from_int64(int64_t((uint64_t(i) << shift) - (uint64_t(1) << 63)));
+        auto hi = dht::token::from_int64(int64_t(((uint64_t(i) + 1) << shift) - (uint64_t(1) << 63) - 1));
+        res.push_back(subrange_load{dht::token_range(dht::token_range::bound(lo, true), dht::token_range::bound(hi, true)),
+                _subrange_reads[i], _subrange_writes[i]});
+    }
+    return res;
+}
+
+void large_write_monitor::listener::on_write(const schema_ptr& s, const frozen_mutation& m) {
+    _monitor._accumulated.append(toppartitions_item_key{s, m.decorated_key(*s)}, m.representation().size());
+}
+
+large_write_monitor::large_write_monitor(database& db, uint64_t threshold_bytes)
+        : _db(db)
+        , _threshold_bytes(threshold_bytes)
+        , _listener(*this)
+        , _timer([this] { scan(); }) {
+    _db.data_listeners().install(&_listener);
+    namespace sm = seastar::metrics;
+    _metrics.add_group("database", {
+        sm::make_counter("large_partition_writes_detected", [this] { return _partitions_reported; },
+            sm::description("Number of partitions whose accumulated write volume crossed large_partition_write_warning_threshold_mb"
+                            " on this shard. The partitions are named in the log.")),
+    });
+    _timer.arm_periodic(scan_period);
+}
+
+large_write_monitor::~large_write_monitor() {
+    _db.data_listeners().uninstall(&_listener);
+}
+
+void large_write_monitor::scan() {
+    if (!_accumulated.valid()) {
+        _accumulated.reset();
+        return;
+    }
+    bool wrap_risk = false;
+    for (const auto& e : _accumulated.top(8)) {
+        // The sketch counters are 32 bit; start a fresh window before a
+        // long-lived entry can wrap. _reported keeps the warnings deduped
+        // across windows.
+        wrap_risk |= e.count > (unsigned(1) << 31);
+        if (e.count < _threshold_bytes) {
+            continue;
+        }
+        auto name = format("{}.{}:{}", e.item.schema->ks_name(), e.item.schema->cf_name(), sstring(e.item));
+        if (_reported.contains(name)) {
+            continue;
+        }
+        if (_reported.size() >= 1000) {
+            _reported.clear();
+        }
+        _reported.insert(name);
+        ++_partitions_reported;
+        dblog.warn("Writing large partition {}.{}: {} bytes accumulated on the write path (threshold {} bytes), key {}",
+                e.item.schema->ks_name(), e.item.schema->cf_name(), e.count, _threshold_bytes, sstring(e.item));
+    }
+    if (wrap_risk) {
+        _accumulated.reset();
+    }
+}
+
 toppartitions_query::toppartitions_query(distributed<database>& xdb, std::unordered_set<std::tuple<sstring, sstring>, utils::tuple_hash>&& table_filters,
         std::unordered_set<sstring>&& keyspace_filters, std::chrono::milliseconds duration, size_t list_size, size_t capacity)
         : _xdb(xdb), _table_filters(std::move(table_filters)), _keyspace_filters(std::move(keyspace_filters)), _duration(duration), _list_size(list_size), _capacity(capacity),
@@ -25,6 +25,8 @@
 #include <seastar/core/future.hh>
 #include <seastar/core/distributed.hh>
 #include <seastar/core/weak_ptr.hh>
+#include <seastar/core/timer.hh>
+#include <seastar/core/metrics_registration.hh>
 
 #include "utils/hash.hh"
 #include "schema_fwd.hh"
@@ -33,6 +35,7 @@
 #include "utils/top_k.hh"
 #include "schema_registry.hh"
 
+#include <array>
 #include <vector>
 #include <set>
 
@@ -125,23 +128,55 @@ struct toppartitions_global_item_key {
 
 class toppartitions_data_listener : public data_listener, public weakly_referencable<toppartitions_data_listener> {
     friend class toppartitions_query;
+    friend class toppartitions_monitor;
 
     database& _db;
     std::unordered_set<std::tuple<sstring, sstring>, utils::tuple_hash> _table_filters;
     std::unordered_set<sstring> _keyspace_filters;
+    unsigned _sample_frequency;
+    unsigned _sample_countdown = 1;
 
 public:
     using top_k = utils::space_saving_top_k<toppartitions_item_key, toppartitions_item_key::hash, toppartitions_item_key::comp>;
     using global_top_k = utils::space_saving_top_k<toppartitions_global_item_key, toppartitions_global_item_key::hash, toppartitions_global_item_key::comp>;
+
+    // The token ring is divided into this many equally sized sub-ranges for
+    // per-sub-range load accounting. 2^8 buckets keep the counters small
+    // enough to sit in the listener while still being fine-grained enough to
+    // locate a hot slice of a shard's range.
+    static constexpr unsigned subrange_count_bits = 8;
+    static constexpr size_t subrange_count = size_t(1) << subrange_count_bits;
+
+    static unsigned subrange_of(const dht::token& t) noexcept {
+        return (uint64_t(t.raw()) + (uint64_t(1) << 63)) >> (64 - subrange_count_bits);
+    }
 public:
     static global_top_k::results globalize(top_k::results&& r);
     static top_k::results localize(const global_top_k::results& r);
 private:
     top_k _top_k_read;
     top_k _top_k_write;
+    // Sampled hit counters per token sub-range, maintained alongside the
+    // sketches. Unlike the sketches these see the whole load distribution,
+    // not just the heaviest keys, so they can drive sub-range level decisions
+    // (e.g. which slice of a shard's range is worth splitting off).
+    std::array<uint64_t, subrange_count> _subrange_reads{};
+    std::array<uint64_t, subrange_count> _subrange_writes{};
+
+private:
+    // Counter-based sampling gate: records only every Nth partition touch.
+    // With the default frequency of 1 every touch is recorded.
+    bool should_sample() noexcept {
+        if (--_sample_countdown) {
+            return false;
+        }
+        _sample_countdown = _sample_frequency;
+        return true;
+    }
 
 public:
-    toppartitions_data_listener(database& db, std::unordered_set<std::tuple<sstring, sstring>, utils::tuple_hash> table_filters, std::unordered_set<sstring> keyspace_filters);
+    toppartitions_data_listener(database& db, std::unordered_set<std::tuple<sstring, sstring>, utils::tuple_hash> table_filters, std::unordered_set<sstring> keyspace_filters,
+            unsigned sample_frequency = 1);
     ~toppartitions_data_listener();
 
     virtual flat_mutation_reader on_read(const schema_ptr& s, const dht::partition_range& range,
@@ -152,6 +187,86 @@ public:
     future<> stop();
 };
 
+/// An always-on, low-overhead flavour of the toppartitions machinery, enabled with the
+/// continuous_toppartitions_sample_frequency config option. Each shard keeps a space-saving sketch fed by a sampled
+/// data listener (only every Nth partition touch is recorded) and periodically harvests the hit count of its hottest
+/// entry into gauges, resetting the sketch so that every harvest window starts fresh. The node-level view is obtained
+/// by aggregating the per-shard gauges in the monitoring stack, like for any other metric; once an alert fires, the
+/// identity of the hot partition can be learned with a regular toppartitions query.
+class toppartitions_monitor {
+public:
+    static constexpr std::chrono::seconds harvest_period{15};
+
+    // Estimated load on one token sub-range during the last harvest window.
+    struct subrange_load {
+        dht::token_range range;
+        uint64_t reads;
+        uint64_t writes;
+    };
+
+private:
+    toppartitions_data_listener _listener;
+    unsigned _sample_frequency;
+    uint64_t _top_read_hits = 0;
+    uint64_t _top_write_hits = 0;
+    uint64_t _top_subrange_reads = 0;
+    uint64_t _top_subrange_writes = 0;
+    // Last harvested window of the listener's per-sub-range counters, already
+    // scaled back from sampled counts to operation estimates.
+    std::array<uint64_t, toppartitions_data_listener::subrange_count> _subrange_reads{};
+    std::array<uint64_t, toppartitions_data_listener::subrange_count> _subrange_writes{};
+    seastar::timer<seastar::lowres_clock> _timer;
+    seastar::metrics::metric_groups _metrics;
+
+public:
+    toppartitions_monitor(database& db, unsigned sample_frequency);
+
+    // The n sub-ranges which saw the most operations during the last harvest
+    // window, hottest first. Sub-ranges with no recorded load are omitted.
+    std::vector<subrange_load> hottest_subranges(size_t n) const;
+
+private:
+    void harvest();
+};
+
+/// Write-path large-partition detection, enabled with the large_partition_write_warning_threshold_mb config option.
+/// The large_data_handler only notices oversized partitions when their data reaches an sstable writer, at flush or
+/// compaction time; this monitor watches the write path itself. Each shard feeds the representation size of every
+/// incoming mutation into a space-saving sketch keyed by partition, so the partitions with the largest accumulated
+/// write volume are tracked in bounded memory, and a periodic scan warns - once per partition - as soon as one of
+/// them crosses the threshold, typically well before the flush or compaction that would have reported it.
+class large_write_monitor {
+public:
+    static constexpr std::chrono::seconds scan_period{2};
+    static constexpr size_t sketch_capacity = 256;
+
+private:
+    class listener : public data_listener {
+        large_write_monitor& _monitor;
+    public:
+        explicit listener(large_write_monitor& monitor) : _monitor(monitor) {}
+        virtual void on_write(const schema_ptr& s, const frozen_mutation& m) override;
+    };
+
+    database& _db;
+    uint64_t _threshold_bytes;
+    // Weighted by bytes written rather than by touches, so top() yields the
+    // partitions with the largest accumulated write volume.
+    toppartitions_data_listener::top_k _accumulated{sketch_capacity};
+    std::unordered_set<sstring> _reported; // partitions already warned about
+    uint64_t _partitions_reported = 0;
+    listener _listener;
+    seastar::timer<seastar::lowres_clock> _timer;
+    seastar::metrics::metric_groups _metrics;
+
+public:
+    large_write_monitor(database& db, uint64_t threshold_bytes);
+    ~large_write_monitor();
+
+private:
+    void scan();
+};
+
 class toppartitions_query {
     distributed<database>& _xdb;
     std::unordered_set<std::tuple<sstring, sstring>, utils::tuple_hash> _table_filters;
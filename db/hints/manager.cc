@@ -548,40 +548,37 @@ future<timespec> manager::end_point_hints_manager::sender::get_last_file_modific
     });
 }
 
-future<> manager::end_point_hints_manager::sender::do_send_one_mutation(frozen_mutation_and_schema m, const inet_address_vector_replica_set& natural_endpoints) noexcept {
-    return futurize_invoke([this, m = std::move(m), &natural_endpoints] () mutable -> future<> {
-        // The fact that we send with CL::ALL in both cases below ensures that new hints are not going
-        // to be generated as a result of hints sending.
-        if (boost::range::find(natural_endpoints, end_point_key()) != natural_endpoints.end()) {
-            manager_logger.trace("Sending directly to {}", end_point_key());
-            return _proxy.send_hint_to_endpoint(std::move(m), end_point_key());
-        } else {
-            manager_logger.trace("Endpoints set has changed and {} is no longer a replica. Mutating from scratch...", end_point_key());
-            return _proxy.send_hint_to_all_replicas(std::move(m));
-        }
-    });
-}
-
 bool manager::end_point_hints_manager::sender::can_send() noexcept {
     if (stopping() && !draining()) {
         return false;
     }
 
+    // Asking gossip about the destination per hint is needlessly expensive
+    // during replay - pin the last verdict for a short while. If the node goes
+    // down within the window we merely waste a few sends, which fail and mark
+    // the segment for another replay round anyway.
+    auto now = clock::now();
+    if (now - _liveness_checked_tp < liveness_cache_period) {
+        return _liveness_check_result;
+    }
+    _liveness_checked_tp = now;
+
     try {
-        auto ep_state_ptr = _gossiper. get_endpoint_state_for_endpoint_ptr(end_point_key());
+        auto ep_state_ptr = _gossiper.get_endpoint_state_for_endpoint_ptr(end_point_key());
         if (ep_state_ptr && ep_state_ptr->is_alive()) {
             _state.remove(state::ep_state_left_the_ring);
-            return true;
+            _liveness_check_result = true;
         } else {
             if (!_state.contains(state::ep_state_left_the_ring)) {
                 _state.set_if<state::ep_state_left_the_ring>(!_shard_manager.local_db().get_token_metadata().is_member(end_point_key()));
             }
             // send the hints out if the destination Node is part of the ring - we will send to all new replicas in this case
-            return _state.contains(state::ep_state_left_the_ring);
+            _liveness_check_result = _state.contains(state::ep_state_left_the_ring);
         }
     } catch (...) {
-        return false;
+        _liveness_check_result = false;
     }
+    return _liveness_check_result;
 }
 
 frozen_mutation_and_schema manager::end_point_hints_manager::sender::get_mutation(lw_shared_ptr<send_one_file_ctx> ctx_ptr, fragmented_temporary_buffer& buf) {
@@ -863,12 +860,46 @@ void manager::end_point_hints_manager::sender::start() {
     });
 }
 
-future<> manager::end_point_hints_manager::sender::send_one_mutation(frozen_mutation_and_schema m) {
-    keyspace& ks = _db.find_keyspace(m.s->ks_name());
-    auto token = dht::get_token(*m.s, m.fm.key());
-    inet_address_vector_replica_set natural_endpoints = ks.get_effective_replication_map()->get_natural_endpoints(std::move(token));
+void manager::end_point_hints_manager::sender::on_hint_send_result(lw_shared_ptr<send_one_file_ctx> ctx_ptr, db::replay_position rp, bool success) noexcept {
+    if (success) {
+        ctx_ptr->on_hint_send_success(rp);
+        auto new_bound = ctx_ptr->get_replayed_bound();
+        // Segments from other shards are replayed first and are considered to be "before" replay position 0.
+        // Update the sent upper bound only if it is a local segment.
+        if (new_bound.shard_id() == this_shard_id() && _sent_upper_bound_rp < new_bound) {
+            _sent_upper_bound_rp = new_bound;
+            notify_replay_waiters();
+        }
+    } else {
+        ctx_ptr->on_hint_send_failure(rp);
+    }
+}
 
-    return do_send_one_mutation(std::move(m), natural_endpoints);
+future<> manager::end_point_hints_manager::sender::flush_hint_batch(lw_shared_ptr<send_one_file_ctx> ctx_ptr) {
+    if (ctx_ptr->batch_mutations.empty()) {
+        return make_ready_future<>();
+    }
+    auto mutations = std::exchange(ctx_ptr->batch_mutations, {});
+    auto rps = std::exchange(ctx_ptr->batch_rps, {});
+    auto units = std::exchange(ctx_ptr->batch_units, {});
+
+    manager_logger.trace("Sending a batch of {} hints to {}", mutations.size(), end_point_key());
+    return _proxy.send_hint_to_endpoint(std::move(mutations), end_point_key()).then_wrapped(
+            [this, ctx_ptr, rps = std::move(rps), units = std::move(units)] (future<> f) {
+        bool ok = true;
+        try {
+            f.get();
+        } catch (...) {
+            ok = false;
+            manager_logger.trace("flush_hint_batch(): failed to send a batch of {} hints to {}: {}", rps.size(), end_point_key(), std::current_exception());
+        }
+        if (ok) {
+            this->shard_stats().sent += rps.size();
+        }
+        for (auto rp : rps) {
+            on_hint_send_result(ctx_ptr, rp, ok);
+        }
+    });
 }
 
 future<> manager::end_point_hints_manager::sender::send_one_hint(lw_shared_ptr<send_one_file_ctx> ctx_ptr, fragmented_temporary_buffer buf, db::replay_position rp, gc_clock::duration secs_since_file_mod, const sstring& fname) {
@@ -876,7 +907,7 @@ future<> manager::end_point_hints_manager::sender::send_one_hint(lw_shared_ptr<s
         ctx_ptr->mark_hint_as_in_progress(rp);
 
         // Future is waited on indirectly in `send_one_file()` (via `ctx_ptr->file_send_gate`).
-        (void)with_gate(ctx_ptr->file_send_gate, [this, secs_since_file_mod, &fname, buf = std::move(buf), rp, ctx_ptr] () mutable {
+        (void)with_gate(ctx_ptr->file_send_gate, [this, secs_since_file_mod, &fname, buf = std::move(buf), rp, ctx_ptr, units = std::move(units)] () mutable {
             try {
                 auto m = this->get_mutation(ctx_ptr, buf);
                 gc_clock::duration gc_grace_sec = m.s->gc_grace_seconds();
@@ -886,15 +917,36 @@ future<> manager::end_point_hints_manager::sender::send_one_hint(lw_shared_ptr<s
                 // Files are aggregated for at most manager::hints_timer_period therefore the oldest hint there is
                 // (last_modification - manager::hints_timer_period) old.
                 if (gc_clock::now().time_since_epoch() - secs_since_file_mod > gc_grace_sec - manager::hints_flush_period) {
+                    on_hint_send_result(ctx_ptr, rp, true);
                     return make_ready_future<>();
                 }
 
-                return this->send_one_mutation(std::move(m)).then([this, rp, ctx_ptr] {
+                keyspace& ks = _db.find_keyspace(m.s->ks_name());
+                auto token = dht::get_token(*m.s, m.fm.key());
+                inet_address_vector_replica_set natural_endpoints = ks.get_effective_replication_map()->get_natural_endpoints(std::move(token));
+
+                // The fact that we send with CL::ALL in both cases below ensures that new hints are not going
+                // to be generated as a result of hints sending.
+                if (boost::range::find(natural_endpoints, end_point_key()) != natural_endpoints.end()) {
+                    // The destination is still a replica - forward the stored frozen form as-is,
+                    // grouping hints into one batched verb instead of an RPC per mutation.
+                    ctx_ptr->batch_mutations.emplace_back(std::move(m));
+                    ctx_ptr->batch_rps.emplace_back(rp);
+                    ctx_ptr->batch_units.emplace_back(std::move(units));
+                    if (ctx_ptr->batch_mutations.size() >= max_hints_per_batch) {
+                        return flush_hint_batch(ctx_ptr);
+                    }
+                    return make_ready_future<>();
+                }
+
+                manager_logger.trace("Endpoints set has changed and {} is no longer a replica. Mutating from scratch...", end_point_key());
+                return _proxy.send_hint_to_all_replicas(std::move(m)).then([this, rp, ctx_ptr] {
                     ++this->shard_stats().sent;
+                    on_hint_send_result(ctx_ptr, rp, true);
                 }).handle_exception([this, ctx_ptr, rp] (auto eptr) {
                     manager_logger.trace("send_one_hint(): failed to send to {}: {}", end_point_key(), eptr);
-                    return make_exception_future<>(std::move(eptr));
-                });
+                    on_hint_send_result(ctx_ptr, rp, false);
+                }).finally([units = std::move(units)] {});
 
             // ignore these errors and move on - probably this hint is too old and the KS/CF has been deleted...
             } catch (no_such_column_family& e) {
@@ -909,25 +961,11 @@ future<> manager::end_point_hints_manager::sender::send_one_hint(lw_shared_ptr<s
             } catch (...) {
                 auto eptr = std::current_exception();
                 manager_logger.debug("send_hints(): unexpected error in file {} at {}: {}", fname, rp, eptr);
-                return make_exception_future<>(std::move(eptr));
+                on_hint_send_result(ctx_ptr, rp, false);
+                return make_ready_future<>();
             }
+            on_hint_send_result(ctx_ptr, rp, true);
             return make_ready_future<>();
-        }).then_wrapped([this, units = std::move(units), rp, ctx_ptr] (future<>&& f) {
-            // Information about the error was already printed somewhere higher.
-            // We just need to account in the ctx that sending of this hint has failed.
-            if (!f.failed()) {
-                ctx_ptr->on_hint_send_success(rp);
-                auto new_bound = ctx_ptr->get_replayed_bound();
-                // Segments from other shards are replayed first and are considered to be "before" replay position 0.
-                // Update the sent upper bound only if it is a local segment.
-                if (new_bound.shard_id() == this_shard_id() && _sent_upper_bound_rp < new_bound) {
-                    _sent_upper_bound_rp = new_bound;
-                    notify_replay_waiters();
-                }
-            } else {
-                ctx_ptr->on_hint_send_failure(rp);
-            }
-            f.ignore_ready_future();
         });
     }).handle_exception([this, ctx_ptr, rp] (auto eptr) {
         manager_logger.trace("send_one_file(): Hmmm. Something bad had happend: {}", eptr);
@@ -1093,6 +1131,9 @@ bool manager::end_point_hints_manager::sender::send_one_file(const sstring& fnam
         ctx_ptr->segment_replay_failed = true;
     }
 
+    // send out the last, incomplete batch if there is one
+    flush_hint_batch(ctx_ptr).get();
+
     // wait till all background hints sending is complete
     ctx_ptr->file_send_gate.close().get();
 
@@ -132,6 +132,11 @@ public:
                 std::optional<db::replay_position> last_succeeded_rp;
                 std::set<db::replay_position> in_progress_rps;
                 bool segment_replay_failed = false;
+                // Hints awaiting a single batched send to the destination. The resource
+                // units of every batched hint are held until its batch is flushed.
+                std::vector<frozen_mutation_and_schema> batch_mutations;
+                std::vector<db::replay_position> batch_rps;
+                std::vector<semaphore_units<named_semaphore::exception_factory>> batch_units;
 
                 void mark_hint_as_in_progress(db::replay_position rp);
                 void on_hint_send_success(db::replay_position rp) noexcept;
@@ -142,6 +147,11 @@ public:
             };
 
         private:
+            // How many hints are grouped into a single batched send at most.
+            static constexpr size_t max_hints_per_batch = 16;
+            // For how long can_send() may reuse the last gossiper liveness verdict.
+            static constexpr std::chrono::milliseconds liveness_cache_period{100};
+
             std::list<sstring> _segments_to_replay;
             // Segments to replay which were not created on this shard but were moved during rebalancing
             std::list<sstring> _foreign_segments_to_replay;
@@ -153,6 +163,8 @@ public:
             abort_source _stop_as;
             clock::time_point _next_flush_tp;
             clock::time_point _next_send_retry_tp;
+            clock::time_point _liveness_checked_tp;
+            bool _liveness_check_result = false;
             key_type _ep_key;
             end_point_hints_manager& _ep_manager;
             manager& _shard_manager;
@@ -283,21 +295,18 @@ public:
             /// \return
             const column_mapping& get_column_mapping(lw_shared_ptr<send_one_file_ctx> ctx_ptr, const frozen_mutation& fm, const hint_entry_reader& hr);
 
-            /// \brief Perform a single mutation send atempt.
-            ///
-            /// If the original destination end point is still a replica for the given mutation - send the mutation directly
-            /// to it, otherwise execute the mutation "from scratch" with CL=ALL.
+            /// \brief Account the result of sending one hint and update the replayed bound.
             ///
-            /// \param m mutation to send
-            /// \param natural_endpoints current replicas for the given mutation
-            /// \return future that resolves when the operation is complete
-            future<> do_send_one_mutation(frozen_mutation_and_schema m, const inet_address_vector_replica_set& natural_endpoints) noexcept;
+            /// \param ctx_ptr pointer to the send context
+            /// \param rp replay position of the hint
+            /// \param success TRUE if the hint was successfully sent (or legitimately dropped)
+            void on_hint_send_result(lw_shared_ptr<send_one_file_ctx> ctx_ptr, db::replay_position rp, bool success) noexcept;
 
-            /// \brief Send one mutation out.
+            /// \brief Send out the hints batched so far for the destination in a single verb.
             ///
-            /// \param m mutation to send
-            /// \return future that resolves when the mutation sending processing is complete.
-            future<> send_one_mutation(frozen_mutation_and_schema m);
+            /// \param ctx_ptr pointer to the send context
+            /// \return future that resolves when the batch send attempt is complete; never exceptional
+            future<> flush_hint_batch(lw_shared_ptr<send_one_file_ctx> ctx_ptr);
 
             /// \brief Notifies replay waiters for which the target replay position was reached.
             void notify_replay_waiters() noexcept;
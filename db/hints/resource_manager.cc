@@ -64,7 +64,11 @@ future<semaphore_units<named_semaphore::exception_factory>> resource_manager::ge
     // Allow a very big mutation to be sent out by consuming the whole shard budget
     hint_memory_budget = std::min(hint_memory_budget, _max_send_in_flight_memory);
     resource_manager_logger.trace("memory budget: need {} have {}", hint_memory_budget, _send_limiter.available_units());
-    return get_units(_send_limiter, hint_memory_budget);
+    // Pace replay by the on-the-wire size before competing for in-flight
+    // memory, so a recovering node is not flooded at full disk read speed.
+    return _send_rate_limiter.reserve(buf_size).then([this, hint_memory_budget] {
+        return get_units(_send_limiter, hint_memory_budget);
+    });
 }
 
 size_t resource_manager::sending_queue_length() const {
@@ -31,6 +31,7 @@
 #include <unordered_set>
 #include "utils/small_vector.hh"
 #include "utils/updateable_value.hh"
+#include "utils/rate_limiter.hh"
 #include "lister.hh"
 #include "enum_set.hh"
 
@@ -128,6 +129,8 @@ class resource_manager {
     const size_t _max_send_in_flight_memory;
     utils::updateable_value<uint32_t> _max_hints_send_queue_length;
     seastar::named_semaphore _send_limiter;
+    // Paces hint replay in bytes per second (per shard). Zero rate - no pacing.
+    utils::rate_limiter _send_rate_limiter;
 
     seastar::named_semaphore _operation_lock;
     space_watchdog::shard_managers_set _shard_managers;
@@ -175,10 +178,11 @@ public:
     static constexpr size_t default_per_shard_concurrency_limit = 8;
 
 public:
-    resource_manager(size_t max_send_in_flight_memory, utils::updateable_value<uint32_t> max_hint_sending_concurrency)
+    resource_manager(size_t max_send_in_flight_memory, utils::updateable_value<uint32_t> max_hint_sending_concurrency, size_t send_rate_limit_bytes_per_s = 0)
         : _max_send_in_flight_memory(max_send_in_flight_memory)
         , _max_hints_send_queue_length(std::move(max_hint_sending_concurrency))
         , _send_limiter(_max_send_in_flight_memory, named_semaphore_exception_factory{"send limiter"})
+        , _send_rate_limiter(send_rate_limit_bytes_per_s)
         , _operation_lock(1, named_semaphore_exception_factory{"operation lock"})
         , _space_watchdog(_shard_managers, _per_device_limits_map)
     {}
@@ -0,0 +1,168 @@
+/*
+ * Copyright (C) 2021-present ScyllaDB
+ */
+
+/*
+ * This file is part of Scylla.
+ *
+ * Scylla is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Scylla is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Scylla.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "db/hot_partition_mirror.hh"
+#include "database.hh"
+#include "frozen_mutation.hh"
+#include "xx_hasher.hh"
+
+namespace db {
+
+hot_partition_version_tracker::hot_partition_version_tracker(database& db)
+        : _db(db) {
+    _db.data_listeners().install(this);
+}
+
+hot_partition_version_tracker::~hot_partition_version_tracker() {
+    _db.data_listeners().uninstall(this);
+}
+
+std::optional<uint64_t> hot_partition_version_tracker::track(const utils::UUID& cf_id, int64_t token) {
+    auto now = seastar::lowres_clock::now();
+    if (_tracked.size() >= max_tracked_partitions && !_tracked.contains(std::tuple(cf_id, token))) {
+        std::erase_if(_tracked, [now] (const auto& e) { return e.second.expiry <= now; });
+        if (_tracked.size() >= max_tracked_partitions) {
+            return std::nullopt;
+        }
+    }
+    auto [it, inserted] = _tracked.try_emplace(std::tuple(cf_id, token));
+    it->second.expiry = now + tracking_period;
+    return it->second.version;
+}
+
+std::optional<uint64_t> hot_partition_version_tracker::version_of(const utils::UUID& cf_id, int64_t token) const {
+    auto it = _tracked.find(std::tuple(cf_id, token));
+    if (it == _tracked.end() || it->second.expiry <= seastar::lowres_clock::now()) {
+        return std::nullopt;
+    }
+    return it->second.version;
+}
+
+void hot_partition_version_tracker::on_write(const schema_ptr& s, const frozen_mutation& m) {
+    if (_tracked.empty()) {
+        return;
+    }
+    auto it = _tracked.find(std::tuple(s->id(), m.decorated_key(*s).token().raw()));
+    if (it != _tracked.end()) {
+        ++it->second.version;
+    }
+}
+
+// Folds everything about the slice which influences the result bytes into a
+// 64-bit identity, so snapshots are only ever served to queries of exactly the
+// shape that produced them.
+static uint64_t slice_identity_hash(const schema& s, const query::partition_slice& slice) {
+    xx_hasher h;
+    auto feed_ranges = [&] (const query::clustering_row_ranges& ranges) {
+        feed_hash(h, ranges.size());
+        for (const auto& r : ranges) {
+            auto feed_bound = [&] (const std::optional<query::clustering_range::bound>& b) {
+                feed_hash(h, bool(b));
+                if (b) {
+                    feed_hash(h, b->value(), s);
+                    feed_hash(h, b->is_inclusive());
+                }
+            };
+            feed_bound(r.start());
+            feed_bound(r.end());
+        }
+    };
+    feed_ranges(slice.default_row_ranges());
+    feed_hash(h, slice.static_columns.size());
+    for (auto id : slice.static_columns) {
+        feed_hash(h, id);
+    }
+    feed_hash(h, slice.regular_columns.size());
+    for (auto id : slice.regular_columns) {
+        feed_hash(h, id);
+    }
+    feed_hash(h, slice.options.mask());
+    feed_hash(h, slice.partition_row_limit());
+    feed_hash(h, slice.cql_format().protocol_version());
+    if (const auto& specific = slice.get_specific_ranges()) {
+        feed_hash(h, specific->pk(), s);
+        feed_ranges(specific->ranges());
+    }
+    return h.finalize_uint64();
+}
+
+hot_partition_mirror::key_type
+hot_partition_mirror::make_key(const schema& s, const query::read_command& cmd, const dht::partition_range& pr, query::result_options opts) {
+    const auto& pos = pr.start()->value();
+    xx_hasher h;
+    if (pos.has_key()) {
+        feed_hash(h, *pos.key(), s);
+    }
+    return key_type(
+            cmd.cf_id,
+            pos.token().raw(),
+            h.finalize_uint64(),
+            cmd.schema_version,
+            slice_identity_hash(s, cmd.slice),
+            cmd.get_row_limit(),
+            cmd.partition_limit,
+            static_cast<uint8_t>(opts.request),
+            static_cast<uint8_t>(opts.digest_algo));
+}
+
+const hot_partition_mirror::entry* hot_partition_mirror::find(const key_type& key) {
+    auto it = _entries.find(key);
+    if (it == _entries.end()) {
+        return nullptr;
+    }
+    if (it->second.expiry <= seastar::lowres_clock::now()) {
+        _entries.erase(it);
+        return nullptr;
+    }
+    return &it->second;
+}
+
+void hot_partition_mirror::insert(key_type key, entry e) {
+    if (_entries.size() >= max_entries && !_entries.contains(key)) {
+        auto now = seastar::lowres_clock::now();
+        std::erase_if(_entries, [now] (const auto& e) { return e.second.expiry <= now; });
+        if (_entries.size() >= max_entries) {
+            return;
+        }
+    }
+    _entries.insert_or_assign(std::move(key), std::move(e));
+}
+
+void hot_partition_mirror::invalidate(const key_type& key) {
+    _entries.erase(key);
+}
+
+bool hot_partition_mirror::should_mirror(const utils::UUID& cf_id, int64_t token, uint32_t threshold) {
+    auto now = seastar::lowres_clock::now();
+    if (_read_counts.size() >= max_entries && !_read_counts.contains(std::tuple(cf_id, token))) {
+        std::erase_if(_read_counts, [now] (const auto& e) { return e.second.second <= now; });
+        if (_read_counts.size() >= max_entries) {
+            return false;
+        }
+    }
+    auto [it, inserted] = _read_counts.try_emplace(std::tuple(cf_id, token), 0, now + promotion_window);
+    if (it->second.second <= now) {
+        it->second = {0, now + promotion_window};
+    }
+    return ++it->second.first >= threshold;
+}
+
+} // namespace db
@@ -0,0 +1,138 @@
+/*
+ * Copyright (C) 2021-present ScyllaDB
+ */
+
+/*
+ * This file is part of Scylla.
+ *
+ * Scylla is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Scylla is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Scylla.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+// Hot partition read mirroring restores intra-node scaling for skewed read
+// workloads: a partition is owned by exactly one shard, so a single hot key
+// can saturate that shard while the rest of the node idles. When enabled
+// (hot_partition_read_mirroring_threshold), a coordinator shard which keeps
+// forwarding singular reads of the same partition to another local shard
+// promotes that partition and caches a read-only snapshot of the query result.
+// Subsequent identical reads are served from the snapshot; the owning shard is
+// still consulted on every read, but only for a write-version lookup, so the
+// expensive part of the read - building and holding the result - runs on the
+// mirroring shard.
+//
+// Correctness: the owning shard bumps the partition's write version
+// synchronously from the write path, before the write is acked, and the
+// mirroring shard serves a snapshot only after the owner confirms its version
+// is unchanged. A snapshot therefore always reflects every acked write, and
+// the only staleness a mirrored read can observe is TTL expiry of cells during
+// the snapshot's short lifetime.
+
+#include <chrono>
+#include <optional>
+#include <unordered_map>
+
+#include <seastar/core/lowres_clock.hh>
+#include <seastar/core/shared_ptr.hh>
+
+#include "db/data_listeners.hh"
+#include "query-request.hh"
+#include "query-result.hh"
+#include "cache_temperature.hh"
+#include "utils/hash.hh"
+
+namespace db {
+
+// The owning-shard half: tracks a write version for each partition whose read
+// results other shards of this node currently mirror. Installed as a data
+// listener so the version is bumped from the write path; the lookup is a
+// no-op while nothing is tracked.
+class hot_partition_version_tracker : public data_listener {
+public:
+    // Tracking (and hence snapshot) lifetime. Bounds how long an expired-TTL
+    // cell may still be reported live by a mirrored snapshot.
+    static constexpr std::chrono::milliseconds tracking_period{100};
+    // Caps the size of the write-path lookup table; track() refuses new
+    // partitions beyond it.
+    static constexpr size_t max_tracked_partitions = 256;
+
+private:
+    struct entry {
+        uint64_t version = 0;
+        seastar::lowres_clock::time_point expiry;
+    };
+
+    database& _db;
+    std::unordered_map<std::tuple<utils::UUID, int64_t>, entry, utils::tuple_hash> _tracked;
+
+public:
+    explicit hot_partition_version_tracker(database& db);
+    ~hot_partition_version_tracker();
+
+    // Starts (or refreshes) tracking the given partition and returns its
+    // current write version, or nullopt if the tracking table is full.
+    std::optional<uint64_t> track(const utils::UUID& cf_id, int64_t token);
+
+    // Returns the partition's current write version, or nullopt if it is not
+    // (or no longer) tracked.
+    std::optional<uint64_t> version_of(const utils::UUID& cf_id, int64_t token) const;
+
+    virtual void on_write(const schema_ptr& s, const frozen_mutation& m) override;
+};
+
+// The coordinator-shard half: a small cache of read-only result snapshots for
+// hot partitions owned by other shards of this node, living above their
+// row_cache. Entries are keyed by both the partition and the shape of the
+// query, so different statements hitting the same hot key don't mix.
+class hot_partition_mirror {
+public:
+    static constexpr std::chrono::milliseconds entry_ttl = hot_partition_version_tracker::tracking_period;
+    // Window over which cross-shard reads of a partition are counted towards
+    // the promotion threshold.
+    static constexpr std::chrono::seconds promotion_window{1};
+    static constexpr size_t max_entries = 64;
+
+    // (cf_id, token, partition key hash, schema version, slice hash, row
+    // limit, partition limit, result request, digest algorithm). The
+    // partition key and slice are folded into 64-bit hashes; like for query
+    // result digests, a collision is considered too improbable to defend
+    // against.
+    using key_type = std::tuple<utils::UUID, int64_t, uint64_t, table_schema_version, uint64_t, uint64_t, uint32_t, uint8_t, uint8_t>;
+
+    struct entry {
+        seastar::lw_shared_ptr<query::result> result;
+        cache_temperature hit_rate;
+        uint64_t version;
+        seastar::lowres_clock::time_point expiry;
+    };
+
+private:
+    std::unordered_map<key_type, entry, utils::tuple_hash> _entries;
+    std::unordered_map<std::tuple<utils::UUID, int64_t>, std::pair<uint32_t, seastar::lowres_clock::time_point>, utils::tuple_hash> _read_counts;
+
+public:
+    static key_type make_key(const schema& s, const query::read_command& cmd, const dht::partition_range& pr, query::result_options opts);
+
+    // Returns the entry for the key if present and not expired. The returned
+    // pointer is invalidated by any other non-const call.
+    const entry* find(const key_type& key);
+    void insert(key_type key, entry e);
+    void invalidate(const key_type& key);
+
+    // Counts a cross-shard read of the given partition and returns true when
+    // it crossed the promotion threshold within the current window.
+    bool should_mirror(const utils::UUID& cf_id, int64_t token, uint32_t threshold);
+};
+
+} // namespace db
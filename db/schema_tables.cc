@@ -51,6 +51,7 @@
 #include "query-result-writer.hh"
 #include "schema_builder.hh"
 #include "map_difference.hh"
+#include "to_string.hh"
 #include "utils/UUID_gen.hh"
 #include <seastar/coroutine/all.hh>
 #include "log.hh"
@@ -936,19 +937,91 @@ static utils::UUID table_id_from_mutations(const schema_mutations& sm) {
     return table_row.get_nonnull<utils::UUID>("id");
 }
 
+// Which table (or view) definitions of a keyspace are possibly affected by a
+// set of schema mutations. Used to avoid re-reading and re-diffing the
+// definitions of every table in a keyspace when only a few of them changed.
+struct table_selector {
+    // If set, all tables in the keyspace are selected and the name set below
+    // is meaningless.
+    bool all_in_keyspace = false;
+    std::unordered_set<sstring> tables;
+
+    table_selector& operator+=(table_selector&& o) {
+        all_in_keyspace |= o.all_in_keyspace;
+        for (auto&& t : o.tables) {
+            tables.emplace(std::move(t));
+        }
+        return *this;
+    }
+};
+
+// Returns which table definitions in the keyspace given by the mutation's
+// partition key are possibly affected by the mutation. The first clustering
+// key component of every per-table schema table (tables, columns, ...) is the
+// table name, so as long as the mutation only touches individual rows we can
+// tell exactly which tables it refers to.
+static table_selector get_affected_tables(const sstring& keyspace_name, const mutation& m) {
+    const schema& s = *m.schema();
+    table_selector result;
+    if (m.partition().partition_tombstone() || !m.partition().row_tombstones().empty()) {
+        // A partition or range tombstone can cover any table of the keyspace
+        // (a keyspace drop covers all of them).
+        slogger.trace("Mutation of {}.{} affects all tables in keyspace {}", s.ks_name(), s.cf_name(), keyspace_name);
+        result.all_in_keyspace = true;
+        return result;
+    }
+    static const std::unordered_set<sstring> per_table_schema_tables = {
+        TABLES, SCYLLA_TABLES, COLUMNS, DROPPED_COLUMNS, TRIGGERS, VIEWS, INDEXES, VIEW_VIRTUAL_COLUMNS, COMPUTED_COLUMNS,
+    };
+    if (!per_table_schema_tables.contains(s.cf_name())) {
+        // Keyspace, type, function and aggregate rows don't change table
+        // definitions; statements which do (e.g. ALTER TYPE) also emit
+        // mutations for the affected tables themselves.
+        return result;
+    }
+    for (auto&& row : m.partition().clustered_rows()) {
+        result.tables.emplace(value_cast<sstring>(utf8_type->deserialize(row.key().get_component(s, 0))));
+    }
+    slogger.trace("Mutation of {}.{} affects tables {} in keyspace {}", s.ks_name(), s.cf_name(), result.tables, keyspace_name);
+    return result;
+}
+
 static
 future<std::map<utils::UUID, schema_mutations>>
-read_tables_for_keyspaces(distributed<service::storage_proxy>& proxy, const std::set<sstring>& keyspace_names, schema_ptr s)
+read_tables_for_keyspaces(distributed<service::storage_proxy>& proxy, const std::set<sstring>& keyspace_names, schema_ptr s,
+        const std::unordered_map<sstring, table_selector>& affected_tables)
 {
-    std::map<utils::UUID, schema_mutations> result;
+    std::vector<qualified_name> names;
     for (auto&& keyspace_name : keyspace_names) {
-        for (auto&& table_name : co_await read_table_names_of_keyspace(proxy, keyspace_name, s)) {
-            auto qn = qualified_name(keyspace_name, table_name);
-            auto muts = co_await read_table_mutations(proxy, qn, s);
-            auto id = table_id_from_mutations(muts);
-            result.emplace(std::move(id), std::move(muts));
+        auto sel = affected_tables.find(keyspace_name);
+        if (sel == affected_tables.end()) {
+            continue;
+        }
+        if (sel->second.all_in_keyspace) {
+            for (auto&& table_name : co_await read_table_names_of_keyspace(proxy, keyspace_name, s)) {
+                names.emplace_back(keyspace_name, table_name);
+            }
+        } else {
+            for (auto&& table_name : sel->second.tables) {
+                names.emplace_back(keyspace_name, table_name);
+            }
         }
     }
+    std::map<utils::UUID, schema_mutations> result;
+    // Reading one definition is itself several concurrent queries, so put a
+    // lid on how many definitions are read at a time.
+    co_await max_concurrent_for_each(names, 64, [&] (const qualified_name& qn) -> future<> {
+        auto muts = co_await read_table_mutations(proxy, qn, s);
+        if (!muts.live()) {
+            // The selector doesn't distinguish tables from views, so when
+            // reading tables a selected name may refer to a view (and vice
+            // versa); the name may also refer to a dropped or a being-created
+            // table. In all those cases there is no definition to read.
+            co_return;
+        }
+        auto id = table_id_from_mutations(muts);
+        result.emplace(std::move(id), std::move(muts));
+    });
     co_return result;
 }
 
@@ -1051,8 +1124,11 @@ static future<> do_merge_schema(distributed<service::storage_proxy>& proxy, std:
     // compare before/after schemas of the affected keyspaces only
     std::set<sstring> keyspaces;
     std::set<utils::UUID> column_families;
+    std::unordered_map<sstring, table_selector> affected_tables;
     for (auto&& mutation : mutations) {
-        keyspaces.emplace(value_cast<sstring>(utf8_type->deserialize(mutation.key().get_component(*s, 0))));
+        auto keyspace_name = value_cast<sstring>(utf8_type->deserialize(mutation.key().get_component(*s, 0)));
+        affected_tables[keyspace_name] += get_affected_tables(keyspace_name, mutation);
+        keyspaces.emplace(std::move(keyspace_name));
         column_families.emplace(mutation.column_family_id());
         // We must force recalculation of schema version after the merge, since the resulting
         // schema may be a mix of the old and new schemas.
@@ -1061,9 +1137,9 @@ static future<> do_merge_schema(distributed<service::storage_proxy>& proxy, std:
 
     // current state of the schema
     auto&& old_keyspaces = co_await read_schema_for_keyspaces(proxy, KEYSPACES, keyspaces);
-    auto&& old_column_families = co_await read_tables_for_keyspaces(proxy, keyspaces, tables());
+    auto&& old_column_families = co_await read_tables_for_keyspaces(proxy, keyspaces, tables(), affected_tables);
     auto&& old_types = co_await read_schema_for_keyspaces(proxy, TYPES, keyspaces);
-    auto&& old_views = co_await read_tables_for_keyspaces(proxy, keyspaces, views());
+    auto&& old_views = co_await read_tables_for_keyspaces(proxy, keyspaces, views(), affected_tables);
     auto old_functions = co_await read_schema_for_keyspaces(proxy, FUNCTIONS, keyspaces);
     auto old_aggregates = co_await read_schema_for_keyspaces(proxy, AGGREGATES, keyspaces);
 
@@ -1081,9 +1157,9 @@ static future<> do_merge_schema(distributed<service::storage_proxy>& proxy, std:
 
     // with new data applied
     auto&& new_keyspaces = co_await read_schema_for_keyspaces(proxy, KEYSPACES, keyspaces);
-    auto&& new_column_families = co_await read_tables_for_keyspaces(proxy, keyspaces, tables());
+    auto&& new_column_families = co_await read_tables_for_keyspaces(proxy, keyspaces, tables(), affected_tables);
     auto&& new_types = co_await read_schema_for_keyspaces(proxy, TYPES, keyspaces);
-    auto&& new_views = co_await read_tables_for_keyspaces(proxy, keyspaces, views());
+    auto&& new_views = co_await read_tables_for_keyspaces(proxy, keyspaces, views(), affected_tables);
     auto new_functions = co_await read_schema_for_keyspaces(proxy, FUNCTIONS, keyspaces);
     auto new_aggregates = co_await read_schema_for_keyspaces(proxy, AGGREGATES, keyspaces);
 
@@ -89,6 +89,7 @@
 #include "gms/gossiper.hh"
 #include "service/paxos/paxos_state.hh"
 #include "utils/build_id.hh"
+#include "utils/stall_fingerprints.hh"
 #include "query-result-set.hh"
 #include "idl/frozen_mutation.dist.hh"
 #include "serializer_impl.hh"
@@ -498,6 +499,31 @@ schema_ptr system_keyspace::built_indexes() {
     return compaction_history;
 }
 
+/*static*/ schema_ptr system_keyspace::repair_history() {
+    static thread_local auto repair_history = [] {
+        schema_builder builder(generate_legacy_id(NAME, REPAIR_HISTORY), NAME, REPAIR_HISTORY,
+        // partition key
+        {{"keyspace_name", utf8_type}, {"columnfamily_name", utf8_type}},
+        // clustering key
+        {{"range_start", long_type}, {"range_end", long_type}},
+        // regular columns
+        {
+            {"id", uuid_type},
+            {"repair_time", timestamp_type},
+        },
+        // static columns
+        {},
+        // regular column name type
+        utf8_type,
+        // comment
+        "per-range history of successful repairs"
+        );
+        builder.with_version(generate_schema_version(builder.uuid()));
+        return builder.build(schema_builder::compact_storage::no);
+    }();
+    return repair_history;
+}
+
 /*static*/ schema_ptr system_keyspace::sstable_activity() {
     static thread_local auto sstable_activity = [] {
         schema_builder builder(generate_legacy_id(NAME, SSTABLE_ACTIVITY), NAME, SSTABLE_ACTIVITY,
@@ -1626,6 +1652,18 @@ future<std::optional<sstring>> system_keyspace::get_scylla_local_param(const sst
     return get_scylla_local_param_as<sstring>(key);
 }
 
+static const sstring COMMITLOG_CLEAN_SHUTDOWN_KEY = "commitlog_clean_shutdown_segment_id";
+
+future<> system_keyspace::save_commitlog_clean_shutdown_record(uint64_t max_segment_base_id) {
+    return set_scylla_local_param_as<int64_t>(COMMITLOG_CLEAN_SHUTDOWN_KEY, int64_t(max_segment_base_id));
+}
+
+future<std::optional<uint64_t>> system_keyspace::get_commitlog_clean_shutdown_record() {
+    return get_scylla_local_param_as<int64_t>(COMMITLOG_CLEAN_SHUTDOWN_KEY).then([] (std::optional<int64_t> val) {
+        return make_ready_future<std::optional<uint64_t>>(val ? std::optional<uint64_t>(uint64_t(*val)) : std::nullopt);
+    });
+}
+
 future<> system_keyspace::update_schema_version(utils::UUID version) {
     sstring req = format("INSERT INTO system.{} (key, schema_version) VALUES (?, ?)", LOCAL);
     return qctx->execute_cql(req, sstring(LOCAL), version).discard_result();
@@ -2479,6 +2517,86 @@ public:
     }
 };
 
+class stall_fingerprints_table : public streaming_virtual_table {
+public:
+    explicit stall_fingerprints_table()
+            : streaming_virtual_table(build_schema())
+    {
+        _shard_aware = true;
+    }
+
+    static schema_ptr build_schema() {
+        auto id = generate_legacy_id(system_keyspace::NAME, "stall_fingerprints");
+        return schema_builder(system_keyspace::NAME, "stall_fingerprints", std::make_optional(id))
+            .with_column("shard", int32_type, column_kind::partition_key)
+            .with_column("fingerprint", utf8_type, column_kind::clustering_key)
+            .with_column("scheduling_group", utf8_type)
+            .with_column("count", long_type)
+            .with_column("first_seen", timestamp_type)
+            .with_column("last_seen", timestamp_type)
+            .with_column("backtrace", utf8_type)
+            .set_comment("Reactor stalls observed since startup, grouped by backtrace fingerprint.")
+            .with_version(system_keyspace::generate_schema_version(id))
+            .build();
+    }
+
+    dht::decorated_key make_partition_key(shard_id shard) {
+        return dht::decorate_key(*_s, partition_key::from_single_value(*_s, data_value(int32_t(shard)).serialize_nonnull()));
+    }
+
+    static db_clock::time_point to_db_clock(std::chrono::system_clock::time_point tp) {
+        return db_clock::time_point(std::chrono::duration_cast<db_clock::duration>(tp.time_since_epoch()));
+    }
+
+    future<> execute(reader_permit permit, result_collector& result, const query_restrictions& qr) override {
+        struct decorated_shard {
+            shard_id shard;
+            dht::decorated_key key;
+        };
+        std::vector<decorated_shard> shards;
+
+        for (auto shard : boost::irange(0u, smp::count)) {
+            auto dk = make_partition_key(shard);
+            if (!this_shard_owns(dk) || !contains_key(qr.partition_range(), dk)) {
+                continue;
+            }
+            shards.push_back({shard, std::move(dk)});
+        }
+
+        boost::sort(shards, [less = dht::ring_position_less_comparator(*_s)]
+                (const decorated_shard& l, const decorated_shard& r) {
+            return less(l.key, r.key);
+        });
+
+        for (auto& sh : shards) {
+            auto fingerprints = co_await smp::submit_to(sh.shard, [] {
+                return utils::get_local_stall_fingerprint_registry().snapshot();
+            });
+            // The fingerprint is a fixed-width hex string, so lexicographic
+            // clustering order matches numeric order.
+            boost::sort(fingerprints, [] (const auto& l, const auto& r) {
+                return l.id < r.id;
+            });
+
+            co_await result.emit_partition_start(sh.key);
+            for (auto& fp : fingerprints) {
+                sstring bt;
+                for (auto addr : fp.frames) {
+                    bt += format(" 0x{:x}", addr);
+                }
+                clustering_row cr(clustering_key::from_single_value(*_s, data_value(format("{:016x}", fp.id)).serialize_nonnull()));
+                set_cell(cr.cells(), "scheduling_group", fp.sched_group_name);
+                set_cell(cr.cells(), "count", int64_t(fp.count));
+                set_cell(cr.cells(), "first_seen", to_db_clock(fp.first_seen));
+                set_cell(cr.cells(), "last_seen", to_db_clock(fp.last_seen));
+                set_cell(cr.cells(), "backtrace", bt);
+                co_await result.emit_row(std::move(cr));
+            }
+            co_await result.emit_partition_end();
+        }
+    }
+};
+
 // Map from table's schema ID to table itself. Helps avoiding accidental duplication.
 static thread_local std::map<utils::UUID, std::unique_ptr<virtual_table>> virtual_tables;
 
@@ -2499,6 +2617,7 @@ void register_virtual_tables(distributed<database>& dist_db, distributed<service
     add_table(std::make_unique<runtime_info_table>(dist_db, ss));
     add_table(std::make_unique<versions_table>());
     add_table(std::make_unique<db_config_table>(cfg));
+    add_table(std::make_unique<stall_fingerprints_table>());
 }
 
 std::vector<schema_ptr> system_keyspace::all_tables(const db::config& cfg) {
@@ -2507,7 +2626,7 @@ std::vector<schema_ptr> system_keyspace::all_tables(const db::config& cfg) {
     std::copy(schema_tables.begin(), schema_tables.end(), std::back_inserter(r));
     r.insert(r.end(), { built_indexes(), hints(), batchlog(), paxos(), local(),
                     peers(), peer_events(), range_xfers(),
-                    compactions_in_progress(), compaction_history(),
+                    compactions_in_progress(), compaction_history(), repair_history(),
                     sstable_activity(), clients(), size_estimates(), large_partitions(), large_rows(), large_cells(),
                     scylla_local(), db::schema_tables::scylla_table_schema_history(),
                     v3::views_builds_in_progress(), v3::built_views(),
@@ -2710,6 +2829,33 @@ future<> system_keyspace::get_compaction_history(compaction_history_consumer&& f
     });
 }
 
+future<> system_keyspace::update_repair_history(utils::UUID id, sstring ksname, sstring cfname, int64_t range_start, int64_t range_end, db_clock::time_point repair_time) {
+    sstring req = format("INSERT INTO system.{} (keyspace_name, columnfamily_name, range_start, range_end, id, repair_time) VALUES (?, ?, ?, ?, ?, ?)",
+            REPAIR_HISTORY);
+    return qctx->execute_cql(req, ksname, cfname, range_start, range_end, id, repair_time).discard_result().handle_exception([] (auto ep) {
+        slogger.error("update repair history failed: {}: ignored", ep);
+    });
+}
+
+future<> system_keyspace::get_repair_history(sstring ksname, sstring cfname, repair_history_consumer&& f) {
+    return do_with(repair_history_consumer(std::move(f)), std::move(ksname), std::move(cfname),
+            [] (repair_history_consumer& consumer, sstring& ksname, sstring& cfname) mutable {
+        sstring req = format("SELECT * from system.{} WHERE keyspace_name = ? AND columnfamily_name = ?", REPAIR_HISTORY);
+        return qctx->qp().query_internal(req, db::consistency_level::ONE, {ksname, cfname}, 1000, [&consumer] (const cql3::untyped_result_set::row& row) mutable {
+            repair_history_entry entry;
+            entry.id = row.get_as<utils::UUID>("id");
+            entry.ks = row.get_as<sstring>("keyspace_name");
+            entry.cf = row.get_as<sstring>("columnfamily_name");
+            entry.range_start = row.get_as<int64_t>("range_start");
+            entry.range_end = row.get_as<int64_t>("range_end");
+            entry.repair_time = row.get_as<db_clock::time_point>("repair_time");
+            return consumer(std::move(entry)).then([] {
+                return stop_iteration::no;
+            });
+        });
+    });
+}
+
 future<int> system_keyspace::increment_and_get_generation() {
     auto req = format("SELECT gossip_generation FROM system.{} WHERE key='{}'", LOCAL, LOCAL);
     return qctx->qp().execute_internal(req).then([] (auto rs) {
@@ -111,6 +111,7 @@ class system_keyspace {
     static schema_ptr range_xfers();
     static schema_ptr compactions_in_progress();
     static schema_ptr compaction_history();
+    static schema_ptr repair_history();
     static schema_ptr sstable_activity();
     static schema_ptr large_partitions();
     static schema_ptr large_rows();
@@ -140,6 +141,7 @@ public:
     static constexpr auto RANGE_XFERS = "range_xfers";
     static constexpr auto COMPACTIONS_IN_PROGRESS = "compactions_in_progress";
     static constexpr auto COMPACTION_HISTORY = "compaction_history";
+    static constexpr auto REPAIR_HISTORY = "repair_history";
     static constexpr auto SSTABLE_ACTIVITY = "sstable_activity";
     static constexpr auto SIZE_ESTIMATES = "size_estimates";
     static constexpr auto LARGE_PARTITIONS = "large_partitions";
@@ -321,6 +323,24 @@ public:
     using compaction_history_consumer = noncopyable_function<future<>(const compaction_history_entry&)>;
     static future<> get_compaction_history(compaction_history_consumer&& f);
 
+    struct repair_history_entry {
+        utils::UUID id;
+        sstring ks;
+        sstring cf;
+        // Range bounds as int64 token values; an absent bound is stored as
+        // the numeric limit of the corresponding side.
+        int64_t range_start = 0;
+        int64_t range_end = 0;
+        db_clock::time_point repair_time;
+    };
+
+    // Records a successfully repaired range of a table, overwriting any
+    // previous record for the same range. The history lets a scheduler skip
+    // ranges that have not changed since their last successful repair.
+    static future<> update_repair_history(utils::UUID id, sstring ksname, sstring cfname, int64_t range_start, int64_t range_end, db_clock::time_point repair_time);
+    using repair_history_consumer = noncopyable_function<future<>(const repair_history_entry&)>;
+    static future<> get_repair_history(sstring ksname, sstring cfname, repair_history_consumer&& f);
+
     typedef std::vector<db::replay_position> replay_positions;
 
     static future<> save_truncation_record(utils::UUID, db_clock::time_point truncated_at, db::replay_position);
@@ -330,6 +350,16 @@ public:
     static future<db_clock::time_point> get_truncated_at(utils::UUID);
     static future<truncation_record> get_truncation_record(utils::UUID cf_id);
 
+    // Clean-shutdown commitlog watermark, written during drain once every
+    // table has been flushed and the data commitlog was shut down. Every
+    // data commitlog segment whose base id is not greater than the recorded
+    // value is fully covered by sstables, so replay can skip it without
+    // reading it. Segment ids grow monotonically across restarts and a
+    // segment is never written to again once recorded, so the record never
+    // needs to be invalidated.
+    static future<> save_commitlog_clean_shutdown_record(uint64_t max_segment_base_id);
+    static future<std::optional<uint64_t>> get_commitlog_clean_shutdown_record();
+
     /**
      * Return a map of stored tokens to IP addresses
      *
@@ -65,15 +65,40 @@ row_locker::lock_holder::lock_holder(row_locker* locker, const dht::decorated_ke
     , _row_exclusive(exclusive) {
 }
 
+row_locker::two_level_locks_map_type::iterator
+row_locker::get_or_create_partition_entry(const dht::decorated_key& pk) {
+    auto i = _two_level_locks.find(pk);
+    if (i == _two_level_locks.end()) {
+        if (_spare_partition_node) {
+            // Reuse the node recycled by the last unlock() instead of
+            // allocating a new one. The lock it holds is fully released
+            // and its row map is empty, or it wouldn't have been erased.
+            _spare_partition_node.key() = pk;
+            i = _two_level_locks.insert(std::move(_spare_partition_node)).position;
+        } else {
+            i = _two_level_locks.try_emplace(pk, this).first;
+        }
+    }
+    return i;
+}
+
 future<row_locker::lock_holder>
 row_locker::lock_pk(const dht::decorated_key& pk, bool exclusive, db::timeout_clock::time_point timeout, stats& stats) {
     mylog.debug("taking {} lock on entire partition {}", (exclusive ? "exclusive" : "shared"), pk);
-    auto i = _two_level_locks.try_emplace(pk, this).first;
+    auto i = get_or_create_partition_entry(pk);
     single_lock_stats &single_lock_stats = exclusive ? stats.exclusive_partition : stats.shared_partition;
+    auto f = exclusive ? i->second._partition_lock.write_lock(timeout) : i->second._partition_lock.read_lock(timeout);
+    if (f.available() && !f.failed()) {
+        // Uncontended fast path: the lock was granted on the spot, no need
+        // for the latency-tracking continuation.
+        f.ignore_ready_future();
+        single_lock_stats.estimated_waiting_for_lock.add_micro(0);
+        single_lock_stats.lock_acquisitions++;
+        return make_ready_future<lock_holder>(this, &i->first, exclusive);
+    }
     single_lock_stats.operations_currently_waiting_for_lock++;
     utils::latency_counter waiting_latency;
     waiting_latency.start();
-    auto f = exclusive ? i->second._partition_lock.write_lock(timeout) : i->second._partition_lock.read_lock(timeout);
     // Note: we rely on the fact that &i->first, the pointer to a key, never
     // becomes invalid (as long as the item is actually in the hash table),
     // even in the case of rehashing.
@@ -89,13 +114,20 @@ row_locker::lock_pk(const dht::decorated_key& pk, bool exclusive, db::timeout_cl
 future<row_locker::lock_holder>
 row_locker::lock_ck(const dht::decorated_key& pk, const clustering_key_prefix& cpk, bool exclusive, db::timeout_clock::time_point timeout, stats& stats) {
     mylog.debug("taking shared lock on partition {}, and {} lock on row {} in it", pk, (exclusive ? "exclusive" : "shared"), cpk);
-    auto i = _two_level_locks.try_emplace(pk, this).first;
+    auto i = get_or_create_partition_entry(pk);
     future<lock_type::holder> lock_partition = i->second._partition_lock.hold_read_lock(timeout);
     auto j = i->second._row_locks.find(cpk);
     if (j == i->second._row_locks.end()) {
         // Not yet locked, need to create the lock. This makes a copy of cpk.
         try {
-            j = i->second._row_locks.emplace(cpk, lock_type()).first;
+            if (_spare_row_node) {
+                // As in get_or_create_partition_entry(), reuse the tree node
+                // recycled by the last unlock() rather than allocating.
+                _spare_row_node.key() = cpk;
+                j = i->second._row_locks.insert(std::move(_spare_row_node)).position;
+            } else {
+                j = i->second._row_locks.emplace(cpk, lock_type()).first;
+            }
         } catch(...) {
             // If this emplace() failed, e.g., out of memory, we fail. We
             // could do nothing - the partition lock we already started
@@ -112,10 +144,19 @@ row_locker::lock_ck(const dht::decorated_key& pk, const clustering_key_prefix& c
         }
     }
     single_lock_stats &single_lock_stats = exclusive ? stats.exclusive_row : stats.shared_row;
+    future<lock_type::holder> lock_row = exclusive ? j->second.hold_write_lock(timeout) : j->second.hold_read_lock(timeout);
+    if (lock_partition.available() && !lock_partition.failed() && lock_row.available() && !lock_row.failed()) {
+        // Uncontended fast path: both locks were granted on the spot, no
+        // need for the latency-tracking continuation.
+        lock_partition.get0().release();
+        lock_row.get0().release();
+        single_lock_stats.estimated_waiting_for_lock.add_micro(0);
+        single_lock_stats.lock_acquisitions++;
+        return make_ready_future<lock_holder>(this, &i->first, &j->first, exclusive);
+    }
     single_lock_stats.operations_currently_waiting_for_lock++;
     utils::latency_counter waiting_latency;
     waiting_latency.start();
-    future<lock_type::holder> lock_row = exclusive ? j->second.hold_write_lock(timeout) : j->second.hold_read_lock(timeout);
     return when_all_succeed(std::move(lock_partition), std::move(lock_row))
     .then_unpack([this, pk = &i->first, cpk = &j->first, exclusive, &single_lock_stats, waiting_latency = std::move(waiting_latency)] (auto lock1, auto lock2) mutable {
         lock1.release();
@@ -186,7 +227,8 @@ row_locker::unlock(const dht::decorated_key* pk, bool partition_exclusive,
             }
             if (!lock.locked()) {
                 mylog.debug("Erasing lock object for row {} in partition {}", *cpk, *pk);
-                pli->second._row_locks.erase(rli);
+                // Recycle the node for the next lock_ck() instead of freeing it.
+                _spare_row_node = pli->second._row_locks.extract(rli);
             }
         }
         mylog.debug("releasing {} lock for entire partition {}", (partition_exclusive ? "exclusive" : "shared"), *pk);
@@ -198,7 +240,9 @@ row_locker::unlock(const dht::decorated_key* pk, bool partition_exclusive,
         }
         if (!lock.locked()) {
             mylog.debug("Erasing lock object for partition {}", *pk);
-            _two_level_locks.erase(pli);
+            // Recycle the node for the next lock_pk()/lock_ck() instead of
+            // freeing it.
+            _spare_partition_node = _two_level_locks.extract(pli);
         }
      }
 }
@@ -110,7 +110,16 @@ private:
             return k1.equal(*locker->_schema, k2);
         }
     };
-    std::unordered_map<dht::decorated_key, two_level_lock, decorated_key_hash, decorated_key_equals_comparator> _two_level_locks;
+    using two_level_locks_map_type = std::unordered_map<dht::decorated_key, two_level_lock, decorated_key_hash, decorated_key_equals_comparator>;
+    using row_locks_map_type = std::map<clustering_key_prefix, lock_type, two_level_lock::clustering_key_prefix_less>;
+    two_level_locks_map_type _two_level_locks;
+    // In steady state an MV-heavy workload locks and unlocks one row at a
+    // time, which used to allocate a hash-table node and a tree node on
+    // every update and free them right after. Instead of freeing, keep the
+    // last erased node of each map and reuse it for the next lock.
+    two_level_locks_map_type::node_type _spare_partition_node;
+    row_locks_map_type::node_type _spare_row_node;
+    two_level_locks_map_type::iterator get_or_create_partition_entry(const dht::decorated_key& pk);
     void unlock(const dht::decorated_key* pk, bool partition_exclusive, const clustering_key_prefix* cpk, bool row_exclusive);
 public:
     // row_locker needs to know the column_family's schema because key
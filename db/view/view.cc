@@ -74,6 +74,7 @@
 #include "mutation.hh"
 #include "mutation_partition.hh"
 #include "service/migration_manager.hh"
+#include "service/priority_manager.hh"
 #include "service/storage_proxy.hh"
 #include "view_info.hh"
 #include "view_update_checks.hh"
@@ -255,6 +256,9 @@ void stats::register_stats() {
                     {_cf_label, _ks_label}),
             ms::make_gauge("view_updates_pending", ms::description("Number of updates pushed to view and are still to be completed"),
                     {_cf_label, _ks_label}, writes),
+            ms::make_derive("view_update_backlog_added_bytes", view_update_backlog_added_bytes,
+                    ms::description("Bytes of generated view updates charged to the pending view update memory quota on behalf of this base table"),
+                    {_cf_label, _ks_label}),
     });
 }
 
@@ -679,7 +683,7 @@ void create_virtual_column(schema_builder& builder, const bytes& name, const dat
     }
 }
 
-static void add_cells_to_view(const schema& base, const schema& view, row base_cells, row& view_cells) {
+static void add_cells_to_view(const schema& base, const schema& view, row&& base_cells, row& view_cells) {
     base_cells.for_each_cell([&] (column_id id, atomic_cell_or_collection& c) {
         auto* view_col = view_column(base, view, id);
         if (view_col && !view_col->is_primary_key()) {
@@ -689,6 +693,20 @@ static void add_cells_to_view(const schema& base, const schema& view, row base_c
     });
 }
 
+// Overload for base rows we don't own: only the cells of base columns that
+// the view actually selects are copied, so unselected columns of a wide base
+// row are never duplicated just to be dropped again.
+static void add_cells_to_view(const schema& base, const schema& view, const row& base_cells, row& view_cells) {
+    base_cells.for_each_cell([&] (column_id id, const atomic_cell_or_collection& c) {
+        auto* view_col = view_column(base, view, id);
+        if (view_col && !view_col->is_primary_key()) {
+            auto cell = c.copy(*base.regular_column_at(id).type);
+            maybe_make_virtual(cell, view_col);
+            view_cells.append_cell(view_col->id, std::move(cell));
+        }
+    });
+}
+
 /**
  * Creates a view entry corresponding to the provided base row.
  * This method checks that the base row does match the view filter before applying anything.
@@ -701,7 +719,7 @@ void view_updates::create_entry(const partition_key& base_key, const clustering_
     auto marker = compute_row_marker(update);
     r.apply(marker);
     r.apply(update.tomb());
-    add_cells_to_view(*_base, *_view, row(*_base, column_kind::regular_column, update.cells()), r.cells());
+    add_cells_to_view(*_base, *_view, update.cells(), r.cells());
     _op_count++;
 }
 
@@ -1204,26 +1222,53 @@ future<query::clustering_row_ranges> calculate_affected_clustering_ranges(const
 //
 // If the assumption that the given base token belongs to this replica
 // does not hold, we return an empty optional.
-static std::optional<gms::inet_address>
-get_view_natural_endpoint(const sstring& keyspace_name,
-        const dht::token& base_token, const dht::token& view_token) {
-    auto &db = service::get_local_storage_proxy().local_db();
+//
+// The pairing depends on the base token, the keyspace's replication and
+// the view token. Within one base-partition write the first two are fixed,
+// so everything derived from them - the effective replication map, the
+// datacenter-filtered base replica list - is captured once per write in a
+// view_update_routing_info and shared by all the updates of the batch,
+// leaving only the view-replica half of the computation per update.
+struct view_update_routing_info {
+    sstring keyspace_name;
+    locator::effective_replication_map_ptr erm;
+    locator::token_metadata_ptr tm;
+    gms::inet_address my_address;
+    sstring my_datacenter;
+    bool network_topology;
+    // The base replicas in this node's datacenter, in ring order.
+    std::vector<gms::inet_address> base_endpoints;
+};
+
+static view_update_routing_info
+make_view_update_routing_info(sstring keyspace_name, const dht::token& base_token) {
+    auto& db = service::get_local_storage_proxy().local_db();
     auto& ks = db.find_keyspace(keyspace_name);
     auto erm = ks.get_effective_replication_map();
+    auto tm = service::get_local_storage_proxy().get_token_metadata_ptr();
     auto my_address = utils::fb_utilities::get_broadcast_address();
     auto my_datacenter = locator::i_endpoint_snitch::get_local_snitch_ptr()->get_datacenter(my_address);
     bool network_topology = dynamic_cast<const locator::network_topology_strategy*>(&ks.get_replication_strategy());
-    std::vector<gms::inet_address> base_endpoints, view_endpoints;
+    std::vector<gms::inet_address> base_endpoints;
     for (auto&& base_endpoint : erm->get_natural_endpoints(base_token)) {
         if (!network_topology || locator::i_endpoint_snitch::get_local_snitch_ptr()->get_datacenter(base_endpoint) == my_datacenter) {
             base_endpoints.push_back(base_endpoint);
         }
     }
+    return view_update_routing_info{std::move(keyspace_name), std::move(erm), std::move(tm), my_address,
+            std::move(my_datacenter), network_topology, std::move(base_endpoints)};
+}
 
-    for (auto&& view_endpoint : erm->get_natural_endpoints(view_token)) {
+static std::optional<gms::inet_address>
+get_view_natural_endpoint(const view_update_routing_info& info, const dht::token& view_token) {
+    // The loop below removes endpoints shared between the base and the view
+    // from the base list, so work on a copy and keep the per-write list intact.
+    auto base_endpoints = info.base_endpoints;
+    std::vector<gms::inet_address> view_endpoints;
+    for (auto&& view_endpoint : info.erm->get_natural_endpoints(view_token)) {
         // If this base replica is also one of the view replicas, we use
         // ourselves as the view replica.
-        if (view_endpoint == my_address) {
+        if (view_endpoint == info.my_address) {
             return view_endpoint;
         }
         // We have to remove any endpoint which is shared between the base
@@ -1233,13 +1278,13 @@ get_view_natural_endpoint(const sstring& keyspace_name,
             view_endpoint);
         if (it != base_endpoints.end()) {
             base_endpoints.erase(it);
-        } else if (!network_topology || locator::i_endpoint_snitch::get_local_snitch_ptr()->get_datacenter(view_endpoint) == my_datacenter) {
+        } else if (!info.network_topology || locator::i_endpoint_snitch::get_local_snitch_ptr()->get_datacenter(view_endpoint) == info.my_datacenter) {
             view_endpoints.push_back(view_endpoint);
         }
     }
 
     assert(base_endpoints.size() == view_endpoints.size());
-    auto base_it = std::find(base_endpoints.begin(), base_endpoints.end(), my_address);
+    auto base_it = std::find(base_endpoints.begin(), base_endpoints.end(), info.my_address);
     if (base_it == base_endpoints.end()) {
         // This node is not a base replica of this key, so we return empty
         return {};
@@ -1277,18 +1322,24 @@ future<> mutate_MV(
         wait_for_all_updates wait_for_all)
 {
     static constexpr size_t max_concurrent_updates = 128;
+    if (view_updates.empty()) {
+        co_return;
+    }
+    // All the views of a base table live in the base table's keyspace, so
+    // the routing info derived from the keyspace and the base token is the
+    // same for every update of this batch.
+    auto routing_info = make_view_update_routing_info(view_updates.front().s->ks_name(), base_token);
     co_await max_concurrent_for_each(view_updates, max_concurrent_updates,
-            [base_token, &stats, &cf_stats, tr_state, &pending_view_updates, allow_hints, wait_for_all] (frozen_mutation_and_schema mut) mutable -> future<> {
+            [base_token, &routing_info, &stats, &cf_stats, tr_state, &pending_view_updates, allow_hints, wait_for_all] (frozen_mutation_and_schema mut) mutable -> future<> {
         auto view_token = dht::get_token(*mut.s, mut.fm.key());
-        auto& keyspace_name = mut.s->ks_name();
-        auto target_endpoint = get_view_natural_endpoint(keyspace_name, base_token, view_token);
-        auto remote_endpoints = service::get_local_storage_proxy().get_token_metadata_ptr()->pending_endpoints_for(view_token, keyspace_name);
+        auto target_endpoint = get_view_natural_endpoint(routing_info, view_token);
+        auto remote_endpoints = routing_info.tm->pending_endpoints_for(view_token, routing_info.keyspace_name);
         auto sem_units = pending_view_updates.split(mut.fm.representation().size());
 
         // First, find the local endpoint and ensure that if it exists,
         // it will be the target endpoint. That way, all endpoints in the
         // remote_endpoints list are guaranteed to be remote.
-        auto my_address = utils::fb_utilities::get_broadcast_address();
+        auto my_address = routing_info.my_address;
         auto remote_it = std::find(remote_endpoints.begin(), remote_endpoints.end(), my_address);
         if (remote_it != remote_endpoints.end()) {
             if (!target_endpoint) {
@@ -1410,6 +1461,11 @@ void view_builder::setup_metrics() {
                 sm::description("Number of failed build steps."),
                 _stats.steps_failed),
 
+        sm::make_derive("base_rows_processed",
+                sm::description("Number of base table rows read and processed by the view builder."
+                                " The rate of this counter is the per-shard build throughput."),
+                _stats.base_rows_processed),
+
         sm::make_gauge("builds_in_progress",
                 sm::description("Number of currently active view builds."),
                 [this] { return _base_to_build_step.size(); })
@@ -1526,7 +1582,9 @@ future<> view_builder::initialize_reader_at_current_token(build_step& step) {
             _permit,
             step.prange,
             step.pslice,
-            default_priority_class(),
+            // The build scan is a long sequential read, akin to streaming;
+            // keep its I/O out of the query classes.
+            service::get_local_streaming_priority(),
             nullptr,
             streamed_mutation::forwarding::no,
             mutation_reader::forwarding::no);
@@ -1988,6 +2046,7 @@ public:
             return stop_iteration::yes;
         }
 
+        ++_builder._stats.base_rows_processed;
         _fragments_memory_usage += cr.memory_usage(*_step.reader.schema());
         _fragments.emplace_back(*_step.reader.schema(), _builder._permit, std::move(cr));
         if (_fragments_memory_usage > batch_memory_max) {
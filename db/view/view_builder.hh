@@ -125,6 +125,7 @@ class view_builder final : public service::migration_listener::only_view_notific
     struct stats {
         uint64_t steps_performed = 0;
         uint64_t steps_failed = 0;
+        uint64_t base_rows_processed = 0;
     };
 
     /**
@@ -191,7 +192,11 @@ public:
     // However, if the individual rows are large, there is no real need to
     // collect batch_size of them in memory at once. Rather, as soon as we've
     // collected batch_memory_max bytes, we can process the rows read so far.
-    static constexpr size_t batch_size = 128;
+    // Memory use is thus bounded by batch_memory_max regardless of
+    // batch_size, so the row count is sized for throughput: it amortizes the
+    // per-step bookkeeping (progress updates, reader switching) over a
+    // larger chunk of the base table.
+    static constexpr size_t batch_size = 1024;
     static constexpr size_t batch_memory_max = 1024*1024;
 
 public:
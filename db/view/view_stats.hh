@@ -32,6 +32,10 @@ struct stats : public service::storage_proxy_stats::write_stats {
     int64_t view_updates_pushed_remote = 0;
     int64_t view_updates_failed_local = 0;
     int64_t view_updates_failed_remote = 0;
+    // Bytes of generated view updates charged to the shared pending-update
+    // memory quota on behalf of this base table. The rate of this counter
+    // attributes view update backlog pressure to the table causing it.
+    int64_t view_update_backlog_added_bytes = 0;
     using label_instance = seastar::metrics::label_instance;
     stats(const sstring& category, label_instance ks_label, label_instance cf_label);
     void register_stats();
@@ -68,6 +68,27 @@ struct update_backlog {
     static update_backlog no_backlog() {
         return update_backlog{0, std::numeric_limits<size_t>::max()};
     }
+
+    /**
+     * Fold a fresh backlog sample into the previous estimate for a replica.
+     *
+     * Samples arrive in steps (piggy-backed on write responses or via
+     * gossip), and feeding them directly into the write-delay calculation
+     * makes the delay jump with them: the backlog drains, the delay
+     * collapses to zero, writes flood in and the backlog spikes again,
+     * producing periodic bursts of heavily throttled writes. Growth is
+     * followed immediately, since under-throttling risks running the
+     * replica out of its quota, but a drop only moves the estimate a
+     * quarter of the way towards the sample, so the delay relaxes as a
+     * smooth gradient instead of falling off a cliff.
+     */
+    static update_backlog controlled_update(update_backlog prev, update_backlog sample) {
+        if (sample >= prev) {
+            return sample;
+        }
+        float relative = prev.relative_size() * 0.75f + sample.relative_size() * 0.25f;
+        return update_backlog{size_t(relative * float(sample.max)), sample.max};
+    }
 };
 
 }
@@ -19,6 +19,7 @@
  * along with Scylla.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <seastar/core/future-util.hh>
 #include <seastar/util/defer.hh>
 #include <boost/range/adaptor/map.hpp>
 #include "view_update_generator.hh"
@@ -36,6 +37,73 @@ static inline void inject_failure(std::string_view operation) {
 
 namespace db::view {
 
+void view_update_generator::process_staging_batch(lw_shared_ptr<table> t, std::vector<sstables::shared_sstable> sstables) {
+    schema_ptr s = t->schema();
+
+    vug_logger.trace("Processing {}.{}: {} sstables", s->ks_name(), s->cf_name(), sstables.size());
+
+    const auto num_sstables = sstables.size();
+    uint64_t batch_bytes = 0;
+    for (auto& sst : sstables) {
+        batch_bytes += sst->bytes_on_disk();
+    }
+
+    try {
+        // Exploit the fact that sstables in the staging directory
+        // are usually non-overlapping and use a partitioned set for
+        // the read.
+        auto ssts = make_lw_shared<sstables::sstable_set>(sstables::make_partitioned_sstable_set(s, make_lw_shared<sstable_list>(sstable_list{}), false));
+        for (auto& sst : sstables) {
+            ssts->insert(sst);
+        }
+
+        auto permit = _db.obtain_reader_permit(*t, "view_update_generator", db::no_timeout).get0();
+        auto ms = mutation_source([this, ssts] (
+                    schema_ptr s,
+                    reader_permit permit,
+                    const dht::partition_range& pr,
+                    const query::partition_slice& ps,
+                    const io_priority_class& pc,
+                    tracing::trace_state_ptr ts,
+                    streamed_mutation::forwarding fwd_ms,
+                    mutation_reader::forwarding fwd_mr) {
+            return ssts->make_range_sstable_reader(s, std::move(permit), pr, ps, pc, std::move(ts), fwd_ms, fwd_mr);
+        });
+        auto [staging_sstable_reader, staging_sstable_reader_handle] = make_manually_paused_evictable_reader(
+                std::move(ms),
+                s,
+                permit,
+                query::full_partition_range,
+                s->full_slice(),
+                service::get_local_streaming_priority(),
+                nullptr,
+                ::mutation_reader::forwarding::no);
+
+        inject_failure("view_update_generator_consume_staging_sstable");
+        auto result = staging_sstable_reader.consume_in_thread(view_updating_consumer(s, std::move(permit), *t, sstables, _as, staging_sstable_reader_handle));
+        staging_sstable_reader.close().get();
+        if (result == stop_iteration::yes) {
+            return;
+        }
+    } catch (...) {
+        vug_logger.warn("Processing {} failed for table {}:{}. Will retry...", s->ks_name(), s->cf_name(), std::current_exception());
+        // Need to add sstables back to the set so we can retry later. By now it may
+        // have had other updates.
+        std::move(sstables.begin(), sstables.end(), std::back_inserter(_sstables_with_tables[t]));
+        return;
+    }
+    try {
+        inject_failure("view_update_generator_collect_consumed_sstables");
+        // collect all staging sstables to move in a map, grouped by table.
+        std::move(sstables.begin(), sstables.end(), std::back_inserter(_sstables_to_move[t]));
+    } catch (...) {
+        // Move from staging will be retried upon restart.
+        vug_logger.warn("Moving {} from staging failed: {}:{}. Ignoring...", s->ks_name(), s->cf_name(), std::current_exception());
+    }
+    _pending_sstables_bytes -= batch_bytes;
+    _registration_sem.signal(num_sstables);
+}
+
 future<> view_update_generator::start() {
     thread_attributes attr;
     attr.sched_group = _db.get_streaming_scheduling_group();
@@ -46,6 +114,7 @@ future<> view_update_generator::start() {
                     _sstables_to_move.size(), _sstables_with_tables.size());
             _sstables_to_move.clear();
             _sstables_with_tables.clear();
+            _pending_sstables_bytes = 0;
         });
         while (!_as.abort_requested()) {
             if (_sstables_with_tables.empty()) {
@@ -56,70 +125,43 @@ future<> view_update_generator::start() {
             // into a local variable.
             auto sstables_with_tables = std::exchange(_sstables_with_tables, {});
 
-            // If we got here, we will process all tables we know about so far eventually so there
-            // is no starvation
-            for (auto table_it = sstables_with_tables.begin(); table_it != sstables_with_tables.end(); table_it = sstables_with_tables.erase(table_it)) {
-                auto& [t, sstables] = *table_it;
+            // Split each table's sstables into batches covering disjoint
+            // token ranges: sort by first key and cut a new batch wherever
+            // the next sstable starts past everything seen so far. Batches
+            // of the same table then never overlap, and different tables are
+            // disjoint by definition, so the batches can be processed
+            // concurrently without generating updates for the same base rows.
+            struct staging_batch {
+                lw_shared_ptr<table> t;
+                std::vector<sstables::shared_sstable> sstables;
+            };
+            std::vector<staging_batch> batches;
+            for (auto& [t, sstables] : sstables_with_tables) {
                 schema_ptr s = t->schema();
-
-                vug_logger.trace("Processing {}.{}: {} sstables", s->ks_name(), s->cf_name(), sstables.size());
-
-                const auto num_sstables = sstables.size();
-
-                try {
-                    // Exploit the fact that sstables in the staging directory
-                    // are usually non-overlapping and use a partitioned set for
-                    // the read.
-                    auto ssts = make_lw_shared<sstables::sstable_set>(sstables::make_partitioned_sstable_set(s, make_lw_shared<sstable_list>(sstable_list{}), false));
-                    for (auto& sst : sstables) {
-                        ssts->insert(sst);
+                std::sort(sstables.begin(), sstables.end(), [&s] (const sstables::shared_sstable& a, const sstables::shared_sstable& b) {
+                    return a->get_first_decorated_key().tri_compare(*s, b->get_first_decorated_key()) < 0;
+                });
+                std::optional<dht::decorated_key> batch_last;
+                for (auto& sst : sstables) {
+                    if (!batch_last || batch_last->tri_compare(*s, sst->get_first_decorated_key()) < 0) {
+                        batches.push_back(staging_batch{t, {}});
                     }
-
-                    auto permit = _db.obtain_reader_permit(*t, "view_update_generator", db::no_timeout).get0();
-                    auto ms = mutation_source([this, ssts] (
-                                schema_ptr s,
-                                reader_permit permit,
-                                const dht::partition_range& pr,
-                                const query::partition_slice& ps,
-                                const io_priority_class& pc,
-                                tracing::trace_state_ptr ts,
-                                streamed_mutation::forwarding fwd_ms,
-                                mutation_reader::forwarding fwd_mr) {
-                        return ssts->make_range_sstable_reader(s, std::move(permit), pr, ps, pc, std::move(ts), fwd_ms, fwd_mr);
-                    });
-                    auto [staging_sstable_reader, staging_sstable_reader_handle] = make_manually_paused_evictable_reader(
-                            std::move(ms),
-                            s,
-                            permit,
-                            query::full_partition_range,
-                            s->full_slice(),
-                            service::get_local_streaming_priority(),
-                            nullptr,
-                            ::mutation_reader::forwarding::no);
-
-                    inject_failure("view_update_generator_consume_staging_sstable");
-                    auto result = staging_sstable_reader.consume_in_thread(view_updating_consumer(s, std::move(permit), *t, sstables, _as, staging_sstable_reader_handle));
-                    staging_sstable_reader.close().get();
-                    if (result == stop_iteration::yes) {
-                        break;
+                    if (!batch_last || batch_last->tri_compare(*s, sst->get_last_decorated_key()) < 0) {
+                        batch_last.emplace(sst->get_last_decorated_key());
                     }
-                } catch (...) {
-                    vug_logger.warn("Processing {} failed for table {}:{}. Will retry...", s->ks_name(), s->cf_name(), std::current_exception());
-                    // Need to add sstables back to the set so we can retry later. By now it may
-                    // have had other updates.
-                    std::move(sstables.begin(), sstables.end(), std::back_inserter(_sstables_with_tables[t]));
-                    break;
+                    batches.back().sstables.push_back(std::move(sst));
                 }
-                try {
-                    inject_failure("view_update_generator_collect_consumed_sstables");
-                    // collect all staging sstables to move in a map, grouped by table.
-                    std::move(sstables.begin(), sstables.end(), std::back_inserter(_sstables_to_move[t]));
-                } catch (...) {
-                    // Move from staging will be retried upon restart.
-                    vug_logger.warn("Moving {} from staging failed: {}:{}. Ignoring...", s->ks_name(), s->cf_name(), std::current_exception());
-                }
-                _registration_sem.signal(num_sstables);
             }
+            sstables_with_tables.clear();
+
+            // If we got here, we will process all batches we know about so far
+            // eventually so there is no starvation. Failed batches re-register
+            // their sstables and don't prevent the others from making progress.
+            max_concurrent_for_each(batches, processing_concurrency, [this] (staging_batch& batch) {
+                return seastar::async([this, &batch] {
+                    process_staging_batch(std::move(batch.t), std::move(batch.sstables));
+                });
+            }).get();
             // For each table, move the processed staging sstables into the table's base dir.
             for (auto it = _sstables_to_move.begin(); it != _sstables_to_move.end(); ) {
                 auto& [t, sstables] = *it;
@@ -154,6 +196,7 @@ future<> view_update_generator::register_staging_sstable(sstables::shared_sstabl
         return make_ready_future<>();
     }
     inject_failure("view_update_generator_registering_staging_sstable");
+    _pending_sstables_bytes += sst->bytes_on_disk();
     _sstables_with_tables[table].push_back(std::move(sst));
 
     _pending_sstables.signal();
@@ -178,7 +221,11 @@ void view_update_generator::setup_metrics() {
 
         sm::make_gauge("sstables_to_move_count",
                 sm::description("Number of sets of sstables which are already processed and wait to be moved from their staging directory"),
-                [this] { return _sstables_to_move.size(); })
+                [this] { return _sstables_to_move.size(); }),
+
+        sm::make_gauge("sstables_pending_work",
+                sm::description("Number of bytes remaining to be processed from SSTables for view updates"),
+                [this] { return _pending_sstables_bytes; })
     });
 }
 
@@ -187,6 +234,7 @@ void view_update_generator::discover_staging_sstables() {
         table& t = *(x.second);
         for (auto sstables = t.get_sstables(); sstables::shared_sstable sst : *sstables) {
             if (sst->requires_view_building()) {
+                _pending_sstables_bytes += sst->bytes_on_disk();
                 _sstables_with_tables[t.shared_from_this()].push_back(std::move(sst));
                 // we're at early stage here, no need to kick _pending_sstables (the
                 // bulding fiber is not running), neither we can wait on the semaphore
@@ -33,6 +33,10 @@ namespace db::view {
 class view_update_generator {
 public:
     static constexpr size_t registration_queue_size = 5;
+    // How many staging sstable batches may be processed concurrently. Batches
+    // cover disjoint token ranges (or distinct tables), so they never generate
+    // updates for the same base rows.
+    static constexpr size_t processing_concurrency = 4;
 
 private:
     database& _db;
@@ -42,6 +46,9 @@ private:
     named_semaphore _registration_sem{registration_queue_size, named_semaphore_exception_factory{"view update generator"}};
     std::unordered_map<lw_shared_ptr<table>, std::vector<sstables::shared_sstable>> _sstables_with_tables;
     std::unordered_map<lw_shared_ptr<table>, std::vector<sstables::shared_sstable>> _sstables_to_move;
+    // Total on-disk size of the staging sstables registered but not yet
+    // processed. Exported as a metric so the staging backlog can be alerted on.
+    uint64_t _pending_sstables_bytes = 0;
     metrics::metric_groups _metrics;
 public:
     view_update_generator(database& db) : _db(db) {
@@ -58,6 +65,9 @@ private:
     bool should_throttle() const;
     void setup_metrics();
     void discover_staging_sstables();
+    // Generates view updates for one batch of staging sstables belonging to
+    // the given table. Must be called from inside a seastar thread.
+    void process_staging_batch(lw_shared_ptr<table> t, std::vector<sstables::shared_sstable> sstables);
 };
 
 }
@@ -62,6 +62,14 @@ bool virtual_table::contains_key(const dht::partition_range& pr, const dht::deco
     return pr.contains(dk, dht::ring_position_comparator(*_s));
 }
 
+bool virtual_table::contains_row(const query::partition_slice& slice, const partition_key& pk, const clustering_key& ck) const {
+    auto cmp = clustering_key_prefix::prefix_equal_tri_compare(*_s);
+    const auto& ranges = slice.row_ranges(*_s, pk);
+    return std::any_of(ranges.begin(), ranges.end(), [&] (const query::clustering_range& r) {
+        return r.contains(ck, cmp);
+    });
+}
+
 mutation_source memtable_filling_virtual_table::as_mutation_source() {
     return mutation_source([this] (schema_ptr s,
         reader_permit permit,
@@ -92,9 +100,9 @@ mutation_source memtable_filling_virtual_table::as_mutation_source() {
                 auto rd = mt->as_data_source().make_reader_v2(s, units->units.permit(), range, slice, pc, trace_state, fwd, fwd_mr);
 
                 if (!_shard_aware) {
-                    rd = upgrade_to_v2(make_filtering_reader(downgrade_to_v1(std::move(rd)), [this] (const dht::decorated_key& dk) -> bool {
+                    rd = make_filtering_reader_v2(std::move(rd), [this] (const dht::decorated_key& dk) -> bool {
                         return this_shard_owns(dk);
-                    }));
+                    });
                 }
 
                 return rd;
@@ -135,12 +143,14 @@ mutation_source streaming_virtual_table::as_mutation_source() {
             // Valid until handle.is_terminated(), which is set to true when the
             // queue_reader dies.
             const dht::partition_range* pr;
+            const query::partition_slice* ps;
             mutation_reader::forwarding fwd_mr;
 
-            my_result_collector(schema_ptr s, reader_permit p, const dht::partition_range* pr, queue_reader_handle&& handle)
+            my_result_collector(schema_ptr s, reader_permit p, const dht::partition_range* pr, const query::partition_slice* ps, queue_reader_handle&& handle)
                 : result_collector(s, p)
                 , handle(std::move(handle))
                 , pr(pr)
+                , ps(ps)
             { }
 
             // result_collector
@@ -155,10 +165,17 @@ mutation_source streaming_virtual_table::as_mutation_source() {
                 }
                 return *pr;
             }
+
+            const query::partition_slice& slice() const override {
+                if (handle.is_terminated()) {
+                    throw std::runtime_error("read abandoned");
+                }
+                return *ps;
+            }
         };
 
         auto reader_and_handle = make_queue_reader(s, permit);
-        auto consumer = std::make_unique<my_result_collector>(s, permit, &pr, std::move(reader_and_handle.second));
+        auto consumer = std::make_unique<my_result_collector>(s, permit, &pr, &slice, std::move(reader_and_handle.second));
         auto f = execute(permit, *consumer, *consumer);
 
         // It is safe to discard this future because:
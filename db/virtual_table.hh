@@ -42,12 +42,18 @@ protected: // opt-ins
 protected:
     void set_cell(row&, const bytes& column_name, data_value);
     bool contains_key(const dht::partition_range&, const dht::decorated_key&) const;
+    // Returns true iff rows with the given clustering key in the given
+    // partition are selected by the slice.
+    bool contains_row(const query::partition_slice&, const partition_key&, const clustering_key&) const;
     bool this_shard_owns(const dht::decorated_key&) const;
 
 public:
     class query_restrictions {
     public:
         virtual const dht::partition_range& partition_range() const = 0;
+        // The clustering restrictions of the query, in the natural order of
+        // the table's keys (also for reversed queries).
+        virtual const query::partition_slice& slice() const = 0;
     };
 
     explicit virtual_table(schema_ptr s) : _s(std::move(s)) {}
@@ -114,6 +120,14 @@ public: // helpers
 //
 //  - avoid emitting partitions which fall outside result_collector::partition_range().
 //
+//  - avoid emitting rows which fall outside the clustering restrictions of
+//    query_restrictions::slice(); contains_row() does the check.
+//
+// Production is driven by demand: take() returns a non-ready future when the
+// reader's buffer is full, and once the query has enough rows for its page
+// the reader is dropped and the producer is aborted on the next emission.
+// Together with the skips above this lets tables over large datasets serve
+// paged queries without materializing more than a page's worth of rows.
 class streaming_virtual_table : public virtual_table {
 public:
     using virtual_table::virtual_table;
@@ -54,6 +54,16 @@ sharder::token_for_next_shard(const token& t, shard_id shard, unsigned spans) co
     return dht::token_for_next_shard(_shard_start, _shard_count, _sharding_ignore_msb_bits, t, shard, spans);
 }
 
+std::vector<token>
+i_partitioner::get_tokens(const schema& s, const std::vector<partition_key>& keys) const {
+    std::vector<token> tokens;
+    tokens.reserve(keys.size());
+    for (const auto& key : keys) {
+        tokens.push_back(get_token(s, key));
+    }
+    return tokens;
+}
+
 std::ostream& operator<<(std::ostream& out, const decorated_key& dk) {
     return out << "{key: " << dk._key << ", token:" << dk._token << "}";
 }
@@ -179,6 +179,13 @@ public:
     virtual token get_token(const schema& s, partition_key_view key) const = 0;
     virtual token get_token(const sstables::key_view& key) const = 0;
 
+    /**
+     * Computes the tokens of a batch of keys. Equivalent to calling
+     * get_token() on each key in turn, but allows the partitioner to hash
+     * several keys in parallel.
+     */
+    virtual std::vector<token> get_tokens(const schema& s, const std::vector<partition_key>& keys) const;
+
     // FIXME: token.tokenFactory
     //virtual token.tokenFactory gettokenFactory() = 0;
 
@@ -58,6 +58,35 @@ murmur3_partitioner::get_token(const schema& s, partition_key_view key) const {
     return get_token(hash[0]);
 }
 
+std::vector<token>
+murmur3_partitioner::get_tokens(const schema& s, const std::vector<partition_key>& keys) const {
+    std::vector<token> tokens;
+    tokens.reserve(keys.size());
+    // The legacy form is exposed through input iterators; linearize four
+    // keys at a time so the interleaved hash can load 64-bit blocks
+    // directly.
+    std::array<bytes, 4> linearized;
+    std::array<bytes_view, 4> views;
+    std::array<std::array<uint64_t, 2>, 4> hashes;
+    size_t i = 0;
+    for (; i + 4 <= keys.size(); i += 4) {
+        for (size_t lane = 0; lane < 4; lane++) {
+            auto&& legacy = keys[i + lane].legacy_form(s);
+            linearized[lane] = bytes(bytes::initialized_later(), legacy.size());
+            std::copy(legacy.begin(), legacy.end(), linearized[lane].begin());
+            views[lane] = linearized[lane];
+        }
+        utils::murmur_hash::hash3_x64_128_x4(views, 0, hashes);
+        for (size_t lane = 0; lane < 4; lane++) {
+            tokens.push_back(get_token(hashes[lane][0]));
+        }
+    }
+    for (; i < keys.size(); i++) {
+        tokens.push_back(get_token(s, keys[i]));
+    }
+    return tokens;
+}
+
 using registry = class_registrator<i_partitioner, murmur3_partitioner>;
 static registry registrator("org.apache.cassandra.dht.Murmur3Partitioner");
 static registry registrator_short_name("Murmur3Partitioner");
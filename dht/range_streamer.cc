@@ -62,10 +62,19 @@ range_streamer::get_range_fetch_map(const std::unordered_map<dht::token_range, s
                                     const std::unordered_set<std::unique_ptr<i_source_filter>>& source_filters,
                                     const sstring& keyspace) {
     std::unordered_map<inet_address, dht::token_range_vector> range_fetch_map_map;
+    // Number of ranges assigned to each source so far. Candidate lists are
+    // sorted by proximity, so among the acceptable candidates we pick the
+    // least loaded one instead of always the first - otherwise the nearest
+    // replica ends up serving most of the ranges while equivalent replicas
+    // idle. Ranges are vnode sized, so their count is the best available
+    // proxy for bytes; this node does not hold the data yet, so it has no
+    // size estimates to weigh them with.
+    std::unordered_map<inet_address, size_t> load;
     for (auto x : ranges_with_sources) {
         const dht::token_range& range_ = x.first;
         const std::vector<inet_address>& addresses = x.second;
         bool found_source = false;
+        std::optional<inet_address> best;
         for (auto address : addresses) {
             if (address == utils::fb_utilities::get_broadcast_address()) {
                 // If localhost is a source, we have found one, but we don't add it to the map to avoid streaming locally
@@ -86,9 +95,15 @@ range_streamer::get_range_fetch_map(const std::unordered_map<dht::token_range, s
                 continue;
             }
 
-            range_fetch_map_map[address].push_back(range_);
             found_source = true;
-            break; // ensure we only stream from one other node for each range
+            if (!best || load[address] < load[*best]) {
+                best = address;
+            }
+        }
+
+        if (best) {
+            range_fetch_map_map[*best].push_back(range_);
+            load[*best]++;
         }
 
         if (!found_source) {
@@ -105,6 +120,13 @@ range_streamer::get_range_fetch_map(const std::unordered_map<dht::token_range, s
         }
     }
 
+    // Adjacent and overlapping ranges assigned to the same source collapse
+    // into one entry, so they go through a single stream session instead of
+    // one per vnode range.
+    for (auto& [source, ranges] : range_fetch_map_map) {
+        ranges = dht::token_range::deoverlap(std::move(ranges), dht::token_comparator());
+    }
+
     return range_fetch_map_map;
 }
 
@@ -157,11 +179,12 @@ range_streamer::get_all_ranges_with_strict_sources_for(const sstring& keyspace_n
     auto& strat = ks.get_replication_strategy();
     auto erm = ks.get_effective_replication_map();
 
-    //Active ranges
-    auto metadata_clone = get_token_metadata().clone_only_token_map().get0();
-    auto range_addresses = strat.get_range_addresses(metadata_clone).get0();
+    //Active ranges, computed on our immutable token_metadata snapshot
+    auto range_addresses = strat.get_range_addresses(get_token_metadata()).get0();
 
-    //Pending ranges
+    //Pending ranges: cloned so the prospective tokens can be added without
+    //touching the published snapshot
+    auto metadata_clone = get_token_metadata().clone_only_token_map().get0();
     metadata_clone.update_normal_tokens(_tokens, _address).get();
     auto pending_range_addresses  = strat.get_range_addresses(metadata_clone).get0();
     metadata_clone.clear_gently().get();
@@ -270,6 +293,10 @@ future<> range_streamer::add_ranges(const sstring& keyspace_name, dht::token_ran
 
     std::unordered_map<inet_address, dht::token_range_vector> range_fetch_map = get_range_fetch_map(ranges_for_keyspace, _source_filters, keyspace_name);
 
+    // Remember the candidate lists for mid-stream failover; see
+    // reassign_ranges_of_failed_sources().
+    _sources_for_range[keyspace_name] = std::move(ranges_for_keyspace);
+
     if (logger.is_enabled(logging::log_level::debug)) {
         for (auto& x : range_fetch_map) {
             logger.debug("{} : keyspace={}, ranges={} from source={}, range_size={}", _description, keyspace_name, x.second, x.first, x.second.size());
@@ -288,6 +315,7 @@ future<> range_streamer::stream_async() {
                 break;
             } catch (...) {
                 logger.warn("{} failed to stream. Will retry in {} seconds ...", _description, sleep_time);
+                reassign_ranges_of_failed_sources();
                 sleep_abortable(std::chrono::seconds(sleep_time), _abort_source).get();
                 sleep_time *= 1.5;
                 if (++_nr_retried >= _nr_max_retry) {
@@ -302,7 +330,12 @@ future<> range_streamer::do_stream_async() {
     auto nr_ranges_remaining = nr_ranges_to_stream();
     logger.info("{} starts, nr_ranges_remaining={}", _description, nr_ranges_remaining);
     auto start = lowres_clock::now();
-    return do_for_each(_to_stream, [this, start, description = _description] (auto& stream) {
+    // Stream independent keyspaces in parallel, so that a cluster with many
+    // small keyspaces does not pay the session setup latency once per
+    // keyspace in sequence. The number of concurrent node-sessions across
+    // all keyspaces is capped by _limiter and the memory used by in-flight
+    // mutations is capped globally by stream_manager::mutation_send_limiter.
+    return parallel_for_each(_to_stream, [this, start, description = _description] (auto& stream) {
         const auto& keyspace = stream.first;
         auto& ip_range_vec = stream.second;
         auto ips = boost::copy_range<std::list<inet_address>>(ip_range_vec | boost::adaptors::map_keys);
@@ -354,6 +387,7 @@ future<> range_streamer::do_stream_async() {
                     for (auto& range : ranges_to_stream) {
                         range_vec.push_back(range);
                     }
+                    _failed_sources.insert(source);
                     auto t = std::chrono::duration_cast<std::chrono::duration<float>>(lowres_clock::now() - start_time).count();
                     logger.warn("{} with {} for keyspace={} failed, took {} seconds: {}", description, source, keyspace, t, std::current_exception());
                     throw;
@@ -362,6 +396,8 @@ future<> range_streamer::do_stream_async() {
                 logger.info("{} with {} for keyspace={} succeeded, took {} seconds", description, source, keyspace, t);
               });
           });
+        }).then([this, description, keyspace] {
+            logger.info("{} for keyspace={} finished, nr_ranges_remaining={}", description, keyspace, nr_ranges_to_stream());
         });
     }).finally([this, start] {
         auto t = std::chrono::duration_cast<std::chrono::seconds>(lowres_clock::now() - start).count();
@@ -374,6 +410,65 @@ future<> range_streamer::do_stream_async() {
     });
 }
 
+void range_streamer::reassign_ranges_of_failed_sources() {
+    if (_failed_sources.empty()) {
+        return;
+    }
+    auto failed = std::exchange(_failed_sources, {});
+    auto acceptable = [&] (inet_address address) {
+        if (address == utils::fb_utilities::get_broadcast_address() || failed.contains(address)) {
+            return false;
+        }
+        return std::all_of(_source_filters.begin(), _source_filters.end(), [&] (const auto& filter) {
+            return filter->should_include(address);
+        });
+    };
+    for (auto& [keyspace, ip_range_vec] : _to_stream) {
+        auto sources_it = _sources_for_range.find(keyspace);
+        if (sources_it == _sources_for_range.end()) {
+            // Added through add_tx_ranges()/add_rx_ranges(); no alternative
+            // candidates are known, retry against the original source.
+            continue;
+        }
+        std::unordered_map<inet_address, dht::token_range_vector> moved;
+        for (auto& [source, range_vec] : ip_range_vec) {
+            if (!failed.contains(source) || range_vec.empty()) {
+                continue;
+            }
+            dht::token_range_vector keep;
+            for (auto& range : range_vec) {
+                // The range may be a merge of several originally assigned
+                // ranges with different candidate lists; fail each original
+                // range it covers over on its own.
+                bool decomposed = false;
+                for (auto& [orig_range, candidates] : sources_it->second) {
+                    if (!range.contains(orig_range, dht::tri_compare)) {
+                        continue;
+                    }
+                    decomposed = true;
+                    auto alt = std::find_if(candidates.begin(), candidates.end(), acceptable);
+                    if (alt != candidates.end()) {
+                        logger.info("{} : failing over range {} for keyspace={} from {} to {}",
+                                _description, orig_range, keyspace, source, *alt);
+                        moved[*alt].push_back(orig_range);
+                    } else {
+                        keep.push_back(orig_range);
+                    }
+                }
+                if (!decomposed) {
+                    keep.push_back(range);
+                }
+            }
+            range_vec = std::move(keep);
+        }
+        for (auto& [alt, ranges] : moved) {
+            auto& range_vec = ip_range_vec[alt];
+            std::move(ranges.begin(), ranges.end(), std::back_inserter(range_vec));
+            range_vec = dht::token_range::deoverlap(std::move(range_vec), dht::token_comparator());
+        }
+    }
+}
+
 size_t range_streamer::nr_ranges_to_stream() {
     size_t nr_ranges_remaining = 0;
     for (auto& fetch : _to_stream) {
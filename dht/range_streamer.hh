@@ -165,6 +165,10 @@ private:
     const token_metadata& get_token_metadata() {
         return *_token_metadata_ptr;
     }
+    // Moves the not-yet-streamed ranges of sources which failed in the last
+    // attempt to an alternative candidate source, where one exists. Called
+    // between stream_async() retries; completed ranges are not touched.
+    void reassign_ranges_of_failed_sources();
 public:
     future<> stream_async();
     future<> do_stream_async();
@@ -179,6 +183,12 @@ private:
     sstring _description;
     streaming::stream_reason _reason;
     std::unordered_multimap<sstring, std::unordered_map<inet_address, dht::token_range_vector>> _to_stream;
+    // The full candidate source lists of the ranges added with add_ranges(),
+    // in proximity order. Kept so that ranges still pending on a failed
+    // source can be failed over to an alternative replica between retries.
+    std::unordered_map<sstring, std::unordered_map<dht::token_range, std::vector<inet_address>>> _sources_for_range;
+    // Sources whose stream sessions failed in the current attempt.
+    std::unordered_set<inet_address> _failed_sources;
     std::unordered_set<std::unique_ptr<i_source_filter>> _source_filters;
     // Retry the stream plan _nr_max_retry times
     unsigned _nr_retried = 0;
@@ -24,8 +24,10 @@
 #include <boost/intrusive/parent_from_member.hpp>
 #include <seastar/core/condition-variable.hh>
 #include <seastar/core/future.hh>
+#include <seastar/core/lowres_clock.hh>
 #include <seastar/core/metrics_registration.hh>
 #include <seastar/core/semaphore.hh>
+#include <seastar/core/timer.hh>
 #include "database_fwd.hh"
 #include "utils/logalloc.hh"
 
@@ -102,13 +104,31 @@ class dirty_memory_manager: public logalloc::region_group_reclaimer {
     condition_variable _should_flush;
     int64_t _dirty_bytes_released_pre_accounted = 0;
 
+    // Rate controller state. The static soft limit alone reacts too late to
+    // ingest bursts: by the time the limit is crossed, the flush that it
+    // kicks off may not complete before dirty memory hits the hard limit and
+    // writes stall. We therefore periodically sample the write bandwidth
+    // into memtables and the flush bandwidth out, and start flushing as soon
+    // as the projected dirty growth over one flush cycle would exhaust the
+    // remaining headroom. Rates are EWMA-smoothed bytes per second.
+    static constexpr std::chrono::milliseconds _rate_sample_period{100};
+    timer<lowres_clock> _rate_sampler;
+    // Monotonic count of bytes released by flushing, for rate sampling.
+    uint64_t _dirty_bytes_flushed_total = 0;
+    uint64_t _last_sampled_flushed_total = 0;
+    size_t _last_sampled_virtual_dirty = 0;
+    double _ingest_rate = 0;
+    double _flush_rate = 0;
+
+    void update_rates();
+
     future<> flush_when_needed();
 
     future<> _waiting_flush;
     virtual void start_reclaiming() noexcept override;
 
     bool has_pressure() const {
-        return over_soft_limit();
+        return over_soft_limit() || predicted_hard_limit_headroom() <= 0;
     }
 
     unsigned _extraneous_flushes = 0;
@@ -158,7 +178,10 @@ public:
         , _real_region_group("memtable", _real_dirty_reclaimer, deferred_work_sg)
         , _virtual_region_group("memtable (virtual)", &_real_region_group, *this, deferred_work_sg)
         , _flush_serializer(1)
-        , _waiting_flush(flush_when_needed()) {}
+        , _waiting_flush(flush_when_needed()) {
+        _rate_sampler.set_callback([this] { update_rates(); });
+        _rate_sampler.arm_periodic(_rate_sample_period);
+    }
 
     dirty_memory_manager() : logalloc::region_group_reclaimer()
         , _db(nullptr)
@@ -189,6 +212,7 @@ public:
         _real_region_group.update(delta);
         _virtual_region_group.update(-delta);
         _dirty_bytes_released_pre_accounted += delta;
+        _dirty_bytes_flushed_total += delta;
     }
 
     void pin_real_dirty_memory(int64_t delta) {
@@ -207,6 +231,36 @@ public:
         return _virtual_region_group.memory_used();
     }
 
+    // Headroom until the hard limit, in bytes.
+    ssize_t hard_limit_headroom() const {
+        return ssize_t(throttle_threshold()) - ssize_t(virtual_dirty_memory());
+    }
+
+    // Headroom until the hard limit predicted at the end of one flush cycle,
+    // assuming the current ingest and flush bandwidths hold. May be negative.
+    // While no flush bandwidth has been observed yet the projection degrades
+    // to the actual headroom and flushing is governed by the soft limit alone.
+    ssize_t predicted_hard_limit_headroom() const {
+        auto headroom = hard_limit_headroom();
+        double net_growth = _ingest_rate - _flush_rate;
+        if (net_growth <= 0 || _flush_rate <= 0) {
+            return headroom;
+        }
+        // Time to drain the current dirty set at the current flush bandwidth.
+        // A flush started now completes within this horizon, so if net growth
+        // over it stays within the headroom, the hard limit is never reached.
+        double flush_horizon = virtual_dirty_memory() / _flush_rate;
+        return headroom - ssize_t(net_growth * flush_horizon);
+    }
+
+    uint64_t ingest_bandwidth() const {
+        return uint64_t(_ingest_rate);
+    }
+
+    uint64_t flush_bandwidth() const {
+        return uint64_t(_flush_rate);
+    }
+
     future<> flush_one(memtable_list& cf, flush_permit&& permit);
 
     future<flush_permit> get_flush_permit() {
@@ -39,6 +39,7 @@
 #include <unordered_map>
 #include <boost/range/adaptor/map.hpp>
 #include <boost/range/algorithm/min_element.hpp>
+#include <boost/range/irange.hpp>
 #include "db/view/view_update_generator.hh"
 #include "utils/directories.hh"
 
@@ -95,15 +96,81 @@ public:
     }
 };
 
+// The scan assigns SSTables to shards by generation number. That is cheap and usually comes out
+// even, but some directories are heavily skewed - e.g. after an import from a node with a
+// different shard count, or when populated by a single-shard writer - and then the one shard
+// opening most of the SSTables gates the whole boot. Opening doesn't have to happen on the shard
+// that owns an SSTable: one opened elsewhere is routed to its owner through
+// move_foreign_sstables() like any other foreign SSTable. So before the opening starts, hand off
+// descriptors from overloaded shards to underloaded ones until everyone opens about the same
+// amount.
+static future<>
+distribute_pending_sstables(sharded<sstables::sstable_directory>& dir) {
+    struct handoff {
+        unsigned from;
+        unsigned to;
+        size_t count;
+    };
+    return do_with(std::vector<size_t>(smp::count), [&dir] (std::vector<size_t>& counts) {
+        return parallel_for_each(boost::irange(0u, smp::count), [&dir, &counts] (unsigned shard) {
+            return dir.invoke_on(shard, std::mem_fn(&sstables::sstable_directory::pending_sstable_count)).then([&counts, shard] (size_t count) {
+                counts[shard] = count;
+            });
+        }).then([&counts] {
+            return make_ready_future<std::vector<size_t>>(std::move(counts));
+        });
+    }).then([&dir] (std::vector<size_t> counts) {
+        auto total = boost::accumulate(counts, size_t(0));
+        auto target = (total + smp::count - 1) / smp::count;
+        std::vector<handoff> plan;
+        unsigned to = 0;
+        for (unsigned from = 0; from < smp::count; ++from) {
+            while (counts[from] > target && to < smp::count) {
+                if (to == from || counts[to] >= target) {
+                    ++to;
+                    continue;
+                }
+                auto count = std::min(counts[from] - target, target - counts[to]);
+                counts[from] -= count;
+                counts[to] += count;
+                plan.push_back(handoff{from, to, count});
+            }
+        }
+        return do_with(std::move(plan), [&dir] (std::vector<handoff>& plan) {
+            return parallel_for_each(plan, [&dir] (const handoff& h) {
+                dblog.debug("Handing off {} SSTable descriptors from shard {} to shard {}", h.count, h.from, h.to);
+                return dir.invoke_on(h.from, [count = h.count] (sstables::sstable_directory& d) {
+                    return d.release_pending_sstables(count);
+                }).then([&dir, to = h.to] (sstables::sstable_directory::scan_descriptors descs) {
+                    return dir.invoke_on(to, [descs = std::move(descs)] (sstables::sstable_directory& d) mutable {
+                        return d.add_pending_sstables(std::move(descs));
+                    });
+                });
+            });
+        });
+    });
+}
+
 future<>
 distributed_loader::process_sstable_dir(sharded<sstables::sstable_directory>& dir, bool sort_sstables_according_to_owner) {
     return dir.invoke_on(0, [] (const sstables::sstable_directory& d) {
         return utils::directories::verify_owner_and_mode(d.sstable_dir());
-    }).then([&dir, sort_sstables_according_to_owner] {
-      return dir.invoke_on_all([&dir, sort_sstables_according_to_owner] (sstables::sstable_directory& d) {
+    }).then([&dir] {
+      return dir.invoke_on_all([] (sstables::sstable_directory& d) {
         // Supposed to be called with the node either down or on behalf of maintenance tasks
         // like nodetool refresh
-        return d.process_sstable_dir(service::get_local_streaming_priority(), sort_sstables_according_to_owner).then([&dir, &d] {
+        return d.scan_sstable_dir();
+      });
+    }).then([&dir, sort_sstables_according_to_owner] {
+        if (!sort_sstables_according_to_owner) {
+            // The unsorted flavour returns each SSTable object on the shard that opened it, so
+            // the opening work has to stay where the scan assigned it.
+            return make_ready_future<>();
+        }
+        return distribute_pending_sstables(dir);
+    }).then([&dir, sort_sstables_according_to_owner] {
+      return dir.invoke_on_all([&dir, sort_sstables_according_to_owner] (sstables::sstable_directory& d) {
+        return d.process_pending_sstables(service::get_local_streaming_priority(), sort_sstables_according_to_owner).then([&dir, &d] {
             return d.move_foreign_sstables(dir);
         });
       });
@@ -368,6 +368,24 @@ public:
             return std::exchange(_buffer, tracked_buffer(tracking_allocator<mutation_fragment>(_permit)));
         }
 
+        // Release the buffer's excess capacity.
+        //
+        // The buffer is reallocated to fit just the currently buffered
+        // fragments, giving the slack it accumulated while being (re)filled
+        // back to the reader's permit. Useful when the reader is going to be
+        // parked for an extended period of time, e.g. when cached between
+        // pages.
+        void shrink_buffer() {
+            if (_buffer.empty()) {
+                _buffer = tracked_buffer(tracking_allocator<mutation_fragment>(_permit));
+                return;
+            }
+            tracked_buffer new_buffer(tracking_allocator<mutation_fragment>(_permit));
+            new_buffer.reserve(_buffer.size());
+            std::move(_buffer.begin(), _buffer.end(), std::back_inserter(new_buffer));
+            _buffer = std::move(new_buffer);
+        }
+
         void move_buffer_content_to(impl& other) {
             if (other._buffer.empty()) {
                 std::swap(_buffer, other._buffer);
@@ -618,6 +636,11 @@ public:
     tracked_buffer detach_buffer() noexcept {
         return _impl->detach_buffer();
     }
+    // Release the buffer's excess capacity, keeping its content.
+    // See flat_mutation_reader::impl::shrink_buffer().
+    void shrink_buffer() {
+        _impl->shrink_buffer();
+    }
     // Moves the buffer content to `other`.
     //
     // If the buffer of `other` is empty this is very efficient as the buffers
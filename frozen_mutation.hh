@@ -59,6 +59,11 @@ public:
     frozen_mutation& operator=(frozen_mutation&&) = default;
     frozen_mutation& operator=(const frozen_mutation&) = default;
     const bytes_ostream& representation() const { return _bytes; }
+
+    future<> clear_gently() noexcept {
+        return _bytes.clear_gently();
+    }
+
     utils::UUID column_family_id() const;
     utils::UUID schema_version() const; // FIXME: Should replace column_family_id()
     partition_key_view key() const;
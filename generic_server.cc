@@ -143,6 +143,14 @@ server::listen(socket_address addr, std::shared_ptr<seastar::tls::credentials_bu
         listen_options lo;
         lo.reuse_address = true;
         if (is_shard_aware) {
+            // Shard-aware clients compute the shard owning their data and
+            // connect to a port derived from it; routing the connection by
+            // destination port lands it directly on that shard, with no
+            // cross-shard forwarding of the accepted socket. How the
+            // listening sockets themselves are set up (per-shard
+            // SO_REUSEPORT sockets, and steering the kernel's socket choice
+            // to the CPU that runs the owning shard) is seastar's business -
+            // all we choose here is the balancing algorithm.
             lo.lba = server_socket::load_balancing_algorithm::port;
         }
         server_socket ss;
@@ -78,6 +78,10 @@ double arrival_window::mean() const {
     return _arrival_intervals.mean();
 }
 
+double arrival_window::variance() const {
+    return _arrival_intervals.variance();
+}
+
 double arrival_window::phi(clk::time_point tnow) {
     assert(_arrival_intervals.size() > 0 && _tlast > clk::time_point::min()); // should not be called before any samples arrive
     auto t = (tnow - _tlast).count();
@@ -89,8 +93,8 @@ double arrival_window::phi(clk::time_point tnow) {
 }
 
 std::ostream& operator<<(std::ostream& os, const arrival_window& w) {
-    for (auto& x : w._arrival_intervals.deque()) {
-        os << x << " ";
+    for (size_t i = 0; i < w._arrival_intervals.size(); i++) {
+        os << w._arrival_intervals[i] << " ";
     }
     return os;
 }
@@ -145,7 +149,7 @@ void failure_detector::interpret(inet_address ep) {
 
     if (PHI_FACTOR * phi > get_phi_convict_threshold()) {
         logger.trace("failure_detector: notifying listeners that {} is down", ep);
-        logger.trace("failure_detector: intervals: {} mean: {}", hb_wnd, hb_wnd.mean());
+        logger.trace("failure_detector: intervals: {} mean: {} stddev: {}", hb_wnd, hb_wnd.mean(), std::sqrt(hb_wnd.variance()));
         for (auto& listener : _fd_evnt_listeners) {
             logger.debug("failure_detector: convict ep={} phi={}", ep, phi);
             listener->convict(ep, phi);
@@ -41,7 +41,7 @@
 #include <seastar/core/sstring.hh>
 #include <seastar/core/shared_ptr.hh>
 #include <seastar/core/distributed.hh>
-#include "utils/bounded_stats_deque.hh"
+#include "utils/bounded_stats_ring.hh"
 #include <iosfwd>
 #include <cmath>
 #include <list>
@@ -60,7 +60,7 @@ public:
     using clk = seastar::lowres_system_clock;
 private:
     clk::time_point _tlast{clk::time_point::min()};
-    utils::bounded_stats_deque _arrival_intervals;
+    utils::bounded_stats_ring _arrival_intervals;
     std::chrono::milliseconds _initial;
     std::chrono::milliseconds _max_interval;
     std::chrono::milliseconds _min_interval;
@@ -72,7 +72,7 @@ private:
     static constexpr double PHI_FACTOR{M_LOG10El};
 
 public:
-    arrival_window(int size, std::chrono::milliseconds initial,
+    arrival_window(size_t size, std::chrono::milliseconds initial,
             std::chrono::milliseconds max_interval, std::chrono::milliseconds min_interval)
         : _arrival_intervals(size)
         , _initial(initial)
@@ -84,6 +84,8 @@ public:
 
     double mean() const;
 
+    double variance() const;
+
     // see CASSANDRA-2597 for an explanation of the math at work here.
     double phi(clk::time_point tnow);
 
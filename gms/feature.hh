@@ -148,6 +148,9 @@ extern const std::string_view ALTERNATOR_TTL;
 extern const std::string_view RANGE_SCAN_DATA_VARIANT;
 extern const std::string_view CDC_GENERATIONS_V2;
 extern const std::string_view UDA;
+extern const std::string_view HINTED_HANDOFF_BATCHED_MUTATIONS;
+extern const std::string_view COALESCED_MUTATIONS;
+extern const std::string_view FILE_BASED_STREAMING;
 
 }
 
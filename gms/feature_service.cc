@@ -73,6 +73,9 @@ constexpr std::string_view features::ALTERNATOR_TTL = "ALTERNATOR_TTL";
 constexpr std::string_view features::RANGE_SCAN_DATA_VARIANT = "RANGE_SCAN_DATA_VARIANT";
 constexpr std::string_view features::CDC_GENERATIONS_V2 = "CDC_GENERATIONS_V2";
 constexpr std::string_view features::UDA = "UDA";
+constexpr std::string_view features::HINTED_HANDOFF_BATCHED_MUTATIONS = "HINTED_HANDOFF_BATCHED_MUTATIONS";
+constexpr std::string_view features::COALESCED_MUTATIONS = "COALESCED_MUTATIONS";
+constexpr std::string_view features::FILE_BASED_STREAMING = "FILE_BASED_STREAMING";
 
 static logging::logger logger("features");
 
@@ -98,6 +101,9 @@ feature_service::feature_service(feature_config cfg) : _config(cfg)
         , _range_scan_data_variant(*this, features::RANGE_SCAN_DATA_VARIANT)
         , _cdc_generations_v2(*this, features::CDC_GENERATIONS_V2)
         , _uda(*this, features::UDA)
+        , _hinted_handoff_batched_mutations(*this, features::HINTED_HANDOFF_BATCHED_MUTATIONS)
+        , _coalesced_mutations(*this, features::COALESCED_MUTATIONS)
+        , _file_based_streaming(*this, features::FILE_BASED_STREAMING)
 {}
 
 feature_config feature_config_from_db_config(db::config& cfg, std::set<sstring> disabled) {
@@ -202,6 +208,9 @@ std::set<std::string_view> feature_service::known_feature_set() {
         gms::features::RANGE_SCAN_DATA_VARIANT,
         gms::features::CDC_GENERATIONS_V2,
         gms::features::UDA,
+        gms::features::HINTED_HANDOFF_BATCHED_MUTATIONS,
+        gms::features::COALESCED_MUTATIONS,
+        gms::features::FILE_BASED_STREAMING,
     };
 
     for (const sstring& s : _config._disabled_features) {
@@ -307,6 +316,9 @@ void feature_service::enable(const std::set<std::string_view>& list) {
         std::ref(_range_scan_data_variant),
         std::ref(_cdc_generations_v2),
         std::ref(_uda),
+        std::ref(_hinted_handoff_batched_mutations),
+        std::ref(_coalesced_mutations),
+        std::ref(_file_based_streaming),
     })
     {
         if (list.contains(f.name())) {
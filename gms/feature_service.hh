@@ -100,6 +100,9 @@ private:
     gms::feature _range_scan_data_variant;
     gms::feature _cdc_generations_v2;
     gms::feature _uda;
+    gms::feature _hinted_handoff_batched_mutations;
+    gms::feature _coalesced_mutations;
+    gms::feature _file_based_streaming;
 
 public:
 
@@ -178,6 +181,18 @@ public:
         return bool(_uda);
     }
 
+    bool cluster_supports_hinted_handoff_batched_mutations() const {
+        return bool(_hinted_handoff_batched_mutations);
+    }
+
+    bool cluster_supports_coalesced_mutations() const {
+        return bool(_coalesced_mutations);
+    }
+
+    bool cluster_supports_file_based_streaming() const {
+        return bool(_file_based_streaming);
+    }
+
     static std::set<sstring> to_feature_set(sstring features_string);
     // Persist enabled feature in the `system.scylla_local` table under the "enabled_features" key.
     // The key itself is maintained as an `unordered_set<string>` and serialized via `to_string`
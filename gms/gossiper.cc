@@ -301,6 +301,10 @@ future<> gossiper::handle_ack_msg(msg_addr id, gossip_digest_ack ack_msg) {
     auto g_digest_list = ack_msg.get_gossip_digest_list();
     auto& ep_state_map = ack_msg.get_endpoint_state_map();
 
+    if (!this->is_in_shadow_round()) {
+        update_converged_digests(id.addr, g_digest_list, ep_state_map);
+    }
+
     auto f = make_ready_future<>();
     if (ep_state_map.size() > 0) {
         update_timestamp_for_nodes(ep_state_map);
@@ -696,6 +700,7 @@ void gossiper::remove_endpoint(inet_address endpoint) {
     _unreachable_endpoints.erase(endpoint);
     _syn_handlers.erase(endpoint);
     _ack_handlers.erase(endpoint);
+    _peer_digest_state.erase(endpoint);
     quarantine_endpoint(endpoint);
     logger.debug("removing endpoint {}", endpoint);
 }
@@ -973,6 +978,7 @@ void gossiper::run() {
                         for (auto&& e : es) {
                             local_gossiper.endpoint_state_map[e.first].set_alive(e.second.is_alive());
                         }
+                        local_gossiper.rebuild_liveness_bitmap();
                     }
                 }).get();
             }
@@ -1113,6 +1119,7 @@ void gossiper::evict_from_membership(inet_address endpoint) {
     _unreachable_endpoints.erase(endpoint);
     container().invoke_on_all([endpoint] (auto& g) {
         g.endpoint_state_map.erase(endpoint);
+        g.rebuild_liveness_bitmap();
     }).get();
     _expire_time_endpoint_map.erase(endpoint);
     quarantine_endpoint(endpoint);
@@ -1300,8 +1307,68 @@ future<int> gossiper::get_current_heart_beat_version(inet_address endpoint) {
     });
 }
 
+// Prunes the digest list of a SYN message down to the digests the given peer
+// is not known to agree with us on. A peer that went through a full
+// SYN/ACK/ACK2 cycle with us has seen our versions, so re-advertising
+// unchanged (generation, max_version) pairs every round only costs CPU and
+// bytes on both sides. The full digest list is still sent periodically as a
+// safety net against lost messages and peers which restarted and lost their
+// state; a peer which is missing an omitted endpoint also recovers via its
+// own SYN rounds, which advertise the endpoint with an older version and make
+// our ACK ship the newer state.
+gossip_digest_syn gossiper::make_syn_for_peer(gossip_digest_syn syn, inet_address ep) {
+    auto& pds = _peer_digest_state[ep];
+    if (++pds.rounds_since_full_digest >= max_rounds_between_full_digests || pds.converged.empty()) {
+        pds.rounds_since_full_digest = 0;
+        pds.last_sent.clear();
+        for (const auto& d : syn.get_gossip_digests()) {
+            pds.last_sent.emplace(d.get_endpoint(), std::make_pair(d.get_generation(), d.get_max_version()));
+        }
+        return syn;
+    }
+    utils::chunked_vector<gossip_digest> delta;
+    pds.last_sent.clear();
+    for (const auto& d : syn.get_gossip_digests()) {
+        auto it = pds.converged.find(d.get_endpoint());
+        if (it != pds.converged.end() && it->second == std::make_pair(d.get_generation(), d.get_max_version())) {
+            // The peer already agreed with us on this version; there is
+            // nothing to exchange until one of us sees a newer one.
+            continue;
+        }
+        pds.last_sent.emplace(d.get_endpoint(), std::make_pair(d.get_generation(), d.get_max_version()));
+        delta.push_back(d);
+    }
+    logger.trace("make_syn_for_peer: node={}, sending {} digests out of {}", ep, delta.size(), syn.get_gossip_digests().size());
+    return gossip_digest_syn(syn.get_cluster_id(), syn.get_partioner(), std::move(delta));
+}
+
+void gossiper::update_converged_digests(inet_address from, const utils::chunked_vector<gossip_digest>& ack_digests,
+        const std::map<inet_address, endpoint_state>& ack_states) {
+    auto it = _peer_digest_state.find(from);
+    if (it == _peer_digest_state.end()) {
+        return;
+    }
+    auto& pds = it->second;
+    // Endpoints from our last SYN that the peer neither requested state for
+    // nor had newer state of were found in agreement. Remember the agreed
+    // versions so subsequent SYNs can omit them until they change. If a
+    // newer SYN raced with this ACK the recorded version may be ahead of
+    // what the peer really saw; the periodic full digest bounds how long
+    // such an endpoint can stay omitted.
+    for (const auto& d : ack_digests) {
+        pds.last_sent.erase(d.get_endpoint());
+    }
+    for (const auto& [ep, state] : ack_states) {
+        pds.last_sent.erase(ep);
+    }
+    for (const auto& [ep, version] : pds.last_sent) {
+        pds.converged[ep] = version;
+    }
+    pds.last_sent.clear();
+}
+
 future<> gossiper::do_gossip_to_live_member(gossip_digest_syn message, gms::inet_address ep) {
-    return send_gossip(message, {ep});
+    return send_gossip(make_syn_for_peer(std::move(message), ep), {ep});
 }
 
 future<> gossiper::do_gossip_to_unreachable_member(gossip_digest_syn message) {
@@ -1388,6 +1455,7 @@ future<> gossiper::reset_endpoint_state_map() {
     co_await update_live_endpoints_version();
     co_await container().invoke_on_all([] (gossiper& g) {
         g.endpoint_state_map.clear();
+        g.rebuild_liveness_bitmap();
     });
 }
 
@@ -1518,6 +1586,7 @@ void gossiper::mark_alive(inet_address addr, endpoint_state& local_state) {
     }
 
     local_state.mark_dead();
+    rebuild_liveness_bitmap();
     msg_addr id = get_msg_addr(addr);
     int64_t generation = endpoint_state_map[get_broadcast_address()].get_heart_beat_state().get_generation();
     logger.debug("Sending a EchoMessage to {}, with generation_number={}", id, generation);
@@ -1557,6 +1626,7 @@ void gossiper::real_mark_alive(inet_address addr, endpoint_state& local_state) {
 
     local_state.mark_alive();
     local_state.update_timestamp(); // prevents do_status_check from racing us and evicting if it was down > A_VERY_LONG_TIME
+    rebuild_liveness_bitmap();
 
     logger.debug("removing expire time for endpoint : {}", addr);
     _unreachable_endpoints.erase(addr);
@@ -1592,6 +1662,7 @@ void gossiper::real_mark_alive(inet_address addr, endpoint_state& local_state) {
 void gossiper::mark_dead(inet_address addr, endpoint_state& local_state) {
     logger.trace("marking as down {}", addr);
     local_state.mark_dead();
+    rebuild_liveness_bitmap();
     endpoint_state state = local_state;
     _live_endpoints.resize(std::distance(_live_endpoints.begin(), std::remove(_live_endpoints.begin(), _live_endpoints.end(), addr)));
     update_live_endpoints_version().get();
@@ -2028,6 +2099,7 @@ void gossiper::add_saved_endpoint(inet_address ep) {
     }
     ep_state.mark_dead();
     endpoint_state_map[ep] = ep_state;
+    rebuild_liveness_bitmap();
     replicate(ep, ep_state).get();
     _unreachable_endpoints[ep] = now();
     logger.trace("Adding saved endpoint {} {}", ep, ep_state.get_heart_beat_state().get_generation());
@@ -2225,10 +2297,36 @@ void gossiper::dump_endpoint_state_map() {
     logger.info("=== endpoint_state_map dump ends ===");
 }
 
+void gossiper::rebuild_liveness_bitmap() {
+    // Forget endpoints that left the ring, so is_alive() goes back to the
+    // defensive slow path for them.
+    std::erase_if(_liveness_index, [this] (const auto& e) {
+        return !endpoint_state_map.contains(e.first);
+    });
+    for (const auto& [ep, eps] : endpoint_state_map) {
+        auto [it, inserted] = _liveness_index.try_emplace(ep, _liveness_next_bit);
+        if (inserted) {
+            ++_liveness_next_bit;
+            _liveness_bitmap.resize((_liveness_next_bit + 63) / 64);
+        }
+        const auto bit = it->second;
+        if (eps.is_alive()) {
+            _liveness_bitmap[bit / 64] |= uint64_t(1) << (bit % 64);
+        } else {
+            _liveness_bitmap[bit / 64] &= ~(uint64_t(1) << (bit % 64));
+        }
+    }
+}
+
 bool gossiper::is_alive(inet_address ep) const {
     if (ep == get_broadcast_address()) {
         return true;
     }
+    // Fast path: a lookup in the flat liveness index plus a bit test,
+    // without touching the much larger endpoint_state objects.
+    if (auto it = _liveness_index.find(ep); it != _liveness_index.end()) {
+        return _liveness_bitmap[it->second / 64] & (uint64_t(1) << (it->second % 64));
+    }
     auto* eps = get_endpoint_state_for_endpoint_ptr(std::move(ep));
     // we could assert not-null, but having isAlive fail screws a node over so badly that
     // it's worth being defensive here so minor bugs don't cause disproportionate
@@ -143,6 +143,21 @@ private:
     seastar::gate _background_msg;
     std::unordered_map<gms::inet_address, syn_msg_pending> _syn_handlers;
     std::unordered_map<gms::inet_address, ack_msg_pending> _ack_handlers;
+    // Digest bookkeeping for delta SYN messages, per peer. See make_syn_for_peer().
+    struct peer_digest_state {
+        // The (generation, max_version) per endpoint that the peer was last
+        // observed to agree with us on.
+        std::unordered_map<gms::inet_address, std::pair<int32_t, int32_t>> converged;
+        // The digests included in the last SYN sent to the peer.
+        std::unordered_map<gms::inet_address, std::pair<int32_t, int32_t>> last_sent;
+        // SYN rounds since the peer last got the full digest list.
+        unsigned rounds_since_full_digest = 0;
+    };
+    std::unordered_map<gms::inet_address, peer_digest_state> _peer_digest_state;
+    static constexpr unsigned max_rounds_between_full_digests = 8;
+    gossip_digest_syn make_syn_for_peer(gossip_digest_syn syn, inet_address ep);
+    void update_converged_digests(inet_address from, const utils::chunked_vector<gossip_digest>& ack_digests,
+            const std::map<inet_address, endpoint_state>& ack_states);
     bool _advertise_myself = true;
     // Map ip address and generation number
     std::unordered_map<gms::inet_address, int32_t> _advertise_to_nodes;
@@ -216,6 +231,18 @@ private:
     utils::chunked_vector<inet_address> _live_endpoints;
     uint64_t _live_endpoints_version = 0;
 
+    /* Flat per-shard liveness table serving the hot-path is_alive() checks.
+     * Endpoints get a dense bit index on first sight; indexes are never
+     * reused, so the bitmap only grows. The table is rebuilt from
+     * endpoint_state_map whenever liveness may have changed on this shard;
+     * endpoints without an entry fall back to the endpoint_state_map
+     * lookup. */
+    std::unordered_map<inet_address, uint32_t> _liveness_index;
+    std::vector<uint64_t> _liveness_bitmap;
+    uint32_t _liveness_next_bit = 0;
+
+    void rebuild_liveness_bitmap();
+
     /* nodes are being marked as alive */
     std::unordered_set<inet_address> _pending_mark_alive_endpoints;
 
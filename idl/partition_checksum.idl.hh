@@ -63,6 +63,7 @@ struct get_sync_boundary_response {
 enum class row_level_diff_detect_algorithm : uint8_t {
     send_full_set,
     send_full_set_rpc_stream,
+    send_full_set_rpc_stream_xxh3,
 };
 
 enum class repair_stream_cmd : uint8_t {
@@ -55,6 +55,136 @@ static std::pair<wasmtime::Instance, wasmtime::Func> create_instance_and_func(co
     return std::make_pair(std::move(instance), std::move(*func));
 }
 
+// A store with a pre-created instance of the module. Creating these is the
+// dominant cost of calling a small UDF, so successful calls return them to
+// the pool for reuse instead of destroying them.
+struct pooled_instance {
+    wasmtime::Store store;
+    wasmtime::Instance instance;
+    wasmtime::Func func;
+    // Total amount of fuel ever added to the store, used to compute how much
+    // is left when the instance is reused.
+    uint64_t fuel_added = 0;
+    // Byte offset and capacity of the argument scratch region at the end of
+    // the instance's linear memory. Established by the first call that passes
+    // an argument indirectly and reused by subsequent calls, growing the
+    // memory only when a call needs more space than any previous one.
+    uint32_t arg_buf_offset = 0;
+    uint32_t arg_buf_capacity = 0;
+};
+
+class instance_pool {
+    // Enough to cover a few concurrent executions of the same function on
+    // this shard without retaining an unbounded number of stores.
+    static constexpr size_t max_idle_instances = 4;
+    // An instance whose linear memory grew beyond this is cheaper to recreate
+    // than to keep around.
+    static constexpr size_t max_retained_memory_size = 1 << 20;
+
+    std::vector<std::unique_ptr<pooled_instance>> _idle;
+public:
+    std::unique_ptr<pooled_instance> get(context& ctx) {
+        if (!_idle.empty()) {
+            auto pi = std::move(_idle.back());
+            _idle.pop_back();
+            return pi;
+        }
+        auto store = wasmtime::Store(ctx.engine_ptr->get());
+        auto [instance, func] = create_instance_and_func(ctx, store);
+        return std::make_unique<pooled_instance>(pooled_instance{std::move(store), std::move(instance), std::move(func)});
+    }
+
+    void put(std::unique_ptr<pooled_instance> pi) {
+        if (_idle.size() >= max_idle_instances) {
+            return;
+        }
+        if (auto memory_export = pi->instance.get(pi->store, "memory")) {
+            auto* memory = std::get_if<wasmtime::Memory>(&*memory_export);
+            if (memory && memory->data(pi->store).size() > max_retained_memory_size) {
+                return;
+            }
+        }
+        _idle.push_back(std::move(pi));
+    }
+};
+
+// Marshals indirectly-passed values through the instance's linear memory,
+// using the scratch region retained on the pooled instance, so that repeated
+// calls don't have to grow the memory for every argument.
+class linear_memory_buffer {
+    static constexpr size_t wasm_page_size = 64 * 1024;
+
+    pooled_instance& _pi;
+    std::optional<wasmtime::Memory> _memory;
+    uint32_t _used = 0;
+
+private:
+    wasmtime::Memory& memory() {
+        if (!_memory) {
+            // `memory` is required to be exported in the WebAssembly module
+            auto memory_export = _pi.instance.get(_pi.store, "memory");
+            if (!memory_export) {
+                throw wasm::exception("memory export not found - please export `memory` in the wasm module");
+            }
+            _memory = std::get<wasmtime::Memory>(*memory_export);
+            if (!_pi.arg_buf_capacity) {
+                _pi.arg_buf_offset = _memory->data(_pi.store).size();
+            }
+        }
+        return *_memory;
+    }
+
+    // Returns the byte offset in linear memory of a fresh len-byte slot in
+    // the scratch region.
+    uint32_t reserve(size_t len) {
+        auto& mem = memory();
+        const auto needed = _used + len;
+        if (needed > _pi.arg_buf_capacity) {
+            const auto delta_pages = (needed - _pi.arg_buf_capacity + wasm_page_size - 1) / wasm_page_size;
+            auto grown = mem.grow(_pi.store, delta_pages);
+            if (!grown) {
+                throw wasm::exception(format("Failed to grow wasm memory by {} pages: {}", delta_pages, grown.err().message()));
+            }
+            _pi.arg_buf_capacity += delta_pages * wasm_page_size;
+        }
+        const auto offset = _pi.arg_buf_offset + _used;
+        _used = needed;
+        return offset;
+    }
+
+public:
+    explicit linear_memory_buffer(pooled_instance& pi) : _pi(pi) {
+    }
+
+    // Writes param as the {int32_t serialized_size; char[] serialized_buf}
+    // struct of the indirect-argument ABI, with size -1 denoting null, and
+    // returns its location in linear memory.
+    int32_t write_indirect_arg(const bytes_opt& param, bool nullable) {
+        if (!param && !nullable) {
+            on_internal_error(wasm_logger, "write_indirect_arg does not accept null values here");
+        }
+        const int64_t serialized_size = param ? param->size() : 0;
+        if (serialized_size > std::numeric_limits<int32_t>::max()) {
+            throw wasm::exception(format("Serialized parameter is too large: {} > {}", serialized_size, std::numeric_limits<int32_t>::max()));
+        }
+        const auto offset = reserve(sizeof(int32_t) + serialized_size);
+        // data pointers are invalidated by growth, so fetch after reserve()
+        uint8_t* data = memory().data(_pi.store).data() + offset;
+        const int32_t size_or_null = param ? int32_t(serialized_size) : -1;
+        std::memcpy(data, reinterpret_cast<const char*>(&size_or_null), sizeof(int32_t));
+        if (param) {
+            std::memcpy(data + sizeof(int32_t), param->data(), serialized_size);
+        }
+        return int32_t(offset);
+    }
+
+    // Returns a pointer to the given location in linear memory, for reading
+    // back the returned value.
+    uint8_t* read_at(int32_t offset) {
+        return memory().data(_pi.store).data() + offset;
+    }
+};
+
 void compile(context& ctx, const std::vector<sstring>& arg_names, std::string script) {
     wasm_logger.debug("Compiling script {}", script);
     auto module = wasmtime::Module::compile(ctx.engine_ptr->get(), script);
@@ -70,8 +200,7 @@ void compile(context& ctx, const std::vector<sstring>& arg_names, std::string sc
 struct init_arg_visitor {
     const bytes_opt& param;
     std::vector<wasmtime::Val>& argv;
-    wasmtime::Store& store;
-    wasmtime::Instance& instance;
+    linear_memory_buffer& buf;
 
     void operator()(const boolean_type_impl&) {
         auto dv = boolean_type->deserialize(*param);
@@ -110,80 +239,28 @@ struct init_arg_visitor {
     }
 
     void operator()(const abstract_type& t) {
-        // set up exported memory's underlying buffer,
-        // `memory` is required to be exported in the WebAssembly module
-        auto memory_export = instance.get(store, "memory");
-        if (!memory_export) {
-            throw wasm::exception("memory export not found - please export `memory` in the wasm module");
-        }
-        auto memory = std::get<wasmtime::Memory>(*memory_export);
-        uint8_t* data = memory.data(store).data();
-        size_t mem_size = memory.size(store);
         if (!param) {
             on_internal_error(wasm_logger, "init_arg_visitor does not accept null values");
         }
-        int32_t serialized_size = param->size();
-        if (serialized_size > std::numeric_limits<int32_t>::max()) {
-            throw wasm::exception(format("Serialized parameter is too large: {} > {}", serialized_size, std::numeric_limits<int32_t>::max()));
-        }
-        auto grown = memory.grow(store, sizeof(int32_t) + serialized_size); // for fitting serialized size + the buffer itself
-        if (!grown) {
-            throw wasm::exception(format("Failed to grow wasm memory to {}: {}", serialized_size, grown.err().message()));
-        }
-        // put the size in wasm module's memory
-        std::memcpy(data + mem_size, reinterpret_cast<char*>(&serialized_size), sizeof(int32_t));
-        // put the argument in wasm module's memory
-        std::memcpy(data + mem_size + sizeof(int32_t), param->data(), serialized_size);
-
         // the place inside wasm memory where the struct is placed
-        argv.push_back(int32_t(mem_size));
+        argv.push_back(buf.write_indirect_arg(param, false));
     }
 };
 
 struct init_nullable_arg_visitor {
     const bytes_opt& param;
     std::vector<wasmtime::Val>& argv;
-    wasmtime::Store& store;
-    wasmtime::Instance& instance;
+    linear_memory_buffer& buf;
 
     void operator()(const abstract_type& t) {
-        // set up exported memory's underlying buffer,
-        // `memory` is required to be exported in the WebAssembly module
-        auto memory_export = instance.get(store, "memory");
-        if (!memory_export) {
-            throw wasm::exception("memory export not found - please export `memory` in the wasm module");
-        }
-        auto memory = std::get<wasmtime::Memory>(*memory_export);
-        uint8_t* data = memory.data(store).data();
-        size_t mem_size = memory.size(store);
-        const int32_t serialized_size = param ? param->size() : 0;
-        if (serialized_size > std::numeric_limits<int32_t>::max()) {
-            throw wasm::exception(format("Serialized parameter is too large: {} > {}", param->size(), std::numeric_limits<int32_t>::max()));
-        }
-        auto grown = memory.grow(store, sizeof(int32_t) + serialized_size); // for fitting the serialized size + the buffer itself
-        if (!grown) {
-            throw wasm::exception(format("Failed to grow wasm memory to {}: {}", serialized_size, grown.err().message()));
-        }
-        if (param) {
-            // put the size in wasm module's memory
-            std::memcpy(data + mem_size, reinterpret_cast<const char*>(&serialized_size), sizeof(int32_t));
-            // put the argument in wasm module's memory
-            std::memcpy(data + mem_size + sizeof(int32_t), param->data(), serialized_size);
-        } else {
-            // size of -1 means that the value is null
-            const int32_t is_null = -1;
-            std::memcpy(data + mem_size, reinterpret_cast<const char*>(&is_null), sizeof(int32_t));
-        }
-
         // the place inside wasm memory where the struct is placed
-        argv.push_back(int32_t(mem_size));
+        argv.push_back(buf.write_indirect_arg(param, true));
     }
 };
 
 struct from_val_visitor {
     const wasmtime::Val& val;
-    wasmtime::Store& store;
-    wasmtime::Instance& instance;
+    linear_memory_buffer& buf;
 
     bytes_opt operator()(const boolean_type_impl&) {
         expect_kind(wasmtime::ValKind::I32);
@@ -216,13 +293,7 @@ struct from_val_visitor {
 
     bytes_opt operator()(const abstract_type& t) {
         expect_kind(wasmtime::ValKind::I32);
-        auto memory_export = instance.get(store, "memory");
-        if (!memory_export) {
-            throw wasm::exception("memory export not found - please export `memory` in the wasm module");
-        }
-        auto memory = std::get<wasmtime::Memory>(*memory_export);
-        uint8_t* mem_base = memory.data(store).data();
-        uint8_t* data = mem_base + val.i32();
+        uint8_t* data = buf.read_at(val.i32());
         int32_t ret_size;
         std::memcpy(reinterpret_cast<char*>(&ret_size), data, 4);
         if (ret_size == -1) {
@@ -252,32 +323,42 @@ struct from_val_visitor {
 seastar::future<bytes_opt> run_script(context& ctx, const std::vector<data_type>& arg_types, const std::vector<bytes_opt>& params, data_type return_type, bool allow_null_input) {
     wasm_logger.debug("Running function {}", ctx.function_name);
 
-    auto store = wasmtime::Store(ctx.engine_ptr->get());
-    // Replenish the store with initial amount of fuel
-    auto added = store.context().add_fuel(ctx.engine_ptr->initial_fuel_amount());
-    if (!added) {
-        co_return coroutine::make_exception(wasm::exception(added.err().message()));
+    if (!ctx.pool) {
+        ctx.pool = std::make_shared<instance_pool>();
+    }
+    // Reuses an idle pre-created instance if there is one. Only successful
+    // calls return the instance to the pool; on the error paths below the
+    // instance is simply destroyed, a trapped instance must not be reused.
+    auto pi = ctx.pool->get(ctx);
+    // Replenish the store's fuel back to the initial amount
+    const uint64_t fuel_remaining = pi->fuel_added - *pi->store.context().fuel_consumed();
+    if (const auto initial_fuel = ctx.engine_ptr->initial_fuel_amount(); fuel_remaining < initial_fuel) {
+        auto added = pi->store.context().add_fuel(initial_fuel - fuel_remaining);
+        if (!added) {
+            co_return coroutine::make_exception(wasm::exception(added.err().message()));
+        }
+        pi->fuel_added += initial_fuel - fuel_remaining;
     }
-    auto [instance, func] = create_instance_and_func(ctx, store);
     std::vector<wasmtime::Val> argv;
+    linear_memory_buffer membuf(*pi);
     for (size_t i = 0; i < arg_types.size(); ++i) {
         const abstract_type& type = *arg_types[i];
         const bytes_opt& param = params[i];
         // If nulls are allowed, each type will be passed indirectly
         // as a struct {bool is_null; int32_t serialized_size, char[] serialized_buf}
         if (allow_null_input) {
-            visit(type, init_nullable_arg_visitor{param, argv, store, instance});
+            visit(type, init_nullable_arg_visitor{param, argv, membuf});
         } else if (param) {
-            visit(type, init_arg_visitor{param, argv, store, instance});
+            visit(type, init_arg_visitor{param, argv, membuf});
         } else {
             co_return coroutine::make_exception(wasm::exception(format("Function {} cannot be called on null values", ctx.function_name)));
         }
     }
-    uint64_t fuel_before = *store.context().fuel_consumed();
+    uint64_t fuel_before = *pi->store.context().fuel_consumed();
 
-    auto result = func.call(store, argv);
+    auto result = pi->func.call(pi->store, argv);
 
-    uint64_t consumed = *store.context().fuel_consumed() - fuel_before;
+    uint64_t consumed = *pi->store.context().fuel_consumed() - fuel_before;
     wasm_logger.debug("Consumed {} fuel units", consumed);
 
     if (!result) {
@@ -301,13 +382,18 @@ seastar::future<bytes_opt> run_script(context& ctx, const std::vector<data_type>
     // wrappers for a few languages (C++, C, Rust), and see whether the ABI makes it easy
     // to interact with - we want to avoid poor user experience, and it's hard to judge it
     // before we actually have helper libraries.
+    bytes_opt ret;
     if (allow_null_input) {
         // Force calling the default method for abstract_type, which checks for nulls
         // and expects a serialized input
-        co_return from_val_visitor{result_vec[0], store, instance}(static_cast<const abstract_type&>(*return_type));
+        ret = from_val_visitor{result_vec[0], membuf}(static_cast<const abstract_type&>(*return_type));
     } else {
-        co_return visit(*return_type, from_val_visitor{result_vec[0], store, instance});
+        ret = visit(*return_type, from_val_visitor{result_vec[0], membuf});
     }
+    // The returned value was read back out of linear memory, the instance
+    // can be recycled now
+    ctx.pool->put(std::move(pi));
+    co_return ret;
 }
 
 }
@@ -38,10 +38,16 @@ public:
 
 #ifdef SCYLLA_ENABLE_WASMTIME
 
+// Defined in wasm.cc. Keeps idle, pre-instantiated instances of the module,
+// so that repeated calls (e.g. aggregations) don't pay the store and
+// instance creation costs on every row.
+class instance_pool;
+
 struct context {
     wasm::engine* engine_ptr;
     std::optional<wasmtime::Module> module;
     std::string function_name;
+    std::shared_ptr<instance_pool> pool;
 
     context(wasm::engine* engine_ptr, std::string name);
 };
@@ -80,6 +80,11 @@ sstring abstract_replication_strategy::to_qualified_class_name(std::string_view
 }
 
 inet_address_vector_replica_set abstract_replication_strategy::get_natural_endpoints(const token& search_token, const effective_replication_map& erm) const {
+    const auto& by_index = erm.get_replication_map_by_index();
+    if (!by_index.empty()) {
+        auto index = erm.get_token_metadata_ptr()->first_token_index(search_token);
+        return *by_index[index];
+    }
     const token& key_token = erm.get_token_metadata_ptr()->first_token(search_token);
     auto res = erm.get_replication_map().find(key_token);
     return res->second;
@@ -340,7 +345,24 @@ inet_address_vector_replica_set effective_replication_map::get_natural_endpoints
     return _rs->get_natural_endpoints(search_token, *this);
 }
 
+void effective_replication_map::build_token_index() {
+    const auto& sorted_tokens = _tmptr->sorted_tokens();
+    _replication_map_by_index.clear();
+    _replication_map_by_index.reserve(sorted_tokens.size());
+    for (const auto& t : sorted_tokens) {
+        auto it = _replication_map.find(t);
+        if (it == _replication_map.end()) {
+            // The replication map does not cover the ring; leave the index
+            // empty and let lookups fall back to the map.
+            _replication_map_by_index.clear();
+            return;
+        }
+        _replication_map_by_index.push_back(&it->second);
+    }
+}
+
 future<> effective_replication_map::clear_gently() noexcept {
+    _replication_map_by_index.clear();
     co_await utils::clear_gently(_replication_map);
     co_await utils::clear_gently(_tmptr);
 }
@@ -163,6 +163,11 @@ private:
     abstract_replication_strategy::ptr_type _rs;
     token_metadata_ptr _tmptr;
     replication_map _replication_map;
+    // Replica sets of _replication_map ordered like the sorted tokens of
+    // _tmptr, so the hot-path endpoint lookup is an array index away from
+    // the token search instead of a second, hashed lookup. The pointers
+    // reference _replication_map values, which are node-stable.
+    std::vector<const inet_address_vector_replica_set*> _replication_map_by_index;
     size_t _replication_factor;
     std::optional<factory_key> _factory_key = std::nullopt;
     effective_replication_map_factory* _factory = nullptr;
@@ -188,6 +193,14 @@ public:
         return _replication_map;
     }
 
+    const std::vector<const inet_address_vector_replica_set*>& get_replication_map_by_index() const noexcept {
+        return _replication_map_by_index;
+    }
+
+    // Rebuilds _replication_map_by_index from _replication_map. Must be
+    // called after construction, before the map is used for lookups.
+    void build_token_index();
+
     const size_t get_replication_factor() const noexcept {
         return _replication_factor;
     }
@@ -255,7 +268,9 @@ using effective_replication_map_ptr = lw_shared_ptr<const effective_replication_
 using mutable_effective_replication_map_ptr = lw_shared_ptr<effective_replication_map>;
 
 inline mutable_effective_replication_map_ptr make_effective_replication_map(abstract_replication_strategy::ptr_type rs, token_metadata_ptr tmptr, replication_map replication_map, size_t replication_factor) {
-    return make_lw_shared<effective_replication_map>(std::move(rs), std::move(tmptr), std::move(replication_map), replication_factor);
+    auto erm = make_lw_shared<effective_replication_map>(std::move(rs), std::move(tmptr), std::move(replication_map), replication_factor);
+    erm->build_token_index();
+    return erm;
 }
 
 // Apply the replication strategy over the current configuration and the given token_metadata.
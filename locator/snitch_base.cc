@@ -39,6 +39,7 @@
 #include "locator/snitch_base.hh"
 #include "gms/gossiper.hh"
 #include "gms/application_state.hh"
+#include "utils/hash.hh"
 
 namespace locator {
 std::optional<sstring>
@@ -60,9 +61,40 @@ inet_address_vector_replica_set snitch_base::get_sorted_list_by_proximity(
     return preferred;
 }
 
+size_t snitch_base::proximity_cache_key::hash::operator()(const proximity_cache_key& k) const {
+    size_t h = std::hash<inet_address>()(k.address);
+    for (auto& ep : k.replicas) {
+        h = utils::hash_combine(h, std::hash<inet_address>()(ep));
+    }
+    return h;
+}
+
 void snitch_base::sort_by_proximity(
     inet_address address, inet_address_vector_replica_set& addresses) {
 
+    if (addresses.size() <= 1) {
+        return;
+    }
+
+    auto now = seastar::lowres_clock::now();
+    if (now >= _proximity_cache_expiry || _proximity_cache.size() >= max_proximity_cache_entries) {
+        _proximity_cache.clear();
+        _proximity_cache_expiry = now + proximity_cache_refresh_interval;
+    }
+
+    proximity_cache_key key{address, addresses};
+    auto it = _proximity_cache.find(key);
+    if (it == _proximity_cache.end()) {
+        do_sort_by_proximity(address, addresses);
+        _proximity_cache.emplace(std::move(key), addresses);
+    } else {
+        addresses = it->second;
+    }
+}
+
+void snitch_base::do_sort_by_proximity(
+    inet_address address, inet_address_vector_replica_set& addresses) {
+
     std::sort(addresses.begin(), addresses.end(),
               [this, &address](inet_address& a1, inet_address& a2)
     {
@@ -38,8 +38,11 @@
 
 #pragma once
 
+#include <chrono>
+#include <unordered_map>
 #include <unordered_set>
 #include <vector>
+#include <seastar/core/lowres_clock.hh>
 #include <boost/signals2.hpp>
 #include <boost/signals2/dummy_mutex.hpp>
 
@@ -453,6 +456,31 @@ public:
 private:
     bool has_remote_node(inet_address_vector_replica_set& l);
 
+    // Memoized results of sort_by_proximity(). Proximity of a replica set
+    // is a function of dc/rack assignments, which change only on admin
+    // action, so sorted orders are stable for long periods. Instead of
+    // invalidating the cache on every possible topology event we simply
+    // rebuild it every proximity_cache_refresh_interval; proximity order
+    // is a routing hint, so serving an order that is stale by up to the
+    // refresh interval is harmless.
+    struct proximity_cache_key {
+        inet_address address;
+        inet_address_vector_replica_set replicas;
+
+        bool operator==(const proximity_cache_key&) const = default;
+
+        struct hash {
+            size_t operator()(const proximity_cache_key& k) const;
+        };
+    };
+    static constexpr auto proximity_cache_refresh_interval = std::chrono::seconds(1);
+    static constexpr size_t max_proximity_cache_entries = 4096;
+    std::unordered_map<proximity_cache_key, inet_address_vector_replica_set, proximity_cache_key::hash> _proximity_cache;
+    seastar::lowres_clock::time_point _proximity_cache_expiry;
+
+    void do_sort_by_proximity(
+        inet_address address, inet_address_vector_replica_set& addresses);
+
 protected:
     static std::optional<sstring> get_endpoint_info(inet_address endpoint,
                                                     gms::application_state key);
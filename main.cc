@@ -23,6 +23,9 @@
 
 #include <seastar/util/closeable.hh>
 #include "utils/build_id.hh"
+#include "utils/numa_locality.hh"
+#include "utils/stall_fingerprints.hh"
+#include "utils/write_path_trace.hh"
 #include "supervisor.hh"
 #include "database.hh"
 #include <seastar/core/reactor.hh>
@@ -31,6 +34,7 @@
 #include "transport/server.hh"
 #include <seastar/http/httpd.hh>
 #include "api/api_init.hh"
+#include "db/cache_warmup.hh"
 #include "db/config.hh"
 #include "db/extensions.hh"
 #include "db/legacy_schema_migrator.hh"
@@ -526,6 +530,8 @@ int main(int ac, char** av) {
             auto blocked_reactor_notify_ms = engine().get_blocked_reactor_notify_ms();
             smp::invoke_on_all([] {
                 engine().update_blocked_reactor_notify_ms(std::chrono::milliseconds(1000000));
+                // collect stall backtraces into per-shard fingerprint counts
+                utils::get_local_stall_fingerprint_registry().start();
             }).get();
 
             ::stop_signal stop_signal; // we can move this earlier to support SIGINT during initialization
@@ -560,6 +566,10 @@ int main(int ac, char** av) {
                 default_sg.set_shares(200);
             }).get();
 
+            smp::invoke_on_all([rate = cfg->write_trace_sample_rate()] {
+                utils::get_local_write_path_tracer().set_sample_rate(rate);
+            }).get();
+
             adjust_and_verify_rlimit(cfg->developer_mode());
             verify_adequate_memory_per_shard(cfg->developer_mode());
             verify_seastar_io_scheduler(opts, cfg->developer_mode());
@@ -599,6 +609,7 @@ int main(int ac, char** av) {
             smp::invoke_on_all([&cfg, background_reclaim_scheduling_group] {
                 logalloc::tracker::config st_cfg;
                 st_cfg.defragment_on_idle = cfg->defragment_memory_on_idle();
+                st_cfg.idle_compaction_target_occupancy = cfg->defragment_memory_target_occupancy();
                 st_cfg.abort_on_lsa_bad_alloc = cfg->abort_on_lsa_bad_alloc();
                 st_cfg.lsa_reclamation_step = cfg->lsa_reclamation_step();
                 st_cfg.background_reclaim_sched_group = background_reclaim_scheduling_group;
@@ -762,6 +773,7 @@ int main(int ac, char** av) {
             } else if (compress_what == "dc") {
                 mscfg.compress = netw::messaging_service::compress_what::dc;
             }
+            mscfg.compress_streaming_dict = cfg->internode_compression_zstd_dictionary();
 
             if (!cfg->inter_dc_tcp_nodelay()) {
                 mscfg.tcp_nodelay = netw::messaging_service::tcp_nodelay_what::local;
@@ -987,10 +999,20 @@ int main(int ac, char** av) {
             auto cl = db.local().commitlog();
             if (cl != nullptr) {
                 auto paths = cl->get_segments_to_replay();
-                if (!paths.empty()) {
+                auto system_cl = db.local().system_commitlog();
+                auto system_paths = system_cl->get_segments_to_replay();
+                if (!paths.empty() || !system_paths.empty()) {
                     supervisor::notify("replaying commit log");
                     auto rp = db::commitlog_replayer::create_replayer(db).get0();
-                    rp.recover(paths, db::commitlog::descriptor::FILENAME_PREFIX).get();
+                    // Replay the system domain first, so that anything reading
+                    // system tables while user tables are replayed sees the
+                    // recovered state.
+                    if (!system_paths.empty()) {
+                        rp.recover(system_paths, database::system_commitlog_filename_prefix).get();
+                    }
+                    if (!paths.empty()) {
+                        rp.recover(paths, db::commitlog::descriptor::FILENAME_PREFIX).get();
+                    }
                     supervisor::notify("replaying commit log - flushing memtables");
                     db.invoke_on_all([] (database& db) {
                         return db.flush_all_memtables();
@@ -998,6 +1020,7 @@ int main(int ac, char** av) {
                     supervisor::notify("replaying commit log - removing old commitlog segments");
                     //FIXME: discarded future
                     (void)cl->delete_segments(std::move(paths));
+                    (void)system_cl->delete_segments(std::move(system_paths));
                 }
             }
 
@@ -1325,6 +1348,13 @@ int main(int ac, char** av) {
                 db.revert_initial_system_read_concurrency_boost();
             }).get();
 
+            if (cfg->row_cache_warmup_on_startup()) {
+                supervisor::notify("warming row caches from saved hot sets");
+                db.invoke_on_all([] (database& db) {
+                    return db::warm_row_caches(db);
+                }).get();
+            }
+
             cql_transport::controller cql_server_ctl(auth_service, mm_notifier, gossiper, qp, service_memory_limiter, sl_controller, lifecycle_notifier, *cfg);
 
             ss.local().register_protocol_server(cql_server_ctl);
@@ -1405,6 +1435,23 @@ int main(int ac, char** av) {
             seastar::set_abort_on_ebadf(cfg->abort_on_ebadf());
             api::set_server_done(ctx).get();
             supervisor::notify("serving");
+
+            if (cfg->validate_sstables_after_boot()) {
+                // Now that the node is serving, check the integrity of its
+                // sstables in the background. Corrupt sstables are
+                // quarantined. The scrub jobs are tracked by the compaction
+                // manager, which stops them on drain.
+                (void)db.invoke_on_all(&database::validate_all_sstables);
+            }
+
+            // Startup allocation is done; verify that each shard's memory
+            // actually resides on its local NUMA node. Remote pages inflate
+            // tail latency on multi-socket machines, and a warning here
+            // means some of the memory was faulted on the wrong socket.
+            smp::invoke_on_all([] {
+                utils::log_and_register_numa_locality_metrics();
+            }).get();
+
             // Register at_exit last, so that storage_service::drain_on_shutdown will be called first
 
             auto stop_repair = defer_verbose_shutdown("repair", [&repair] {
@@ -546,9 +546,18 @@ void memtable::revert_flushed_memory() noexcept {
 
 class flush_memory_accounter {
     memtable& _mt;
+    // Bytes read into the flush reader's buffer but not yet credited to the
+    // dirty memory manager. Crediting is deferred to commit(), which the
+    // flush reader calls when the previous buffer has been consumed by the
+    // sstable writer, so that write throttling tracks writer progress rather
+    // than the reader's read-ahead.
+    uint64_t _pending = 0;
 public:
     void update_bytes_read(uint64_t delta) {
-        _mt.add_flushed_memory(delta);
+        _pending += delta;
+    }
+    void commit() {
+        _mt.add_flushed_memory(std::exchange(_pending, 0));
     }
     explicit flush_memory_accounter(memtable& mt)
         : _mt(mt)
@@ -623,6 +632,15 @@ class flush_reader final : public flat_mutation_reader::impl, private iterator_r
     // flat_mutation_reader for each partition. This is suboptimal.
     // Partition snapshot reader should be devirtualised and called directly
     // without using any intermediate buffers.
+    //
+    // Note on wide partitions: a single huge partition is necessarily flushed
+    // as one serial stream. Splitting its clustering range across parallel
+    // writer pipelines was considered and rejected: the sstable format keeps
+    // a partition contiguous in the data file with a sequentially built
+    // promoted index, and a partition cannot span fragments of a run either,
+    // so there is no way to merge independently written chunks back into one
+    // sstable partition. Flush bandwidth for such tables scales with the
+    // partition count only.
     flat_mutation_reader_opt _partition_reader;
     flush_memory_accounter _flushed_memory;
 public:
@@ -665,6 +683,12 @@ private:
     }
 public:
     virtual future<> fill_buffer() override {
+        // We are called when the buffer filled by the previous invocation has
+        // been drained by the flush consumer, so everything read back then has
+        // made it into the sstable writer. Credit it to the dirty memory
+        // manager now, so that throttled writes are released in step with
+        // writer progress rather than with our read-ahead.
+        _flushed_memory.commit();
         return do_until([this] { return is_end_of_stream() || is_buffer_full(); }, [this] {
             if (!_partition_reader) {
                 get_next_partition();
@@ -698,6 +722,10 @@ public:
         return make_exception_future<>(make_backtraced_exception_ptr<std::bad_function_call>());
     }
     virtual future<> close() noexcept override {
+        // Credit whatever is still pending. On the happy path the stream was
+        // fully consumed; on failure the flush machinery reverts all flushed
+        // memory anyway, so over-crediting here is harmless.
+        _flushed_memory.commit();
         return close_partition_reader();
     }
 };
@@ -21,6 +21,7 @@
 
 #include "message/messaging_service.hh"
 #include <seastar/core/distributed.hh>
+#include <seastar/core/metrics.hh>
 #include "gms/failure_detector.hh"
 #include "gms/gossiper.hh"
 #include "gms/inet_address_serializer.hh"
@@ -92,6 +93,7 @@
 #include <seastar/rpc/lz4_compressor.hh>
 #include <seastar/rpc/lz4_fragmented_compressor.hh>
 #include <seastar/rpc/multi_algo_compressor_factory.hh>
+#include "message/stream_compressor.hh"
 #include "idl/view.dist.impl.hh"
 #include "partition_range_compat.hh"
 #include <boost/range/adaptor/filtered.hpp>
@@ -125,6 +127,15 @@ static rpc::multi_algo_compressor_factory compressor_factory {
     &lz4_fragmented_compressor_factory,
     &lz4_compressor_factory,
 };
+// Offered on streaming and repair connections when dictionary compression is
+// enabled. The dictionary compressor comes first so it wins the negotiation
+// whenever both sides advertise it; peers which do not know it fall back to
+// the LZ4 compressors as before.
+static rpc::multi_algo_compressor_factory streaming_compressor_factory {
+    &stream_compressor_factory(),
+    &lz4_fragmented_compressor_factory,
+    &lz4_compressor_factory,
+};
 
 struct messaging_service::rpc_protocol_server_wrapper : public rpc_protocol::server { using rpc_protocol::server::server; };
 
@@ -240,7 +251,9 @@ void messaging_service::do_start_listen() {
     bool listen_to_bc = _cfg.listen_on_broadcast_address && _cfg.ip != utils::fb_utilities::get_broadcast_address();
     rpc::server_options so;
     if (_cfg.compress != compress_what::none) {
-        so.compressor_factory = &compressor_factory;
+        // The server side always advertises the full set; only clients which
+        // offer the dictionary compressor end up using it.
+        so.compressor_factory = _cfg.compress_streaming_dict ? &streaming_compressor_factory : &compressor_factory;
     }
     so.load_balancing_algorithm = server_socket::load_balancing_algorithm::port;
 
@@ -332,7 +345,7 @@ messaging_service::messaging_service(config cfg, scheduling_config scfg, std::sh
     : _cfg(std::move(cfg))
     , _rpc(new rpc_protocol_wrapper(serializer { }))
     , _credentials_builder(credentials ? std::make_unique<seastar::tls::credentials_builder>(*credentials) : nullptr)
-    , _clients(2 + scfg.statement_tenants.size() * 2)
+    , _clients(3 + scfg.statement_tenants.size() * 2)
     , _scheduling_config(scfg)
     , _scheduling_info_for_connection_index(initial_scheduling_info())
 {
@@ -346,6 +359,36 @@ messaging_service::messaging_service(config cfg, scheduling_config scfg, std::sh
         _connection_index_for_tenant.push_back({_scheduling_config.statement_tenants[i].sched_group, i});
     }
 
+    // Per-connection-class client metrics, labeled with the class name
+    // (the isolation cookie). The API exposes per-peer stats flattened over
+    // all classes; these let us tell e.g. bulk streaming traffic apart from
+    // its control verbs.
+    namespace sm = seastar::metrics;
+    std::vector<sm::metric_definition> class_metrics;
+    for (unsigned idx = 0; idx < _clients.size(); ++idx) {
+        auto label = sm::label_instance("connection_class", _scheduling_info_for_connection_index[idx].isolation_cookie);
+        auto sum_of = [this, idx] (rpc::stats::counter_type rpc::stats::* field) {
+            return [this, idx, field] {
+                rpc::stats::counter_type sum = 0;
+                for (auto&& c : _clients[idx]) {
+                    sum += c.second.get_stats().*field;
+                }
+                return sum;
+            };
+        };
+        class_metrics.emplace_back(sm::make_derive("client_sent_messages", sum_of(&rpc::stats::sent_messages),
+                sm::description("Total RPC requests sent on client connections of this class."), {label}));
+        class_metrics.emplace_back(sm::make_derive("client_replied", sum_of(&rpc::stats::replied),
+                sm::description("Total RPC responses received on client connections of this class."), {label}));
+        class_metrics.emplace_back(sm::make_derive("client_exceptions", sum_of(&rpc::stats::exception_received),
+                sm::description("Total RPC exception responses received on client connections of this class."), {label}));
+        class_metrics.emplace_back(sm::make_derive("client_timeouts", sum_of(&rpc::stats::timeout),
+                sm::description("Total RPC requests that timed out on client connections of this class."), {label}));
+        class_metrics.emplace_back(sm::make_gauge("client_pending", sum_of(&rpc::stats::pending),
+                sm::description("RPC requests queued or in flight on client connections of this class."), {label}));
+    }
+    _metrics.add_group("messaging_service", std::move(class_metrics));
+
     register_handler(this, messaging_verb::CLIENT_ID, [] (rpc::client_info& ci, gms::inet_address broadcast_address, uint32_t src_cpu_id, rpc::optional<uint64_t> max_result_size) {
         ci.attach_auxiliary("baddr", broadcast_address);
         ci.attach_auxiliary("src_cpu_id", src_cpu_id);
@@ -448,6 +491,11 @@ static constexpr unsigned do_get_rpc_client_idx(messaging_verb verb) {
     case messaging_verb::GROUP0_PEER_EXCHANGE:
     case messaging_verb::GROUP0_MODIFY_CONFIG:
         return 0;
+    // Streaming and repair control verbs. They are small and
+    // latency-sensitive: a stalled NODE_OPS_CMD or repair negotiation stalls
+    // the whole operation. Keep them away from the bulk data verbs below,
+    // which can keep a saturated (e.g. cross-DC) link busy for seconds per
+    // frame and would head-of-line-block them on a shared socket.
     case messaging_verb::PREPARE_MESSAGE:
     case messaging_verb::PREPARE_DONE_MESSAGE:
     case messaging_verb::UNUSED__STREAM_MUTATION:
@@ -455,25 +503,32 @@ static constexpr unsigned do_get_rpc_client_idx(messaging_verb verb) {
     case messaging_verb::COMPLETE_MESSAGE:
     case messaging_verb::REPLICATION_FINISHED:
     case messaging_verb::UNUSED__REPAIR_CHECKSUM_RANGE:
-    case messaging_verb::STREAM_MUTATION_FRAGMENTS:
     case messaging_verb::REPAIR_ROW_LEVEL_START:
     case messaging_verb::REPAIR_ROW_LEVEL_STOP:
     case messaging_verb::REPAIR_GET_FULL_ROW_HASHES:
     case messaging_verb::REPAIR_GET_COMBINED_ROW_HASH:
     case messaging_verb::REPAIR_GET_SYNC_BOUNDARY:
-    case messaging_verb::REPAIR_GET_ROW_DIFF:
-    case messaging_verb::REPAIR_PUT_ROW_DIFF:
     case messaging_verb::REPAIR_GET_ESTIMATED_PARTITIONS:
     case messaging_verb::REPAIR_SET_ESTIMATED_PARTITIONS:
     case messaging_verb::REPAIR_GET_DIFF_ALGORITHMS:
+    case messaging_verb::NODE_OPS_CMD:
+        return 1;
+    // Bulk data movers: whole sstables, mutation fragment streams, repair
+    // row diffs and hint replay. The RPC-stream setup verbs go here too, so
+    // the streams they create inherit this connection class.
+    case messaging_verb::STREAM_MUTATION_FRAGMENTS:
+    case messaging_verb::STREAM_SSTABLE_FILES:
+    case messaging_verb::REPAIR_GET_ROW_DIFF:
+    case messaging_verb::REPAIR_PUT_ROW_DIFF:
     case messaging_verb::REPAIR_GET_ROW_DIFF_WITH_RPC_STREAM:
     case messaging_verb::REPAIR_PUT_ROW_DIFF_WITH_RPC_STREAM:
     case messaging_verb::REPAIR_GET_FULL_ROW_HASHES_WITH_RPC_STREAM:
-    case messaging_verb::NODE_OPS_CMD:
     case messaging_verb::HINT_MUTATION:
-        return 1;
+    case messaging_verb::HINT_MUTATION_BATCH:
+        return 2;
     case messaging_verb::CLIENT_ID:
     case messaging_verb::MUTATION:
+    case messaging_verb::MUTATION_BATCH:
     case messaging_verb::READ_DATA:
     case messaging_verb::READ_MUTATION_DATA:
     case messaging_verb::READ_DIGEST:
@@ -499,10 +554,10 @@ static constexpr unsigned do_get_rpc_client_idx(messaging_verb verb) {
     case messaging_verb::RAFT_EXECUTE_READ_BARRIER_ON_LEADER:
     case messaging_verb::RAFT_ADD_ENTRY:
     case messaging_verb::RAFT_MODIFY_CONFIG:
-        return 2;
+        return 3;
     case messaging_verb::MUTATION_DONE:
     case messaging_verb::MUTATION_FAILED:
-        return 3;
+        return 4;
     case messaging_verb::LAST:
         return -1; // should never happen
     }
@@ -522,7 +577,7 @@ unsigned
 messaging_service::get_rpc_client_idx(messaging_verb verb) const {
     auto idx = s_rpc_client_idx_table[static_cast<size_t>(verb)];
 
-    if (idx < 2) {
+    if (idx < 3) {
         return idx;
     }
 
@@ -530,7 +585,7 @@ messaging_service::get_rpc_client_idx(messaging_verb verb) const {
     const auto curr_sched_group = current_scheduling_group();
     for (unsigned i = 0; i < _connection_index_for_tenant.size(); ++i) {
         if (_connection_index_for_tenant[i].sched_group == curr_sched_group) {
-            // i == 0: the default tenant maps to the default client indexes of 2 and 3.
+            // i == 0: the default tenant maps to the default client indexes of 3 and 4.
             idx += i * 2;
             break;
         }
@@ -546,6 +601,7 @@ messaging_service::initial_scheduling_info() const {
     auto sched_infos = std::vector<scheduling_info_for_connection_index>({
         { _scheduling_config.gossip, "gossip" },
         { _scheduling_config.streaming, "streaming", },
+        { _scheduling_config.streaming, "streaming-bulk", },
     });
     sched_infos.reserve(sched_infos.size() + _scheduling_config.statement_tenants.size() * 2);
     for (const auto& tenant : _scheduling_config.statement_tenants) {
@@ -620,6 +676,22 @@ void messaging_service::cache_preferred_ip(gms::inet_address ep, gms::inet_addre
     _preferred_ip_cache[ep] = ip;
 }
 
+void messaging_service::warm_up_connections(msg_addr id) {
+    if (_shutting_down) {
+        return;
+    }
+    // One representative verb per connection index. Creating the client
+    // starts TCP connect and protocol negotiation in the background; if a
+    // client for the index already exists and is healthy this is a no-op.
+    // The statement verbs are resolved against the current (default)
+    // scheduling group, which covers the connections foreground traffic
+    // will use.
+    for (auto verb : {messaging_verb::GOSSIP_ECHO, messaging_verb::STREAM_MUTATION_DONE,
+                      messaging_verb::HINT_MUTATION, messaging_verb::MUTATION, messaging_verb::MUTATION_DONE}) {
+        get_rpc_client(verb, id);
+    }
+}
+
 shared_ptr<messaging_service::rpc_protocol_client_wrapper> messaging_service::get_rpc_client(messaging_verb verb, msg_addr id) {
     assert(!_shutting_down);
     auto idx = get_rpc_client_idx(verb);
@@ -692,12 +764,15 @@ shared_ptr<messaging_service::rpc_protocol_client_wrapper> messaging_service::ge
     // send keepalive messages each minute if connection is idle, drop connection after 10 failures
     opts.keepalive = std::optional<net::tcp_keepalive_params>({60s, 60s, 10});
     if (must_compress) {
-        opts.compressor_factory = &compressor_factory;
+        // idx 2 carries the bulk streaming and repair data verbs; their
+        // payloads are highly self-similar row data, which is what the
+        // dictionary compressor is trained for.
+        opts.compressor_factory = (_cfg.compress_streaming_dict && idx == 2) ? &streaming_compressor_factory : &compressor_factory;
     }
     opts.tcp_nodelay = must_tcp_nodelay;
     opts.reuseaddr = true;
     // We send cookies only for non-default statement tenant clients.
-    if (idx > 3) {
+    if (idx > 4) {
         opts.isolation_cookie = _scheduling_info_for_connection_index[idx].isolation_cookie;
     }
 
@@ -793,6 +868,35 @@ future<> messaging_service::unregister_stream_mutation_fragments() {
     return unregister_handler(messaging_verb::STREAM_MUTATION_FRAGMENTS);
 }
 
+rpc::sink<int32_t> messaging_service::make_sink_for_stream_sstable_files(rpc::source<sstring, bytes, rpc::optional<streaming::stream_files_cmd>>& source) {
+    return source.make_sink<netw::serializer, int32_t>();
+}
+
+future<std::tuple<rpc::sink<sstring, bytes, streaming::stream_files_cmd>, rpc::source<int32_t>>>
+messaging_service::make_sink_and_source_for_stream_sstable_files(utils::UUID plan_id, utils::UUID cf_id, unsigned sender_shard, unsigned sender_shard_count, unsigned sender_ignore_msb, streaming::stream_reason reason, msg_addr id) {
+    using value_type = std::tuple<rpc::sink<sstring, bytes, streaming::stream_files_cmd>, rpc::source<int32_t>>;
+    if (is_shutting_down()) {
+        return make_exception_future<value_type>(rpc::closed_error());
+    }
+    auto rpc_client = get_rpc_client(messaging_verb::STREAM_SSTABLE_FILES, id);
+    return rpc_client->make_stream_sink<netw::serializer, sstring, bytes, streaming::stream_files_cmd>().then([this, plan_id, cf_id, sender_shard, sender_shard_count, sender_ignore_msb, reason, rpc_client] (rpc::sink<sstring, bytes, streaming::stream_files_cmd> sink) mutable {
+        auto rpc_handler = rpc()->make_client<rpc::source<int32_t> (utils::UUID, utils::UUID, unsigned, unsigned, unsigned, streaming::stream_reason, rpc::sink<sstring, bytes, streaming::stream_files_cmd>)>(messaging_verb::STREAM_SSTABLE_FILES);
+        return rpc_handler(*rpc_client, plan_id, cf_id, sender_shard, sender_shard_count, sender_ignore_msb, reason, sink).then_wrapped([sink, rpc_client] (future<rpc::source<int32_t>> source) mutable {
+            return (source.failed() ? sink.close() : make_ready_future<>()).then([sink = std::move(sink), source = std::move(source)] () mutable {
+                return make_ready_future<value_type>(value_type(std::move(sink), source.get0()));
+            });
+        });
+    });
+}
+
+void messaging_service::register_stream_sstable_files(std::function<future<rpc::sink<int32_t>> (const rpc::client_info& cinfo, UUID plan_id, UUID cf_id, unsigned sender_shard, unsigned sender_shard_count, unsigned sender_ignore_msb, streaming::stream_reason reason, rpc::source<sstring, bytes, rpc::optional<streaming::stream_files_cmd>> source)>&& func) {
+    register_handler(this, messaging_verb::STREAM_SSTABLE_FILES, std::move(func));
+}
+
+future<> messaging_service::unregister_stream_sstable_files() {
+    return unregister_handler(messaging_verb::STREAM_SSTABLE_FILES);
+}
+
 template<class SinkType, class SourceType>
 future<std::tuple<rpc::sink<SinkType>, rpc::source<SourceType>>>
 do_make_sink_source(messaging_verb verb, uint32_t repair_meta_id, shared_ptr<messaging_service::rpc_protocol_client_wrapper> rpc_client, std::unique_ptr<messaging_service::rpc_protocol_wrapper>& rpc) {
@@ -1330,6 +1434,29 @@ future<> messaging_service::send_hint_mutation(msg_addr id, clock_type::time_poi
         std::move(reply_to), shard, std::move(response_id), std::move(trace_info));
 }
 
+void messaging_service::register_hint_mutation_batch(std::function<future<> (const rpc::client_info&, rpc::opt_time_point, std::vector<frozen_mutation> fms)>&& func) {
+    register_handler(this, netw::messaging_verb::HINT_MUTATION_BATCH, std::move(func));
+}
+future<> messaging_service::unregister_hint_mutation_batch() {
+    return unregister_handler(netw::messaging_verb::HINT_MUTATION_BATCH);
+}
+future<> messaging_service::send_hint_mutation_batch(msg_addr id, clock_type::time_point timeout, std::vector<frozen_mutation> fms) {
+    return send_message_timeout<void>(this, messaging_verb::HINT_MUTATION_BATCH, std::move(id), timeout, std::move(fms));
+}
+
+void messaging_service::register_mutation_batch(std::function<future<rpc::no_wait_type> (const rpc::client_info&, rpc::opt_time_point, std::vector<frozen_mutation> fms,
+        inet_address reply_to, unsigned shard, std::vector<response_id_type> response_ids)>&& func) {
+    register_handler(this, netw::messaging_verb::MUTATION_BATCH, std::move(func));
+}
+future<> messaging_service::unregister_mutation_batch() {
+    return unregister_handler(netw::messaging_verb::MUTATION_BATCH);
+}
+future<> messaging_service::send_mutation_batch(msg_addr id, clock_type::time_point timeout, std::vector<frozen_mutation> fms,
+        inet_address reply_to, unsigned shard, std::vector<response_id_type> response_ids) {
+    return send_message_oneway_timeout(this, timeout, messaging_verb::MUTATION_BATCH, std::move(id), std::move(fms),
+        std::move(reply_to), shard, std::move(response_ids));
+}
+
 void messaging_service::register_raft_send_snapshot(std::function<future<raft::snapshot_reply> (const rpc::client_info&, rpc::opt_time_point, raft::group_id gid, raft::server_id from_id, raft::server_id dst_id, raft::install_snapshot)>&& func) {
    register_handler(this, netw::messaging_verb::RAFT_SEND_SNAPSHOT, std::move(func));
 }
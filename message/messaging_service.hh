@@ -29,6 +29,7 @@
 #include "gms/inet_address.hh"
 #include "inet_address_vectors.hh"
 #include <seastar/rpc/rpc_types.hh>
+#include <seastar/core/metrics_registration.hh>
 #include <unordered_map>
 #include "query-request.hh"
 #include "mutation_query.hh"
@@ -38,6 +39,7 @@
 #include "digest_algorithm.hh"
 #include "streaming/stream_reason.hh"
 #include "streaming/stream_mutation_fragments_cmd.hh"
+#include "streaming/stream_files_cmd.hh"
 #include "cache_temperature.hh"
 #include "service/paxos/prepare_response.hh"
 #include "raft/raft.hh"
@@ -161,7 +163,10 @@ enum class messaging_verb : int32_t {
     RAFT_MODIFY_CONFIG = 56,
     GROUP0_PEER_EXCHANGE = 57,
     GROUP0_MODIFY_CONFIG = 58,
-    LAST = 59,
+    HINT_MUTATION_BATCH = 59,
+    MUTATION_BATCH = 60,
+    STREAM_SSTABLE_FILES = 61,
+    LAST = 62,
 };
 
 } // namespace netw
@@ -241,6 +246,9 @@ public:
         uint16_t ssl_port = 0;
         encrypt_what encrypt = encrypt_what::none;
         compress_what compress = compress_what::none;
+        // When compression applies, also offer dictionary-training zstd
+        // compression on streaming and repair connections.
+        bool compress_streaming_dict = false;
         tcp_nodelay_what tcp_nodelay = tcp_nodelay_what::all;
         bool listen_on_broadcast_address = false;
         size_t rpc_memory_limit = 1'000'000;
@@ -287,6 +295,7 @@ private:
     scheduling_config _scheduling_config;
     std::vector<scheduling_info_for_connection_index> _scheduling_info_for_connection_index;
     std::vector<tenant_connection_index> _connection_index_for_tenant;
+    seastar::metrics::metric_groups _metrics;
 
     future<> stop_tls_server();
     future<> stop_nontls_server();
@@ -331,6 +340,18 @@ public:
     rpc::sink<int32_t> make_sink_for_stream_mutation_fragments(rpc::source<frozen_mutation_fragment, rpc::optional<streaming::stream_mutation_fragments_cmd>>& source);
     future<std::tuple<rpc::sink<frozen_mutation_fragment, streaming::stream_mutation_fragments_cmd>, rpc::source<int32_t>>> make_sink_and_source_for_stream_mutation_fragments(utils::UUID schema_id, utils::UUID plan_id, utils::UUID cf_id, uint64_t estimated_partitions, streaming::stream_reason reason, msg_addr id);
 
+    // Wrapper for STREAM_SSTABLE_FILES
+    // Carries whole sstable component files, chunk by chunk. Each sink message is
+    // (component basename, chunk, cmd). The receiver sends status codes over the
+    // reverse direction: the first one acks the request (0 means proceed, -2 means
+    // the receiver cannot accept files for this table and the sender should fall
+    // back to mutation-based streaming), the final one reports the outcome
+    // (0 means success, -1 means error).
+    void register_stream_sstable_files(std::function<future<rpc::sink<int32_t>> (const rpc::client_info& cinfo, UUID plan_id, UUID cf_id, unsigned sender_shard, unsigned sender_shard_count, unsigned sender_ignore_msb, streaming::stream_reason reason, rpc::source<sstring, bytes, rpc::optional<streaming::stream_files_cmd>> source)>&& func);
+    future<> unregister_stream_sstable_files();
+    rpc::sink<int32_t> make_sink_for_stream_sstable_files(rpc::source<sstring, bytes, rpc::optional<streaming::stream_files_cmd>>& source);
+    future<std::tuple<rpc::sink<sstring, bytes, streaming::stream_files_cmd>, rpc::source<int32_t>>> make_sink_and_source_for_stream_sstable_files(utils::UUID plan_id, utils::UUID cf_id, unsigned sender_shard, unsigned sender_shard_count, unsigned sender_ignore_msb, streaming::stream_reason reason, msg_addr id);
+
     // Wrapper for REPAIR_GET_ROW_DIFF_WITH_RPC_STREAM
     future<std::tuple<rpc::sink<repair_hash_with_cmd>, rpc::source<repair_row_on_wire_with_cmd>>> make_sink_and_source_for_repair_get_row_diff_with_rpc_stream(uint32_t repair_meta_id, msg_addr id);
     rpc::sink<repair_row_on_wire_with_cmd> make_sink_for_repair_get_row_diff_with_rpc_stream(rpc::source<repair_hash_with_cmd>& source);
@@ -559,6 +580,20 @@ public:
     future<> send_hint_mutation(msg_addr id, clock_type::time_point timeout, const frozen_mutation& fm, inet_address_vector_replica_set forward,
         inet_address reply_to, unsigned shard, response_id_type response_id, std::optional<tracing::trace_info> trace_info = std::nullopt);
 
+    // Wrapper for HINT_MUTATION_BATCH
+    void register_hint_mutation_batch(std::function<future<> (const rpc::client_info&, rpc::opt_time_point, std::vector<frozen_mutation> fms)>&& func);
+    future<> unregister_hint_mutation_batch();
+    future<> send_hint_mutation_batch(msg_addr id, clock_type::time_point timeout, std::vector<frozen_mutation> fms);
+
+    // Wrapper for MUTATION_BATCH
+    // Several coalesced mutations for the same replica, acknowledged individually
+    // (with MUTATION_DONE/MUTATION_FAILED per response id) just like MUTATION.
+    void register_mutation_batch(std::function<future<rpc::no_wait_type> (const rpc::client_info&, rpc::opt_time_point, std::vector<frozen_mutation> fms,
+        inet_address reply_to, unsigned shard, std::vector<response_id_type> response_ids)>&& func);
+    future<> unregister_mutation_batch();
+    future<> send_mutation_batch(msg_addr id, clock_type::time_point timeout, std::vector<frozen_mutation> fms,
+        inet_address reply_to, unsigned shard, std::vector<response_id_type> response_ids);
+
     // RAFT verbs
     void register_raft_send_snapshot(std::function<future<raft::snapshot_reply> (const rpc::client_info&, rpc::opt_time_point, raft::group_id, raft::server_id from_id, raft::server_id dst_id, raft::install_snapshot)>&& func);
     future<> unregister_raft_send_snapshot();
@@ -619,6 +654,10 @@ private:
 public:
     // Return rpc::protocol::client for a shard which is a ip + cpuid pair.
     shared_ptr<rpc_protocol_client_wrapper> get_rpc_client(messaging_verb verb, msg_addr id);
+    // Eagerly creates the RPC clients used to talk to the given endpoint,
+    // so connection setup and negotiation happen in the background instead
+    // of being paid by the first foreground request.
+    void warm_up_connections(msg_addr id);
     void remove_error_rpc_client(messaging_verb verb, msg_addr id);
     void remove_rpc_client(msg_addr id);
     connection_drop_registration_t when_connection_drops(connection_drop_slot_t& slot) {
@@ -0,0 +1,258 @@
+/*
+ * Copyright (C) 2021-present ScyllaDB
+ */
+
+/*
+ * This file is part of Scylla.
+ *
+ * Scylla is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Scylla is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Scylla.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <vector>
+
+#include <zstd.h>
+#include <zdict.h>
+
+#include <seastar/core/byteorder.hh>
+#include <seastar/core/print.hh>
+#include <seastar/core/temporary_buffer.hh>
+
+#include "message/stream_compressor.hh"
+#include "log.hh"
+#include "seastarx.hh"
+
+namespace netw {
+
+static logging::logger sclog("stream_compressor");
+
+static const sstring STREAM_COMPRESSOR_NAME = "ZSTD_DICT";
+
+// Wire format: every message starts with a one byte frame type.
+//
+//   plain:         [type][zstd frame]
+//   with_dict:     [type][zstd frame compressed with the connection dictionary]
+//   dict_delivery: [type][uint32_t dict_len (le)][dictionary][zstd frame
+//                  compressed with the dictionary]
+//
+// Each direction of a connection is independent: the sender trains a
+// dictionary on the data it compresses and delivers it in-band, so no
+// handshake beyond the rpc compression feature negotiation is needed.
+// Messages on an rpc connection are framed and ordered, so the dictionary is
+// always seen by the receiver before any with_dict frame that uses it.
+enum class frame_type : uint8_t {
+    plain = 0,
+    with_dict = 1,
+    dict_delivery = 2,
+};
+
+// How much outgoing data is sampled before training, and how it is sliced
+// into samples. Training is a one-off synchronous cost per connection, so the
+// budget is kept small; fastcover on 2MB takes a few tens of milliseconds.
+static constexpr size_t sample_budget = 2 * 1024 * 1024;
+static constexpr size_t sample_slice_size = 4 * 1024;
+static constexpr size_t max_dict_size = 16 * 1024;
+static constexpr int compression_level = 3;
+
+class zstd_dict_compressor final : public rpc::compressor {
+    struct cctx_deleter { void operator()(ZSTD_CCtx* c) const { ZSTD_freeCCtx(c); } };
+    struct dctx_deleter { void operator()(ZSTD_DCtx* d) const { ZSTD_freeDCtx(d); } };
+    struct cdict_deleter { void operator()(ZSTD_CDict* d) const { ZSTD_freeCDict(d); } };
+    struct ddict_deleter { void operator()(ZSTD_DDict* d) const { ZSTD_freeDDict(d); } };
+
+    std::unique_ptr<ZSTD_CCtx, cctx_deleter> _cctx;
+    std::unique_ptr<ZSTD_DCtx, dctx_deleter> _dctx;
+
+    // Outgoing direction: samples of sent data, and once trained, the
+    // dictionary and its digested form.
+    std::vector<char> _samples;
+    std::vector<size_t> _sample_sizes;
+    bool _training_done = false;
+    std::vector<char> _dict;
+    bool _dict_sent = false;
+    std::unique_ptr<ZSTD_CDict, cdict_deleter> _cdict;
+
+    // Incoming direction: the dictionary delivered by the peer, if any.
+    std::unique_ptr<ZSTD_DDict, ddict_deleter> _ddict;
+private:
+    void sample(const char* data, size_t size);
+    void train();
+public:
+    zstd_dict_compressor();
+    rpc::snd_buf compress(size_t head_space, rpc::snd_buf data) override;
+    rpc::rcv_buf decompress(rpc::rcv_buf data) override;
+};
+
+zstd_dict_compressor::zstd_dict_compressor()
+    : _cctx(ZSTD_createCCtx())
+    , _dctx(ZSTD_createDCtx()) {
+    if (!_cctx || !_dctx) {
+        throw std::bad_alloc();
+    }
+}
+
+// The rpc compressor interface works on whole messages, so compressing and
+// decompressing with contiguous input/output is fine - like seastar's own
+// rpc::lz4_compressor does, fragmented buffers are linearized first.
+template <typename Buf>
+static temporary_buffer<char> linearize(Buf& input) {
+    if (auto* buf = std::get_if<temporary_buffer<char>>(&input.bufs)) {
+        return buf->share();
+    }
+    temporary_buffer<char> out(input.size);
+    char* dst = out.get_write();
+    for (auto& b : std::get<std::vector<temporary_buffer<char>>>(input.bufs)) {
+        dst = std::copy_n(b.get(), b.size(), dst);
+    }
+    return out;
+}
+
+void zstd_dict_compressor::sample(const char* data, size_t size) {
+    while (size && _samples.size() < sample_budget) {
+        auto n = std::min({size, sample_slice_size, sample_budget - _samples.size()});
+        _samples.insert(_samples.end(), data, data + n);
+        _sample_sizes.push_back(n);
+        data += n;
+        size -= n;
+    }
+    if (_samples.size() == sample_budget) {
+        train();
+    }
+}
+
+void zstd_dict_compressor::train() {
+    _training_done = true;
+    std::vector<char> dict(max_dict_size);
+    auto n = ZDICT_trainFromBuffer(dict.data(), dict.size(), _samples.data(), _sample_sizes.data(), _sample_sizes.size());
+    _samples = {};
+    _sample_sizes = {};
+    if (ZDICT_isError(n)) {
+        // Can happen on degenerate inputs (e.g. incompressible data); just
+        // keep compressing without a dictionary.
+        sclog.debug("dictionary training failed: {}", ZDICT_getErrorName(n));
+        return;
+    }
+    dict.resize(n);
+    _cdict.reset(ZSTD_createCDict(dict.data(), dict.size(), compression_level));
+    if (!_cdict) {
+        sclog.debug("failed to digest trained dictionary, continuing without one");
+        return;
+    }
+    _dict = std::move(dict);
+    sclog.debug("trained a {} byte dictionary", _dict.size());
+}
+
+rpc::snd_buf zstd_dict_compressor::compress(size_t head_space, rpc::snd_buf data) {
+    auto src = linearize(data);
+    if (!_training_done) {
+        sample(src.get(), src.size());
+    }
+    const bool deliver_dict = _cdict && !_dict_sent;
+    const size_t prefix = 1 + (deliver_dict ? sizeof(uint32_t) + _dict.size() : 0);
+    temporary_buffer<char> out(head_space + prefix + ZSTD_compressBound(src.size()));
+    char* p = out.get_write() + head_space;
+    if (deliver_dict) {
+        *p++ = static_cast<char>(frame_type::dict_delivery);
+        write_le<uint32_t>(p, _dict.size());
+        p += sizeof(uint32_t);
+        p = std::copy_n(_dict.data(), _dict.size(), p);
+    } else {
+        *p++ = static_cast<char>(_cdict ? frame_type::with_dict : frame_type::plain);
+    }
+    const size_t avail = out.size() - head_space - prefix;
+    size_t ret;
+    if (_cdict) {
+        ret = ZSTD_compress_usingCDict(_cctx.get(), p, avail, src.get(), src.size(), _cdict.get());
+    } else {
+        ret = ZSTD_compressCCtx(_cctx.get(), p, avail, src.get(), src.size(), compression_level);
+    }
+    if (ZSTD_isError(ret)) {
+        throw std::runtime_error(format("rpc frame compression failure: {}", ZSTD_getErrorName(ret)));
+    }
+    if (deliver_dict) {
+        _dict_sent = true;
+    }
+    out.trim(head_space + prefix + ret);
+    return rpc::snd_buf(std::move(out));
+}
+
+rpc::rcv_buf zstd_dict_compressor::decompress(rpc::rcv_buf data) {
+    auto src = linearize(data);
+    if (src.empty()) {
+        throw std::runtime_error("rpc frame decompression failure: empty frame");
+    }
+    auto type = static_cast<frame_type>(src[0]);
+    const char* p = src.get() + 1;
+    size_t remaining = src.size() - 1;
+    if (type == frame_type::dict_delivery) {
+        if (remaining < sizeof(uint32_t)) {
+            throw std::runtime_error("rpc frame decompression failure: truncated dictionary frame");
+        }
+        auto dict_len = read_le<uint32_t>(p);
+        p += sizeof(uint32_t);
+        remaining -= sizeof(uint32_t);
+        if (dict_len > remaining) {
+            throw std::runtime_error("rpc frame decompression failure: truncated dictionary frame");
+        }
+        _ddict.reset(ZSTD_createDDict(p, dict_len));
+        if (!_ddict) {
+            throw std::bad_alloc();
+        }
+        p += dict_len;
+        remaining -= dict_len;
+        type = frame_type::with_dict;
+    } else if (type == frame_type::with_dict && !_ddict) {
+        throw std::runtime_error("rpc frame decompression failure: no dictionary received");
+    } else if (type != frame_type::plain && type != frame_type::with_dict) {
+        throw std::runtime_error(format("rpc frame decompression failure: unknown frame type {:d}", src[0]));
+    }
+    auto content_size = ZSTD_getFrameContentSize(p, remaining);
+    if (content_size == ZSTD_CONTENTSIZE_UNKNOWN || content_size == ZSTD_CONTENTSIZE_ERROR
+            || content_size > std::numeric_limits<uint32_t>::max()) {
+        throw std::runtime_error("rpc frame decompression failure: invalid content size");
+    }
+    temporary_buffer<char> out(content_size);
+    size_t ret;
+    if (type == frame_type::with_dict) {
+        ret = ZSTD_decompress_usingDDict(_dctx.get(), out.get_write(), out.size(), p, remaining, _ddict.get());
+    } else {
+        ret = ZSTD_decompressDCtx(_dctx.get(), out.get_write(), out.size(), p, remaining);
+    }
+    if (ZSTD_isError(ret) || ret != content_size) {
+        throw std::runtime_error(format("rpc frame decompression failure: {}",
+                ZSTD_isError(ret) ? ZSTD_getErrorName(ret) : "size mismatch"));
+    }
+    auto size = out.size();
+    return rpc::rcv_buf(std::move(out), size);
+}
+
+class zstd_dict_compressor_factory final : public rpc::compressor::factory {
+public:
+    const sstring& supported() const override {
+        return STREAM_COMPRESSOR_NAME;
+    }
+    std::unique_ptr<rpc::compressor> negotiate(sstring feature, bool is_server) const override {
+        return feature == STREAM_COMPRESSOR_NAME ? std::make_unique<zstd_dict_compressor>() : nullptr;
+    }
+};
+
+rpc::compressor::factory& stream_compressor_factory() {
+    static zstd_dict_compressor_factory factory;
+    return factory;
+}
+
+}
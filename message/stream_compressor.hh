@@ -0,0 +1,37 @@
+/*
+ * Copyright (C) 2021-present ScyllaDB
+ */
+
+/*
+ * This file is part of Scylla.
+ *
+ * Scylla is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Scylla is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Scylla.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <seastar/rpc/rpc_types.hh>
+
+namespace netw {
+
+// Factory for the dictionary-training zstd RPC connection compressor used on
+// streaming and repair connections. Each side of a connection trains a small
+// zstd dictionary on the first megabytes it sends, ships it to the peer
+// in-band and compresses the rest of the session with it. Row data within a
+// table is highly self-similar, so small RPC frames compress considerably
+// better against such a dictionary than with the generic LZ4 compressors.
+// See stream_compressor.cc for the frame format.
+seastar::rpc::compressor::factory& stream_compressor_factory();
+
+}
@@ -650,7 +650,11 @@ future<page_consume_result<ResultBuilder>> read_page(
             tracing::trace_state_ptr trace_state,
             streamed_mutation::forwarding,
             mutation_reader::forwarding fwd_mr) {
-        return make_multishard_combining_reader(ctx, std::move(s), std::move(permit), pr, ps, pc, std::move(trace_state), fwd_mr);
+        // Speculative read-aheads to the shards we expect to visit next only
+        // pay off if we actually get there; a query that stops at the first
+        // row would just throw their buffers away.
+        const auto read_ahead = cmd.get_row_limit() > 1 ? multishard_reader_read_ahead::yes : multishard_reader_read_ahead::no;
+        return make_multishard_combining_reader(ctx, std::move(s), std::move(permit), pr, ps, pc, std::move(trace_state), fwd_mr, read_ahead);
     });
     auto compaction_state = make_lw_shared<compact_for_result_state<ResultBuilder>>(*s, cmd.timestamp, cmd.slice, cmd.get_row_limit(),
             cmd.partition_limit);
@@ -301,7 +301,12 @@ public:
     template <typename Consumer, typename GCConsumer>
     requires CompactedFragmentsConsumer<Consumer> && CompactedFragmentsConsumer<GCConsumer>
     stop_iteration consume(static_row&& sr, Consumer& consumer, GCConsumer& gc_consumer) {
-        _last_static_row = static_row(_schema, sr);
+        if constexpr (!sstable_compaction()) {
+            // Save the static row for start_new_page()/detach_state(), which
+            // re-establish it when the read is resumed on the next page.
+            // SSTable compaction never pages so it doesn't need the copy.
+            _last_static_row = static_row(_schema, sr);
+        }
         auto current_tombstone = _range_tombstones.get_partition_tombstone();
         if constexpr (sstable_compaction()) {
             _collector->start_collecting_static_row();
@@ -463,6 +468,7 @@ public:
             gc_clock::time_point query_time,
             mutation_fragment::kind next_fragment_kind,
             Consumer& consumer) {
+        static_assert(!sstable_compaction(), "Cannot be used for sstable compaction.");
         _empty_partition = true;
         _static_row_live = false;
         _row_limit = row_limit;
@@ -493,6 +499,7 @@ public:
     /// is (given the same outside parameters of course). Practically this
     /// allows the compaction state to be stored in the compacted reader.
     detached_compaction_state detach_state() && {
+        static_assert(!sstable_compaction(), "Cannot be used for sstable compaction.");
         partition_start ps(std::move(_last_dk), _range_tombstones.get_partition_tombstone());
         return {std::move(ps), std::move(_last_static_row), std::move(_range_tombstones).range_tombstones()};
     }
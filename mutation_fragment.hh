@@ -295,6 +295,10 @@ private:
         data(reader_permit permit) :  _memory(permit.consume_memory()) { }
         ~data() { }
 
+        // Recycled through a per-shard pool, see mutation_fragment.cc.
+        static void* operator new(size_t size);
+        static void operator delete(void* ptr) noexcept;
+
         reader_permit::resource_units _memory;
         union {
             static_row _static_row;
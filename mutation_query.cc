@@ -21,6 +21,7 @@
 
 #include "mutation_query.hh"
 #include "gc_clock.hh"
+#include "utils/stall_free.hh"
 #include "mutation_partition_serializer.hh"
 #include "service/priority_manager.hh"
 #include "query-result-writer.hh"
@@ -54,6 +55,10 @@ utils::chunked_vector<partition>& reconcilable_result::partitions() {
     return _partitions;
 }
 
+future<> reconcilable_result::clear_gently() noexcept {
+    return utils::clear_gently(_partitions);
+}
+
 bool
 reconcilable_result::operator==(const reconcilable_result& other) const {
     return boost::equal(_partitions, other._partitions);
@@ -69,6 +69,10 @@ struct partition {
         return _m;
     }
 
+    future<> clear_gently() noexcept {
+        return _m.clear_gently();
+    }
+
 
     bool operator==(const partition& other) const {
         return row_count() == other.row_count() && _m.representation() == other._m.representation();
@@ -102,6 +106,10 @@ public:
     const utils::chunked_vector<partition>& partitions() const;
     utils::chunked_vector<partition>& partitions();
 
+    // Frees the partitions one by one, yielding in between, so that dropping
+    // a large result doesn't stall the reactor.
+    future<> clear_gently() noexcept;
+
     uint32_t row_count_low_bits() const {
         return _row_count_low_bits;
     }
@@ -160,10 +160,16 @@ public:
     struct reader_and_fragment {
         reader_iterator reader{};
         mutation_fragment fragment;
+        // The fragment's position, cached to spare the heap comparators a
+        // fragment-kind dispatch per comparison. The view stays valid when
+        // this struct is moved around the heaps, since the fragment's
+        // underlying data does not move.
+        position_in_partition_view position;
 
         reader_and_fragment(reader_iterator r, mutation_fragment f)
             : reader(r)
-            , fragment(std::move(f)) {
+            , fragment(std::move(f))
+            , position(fragment.position()) {
         }
     };
 
@@ -343,7 +349,7 @@ struct mutation_reader_merger::fragment_heap_compare {
 
     bool operator()(const mutation_reader_merger::reader_and_fragment& a, const mutation_reader_merger::reader_and_fragment& b) {
         // Invert comparison as this is a max-heap.
-        return cmp(b.fragment.position(), a.fragment.position());
+        return cmp(b.position, a.position);
     }
 };
 
@@ -392,7 +398,7 @@ future<mutation_reader_merger::needs_merge> mutation_reader_merger::prepare_one(
                 if (reader_galloping) {
                     // Optimization: assume that galloping reader will keep winning, and compare directly with the heap front.
                     // If this assumption is correct, we do one key comparison instead of pushing to/popping from the heap.
-                    if (_fragment_heap.empty() || position_in_partition::less_compare(*_schema)(mfo->position(), _fragment_heap.front().fragment.position())) {
+                    if (_fragment_heap.empty() || position_in_partition::less_compare(*_schema)(mfo->position(), _fragment_heap.front().position)) {
                         _current.clear();
                         _current.push_back(std::move(*mfo));
                         _galloping_reader.last_kind = _current.back().mutation_fragment_kind();
@@ -536,15 +542,18 @@ future<mutation_fragment_batch> mutation_reader_merger::operator()() {
     }
 
     const auto equal = position_in_partition::equal_compare(*_schema);
+    // Overwritten by the first iteration below; any valid view will do here.
+    position_in_partition_view winner_position = position_in_partition_view::for_static_row();
     do {
         boost::range::pop_heap(_fragment_heap, fragment_heap_compare(*_schema));
         auto& n = _fragment_heap.back();
         const auto kind = n.fragment.mutation_fragment_kind();
+        winner_position = n.position;
         _current.emplace_back(std::move(n.fragment));
         _next.emplace_back(n.reader, kind);
         _fragment_heap.pop_back();
     }
-    while (!_fragment_heap.empty() && equal(_current.back().position(), _fragment_heap.front().fragment.position()));
+    while (!_fragment_heap.empty() && equal(winner_position, _fragment_heap.front().position));
 
     if (_next.size() == 1 && _next.front().reader == _galloping_reader.reader) {
         ++_gallop_mode_hits;
@@ -779,6 +788,13 @@ class foreign_reader : public flat_mutation_reader::impl {
     foreign_unique_ptr<flat_mutation_reader> _reader;
     foreign_unique_ptr<future<>> _read_ahead_future;
     streamed_mutation::forwarding _fwd_sm;
+    // Cap on the amount of fragment data moved across shards per transfer.
+    // Starts at one reader buffer's worth and doubles whenever the consumer
+    // drains a full batch, so fast multishard scans move fragments in
+    // progressively larger blocks, amortizing the cross-shard hops, while
+    // slow or short reads keep the smaller, lower-latency batches.
+    static constexpr size_t max_transfer_size = 128 * 1024;
+    size_t _transfer_size = default_max_buffer_size_in_bytes();
 
     // Forward an operation to the reader on the remote shard.
     // If the remote reader has an ongoing read-ahead, bring it to the
@@ -850,17 +866,44 @@ future<> foreign_reader::fill_buffer() {
         return make_ready_future();
     }
 
-    return forward_operation([reader = _reader.get()] () {
-        auto f = reader->is_buffer_empty() ? reader->fill_buffer() : make_ready_future<>();
-        return f.then([=] {
-            return make_ready_future<remote_fill_buffer_result>(remote_fill_buffer_result(reader->detach_buffer(), reader->is_end_of_stream()));
+    const auto max_bytes = _transfer_size;
+    return forward_operation([reader = _reader.get(), max_bytes] () {
+        // Accumulate up to max_bytes worth of fragments before transferring
+        // them, refilling the remote reader's buffer as many times as needed.
+        return do_with(fragment_buffer(tracking_allocator<mutation_fragment>(reader->permit())), size_t(0),
+                [reader, max_bytes] (fragment_buffer& batch, size_t& batch_size) {
+            return repeat([reader, max_bytes, &batch, &batch_size] {
+                if (reader->is_buffer_empty()) {
+                    if (reader->is_end_of_stream()) {
+                        return make_ready_future<stop_iteration>(stop_iteration::yes);
+                    }
+                    return reader->fill_buffer().then([] { return stop_iteration::no; });
+                }
+                while (!reader->is_buffer_empty() && batch_size < max_bytes) {
+                    auto mf = reader->pop_mutation_fragment();
+                    batch_size += mf.memory_usage();
+                    batch.emplace_back(std::move(mf));
+                }
+                return make_ready_future<stop_iteration>(stop_iteration(batch_size >= max_bytes));
+            }).then([reader, &batch] {
+                return make_ready_future<remote_fill_buffer_result>(
+                        remote_fill_buffer_result(std::move(batch), reader->is_end_of_stream() && reader->is_buffer_empty()));
+            });
         });
-    }).then([this] (remote_fill_buffer_result res) mutable {
+    }).then([this, max_bytes] (remote_fill_buffer_result res) mutable {
         _end_of_stream = res.end_of_stream;
+        size_t batch_size = 0;
         for (const auto& mf : *res.buffer) {
+            batch_size += mf.memory_usage();
             // Need a copy since the mf is on the remote shard.
             push_mutation_fragment(mutation_fragment(*_schema, _permit, mf));
         }
+        // The consumer drained a full batch and there is more to read: it is
+        // outpacing the transfers, so double the next batch (TCP-window
+        // style). Producer-limited (partial) batches keep the current size.
+        if (!_end_of_stream && batch_size >= max_bytes) {
+            _transfer_size = std::min(_transfer_size * 2, max_transfer_size);
+        }
     });
 }
 
@@ -1728,6 +1771,7 @@ class multishard_combining_reader : public flat_mutation_reader::impl {
     unsigned _current_shard;
     bool _crossed_shards;
     unsigned _concurrency = 1;
+    const multishard_reader_read_ahead _read_ahead;
 
     void on_partition_range_change(const dht::partition_range& pr);
     bool maybe_move_to_next_shard(const dht::token* const t = nullptr);
@@ -1743,7 +1787,8 @@ public:
             const query::partition_slice& ps,
             const io_priority_class& pc,
             tracing::trace_state_ptr trace_state,
-            mutation_reader::forwarding fwd_mr);
+            mutation_reader::forwarding fwd_mr,
+            multishard_reader_read_ahead read_ahead);
 
     // this is captured.
     multishard_combining_reader(const multishard_combining_reader&) = delete;
@@ -1812,8 +1857,11 @@ future<> multishard_combining_reader::handle_empty_reader_buffer() {
     } else {
         // If we crossed shards and the next reader has an empty buffer we
         // double concurrency so the next time we cross shards we will have
-        // more chances of hitting the reader's buffer.
-        if (_crossed_shards) {
+        // more chances of hitting the reader's buffer. Not worth it for
+        // low-limit reads: the limit is typically satisfied before the
+        // speculatively filled buffers are reached, and their content is
+        // dropped on the floor.
+        if (_crossed_shards && _read_ahead == multishard_reader_read_ahead::yes) {
             _concurrency = std::min(_concurrency * 2, _sharder.shard_count());
 
             // Read ahead shouldn't change the min selection heap so we work on a local copy.
@@ -1842,8 +1890,9 @@ multishard_combining_reader::multishard_combining_reader(
         const query::partition_slice& ps,
         const io_priority_class& pc,
         tracing::trace_state_ptr trace_state,
-        mutation_reader::forwarding fwd_mr)
-    : impl(std::move(s), std::move(permit)), _sharder(sharder) {
+        mutation_reader::forwarding fwd_mr,
+        multishard_reader_read_ahead read_ahead)
+    : impl(std::move(s), std::move(permit)), _sharder(sharder), _read_ahead(read_ahead) {
 
     on_partition_range_change(pr);
 
@@ -1907,10 +1956,11 @@ flat_mutation_reader make_multishard_combining_reader(
         const query::partition_slice& ps,
         const io_priority_class& pc,
         tracing::trace_state_ptr trace_state,
-        mutation_reader::forwarding fwd_mr) {
+        mutation_reader::forwarding fwd_mr,
+        multishard_reader_read_ahead read_ahead) {
     const dht::sharder& sharder = schema->get_sharder();
     return make_flat_mutation_reader<multishard_combining_reader>(sharder, std::move(lifecycle_policy), std::move(schema), std::move(permit), pr, ps, pc,
-            std::move(trace_state), fwd_mr);
+            std::move(trace_state), fwd_mr, read_ahead);
 }
 
 flat_mutation_reader make_multishard_combining_reader_for_tests(
@@ -1924,7 +1974,7 @@ flat_mutation_reader make_multishard_combining_reader_for_tests(
         tracing::trace_state_ptr trace_state,
         mutation_reader::forwarding fwd_mr) {
     return make_flat_mutation_reader<multishard_combining_reader>(sharder, std::move(lifecycle_policy), std::move(schema), std::move(permit), pr, ps, pc,
-            std::move(trace_state), fwd_mr);
+            std::move(trace_state), fwd_mr, multishard_reader_read_ahead::yes);
 }
 
 class queue_reader final : public flat_mutation_reader::impl {
@@ -136,6 +136,72 @@ flat_mutation_reader make_filtering_reader(flat_mutation_reader rd, MutationFilt
     return make_flat_mutation_reader<filtering_reader<MutationFilter>>(std::move(rd), std::forward<MutationFilter>(filter));
 }
 
+template <typename MutationFilter>
+requires requires(MutationFilter mf, const dht::decorated_key& dk) {
+    { mf(dk) } -> std::same_as<bool>;
+}
+class filtering_reader_v2 : public flat_mutation_reader_v2::impl {
+    flat_mutation_reader_v2 _rd;
+    MutationFilter _filter;
+public:
+    filtering_reader_v2(flat_mutation_reader_v2 rd, MutationFilter&& filter)
+        : impl(rd.schema(), rd.permit())
+        , _rd(std::move(rd))
+        , _filter(std::forward<MutationFilter>(filter)) {
+    }
+    virtual future<> fill_buffer() override {
+        return do_until([this] { return is_buffer_full() || is_end_of_stream(); }, [this] {
+            return _rd.fill_buffer().then([this] {
+                return do_until([this] { return _rd.is_buffer_empty(); }, [this] {
+                    auto mf = _rd.pop_mutation_fragment();
+                    if (mf.is_partition_start()) {
+                        auto& dk = mf.as_partition_start().key();
+                        if (!_filter(dk)) {
+                            // We drop whole partitions only, so the stream
+                            // remains well-formed: any range tombstone changes
+                            // of the dropped partition go with it.
+                            return _rd.next_partition();
+                        }
+                    }
+                    push_mutation_fragment(std::move(mf));
+                    return make_ready_future<>();
+                }).then([this] {
+                    _end_of_stream = _rd.is_end_of_stream();
+                });
+            });
+        });
+    }
+    virtual future<> next_partition() override {
+        clear_buffer_to_next_partition();
+        if (is_buffer_empty()) {
+            _end_of_stream = false;
+            return _rd.next_partition();
+        }
+        return make_ready_future<>();
+    }
+    virtual future<> fast_forward_to(const dht::partition_range& pr) override {
+        clear_buffer();
+        _end_of_stream = false;
+        return _rd.fast_forward_to(pr);
+    }
+    virtual future<> fast_forward_to(position_range pr) override {
+        forward_buffer_to(pr.start());
+        _end_of_stream = false;
+        return _rd.fast_forward_to(std::move(pr));
+    }
+    virtual future<> close() noexcept override {
+        return _rd.close();
+    }
+};
+
+// Version of make_filtering_reader() for the v2 reader.
+// Allows filtering v2 readers natively, without a conversion round-trip
+// through the v1 format.
+template <typename MutationFilter>
+flat_mutation_reader_v2 make_filtering_reader_v2(flat_mutation_reader_v2 rd, MutationFilter&& filter) {
+    return make_flat_mutation_reader_v2<filtering_reader_v2<MutationFilter>>(std::move(rd), std::forward<MutationFilter>(filter));
+}
+
 /// Create a wrapper that filters fragments according to partition range and slice.
 flat_mutation_reader make_slicing_filtering_reader(flat_mutation_reader, const dht::partition_range&, const query::partition_slice&);
 
@@ -523,6 +589,12 @@ public:
     virtual future<reader_permit> obtain_reader_permit(schema_ptr schema, const char* const description, db::timeout_clock::time_point timeout) = 0;
 };
 
+/// Whether the multishard combining reader may issue speculative read-aheads
+/// to the shards it expects to visit next. Callers whose row limit is very
+/// low should disable this: any read-ahead past the satisfying shard only
+/// produces buffered rows that get thrown away.
+using multishard_reader_read_ahead = bool_class<class multishard_reader_read_ahead_tag>;
+
 /// Make a multishard_combining_reader.
 ///
 /// multishard_combining_reader takes care of reading a range from all shards
@@ -549,7 +621,8 @@ flat_mutation_reader make_multishard_combining_reader(
         const query::partition_slice& ps,
         const io_priority_class& pc,
         tracing::trace_state_ptr trace_state = nullptr,
-        mutation_reader::forwarding fwd_mr = mutation_reader::forwarding::no);
+        mutation_reader::forwarding fwd_mr = mutation_reader::forwarding::no,
+        multishard_reader_read_ahead read_ahead = multishard_reader_read_ahead::yes);
 
 flat_mutation_reader make_multishard_combining_reader_for_tests(
         const dht::sharder& sharder,
@@ -34,14 +34,24 @@ class shard_writer {
 private:
     schema_ptr _s;
     std::unique_ptr<reader_concurrency_semaphore> _semaphore;
+    reader_permit _permit;
     flat_mutation_reader _reader;
+    queue_reader_handle _handle;
     std::function<future<> (flat_mutation_reader reader)> _consumer;
 public:
     shard_writer(schema_ptr s,
         std::unique_ptr<reader_concurrency_semaphore> semaphore,
+        reader_permit permit,
         flat_mutation_reader reader,
+        queue_reader_handle handle,
         std::function<future<> (flat_mutation_reader reader)> consumer);
     future<> consume();
+    // Copies a batch of fragments produced on another shard into the local
+    // queue. The copies are accounted on this shard's permit, the original
+    // batch is freed back on the producing shard.
+    future<> push_batch(const std::vector<mutation_fragment>& batch);
+    void push_end_of_stream();
+    void abort(std::exception_ptr ep);
     future<> close() noexcept;
 };
 
@@ -51,12 +61,23 @@ public:
 // the shard multishard_writer is on, it will forward the mutation_fragment to
 // the correct shard. Future returned by multishard_writer() becomes
 // ready when all the mutation_fragments are consumed.
+//
+// Fragments are not forwarded one by one: they accumulate into a
+// per-destination batch of a few KB which crosses the shard boundary
+// wholesale, amortizing the smp message cost over many fragments. Flow
+// control is provided by the destination-side queue readers - a batch
+// handoff completes only once the destination queue accepted all of it.
 class multishard_writer {
 private:
+    // Compromise between amortizing the smp message cost and keeping the
+    // destination shards busy. Matches the order of magnitude of the reader
+    // buffer size.
+    static constexpr size_t batch_size_limit = 8 * 1024;
     schema_ptr _s;
     std::vector<foreign_ptr<std::unique_ptr<shard_writer>>> _shard_writers;
     std::vector<future<>> _pending_consumers;
-    std::vector<std::optional<queue_reader_handle>> _queue_reader_handles;
+    std::vector<std::vector<mutation_fragment>> _batches;
+    std::vector<size_t> _batch_sizes;
     unsigned _current_shard = -1;
     uint64_t _consumed_partitions = 0;
     flat_mutation_reader _producer;
@@ -66,8 +87,10 @@ private:
         return _s->get_sharder().shard_of(mf.as_partition_start().key().token());
     }
     future<> make_shard_writer(unsigned shard);
+    future<> flush_batch(unsigned shard);
     future<stop_iteration> handle_mutation_fragment(mutation_fragment mf);
     future<stop_iteration> handle_end_of_stream();
+    future<> abort_shard_writers(std::exception_ptr ep);
     future<> consume(unsigned shard);
     future<> wait_pending_consumers();
     future<> distribute_mutation_fragments();
@@ -82,11 +105,15 @@ public:
 
 shard_writer::shard_writer(schema_ptr s,
     std::unique_ptr<reader_concurrency_semaphore> semaphore,
+    reader_permit permit,
     flat_mutation_reader reader,
+    queue_reader_handle handle,
     std::function<future<> (flat_mutation_reader reader)> consumer)
     : _s(s)
     , _semaphore(std::move(semaphore))
+    , _permit(std::move(permit))
     , _reader(std::move(reader))
+    , _handle(std::move(handle))
     , _consumer(std::move(consumer)) {
 }
 
@@ -99,6 +126,21 @@ future<> shard_writer::consume() {
     });
 }
 
+future<> shard_writer::push_batch(const std::vector<mutation_fragment>& batch) {
+    return do_for_each(batch, [this] (const mutation_fragment& mf) {
+        // Need a copy since the mf is on the remote shard.
+        return _handle.push(mutation_fragment(*_s, _permit, mf));
+    });
+}
+
+void shard_writer::push_end_of_stream() {
+    _handle.push_end_of_stream();
+}
+
+void shard_writer::abort(std::exception_ptr ep) {
+    _handle.abort(std::move(ep));
+}
+
 future<> shard_writer::close() noexcept {
     return _reader.close().finally([this] {
         return _semaphore->stop();
@@ -110,29 +152,40 @@ multishard_writer::multishard_writer(
     flat_mutation_reader producer,
     std::function<future<> (flat_mutation_reader)> consumer)
     : _s(std::move(s))
-    , _queue_reader_handles(_s->get_sharder().shard_count())
+    , _batches(_s->get_sharder().shard_count())
+    , _batch_sizes(_s->get_sharder().shard_count(), 0)
     , _producer(std::move(producer))
     , _consumer(std::move(consumer)) {
     _shard_writers.resize(_s->get_sharder().shard_count());
 }
 
 future<> multishard_writer::make_shard_writer(unsigned shard) {
-    auto [reader, handle] = make_queue_reader(_s, _producer.permit());
-    _queue_reader_handles[shard] = std::move(handle);
-    return smp::submit_to(shard, [gs = global_schema_ptr(_s),
-            consumer = _consumer,
-            reader = make_foreign(std::make_unique<flat_mutation_reader>(std::move(reader)))] () mutable {
+    return smp::submit_to(shard, [gs = global_schema_ptr(_s), consumer = _consumer] () mutable {
         auto s = gs.get();
         auto semaphore = std::make_unique<reader_concurrency_semaphore>(reader_concurrency_semaphore::no_limits{}, "shard_writer");
         auto permit = semaphore->make_tracking_only_permit(s.get(), "multishard-writer", db::no_timeout);
-        auto this_shard_reader = make_foreign_reader(s, std::move(permit), std::move(reader));
-        return make_foreign(std::make_unique<shard_writer>(gs.get(), std::move(semaphore), std::move(this_shard_reader), consumer));
+        auto [reader, handle] = make_queue_reader(s, permit);
+        return make_foreign(std::make_unique<shard_writer>(s, std::move(semaphore), std::move(permit), std::move(reader), std::move(handle), consumer));
     }).then([this, shard] (foreign_ptr<std::unique_ptr<shard_writer>> writer) {
         _shard_writers[shard] = std::move(writer);
         _pending_consumers.push_back(consume(shard));
     });
 }
 
+future<> multishard_writer::flush_batch(unsigned shard) {
+    if (_batches[shard].empty()) {
+        return make_ready_future<>();
+    }
+    _batch_sizes[shard] = 0;
+    auto batch = make_foreign(std::make_unique<std::vector<mutation_fragment>>(std::exchange(_batches[shard], {})));
+    return smp::submit_to(shard, [writer = _shard_writers[shard].get(), batch = std::move(batch)] () mutable {
+        auto& b = *batch;
+        // Keep the batch alive until the last copy was pushed, then free it
+        // back on the producing shard.
+        return writer->push_batch(b).finally([batch = std::move(batch)] {});
+    });
+}
+
 future<stop_iteration> multishard_writer::handle_mutation_fragment(mutation_fragment mf) {
     auto f = make_ready_future<>();
     if (mf.is_partition_start()) {
@@ -146,33 +199,51 @@ future<stop_iteration> multishard_writer::handle_mutation_fragment(mutation_frag
     }
     return f.then([this, mf = std::move(mf)] () mutable {
         assert(_current_shard != -1u);
-        return _queue_reader_handles[_current_shard]->push(std::move(mf));
-    }).then([] {
-        return stop_iteration::no;
+        auto shard = _current_shard;
+        _batch_sizes[shard] += mf.memory_usage();
+        _batches[shard].push_back(std::move(mf));
+        if (_batch_sizes[shard] >= batch_size_limit) {
+            return flush_batch(shard).then([] {
+                return stop_iteration::no;
+            });
+        }
+        return make_ready_future<stop_iteration>(stop_iteration::no);
     });
 }
 
 future<stop_iteration> multishard_writer::handle_end_of_stream() {
     return parallel_for_each(boost::irange(0u, _s->get_sharder().shard_count()), [this] (unsigned shard) {
-        if (_queue_reader_handles[shard]) {
-            _queue_reader_handles[shard]->push_end_of_stream();
+        if (!_shard_writers[shard]) {
+            return make_ready_future<>();
         }
-        return make_ready_future<>();
+        return flush_batch(shard).then([this, shard] {
+            return smp::submit_to(shard, [writer = _shard_writers[shard].get()] {
+                writer->push_end_of_stream();
+            });
+        });
     }).then([] {
         return stop_iteration::yes;
     });
 }
 
+future<> multishard_writer::abort_shard_writers(std::exception_ptr ep) {
+    return parallel_for_each(boost::irange(0u, unsigned(_shard_writers.size())), [this, ep] (unsigned shard) {
+        if (!_shard_writers[shard]) {
+            return make_ready_future<>();
+        }
+        return smp::submit_to(shard, [writer = _shard_writers[shard].get(), ep] {
+            writer->abort(ep);
+        });
+    });
+}
+
 future<> multishard_writer::consume(unsigned shard) {
     return smp::submit_to(shard, [writer = _shard_writers[shard].get()] () mutable {
         return writer->consume();
     }).handle_exception([this] (std::exception_ptr ep) {
-        for (auto& q : _queue_reader_handles) {
-            if (q) {
-                q->abort(ep);
-            }
-        }
-        return make_exception_future<>(std::move(ep));
+        return abort_shard_writers(ep).then([ep] () mutable {
+            return make_exception_future<>(std::move(ep));
+        });
     });
 }
 
@@ -190,12 +261,9 @@ future<> multishard_writer::distribute_mutation_fragments() {
             }
         });
     }).handle_exception([this] (std::exception_ptr ep) {
-        for (auto& q : _queue_reader_handles) {
-            if (q) {
-                q->abort(ep);
-            }
-        }
-        return make_exception_future<>(std::move(ep));
+        return abort_shard_writers(ep).then([ep] () mutable {
+            return make_exception_future<>(std::move(ep));
+        });
     });
 }
 
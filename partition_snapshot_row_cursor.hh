@@ -200,6 +200,28 @@ class partition_snapshot_row_cursor final {
         memory::on_alloc_point();
         position_in_version::less_compare heap_less(_schema);
         assert(iterators_valid());
+        // Fast path for runs of rows which live in a single version. When the
+        // current row has entries in one version only and that version's next
+        // entry is still ahead of all other versions' next entries (the top of
+        // the heap), the merge is uncontested and we can advance within that
+        // version alone, without going through the heap. Falls through to the
+        // general merge on version boundaries.
+        if (keep && _current_row.size() == 1) {
+            auto& curr = _current_row[0];
+            auto next = std::next(curr.it);
+            rows_entry::tri_compare cmp(_schema);
+            if (next && (_heap.empty() || cmp(*next, *_heap[0].it) < 0)) {
+                _position = position_in_partition(next->position());
+                curr.it = next;
+                if (curr.version_no == 0) {
+                    _latest_it = next;
+                }
+                _dummy = bool(next->dummy());
+                _continuous = bool(next->continuous())
+                    || boost::algorithm::any_of(_heap, [] (auto&& v) { return v.it->continuous(); });
+                return true;
+            }
+        }
         for (auto&& curr : _current_row) {
             if (!keep && curr.unique_owner) {
                 mutation_partition::rows_type::key_grabber kg(curr.it);
@@ -351,16 +351,21 @@ void partition_entry::apply(const schema& s, mutation_partition&& mp, const sche
     if (s.version() != mp_schema.version()) {
         mp.upgrade(mp_schema, s);
     }
-    auto new_version = current_allocator().construct<partition_version>(std::move(mp));
     if (!_snapshot) {
         try {
-            _version->partition().apply_monotonically(s, std::move(new_version->partition()), no_cache_tracker, app_stats);
-            current_allocator().destroy(new_version);
+            // Apply in place, without wrapping mp in a partition_version first.
+            // Constructing and immediately destroying a version object per
+            // write would leave a hole in the LSA segment, adding compaction
+            // work proportional to the write rate.
+            _version->partition().apply_monotonically(s, std::move(mp), no_cache_tracker, app_stats);
             return;
         } catch (...) {
-            // fall through
+            // apply_monotonically() is monotonic: what was applied was moved
+            // out of mp and the rest is still in it, so preserving mp as a
+            // new version keeps all the data in the entry. Fall through.
         }
     }
+    auto new_version = current_allocator().construct<partition_version>(std::move(mp));
     new_version->insert_before(*_version);
     set_version(new_version);
     app_stats.row_writes += new_version->partition().row_count();
@@ -544,7 +544,10 @@ public:
         return _snapshot && _snapshot->is_locked();
     }
 
-    // Strong exception guarantees.
+    // Applies mutation_partition to this entry.
+    // On exception, a monotonic subset of mp may have been moved into this
+    // entry, with the remainder left in mp, so retrying with the same data
+    // is safe.
     // Assumes this instance and mp are fully continuous.
     // Use only on non-evictable entries.
     // Must not be called when is_locked().
@@ -255,7 +255,14 @@ void querier_cache::insert_querier(
 
     auto& sem = q.permit().semaphore();
 
-    auto irh = sem.register_inactive_read(querier_utils::get_reader(q));
+    auto reader = querier_utils::get_reader(q);
+    // The reader is parked until the next page (or until it expires). Give
+    // back the buffer's slack capacity so it doesn't sit idle against the
+    // semaphore's memory budget in the meantime. The buffered fragments
+    // themselves have to be kept: the reader cannot be re-wound to produce
+    // them again.
+    reader.shrink_buffer();
+    auto irh = sem.register_inactive_read(std::move(reader));
     if (!irh) {
         ++stats.resource_based_evictions;
         return;
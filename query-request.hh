@@ -236,6 +236,9 @@ public:
     const cql_serialization_format& cql_format() const {
         return _cql_format;
     }
+    void set_cql_format(cql_serialization_format fmt) {
+        _cql_format = fmt;
+    }
     const uint32_t partition_row_limit_low_bits() const {
         return _partition_row_limit_low_bits;
     }
@@ -20,6 +20,7 @@
  */
 
 #include <limits>
+#include <numeric>
 #include "query-request.hh"
 #include "query-result.hh"
 #include "query-result-writer.hh"
@@ -338,6 +339,11 @@ foreign_ptr<lw_shared_ptr<query::result>> result_merger::get() {
     }
 
     bytes_ostream w;
+    // The merged result is roughly the concatenation of the partial results,
+    // so allocate the buffer for it up front.
+    w.reserve(std::accumulate(_partial.begin(), _partial.end(), size_t(0), [] (size_t acc, const auto& r) {
+        return acc + r->buf().size();
+    }));
     auto partitions = ser::writer_of_query_result<bytes_ostream>(w).start_partitions();
     uint64_t row_count = 0;
     short_read is_short_read;
@@ -93,6 +93,11 @@ class reader_permit::impl
     bool _marked_as_used = false;
     uint64_t _blocked_branches = 0;
     bool _marked_as_blocked = false;
+    // Wall-clock time accumulated in the active/used state, i.e. while the
+    // read was runnable and not blocked on I/O. Approximates the CPU time
+    // consumed by the read.
+    std::chrono::steady_clock::duration _used_cpu_time = {};
+    std::chrono::steady_clock::time_point _used_since;
     db::timeout_clock::time_point _timeout;
     query::max_result_size _max_result_size{query::result_memory_limiter::unlimited_result_size};
 
@@ -100,18 +105,22 @@ private:
     void on_permit_used() {
         _semaphore.on_permit_used();
         _marked_as_used = true;
+        _used_since = std::chrono::steady_clock::now();
     }
     void on_permit_unused() {
         _semaphore.on_permit_unused();
         _marked_as_used = false;
+        _used_cpu_time += std::chrono::steady_clock::now() - _used_since;
     }
     void on_permit_blocked() {
         _semaphore.on_permit_blocked();
         _marked_as_blocked = true;
+        _used_cpu_time += std::chrono::steady_clock::now() - _used_since;
     }
     void on_permit_unblocked() {
         _semaphore.on_permit_unblocked();
         _marked_as_blocked = false;
+        _used_since = std::chrono::steady_clock::now();
     }
     void on_permit_active() {
         if (_used_branches) {
@@ -249,6 +258,14 @@ public:
         return _base_resources;
     }
 
+    std::chrono::nanoseconds used_cpu_time() const {
+        auto d = _used_cpu_time;
+        if (_state == reader_permit::state::active_used) {
+            d += std::chrono::steady_clock::now() - _used_since;
+        }
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(d);
+    }
+
     sstring description() const {
         return format("{}.{}:{}",
                 _schema ? _schema->ks_name() : "*",
@@ -394,6 +411,10 @@ reader_resources reader_permit::base_resources() const {
     return _impl->base_resources();
 }
 
+std::chrono::nanoseconds reader_permit::used_cpu_time() const {
+    return _impl->used_cpu_time();
+}
+
 sstring reader_permit::description() const {
     return _impl->description();
 }
@@ -459,15 +480,18 @@ namespace {
 struct permit_stats {
     uint64_t permits = 0;
     reader_resources resources;
+    std::chrono::nanoseconds cpu_time = {};
 
     void add(const reader_permit::impl& permit) {
         ++permits;
         resources += permit.resources();
+        cpu_time += permit.used_cpu_time();
     }
 
     permit_stats& operator+=(const permit_stats& o) {
         permits += o.permits;
         resources += o.resources;
+        cpu_time += o.cpu_time;
         return *this;
     }
 };
@@ -492,12 +516,13 @@ static permit_stats do_dump_reader_permit_diagnostics(std::ostream& os, const pe
         reader_permit::state state;
         uint64_t permits;
         reader_resources resources;
+        std::chrono::nanoseconds cpu_time;
     };
 
     std::vector<permit_summary> permit_summaries;
     for (const auto& [k, v] : permits) {
         const auto& [s, op_name, k_state] = k;
-        permit_summaries.emplace_back(permit_summary{s, op_name, k_state, v.permits, v.resources});
+        permit_summaries.emplace_back(permit_summary{s, op_name, k_state, v.permits, v.resources, v.cpu_time});
     }
 
     std::ranges::sort(permit_summaries, [] (const permit_summary& a, const permit_summary& b) {
@@ -508,16 +533,21 @@ static permit_stats do_dump_reader_permit_diagnostics(std::ostream& os, const pe
     unsigned lines = 0;
     permit_stats omitted_permit_stats;
 
-    auto print_line = [&os] (auto col1, auto col2, auto col3, auto col4) {
-        fmt::print(os, "{}\t{}\t{}\t{}\n", col1, col2, col3, col4);
+    auto print_line = [&os] (auto col1, auto col2, auto col3, auto col4, auto col5) {
+        fmt::print(os, "{}\t{}\t{}\t{}\t{}\n", col1, col2, col3, col4, col5);
     };
 
-    print_line("permits", "count", "memory", "table/description/state");
+    auto to_ms = [] (std::chrono::nanoseconds d) {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(d).count();
+    };
+
+    print_line("permits", "count", "memory", "CPU(ms)", "table/description/state");
     for (const auto& summary : permit_summaries) {
         total.permits += summary.permits;
         total.resources += summary.resources;
+        total.cpu_time += summary.cpu_time;
         if (!max_lines || lines++ < max_lines) {
-            print_line(summary.permits, summary.resources.count, utils::to_hr_size(summary.resources.memory), fmt::format("{}.{}/{}/{}",
+            print_line(summary.permits, summary.resources.count, utils::to_hr_size(summary.resources.memory), to_ms(summary.cpu_time), fmt::format("{}.{}/{}/{}",
                         summary.s ? summary.s->ks_name() : "*",
                         summary.s ? summary.s->cf_name() : "*",
                         summary.op_name,
@@ -525,13 +555,15 @@ static permit_stats do_dump_reader_permit_diagnostics(std::ostream& os, const pe
         } else {
             omitted_permit_stats.permits += summary.permits;
             omitted_permit_stats.resources += summary.resources;
+            omitted_permit_stats.cpu_time += summary.cpu_time;
         }
     }
     if (max_lines && lines > max_lines) {
-        print_line(omitted_permit_stats.permits, omitted_permit_stats.resources.count, utils::to_hr_size(omitted_permit_stats.resources.memory), "permits omitted for brevity");
+        print_line(omitted_permit_stats.permits, omitted_permit_stats.resources.count, utils::to_hr_size(omitted_permit_stats.resources.memory),
+                to_ms(omitted_permit_stats.cpu_time), "permits omitted for brevity");
     }
     fmt::print(os, "\n");
-    print_line(total.permits, total.resources.count, utils::to_hr_size(total.resources.memory), "total");
+    print_line(total.permits, total.resources.count, utils::to_hr_size(total.resources.memory), to_ms(total.cpu_time), "total");
     return total;
 }
 
@@ -728,11 +760,30 @@ flat_mutation_reader_opt reader_concurrency_semaphore::unregister_inactive_read(
     return std::move(irp->reader);
 }
 
+reader_concurrency_semaphore::inactive_read& reader_concurrency_semaphore::pick_inactive_read_for_eviction() noexcept {
+    // Prefer evicting the read whose permit consumed the most CPU so far:
+    // past consumption is the best predictor of what resuming the read would
+    // cost, so this keeps the cheap reads cached at the expense of the hogs.
+    // Only the oldest few reads are examined, so the scan stays cheap and a
+    // long-inactive read cannot be passed over indefinitely.
+    auto it = _inactive_reads.begin();
+    auto candidate = it;
+    auto max_cpu = it->reader.permit().used_cpu_time();
+    for (unsigned i = 1; ++it != _inactive_reads.end() && i < eviction_scan_depth; ++i) {
+        const auto cpu = it->reader.permit().used_cpu_time();
+        if (cpu > max_cpu) {
+            max_cpu = cpu;
+            candidate = it;
+        }
+    }
+    return *candidate;
+}
+
 bool reader_concurrency_semaphore::try_evict_one_inactive_read(evict_reason reason) {
     if (_inactive_reads.empty()) {
         return false;
     }
-    evict(_inactive_reads.front(), reason);
+    evict(pick_inactive_read_for_eviction(), reason);
     return true;
 }
 
@@ -842,7 +893,7 @@ void reader_concurrency_semaphore::evict_readers_in_background() {
     // This is safe since stop() closes _gate;
     (void)with_gate(_close_readers_gate, [this] {
         return do_until([this] { return _wait_list.empty() || _inactive_reads.empty(); }, [this] {
-            return detach_inactive_reader(_inactive_reads.front(), evict_reason::permit).close();
+            return detach_inactive_reader(pick_inactive_read_for_eviction(), evict_reason::permit).close();
         });
     });
  }
@@ -198,8 +198,17 @@ private:
     std::optional<future<>> _execution_loop_future;
 
 private:
+    // When picking an inactive read to evict, up to this many of the oldest
+    // ones are examined and the one whose permit consumed the most CPU is
+    // chosen. Bounding the scan keeps eviction cheap and preserves rough
+    // FIFO fairness for reads that consumed little CPU.
+    static constexpr unsigned eviction_scan_depth = 8;
+
     [[nodiscard]] flat_mutation_reader detach_inactive_reader(inactive_read&, evict_reason reason) noexcept;
     void evict(inactive_read&, evict_reason reason) noexcept;
+    // Picks the inactive read to evict next, see eviction_scan_depth.
+    // Requires a non-empty _inactive_reads list.
+    inactive_read& pick_inactive_read_for_eviction() noexcept;
 
     bool has_available_units(const resources& r) const;
 
@@ -277,6 +286,7 @@ public:
     ///
     /// The semaphore will evict this read when there is a shortage of
     /// permits. This might be immediate, during this register call.
+    /// Reads whose permits consumed more CPU are preferred for eviction.
     /// Clients can use the returned handle to unregister the read, when it
     /// stops being inactive and hence evictable, or to set the optional
     /// notify_handler and ttl.
@@ -161,6 +161,13 @@ public:
 
     reader_resources base_resources() const;
 
+    /// The time this permit's read has spent on the CPU so far.
+    ///
+    /// Measured as the wall-clock time spent in the active/used state, not
+    /// counting the time spent blocked on I/O. With one reactor thread per
+    /// core this is a fair approximation of the CPU time consumed by the read.
+    std::chrono::nanoseconds used_cpu_time() const;
+
     sstring description() const;
 
     db::timeout_clock::time_point timeout() const noexcept;
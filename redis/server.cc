@@ -91,8 +91,8 @@ redis_server::connection::~connection() {
 
 thread_local redis_server::connection::execution_stage_type redis_server::connection::_process_request_stage {"redis_transport", &connection::process_request_one};
 
-future<redis_server::result> redis_server::connection::process_request_internal() {
-    return _process_request_stage(this, _parser.get_request(), seastar::ref(_options), empty_service_permit());
+future<redis_server::result> redis_server::connection::process_request_internal(redis::request&& request, service_permit permit) {
+    return _process_request_stage(this, std::move(request), seastar::ref(_options), std::move(permit));
 }
 
 void redis_server::connection::write_reply(const redis_exception& e)
@@ -107,13 +107,15 @@ void redis_server::connection::write_reply(const redis_exception& e)
     });
 }
 
-void redis_server::connection::write_reply(redis_server::result result)
-{
-    _ready_to_respond = _ready_to_respond.then([this, result = std::move(result)] () mutable {
-        auto m = result.make_message();
-        return _write_buf.write(std::move(*m)).then([this] {
+future<> redis_server::connection::write_reply_message(lw_shared_ptr<scattered_message<char>> m) {
+    return _write_buf.write(std::move(*m)).then([this] {
+        // Flush only once the last queued reply has been written, so that
+        // the replies of a pipelined burst of commands are coalesced into
+        // fewer, larger socket writes.
+        if (--_pending_replies == 0) {
             return _write_buf.flush();
-        });
+        }
+        return make_ready_future<>();
     });
 }
 
@@ -123,29 +125,62 @@ future<> redis_server::connection::process_request() {
         if (_parser.eof()) {
             return make_ready_future<>();
         }
-        ++_server._stats._requests_serving;
-        _pending_requests_gate.enter();
-        utils::latency_counter lc;
-        lc.start();
-        auto leave = defer([this] () noexcept { _pending_requests_gate.leave(); });
-        return process_request_internal().then([this, leave = std::move(leave), lc = std::move(lc)] (auto&& result) mutable {
-            --_server._stats._requests_serving;
-            try {
-                if (_parser.failed()) {
-                    logging.error("request parse failed");
-                    const auto e = redis_exception("unknown command ''");
-                    write_reply(std::move(e));
-                }else{
-                    write_reply(std::move(result));
-                }
-                ++_server._stats._requests_served;
-                _server._stats._requests.mark(lc.stop().latency());
-                if (lc.is_start()) {
-                    _server._stats._estimated_requests_latency.add(lc.latency(), _server._stats._requests.hist.count);
-                }
-            } catch (...) {
-                logging.error("request processing failed: {}", std::current_exception());
-            }
+        if (_parser.failed()) {
+            logging.error("request parse failed");
+            write_reply(redis_exception("unknown command ''"));
+            return make_ready_future<>();
+        }
+        auto request = std::move(_parser.get_request());
+        auto mem_estimate = request.total_request_size() + 8000; // Allow for extra copies and bookkeeping
+        auto fut = get_units(_server._memory_available, mem_estimate);
+        if (_server._memory_available.waiters()) {
+            ++_server._stats._requests_blocked_memory;
+        }
+        return fut.then([this, request = std::move(request)] (semaphore_units<> mem_permit) mutable {
+            ++_server._stats._requests_serving;
+            _pending_requests_gate.enter();
+            auto leave = defer([this] () noexcept { _pending_requests_gate.leave(); });
+            utils::latency_counter lc;
+            lc.start();
+            auto result_fut = process_request_internal(std::move(request), make_service_permit(std::move(mem_permit)));
+            // Chain the reply onto the response queue right away, in command
+            // arrival order, and return to the read loop, so that further
+            // pipelined commands sitting in the input buffer start executing
+            // while this one is still in flight. RESP has no request
+            // identifiers, so the replies must be emitted in arrival order
+            // even when a later command completes first.
+            ++_pending_replies;
+            _ready_to_respond = _ready_to_respond.then([this, result_fut = std::move(result_fut), leave = std::move(leave), lc] () mutable {
+                return result_fut.then_wrapped([this, lc] (future<result> f) mutable {
+                    --_server._stats._requests_serving;
+                    ++_server._stats._requests_served;
+                    _server._stats._requests.mark(lc.stop().latency());
+                    if (lc.is_start()) {
+                        _server._stats._estimated_requests_latency.add(lc.latency(), _server._stats._requests.hist.count);
+                    }
+                    if (f.failed()) {
+                        // Errors are ordinary replies in the redis protocol -
+                        // report them in this command's reply slot and keep
+                        // the connection (and the replies queued after us)
+                        // going.
+                        sstring msg;
+                        try {
+                            f.get();
+                        } catch (redis_exception& e) {
+                            msg = e.what_message();
+                        } catch (std::exception& e) {
+                            msg = e.what();
+                        } catch (...) {
+                            msg = "Unknown exception";
+                        }
+                        return redis_message::exception(msg).then([this] (auto&& result) {
+                            return write_reply_message(result.message());
+                        });
+                    }
+                    return write_reply_message(f.get0().make_message());
+                });
+            });
+            return make_ready_future<>();
         });
     });
 }
@@ -93,6 +93,10 @@ private:
         socket_address _server_addr;
         redis_protocol_parser _parser;
         redis::redis_options _options;
+        // Replies queued on _ready_to_respond but not yet written; the output
+        // stream is flushed only when this drops to zero, coalescing the
+        // replies of a pipelined burst of commands.
+        size_t _pending_replies = 0;
 
         using execution_stage_type = inheriting_concrete_execution_stage<
                 future<redis_server::result>,
@@ -108,11 +112,11 @@ private:
         future<> process_request() override;
         void handle_error(future<>&& f) override;
         void write_reply(const redis_exception&);
-        void write_reply(redis_server::result result);
     private:
+        future<> write_reply_message(lw_shared_ptr<scattered_message<char>> m);
         const ::timeout_config& timeout_config() { return _server.timeout_config(); }
         future<result> process_request_one(redis::request&& request, redis::redis_options&, service_permit permit);
-        future<result> process_request_internal();
+        future<result> process_request_internal(redis::request&& request, service_permit permit);
     };
 
     virtual shared_ptr<generic_server::connection> make_connection(socket_address server_addr, connected_socket&& fd, socket_address addr) override;
@@ -50,6 +50,8 @@ stats::stats() : api_operations{} {
             seastar::metrics::description("Counts a number of served requests.")),
         seastar::metrics::make_gauge("requests_serving", _requests_serving,
             seastar::metrics::description("Holds a number of requests that are being processed right now.")),
+        seastar::metrics::make_derive("requests_blocked_memory", _requests_blocked_memory,
+            seastar::metrics::description("Counts a number of requests that were blocked due to reaching the memory quota limit.")),
         seastar::metrics::make_histogram("requests_latency", seastar::metrics::description("The general requests latency histogram"), [this]{ return _estimated_requests_latency.get_histogram(16, 20);}),
     });
 }
@@ -33,6 +33,7 @@
 #include "sstables/sstables.hh"
 #include "database.hh"
 #include "db/config.hh"
+#include "db/system_keyspace.hh"
 #include "hashers.hh"
 #include "locator/network_topology_strategy.hh"
 #include "utils/bit_cast.hh"
@@ -54,6 +55,8 @@
 #include <seastar/core/sleep.hh>
 
 #include <cfloat>
+#include <deque>
+#include <limits>
 
 logging::logger rlogger("repair");
 
@@ -147,6 +150,8 @@ std::ostream& operator<<(std::ostream& out, row_level_diff_detect_algorithm algo
         return out << "send_full_set";
     case row_level_diff_detect_algorithm::send_full_set_rpc_stream:
         return out << "send_full_set_rpc_stream";
+    case row_level_diff_detect_algorithm::send_full_set_rpc_stream_xxh3:
+        return out << "send_full_set_rpc_stream_xxh3";
     };
     return out << "unknown";
 }
@@ -359,6 +364,7 @@ tracker::tracker(size_t nr_shards, size_t max_repair_memory)
     auto nr = std::max(size_t(1), size_t(max_repair_memory / max_repair_memory_per_range() / 4));
     rlogger.info("Setting max_repair_memory={}, max_repair_memory_per_range={}, max_repair_ranges_in_parallel={}",
         max_repair_memory, max_repair_memory_per_range(), nr);
+    _max_repair_ranges_in_parallel = nr;
     _range_parallelism_semaphores.reserve(nr_shards);
     while (nr_shards--) {
         _range_parallelism_semaphores.emplace_back(named_semaphore(nr, named_semaphore_exception_factory{"repair range parallelism"}));
@@ -644,6 +650,15 @@ repair_neighbors repair_info::get_repair_neighbors(const dht::token_range& range
         neighbors[range];
 }
 
+// Record a successfully repaired range in the local history table. Failures
+// to record are logged and ignored inside update_repair_history() - the
+// history is an optimization aid, not a correctness requirement.
+static future<> record_repair_history(const repair_info& ri, const sstring& cf, const dht::token_range& range) {
+    auto start = range.start() ? dht::token::to_int64(range.start()->value()) : std::numeric_limits<int64_t>::min();
+    auto end = range.end() ? dht::token::to_int64(range.end()->value()) : std::numeric_limits<int64_t>::max();
+    return db::system_keyspace::update_repair_history(ri.id.uuid, ri.keyspace, cf, start, end, db_clock::now());
+}
+
 // Repair a single local range, multiple column families.
 // Comparable to RepairSession in Origin
 future<> repair_info::repair_range(const dht::token_range& range) {
@@ -696,7 +711,9 @@ future<> repair_info::repair_range(const dht::token_range& range) {
             if (dropped_tables.contains(cf)) {
                 return make_ready_future<>();
             }
-            return repair_cf_range_row_level(*this, cf, table_id, range, neighbors).handle_exception_type([this, cf] (no_such_column_family&) mutable {
+            return repair_cf_range_row_level(*this, cf, table_id, range, neighbors).then([this, cf, range] {
+                return record_repair_history(*this, cf, range);
+            }).handle_exception_type([this, cf] (no_such_column_family&) mutable {
                 dropped_tables.insert(cf);
                 return make_ready_future<>();
             }).handle_exception([this] (std::exception_ptr ep) mutable {
@@ -975,11 +992,58 @@ private:
 };
 
 
-static future<> do_repair_ranges(lw_shared_ptr<repair_info> ri) {
-    // repair all the ranges in limited parallelism
-    return parallel_for_each(ri->ranges, [ri] (auto&& range) {
-        return with_semaphore(repair_tracker().range_parallelism_semaphore(), 1, [ri, &range] {
-            return ri->repair_range(range).then([ri] {
+// A sub-range waiting to be repaired. When a range is split, only one of the
+// two halves inherits counts=true, so the per-range completion counters still
+// add up to the number of ranges the job started with.
+struct repair_sub_range {
+    dht::token_range range;
+    bool counts;
+};
+
+// Estimated number of partitions over all tables above which a sub-range is
+// split in half instead of being repaired in one go. Bounds the amount of
+// work a single worker fiber can be stuck with.
+static constexpr uint64_t max_estimated_partitions_per_sub_range = 128 * 1024;
+
+// Splits a range in two at the approximate token midpoint. Returns nullopt
+// for ranges which cannot be split - unbounded ranges and ranges too narrow
+// for the midpoint to differ from both ends.
+static std::optional<std::pair<dht::token_range, dht::token_range>> split_range(const dht::token_range& range) {
+    if (!range.start() || !range.end()) {
+        return std::nullopt;
+    }
+    const auto& start = range.start()->value();
+    const auto& end = range.end()->value();
+    auto mid = dht::token::midpoint(start, end);
+    if (mid == start || mid == end) {
+        return std::nullopt;
+    }
+    return std::make_pair(dht::token_range(range.start(), dht::token_range::bound(mid, true)),
+                          dht::token_range(dht::token_range::bound(mid, false), range.end()));
+}
+
+static future<> repair_ranges_fiber(lw_shared_ptr<repair_info> ri, std::deque<repair_sub_range>& queue) {
+    while (!queue.empty()) {
+        auto sub_range = queue.front();
+        queue.pop_front();
+        uint64_t estimate = 0;
+        for (const auto& table : ri->table_names()) {
+            estimate += co_await estimate_partitions(ri->db, ri->keyspace, table, sub_range.range);
+        }
+        if (estimate > max_estimated_partitions_per_sub_range) {
+            if (auto halves = split_range(sub_range.range)) {
+                rlogger.debug("repair id {} on shard {}: splitting range {} with an estimated {} partitions",
+                        ri->id, ri->shard, sub_range.range, estimate);
+                queue.push_front(repair_sub_range{std::move(halves->second), false});
+                queue.push_front(repair_sub_range{std::move(halves->first), sub_range.counts});
+                continue;
+            }
+        }
+        co_await with_semaphore(repair_tracker().range_parallelism_semaphore(), 1, [ri, sub_range] {
+            return ri->repair_range(sub_range.range).then([ri, counts = sub_range.counts] {
+                if (!counts) {
+                    return;
+                }
                 if (ri->reason == streaming::stream_reason::bootstrap) {
                     _node_ops_metrics.bootstrap_finished_ranges++;
                 } else if (ri->reason == streaming::stream_reason::replace) {
@@ -996,6 +1060,24 @@ static future<> do_repair_ranges(lw_shared_ptr<repair_info> ri) {
                 }
             });
         });
+    }
+}
+
+static future<> do_repair_ranges(lw_shared_ptr<repair_info> ri) {
+    // The ranges of the job form a shared work queue consumed by a fixed set
+    // of worker fibers. A fiber that finished a cheap range immediately takes
+    // the next pending one, and a range estimated to hold too many partitions
+    // is split at its token midpoint with both halves returned to the queue
+    // for any fiber to take. This way the job does not finish at the pace of
+    // its most skewed range. Each sub-range still takes a unit of the global
+    // range parallelism semaphore, so the limit is shared with other jobs.
+    std::deque<repair_sub_range> queue;
+    for (auto& range : ri->ranges) {
+        queue.push_back(repair_sub_range{range, true});
+    }
+    auto nr_fibers = std::min(queue.size(), repair_tracker().max_repair_ranges_in_parallel());
+    co_await parallel_for_each(boost::irange(size_t(0), nr_fibers), [ri, &queue] (size_t) {
+        return repair_ranges_fiber(ri, queue);
     });
 }
 
@@ -1334,11 +1416,12 @@ future<> repair_service::bootstrap_with_repair(locator::token_metadata_ptr tmptr
             auto erm = ks.get_effective_replication_map();
             auto replication_factor = erm->get_replication_factor();
 
-            //Active ranges
-            auto metadata_clone = tmptr->clone_only_token_map().get0();
-            auto range_addresses = strat.get_range_addresses(metadata_clone).get0();
+            //Active ranges, computed on the immutable token_metadata snapshot
+            auto range_addresses = strat.get_range_addresses(*tmptr).get0();
 
-            //Pending ranges
+            //Pending ranges: cloned so the prospective tokens can be added
+            //without touching the published snapshot
+            auto metadata_clone = tmptr->clone_only_token_map().get0();
             metadata_clone.update_normal_tokens(tokens, myip).get();
             auto pending_range_addresses = strat.get_range_addresses(metadata_clone).get0();
             metadata_clone.clear_gently().get();
@@ -255,6 +255,7 @@ private:
     // ranges that can be repaired in parallel. Each element will be accessed
     // by one shared.
     std::vector<named_semaphore> _range_parallelism_semaphores;
+    size_t _max_repair_ranges_in_parallel;
     static constexpr size_t _max_repair_memory_per_range = 32 * 1024 * 1024;
     seastar::condition_variable _done_cond;
     void start(repair_uniq_id id);
@@ -275,6 +276,7 @@ public:
     void abort_all_repairs();
     seastar::abort_source& get_abort_all_abort_source();
     named_semaphore& range_parallelism_semaphore();
+    size_t max_repair_ranges_in_parallel() const { return _max_repair_ranges_in_parallel; }
     static size_t max_repair_memory_per_range() { return _max_repair_memory_per_range; }
     future<> run(repair_uniq_id id, std::function<void ()> func);
     future<repair_status> repair_await_completion(int id, std::chrono::steady_clock::time_point timeout);
@@ -416,6 +418,11 @@ struct repair_row_on_wire_with_cmd {
 enum class row_level_diff_detect_algorithm : uint8_t {
     send_full_set,
     send_full_set_rpc_stream,
+    // Same diff detection as send_full_set_rpc_stream, but rows are hashed
+    // with one XXH3 pass over their frozen representation instead of
+    // field-by-field. Negotiated like any other algorithm, so all nodes in a
+    // repair session hash the same way.
+    send_full_set_rpc_stream_xxh3,
 };
 
 std::ostream& operator<<(std::ostream& out, row_level_diff_detect_algorithm algo);
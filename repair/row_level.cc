@@ -32,6 +32,7 @@
 #include "xx_hasher.hh"
 #include "utils/UUID.hh"
 #include "utils/hash.hh"
+#include "utils/chunked_vector.hh"
 #include "service/priority_manager.hh"
 #include "database.hh"
 #include <seastar/util/bool_class.hh>
@@ -207,6 +208,7 @@ static const std::vector<row_level_diff_detect_algorithm>& suportted_diff_detect
     static std::vector<row_level_diff_detect_algorithm> _algorithms = {
         row_level_diff_detect_algorithm::send_full_set,
         row_level_diff_detect_algorithm::send_full_set_rpc_stream,
+        row_level_diff_detect_algorithm::send_full_set_rpc_stream_xxh3,
     };
     return _algorithms;
 };
@@ -343,6 +345,12 @@ public:
     }
 };
 
+// Rows of a repair round are accumulated in repair_rows buffers. They are
+// backed by large contiguous chunks instead of one heap node per row, so the
+// hashing and diff passes walk rows sequentially in memory and the buffer is
+// released wholesale when the round completes.
+using repair_rows = utils::chunked_vector<repair_row>;
+
 class repair_reader {
 public:
 using is_local_reader = bool_class<class is_local_reader_tag>;
@@ -668,9 +676,9 @@ private:
     repair_reader _repair_reader;
     lw_shared_ptr<repair_writer> _repair_writer;
     // Contains rows read from disk
-    std::list<repair_row> _row_buf;
+    repair_rows _row_buf;
     // Contains rows we are working on to sync between peers
-    std::list<repair_row> _working_row_buf;
+    repair_rows _working_row_buf;
     // Combines all the repair_hash in _working_row_buf
     repair_hash _working_row_buf_combined_hash;
     // Tracks the last sync boundary
@@ -1109,7 +1117,7 @@ private:
                && this_shard_id() == _master_node_shard_config.shard;
     }
 
-    future<size_t> get_repair_rows_size(const std::list<repair_row>& rows) const {
+    future<size_t> get_repair_rows_size(const repair_rows& rows) const {
         return do_with(size_t(0), [&rows] (size_t& sz) {
             return do_for_each(rows, [&sz] (const repair_row& r) mutable {
                 sz += r.size();
@@ -1142,7 +1150,28 @@ private:
         return repair_hash(h.finalize_uint64());
     }
 
-    stop_iteration handle_mutation_fragment(mutation_fragment& mf, size_t& cur_size, size_t& new_rows_size, std::list<repair_row>& cur_rows) {
+    bool one_shot_row_hashing() const {
+        return _algo == row_level_diff_detect_algorithm::send_full_set_rpc_stream_xxh3;
+    }
+
+    // Hash the row's frozen representation in one pass instead of walking the
+    // live fragment field by field. The serialized bytes are already produced
+    // anyway (the row buffer keeps rows frozen), and XXH3 chews through large
+    // buffers with SIMD, so hashing stops being the bottleneck on dense
+    // tables. Only valid when the whole repair session negotiated
+    // send_full_set_rpc_stream_xxh3, since the digests differ from
+    // do_hash_for_mf()'s.
+    repair_hash do_hash_for_fmf(const decorated_key_with_hash& dk_with_hash, const frozen_mutation_fragment& fmf) {
+        xx3_hasher h(_seed);
+        for (bytes_view frag : fmf.representation()) {
+            h.update(reinterpret_cast<const char*>(frag.data()), frag.size());
+        }
+        uint64_t dk_hash = dk_with_hash.hash.hash;
+        h.update(reinterpret_cast<const char*>(&dk_hash), sizeof(dk_hash));
+        return repair_hash(h.finalize_uint64());
+    }
+
+    stop_iteration handle_mutation_fragment(mutation_fragment& mf, size_t& cur_size, size_t& new_rows_size, repair_rows& cur_rows) {
         if (mf.is_partition_start()) {
             auto& start = mf.as_partition_start();
             _repair_reader.set_current_dk(start.key());
@@ -1154,8 +1183,10 @@ private:
             _repair_reader.clear_current_dk();
             return stop_iteration::no;
         }
-        auto hash = do_hash_for_mf(*_repair_reader.get_current_dk(), mf);
-        repair_row r(freeze(*_schema, mf), position_in_partition(mf.position()), _repair_reader.get_current_dk(), hash, is_dirty_on_master::no);
+        auto fm = freeze(*_schema, mf);
+        auto hash = one_shot_row_hashing() ? do_hash_for_fmf(*_repair_reader.get_current_dk(), fm)
+                                           : do_hash_for_mf(*_repair_reader.get_current_dk(), mf);
+        repair_row r(std::move(fm), position_in_partition(mf.position()), _repair_reader.get_current_dk(), hash, is_dirty_on_master::no);
         rlogger.trace("Reading: r.boundary={}, r.hash={}", r.boundary(), r.hash());
         _metrics.row_from_disk_nr++;
         _metrics.row_from_disk_bytes += r.size();
@@ -1168,10 +1199,10 @@ private:
     // Read rows from sstable until the size of rows exceeds _max_row_buf_size  - current_size
     // This reads rows from where the reader left last time into _row_buf
     // _current_sync_boundary or _last_sync_boundary have no effect on the reader neither.
-    future<std::tuple<std::list<repair_row>, size_t>>
+    future<std::tuple<repair_rows, size_t>>
     read_rows_from_disk(size_t cur_size) {
-        using value_type = std::tuple<std::list<repair_row>, size_t>;
-        return do_with(cur_size, size_t(0), std::list<repair_row>(), [this] (size_t& cur_size, size_t& new_rows_size, std::list<repair_row>& cur_rows) {
+        using value_type = std::tuple<repair_rows, size_t>;
+        return do_with(cur_size, size_t(0), repair_rows(), [this] (size_t& cur_size, size_t& new_rows_size, repair_rows& cur_rows) {
             return repeat([this, &cur_size, &cur_rows, &new_rows_size] () mutable {
                 if (cur_size >= _max_row_buf_size) {
                     return make_ready_future<stop_iteration>(stop_iteration::yes);
@@ -1201,6 +1232,16 @@ private:
         return utils::clear_gently(_row_buf);
     }
 
+    // Append the given rows to the end of _row_buf, yielding between rows.
+    future<> append_rows_to_row_buf(repair_rows rows) {
+        _row_buf.reserve(_row_buf.size() + rows.size());
+        return do_with(std::move(rows), [this] (repair_rows& rows) {
+            return do_for_each(rows, [this] (repair_row& r) {
+                _row_buf.push_back(std::move(r));
+            });
+        });
+    }
+
     future<> clear_working_row_buf() {
         return utils::clear_gently(_working_row_buf).then([this] {
             _working_row_buf_combined_hash.clear();
@@ -1223,9 +1264,9 @@ private:
       return f.then([this, sb = std::move(skipped_sync_boundary)] () mutable {
        return clear_working_row_buf().then([this, sb = sb] () mutable {
         return row_buf_size().then([this, sb = std::move(sb)] (size_t cur_size) {
-            return read_rows_from_disk(cur_size).then_unpack([this, sb = std::move(sb)] (std::list<repair_row> new_rows, size_t new_rows_size) mutable {
+            return read_rows_from_disk(cur_size).then_unpack([this, sb = std::move(sb)] (repair_rows new_rows, size_t new_rows_size) mutable {
                 size_t new_rows_nr = new_rows.size();
-                _row_buf.splice(_row_buf.end(), new_rows);
+                return append_rows_to_row_buf(std::move(new_rows)).then([this, new_rows_size, new_rows_nr, sb = std::move(sb)] () mutable {
                 return row_buf_csum().then([this, new_rows_size, new_rows_nr, sb = std::move(sb)] (repair_hash row_buf_combined_hash) {
                     return row_buf_size().then([this, new_rows_size, new_rows_nr, row_buf_combined_hash, sb = std::move(sb)] (size_t row_buf_bytes) {
                         std::optional<repair_sync_boundary> sb_max;
@@ -1237,6 +1278,7 @@ private:
                         return get_sync_boundary_response{sb_max, row_buf_combined_hash, row_buf_bytes, new_rows_size, new_rows_nr};
                     });
                 });
+                });
             });
         });
        });
@@ -1246,29 +1288,38 @@ private:
     future<> move_row_buf_to_working_row_buf() {
         if (_cmp(_row_buf.back().boundary(), *_current_sync_boundary) <= 0) {
             // Fast path
-            _working_row_buf.swap(_row_buf);
+            std::swap(_working_row_buf, _row_buf);
             return make_ready_future<>();
         }
-        return do_with(_row_buf.rbegin(), [this, sz = _row_buf.size()] (auto& it) {
-            // Move the rows > _current_sync_boundary to _working_row_buf
-            // Delete the rows > _current_sync_boundary from _row_buf
-            // Swap _working_row_buf and _row_buf so that _working_row_buf
-            // contains rows within (_last_sync_boundary,
+        return do_with(_row_buf.size(), repair_rows(), [this, sz = _row_buf.size()] (size_t& split, repair_rows& tail) {
+            // Find the index of the first row > _current_sync_boundary,
+            // scanning backwards since the rows in _row_buf are sorted.
+            // Move the rows > _current_sync_boundary to tail and drop them
+            // from _row_buf, then exchange the buffers so that
+            // _working_row_buf contains rows within (_last_sync_boundary,
             // _current_sync_boundary], _row_buf contains rows wthin
             // (_current_sync_boundary, ...]
-            return repeat([this, &it, sz] () {
-                if (it == _row_buf.rend()) {
+            return repeat([this, &split] () {
+                if (split == 0 || _cmp(_row_buf[split - 1].boundary(), *_current_sync_boundary) <= 0) {
                     return make_ready_future<stop_iteration>(stop_iteration::yes);
                 }
-                repair_row& r = *(it++);
-                if (_cmp(r.boundary(), *_current_sync_boundary) > 0) {
-                    _working_row_buf.push_front(std::move(r));
-                    return make_ready_future<stop_iteration>(stop_iteration::no);
-                }
-                return make_ready_future<stop_iteration>(stop_iteration::yes);
-            }).then([this, sz] {
-                _row_buf.resize(_row_buf.size() - _working_row_buf.size());
-                _row_buf.swap(_working_row_buf);
+                split--;
+                return make_ready_future<stop_iteration>(stop_iteration::no);
+            }).then([this, &split, &tail] {
+                tail.reserve(_row_buf.size() - split);
+                return do_with(split, [this, &tail] (size_t& idx) {
+                    return repeat([this, &tail, &idx] () {
+                        if (idx == _row_buf.size()) {
+                            return make_ready_future<stop_iteration>(stop_iteration::yes);
+                        }
+                        tail.push_back(std::move(_row_buf[idx++]));
+                        return make_ready_future<stop_iteration>(stop_iteration::no);
+                    });
+                });
+            }).then([this, &split, &tail, sz] {
+                _row_buf.resize(split);
+                _working_row_buf = std::move(_row_buf);
+                _row_buf = std::move(tail);
                 if (sz != _working_row_buf.size() + _row_buf.size()) {
                     throw std::runtime_error(format("incorrect row_buf and working_row_buf size, before={}, after={} + {}",
                             sz, _working_row_buf.size(), _row_buf.size()));
@@ -1304,9 +1355,9 @@ private:
         });
     }
 
-    future<std::list<repair_row>>
+    future<repair_rows>
     copy_rows_from_working_row_buf() {
-        return do_with(std::list<repair_row>(), [this] (std::list<repair_row>& rows) {
+        return do_with(repair_rows(), [this] (repair_rows& rows) {
             return do_for_each(_working_row_buf, [this, &rows] (const repair_row& r) {
                 rows.push_back(r);
             }).then([&rows] {
@@ -1315,10 +1366,10 @@ private:
         });
     }
 
-    future<std::list<repair_row>>
+    future<repair_rows>
     copy_rows_from_working_row_buf_within_set_diff(repair_hash_set set_diff) {
-        return do_with(std::list<repair_row>(), std::move(set_diff),
-                [this] (std::list<repair_row>& rows, repair_hash_set& set_diff) {
+        return do_with(repair_rows(), std::move(set_diff),
+                [this] (repair_rows& rows, repair_hash_set& set_diff) {
             return do_for_each(_working_row_buf, [this, &set_diff, &rows] (const repair_row& r) {
                 if (set_diff.contains(r.hash())) {
                     rows.push_back(r);
@@ -1332,11 +1383,11 @@ private:
     // Return rows in the _working_row_buf with hash within the given sef_diff
     // Give a set of row hashes, return the corresponding rows
     // If needs_all_rows is set, return all the rows in _working_row_buf, ignore the set_diff
-    future<std::list<repair_row>>
+    future<repair_rows>
     get_row_diff(repair_hash_set set_diff, needs_all_rows_t needs_all_rows = needs_all_rows_t::no) {
         if (needs_all_rows) {
             if (!_repair_master || _nr_peer_nodes == 1) {
-                return make_ready_future<std::list<repair_row>>(std::move(_working_row_buf));
+                return make_ready_future<repair_rows>(std::move(_working_row_buf));
             }
             return copy_rows_from_working_row_buf();
         } else {
@@ -1344,15 +1395,15 @@ private:
         }
     }
 
-    future<> do_apply_rows(std::list<repair_row>&& row_diff, update_working_row_buf update_buf) {
-        return do_with(std::move(row_diff), [this, update_buf] (std::list<repair_row>& row_diff) {
-            return with_semaphore(_repair_writer->sem(), 1, [this, update_buf, &row_diff] {
+    future<> do_apply_rows(repair_rows&& row_diff, update_working_row_buf update_buf) {
+        return do_with(std::move(row_diff), size_t(0), [this, update_buf] (repair_rows& row_diff, size_t& idx) {
+            return with_semaphore(_repair_writer->sem(), 1, [this, update_buf, &row_diff, &idx] {
                 _repair_writer->create_writer(_db, _sys_dist_ks, _view_update_generator);
-                return repeat([this, update_buf, &row_diff] () mutable {
-                    if (row_diff.empty()) {
+                return repeat([this, update_buf, &row_diff, &idx] () mutable {
+                    if (idx == row_diff.size()) {
                         return make_ready_future<stop_iteration>(stop_iteration::yes);
                     }
-                    repair_row& r = row_diff.front();
+                    repair_row& r = row_diff[idx];
                     if (update_buf) {
                         _working_row_buf_combined_hash.add(r.hash());
                     }
@@ -1361,11 +1412,13 @@ private:
                     // to_repair_rows_list above where the repair_row is created.
                     mutation_fragment mf = std::move(r.get_mutation_fragment());
                     auto dk_with_hash = r.get_dk_with_hash();
-                    return _repair_writer->do_write(std::move(dk_with_hash), std::move(mf)).then([&row_diff] {
-                        row_diff.pop_front();
+                    return _repair_writer->do_write(std::move(dk_with_hash), std::move(mf)).then([&idx] {
+                        ++idx;
                         return make_ready_future<stop_iteration>(stop_iteration::no);
                     });
                 });
+            }).then([&row_diff] {
+                return utils::clear_gently(row_diff);
             });
         });
     }
@@ -1384,10 +1437,28 @@ private:
         stats().rx_row_nr_peer[from] += row_diff.size();
         if (update_buf) {
             // Both row_diff and _working_row_buf and are ordered, merging
-            // two sored list to make sure the combination of row_diff
-            // and _working_row_buf are ordered.
-            utils::merge_to_gently(_working_row_buf, row_diff,
-                 [this] (const repair_row& x, const repair_row& y) { return _cmp(x.boundary(), y.boundary()) < 0; });
+            // two sored buffers to make sure the combination of row_diff
+            // and _working_row_buf are ordered. Merge into a fresh buffer
+            // instead of inserting into the middle of _working_row_buf,
+            // which would move the tail rows once per inserted row.
+            auto comp = [this] (const repair_row& x, const repair_row& y) { return _cmp(x.boundary(), y.boundary()) < 0; };
+            repair_rows merged;
+            merged.reserve(_working_row_buf.size() + row_diff.size());
+            auto it1 = _working_row_buf.begin();
+            auto end1 = _working_row_buf.end();
+            auto it2 = row_diff.begin();
+            auto end2 = row_diff.end();
+            while (it1 != end1 || it2 != end2) {
+                thread::maybe_yield();
+                if (it1 == end1) {
+                    merged.push_back(*it2++);
+                } else if (it2 != end2 && comp(*it2, *it1)) {
+                    merged.push_back(*it2++);
+                } else {
+                    merged.push_back(std::move(*it1++));
+                }
+            }
+            _working_row_buf = std::move(merged);
             for (auto& r : row_diff) {
                 thread::maybe_yield();
                 _working_row_buf_combined_hash.add(r.hash());
@@ -1444,15 +1515,15 @@ private:
         if (rows.empty()) {
             return make_ready_future<>();
         }
-        return to_repair_rows_list(std::move(rows)).then([this] (std::list<repair_row> row_diff) {
+        return to_repair_rows_list(std::move(rows)).then([this] (repair_rows row_diff) {
             return do_apply_rows(std::move(row_diff), update_working_row_buf::no);
         });
     }
 
-    future<repair_rows_on_wire> to_repair_rows_on_wire(std::list<repair_row> row_list) {
+    future<repair_rows_on_wire> to_repair_rows_on_wire(repair_rows row_list) {
         lw_shared_ptr<const decorated_key_with_hash> last_dk_with_hash;
         return do_with(repair_rows_on_wire(), std::move(row_list), std::move(last_dk_with_hash),
-                [this] (repair_rows_on_wire& rows, std::list<repair_row>& row_list, lw_shared_ptr<const decorated_key_with_hash>& last_dk_with_hash) {
+                [this] (repair_rows_on_wire& rows, repair_rows& row_list, lw_shared_ptr<const decorated_key_with_hash>& last_dk_with_hash) {
             return get_repair_rows_size(row_list).then([this, &rows, &row_list, &last_dk_with_hash] (size_t row_bytes) {
                 _metrics.tx_row_nr += row_list.size();
                 _metrics.tx_row_bytes += row_bytes;
@@ -1480,9 +1551,9 @@ private:
         });
     };
 
-    future<std::list<repair_row>> to_repair_rows_list(repair_rows_on_wire rows) {
-        return do_with(std::move(rows), std::list<repair_row>(), lw_shared_ptr<const decorated_key_with_hash>(), lw_shared_ptr<mutation_fragment>(), position_in_partition::tri_compare(*_schema),
-          [this] (repair_rows_on_wire& rows, std::list<repair_row>& row_list, lw_shared_ptr<const decorated_key_with_hash>& dk_ptr, lw_shared_ptr<mutation_fragment>& last_mf, position_in_partition::tri_compare& cmp) mutable {
+    future<repair_rows> to_repair_rows_list(repair_rows_on_wire rows) {
+        return do_with(std::move(rows), repair_rows(), lw_shared_ptr<const decorated_key_with_hash>(), lw_shared_ptr<mutation_fragment>(), position_in_partition::tri_compare(*_schema),
+          [this] (repair_rows_on_wire& rows, repair_rows& row_list, lw_shared_ptr<const decorated_key_with_hash>& dk_ptr, lw_shared_ptr<mutation_fragment>& last_mf, position_in_partition::tri_compare& cmp) mutable {
             return do_for_each(rows, [this, &dk_ptr, &row_list, &last_mf, &cmp] (partition_key_and_mutation_fragments& x) mutable {
                 dht::decorated_key dk = dht::decorate_key(*_schema, x.get_key());
                 if (!(dk_ptr && dk_ptr->dk.equal(*_schema, dk))) {
@@ -1497,7 +1568,7 @@ private:
                         // mutation_fragment is needed by _repair_writer.do_write()
                         // to apply the repair_row to disk
                         auto mf = make_lw_shared<mutation_fragment>(fmf.unfreeze(*_schema, _permit));
-                        auto hash = do_hash_for_mf(*dk_ptr, *mf);
+                        auto hash = one_shot_row_hashing() ? do_hash_for_fmf(*dk_ptr, fmf) : do_hash_for_mf(*dk_ptr, *mf);
                         position_in_partition pos(mf->position());
                         row_list.push_back(repair_row(std::move(fmf), std::move(pos), dk_ptr, std::move(hash), is_dirty_on_master::yes, std::move(mf)));
                     });
@@ -1891,7 +1962,7 @@ public:
     // RPC handler
     future<repair_rows_on_wire> get_row_diff_handler(repair_hash_set set_diff, needs_all_rows_t needs_all_rows) {
         return with_gate(_gate, [this, set_diff = std::move(set_diff), needs_all_rows] () mutable {
-            return get_row_diff(std::move(set_diff), needs_all_rows).then([this] (std::list<repair_row> row_diff) {
+            return get_row_diff(std::move(set_diff), needs_all_rows).then([this] (repair_rows row_diff) {
                 return to_repair_rows_on_wire(std::move(row_diff));
             });
         });
@@ -1905,12 +1976,12 @@ public:
                 return make_ready_future<>();
             }
             size_t sz = set_diff.size();
-            return get_row_diff(std::move(set_diff), needs_all_rows).then([this, remote_node, sz] (std::list<repair_row> row_diff) {
+            return get_row_diff(std::move(set_diff), needs_all_rows).then([this, remote_node, sz] (repair_rows row_diff) {
                 if (row_diff.size() != sz) {
                     rlogger.warn("Hash conflict detected, keyspace={}, table={}, range={}, row_diff.size={}, set_diff.size={}. It is recommended to compact the table and rerun repair for the range.",
                             _schema->ks_name(), _schema->cf_name(), _range, row_diff.size(), sz);
                 }
-                return do_with(std::move(row_diff), [this, remote_node] (std::list<repair_row>& row_diff) {
+                return do_with(std::move(row_diff), [this, remote_node] (repair_rows& row_diff) {
                     return get_repair_rows_size(row_diff).then([this, remote_node, &row_diff] (size_t row_bytes) mutable {
                         stats().tx_row_nr += row_diff.size();
                         stats().tx_row_nr_peer[remote_node] += row_diff.size();
@@ -1983,12 +2054,12 @@ public:
                 return make_ready_future<>();
             }
             size_t sz = set_diff.size();
-            return get_row_diff(std::move(set_diff), needs_all_rows).then([this, remote_node, node_idx, sz] (std::list<repair_row> row_diff) {
+            return get_row_diff(std::move(set_diff), needs_all_rows).then([this, remote_node, node_idx, sz] (repair_rows row_diff) {
                 if (row_diff.size() != sz) {
                     rlogger.warn("Hash conflict detected, keyspace={}, table={}, range={}, row_diff.size={}, set_diff.size={}. It is recommended to compact the table and rerun repair for the range.",
                             _schema->ks_name(), _schema->cf_name(), _range, row_diff.size(), sz);
                 }
-                return do_with(std::move(row_diff), [this, remote_node, node_idx] (std::list<repair_row>& row_diff) {
+                return do_with(std::move(row_diff), [this, remote_node, node_idx] (repair_rows& row_diff) {
                     return get_repair_rows_size(row_diff).then([this, remote_node, node_idx, &row_diff] (size_t row_bytes) mutable {
                         stats().tx_row_nr += row_diff.size();
                         stats().tx_row_nr_peer[remote_node] += row_diff.size();
@@ -33,6 +33,7 @@
 #include "dirty_memory_manager.hh"
 #include "cache_flat_mutation_reader.hh"
 #include "real_dirty_memory_accounter.hh"
+#include "utils/histogram_metrics_helper.hh"
 
 namespace cache {
 
@@ -67,6 +68,10 @@ cache_tracker::cache_tracker(mutation_application_stats& app_stats, register_met
     }
 
     _region.make_evictable([this] {
+        auto eviction_start = utils::time_estimated_histogram::clock::now();
+        auto record_latency = defer([&] () noexcept {
+            _stats.eviction_latency.add(utils::time_estimated_histogram::clock::now() - eviction_start);
+        });
         return with_allocator(_region.allocator(), [this] {
           // Removing a partition may require reading large keys when we rebalance
           // the rbtree, so linearize anything we read
@@ -80,7 +85,23 @@ cache_tracker::cache_tracker(mutation_application_stats& app_stats, register_met
                 return memory::reclaiming_result::reclaimed_something;
             }
             current_tracker = this;
-            return _lru.evict();
+            // Index pages are kept in their own eviction domain and evicted
+            // only while they exceed their configured share of the region,
+            // or when there are no data rows left to evict.
+            if (_index_bytes_source && _index_bytes_source() > _index_cache_fraction * _region.occupancy().total_space()) {
+                if (_index_lru.evict() == memory::reclaiming_result::reclaimed_something) {
+                    ++_stats.index_evictions;
+                    return memory::reclaiming_result::reclaimed_something;
+                }
+            }
+            if (_lru.evict() == memory::reclaiming_result::reclaimed_something) {
+                return memory::reclaiming_result::reclaimed_something;
+            }
+            auto result = _index_lru.evict();
+            if (result == memory::reclaiming_result::reclaimed_something) {
+                ++_stats.index_evictions;
+            }
+            return result;
            } catch (std::bad_alloc&) {
             // Bad luck, linearization during partition removal caused us to
             // fail.  Drop the entire cache so we can make forward progress.
@@ -140,6 +161,18 @@ cache_tracker::setup_metrics() {
             sm::description("total amount of range tombstones processed during read")),
         sm::make_derive("row_tombstone_reads", _stats.row_tombstone_reads,
             sm::description("total amount of row tombstones processed during read")),
+        sm::make_derive("partition_admissions", _stats.partition_admissions,
+            sm::description("number of partitions admitted into cache by the admission filter")),
+        sm::make_derive("partition_admission_rejections", _stats.partition_admission_rejections,
+            sm::description("number of partitions which the admission filter kept out of cache")),
+        sm::make_derive("index_evictions", _stats.index_evictions,
+            sm::description("number of entries evicted from the sstable index eviction domain")),
+        sm::make_derive("version_chain_flattens", _stats.version_chain_flattens,
+            sm::description("number of partition version chains handed over for background flattening")),
+        sm::make_histogram("population_latency", sm::description("Latency histogram of cache population batches"),
+            [this] { return to_metrics_histogram(_stats.population_latency); }),
+        sm::make_histogram("eviction_latency", sm::description("Latency histogram of single eviction steps performed on memory pressure"),
+            [this] { return to_metrics_histogram(_stats.eviction_latency); }),
     });
 }
 
@@ -153,6 +186,7 @@ void cache_tracker::clear() {
         _memtable_cleaner.clear();
         current_tracker = this;
         _lru.evict_all();
+        _index_lru.evict_all();
     });
     _stats.partition_removals += partitions_before;
     _stats.row_removals += rows_before;
@@ -192,6 +226,32 @@ void cache_tracker::on_partition_miss() noexcept {
     ++_stats.partition_misses;
 }
 
+void cache_tracker::enable_admission_filter(size_t tracked_keys) {
+    _admission_sketch.emplace(tracked_keys);
+}
+
+void cache_tracker::on_partition_access(int64_t raw_token) noexcept {
+    if (_admission_sketch) {
+        _admission_sketch->increment(uint64_t(raw_token));
+    }
+}
+
+bool cache_tracker::should_admit(int64_t raw_token) noexcept {
+    if (!_admission_sketch) {
+        return true;
+    }
+    // Admit only keys which were already seen within the sampling window.
+    // One-off keys read by scans are thus kept out of cache, at the cost of
+    // populating frequently-read keys on their second miss rather than the
+    // first.
+    if (_admission_sketch->estimate(uint64_t(raw_token)) > 0) {
+        ++_stats.partition_admissions;
+        return true;
+    }
+    ++_stats.partition_admission_rejections;
+    return false;
+}
+
 void cache_tracker::on_partition_eviction() noexcept {
     --_stats.partitions;
     ++_stats.partition_evictions;
@@ -568,13 +628,23 @@ class scanning_and_populating_reader final : public flat_mutation_reader::impl {
     bool _read_next_partition = false;
     bool _secondary_in_progress = false;
     bool _advance_primary = false;
+    // Number of consecutive partitions served from the secondary reader.
+    // Used to detect that the scan is inside a contiguous miss range.
+    uint64_t _secondary_streak = 0;
     std::optional<dht::partition_range::bound> _lower_bound;
     dht::partition_range _secondary_range;
     flat_mutation_reader_opt _reader;
+    // Engaged when the read of the next miss-range partition was issued
+    // speculatively, so that the underlying reader's disk access overlaps
+    // with consumption of the current buffer. Joined by read_next_partition()
+    // (or next_partition()/fast_forward_to()/close()) before any other use
+    // of the readers.
+    std::optional<future<flat_mutation_reader_opt>> _prefetch;
 private:
     flat_mutation_reader read_from_entry(cache_entry& ce) {
         _cache.upgrade_entry(ce);
         _cache.on_partition_hit();
+        _secondary_streak = 0;
         return ce.read(_cache, *_read_context);
     }
 
@@ -643,6 +713,7 @@ private:
         return _secondary_reader().then([this] (range_populating_reader::read_result&& res) {
             auto&& [fropt, ps] = res;
             if (fropt) {
+                ++_secondary_streak;
                 if (ps) {
                     push_mutation_fragment(std::move(*ps));
                 }
@@ -653,7 +724,38 @@ private:
             }
         });
     }
+    // Joins the speculative read issued by maybe_prefetch_secondary().
+    future<> consume_prefetch() {
+        auto f = std::move(*_prefetch);
+        _prefetch = {};
+        return f.then([this] (flat_mutation_reader_opt&& fropt) {
+            _read_next_partition = false;
+            if (bool(fropt)) {
+                _reader = std::move(fropt);
+            } else {
+                _end_of_stream = true;
+            }
+        });
+    }
+    // If the scan is inside a contiguous miss range and the current partition
+    // is exhausted, issues the read of the next partition from the underlying
+    // reader right away, so that its disk latency overlaps with consumption
+    // of the current buffer instead of being serialized after it. Memory used
+    // by the speculative read is accounted by the same reader_permit as
+    // regular reads from the underlying reader.
+    void maybe_prefetch_secondary() {
+        if (!_prefetch && _read_next_partition && _secondary_in_progress && _secondary_streak >= 2 && !is_end_of_stream()) {
+            auto close_reader = _reader ? _reader->close() : make_ready_future<>();
+            _prefetch = close_reader.then([this] {
+                _reader = {};
+                return read_from_secondary();
+            });
+        }
+    }
     future<> read_next_partition() {
+      if (_prefetch) {
+          return consume_prefetch();
+      }
       auto close_reader = _reader ? _reader->close() : make_ready_future<>();
       return close_reader.then([this] {
         _read_next_partition = false;
@@ -689,29 +791,55 @@ public:
                     }
                 });
             }
+        }).then([this] {
+            maybe_prefetch_secondary();
         });
     }
     virtual future<> next_partition() override {
         clear_buffer_to_next_partition();
-        if (_reader && is_buffer_empty()) {
+        // When a prefetch is pending, the current partition is already
+        // exhausted and _reader (if any) points at the next one, which must
+        // not be skipped.
+        if (!_prefetch && _reader && is_buffer_empty()) {
             return _reader->next_partition();
         }
         return make_ready_future<>();
     }
     virtual future<> fast_forward_to(const dht::partition_range& pr) override {
+        if (_prefetch) {
+            return consume_prefetch().then([this, &pr] {
+                return fast_forward_to(pr);
+            });
+        }
         clear_buffer();
         _end_of_stream = false;
         _secondary_in_progress = false;
         _advance_primary = false;
+        _secondary_streak = 0;
         _pr = &pr;
         _primary = partition_range_cursor{_cache, pr};
         _lower_bound = pr.start();
-        return _reader->close();
+        return _reader ? _reader->close() : make_ready_future<>();
     }
     virtual future<> fast_forward_to(position_range cr) override {
         return make_exception_future<>(make_backtraced_exception_ptr<std::bad_function_call>());
     }
     virtual future<> close() noexcept override {
+        if (_prefetch) {
+            auto f = std::move(*_prefetch);
+            _prefetch = {};
+            return f.then_wrapped([this] (future<flat_mutation_reader_opt>&& f) {
+                try {
+                    auto fropt = f.get0();
+                    if (fropt) {
+                        _reader = std::move(fropt);
+                    }
+                } catch (...) {
+                    // The speculative read failed; the readers below get closed regardless.
+                }
+                return close();
+            });
+        }
         auto close_reader = _reader ? _reader->close() : make_ready_future<>();
         auto close_secondary_reader = _secondary_reader.close();
         auto close_read_context = _read_context->close();
@@ -750,12 +878,23 @@ row_cache::do_make_reader(schema_ptr s,
                 cache_entry& e = *i;
                 upgrade_entry(e);
                 on_partition_hit();
+                _tracker.on_partition_access(pos.token().raw());
+                maybe_flatten_entry(e);
                 return e.read(*this, make_context());
             } else if (i->continuous()) {
                 return make_empty_flat_reader(std::move(s), std::move(permit));
             } else {
                 tracing::trace(trace_state, "Range {} not found in cache", range);
                 on_partition_miss();
+                if (_tracker.has_admission_filter()) {
+                    bool admit = _tracker.should_admit(pos.token().raw());
+                    _tracker.on_partition_access(pos.token().raw());
+                    if (!admit) {
+                        tracing::trace(trace_state, "Admission filter rejected population of {}", range);
+                        return _underlying.make_reader(std::move(s), std::move(permit), range, slice, pc,
+                                std::move(trace_state), fwd, mutation_reader::forwarding::no);
+                    }
+                }
                 return make_flat_mutation_reader<single_partition_populating_reader>(*this, make_context());
             }
         });
@@ -766,6 +905,36 @@ row_cache::do_make_reader(schema_ptr s,
     return make_scanning_reader(range, make_context());
 }
 
+void row_cache::maybe_flatten_entry(cache_entry& e) {
+    unsigned threshold = _tracker.max_version_chain_depth();
+    if (threshold == 0) {
+        return;
+    }
+    unsigned depth = 0;
+    for (partition_version& pv : e.partition().versions()) {
+        (void)pv;
+        if (++depth > threshold) {
+            break;
+        }
+    }
+    if (depth <= threshold) {
+        return;
+    }
+    auto phase = phase_of(e.position());
+    if (phase != _underlying_phase) {
+        // The entry is still waiting for the in-progress update, which will
+        // merge the memtable data into the chain anyway when it gets there.
+        return;
+    }
+    // Take a snapshot at the current phase and drop it immediately. This is
+    // exactly what a completed read does, so it doesn't add versions, and
+    // ~partition_snapshot_ptr hands the chain over to the cleaner's worker,
+    // which merges it in the background. Since this is driven by reads, hot
+    // partitions get flattened first and converge to single-version cursors.
+    _tracker.on_version_chain_flatten();
+    e.partition().read(_tracker.region(), _tracker.cleaner(), e.schema(), &_tracker, phase);
+}
+
 flat_mutation_reader
 row_cache::make_reader(schema_ptr s, reader_permit permit, const dht::partition_range& range, const query::partition_slice& query_slice,
         const io_priority_class& pc, tracing::trace_state_ptr trace_state, streamed_mutation::forwarding fwd, mutation_reader::forwarding fwd_mr) {
@@ -917,11 +1086,11 @@ mutation_source& row_cache::snapshot_for_phase(phase_type phase) {
 }
 
 row_cache::snapshot_and_phase row_cache::snapshot_of(dht::ring_position_view pos) {
-    dht::ring_position_less_comparator less(*_schema);
-    if (!_prev_snapshot_pos || less(pos, *_prev_snapshot_pos)) {
-        return {_underlying, _underlying_phase};
+    auto phase = phase_of(pos);
+    if (phase == _underlying_phase) {
+        return {_underlying, phase};
     }
-    return {*_prev_snapshot, _underlying_phase - 1};
+    return {*_prev_snapshot, phase};
 }
 
 void row_cache::invalidate_sync(memtable& m) noexcept {
@@ -948,12 +1117,19 @@ row_cache::phase_type row_cache::phase_of(dht::ring_position_view pos) {
     if (!_prev_snapshot_pos || less(pos, *_prev_snapshot_pos)) {
         return _underlying_phase;
     }
+    // During a concurrent update, each sub-range has its own watermark.
+    // Positions already passed by the fiber owning them reflect the new snapshot.
+    for (const update_subrange& sr : _update_subranges) {
+        if (!less(pos, sr.start) && less(pos, sr.pos)) {
+            return _underlying_phase;
+        }
+    }
     return _underlying_phase - 1;
 }
 
 template <typename Updater>
-future<> row_cache::do_update(external_updater eu, memtable& m, Updater updater) {
-  return do_update(std::move(eu), [this, &m, updater = std::move(updater)] {
+future<> row_cache::do_update(external_updater eu, memtable& m, Updater updater, unsigned concurrency) {
+  return do_update(std::move(eu), [this, &m, updater = std::move(updater), concurrency] {
     real_dirty_memory_accounter real_dirty_acc(m, _tracker);
     m.on_detach_from_region_group();
     _tracker.region().merge(m); // Now all data in memtable belongs to cache
@@ -964,77 +1140,164 @@ future<> row_cache::do_update(external_updater eu, memtable& m, Updater updater)
         STAP_PROBE(scylla, row_cache_update_end);
     });
 
-    return seastar::async([this, &m, updater = std::move(updater), real_dirty_acc = std::move(real_dirty_acc)] () mutable {
-        size_t size_entry;
+    return seastar::async([this, &m, updater = std::move(updater), real_dirty_acc = std::move(real_dirty_acc), concurrency] () mutable {
         // In case updater fails, we must bring the cache to consistency without deferring.
         auto cleanup = defer([&m, this] () noexcept {
             invalidate_sync(m);
+            _update_subranges.clear();
             _prev_snapshot_pos = {};
             _prev_snapshot = {};
         });
-        utils::coroutine update; // Destroy before cleanup to release snapshots before invalidating.
-        partition_presence_checker is_present = _prev_snapshot->make_partition_presence_checker();
-        while (!m.partitions.empty()) {
-            with_allocator(_tracker.allocator(), [&] () {
-                auto cmp = dht::ring_position_comparator(*_schema);
-                {
+
+        // Merges memtable entries with positions in [start, end) into cache,
+        // always picking the first not-yet-merged entry of the sub-range.
+        // A disengaged bound means the respective end of the ring. The watermark
+        // separating positions which already reflect the new snapshot from those
+        // which don't is advanced between deferring points:
+        //   - in serial mode (cursor == nullptr) it is _prev_snapshot_pos,
+        //   - in concurrent mode it is cursor->pos of this fiber's sub-range.
+        auto update_one_subrange = [&] (std::optional<dht::ring_position> start,
+                                        std::optional<dht::ring_position> end,
+                                        update_subrange* cursor) {
+            size_t size_entry = 0;
+            bool done = false;
+            utils::coroutine update; // Destroy before cleanup to release snapshots before invalidating.
+            partition_presence_checker is_present = _prev_snapshot->make_partition_presence_checker();
+            auto mem_cmp = dht::ring_position_comparator(*m.schema());
+            // Returns the first unmerged entry of the sub-range, or end() when
+            // the sub-range is exhausted. Invalidated by deferring points, so
+            // must be re-obtained inside each allocating section.
+            auto first_entry = [&] () -> memtable::partitions_type::iterator {
+                memtable::partitions_type::bound_hint mem_hint;
+                auto it = start ? m.partitions.lower_bound(*start, mem_cmp, mem_hint) : m.partitions.begin();
+                if (it != m.partitions.end() && end && mem_cmp(it->key(), *end) >= 0) {
+                    return m.partitions.end();
+                }
+                return it;
+            };
+            while (!done) {
+                with_allocator(_tracker.allocator(), [&] () {
+                    auto cmp = dht::ring_position_comparator(*_schema);
                     size_t partition_count = 0;
-                    {
-                        STAP_PROBE(scylla, row_cache_update_one_batch_start);
-                        // FIXME: we should really be checking should_yield() here instead of
-                        // need_preempt(). However, should_yield() is currently quite
-                        // expensive and we need to amortize it somehow.
-                        do {
-                          STAP_PROBE(scylla, row_cache_update_partition_start);
-                          {
-                            if (!update) {
-                                _update_section(_tracker.region(), [&] {
-                                    memtable_entry& mem_e = *m.partitions.begin();
-                                    size_entry = mem_e.size_in_allocator_without_rows(_tracker.allocator());
-                                    partitions_type::bound_hint hint;
-                                    auto cache_i = _partitions.lower_bound(mem_e.key(), cmp, hint);
-                                    update = updater(_update_section, cache_i, mem_e, is_present, real_dirty_acc, hint);
-                                });
-                            }
-                            // We use cooperative deferring instead of futures so that
-                            // this layer has a chance to restore invariants before deferring,
-                            // in particular set _prev_snapshot_pos to the correct value.
-                            if (update.run() == stop_iteration::no) {
-                                return;
-                            }
-                            update = {};
-                            real_dirty_acc.unpin_memory(size_entry);
+                    STAP_PROBE(scylla, row_cache_update_one_batch_start);
+                    // FIXME: we should really be checking should_yield() here instead of
+                    // need_preempt(). However, should_yield() is currently quite
+                    // expensive and we need to amortize it somehow.
+                    do {
+                        STAP_PROBE(scylla, row_cache_update_partition_start);
+                        if (!update) {
                             _update_section(_tracker.region(), [&] {
-                                auto i = m.partitions.begin();
-                                i.erase_and_dispose(dht::raw_token_less_comparator{}, [&] (memtable_entry* e) noexcept {
-                                    m.evict_entry(*e, _tracker.memtable_cleaner());
-                                });
+                                auto mem_i = first_entry();
+                                if (mem_i == m.partitions.end()) {
+                                    done = true;
+                                    return;
+                                }
+                                memtable_entry& mem_e = *mem_i;
+                                size_entry = mem_e.size_in_allocator_without_rows(_tracker.allocator());
+                                partitions_type::bound_hint hint;
+                                auto cache_i = _partitions.lower_bound(mem_e.key(), cmp, hint);
+                                update = updater(_update_section, cache_i, mem_e, is_present, real_dirty_acc, hint);
                             });
-                            ++partition_count;
-                          }
-                          STAP_PROBE(scylla, row_cache_update_partition_end);
-                        } while (!m.partitions.empty() && !need_preempt());
-                        with_allocator(standard_allocator(), [&] {
-                            if (m.partitions.empty()) {
-                                _prev_snapshot_pos = {};
+                            if (done) {
+                                break;
+                            }
+                        }
+                        // We use cooperative deferring instead of futures so that
+                        // this layer has a chance to restore invariants before deferring,
+                        // in particular set the watermark to the correct value.
+                        if (update.run() == stop_iteration::no) {
+                            return;
+                        }
+                        update = {};
+                        real_dirty_acc.unpin_memory(size_entry);
+                        _update_section(_tracker.region(), [&] {
+                            auto i = first_entry();
+                            i.erase_and_dispose(dht::raw_token_less_comparator{}, [&] (memtable_entry* e) noexcept {
+                                m.evict_entry(*e, _tracker.memtable_cleaner());
+                            });
+                        });
+                        ++partition_count;
+                        STAP_PROBE(scylla, row_cache_update_partition_end);
+                    } while (!need_preempt());
+                    with_allocator(standard_allocator(), [&] {
+                        _update_section(_tracker.region(), [&] {
+                            auto mem_i = first_entry();
+                            if (mem_i == m.partitions.end()) {
+                                done = true;
+                                if (cursor) {
+                                    cursor->pos = end ? dht::ring_position_ext(*end) : dht::ring_position_ext::max();
+                                } else {
+                                    _prev_snapshot_pos = {};
+                                }
+                            } else if (cursor) {
+                                cursor->pos = dht::ring_position_ext(mem_i->key());
                             } else {
-                                _update_section(_tracker.region(), [&] {
-                                    _prev_snapshot_pos = m.partitions.begin()->key();
-                                });
+                                _prev_snapshot_pos = mem_i->key();
                             }
                         });
-                        STAP_PROBE1(scylla, row_cache_update_one_batch_end, partition_count);
-                    }
+                    });
+                    STAP_PROBE1(scylla, row_cache_update_one_batch_end, partition_count);
+                });
+                real_dirty_acc.commit();
+                if (!done) {
+                    seastar::thread::yield();
                 }
-            });
-            real_dirty_acc.commit();
-            seastar::thread::yield();
+            }
+        };
+
+        if (concurrency <= 1) {
+            update_one_subrange(std::nullopt, std::nullopt, nullptr);
+        } else {
+            // Split the ring into a power-of-two number of token sub-ranges,
+            // each merged into cache by its own fiber. _prev_snapshot_pos stays
+            // at ring_position::min() for the duration, so phase_of() resolves
+            // phases through _update_subranges and reads only wait for the
+            // fiber covering the key they touch.
+            unsigned fibers_n = 2;
+            while (fibers_n * 2 <= concurrency && fibers_n < 8) {
+                fibers_n *= 2;
+            }
+            std::vector<dht::token> bounds;
+            bounds.push_back(dht::minimum_token());
+            bounds.push_back(dht::maximum_token());
+            while (bounds.size() - 1 < fibers_n) {
+                std::vector<dht::token> finer;
+                finer.reserve(bounds.size() * 2 - 1);
+                for (size_t i = 0; i + 1 < bounds.size(); ++i) {
+                    finer.push_back(bounds[i]);
+                    finer.push_back(dht::token::midpoint(bounds[i], bounds[i + 1]));
+                }
+                finer.push_back(bounds.back());
+                bounds = std::move(finer);
+            }
+            _update_subranges.clear();
+            _update_subranges.reserve(fibers_n);
+            for (unsigned i = 0; i < fibers_n; ++i) {
+                auto start = i == 0 ? dht::ring_position_ext::min()
+                                    : dht::ring_position_ext::starting_at(bounds[i]);
+                _update_subranges.push_back(update_subrange{start, start});
+            }
+            std::vector<future<>> fibers;
+            fibers.reserve(fibers_n);
+            for (unsigned i = 0; i < fibers_n; ++i) {
+                auto start = i == 0 ? std::nullopt
+                                    : std::make_optional(dht::ring_position::starting_at(bounds[i]));
+                auto end = i + 1 == fibers_n ? std::nullopt
+                                             : std::make_optional(dht::ring_position::starting_at(bounds[i + 1]));
+                fibers.push_back(seastar::async([&update_one_subrange, start = std::move(start), end = std::move(end),
+                        cursor = &_update_subranges[i]] () mutable {
+                    update_one_subrange(std::move(start), std::move(end), cursor);
+                }));
+            }
+            when_all_succeed(fibers.begin(), fibers.end()).get();
+            _update_subranges.clear();
+            _prev_snapshot_pos = {};
         }
     }).finally([cleanup = std::move(cleanup)] {});
   });
 }
 
-future<> row_cache::update(external_updater eu, memtable& m) {
+future<> row_cache::update(external_updater eu, memtable& m, unsigned concurrency) {
     return do_update(std::move(eu), m, [this] (logalloc::allocating_section& alloc,
             row_cache::partitions_type::iterator cache_i, memtable_entry& mem_e, partition_presence_checker& is_present,
             real_dirty_memory_accounter& acc, const partitions_type::bound_hint& hint) mutable {
@@ -1064,7 +1327,7 @@ future<> row_cache::update(external_updater eu, memtable& m) {
         } else {
             return utils::make_empty_coroutine();
         }
-    });
+    }, concurrency);
 }
 
 future<> row_cache::update_invalidating(external_updater eu, memtable& m) {
@@ -1195,6 +1458,22 @@ void row_cache::evict() {
     while (_tracker.region().evict_some() == memory::reclaiming_result::reclaimed_something) {}
 }
 
+std::vector<dht::decorated_key> row_cache::cached_partition_keys(size_t max_keys) {
+    std::vector<dht::decorated_key> keys;
+    _read_section(_tracker.region(), [&] {
+        for (auto& e : _partitions) {
+            if (e.is_dummy_entry()) {
+                continue;
+            }
+            if (max_keys && keys.size() >= max_keys) {
+                break;
+            }
+            keys.push_back(e.key());
+        }
+    });
+    return keys;
+}
+
 row_cache::row_cache(schema_ptr s, snapshot_source src, cache_tracker& tracker, is_continuous cont)
     : _tracker(tracker)
     , _schema(std::move(s))
@@ -1356,6 +1635,7 @@ future<> row_cache::do_update(row_cache::external_updater eu, row_cache::interna
         return futurize_invoke([&iu] {
             return iu();
         }).then_wrapped([this, permit = std::move(permit)] (auto f) {
+            _update_subranges.clear();
             _prev_snapshot_pos = {};
             _prev_snapshot = {};
             if (f.failed()) {
@@ -258,6 +258,18 @@ private:
     // Positions >= than this are using _prev_snapshot, the rest is using _underlying.
     std::optional<dht::ring_position_ext> _prev_snapshot_pos;
 
+    // When update() runs with concurrency > 1, the ring is divided into disjoint
+    // token sub-ranges, each merged into cache by its own fiber. Positions in
+    // [start, pos) were already processed and use _underlying, the rest of the
+    // sub-range is still using _prev_snapshot. Empty outside of such updates.
+    // During these updates _prev_snapshot_pos is set to ring_position::min() so
+    // that phase_of() falls through to the sub-range check.
+    struct update_subrange {
+        dht::ring_position_ext start;
+        dht::ring_position_ext pos;
+    };
+    std::vector<update_subrange> _update_subranges;
+
     snapshot_source _snapshot_source;
 
     // There can be at most one update in progress.
@@ -275,6 +287,9 @@ private:
     void on_static_row_insert();
     void on_mispopulate();
     void upgrade_entry(cache_entry&);
+    // If the entry's partition_version chain is deeper than the tracker's
+    // threshold, hands it over to the cleaner for background flattening.
+    void maybe_flatten_entry(cache_entry&);
     void invalidate_locked(const dht::decorated_key&);
     void clear_now() noexcept;
 
@@ -339,8 +354,10 @@ private:
     // into _partitions (cache_i), and the memtable entry.
     // It is invoked inside allocating section and in the context of cache's allocator.
     // All memtable entries will be removed.
+    // When concurrency > 1 the memtable is merged by several fibers, each
+    // owning a disjoint token sub-range (see _update_subranges).
     template <typename Updater>
-    future<> do_update(external_updater, memtable& m, Updater func);
+    future<> do_update(external_updater, memtable& m, Updater func, unsigned concurrency = 1);
 
     // Clears given memtable invalidating any affected cache elements.
     void invalidate_sync(memtable&) noexcept;
@@ -402,7 +419,10 @@ public:
     // has just been flushed to the underlying data source.
     // The memtable can be queried during the process, but must not be written.
     // After the update is complete, memtable is empty.
-    future<> update(external_updater, memtable&);
+    // concurrency controls how many fibers merge the memtable in parallel,
+    // each owning a disjoint token sub-range. Reads only wait for the fiber
+    // covering the key they touch. Rounded down to a power of two, capped at 8.
+    future<> update(external_updater, memtable&, unsigned concurrency = 1);
 
     // Like update(), synchronizes cache with an incremental change to the underlying
     // mutation source, but instead of inserting and merging data, invalidates affected ranges.
@@ -445,6 +465,12 @@ public:
     // If it did, use invalidate() instead.
     void evict();
 
+    // Returns the keys of partitions currently present in cache, in ring
+    // order, up to max_keys (0 means no limit). Used for hot-set
+    // checkpointing (db/cache_warmup.hh). Runs synchronously, so callers
+    // should pass a reasonable limit when the cache may be large.
+    std::vector<dht::decorated_key> cached_partition_keys(size_t max_keys = 0);
+
     const cache_tracker& get_cache_tracker() const {
         return _tracker;
     }
@@ -54,7 +54,7 @@ schema_registry_entry::schema_registry_entry(table_schema_version v, schema_regi
         slogger.debug("Dropping {}", _version);
         assert(!_schema);
         try {
-            _registry._entries.erase(_version);
+            _registry.erase(_version);
         } catch (...) {
             slogger.error("Failed to erase schema version {}: {}", _version, std::current_exception());
         }
@@ -71,9 +71,9 @@ schema_ptr schema_registry::learn(const schema_ptr& s) {
     if (s->registry_entry()) {
         return std::move(s);
     }
-    auto i = _entries.find(s->version());
-    if (i != _entries.end()) {
-        return i->second->get_schema();
+    auto e = lookup(s->version());
+    if (e) {
+        return e->get_schema();
     }
     slogger.debug("Learning about version {} of {}.{}", s->version(), s->ks_name(), s->cf_name());
     auto e_ptr = make_lw_shared<schema_registry_entry>(s->version(), *this);
@@ -82,16 +82,35 @@ schema_ptr schema_registry::learn(const schema_ptr& s) {
     return loaded_s;
 }
 
-schema_registry_entry& schema_registry::get_entry(table_schema_version v) const {
+lw_shared_ptr<schema_registry_entry> schema_registry::lookup(table_schema_version v) const {
+    auto& slot = _recent_entries[uint64_t(v.get_least_significant_bits()) & (recent_entries_count - 1)];
+    if (slot && slot->_version == v) {
+        return slot;
+    }
     auto i = _entries.find(v);
     if (i == _entries.end()) {
-        throw schema_version_not_found(v);
+        return nullptr;
+    }
+    if (i->second->_state == schema_registry_entry::state::LOADED) {
+        slot = i->second;
     }
-    schema_registry_entry& e = *i->second;
-    if (e._state != schema_registry_entry::state::LOADED) {
+    return i->second;
+}
+
+void schema_registry::erase(table_schema_version v) {
+    auto& slot = _recent_entries[uint64_t(v.get_least_significant_bits()) & (recent_entries_count - 1)];
+    if (slot && slot->_version == v) {
+        slot = nullptr;
+    }
+    _entries.erase(v);
+}
+
+schema_registry_entry& schema_registry::get_entry(table_schema_version v) const {
+    auto e = lookup(v);
+    if (!e || e->_state != schema_registry_entry::state::LOADED) {
         throw schema_version_not_found(v);
     }
-    return e;
+    return *e;
 }
 
 schema_registry_entry::erase_clock::duration schema_registry::grace_period() const {
@@ -107,45 +126,39 @@ frozen_schema schema_registry::get_frozen(table_schema_version v) const {
 }
 
 future<schema_ptr> schema_registry::get_or_load(table_schema_version v, const async_schema_loader& loader) {
-    auto i = _entries.find(v);
-    if (i == _entries.end()) {
+    auto e = lookup(v);
+    if (!e) {
         auto e_ptr = make_lw_shared<schema_registry_entry>(v, *this);
         auto f = e_ptr->start_loading(loader);
         _entries.emplace(v, e_ptr);
         return f;
     }
-    schema_registry_entry& e = *i->second;
-    if (e._state == schema_registry_entry::state::LOADING) {
-        return e._schema_promise.get_shared_future();
+    if (e->_state == schema_registry_entry::state::LOADING) {
+        return e->_schema_promise.get_shared_future();
     }
-    return make_ready_future<schema_ptr>(e.get_schema());
+    return make_ready_future<schema_ptr>(e->get_schema());
 }
 
 schema_ptr schema_registry::get_or_null(table_schema_version v) const {
-    auto i = _entries.find(v);
-    if (i == _entries.end()) {
+    auto e = lookup(v);
+    if (!e || e->_state != schema_registry_entry::state::LOADED) {
         return nullptr;
     }
-    schema_registry_entry& e = *i->second;
-    if (e._state != schema_registry_entry::state::LOADED) {
-        return nullptr;
-    }
-    return e.get_schema();
+    return e->get_schema();
 }
 
 schema_ptr schema_registry::get_or_load(table_schema_version v, const schema_loader& loader) {
-    auto i = _entries.find(v);
-    if (i == _entries.end()) {
+    auto e = lookup(v);
+    if (!e) {
         auto e_ptr = make_lw_shared<schema_registry_entry>(v, *this);
         auto s = e_ptr->load(loader(v));
         _entries.emplace(v, e_ptr);
         return s;
     }
-    schema_registry_entry& e = *i->second;
-    if (e._state == schema_registry_entry::state::LOADING) {
-        return e.load(loader(v));
+    if (e->_state == schema_registry_entry::state::LOADING) {
+        return e->load(loader(v));
     }
-    return e.get_schema();
+    return e->get_schema();
 }
 
 schema_ptr schema_registry_entry::load(frozen_schema fs) {
@@ -182,7 +195,7 @@ future<schema_ptr> schema_registry_entry::start_loading(async_schema_loader load
         } catch (...) {
             slogger.debug("Loading of {} failed: {}", _version, std::current_exception());
             _schema_promise.set_exception(std::current_exception());
-            _registry._entries.erase(_version);
+            _registry.erase(_version);
         }
     });
     return sf;
@@ -21,6 +21,7 @@
 
 #pragma once
 
+#include <array>
 #include <unordered_map>
 #include <seastar/core/shared_ptr.hh>
 #include <seastar/core/timer.hh>
@@ -115,10 +116,27 @@ public:
 //
 class schema_registry {
     std::unordered_map<table_schema_version, lw_shared_ptr<schema_registry_entry>> _entries;
+
+    // Version resolution runs on every RPC deserialization, and a burst of
+    // requests resolves the same few versions over and over. Recently
+    // resolved entries are kept aside in a small direct-mapped cache so that
+    // repeats are served without a map lookup. Only entries in the LOADED
+    // state are cached, and a cached entry is dropped when it is erased from
+    // the registry, so a cache hit never needs to revalidate against the map.
+    static constexpr size_t recent_entries_count = 64; // must be a power of 2
+    mutable std::array<lw_shared_ptr<schema_registry_entry>, recent_entries_count> _recent_entries;
+
     std::unique_ptr<db::schema_ctxt> _ctxt;
 
     friend class schema_registry_entry;
     schema_registry_entry& get_entry(table_schema_version) const;
+    // Looks up the entry for a version, first in the recently-resolved cache
+    // and then in the map, caching LOADED entries. Returns nullptr when the
+    // version is not known.
+    lw_shared_ptr<schema_registry_entry> lookup(table_schema_version) const;
+    // Removes the entry for a version, if any, from both the map and the
+    // recently-resolved cache.
+    void erase(table_schema_version);
     // Duration for which unused entries are kept alive to avoid
     // too frequent re-requests and syncs. Default is 1 second.
     schema_registry_entry::erase_clock::duration grace_period() const;
@@ -23,24 +23,53 @@
 
 #include "seastarx.hh"
 #include <seastar/core/semaphore.hh>
+#include <seastar/core/when_all.hh>
 
 namespace service {
 
+// Gates the memory consumed by requests making their way through the system.
+//
+// The byte budget is split into admission classes so that tenants whose
+// service level marks them as batch (bulk ingestion and the like) compete
+// only among themselves for their slice of the budget and can never occupy
+// the memory that interactive requests need in order to get admitted.
+// Requests without a service level, or whose service level leaves the
+// workload type unspecified, count as interactive.
 class memory_limiter final {
+public:
+    enum class admission_class { interactive, batch };
+
+    // The fraction of the budget reserved for batch workloads. Interactive
+    // requests get the remaining three quarters.
+    static constexpr size_t batch_share_inverse = 4;
+
+private:
     size_t _mem_total;
-    semaphore _sem;
+    size_t _batch_total;
+    semaphore _sem;       // interactive share
+    semaphore _batch_sem; // batch share
 
 public:
     memory_limiter(size_t available_memory) noexcept
         : _mem_total(available_memory / 10)
-        , _sem(_mem_total) {}
+        , _batch_total(_mem_total / batch_share_inverse)
+        , _sem(_mem_total - _batch_total)
+        , _batch_sem(_batch_total) {}
 
     future<> stop() {
-        return _sem.wait(_mem_total);
+        return when_all_succeed(_sem.wait(_mem_total - _batch_total),
+                _batch_sem.wait(_batch_total)).discard_result();
     }
 
     size_t total_memory() const noexcept { return _mem_total; }
+    size_t total_memory(admission_class c) const noexcept {
+        return c == admission_class::batch ? _batch_total : _mem_total - _batch_total;
+    }
+
     semaphore& get_semaphore() noexcept { return _sem; }
+    semaphore& get_semaphore(admission_class c) noexcept {
+        return c == admission_class::batch ? _batch_sem : _sem;
+    }
 };
 
 } // namespace service
@@ -300,6 +300,7 @@ void view_update_backlog_broker::on_change(gms::inet_address endpoint, gms::appl
         auto backlog = view_update_backlog_timestamped{db::view::update_backlog{current, max}, ticks};
         auto[it, inserted] = _sp.local()._view_update_backlogs.try_emplace(endpoint, std::move(backlog));
         if (!inserted && it->second.ts < backlog.ts) {
+            backlog.backlog = db::view::update_backlog::controlled_update(it->second.backlog, backlog.backlog);
             it->second = std::move(backlog);
         }
     }
@@ -99,6 +99,12 @@ protected:
     std::optional<db::read_repair_decision> _query_read_repair_decision;
     uint64_t _rows_fetched_for_last_partition = 0;
     stats _stats;
+    // Adaptive sizing of coordinator-internal pages, see internal_page_size().
+    uint32_t _internal_page_size_multiplier = 1;
+    // Whether the last page filled its row limit without being cut short by
+    // the replica-side result size limit, i.e. rows - not bytes - were the
+    // limiter. Maintained by handle_result().
+    bool _last_page_filled = false;
 public:
     query_pager(schema_ptr s, shared_ptr<const cql3::selection::selection> selection,
                 service::query_state& state,
@@ -122,6 +128,13 @@ public:
 
     future<cql3::result_generator> fetch_page_generator(uint32_t page_size, gc_clock::time_point now, db::timeout_clock::time_point timeout, cql3::cql_stats& stats);
 
+    /**
+     * Fetches the next page but returns only its row count, without visiting
+     * the rows. The count comes from the replicas, so this lets lone
+     * COUNT(*) queries skip per-row processing on the coordinator entirely.
+     */
+    future<uint64_t> fetch_page_row_count(uint32_t page_size, gc_clock::time_point now, db::timeout_clock::time_point timeout);
+
     /**
      * Whether or not this pager is exhausted, i.e. whether or not a call to
      * fetchPage may return more result.
@@ -155,6 +168,19 @@ public:
         return _stats;
     }
 
+    /**
+     * The page size to use for the next coordinator-internal page. Internal
+     * paging (aggregates, whole-query counts) walks pages that are never sent
+     * to the client, so their row count is ours to choose; replica-side short
+     * reads keep each page's bytes bounded regardless. The size doubles after
+     * every page that filled its row limit without being cut short - the
+     * signature of a scan of small rows, where per-page overhead dominates -
+     * and stops growing once bytes become the limiter. Must not be used for
+     * pages returned to the client, which expects at most its requested
+     * page size.
+     */
+    uint32_t internal_page_size(uint32_t page_size);
+
 protected:
     template<typename Base>
     class query_result_visitor;
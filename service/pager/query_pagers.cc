@@ -39,6 +39,8 @@
  * along with Scylla.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <limits>
+
 #include "query_pagers.hh"
 #include "query_pager.hh"
 #include "cql3/selection/selection.hh"
@@ -238,6 +240,27 @@ future<cql3::result_generator> query_pager::fetch_page_generator(uint32_t page_s
     });
 }
 
+uint32_t query_pager::internal_page_size(uint32_t page_size) {
+    // Cap the growth so a single page stays bounded even if the replica-side
+    // size limit is very permissive for this slice.
+    static constexpr uint32_t max_multiplier = 16;
+    if (_last_page_filled && _internal_page_size_multiplier < max_multiplier) {
+        _internal_page_size_multiplier *= 2;
+    }
+    const auto grown = uint64_t(page_size) * _internal_page_size_multiplier;
+    return std::min<uint64_t>(grown, std::numeric_limits<int32_t>::max());
+}
+
+future<uint64_t> query_pager::fetch_page_row_count(uint32_t page_size, gc_clock::time_point now, db::timeout_clock::time_point timeout) {
+    return do_fetch_page(page_size, now, timeout).then([this, page_size, now] (service::storage_proxy::coordinator_query_result qr) {
+        _last_replicas = std::move(qr.last_replicas);
+        _query_read_repair_decision = qr.read_repair_decision;
+        const auto max_before = _max;
+        handle_result(noop_visitor(), qr.query_result, page_size, now);
+        return max_before - _max;
+    });
+}
+
 class filtering_query_pager : public query_pager {
     ::shared_ptr<cql3::restrictions::statement_restrictions> _filtering_restrictions;
 public:
@@ -346,6 +369,7 @@ public:
             row_count = v.total_rows - v.dropped_rows;
             _max = _max - row_count;
             _exhausted = (v.total_rows < page_size && !results->is_short_read() && v.dropped_rows == 0) || _max == 0;
+            _last_page_filled = v.total_rows >= page_size && !results->is_short_read();
             // If per partition limit is defined, we need to accumulate rows fetched for last partition key if the key matches
             if (_cmd->slice.partition_row_limit() < query::max_rows_if_set) {
                 if (_last_pkey && v.last_pkey && _last_pkey->equal(*_schema, *v.last_pkey)) {
@@ -360,6 +384,7 @@ public:
             row_count = results->row_count() ? *results->row_count() : std::get<1>(view.count_partitions_and_rows());
             _max = _max - row_count;
             _exhausted = (row_count < page_size && !results->is_short_read()) || _max == 0;
+            _last_page_filled = row_count >= page_size && !results->is_short_read();
 
             if (!_exhausted && row_count > 0) {
                 if (_last_pkey) {
@@ -37,6 +37,10 @@ private:
     client_state& _client_state;
     tracing::trace_state_ptr _trace_state_ptr;
     service_permit _permit;
+    // True only for callers that can replay the raw request on another shard
+    // when a statement returns a bounce_to_shard result message (i.e. the CQL
+    // transport). Everyone else must execute statements in place.
+    bool _bounce_to_shard_allowed = false;
 
 public:
     query_state(client_state& client_state, service_permit permit)
@@ -82,6 +86,14 @@ public:
         return _client_state.get_service_level_controller();
     }
 
+    bool bounce_to_shard_allowed() const {
+        return _bounce_to_shard_allowed;
+    }
+
+    void set_bounce_to_shard_allowed(bool allowed) {
+        _bounce_to_shard_allowed = allowed;
+    }
+
 };
 
 }
@@ -192,7 +192,7 @@ future<> raft_sys_table_storage::do_store_log_entries(const std::vector<raft::lo
     // fragmented storage for log_entries data
     std::vector<fragmented_temporary_buffer> stmt_data_views;
     // statement value views -- required for `query_options` to consume `fragmented_temporary_buffer::view`
-    std::vector<std::vector<cql3::raw_value_view>> stmt_value_views;
+    std::vector<cql3::raw_value_view_vector> stmt_value_views;
     const size_t entries_size = entries.size();
     batch_stmts.reserve(entries_size);
     stmt_values.reserve(entries_size);
@@ -218,7 +218,7 @@ future<> raft_sys_table_storage::do_store_log_entries(const std::vector<raft::lo
         stmt_data_views.emplace_back(std::move(data_tmp_buf));
 
         // allocate value views
-        std::vector<cql3::raw_value_view> value_views;
+        cql3::raw_value_view_vector value_views;
         value_views.reserve(4); // 4 is the number of required values for the insertion query 
         for (const cql3::raw_value& raw : stmt_values.back()) {
             value_views.push_back(raw.to_view());
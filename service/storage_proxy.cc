@@ -40,6 +40,7 @@
  */
 
 #include <seastar/core/sleep.hh>
+#include <seastar/core/shared_future.hh>
 #include <seastar/util/defer.hh>
 #include "partition_range_compat.hh"
 #include "db/consistency_level.hh"
@@ -96,6 +97,7 @@
 #include "cdc/stats.hh"
 #include "cdc/cdc_options.hh"
 #include "utils/histogram_metrics_helper.hh"
+#include "utils/stall_free.hh"
 #include "service/paxos/prepare_summary.hh"
 #include "service/migration_manager.hh"
 #include "service/paxos/proposal.hh"
@@ -107,6 +109,7 @@
 #include "service/paxos/paxos_state.hh"
 #include "gms/feature_service.hh"
 #include "db/virtual_table.hh"
+#include "db/hot_partition_mirror.hh"
 #include "canonical_mutation.hh"
 #include "schema_mutations.hh"
 #include "serializer_impl.hh"
@@ -178,6 +181,13 @@ unsigned storage_proxy::cas_shard(const schema& s, dht::token token) {
     return dht::shard_of(s, token);
 }
 
+bool storage_proxy::is_local_replica(const schema& s, dht::token token) {
+    keyspace& ks = _db.local().find_keyspace(s.ks_name());
+    auto erm = ks.get_effective_replication_map();
+    return boost::algorithm::any_of_equal(erm->get_natural_endpoints(token),
+            utils::fb_utilities::get_broadcast_address());
+}
+
 class mutation_holder {
 protected:
     size_t _size = 0;
@@ -221,8 +231,15 @@ public:
             _mutations.emplace(m.first, std::move(fm));
         }
     }
+    // Looking up a destination that has no mutation is legitimate (e.g. the
+    // local node during a read repair that only writes remotely), so don't
+    // let operator[] grow the map with empty entries for such lookups.
+    lw_shared_ptr<const frozen_mutation> mutation_for(gms::inet_address ep) const {
+        auto it = _mutations.find(ep);
+        return it != _mutations.end() ? it->second : nullptr;
+    }
     virtual bool store_hint(db::hints::manager& hm, gms::inet_address ep, tracing::trace_state_ptr tr_state) override {
-        auto m = _mutations[ep];
+        auto m = mutation_for(ep);
         if (m) {
             return hm.store_hint(ep, _schema, std::move(m), tr_state);
         } else {
@@ -231,7 +248,7 @@ public:
     }
     virtual future<> apply_locally(storage_proxy& sp, storage_proxy::clock_type::time_point timeout,
             tracing::trace_state_ptr tr_state) override {
-        auto m = _mutations[utils::fb_utilities::get_broadcast_address()];
+        auto m = mutation_for(utils::fb_utilities::get_broadcast_address());
         if (m) {
             tracing::trace(tr_state, "Executing a mutation locally");
             return sp.mutate_locally(_schema, *m, std::move(tr_state), db::commitlog::force_sync::no, timeout);
@@ -241,7 +258,7 @@ public:
     virtual future<> apply_remotely(storage_proxy& sp, gms::inet_address ep, inet_address_vector_replica_set&& forward,
             storage_proxy::response_id_type response_id, storage_proxy::clock_type::time_point timeout,
             tracing::trace_state_ptr tr_state) override {
-        auto m = _mutations[ep];
+        auto m = mutation_for(ep);
         if (m) {
             tracing::trace(tr_state, "Sending a mutation to /{}", ep);
             return sp._messaging.send_mutation(netw::messaging_service::msg_addr{ep, 0}, timeout, *m,
@@ -289,6 +306,11 @@ public:
     virtual future<> apply_remotely(storage_proxy& sp, gms::inet_address ep, inet_address_vector_replica_set&& forward,
             storage_proxy::response_id_type response_id, storage_proxy::clock_type::time_point timeout,
             tracing::trace_state_ptr tr_state) override {
+        // The batched verb carries neither a forward list nor per-write trace
+        // info, so coalesce only plain untraced writes.
+        if (forward.empty() && !tr_state && sp.should_coalesce_writes()) {
+            return sp.send_mutation_coalesced(ep, *_mutation, response_id, timeout);
+        }
         tracing::trace(tr_state, "Sending a mutation to /{}", ep);
         return sp._messaging.send_mutation(netw::messaging_service::msg_addr{ep, 0}, timeout, *_mutation,
                 std::move(forward), utils::fb_utilities::get_broadcast_address(), this_shard_id(),
@@ -370,6 +392,78 @@ public:
     };
 };
 
+// A per-replica buffer of writes held back for up to the configured coalescing
+// window so that they leave as a single MUTATION_BATCH message. Each batched
+// write keeps its own response id and is acknowledged by the replica with an
+// individual MUTATION_DONE/MUTATION_FAILED, so response handling is unchanged;
+// only the request side of the RPC is shared.
+class storage_proxy::pending_mutation_batch {
+public:
+    std::vector<frozen_mutation> fms;
+    std::vector<storage_proxy::response_id_type> response_ids;
+    size_t size = 0;
+    // The earliest timeout among the batched writes, used as the timeout of
+    // the combined message.
+    storage_proxy::clock_type::time_point timeout = storage_proxy::clock_type::time_point::max();
+    // Resolved when the combined message has been sent (or failed to send),
+    // standing in for the futures send_mutation() would have returned for the
+    // individual writes.
+    shared_promise<> sent;
+    timer<storage_proxy::clock_type> flush_timer;
+};
+
+// Flush a batch early once it would no longer produce a small packet anyway.
+static constexpr size_t max_coalesced_write_bytes = 128 * 1024;
+
+bool storage_proxy::should_coalesce_writes() const {
+    return _features.cluster_supports_coalesced_mutations()
+            && _db.local().get_config().write_coalescing_window_in_us() > 0;
+}
+
+future<> storage_proxy::send_mutation_coalesced(gms::inet_address ep, const frozen_mutation& fm,
+        response_id_type response_id, clock_type::time_point timeout) {
+    auto it = _pending_mutation_batches.find(ep);
+    if (it == _pending_mutation_batches.end()) {
+        auto batch = std::make_unique<pending_mutation_batch>();
+        batch->flush_timer.set_callback([this, ep] { flush_mutation_batch(ep); });
+        batch->flush_timer.arm(std::chrono::microseconds(_db.local().get_config().write_coalescing_window_in_us()));
+        it = _pending_mutation_batches.emplace(ep, std::move(batch)).first;
+    }
+    auto& batch = *it->second;
+    batch.size += fm.representation().size();
+    batch.fms.emplace_back(fm);
+    batch.response_ids.push_back(response_id);
+    batch.timeout = std::min(batch.timeout, timeout);
+    auto f = batch.sent.get_shared_future();
+    if (batch.size >= max_coalesced_write_bytes) {
+        flush_mutation_batch(ep);
+    }
+    return f;
+}
+
+void storage_proxy::flush_mutation_batch(gms::inet_address ep) {
+    auto it = _pending_mutation_batches.find(ep);
+    if (it == _pending_mutation_batches.end()) {
+        return;
+    }
+    auto batch = std::move(it->second);
+    _pending_mutation_batches.erase(it);
+    batch->flush_timer.cancel();
+    auto& b = *batch;
+    // Waited on indirectly: resolving `sent` completes the per-write futures
+    // returned from send_mutation_coalesced(), whose failures are handled by
+    // send_to_live_endpoints() like individual send_mutation() failures.
+    (void)_messaging.send_mutation_batch(netw::messaging_service::msg_addr{ep, 0}, b.timeout,
+            std::move(b.fms), utils::fb_utilities::get_broadcast_address(), this_shard_id(),
+            std::move(b.response_ids)).then_wrapped([batch = std::move(batch)] (future<> f) {
+        if (f.failed()) {
+            batch->sent.set_exception(f.get_exception());
+        } else {
+            batch->sent.set_value();
+        }
+    });
+}
+
 class abstract_write_response_handler : public seastar::enable_shared_from_this<abstract_write_response_handler> {
 protected:
     using error = storage_proxy::error;
@@ -504,6 +598,11 @@ public:
     bool response(gms::inet_address from) {
         auto it = boost::find(_targets, from);
         if (it != _targets.end()) {
+            if (_cl_achieved) {
+                // The client response has already completed; this replica is
+                // lagging behind the ones that formed the consistency level.
+                ++_stats.writes_late_acks.get_ep_stat(from);
+            }
             signal(from);
             using std::swap;
             swap(*it, _targets.back());
@@ -1423,7 +1522,12 @@ void storage_proxy::got_failure_response(storage_proxy::response_id_type id, gms
 void storage_proxy::maybe_update_view_backlog_of(gms::inet_address replica, std::optional<db::view::update_backlog> backlog) {
     if (backlog) {
         auto now = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
-        _view_update_backlogs[replica] = {std::move(*backlog), now};
+        auto it = _view_update_backlogs.find(replica);
+        if (it != _view_update_backlogs.end()) {
+            it->second = {db::view::update_backlog::controlled_update(it->second.backlog, *backlog), now};
+        } else {
+            _view_update_backlogs[replica] = {std::move(*backlog), now};
+        }
     }
 }
 
@@ -1483,19 +1587,22 @@ storage_proxy_stats::write_stats::write_stats()
 : writes_attempts(COORDINATOR_STATS_CATEGORY, "total_write_attempts", "total number of write requests", "mutation_data")
 , writes_errors(COORDINATOR_STATS_CATEGORY, "write_errors", "number of write requests that failed", "mutation_data")
 , background_replica_writes_failed(COORDINATOR_STATS_CATEGORY, "background_replica_writes_failed", "number of replica writes that timed out or failed after CL was reached", "mutation_data")
-, read_repair_write_attempts(COORDINATOR_STATS_CATEGORY, "read_repair_write_attempts", "number of write operations in a read repair context", "mutation_data") { }
+, read_repair_write_attempts(COORDINATOR_STATS_CATEGORY, "read_repair_write_attempts", "number of write operations in a read repair context", "mutation_data")
+, writes_late_acks(COORDINATOR_STATS_CATEGORY, "writes_late_acks", "number of write acknowledgements that arrived after the consistency level had already been reached", "mutation_data") { }
 
 storage_proxy_stats::write_stats::write_stats(const sstring& category, bool auto_register_stats)
         : writes_attempts(category, "total_write_attempts", "total number of write requests", "mutation_data", auto_register_stats)
         , writes_errors(category, "write_errors", "number of write requests that failed", "mutation_data", auto_register_stats)
         , background_replica_writes_failed(category, "background_replica_writes_failed", "number of replica writes that timed out or failed after CL was reached", "mutation_data", auto_register_stats)
-        , read_repair_write_attempts(category, "read_repair_write_attempts", "number of write operations in a read repair context", "mutation_data", auto_register_stats) { }
+        , read_repair_write_attempts(category, "read_repair_write_attempts", "number of write operations in a read repair context", "mutation_data", auto_register_stats)
+        , writes_late_acks(category, "writes_late_acks", "number of write acknowledgements that arrived after the consistency level had already been reached", "mutation_data", auto_register_stats) { }
 
 void storage_proxy_stats::write_stats::register_split_metrics_local() {
     writes_attempts.register_metrics_local();
     writes_errors.register_metrics_local();
     background_replica_writes_failed.register_metrics_local();
     read_repair_write_attempts.register_metrics_local();
+    writes_late_acks.register_metrics_local();
 }
 
 void storage_proxy_stats::write_stats::register_stats() {
@@ -1680,11 +1787,11 @@ void storage_proxy_stats::stats::register_stats() {
 
         sm::make_histogram("cas_read_contention", sm::description("how many contended reads were encountered"),
                        {storage_proxy_stats::current_scheduling_group_label()},
-                       [this]{ return cas_read_contention.get_histogram(1, 8);}),
+                       [this]{ return to_metrics_histogram(cas_read_contention);}),
 
         sm::make_histogram("cas_write_contention", sm::description("how many contended writes were encountered"),
                        {storage_proxy_stats::current_scheduling_group_label()},
-                       [this]{ return cas_write_contention.get_histogram(1, 8);}),
+                       [this]{ return to_metrics_histogram(cas_write_contention);}),
 
         sm::make_total_operations("cas_prune", cas_prune,
                        sm::description("how many times paxos prune was done after successful cas operation"),
@@ -1740,6 +1847,14 @@ void storage_proxy_stats::stats::register_stats() {
                        sm::description("number of operations that crossed a shard boundary"),
                        {storage_proxy_stats::current_scheduling_group_label()}),
 
+        sm::make_total_operations("hot_partition_mirror_hits", hot_partition_mirror_hits,
+                       sm::description("number of cross-shard singular reads served from a local hot partition snapshot"),
+                       {storage_proxy_stats::current_scheduling_group_label()}),
+
+        sm::make_total_operations("hot_partition_mirror_promotions", hot_partition_mirror_promotions,
+                       sm::description("number of hot partition snapshots installed for cross-shard singular reads"),
+                       {storage_proxy_stats::current_scheduling_group_label()}),
+
         sm::make_total_operations("cas_dropped_prune", cas_replica_dropped_prune,
                        sm::description("how many times a coordinator did not perfom prune after cas"),
                        {storage_proxy_stats::current_scheduling_group_label()}),
@@ -1827,7 +1942,8 @@ storage_proxy::storage_proxy(distributed<database>& db, gms::gossiper& gossiper,
     , _hints_write_smp_service_group(cfg.hints_write_smp_service_group)
     , _write_ack_smp_service_group(cfg.write_ack_smp_service_group)
     , _next_response_id(std::chrono::system_clock::now().time_since_epoch()/1ms)
-    , _hints_resource_manager(cfg.available_memory / 10, _db.local().get_config().max_hinted_handoff_concurrency)
+    , _hints_resource_manager(cfg.available_memory / 10, _db.local().get_config().max_hinted_handoff_concurrency,
+            _db.local().get_config().hinted_handoff_throttle_in_kb() * 1024 / smp::count)
     , _hints_manager(_db.local().get_config().hints_directory(), cfg.hinted_handoff_enabled, _db.local().get_config().max_hint_window_in_ms(), _hints_resource_manager, _db)
     , _hints_directory_initializer(std::move(cfg.hints_directory_initializer))
     , _hints_for_views_manager(_db.local().get_config().view_hints_directory(), {}, _db.local().get_config().max_hint_window_in_ms(), _hints_resource_manager, _db)
@@ -2115,8 +2231,9 @@ future<storage_proxy::unique_response_handler_vector> storage_proxy::mutate_prep
 }
 
 future<> storage_proxy::mutate_begin(unique_response_handler_vector ids, db::consistency_level cl,
-                                     tracing::trace_state_ptr trace_state, std::optional<clock_type::time_point> timeout_opt) {
-    return parallel_for_each(ids, [this, cl, timeout_opt] (unique_response_handler& protected_response) {
+                                     tracing::trace_state_ptr trace_state, std::optional<clock_type::time_point> timeout_opt,
+                                     utils::write_path_tracer::slot tslot) {
+    auto f = parallel_for_each(ids, [this, cl, timeout_opt] (unique_response_handler& protected_response) {
         auto response_id = protected_response.id;
         // This function, mutate_begin(), is called after a preemption point
         // so it's possible that other code besides our caller just ran. In
@@ -2147,6 +2264,16 @@ future<> storage_proxy::mutate_begin(unique_response_handler_vector ids, db::con
         send_to_live_endpoints(protected_response.release(), timeout); // response is now running and it will either complete or timeout
         return f;
     });
+    if (!tslot) {
+        return f;
+    }
+    // parallel_for_each() dispatched the sends to all the handlers before
+    // returning, so the remaining wait is for the replica responses.
+    tslot.mark(utils::write_path_tracer::stage::replica_send);
+    return f.finally([tslot] () mutable {
+        tslot.mark(utils::write_path_tracer::stage::ack);
+        utils::get_local_write_path_tracer().end(tslot);
+    });
 }
 
 // this function should be called with a future that holds result of mutation attempt (usually
@@ -2398,10 +2525,12 @@ storage_proxy::mutate_internal(Range mutations, db::consistency_level cl, bool c
     utils::latency_counter lc;
     lc.start();
 
+    auto tslot = utils::get_local_write_path_tracer().begin();
     return mutate_prepare(mutations, cl, type, tr_state, std::move(permit)).then([this, cl, timeout_opt, tracker = std::move(cdc_tracker),
-            tr_state] (storage_proxy::unique_response_handler_vector ids) mutable {
+            tr_state, tslot] (storage_proxy::unique_response_handler_vector ids) mutable {
+        tslot.mark(utils::write_path_tracer::stage::route);
         register_cdc_operation_result_tracker(ids, tracker);
-        return mutate_begin(std::move(ids), cl, tr_state, timeout_opt);
+        return mutate_begin(std::move(ids), cl, tr_state, timeout_opt, tslot);
     }).then_wrapped([this, p = shared_from_this(), lc, tr_state] (future<> f) mutable {
         return p->mutate_end(std::move(f), lc, get_stats(), std::move(tr_state));
     });
@@ -2681,6 +2810,26 @@ future<> storage_proxy::send_hint_to_endpoint(frozen_mutation_and_schema fm_a_s,
             allow_hints::no);
 }
 
+future<> storage_proxy::send_hint_to_endpoint(std::vector<frozen_mutation_and_schema> ms, gms::inet_address target) {
+    if (ms.size() == 1) {
+        return send_hint_to_endpoint(std::move(ms.front()), std::move(target));
+    }
+    if (!_features.cluster_supports_hinted_handoff_batched_mutations()) {
+        return do_with(std::move(ms), [this, target] (std::vector<frozen_mutation_and_schema>& ms) {
+            return do_for_each(ms, [this, target] (frozen_mutation_and_schema& fm_a_s) {
+                return send_hint_to_endpoint(std::move(fm_a_s), target);
+            });
+        });
+    }
+    std::vector<frozen_mutation> fms;
+    fms.reserve(ms.size());
+    for (auto& fm_a_s : ms) {
+        fms.emplace_back(std::move(fm_a_s.fm));
+    }
+    auto timeout = clock_type::now() + std::chrono::milliseconds(_db.local().get_config().write_request_timeout_in_ms());
+    return _messaging.send_hint_mutation_batch(netw::messaging_service::msg_addr{target, 0}, timeout, std::move(fms));
+}
+
 future<> storage_proxy::send_hint_to_all_replicas(frozen_mutation_and_schema fm_a_s) {
     if (!_features.cluster_supports_hinted_handoff_separate_connection()) {
         std::array<mutation, 1> ms{fm_a_s.fm.unfreeze(fm_a_s.s)};
@@ -3537,6 +3686,7 @@ public:
 protected:
     future<rpc::tuple<foreign_ptr<lw_shared_ptr<reconcilable_result>>, cache_temperature>> make_mutation_data_request(lw_shared_ptr<query::read_command> cmd, gms::inet_address ep, clock_type::time_point timeout) {
         ++_proxy->get_stats().mutation_data_read_attempts.get_ep_stat(ep);
+        ++_proxy->get_stats().reads_inflight_per_replica[ep];
         if (fbu::is_me(ep)) {
             tracing::trace(_trace_state, "read_mutation_data: querying locally");
             return _proxy->query_mutations_locally(_schema, cmd, _partition_range, timeout, _trace_state);
@@ -3551,6 +3701,7 @@ protected:
     }
     future<rpc::tuple<foreign_ptr<lw_shared_ptr<query::result>>, cache_temperature>> make_data_request(gms::inet_address ep, clock_type::time_point timeout, bool want_digest) {
         ++_proxy->get_stats().data_read_attempts.get_ep_stat(ep);
+        ++_proxy->get_stats().reads_inflight_per_replica[ep];
         auto opts = want_digest
                   ? query::result_options{query::result_request::result_and_digest, digest_algorithm(*_proxy)}
                   : query::result_options{query::result_request::only_result, query::digest_algorithm::none};
@@ -3568,6 +3719,7 @@ protected:
     }
     future<rpc::tuple<query::result_digest, api::timestamp_type, cache_temperature>> make_digest_request(gms::inet_address ep, clock_type::time_point timeout) {
         ++_proxy->get_stats().digest_read_attempts.get_ep_stat(ep);
+        ++_proxy->get_stats().reads_inflight_per_replica[ep];
         if (fbu::is_me(ep)) {
             tracing::trace(_trace_state, "read_digest: querying locally");
             return _proxy->query_result_local_digest(_schema, _cmd, _partition_range, _trace_state,
@@ -3588,6 +3740,7 @@ protected:
         for (const gms::inet_address& ep : boost::make_iterator_range(begin, end)) {
             // Waited on indirectly, shared_from_this keeps `this` alive
             (void)make_mutation_data_request(cmd, ep, timeout).then_wrapped([this, resolver, ep, start, exec = shared_from_this()] (future<rpc::tuple<foreign_ptr<lw_shared_ptr<reconcilable_result>>, cache_temperature>> f) {
+                --_proxy->get_stats().reads_inflight_per_replica[ep];
                 try {
                     auto v = f.get0();
                     _cf->set_hit_rate(ep, std::get<1>(v));
@@ -3606,6 +3759,7 @@ protected:
         for (const gms::inet_address& ep : boost::make_iterator_range(begin, end)) {
             // Waited on indirectly, shared_from_this keeps `this` alive
             (void)make_data_request(ep, timeout, want_digest).then_wrapped([this, resolver, ep, start, exec = shared_from_this()] (future<rpc::tuple<foreign_ptr<lw_shared_ptr<query::result>>, cache_temperature>> f) {
+                --_proxy->get_stats().reads_inflight_per_replica[ep];
                 try {
                     auto v = f.get0();
                     _cf->set_hit_rate(ep, std::get<1>(v));
@@ -3625,6 +3779,7 @@ protected:
         for (const gms::inet_address& ep : boost::make_iterator_range(begin, end)) {
             // Waited on indirectly, shared_from_this keeps `this` alive
             (void)make_digest_request(ep, timeout).then_wrapped([this, resolver, ep, start, exec = shared_from_this()] (future<rpc::tuple<query::result_digest, api::timestamp_type, cache_temperature>> f) {
+                --_proxy->get_stats().reads_inflight_per_replica[ep];
                 try {
                     auto v = f.get0();
                     _cf->set_hit_rate(ep, std::get<2>(v));
@@ -3656,6 +3811,17 @@ protected:
         return _cmd->partition_limit;
     }
     virtual void adjust_targets_for_reconciliation() {}
+    // Re-fetches full mutation data for the whole page from all targets and
+    // merges it. This is wasteful when a single recent row differs in a wide
+    // partition, but we cannot narrow the fetch to the differing sub-range:
+    // the digest covers the serialized page as a whole, and replicas cannot
+    // compute comparable per-sub-range digests without first agreeing on
+    // clustering split points, which would take an extra round trip (the row
+    // sets differ between replicas, so positional bucketing doesn't line up).
+    // Also, two replicas can produce equal digests while disagreeing on
+    // tombstones, so skipping "matching" replicas here would leave such
+    // differences unrepaired. The repair writes themselves are already
+    // minimal - schedule_repair() sends only the per-replica diffs.
     void reconcile(db::consistency_level cl, storage_proxy::clock_type::time_point timeout, lw_shared_ptr<query::read_command> cmd) {
         adjust_targets_for_reconciliation();
         data_resolver_ptr data_resolver = ::make_shared<data_read_resolver>(_schema, cl, _targets.size(), timeout);
@@ -3677,8 +3843,12 @@ protected:
                 if (rr_opt && (can_send_short_read || data_resolver->all_reached_end() || rr_opt->row_count() >= original_row_limit()
                                || data_resolver->live_partition_count() >= original_partition_limit())
                         && !data_resolver->any_partition_short_read()) {
+                    auto rr = ::make_lw_shared<reconcilable_result>(std::move(*rr_opt));
                     auto result = ::make_foreign(::make_lw_shared<query::result>(
-                            to_data_query_result(std::move(*rr_opt), _schema, _cmd->slice, _cmd->get_row_limit(), cmd->partition_limit)));
+                            to_data_query_result(*rr, _schema, _cmd->slice, _cmd->get_row_limit(), cmd->partition_limit)));
+                    // The reconciled mutations can be large; free them in the
+                    // background, yielding between partitions. Waited on indirectly.
+                    (void)rr->clear_gently().finally([rr] {});
                     // wait for write to complete before returning result to prevent multiple concurrent read requests to
                     // trigger repair multiple times and to prevent quorum read to return an old value, even after a quorum
                     // another read had returned a newer value (but the newer value had not yet been sent to the other replicas)
@@ -3929,6 +4099,31 @@ db::read_repair_decision storage_proxy::new_read_repair_decision(const schema& s
     return db::read_repair_decision::NONE;
 }
 
+// The first target gets the full data request while the rest only compute
+// digests, so which replica ends up first decides whose queue the response
+// bytes wait in. filter_for_query() orders targets by proximity and cache
+// heat but is blind to momentary load, so apply power-of-two-choices on top:
+// compare the preferred target with one other target picked at random and
+// swap them if the contender has fewer reads in flight. Only the order
+// changes - the set of contacted replicas stays exactly as selected, so
+// consistency and cache warm-up traffic are unaffected.
+void storage_proxy::pick_least_loaded_data_replica(inet_address_vector_replica_set& targets) {
+    if (targets.size() < 2) {
+        return;
+    }
+    static thread_local std::default_random_engine re{std::random_device{}()};
+    std::uniform_int_distribution<size_t> dist(1, targets.size() - 1);
+    auto& inflight = get_stats().reads_inflight_per_replica;
+    auto load = [&inflight] (gms::inet_address ep) -> uint64_t {
+        auto it = inflight.find(ep);
+        return it == inflight.end() ? 0 : it->second;
+    };
+    auto contender = dist(re);
+    if (load(targets[contender]) < load(targets[0])) {
+        std::swap(targets[0], targets[contender]);
+    }
+}
+
 ::shared_ptr<abstract_read_executor> storage_proxy::get_read_executor(lw_shared_ptr<query::read_command> cmd,
         schema_ptr schema,
         dht::partition_range pr,
@@ -3971,6 +4166,8 @@ db::read_repair_decision storage_proxy::new_read_repair_decision(const schema& s
         get_stats().read_repair_attempts++;
     }
 
+    pick_least_loaded_data_replica(target_replicas);
+
     size_t block_for = db::block_for(ks, cl);
     auto p = shared_from_this();
     // Speculative retry is disabled *OR* there are simply no extra replicas to speculate.
@@ -4019,6 +4216,9 @@ storage_proxy::query_result_local(schema_ptr s, lw_shared_ptr<query::read_comman
     if (pr.is_singular()) {
         unsigned shard = dht::shard_of(*s, pr.start()->value().token());
         get_stats().replica_cross_shard_ops += shard != this_shard_id();
+        if (shard != this_shard_id() && _db.local().get_config().hot_partition_read_mirroring_threshold()) {
+            return query_result_local_mirrored(shard, std::move(s), std::move(cmd), pr, opts, std::move(trace_state), timeout);
+        }
         return _db.invoke_on(shard, _read_smp_service_group, [gs = global_schema_ptr(s), prv = dht::partition_range_vector({pr}) /* FIXME: pr is copied */, cmd, opts, timeout, gt = tracing::global_trace_state_ptr(std::move(trace_state))] (database& db) mutable {
             auto trace_state = gt.get();
             tracing::trace(trace_state, "Start querying singular range {}", prv.front());
@@ -4040,6 +4240,82 @@ storage_proxy::query_result_local(schema_ptr s, lw_shared_ptr<query::read_comman
     }
 }
 
+future<rpc::tuple<foreign_ptr<lw_shared_ptr<query::result>>, cache_temperature>>
+storage_proxy::query_result_local_mirrored(unsigned shard, schema_ptr s, lw_shared_ptr<query::read_command> cmd, const dht::partition_range& pr,
+                                           query::result_options opts, tracing::trace_state_ptr trace_state, storage_proxy::clock_type::time_point timeout) {
+    using result_tuple = rpc::tuple<foreign_ptr<lw_shared_ptr<query::result>>, cache_temperature>;
+
+    if (!_hot_partition_mirror) {
+        _hot_partition_mirror = std::make_unique<db::hot_partition_mirror>();
+    }
+    auto& mirror = *_hot_partition_mirror;
+    const auto cf_id = s->id();
+    const auto token = pr.start()->value().token().raw();
+    auto key = db::hot_partition_mirror::make_key(*s, *cmd, pr, opts);
+
+    auto query_owning_shard = [this, shard, s = std::move(s), cmd = std::move(cmd), prv = dht::partition_range_vector({pr}), opts, timeout, cf_id, token]
+            (tracing::trace_state_ptr trace_state, db::hot_partition_mirror::key_type key, bool promote) mutable {
+        return _db.invoke_on(shard, _read_smp_service_group, [gs = global_schema_ptr(s), prv = std::move(prv), cmd, opts, timeout, cf_id, token, promote,
+                gt = tracing::global_trace_state_ptr(std::move(trace_state))] (database& db) mutable {
+            auto trace_state = gt.get();
+            tracing::trace(trace_state, "Start querying singular range {}", prv.front());
+            std::optional<uint64_t> version;
+            if (promote) {
+                if (auto* tracker = db.hot_partition_tracker()) {
+                    // Sample the write version before the read starts: a write
+                    // racing with the read invalidates the snapshot even if the
+                    // read happened to observe it.
+                    version = tracker->track(cf_id, token);
+                }
+            }
+            return db.query(gs, *cmd, opts, prv, trace_state, timeout).then([trace_state, version] (std::tuple<lw_shared_ptr<query::result>, cache_temperature>&& f_ht) {
+                auto&& [f, ht] = f_ht;
+                tracing::trace(trace_state, "Querying is done");
+                return make_ready_future<std::tuple<foreign_ptr<lw_shared_ptr<query::result>>, cache_temperature, std::optional<uint64_t>>>(
+                        std::tuple(make_foreign(std::move(f)), ht, version));
+            });
+        }).then([this, key = std::move(key)] (std::tuple<foreign_ptr<lw_shared_ptr<query::result>>, cache_temperature, std::optional<uint64_t>>&& r) mutable {
+            auto&& [result, ht, version] = r;
+            if (version) {
+                // Deep-copy the result into shard-local memory, so serving
+                // mirror hits never touches the owning shard's memory.
+                auto local = make_lw_shared<query::result>(*result);
+                _hot_partition_mirror->insert(std::move(key),
+                        db::hot_partition_mirror::entry{local, ht, *version, lowres_clock::now() + db::hot_partition_mirror::entry_ttl});
+                get_stats().hot_partition_mirror_promotions++;
+                return make_ready_future<result_tuple>(rpc::tuple(make_foreign(std::move(local)), ht));
+            }
+            return make_ready_future<result_tuple>(rpc::tuple(std::move(result), ht));
+        });
+    };
+
+    if (const auto* e = mirror.find(key)) {
+        // We have a snapshot; the owning shard only needs to confirm that the
+        // partition hasn't been written to since it was taken.
+        auto result = e->result;
+        auto hit_rate = e->hit_rate;
+        auto version = e->version;
+        return _db.invoke_on(shard, _read_smp_service_group, [cf_id, token] (database& db) -> std::optional<uint64_t> {
+            auto* tracker = db.hot_partition_tracker();
+            return tracker ? tracker->version_of(cf_id, token) : std::nullopt;
+        }).then([this, &mirror, key = std::move(key), result = std::move(result), hit_rate, version,
+                query_owning_shard = std::move(query_owning_shard), trace_state = std::move(trace_state)] (std::optional<uint64_t> current) mutable {
+            if (current == version) {
+                tracing::trace(trace_state, "Serving singular range from the hot partition mirror");
+                get_stats().hot_partition_mirror_hits++;
+                return make_ready_future<result_tuple>(rpc::tuple(make_foreign(std::move(result)), hit_rate));
+            }
+            mirror.invalidate(key);
+            // The partition is evidently still hot, so refresh the snapshot
+            // along with the read.
+            return query_owning_shard(std::move(trace_state), std::move(key), true);
+        });
+    }
+
+    bool promote = mirror.should_mirror(cf_id, token, _db.local().get_config().hot_partition_read_mirroring_threshold());
+    return query_owning_shard(std::move(trace_state), std::move(key), promote);
+}
+
 void storage_proxy::handle_read_error(std::exception_ptr eptr, bool range) {
     try {
         std::rethrow_exception(eptr);
@@ -4635,6 +4911,17 @@ future<bool> storage_proxy::cas(schema_ptr schema, shared_ptr<cas_request> reque
             }
         });
 
+        // Concurrent CAS requests for the same key on this coordinator queue
+        // here instead of fighting each other's ballots. A queued request
+        // still runs its own prepare/accept/learn round, but usually skips
+        // the read round: the prepare responses carry the most recent commit
+        // (i.e. the predecessor's result), which begin_and_repair_paxos()
+        // hands back as prefetched values. Folding several queued requests
+        // into a single round would require evaluating each condition against
+        // the not-yet-committed state produced by the requests ahead of it,
+        // which cas_request::apply() - taking a replica-produced
+        // query::result - cannot do, and would also collapse the per-request
+        // applied/not-applied replies into one.
         paxos::paxos_state::guard l = co_await paxos::paxos_state::get_cas_lock(token, write_timeout);
 
         while (true) {
@@ -5059,6 +5346,41 @@ void storage_proxy::init_messaging_service(shared_ptr<migration_manager> mm) {
     ms.register_mutation(std::bind_front<>(receive_mutation_handler, mm, _write_smp_service_group));
     ms.register_hint_mutation(std::bind_front<>(receive_mutation_handler, mm, _hints_write_smp_service_group));
 
+    ms.register_hint_mutation_batch([&ms, mm] (const rpc::client_info& cinfo, rpc::opt_time_point t, std::vector<frozen_mutation> fms) {
+        auto src_addr = netw::messaging_service::get_source(cinfo);
+
+        storage_proxy::clock_type::time_point timeout;
+        if (!t) {
+            auto timeout_in_ms = get_local_shared_storage_proxy()->_db.local().get_config().write_request_timeout_in_ms();
+            timeout = clock_type::now() + std::chrono::milliseconds(timeout_in_ms);
+        } else {
+            timeout = *t;
+        }
+
+        return do_with(std::move(fms), get_local_shared_storage_proxy(), [src_addr, timeout, &ms, mm] (std::vector<frozen_mutation>& fms, shared_ptr<storage_proxy>& p) {
+            p->get_stats().received_mutations += fms.size();
+            return parallel_for_each(fms, [src_addr, timeout, &ms, mm, &p] (const frozen_mutation& fm) {
+                return mm->get_schema_for_write(fm.schema_version(), src_addr, ms).then([timeout, &fm, &p] (schema_ptr s) {
+                    return p->mutate_locally(std::move(s), fm, tracing::trace_state_ptr(), db::commitlog::force_sync::no, timeout, p->_hints_write_smp_service_group);
+                });
+            });
+        });
+    });
+
+    ms.register_mutation_batch([receive_mutation_handler, mm, wsg = _write_smp_service_group] (const rpc::client_info& cinfo, rpc::opt_time_point t,
+            std::vector<frozen_mutation> fms, gms::inet_address reply_to, unsigned shard, std::vector<storage_proxy::response_id_type> response_ids) {
+        // Each batched mutation is handled exactly like an individual MUTATION
+        // with an empty forward list, so the coordinator gets a separate
+        // MUTATION_DONE/MUTATION_FAILED for every response id.
+        return do_with(std::move(fms), std::move(response_ids), [&cinfo, t, reply_to, shard, receive_mutation_handler, mm, wsg]
+                (std::vector<frozen_mutation>& fms, std::vector<storage_proxy::response_id_type>& response_ids) {
+            return parallel_for_each(boost::irange<size_t>(0, fms.size()), [&, t, reply_to, shard, mm, wsg] (size_t i) {
+                return receive_mutation_handler(mm, wsg, cinfo, t, std::move(fms[i]), {}, reply_to, shard, response_ids[i],
+                        rpc::optional<std::optional<tracing::trace_info>>()).discard_result();
+            });
+        }).then([] { return netw::messaging_service::no_wait(); });
+    });
+
     ms.register_paxos_learn([mm] (const rpc::client_info& cinfo, rpc::opt_time_point t, paxos::proposal decision,
             std::vector<gms::inet_address> forward, gms::inet_address reply_to, unsigned shard,
             storage_proxy::response_id_type response_id, std::optional<tracing::trace_info> trace_info) {
@@ -5304,6 +5626,8 @@ future<> storage_proxy::uninit_messaging_service() {
         ms.unregister_counter_mutation(),
         ms.unregister_mutation(),
         ms.unregister_hint_mutation(),
+        ms.unregister_hint_mutation_batch(),
+        ms.unregister_mutation_batch(),
         ms.unregister_mutation_done(),
         ms.unregister_mutation_failed(),
         ms.unregister_read_data(),
@@ -5371,8 +5695,12 @@ storage_proxy::query_nonsingular_data_locally(schema_ptr s, lw_shared_ptr<query:
         ret = co_await query_data_on_all_shards(_db, std::move(s), *local_cmd, ranges, opts, std::move(trace_state), timeout);
     } else {
         auto res = co_await query_mutations_on_all_shards(_db, s, *local_cmd, ranges, std::move(trace_state), timeout);
-        ret = rpc::tuple(make_foreign(make_lw_shared<query::result>(to_data_query_result(std::move(*std::get<0>(res)), std::move(s), local_cmd->slice,
+        auto mutation_result = std::move(std::get<0>(res));
+        ret = rpc::tuple(make_foreign(make_lw_shared<query::result>(to_data_query_result(*mutation_result, std::move(s), local_cmd->slice,
                 local_cmd->get_row_limit(), local_cmd->partition_limit, opts))), std::get<1>(res));
+        // The reconciled result can be large; tear it down gently on its home
+        // shard instead of letting the foreign_ptr destroy it in one go.
+        co_await utils::clear_gently(mutation_result);
     }
     co_return ret;
 }
@@ -68,6 +68,7 @@
 #include "locator/abstract_replication_strategy.hh"
 #include "db/hints/host_filter.hh"
 #include "utils/small_vector.hh"
+#include "utils/write_path_trace.hh"
 #include "service/endpoint_lifecycle_subscriber.hh"
 
 class reconcilable_result;
@@ -88,7 +89,11 @@ class one_or_two_partition_ranges;
 }
 
 namespace cdc {
-    class cdc_service;    
+    class cdc_service;
+}
+
+namespace db {
+class hot_partition_mirror;
 }
 
 namespace gms {
@@ -314,6 +319,14 @@ private:
     class view_update_handlers_list;
     std::unique_ptr<view_update_handlers_list> _view_update_handlers_list;
 
+    // Writes held back for up to write_coalescing_window_in_us so that several
+    // small mutations bound for the same replica leave as a single
+    // MUTATION_BATCH message. Only populated when write coalescing is enabled
+    // (see should_coalesce_writes()). Defined in the .cc, like the write
+    // handler classes above.
+    class pending_mutation_batch;
+    std::unordered_map<gms::inet_address, std::unique_ptr<pending_mutation_batch>> _pending_mutation_batches;
+
     /* This is a pointer to the shard-local part of the sharded cdc_service:
      * storage_proxy needs access to cdc_service to augument mutations.
      *
@@ -330,6 +343,10 @@ private:
      */
     cdc::cdc_service* _cdc = nullptr;
 
+    // Lazily created on the first cross-shard singular read when hot
+    // partition read mirroring is enabled. Defined in db/hot_partition_mirror.hh.
+    std::unique_ptr<db::hot_partition_mirror> _hot_partition_mirror;
+
     cdc_stats _cdc_stats;
 private:
     future<coordinator_query_result> query_singular(lw_shared_ptr<query::read_command> cmd,
@@ -357,6 +374,10 @@ private:
             db::consistency_level cl, db::write_type type, tracing::trace_state_ptr tr_state, service_permit permit);
     void register_cdc_operation_result_tracker(const storage_proxy::unique_response_handler_vector& ids, lw_shared_ptr<cdc::operation_result_tracker> tracker);
     void send_to_live_endpoints(response_id_type response_id, clock_type::time_point timeout);
+    bool should_coalesce_writes() const;
+    future<> send_mutation_coalesced(gms::inet_address ep, const frozen_mutation& fm, response_id_type response_id,
+            clock_type::time_point timeout);
+    void flush_mutation_batch(gms::inet_address ep);
     template<typename Range>
     size_t hint_to_dead_endpoints(std::unique_ptr<mutation_holder>& mh, const Range& targets, db::write_type type, tracing::trace_state_ptr tr_state) noexcept;
     void hint_to_dead_endpoints(response_id_type, db::consistency_level);
@@ -367,6 +388,7 @@ private:
     inet_address_vector_replica_set get_live_endpoints(keyspace& ks, const dht::token& token) const;
     static void sort_endpoints_by_proximity(inet_address_vector_replica_set& eps);
     inet_address_vector_replica_set get_live_sorted_endpoints(keyspace& ks, const dht::token& token) const;
+    void pick_least_loaded_data_replica(inet_address_vector_replica_set& targets);
     db::read_repair_decision new_read_repair_decision(const schema& s);
     ::shared_ptr<abstract_read_executor> get_read_executor(lw_shared_ptr<query::read_command> cmd,
             schema_ptr schema,
@@ -381,6 +403,13 @@ private:
                                                                            query::result_options opts,
                                                                            tracing::trace_state_ptr trace_state,
                                                                            clock_type::time_point timeout);
+    // Like query_result_local() for a singular range owned by another local
+    // shard, but with hot partition read mirroring (db/hot_partition_mirror.hh).
+    future<rpc::tuple<foreign_ptr<lw_shared_ptr<query::result>>, cache_temperature>> query_result_local_mirrored(unsigned shard, schema_ptr, lw_shared_ptr<query::read_command> cmd,
+                                                                           const dht::partition_range& pr,
+                                                                           query::result_options opts,
+                                                                           tracing::trace_state_ptr trace_state,
+                                                                           clock_type::time_point timeout);
     future<rpc::tuple<query::result_digest, api::timestamp_type, cache_temperature>> query_result_local_digest(schema_ptr, lw_shared_ptr<query::read_command> cmd, const dht::partition_range& pr,
                                                                                                    tracing::trace_state_ptr trace_state,
                                                                                                    clock_type::time_point timeout,
@@ -416,7 +445,8 @@ private:
     future<unique_response_handler_vector> mutate_prepare(Range&& mutations, db::consistency_level cl, db::write_type type, service_permit permit, CreateWriteHandler handler);
     template<typename Range>
     future<unique_response_handler_vector> mutate_prepare(Range&& mutations, db::consistency_level cl, db::write_type type, tracing::trace_state_ptr tr_state, service_permit permit);
-    future<> mutate_begin(unique_response_handler_vector ids, db::consistency_level cl, tracing::trace_state_ptr trace_state, std::optional<clock_type::time_point> timeout_opt = { });
+    future<> mutate_begin(unique_response_handler_vector ids, db::consistency_level cl, tracing::trace_state_ptr trace_state, std::optional<clock_type::time_point> timeout_opt = { },
+            utils::write_path_tracer::slot tslot = { });
     future<> mutate_end(future<> mutate_result, utils::latency_counter, write_stats& stats, tracing::trace_state_ptr trace_state);
     future<> schedule_repair(std::unordered_map<dht::token, std::unordered_map<gms::inet_address, std::optional<mutation>>> diffs, db::consistency_level cl, tracing::trace_state_ptr trace_state, service_permit permit);
     bool need_throttle_writes() const;
@@ -580,6 +610,11 @@ public:
     // and use different RPC verb.
     future<> send_hint_to_endpoint(frozen_mutation_and_schema fm_a_s, gms::inet_address target);
 
+    // Send a group of hints to a specific remote target in a single RPC. The stored frozen
+    // mutations are forwarded as-is. Falls back to one verb per mutation when the cluster
+    // does not support batched hints yet.
+    future<> send_hint_to_endpoint(std::vector<frozen_mutation_and_schema> ms, gms::inet_address target);
+
     /**
      * Performs the truncate operatoin, which effectively deletes all data from
      * the column family cfname
@@ -667,6 +702,9 @@ public:
 
     static unsigned cas_shard(const schema& s, dht::token token);
 
+    /// Whether this node is a replica for the given token.
+    bool is_local_replica(const schema& s, dht::token token);
+
     virtual void on_join_cluster(const gms::inet_address& endpoint) override;
     virtual void on_leave_cluster(const gms::inet_address& endpoint) override;
     virtual void on_up(const gms::inet_address& endpoint) override;
@@ -86,6 +86,12 @@ struct write_stats {
     // write attempts due to Read Repair logic
     split_stats read_repair_write_attempts;
 
+    // acknowledgements that arrived only after the consistency level had
+    // already been reached, i.e. from replicas lagging behind the ones that
+    // formed the quorum. A persistently high rate for one endpoint points at
+    // a degraded replica dragging background writes (and hints) behind it.
+    split_stats writes_late_acks;
+
     utils::timed_rate_moving_average write_unavailables;
     utils::timed_rate_moving_average write_timeouts;
 
@@ -98,7 +104,7 @@ struct write_stats {
     utils::timed_rate_moving_average_and_histogram cas_write;
     utils::time_estimated_histogram estimated_cas_write;
 
-    utils::estimated_histogram cas_write_contention;
+    utils::count_estimated_histogram cas_write_contention;
 
     uint64_t writes = 0;
     // A CQL write query arrived to a non-replica node and was
@@ -144,7 +150,7 @@ struct stats : public write_stats {
     utils::timed_rate_moving_average cas_read_timeouts;
     utils::timed_rate_moving_average cas_read_unavailables;
 
-    utils::estimated_histogram cas_read_contention;
+    utils::count_estimated_histogram cas_read_contention;
 
     uint64_t read_repair_attempts = 0;
     uint64_t read_repair_repaired_blocking = 0;
@@ -168,6 +174,10 @@ struct stats : public write_stats {
 
     uint64_t replica_cross_shard_ops = 0;
 
+    // Hot partition read mirroring (db/hot_partition_mirror.hh).
+    uint64_t hot_partition_mirror_hits = 0;
+    uint64_t hot_partition_mirror_promotions = 0;
+
     utils::timed_rate_moving_average_and_histogram read;
     utils::timed_rate_moving_average_and_histogram range;
     utils::time_estimated_histogram estimated_read;
@@ -202,6 +212,12 @@ struct stats : public write_stats {
     split_stats mutation_data_read_completed;
     split_stats mutation_data_read_errors;
 
+    // Outstanding read requests (data/digest/mutation data) per replica.
+    // Unlike the split_stats above, which aggregate remote endpoints by DC,
+    // this is kept per endpoint: it feeds the power-of-two-choices selection
+    // of the replica that serves the full data request.
+    std::unordered_map<gms::inet_address, uint64_t> reads_inflight_per_replica;
+
 public:
     stats();
     void register_stats();
@@ -2602,14 +2602,17 @@ future<> storage_service::do_drain() {
     return seastar::async([this] {
         stop_transport().get();
 
-        tracing::tracing::tracing_instance().invoke_on_all(&tracing::tracing::shutdown).get();
-
-        get_batchlog_manager().invoke_on_all([] (auto& bm) {
-            return bm.drain();
-        }).get();
-
-        set_mode(mode::DRAINING, "shutting down migration manager", false);
-        _migration_manager.invoke_on_all(&service::migration_manager::drain).get();
+        set_mode(mode::DRAINING, "shutting down tracing, batchlog and migration manager", false);
+        // These writers are independent of each other; quiesce them in one
+        // wave instead of in sequence. All of them must be done before the
+        // flushes below, so that what they write makes it to sstables.
+        when_all_succeed(
+            tracing::tracing::tracing_instance().invoke_on_all(&tracing::tracing::shutdown),
+            get_batchlog_manager().invoke_on_all([] (auto& bm) {
+                return bm.drain();
+            }),
+            _migration_manager.invoke_on_all(&service::migration_manager::drain)
+        ).get();
 
         set_mode(mode::DRAINING, "flushing column families", false);
         _db.invoke_on_all(&database::drain).get();
@@ -3506,6 +3509,10 @@ void storage_service::notify_up(inet_address endpoint)
         return;
     }
     container().invoke_on_all([endpoint] (auto&& ss) {
+        // Re-establish the messaging connections to the node in the
+        // background, so the first foreground requests after a bounce do
+        // not pay connection setup and negotiation.
+        ss._messaging.local().warm_up_connections(netw::msg_addr(endpoint));
         return ss._lifecycle_notifier.notify_up(endpoint);
     }).get();
     slogger.debug("Notify node {} has been up", endpoint);
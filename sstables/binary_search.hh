@@ -22,6 +22,9 @@
 
 #pragma once
 
+#include <algorithm>
+#include <utility>
+
 #include "sstables/key.hh"
 #include "dht/i_partitioner.hh"
 
@@ -85,4 +88,56 @@ int binary_search(const dht::i_partitioner& partitioner, const T& entries, const
     return binary_search(partitioner, entries, sk, partitioner.get_token(key_view(sk)));
 }
 
+/**
+ * Narrows [low, entries.size()) to a subrange which still contains the lower
+ * bound for a position with the given token, by interpolating over the
+ * entries' precomputed tokens.
+ *
+ * Murmur3 tokens are uniformly distributed over the ring, so each probe cuts
+ * the range down to the interpolation error and the search converges in
+ * O(log log n) probes on average, compared with log2(n) ~ 16 probes of a
+ * plain binary search over our large summaries. The caller is expected to
+ * finish with a binary search over the returned subrange, which also makes
+ * skewed token distributions a performance problem only: the probe budget
+ * below bounds the number of wasted probes, never correctness.
+ *
+ * Narrowing decisions use strict token inequalities exclusively, so they hold
+ * for any ring position with this token regardless of key or weight; entries
+ * with equal tokens are left for the caller's comparator to resolve.
+ */
+template <typename T>
+std::pair<size_t, size_t> interpolate_summary_range(const T& entries, size_t low, const dht::token& token) {
+    size_t high = entries.size();
+    // Interpolation needs a concrete token value and a range worth cutting.
+    if (high - low < 16 || token.is_minimum() || token.is_maximum()) {
+        return {low, high};
+    }
+    // Shifts the int64 token value to unsigned, preserving order, so that
+    // distances below don't overflow.
+    auto to_unsigned = [] (const dht::token& t) {
+        return uint64_t(dht::token::to_int64(t)) + (uint64_t(1) << 63);
+    };
+    const auto target = to_unsigned(token);
+    int budget = 8;
+    while (high - low >= 16 && budget-- > 0) {
+        auto low_token = to_unsigned(entries[low].token);
+        auto high_token = to_unsigned(entries[high - 1].token);
+        if (target <= low_token || target >= high_token) {
+            break;
+        }
+        auto mid = low + size_t((unsigned __int128)(target - low_token) * (high - 1 - low) / (high_token - low_token));
+        // Keep the probe strictly inside (low, high - 1) so the range always shrinks.
+        mid = std::clamp(mid, low + 1, high - 2);
+        auto mid_token = to_unsigned(entries[mid].token);
+        if (mid_token < target) {
+            low = mid + 1;
+        } else if (mid_token > target) {
+            high = mid;
+        } else {
+            break;
+        }
+    }
+    return {low, high};
+}
+
 }
@@ -54,7 +54,10 @@ inline column_values_fixed_lengths get_clustering_values_fixed_lengths(const ser
 class column_translation {
 public:
     struct column_info {
-        const bytes* name = nullptr;
+        // Owned copy of the column name from the serialization header, so
+        // that the translation can be shared between sstables and outlive
+        // the header it was built from.
+        bytes name;
         data_type type;
         // Disengaged 'id' means the column is missing from the current schema
         std::optional<column_id> id;
@@ -74,6 +77,14 @@ private:
                 const sstable_enabled_features& features,
                 bool is_static);
 
+        // Returns the translation for the given (schema, header) pair from a
+        // per-shard cache, building it on a miss. After an ALTER every
+        // sstable sees a schema version mismatch at once; sstables with
+        // identical serialization headers (the common case) share a single
+        // rebuild instead of each computing its own.
+        static lw_shared_ptr<const state> get_or_create(
+                const schema& s, const serialization_header& header, const sstable_enabled_features& features);
+
         utils::UUID schema_uuid;
         std::vector<column_info> regular_schema_columns_from_sstable;
         std::vector<column_info> static_schema_columns_from_sstable;
@@ -99,7 +110,7 @@ public:
     column_translation get_for_schema(
             const schema& s, const serialization_header& header, const sstable_enabled_features& features) {
         if (s.version() != _state->schema_uuid) {
-            _state = make_lw_shared<const state>(s, header, features);
+            _state = state::get_or_create(s, header, features);
         }
         return *this;
     }
@@ -0,0 +1,162 @@
+/*
+ * Copyright (C) 2021-present ScyllaDB
+ */
+
+/*
+ * This file is part of Scylla.
+ *
+ * Scylla is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Scylla is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Scylla.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <chrono>
+
+#include <seastar/core/metrics.hh>
+
+#include "sstables/component_io_stats.hh"
+
+namespace sstables {
+
+namespace sm = seastar::metrics;
+
+namespace {
+
+class component_io_counting_file_impl : public file_impl {
+    file _file;
+    component_io_stats& _stats;
+
+private:
+    using clock = std::chrono::steady_clock;
+
+    void account(clock::time_point start, size_t bytes) {
+        ++_stats.reads;
+        _stats.bytes += bytes;
+        _stats.read_latency.add(std::chrono::duration_cast<std::chrono::microseconds>(clock::now() - start).count());
+    }
+
+public:
+    component_io_counting_file_impl(file f, component_io_stats& stats)
+        : file_impl(*get_file_impl(f)), _file(std::move(f)), _stats(stats) {
+    }
+
+    virtual future<size_t> write_dma(uint64_t pos, const void* buffer, size_t len, const io_priority_class& pc) override {
+        return get_file_impl(_file)->write_dma(pos, buffer, len, pc);
+    }
+
+    virtual future<size_t> write_dma(uint64_t pos, std::vector<iovec> iov, const io_priority_class& pc) override {
+        return get_file_impl(_file)->write_dma(pos, std::move(iov), pc);
+    }
+
+    virtual future<size_t> read_dma(uint64_t pos, void* buffer, size_t len, const io_priority_class& pc) override {
+        return get_file_impl(_file)->read_dma(pos, buffer, len, pc).then([this, start = clock::now()] (size_t size) {
+            account(start, size);
+            return size;
+        });
+    }
+
+    virtual future<size_t> read_dma(uint64_t pos, std::vector<iovec> iov, const io_priority_class& pc) override {
+        return get_file_impl(_file)->read_dma(pos, std::move(iov), pc).then([this, start = clock::now()] (size_t size) {
+            account(start, size);
+            return size;
+        });
+    }
+
+    virtual future<temporary_buffer<uint8_t>> dma_read_bulk(uint64_t offset, size_t range_size, const io_priority_class& pc) override {
+        return get_file_impl(_file)->dma_read_bulk(offset, range_size, pc).then([this, start = clock::now()] (temporary_buffer<uint8_t> buf) {
+            account(start, buf.size());
+            return buf;
+        });
+    }
+
+    virtual future<> flush(void) override {
+        return get_file_impl(_file)->flush();
+    }
+
+    virtual future<struct stat> stat(void) override {
+        return get_file_impl(_file)->stat();
+    }
+
+    virtual future<> truncate(uint64_t length) override {
+        return get_file_impl(_file)->truncate(length);
+    }
+
+    virtual future<> discard(uint64_t offset, uint64_t length) override {
+        return get_file_impl(_file)->discard(offset, length);
+    }
+
+    virtual future<> allocate(uint64_t position, uint64_t length) override {
+        return get_file_impl(_file)->allocate(position, length);
+    }
+
+    virtual future<uint64_t> size(void) override {
+        return get_file_impl(_file)->size();
+    }
+
+    virtual future<> close() override {
+        return get_file_impl(_file)->close();
+    }
+
+    // returns a handle for the plain file, the wrap has to be re-applied on
+    // the file returned by the handle.
+    virtual std::unique_ptr<seastar::file_handle_impl> dup() override {
+        return get_file_impl(_file)->dup();
+    }
+
+    virtual subscription<directory_entry> list_directory(std::function<future<> (directory_entry de)> next) override {
+        return get_file_impl(_file)->list_directory(std::move(next));
+    }
+};
+
+// The component types worth a metric series each. Reads of the remaining
+// types are one-off, at load time, and are not exported.
+constexpr std::pair<component_type, const char*> exported_components[] = {
+    {component_type::Index, "index"},
+    {component_type::CompressionInfo, "compression_info"},
+    {component_type::Data, "data"},
+    {component_type::Summary, "summary"},
+    {component_type::Filter, "filter"},
+    {component_type::Statistics, "statistics"},
+};
+
+} // anonymous namespace
+
+component_io_stats_registry::component_io_stats_registry() {
+    auto component_label = sm::label("component");
+
+    std::vector<sm::metric_definition> defs;
+    for (const auto& [type, name] : exported_components) {
+        auto& stats = get(type);
+        defs.emplace_back(sm::make_counter("component_reads", stats.reads,
+                sm::description("Number of read I/O operations issued against sstable components, per component type."),
+                {component_label(name)}));
+        defs.emplace_back(sm::make_counter("component_read_bytes", stats.bytes,
+                sm::description("Number of bytes read from sstable components, per component type."),
+                {component_label(name)}));
+        defs.emplace_back(sm::make_histogram("component_read_latency",
+                sm::description("Latency histogram (in microseconds) of read I/O operations issued against sstable components, per component type."),
+                {component_label(name)},
+                [&stats] { return stats.read_latency.get_histogram(16, 20); }));
+    }
+    _metrics.add_group("sstables", std::move(defs));
+}
+
+component_io_stats_registry& get_local_component_io_stats_registry() {
+    static thread_local component_io_stats_registry registry;
+    return registry;
+}
+
+file make_component_io_counting_file(component_type type, file f) {
+    return file(::make_shared<component_io_counting_file_impl>(std::move(f), get_local_component_io_stats_registry().get(type)));
+}
+
+} // namespace sstables
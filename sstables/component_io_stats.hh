@@ -0,0 +1,63 @@
+/*
+ * Copyright (C) 2021-present ScyllaDB
+ */
+
+/*
+ * This file is part of Scylla.
+ *
+ * Scylla is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Scylla is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Scylla.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <array>
+#include <seastar/core/file.hh>
+#include <seastar/core/metrics_registration.hh>
+
+#include "seastarx.hh"
+#include "sstables/component_type.hh"
+#include "utils/estimated_histogram.hh"
+
+namespace sstables {
+
+// Read I/O statistics of a single sstable component type, accumulated across
+// all sstables on this shard.
+struct component_io_stats {
+    uint64_t reads = 0;
+    uint64_t bytes = 0;
+    utils::estimated_histogram read_latency{128}; // microseconds
+};
+
+// Per-shard breakdown of sstable read I/O by component type (Data, Index,
+// Filter, Summary, ...). Exposed as metrics in the "sstables" group, with a
+// "component" label, so that the fraction of disk reads going to each
+// component can be observed directly.
+class component_io_stats_registry {
+    std::array<component_io_stats, size_t(component_type::Unknown) + 1> _stats;
+    seastar::metrics::metric_groups _metrics;
+public:
+    component_io_stats_registry();
+
+    component_io_stats& get(component_type type) {
+        return _stats[size_t(type)];
+    }
+};
+
+component_io_stats_registry& get_local_component_io_stats_registry();
+
+// Wraps \c f so that all reads issued through it are counted into this
+// shard's statistics for \c type. Writes pass through uncounted.
+file make_component_io_counting_file(component_type type, file f);
+
+} // namespace sstables
@@ -26,6 +26,7 @@
 #include <seastar/core/align.hh>
 #include <seastar/core/bitops.hh>
 #include <seastar/core/byteorder.hh>
+#include <seastar/core/coroutine.hh>
 #include <seastar/core/fstream.hh>
 
 #include "../compress.hh"
@@ -388,42 +389,76 @@ public:
         _underlying_pos = start.chunk_start;
         _pos = _beg_pos;
     }
+    // Upper bound on the uncompressed bytes get() produces per call. With our
+    // small chunk sizes a sequential read would otherwise pay a continuation
+    // per chunk and interleave checksumming, decompression and parsing chunk
+    // by chunk; batching the chunks already buffered by read-ahead lets each
+    // stage run as one streaming pass instead.
+    static constexpr size_t batch_uncompressed_size = 128 * 1024;
+
     virtual future<temporary_buffer<char>> get() override {
         if (_pos >= _end_pos) {
             return make_ready_future<temporary_buffer<char>>();
         }
         auto addr = _compression_metadata->locate(_pos, _offsets);
-        // Uncompress the next chunk. We need to skip part of the first
+        // Uncompress the next chunk(s). We need to skip part of the first
         // chunk, but then continue to read from beginning of chunks.
         if (_pos != _beg_pos && addr.offset != 0) {
             throw std::runtime_error("compressed reader out of sync");
         }
-        return _input_stream->read_exactly(addr.chunk_len).
-            then([this, addr](temporary_buffer<char> buf) {
-                // The last 4 bytes of the chunk are the adler32/crc32 checksum
-                // of the rest of the (compressed) chunk.
-                auto compressed_len = addr.chunk_len - 4;
+        const uint64_t chunk_size = _compression_metadata->uncompressed_chunk_length();
+        // Chunks are contiguous in the compressed file, so a batch of them
+        // can be read in one go and processed in two tight loops below.
+        std::vector<uint64_t> chunk_lens;
+        chunk_lens.push_back(addr.chunk_len);
+        uint64_t compressed_len = addr.chunk_len;
+        if (addr.offset == 0 && chunk_size <= batch_uncompressed_size) {
+            auto max_chunks = std::min<uint64_t>(
+                (_end_pos - _pos + chunk_size - 1) / chunk_size,
+                batch_uncompressed_size / chunk_size);
+            while (chunk_lens.size() < max_chunks) {
+                auto next = _compression_metadata->locate(_pos + chunk_lens.size() * chunk_size, _offsets);
+                chunk_lens.push_back(next.chunk_len);
+                compressed_len += next.chunk_len;
+            }
+        }
+        return _input_stream->read_exactly(compressed_len).
+            then([this, addr, chunk_size, chunk_lens = std::move(chunk_lens)](temporary_buffer<char> buf) {
+                // Stage 1: one streaming checksum pass over the whole batch.
+                // The last 4 bytes of each chunk are the adler32/crc32
+                // checksum of the rest of the (compressed) chunk.
                 // FIXME: Do not always calculate checksum - Cassandra has a
                 // probability (defaulting to 1.0, but still...)
-                auto expected_checksum = read_be<uint32_t>(buf.get() + compressed_len);
-                auto actual_checksum = ChecksumType::checksum(buf.get(), compressed_len);
-                if (expected_checksum != actual_checksum) {
-                    throw sstables::malformed_sstable_exception(format("compressed chunk of size {} at file offset {} failed checksum, expected={}, actual={}", addr.chunk_len, _underlying_pos, expected_checksum, actual_checksum));
+                auto src = buf.get();
+                auto underlying = _underlying_pos;
+                for (auto chunk_len : chunk_lens) {
+                    auto compressed_len = chunk_len - 4;
+                    auto expected_checksum = read_be<uint32_t>(src + compressed_len);
+                    auto actual_checksum = ChecksumType::checksum(src, compressed_len);
+                    if (expected_checksum != actual_checksum) {
+                        throw sstables::malformed_sstable_exception(format("compressed chunk of size {} at file offset {} failed checksum, expected={}, actual={}", chunk_len, underlying, expected_checksum, actual_checksum));
+                    }
+                    src += chunk_len;
+                    underlying += chunk_len;
                 }
 
-                // We know that the uncompressed data will take exactly
-                // chunk_length bytes (or less, if reading the last chunk).
-                temporary_buffer<char> out(
-                        _compression_metadata->uncompressed_chunk_length());
-                // The compressed data is the whole chunk, minus the last 4
-                // bytes (which contain the checksum verified above).
-
-                auto len = _compression.uncompress(buf.get(), compressed_len, out.get_write(), out.size());
+                // Stage 2: decompression of the batch. We know that the
+                // uncompressed data of every chunk takes exactly chunk_size
+                // bytes (or less, for the last chunk of the file).
+                temporary_buffer<char> out(chunk_lens.size() * chunk_size);
+                size_t out_size = 0;
+                src = buf.get();
+                for (auto chunk_len : chunk_lens) {
+                    // The compressed data is the whole chunk, minus the last
+                    // 4 bytes (which contain the checksum verified above).
+                    out_size += _compression.uncompress(src, chunk_len - 4, out.get_write() + out_size, out.size() - out_size);
+                    src += chunk_len;
+                }
 
-                out.trim(len);
+                out.trim(out_size);
                 out.trim_front(addr.offset);
                 _pos += out.size();
-                _underlying_pos += addr.chunk_len;
+                _underlying_pos += src - buf.get();
 
                 return out;
         });
@@ -481,24 +516,31 @@ enum class compressed_checksum_mode {
     checksum_all,
 };
 
-// compressed_file_data_sink_impl works as a filter for a file output stream,
+// compressed_file_data_sink_impl works as a filter for a file data sink,
 // where the buffer flushed will be compressed and its checksum computed, then
-// the result passed to a regular output stream.
+// the result written to the underlying sink. Compressed chunks are packed
+// into aligned sink-sized buffers, so the compressor's output usually lands
+// straight in the buffer handed to the file (whose bounded write-behind queue
+// overlaps the disk write of one buffer with compression of the next), and
+// the intermediate per-chunk allocation and copy are skipped.
 template <typename ChecksumType, compressed_checksum_mode mode>
 requires ChecksumUtils<ChecksumType>
 class compressed_file_data_sink_impl : public data_sink_impl {
-    output_stream<char> _out;
+    data_sink _out;
     sstables::compression* _compression_metadata;
     sstables::compression::segmented_offsets::writer _offsets;
     sstables::local_compression _compression;
+    temporary_buffer<char> _write_buf;
+    size_t _buf_pos = 0;
     size_t _pos = 0;
     uint32_t _full_checksum;
 public:
-    compressed_file_data_sink_impl(output_stream<char> out, sstables::compression* cm, sstables::local_compression lc)
+    compressed_file_data_sink_impl(data_sink out, sstables::compression* cm, sstables::local_compression lc)
             : _out(std::move(out))
             , _compression_metadata(cm)
             , _offsets(_compression_metadata->offsets.get_writer())
             , _compression(lc)
+            , _write_buf(_out.allocate_buffer(_out.buffer_size()))
             , _full_checksum(ChecksumType::init_checksum())
     {}
 
@@ -506,13 +548,22 @@ public:
     virtual future<> put(temporary_buffer<char> buf) override {
         auto output_len = _compression.compress_max_size(buf.size());
 
-        // account space for checksum that goes after compressed data.
-        temporary_buffer<char> compressed(output_len + 4);
+        // Compress straight into the free space of the aligned write buffer
+        // when the worst-case output (plus the trailing 32-bit checksum)
+        // fits; otherwise compress into a scratch buffer and copy out below.
+        char* dst;
+        temporary_buffer<char> scratch;
+        if (output_len + 4 <= _write_buf.size() - _buf_pos) {
+            dst = _write_buf.get_write() + _buf_pos;
+        } else {
+            scratch = temporary_buffer<char>(output_len + 4);
+            dst = scratch.get_write();
+        }
 
         // compress flushed data.
-        auto len = _compression.compress(buf.get(), buf.size(), compressed.get_write(), output_len);
+        auto len = _compression.compress(buf.get(), buf.size(), dst, output_len);
         if (len > output_len) {
-            return make_exception_future(std::runtime_error("possible overflow during compression"));
+            throw std::runtime_error("possible overflow during compression");
         }
 
         // total length of the uncompressed data.
@@ -524,11 +575,11 @@ public:
         _compression_metadata->set_compressed_file_length(_pos);
 
         // compute 32-bit checksum for compressed data.
-        uint32_t per_chunk_checksum = ChecksumType::checksum(compressed.get(), len);
-        _full_checksum = checksum_combine_or_feed<ChecksumType>(_full_checksum, per_chunk_checksum, compressed.get(), len);
+        uint32_t per_chunk_checksum = ChecksumType::checksum(dst, len);
+        _full_checksum = checksum_combine_or_feed<ChecksumType>(_full_checksum, per_chunk_checksum, dst, len);
 
         // write checksum into buffer after compressed data.
-        write_be<uint32_t>(compressed.get_write() + len, per_chunk_checksum);
+        write_be<uint32_t>(dst + len, per_chunk_checksum);
 
         if constexpr (mode == compressed_checksum_mode::checksum_all) {
             uint32_t be_per_chunk_checksum = cpu_to_be(per_chunk_checksum);
@@ -538,32 +589,58 @@ public:
 
         _compression_metadata->set_full_checksum(_full_checksum);
 
-        compressed.trim(len + 4);
-
-        auto f = _out.write(compressed.get(), compressed.size());
-        return f.then([compressed = std::move(compressed)] {});
+        if (!scratch.size()) {
+            _buf_pos += len + 4;
+            if (_buf_pos == _write_buf.size()) {
+                co_await flush_write_buf();
+            }
+            co_return;
+        }
+        const char* src = scratch.get();
+        size_t left = len + 4;
+        while (left) {
+            auto n = std::min(left, _write_buf.size() - _buf_pos);
+            std::copy_n(src, n, _write_buf.get_write() + _buf_pos);
+            _buf_pos += n;
+            src += n;
+            left -= n;
+            if (_buf_pos == _write_buf.size()) {
+                co_await flush_write_buf();
+            }
+        }
     }
     virtual future<> close() override {
-        return _out.close();
+        if (_buf_pos) {
+            _write_buf.trim(_buf_pos);
+            _buf_pos = 0;
+            co_await _out.put(std::move(_write_buf));
+        }
+        co_await _out.close();
     }
 
     virtual size_t buffer_size() const noexcept override {
         return _compression_metadata->uncompressed_chunk_length();
     }
+private:
+    future<> flush_write_buf() {
+        auto full = std::exchange(_write_buf, _out.allocate_buffer(_out.buffer_size()));
+        _buf_pos = 0;
+        return _out.put(std::move(full));
+    }
 };
 
 template <typename ChecksumType, compressed_checksum_mode mode>
 requires ChecksumUtils<ChecksumType>
 class compressed_file_data_sink : public data_sink {
 public:
-    compressed_file_data_sink(output_stream<char> out, sstables::compression* cm, sstables::local_compression lc)
+    compressed_file_data_sink(data_sink out, sstables::compression* cm, sstables::local_compression lc)
         : data_sink(std::make_unique<compressed_file_data_sink_impl<ChecksumType, mode>>(
                 std::move(out), cm, std::move(lc))) {}
 };
 
 template <typename ChecksumType, compressed_checksum_mode mode>
 requires ChecksumUtils<ChecksumType>
-inline output_stream<char> make_compressed_file_output_stream(output_stream<char> out,
+inline output_stream<char> make_compressed_file_output_stream(data_sink out,
          sstables::compression* cm,
          const compression_parameters& cp) {
     // buffer of output stream is set to chunk length, because flush must
@@ -593,7 +670,7 @@ input_stream<char> sstables::make_compressed_file_m_format_input_stream(file f,
     return make_compressed_file_input_stream<crc32_utils>(std::move(f), cm, offset, len, std::move(options));
 }
 
-output_stream<char> sstables::make_compressed_file_m_format_output_stream(output_stream<char> out,
+output_stream<char> sstables::make_compressed_file_m_format_output_stream(data_sink out,
         sstables::compression* cm,
         const compression_parameters& cp) {
     return make_compressed_file_output_stream<crc32_utils, compressed_checksum_mode::checksum_all>(
@@ -390,7 +390,7 @@ input_stream<char> make_compressed_file_m_format_input_stream(file f,
                 sstables::compression* cm, uint64_t offset, size_t len,
                 class file_input_stream_options options);
 
-output_stream<char> make_compressed_file_m_format_output_stream(output_stream<char> out,
+output_stream<char> make_compressed_file_m_format_output_stream(data_sink out,
                 sstables::compression* cm,
                 const compression_parameters& cp);
 
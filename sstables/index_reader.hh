@@ -23,6 +23,7 @@
 #include "sstables.hh"
 #include "consumer.hh"
 #include "downsampling.hh"
+#include "binary_search.hh"
 #include "sstables/partition_index_cache.hh"
 #include <seastar/util/bool_class.hh>
 #include "utils/buffer_input_stream.hh"
@@ -639,8 +640,12 @@ private:
         }
 
         auto& summary = _sstable->get_summary();
+        // Interpolation over the tokens narrows the range to a handful of
+        // entries, so the full ring-position comparisons below, each a likely
+        // cache miss on a large summary, only run on the leftovers.
+        auto [low, high] = interpolate_summary_range(summary.entries, bound.previous_summary_idx, pos.token());
         bound.previous_summary_idx = std::distance(std::begin(summary.entries),
-            std::lower_bound(summary.entries.begin() + bound.previous_summary_idx, summary.entries.end(), pos, index_comparator(*_sstable->_schema)));
+            std::lower_bound(summary.entries.begin() + low, summary.entries.begin() + high, pos, index_comparator(*_sstable->_schema)));
 
         if (bound.previous_summary_idx == 0) {
             sstlog.trace("index {}: first entry", fmt::ptr(this));
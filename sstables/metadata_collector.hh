@@ -75,7 +75,7 @@ struct column_stats {
     min_max_tracker<int32_t> local_deletion_time_tracker;
     min_max_tracker<int32_t> ttl_tracker;
     /** histogram of tombstone drop time */
-    utils::streaming_histogram tombstone_histogram;
+    utils::streaming_histogram_builder tombstone_histogram;
 
     bool has_legacy_counter_shards;
     bool capped_local_deletion_time = false;
@@ -161,7 +161,7 @@ private:
     min_max_tracker<int32_t> _local_deletion_time_tracker{std::numeric_limits<int32_t>::max(), std::numeric_limits<int32_t>::max()};
     min_max_tracker<int32_t> _ttl_tracker{0, 0};
     double _compression_ratio = NO_COMPRESSION_RATIO;
-    utils::streaming_histogram _estimated_tombstone_drop_time{TOMBSTONE_HISTOGRAM_BIN_SIZE};
+    utils::streaming_histogram_builder _estimated_tombstone_drop_time{TOMBSTONE_HISTOGRAM_BIN_SIZE};
     int _sstable_level = 0;
     std::optional<clustering_key_prefix> _min_clustering_key;
     std::optional<clustering_key_prefix> _max_clustering_key;
@@ -207,7 +207,7 @@ public:
         _estimated_cells_count.add(cells_count);
     }
 
-    void merge_tombstone_histogram(utils::streaming_histogram& histogram) {
+    void merge_tombstone_histogram(utils::streaming_histogram_builder& histogram) {
         _estimated_tombstone_drop_time.merge(histogram);
     }
 
@@ -267,7 +267,7 @@ public:
         m.min_ttl = _ttl_tracker.min();
         m.max_ttl = _ttl_tracker.max();
         m.compression_ratio = _compression_ratio;
-        m.estimated_tombstone_drop_time = std::move(_estimated_tombstone_drop_time);
+        m.estimated_tombstone_drop_time = _estimated_tombstone_drop_time.build();
         m.sstable_level = _sstable_level;
         m.repaired_at = _repaired_at;
         convert(m.min_column_names, _min_clustering_key);
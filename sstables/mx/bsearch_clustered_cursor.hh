@@ -391,8 +391,30 @@ class bsearch_clustered_cursor : public clustered_index_cursor {
     // Points to the upper bound of the cursor.
     std::optional<position_in_partition> _current_pos;
 
+    // Background fetch of the block at _current_idx, started by next_entry()
+    // so that a sequential walk overlaps promoted index I/O with the data
+    // file reads the caller performs between next_entry() calls.
+    // cached_promoted_index methods must not run concurrently, so this is
+    // limited to one block and must be drained before any other operation
+    // on _promoted_index is started.
+    std::optional<future<promoted_index_block*>> _next_block_prefetch;
+
     tracing::trace_state_ptr _trace_state;
 private:
+    // Waits for the pending prefetch (if any), discarding its result.
+    // Errors are dropped too: the demand fetch which follows will retry
+    // and report them.
+    future<> drain_prefetch() {
+        auto f = std::move(*_next_block_prefetch);
+        _next_block_prefetch.reset();
+        return f.then_wrapped([] (future<promoted_index_block*> f) {
+            try {
+                f.get0();
+            } catch (...) {
+            }
+        });
+    }
+
     // Advances the cursor to the nearest block whose start position is > pos.
     //
     // upper_idx should be the index of the block which is known to have start position > pos.
@@ -474,6 +496,10 @@ public:
     { }
 
     future<std::optional<skip_info>> advance_to(position_in_partition_view pos) override {
+        if (_next_block_prefetch) {
+            return drain_prefetch().then([this, pos] { return advance_to(pos); });
+        }
+
         position_in_partition::less_compare less(_s);
 
         sstlog.trace("mc_bsearch_clustered_cursor {}: advance_to({}), _current_pos={}, _current_idx={}, cached={}",
@@ -523,6 +549,9 @@ public:
     }
 
     future<std::optional<offset_in_partition>> probe_upper_bound(position_in_partition_view pos) override {
+        if (_next_block_prefetch) {
+            return drain_prefetch().then([this, pos] { return probe_upper_bound(pos); });
+        }
         return _promoted_index.upper_bound_cache_only(pos, _trace_state);
     }
 
@@ -530,11 +559,23 @@ public:
         if (_current_idx == _blocks_count) {
             return make_ready_future<std::optional<entry_info>>(std::nullopt);
         }
-        return _promoted_index.get_block(_current_idx, _trace_state)
-                .then([this] (promoted_index_block* block) -> std::optional<entry_info> {
+        // Operations which move _current_idx drain the prefetch first, so an
+        // engaged prefetch always refers to _current_idx.
+        future<promoted_index_block*> f = [this] {
+            if (_next_block_prefetch) {
+                auto pf = std::move(*_next_block_prefetch);
+                _next_block_prefetch.reset();
+                return pf;
+            }
+            return _promoted_index.get_block(_current_idx, _trace_state);
+        }();
+        return f.then([this] (promoted_index_block* block) -> std::optional<entry_info> {
             sstlog.trace("mc_bsearch_clustered_cursor {}: block {}: start={}, end={}, offset={}", fmt::ptr(this), _current_idx,
                 *block->start, *block->end, block->data_file_offset);
             ++_current_idx;
+            if (_current_idx < _blocks_count) {
+                _next_block_prefetch = _promoted_index.get_block(_current_idx, _trace_state);
+            }
             return entry_info{*block->start, *block->end, block->data_file_offset};
         });
     }
@@ -545,6 +586,9 @@ public:
     // If the block existed and advancing was successful (i.e. we weren't already at this block),
     // returns `skip_info` describing this block. Otherwise returns nullopt.
     future<std::optional<skip_info>> advance_past(position_in_partition_view pos) {
+        if (_next_block_prefetch) {
+            return drain_prefetch().then([this, pos] { return advance_past(pos); });
+        }
         return advance_to_upper_bound(pos).then([this] {
             if (_current_idx == _blocks_count) {
                 return make_ready_future<std::optional<skip_info>>(std::nullopt);
@@ -571,6 +615,9 @@ public:
     // (shortly: the offset of the last promoted index block in the data file), or nullopt
     // if there are no blocks.
     future<std::optional<uint64_t>> last_block_offset() {
+        if (_next_block_prefetch) {
+            return drain_prefetch().then([this] { return last_block_offset(); });
+        }
         if (_blocks_count == 0) {
             return make_ready_future<std::optional<uint64_t>>();
         }
@@ -581,6 +628,9 @@ public:
     }
 
     future<> close() noexcept override {
+        if (_next_block_prefetch) {
+            return drain_prefetch();
+        }
         return make_ready_future<>();
     }
 };
@@ -75,6 +75,20 @@ public:
     static_row _in_progress_static_row;
     bool _inside_static_row = false;
 
+    // Tombstone of the partition being parsed, learned either from the
+    // partition header or, for sliced reads entering the partition through
+    // the promoted index, from the index.
+    tombstone _partition_tombstone;
+    // Timestamp of the most recent regular tombstone covering the row being
+    // parsed: the maximum of the partition tombstone, the range tombstone
+    // active at the row's position and the row's own tombstone. Cells with
+    // timestamps not greater than this are dead no matter what other
+    // sstables hold, and all of these tombstones are emitted anyway, so
+    // such cells don't have to be materialized at all. Shadowable (view)
+    // tombstones don't count here: a newer row marker from another source
+    // can cancel them and revive the cells they cover.
+    api::timestamp_type _shadowing_timestamp = api::missing_timestamp;
+
     struct cell {
         column_id id;
         atomic_cell_or_collection val;
@@ -185,6 +199,8 @@ public:
         _in_progress_row.reset();
         _stored_tombstone.reset();
         _mf_filter.reset();
+        _partition_tombstone = {};
+        _shadowing_timestamp = api::missing_timestamp;
     }
 
     void check_schema_mismatch(const column_translation::column_info& column_info, const column_definition& column_def) const {
@@ -200,7 +216,7 @@ public:
     void check_column_missing_in_current_schema(const column_translation::column_info& column_info,
                                                 api::timestamp_type timestamp) const {
         if (!column_info.id) {
-            sstring name = sstring(to_sstring_view(*column_info.name));
+            sstring name = sstring(to_sstring_view(column_info.name));
             auto it = _schema->dropped_columns().find(name);
             if (it == _schema->dropped_columns().end() || timestamp > it->second.timestamp) {
                 throw malformed_sstable_exception(format("Column {} missing in current schema", name));
@@ -309,6 +325,16 @@ public:
         _mf_filter->set_tombstone(t);
     }
 
+    /*
+     * Sets the partition tombstone. Used when the partition is entered
+     * through the promoted index and the partition header in the data file
+     * is never parsed, so consume_partition_start() is not called.
+     */
+    void set_partition_tombstone(tombstone t) {
+        sstlog.trace("mp_row_consumer_m {}: set_partition_tombstone({})", fmt::ptr(this), t);
+        _partition_tombstone = t;
+    }
+
     // Consume the row's key and deletion_time. The latter determines if the
     // row is a tombstone, and if so, when it has been deleted.
     // Note that the key is in serialized form, and should be deserialized
@@ -318,6 +344,7 @@ public:
     proceed consume_partition_start(sstables::key_view key, sstables::deletion_time deltime) {
         sstlog.trace("mp_row_consumer_m {}: consume_partition_start(deltime=({}, {})), _is_mutation_end={}", fmt::ptr(this),
             deltime.local_deletion_time, deltime.marked_for_delete_at, _is_mutation_end);
+        _partition_tombstone = tombstone(deltime);
         if (!_is_mutation_end) {
             return proceed::yes;
         }
@@ -346,6 +373,7 @@ public:
         switch (res.action) {
         case mutation_fragment_filter::result::emit:
             sstlog.trace("mp_row_consumer_m {}: emit", fmt::ptr(this));
+            _shadowing_timestamp = std::max(_partition_tombstone.timestamp, _mf_filter->current_tombstone().timestamp);
             return mp_row_consumer_m::row_processing_result::do_proceed;
         case mutation_fragment_filter::result::ignore:
             sstlog.trace("mp_row_consumer_m {}: ignore", fmt::ptr(this));
@@ -383,6 +411,7 @@ public:
         if (_in_progress_row->tomb()) {
             _sst->get_stats().on_row_tombstone_read();
         }
+        _shadowing_timestamp = std::max(_shadowing_timestamp, tomb.timestamp);
         return proceed::yes;
     }
 
@@ -393,6 +422,7 @@ public:
         }
         _inside_static_row = true;
         _in_progress_static_row = static_row();
+        _shadowing_timestamp = _partition_tombstone.timestamp;
         return mp_row_consumer_m::row_processing_result::do_proceed;
     }
 
@@ -415,6 +445,15 @@ public:
             return proceed::yes;
         }
         check_schema_mismatch(column_info, column_def);
+        // See the comment on _shadowing_timestamp. For a collection cell the
+        // complex column's own tombstone shadows it too.
+        auto shadowing_timestamp = _shadowing_timestamp;
+        if (column_def.is_multi_cell() && _cm.tomb) {
+            shadowing_timestamp = std::max(shadowing_timestamp, _cm.tomb.timestamp);
+        }
+        if (timestamp <= shadowing_timestamp) {
+            return proceed::yes;
+        }
         if (column_def.is_multi_cell()) {
             auto& value_type = visit(*column_def.type, make_visitor(
                 [] (const collection_type_impl& ctype) -> const abstract_type& { return *ctype.value_comparator(); },
@@ -493,6 +532,9 @@ public:
             return proceed::yes;
         }
         check_schema_mismatch(column_info, column_def);
+        if (timestamp <= _shadowing_timestamp) {
+            return proceed::yes;
+        }
         auto ac = make_counter_cell(timestamp, value);
         _cells.push_back({*column_id, atomic_cell_or_collection(std::move(ac))});
         return proceed::yes;
@@ -1372,6 +1414,7 @@ private:
         auto pk = _index_reader->get_partition_key();
         auto key = dht::decorate_key(*_schema, std::move(pk));
         _consumer.setup_for_partition(key.key());
+        _consumer.set_partition_tombstone(tombstone(*tomb));
         on_next_partition(std::move(key), tombstone(*tomb));
         return make_ready_future<>();
     }
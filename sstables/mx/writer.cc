@@ -27,6 +27,7 @@
 #include "vint-serialization.hh"
 #include "sstables/types.hh"
 #include "sstables/mx/types.hh"
+#include "sstables/sstables_manager.hh"
 #include "db/config.hh"
 #include "atomic_cell.hh"
 #include "utils/exceptions.hh"
@@ -542,6 +543,7 @@ private:
     const encoding_stats _enc_stats;
     shard_id _shard; // Specifies which shard the new SStable will belong to.
     bool _compression_enabled = false;
+    bool _blocked_filter = false;
     std::unique_ptr<file_writer> _data_writer;
     std::unique_ptr<file_writer> _index_writer;
     bool _tombstone_written = false;
@@ -642,25 +644,35 @@ private:
         }
     }
 
-    void write_delta_timestamp(bytes_ostream& writer, api::timestamp_type timestamp) {
+    template <typename W>
+    requires Writer<W>
+    void write_delta_timestamp(W& writer, api::timestamp_type timestamp) {
         sstables::mc::write_delta_timestamp(writer, timestamp, _enc_stats);
     }
-    void write_delta_ttl(bytes_ostream& writer, gc_clock::duration ttl) {
+    template <typename W>
+    requires Writer<W>
+    void write_delta_ttl(W& writer, gc_clock::duration ttl) {
         sstables::mc::write_delta_ttl(writer, ttl, _enc_stats);
     }
-    void write_delta_local_deletion_time(bytes_ostream& writer, gc_clock::time_point ldt) {
+    template <typename W>
+    requires Writer<W>
+    void write_delta_local_deletion_time(W& writer, gc_clock::time_point ldt) {
         sstables::mc::write_delta_local_deletion_time(writer, ldt, _enc_stats);
     }
     void do_write_delta_deletion_time(bytes_ostream& writer, const tombstone& t) {
-        sstables::mc::write_delta_timestamp(writer, t.timestamp, _enc_stats);
-        sstables::mc::write_delta_local_deletion_time(writer, t.deletion_time, _enc_stats);
+        vint_batch_writer<2 * max_vint_length> batch;
+        sstables::mc::write_delta_timestamp(batch, t.timestamp, _enc_stats);
+        sstables::mc::write_delta_local_deletion_time(batch, t.deletion_time, _enc_stats);
+        batch.flush(writer);
     }
     void write_delta_deletion_time(bytes_ostream& writer, const tombstone& t) {
         if (t) {
             do_write_delta_deletion_time(writer, t);
         } else {
-            sstables::mc::write_delta_timestamp(writer, api::missing_timestamp, _enc_stats);
-            sstables::mc::write_delta_local_deletion_time(writer, no_deletion_time, _enc_stats);
+            vint_batch_writer<2 * max_vint_length> batch;
+            sstables::mc::write_delta_timestamp(batch, api::missing_timestamp, _enc_stats);
+            sstables::mc::write_delta_local_deletion_time(batch, no_deletion_time, _enc_stats);
+            batch.flush(writer);
         }
     }
 
@@ -800,7 +812,12 @@ public:
         _sst._shards = { shard };
 
         _cfg.monitor->on_write_started(_data_writer->offset_tracker());
-        _sst._components->filter = utils::i_filter::get_filter(estimated_partitions, _schema.bloom_filter_fp_chance(), utils::filter_format::m_format);
+        // The blocked layout is a Scylla-specific extension; sstables written
+        // with it are flagged in scylla metadata and cannot be read by nodes
+        // that predate the feature, hence the opt-in.
+        _blocked_filter = _sst.manager().config().enable_sstable_blocked_bloom_filter();
+        auto filter_format = _blocked_filter ? utils::filter_format::m_blocked_format : utils::filter_format::m_format;
+        _sst._components->filter = utils::i_filter::get_filter(estimated_partitions, _schema.bloom_filter_fp_chance(), filter_format);
         _pi_write_m.desired_block_size = cfg.promoted_index_block_size;
         _index_sampling_state.summary_byte_cost = _cfg.summary_byte_cost;
         prepare_summary(_sst._components->summary, estimated_partitions, _schema.min_index_interval());
@@ -887,12 +904,19 @@ void writer::init_file_writers() {
         auto out = make_file_data_sink(std::move(_sst._data_file), options).get0();
         _data_writer = std::make_unique<crc32_checksummed_file_writer>(std::move(out), options.buffer_size, _sst.filename(component_type::Data));
     } else {
-        auto out = make_file_output_stream(std::move(_sst._data_file), options).get0();
+        auto out = make_file_data_sink(std::move(_sst._data_file), options).get0();
+        auto cp = _schema.get_compressor_params();
+        if (_cfg.compressor) {
+            // The override ends up in this sstable's CompressionInfo (along
+            // with any trained dictionary in its options), so the read path
+            // picks it up without further coordination.
+            cp.set_compressor(_cfg.compressor);
+        }
         _data_writer = std::make_unique<file_writer>(
             make_compressed_file_m_format_output_stream(
                 std::move(out),
                 &_sst._components->compression,
-                _schema.get_compressor_params()), _sst.filename(component_type::Data));
+                cp), _sst.filename(component_type::Data));
     }
     auto w = file_writer::make(std::move(_sst._index_file), std::move(options), _sst.filename(component_type::Index));
     _index_writer = std::make_unique<file_writer>(w.get0());
@@ -1100,23 +1124,29 @@ void writer::write_cell(bytes_ostream& writer, const clustering_key_prefix* clus
     if (use_row_ttl) {
         flags |= cell_flags::use_row_ttl_mask;
     }
-    write(_sst.get_version(), writer, flags);
+    // The cell header is a run of a flags byte and up to four vints; stage
+    // it on the stack so the ostream is written once per cell header.
+    vint_batch_writer<1 + 4 * max_vint_length> header;
+    write(_sst.get_version(), header, flags);
 
     if (!use_row_timestamp) {
-        write_delta_timestamp(writer, cell.timestamp());
+        write_delta_timestamp(header, cell.timestamp());
     }
 
     if (!use_row_ttl) {
         if (is_deleted) {
-            write_delta_local_deletion_time(writer, cell.deletion_time());
+            write_delta_local_deletion_time(header, cell.deletion_time());
         } else if (is_cell_expiring) {
-            write_delta_local_deletion_time(writer, cell.expiry());
-            write_delta_ttl(writer, cell.ttl());
+            write_delta_local_deletion_time(header, cell.expiry());
+            write_delta_ttl(header, cell.ttl());
         }
     }
 
     if (bool(cell_path)) {
-        write_vint(writer, cell_path->size());
+        write_vint(header, cell_path->size());
+    }
+    header.flush(writer);
+    if (bool(cell_path)) {
         write(_sst.get_version(), writer, *cell_path);
     }
 
@@ -1167,13 +1197,14 @@ void writer::write_liveness_info(bytes_ostream& writer, const row_marker& marker
 
     api::timestamp_type timestamp = marker.timestamp();
     _c_stats.update_timestamp(timestamp);
-    write_delta_timestamp(writer, timestamp);
+    vint_batch_writer<3 * max_vint_length> batch;
+    write_delta_timestamp(batch, timestamp);
 
-    auto write_expiring_liveness_info = [this, &writer] (gc_clock::duration ttl, gc_clock::time_point ldt) {
+    auto write_expiring_liveness_info = [this, &batch] (gc_clock::duration ttl, gc_clock::time_point ldt) {
         _c_stats.update_ttl(ttl);
         _c_stats.update_local_deletion_time_and_tombstone_histogram(ldt);
-        write_delta_ttl(writer, ttl);
-        write_delta_local_deletion_time(writer, ldt);
+        write_delta_ttl(batch, ttl);
+        write_delta_local_deletion_time(batch, ldt);
     };
     if (!marker.is_live()) {
         write_expiring_liveness_info(gc_clock::duration(expired_liveness_ttl), marker.deletion_time());
@@ -1183,6 +1214,7 @@ void writer::write_liveness_info(bytes_ostream& writer, const row_marker& marker
         _c_stats.update_ttl(0);
         _c_stats.update_local_deletion_time(std::numeric_limits<int32_t>::max());
     }
+    batch.flush(writer);
 }
 
 void writer::write_collection(bytes_ostream& writer, const clustering_key_prefix* clustering_key,
@@ -1489,6 +1521,9 @@ void writer::consume_end_of_stream() {
     _sst.write_statistics(_pc);
     _sst.write_compression(_pc);
     auto features = sstable_enabled_features::all();
+    if (!_blocked_filter) {
+        features.disable(sstable_feature::BlockedBloomFilter);
+    }
     run_identifier identifier{_run_identifier};
     std::optional<scylla_metadata::large_data_stats> ld_stats(std::move(_large_data_stats));
     _sst.write_scylla_metadata(_pc, _shard, std::move(features), std::move(identifier), std::move(ld_stats), _cfg.origin);
@@ -163,8 +163,8 @@ sstable_directory::highest_version_seen() const {
 }
 
 future<>
-sstable_directory::process_sstable_dir(const ::io_priority_class& iop, bool sort_sstables_according_to_owner) {
-    dirlog.debug("Start processing directory {} for SSTables", _sstable_dir);
+sstable_directory::scan_sstable_dir() {
+    dirlog.debug("Start scanning directory {} for SSTables", _sstable_dir);
 
     // It seems wasteful that each shard is repeating this scan, and to some extent it is.
     // However, we still want to open the files and especially call process_dir() in a distributed
@@ -175,15 +175,16 @@ sstable_directory::process_sstable_dir(const ::io_priority_class& iop, bool sort
     // - The directory listing part already interacts with data_structures inside scan_state. We
     //   would have to either transfer a lot of file information among shards or complicate the code
     //   to make sure they all update their own version of scan_state and then merge it.
-    // - If all shards scan in parallel, they can start loading sooner. That is faster than having
-    //   a separate step to fetch all files, followed by another step to distribute and process.
-    return do_with(scan_state{}, [this, sort_sstables_according_to_owner, &iop] (scan_state& state) {
+    // - Scanning is cheap compared to opening: the listing streams directory blocks while opening
+    //   reads several components per SSTable. Each shard picking up its own generations in parallel
+    //   keeps the expensive part distributed without any coordination.
+    return do_with(scan_state{}, [this] (scan_state& state) {
         return lister::scan_dir(_sstable_dir, { directory_entry_type::regular },
-                [this, sort_sstables_according_to_owner, &state] (fs::path parent_dir, directory_entry de) {
+                [this, &state] (fs::path parent_dir, directory_entry de) {
             auto comps = sstables::entry_descriptor::make_descriptor(_sstable_dir.native(), de.name);
             handle_component(state, std::move(comps), parent_dir / fs::path(de.name));
             return make_ready_future<>();
-        }, &manifest_json_filter).then([this, sort_sstables_according_to_owner, &state, &iop] {
+        }, &manifest_json_filter).then([this, &state] {
             // Always okay to delete files with a temporary TOC. We want to do it before we process
             // the generations seen: it's okay to reuse those generations since the files will have
             // been deleted anyway.
@@ -206,12 +207,13 @@ sstable_directory::process_sstable_dir(const ::io_priority_class& iop, bool sort
                     _sstable_dir, _max_generation_seen, state.descriptors.size(), state.generations_found.size());
 
             // _descriptors is everything with a TOC. So after we remove this, what's left is
-            // SSTables for which a TOC was not found.
-            return parallel_for_each_restricted(state.descriptors, [this, sort_sstables_according_to_owner, &state, &iop] (std::tuple<int64_t, sstables::entry_descriptor>&& t) {
-                auto& desc = std::get<1>(t);
+            // SSTables for which a TOC was not found. The descriptors themselves are queued for
+            // later opening (by this shard, or by whichever shard they are handed off to).
+            _pending_descriptors.reserve(state.descriptors.size());
+            return do_for_each(state.descriptors, [this, &state] (std::pair<const int64_t, sstables::entry_descriptor>& t) {
+                auto& desc = t.second;
                 state.generations_found.erase(desc.generation);
-                // This will try to pre-load this file and throw an exception if it is invalid
-                return process_descriptor(std::move(desc), iop, sort_sstables_according_to_owner);
+                _pending_descriptors.push_back(std::move(desc));
             }).then([this, &state] {
                 // For files missing TOC, it depends on where this is coming from.
                 // If scylla was supposed to have generated this SSTable, this is not okay and
@@ -230,6 +232,40 @@ sstable_directory::process_sstable_dir(const ::io_priority_class& iop, bool sort
     });
 }
 
+future<>
+sstable_directory::process_pending_sstables(const ::io_priority_class& iop, bool sort_sstables_according_to_owner) {
+    auto pending = std::exchange(_pending_descriptors, {});
+    dirlog.debug("Start processing {} SSTables from directory {}", pending.size(), _sstable_dir);
+    return parallel_for_each_restricted(std::move(pending), [this, sort_sstables_according_to_owner, &iop] (sstables::entry_descriptor& desc) {
+        // This will try to pre-load this file and throw an exception if it is invalid
+        return process_descriptor(std::move(desc), iop, sort_sstables_according_to_owner);
+    });
+}
+
+future<sstable_directory::scan_descriptors>
+sstable_directory::release_pending_sstables(size_t n) {
+    n = std::min(n, _pending_descriptors.size());
+    return do_with(scan_descriptors(), [this, n] (scan_descriptors& released) {
+        released.reserve(n);
+        return do_for_each(boost::irange(size_t(0), n), [this, &released] (size_t) {
+            released.push_back(std::move(_pending_descriptors.back()));
+            _pending_descriptors.pop_back();
+        }).then([&released] {
+            return make_ready_future<scan_descriptors>(std::move(released));
+        });
+    });
+}
+
+future<>
+sstable_directory::add_pending_sstables(scan_descriptors descs) {
+    return do_with(std::move(descs), [this] (scan_descriptors& descs) {
+        _pending_descriptors.reserve(_pending_descriptors.size() + descs.size());
+        return do_for_each(descs, [this] (sstables::entry_descriptor& desc) {
+            _pending_descriptors.push_back(std::move(desc));
+        });
+    });
+}
+
 future<>
 sstable_directory::commit_directory_changes() {
     // Remove all files scheduled for removal
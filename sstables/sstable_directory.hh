@@ -61,9 +61,9 @@ public:
     // favor chunked vectors when dealing with file lists: they can grow to hundreds of thousands
     // of elements.
     using sstable_info_vector = utils::chunked_vector<sstables::foreign_sstable_open_info>;
+    using scan_descriptors = utils::chunked_vector<sstables::entry_descriptor>;
 private:
     using scan_multimap = std::unordered_multimap<int64_t, std::filesystem::path>;
-    using scan_descriptors = utils::chunked_vector<sstables::entry_descriptor>;
     using scan_descriptors_map = std::unordered_map<int64_t, sstables::entry_descriptor>;
 
     struct scan_state {
@@ -118,6 +118,11 @@ private:
     // the amount of data resharded per shard, so a coordinator may redistribute this.
     sstable_info_vector _shared_sstable_info;
 
+    // SSTables found by the scan but not yet opened. The scan assigns SSTables to shards by
+    // generation, which can come out very skewed; a coordinator may hand some of these off to
+    // less loaded shards before the opening starts (see release_pending_sstables()).
+    scan_descriptors _pending_descriptors;
+
     future<> process_descriptor(sstables::entry_descriptor desc, const ::io_priority_class& iop, bool sort_sstables_according_to_owner = true);
     void validate(sstables::shared_sstable sst) const;
     void handle_component(scan_state& state, sstables::entry_descriptor desc, std::filesystem::path filename);
@@ -156,18 +161,37 @@ public:
     sstables::sstable_version_types highest_version_seen() const;
 
     // scans a directory containing SSTables. Every generation that is believed to belong to this
-    // shard is processed, the ones that are not are skipped. Potential pertinence is decided as
-    // generation % smp::count.
-    //
-    // Once this method return, every SSTable that this shard processed can be in one of 3 states:
-    //  - unshared, local: not a shared SSTable, and indeed belongs to this shard.
-    //  - unshared, remote: not s shared SSTable, but belongs to a remote shard.
-    //  - shared : shared SSTable that belongs to many shards. Must be resharded before using
+    // shard is picked up, the ones that are not are skipped. Potential pertinence is decided as
+    // generation % smp::count. The SSTables found are not opened yet: they are queued as pending
+    // descriptors, so that a coordinator can even out the opening work among shards first, and
+    // opened by a later call to process_pending_sstables().
     //
     // This function doesn't change on-storage state. If files are to be removed, a separate call
     // (commit_file_removals()) has to be issued. This is to make sure that all instances of this
     // class in a sharded service have the opportunity to validate its files.
-    future<> process_sstable_dir(const ::io_priority_class& iop, bool sort_sstables_according_to_owner = true);
+    future<> scan_sstable_dir();
+
+    // opens the SSTables this shard found during scan_sstable_dir(), plus any that were handed
+    // off to it, with the configured load parallelism.
+    //
+    // Once this method returns, every SSTable that this shard opened can be in one of 3 states:
+    //  - unshared, local: not a shared SSTable, and indeed belongs to this shard.
+    //  - unshared, remote: not s shared SSTable, but belongs to a remote shard.
+    //  - shared : shared SSTable that belongs to many shards. Must be resharded before using
+    future<> process_pending_sstables(const ::io_priority_class& iop, bool sort_sstables_according_to_owner = true);
+
+    // Number of SSTables scanned but not yet opened.
+    size_t pending_sstable_count() const noexcept {
+        return _pending_descriptors.size();
+    }
+
+    // Hands off up to n scanned-but-not-yet-opened SSTables, to be opened by another shard.
+    // Opening doesn't have to happen on the shard that owns an SSTable: the result is routed
+    // to the owner through move_foreign_sstables() either way.
+    future<scan_descriptors> release_pending_sstables(size_t n);
+
+    // Accepts SSTables handed off by another shard's release_pending_sstables().
+    future<> add_pending_sstables(scan_descriptors descs);
 
     // Sort the sstable according to owner
     future<> sort_sstable(sstables::shared_sstable sst);
@@ -23,10 +23,15 @@
 
 #include "column_translation.hh"
 #include "concrete_types.hh"
+#include "hashers.hh"
+#include "schema_registry.hh"
 #include "utils/fragment_range.hh"
+#include "utils/hash.hh"
 
 #include <boost/range/algorithm/stable_partition.hpp>
 
+#include <unordered_map>
+
 namespace sstables {
 
 atomic_cell make_counter_cell(api::timestamp_type timestamp, fragmented_temporary_buffer::view cell_value) {
@@ -108,7 +113,7 @@ std::vector<column_translation::column_info> column_translation::state::build(
     if (s.is_dense()) {
         const column_definition& col = is_static ? *s.static_begin() : *s.regular_begin();
         cols.push_back(column_info{
-            &col.name(),
+            col.name(),
             col.type,
             col.id,
             col.type->value_length_if_fixed(),
@@ -135,7 +140,7 @@ std::vector<column_translation::column_info> column_translation::state::build(
                                   !def->type->is_value_compatible_with(*type);
             }
             cols.push_back(column_info{
-                &desc.name.value,
+                desc.name.value,
                 type,
                 id,
                 type->value_length_if_fixed(),
@@ -149,6 +154,83 @@ std::vector<column_translation::column_info> column_translation::state::build(
     return cols;
 }
 
+namespace {
+
+// Key of the per-shard column_translation cache. Two sstables whose
+// serialization headers digest the same and which are read under the same
+// schema version get identical translations, so they can share one.
+struct column_translation_cache_key {
+    table_schema_version schema_version;
+    bytes header_digest;
+    bool operator==(const column_translation_cache_key&) const = default;
+};
+
+struct column_translation_cache_key_hash {
+    size_t operator()(const column_translation_cache_key& k) const {
+        return utils::hash_combine(std::hash<utils::UUID>()(k.schema_version), std::hash<bytes>()(k.header_digest));
+    }
+};
+
+// Digests the parts of the serialization header which state::build() and
+// get_clustering_values_fixed_lengths() look at, plus the feature bits which
+// change build()'s output. Cryptographic, so a collision (which would hand a
+// reader the wrong translation) is not a practical concern.
+static bytes column_translation_digest(const serialization_header& header, const sstable_enabled_features& features) {
+    md5_hasher h;
+    auto feed_string = [&h] (const bytes& b) {
+        feed_hash(h, uint32_t(b.size()));
+        h.update(reinterpret_cast<const char*>(b.data()), b.size());
+    };
+    auto feed_columns = [&] (const utils::chunked_vector<serialization_header::column_desc>& columns) {
+        feed_hash(h, uint32_t(columns.size()));
+        for (auto&& desc : columns) {
+            feed_string(desc.name.value);
+            feed_string(desc.type_name.value);
+        }
+    };
+    feed_hash(h, uint32_t(header.clustering_key_types_names.elements.size()));
+    for (auto&& t : header.clustering_key_types_names.elements) {
+        feed_string(t.value);
+    }
+    feed_columns(header.static_columns.elements);
+    feed_columns(header.regular_columns.elements);
+    feed_hash(h, features.is_enabled(CorrectUDTsInCollections));
+    feed_hash(h, is_certainly_scylla_sstable(features));
+    return h.finalize();
+}
+
+}
+
+lw_shared_ptr<const column_translation::state> column_translation::state::get_or_create(
+        const schema& s, const serialization_header& header, const sstable_enabled_features& features) {
+    static thread_local std::unordered_map<column_translation_cache_key, lw_shared_ptr<const state>,
+            column_translation_cache_key_hash> cache;
+    // Readers always look translations up through the current schema of
+    // their table, and every live schema version sits in the local schema
+    // registry. Entries for versions which left the registry can therefore
+    // never be hit again, and pruning them ties the cache's footprint to the
+    // registry's lifetimes without needing explicit eviction hooks.
+    static constexpr size_t prune_threshold = 128;
+    column_translation_cache_key key{s.version(), column_translation_digest(header, features)};
+    auto it = cache.find(key);
+    if (it != cache.end()) {
+        return it->second;
+    }
+    if (cache.size() >= prune_threshold) {
+        auto& registry = local_schema_registry();
+        for (auto i = cache.begin(); i != cache.end();) {
+            if (!registry.get_or_null(i->first.schema_version)) {
+                i = cache.erase(i);
+            } else {
+                ++i;
+            }
+        }
+    }
+    auto st = make_lw_shared<const state>(s, header, features);
+    cache.emplace(std::move(key), st);
+    return st;
+}
+
 
 
 position_in_partition_view get_slice_upper_bound(const schema& s, const query::partition_slice& slice, dht::ring_position_view key) {
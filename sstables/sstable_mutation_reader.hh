@@ -187,7 +187,11 @@ inline std::unique_ptr<DataConsumeRowsContext> data_consume_single_partition(con
 template <typename DataConsumeRowsContext>
 inline std::unique_ptr<DataConsumeRowsContext> data_consume_rows(const schema& s, shared_sstable sst, typename DataConsumeRowsContext::consumer& consumer) {
         auto data_size = sst->data_size();
-        return data_consume_rows<DataConsumeRowsContext>(s, std::move(sst), consumer, {0, data_size}, data_size);
+        // Whole-file consumers (compaction, scrub, validation) read strictly
+        // sequentially, so use the scan stream profile.
+        auto input = sst->data_stream(0, data_size, consumer.io_priority(),
+                consumer.permit(), consumer.trace_state(), {}, sstable::stream_profile::scan);
+        return std::make_unique<DataConsumeRowsContext>(s, std::move(sst), consumer, std::move(input), uint64_t(0), data_size);
 }
 
 template<typename T>
@@ -32,6 +32,7 @@
 #include "compaction/time_window_compaction_strategy.hh"
 
 #include "sstable_set_impl.hh"
+#include "utils/stall_free.hh"
 
 #include "database.hh"
 
@@ -136,6 +137,11 @@ sstable_set::erase(shared_sstable sst) {
     _impl->erase(sst);
 }
 
+future<>
+sstable_set::clear_gently() noexcept {
+    return _impl->clear_gently();
+}
+
 sstable_set::~sstable_set() = default;
 
 sstable_set::incremental_selector::incremental_selector(std::unique_ptr<incremental_selector_impl> impl, const schema& s)
@@ -208,6 +214,66 @@ bool partitioned_sstable_set::store_as_unleveled(const shared_sstable& sst) cons
     return _use_level_metadata && sst->get_sstable_level() == 0;
 }
 
+void partitioned_sstable_set::rebuild_unleveled_max_last(size_t from) {
+    dht::ring_position_comparator cmp(*_schema);
+    _unleveled_max_last.resize(_unleveled_sstables.size(), dht::ring_position::min());
+    for (auto i = from; i < _unleveled_sstables.size(); ++i) {
+        auto last = dht::ring_position(_unleveled_sstables[i]->get_last_decorated_key());
+        if (i && cmp(last, _unleveled_max_last[i - 1]) < 0) {
+            _unleveled_max_last[i] = _unleveled_max_last[i - 1];
+        } else {
+            _unleveled_max_last[i] = std::move(last);
+        }
+    }
+}
+
+void partitioned_sstable_set::insert_unleveled(shared_sstable sst) {
+    dht::ring_position_comparator cmp(*_schema);
+    auto it = std::lower_bound(_unleveled_sstables.begin(), _unleveled_sstables.end(), sst,
+            [&] (const shared_sstable& a, const shared_sstable& b) {
+        return cmp(a->get_first_decorated_key(), b->get_first_decorated_key()) < 0;
+    });
+    auto from = it - _unleveled_sstables.begin();
+    _unleveled_sstables.insert(it, std::move(sst));
+    rebuild_unleveled_max_last(from);
+}
+
+void partitioned_sstable_set::erase_unleveled(const shared_sstable& sst) {
+    auto it = std::find(_unleveled_sstables.begin(), _unleveled_sstables.end(), sst);
+    if (it == _unleveled_sstables.end()) {
+        return;
+    }
+    auto from = it - _unleveled_sstables.begin();
+    _unleveled_sstables.erase(it);
+    rebuild_unleveled_max_last(from);
+}
+
+std::vector<shared_sstable> partitioned_sstable_set::select_unleveled(const dht::partition_range& range) const {
+    if (!range.start() && !range.end()) {
+        return _unleveled_sstables;
+    }
+    dht::ring_position_comparator cmp(*_schema);
+    // A range contains position p iff for_range_start(range) <= p < for_range_end(range).
+    auto end_bound = dht::ring_position_view::for_range_end(range);
+    // Entries are sorted by first key, so no entry from this point on can overlap with the range.
+    auto e = std::partition_point(_unleveled_sstables.begin(), _unleveled_sstables.end(), [&] (const shared_sstable& sst) {
+        return cmp(sst->get_first_decorated_key(), end_bound) < 0;
+    });
+    auto start_bound = dht::ring_position_view::for_range_start(range);
+    std::vector<shared_sstable> ret;
+    for (auto i = size_t(e - _unleveled_sstables.begin()); i-- > 0;) {
+        if (cmp(_unleveled_max_last[i], start_bound) < 0) {
+            // No sstable at or before position i reaches the range start anymore.
+            break;
+        }
+        const auto& sst = _unleveled_sstables[i];
+        if (cmp(sst->get_last_decorated_key(), start_bound) >= 0) {
+            ret.push_back(sst);
+        }
+    }
+    return ret;
+}
+
 dht::ring_position partitioned_sstable_set::to_ring_position(const compatible_ring_position_or_view& crp) {
     // Ring position views, representing bounds of sstable intervals are
     // guaranteed to have key() != nullptr;
@@ -248,6 +314,8 @@ partitioned_sstable_set::partitioned_sstable_set(schema_ptr schema, const std::v
         , _all(make_lw_shared<sstable_list>(*all))
         , _all_runs(all_runs)
         , _use_level_metadata(use_level_metadata) {
+    // unleveled_sstables comes from another set, so it's already sorted by first key.
+    rebuild_unleveled_max_last(0);
 }
 
 std::unique_ptr<sstable_set_impl> partitioned_sstable_set::clone() const {
@@ -262,7 +330,7 @@ std::vector<shared_sstable> partitioned_sstable_set::select(const dht::partition
     while (b != e) {
         boost::copy(b++->second, std::inserter(result, result.end()));
     }
-    auto r = _unleveled_sstables;
+    auto r = select_unleveled(range);
     r.insert(r.end(), result.begin(), result.end());
     return r;
 }
@@ -285,7 +353,7 @@ void partitioned_sstable_set::insert(shared_sstable sst) {
     auto undo_all_runs_insert = defer([&] () { _all_runs[sst->run_identifier()].erase(sst); });
 
     if (store_as_unleveled(sst)) {
-        _unleveled_sstables.push_back(sst);
+        insert_unleveled(sst);
     } else {
         _leveled_sstables_change_cnt++;
         _leveled_sstables.add({make_interval(*sst), value_set({sst})});
@@ -298,13 +366,32 @@ void partitioned_sstable_set::erase(shared_sstable sst) {
     _all_runs[sst->run_identifier()].erase(sst);
     _all->erase(sst);
     if (store_as_unleveled(sst)) {
-        _unleveled_sstables.erase(std::remove(_unleveled_sstables.begin(), _unleveled_sstables.end(), sst), _unleveled_sstables.end());
+        erase_unleveled(sst);
     } else {
         _leveled_sstables_change_cnt++;
         _leveled_sstables.subtract({make_interval(*sst), value_set({sst})});
     }
 }
 
+future<> partitioned_sstable_set::clear_gently() noexcept {
+    return utils::clear_gently(_unleveled_sstables).then([this] {
+        return utils::clear_gently(_unleveled_max_last);
+    }).then([this] {
+        _leveled_sstables_change_cnt++;
+        return do_until([this] { return _leveled_sstables.empty(); }, [this] {
+            _leveled_sstables.erase(_leveled_sstables.begin());
+            return make_ready_future<>();
+        });
+    }).then([this] {
+        // all() may have handed the list out; only gently clear it if we're
+        // its last owner. The list itself must stay allocated so the set
+        // remains usable.
+        return utils::clear_gently(_all);
+    }).then([this] {
+        return utils::clear_gently(_all_runs);
+    });
+}
+
 class partitioned_sstable_set::incremental_selector : public incremental_selector_impl {
     schema_ptr _schema;
     const std::vector<shared_sstable>& _unleveled_sstables;
@@ -425,6 +512,14 @@ void time_series_sstable_set::erase(shared_sstable sst) {
     }
 }
 
+future<> time_series_sstable_set::clear_gently() noexcept {
+    // The containers may be shared with a clone or a reader queue; only
+    // gently clear those we're the last owner of.
+    return utils::clear_gently(_sstables).then([this] {
+        return utils::clear_gently(_sstables_reversed);
+    });
+}
+
 std::unique_ptr<incremental_selector_impl> time_series_sstable_set::make_incremental_selector() const {
     struct selector : public incremental_selector_impl {
         const time_series_sstable_set& _set;
@@ -769,6 +864,10 @@ sstable_set_impl::select_sstable_runs(const std::vector<shared_sstable>& sstable
     throw_with_backtrace<std::bad_function_call>();
 }
 
+future<> sstable_set_impl::clear_gently() noexcept {
+    return make_ready_future<>();
+}
+
 flat_mutation_reader
 sstable_set_impl::create_single_key_sstable_reader(
         column_family* cf,
@@ -970,6 +1069,17 @@ void compound_sstable_set::erase(shared_sstable sst) {
     throw_with_backtrace<std::bad_function_call>();
 }
 
+future<> compound_sstable_set::clear_gently() noexcept {
+    // The underlying sets are shared with their owning table and only jointly
+    // read from here (cf. insert()/erase()), so gently clear only the ones we
+    // are the last owner of and just drop the references to the rest.
+    return do_for_each(_sets, [] (lw_shared_ptr<sstable_set>& set) {
+        return utils::clear_gently(set);
+    }).then([this] {
+        _sets.clear();
+    });
+}
+
 class compound_sstable_set::incremental_selector : public incremental_selector_impl {
     const schema& _schema;
     const std::vector<lw_shared_ptr<sstable_set>>& _sets;
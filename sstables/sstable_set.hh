@@ -69,6 +69,11 @@ public:
     void for_each_sstable(std::function<void(const shared_sstable&)> func) const;
     void insert(shared_sstable sst);
     void erase(shared_sstable sst);
+    // Empties the set one element at a time, yielding in between, so that
+    // tearing down a large set doesn't stall the reactor. The set remains
+    // valid (and empty) afterwards. Must not run concurrently with readers
+    // of the set.
+    future<> clear_gently() noexcept;
 
     // Used to incrementally select sstables from sstable set using ring-position.
     // sstable set must be alive during the lifetime of the selector.
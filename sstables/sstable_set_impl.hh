@@ -45,6 +45,9 @@ public:
     virtual void for_each_sstable(std::function<void(const shared_sstable&)> func) const = 0;
     virtual void insert(shared_sstable sst) = 0;
     virtual void erase(shared_sstable sst) = 0;
+    // Empties the set one element at a time, yielding in between, so that
+    // tearing down a large set doesn't stall the reactor.
+    virtual future<> clear_gently() noexcept;
     virtual std::unique_ptr<incremental_selector_impl> make_incremental_selector() const = 0;
 
     virtual flat_mutation_reader create_single_key_sstable_reader(
@@ -69,7 +72,14 @@ class partitioned_sstable_set : public sstable_set_impl {
     using map_iterator = interval_map_type::const_iterator;
 private:
     schema_ptr _schema;
+    // Kept sorted by first key, forming a flattened interval index together
+    // with _unleveled_max_last: _unleveled_max_last[i] is the greatest last
+    // key among _unleveled_sstables[0..i]. A range lookup binary-searches the
+    // first keys and then walks back only while an earlier sstable can still
+    // reach the range start, so selection doesn't degrade to a full copy of
+    // level 0 when it falls behind.
     std::vector<shared_sstable> _unleveled_sstables;
+    std::vector<dht::ring_position> _unleveled_max_last;
     interval_map_type _leveled_sstables;
     lw_shared_ptr<sstable_list> _all;
     std::unordered_map<utils::UUID, sstable_run> _all_runs;
@@ -86,6 +96,11 @@ private:
     std::pair<map_iterator, map_iterator> query(const dht::partition_range& range) const;
     // SSTables are stored separately to avoid interval map's fragmentation issue when level 0 falls behind.
     bool store_as_unleveled(const shared_sstable& sst) const;
+    void insert_unleveled(shared_sstable sst);
+    void erase_unleveled(const shared_sstable& sst);
+    // Recomputes _unleveled_max_last for entries [from, size()).
+    void rebuild_unleveled_max_last(size_t from);
+    std::vector<shared_sstable> select_unleveled(const dht::partition_range& range) const;
 public:
     static dht::ring_position to_ring_position(const compatible_ring_position_or_view& crp);
     static dht::partition_range to_partition_range(const interval_type& i);
@@ -109,6 +124,7 @@ public:
     virtual void for_each_sstable(std::function<void(const shared_sstable&)> func) const override;
     virtual void insert(shared_sstable sst) override;
     virtual void erase(shared_sstable sst) override;
+    virtual future<> clear_gently() noexcept override;
     virtual std::unique_ptr<incremental_selector_impl> make_incremental_selector() const override;
     class incremental_selector;
 };
@@ -134,6 +150,7 @@ public:
     virtual void for_each_sstable(std::function<void(const shared_sstable&)> func) const override;
     virtual void insert(shared_sstable sst) override;
     virtual void erase(shared_sstable sst) override;
+    virtual future<> clear_gently() noexcept override;
     virtual std::unique_ptr<incremental_selector_impl> make_incremental_selector() const override;
 
     std::unique_ptr<position_reader_queue> make_position_reader_queue(
@@ -173,6 +190,7 @@ public:
     virtual void for_each_sstable(std::function<void(const shared_sstable&)> func) const override;
     virtual void insert(shared_sstable sst) override;
     virtual void erase(shared_sstable sst) override;
+    virtual future<> clear_gently() noexcept override;
     virtual std::unique_ptr<incremental_selector_impl> make_incremental_selector() const override;
 
     virtual flat_mutation_reader create_single_key_sstable_reader(
@@ -70,6 +70,7 @@
 #include "utils/memory_data_sink.hh"
 #include "utils/cached_file.hh"
 #include "checked-file-impl.hh"
+#include "component_io_stats.hh"
 #include "integrity_checked_file_impl.hh"
 #include "db/extensions.hh"
 #include "unimplemented.hh"
@@ -151,6 +152,12 @@ future<file> sstable::new_sstable_component_file(const io_error_handler& error_h
         }
     }
 
+    if (readonly) {
+        f = with_file_close_on_failure(std::move(f), [type] (file f) {
+            return make_ready_future<file>(make_component_io_counting_file(type, std::move(f)));
+        });
+    }
+
     f = with_file_close_on_failure(std::move(f), [&error_handler] (file f) {
         return make_checked_file(error_handler, std::move(f));
     });
@@ -524,24 +531,34 @@ future<> parse(const schema& schema, sstable_version_types v, random_access_read
 
     s.entries.reserve(s.header.size);
 
-    int idx = 0;
+    // Read the entries in bulk, a buffer covering many entries at a time.
+    // With one read_exactly() per entry, the per-entry future and temporary
+    // buffer dominate the cost of loading a large summary.
+    constexpr size_t entry_chunk_size = 128 * 1024;
+    size_t idx = 0;
     while (s.entries.size() != s.header.size) {
-        auto pos = s.positions[idx++];
-        auto next = s.positions[idx];
-
-        auto entrysize = next - pos;
-        auto buf = co_await in.read_exactly(entrysize);
-        check_buf_size(buf, entrysize);
-
-        auto keysize = entrysize - 8;
-        auto key_data = s.add_summary_data(bytes_view(reinterpret_cast<const int8_t*>(buf.get()), keysize));
-        buf.trim_front(keysize);
-
-        // position is little-endian encoded
-        auto position = seastar::read_le<uint64_t>(buf.get());
-        auto token = schema.get_partitioner().get_token(key_view(key_data));
-        s.add_summary_data(token.data());
-        s.entries.push_back({ token, key_data, position });
+        auto chunk_start = s.positions[idx];
+        // At least one entry is always read, whatever its size.
+        auto end_idx = idx + 1;
+        while (end_idx < s.header.size && s.positions[end_idx + 1] - chunk_start <= entry_chunk_size) {
+            ++end_idx;
+        }
+        auto chunk_len = s.positions[end_idx] - chunk_start;
+        auto buf = co_await in.read_exactly(chunk_len);
+        check_buf_size(buf, chunk_len);
+
+        for (; idx < end_idx; ++idx) {
+            auto entry_offset = s.positions[idx] - chunk_start;
+            auto entrysize = s.positions[idx + 1] - s.positions[idx];
+            auto keysize = entrysize - 8;
+            auto key_data = s.add_summary_data(bytes_view(reinterpret_cast<const int8_t*>(buf.get() + entry_offset), keysize));
+
+            // position is little-endian encoded
+            auto position = seastar::read_le<uint64_t>(buf.get() + entry_offset + keysize);
+            auto token = schema.get_partitioner().get_token(key_view(key_data));
+            s.entries.push_back({ token, key_data, position });
+            co_await coroutine::maybe_yield();
+        }
     }
     // Delete last element which isn't part of the on-disk format.
     s.positions.pop_back();
@@ -1311,7 +1328,7 @@ future<> sstable::update_info_for_opened_data() {
             assert(!_cached_index_file);
             _cached_index_file = seastar::make_shared<cached_file>(_index_file,
                                                                    index_page_cache_metrics,
-                                                                   _manager.get_cache_tracker().get_lru(),
+                                                                   _manager.get_cache_tracker().get_index_lru(),
                                                                    _manager.get_cache_tracker().region(),
                                                                    _index_file_size);
             _index_file = make_cached_seastar_file(*_cached_index_file);
@@ -1378,6 +1395,11 @@ future<> sstable::read_filter(const io_priority_class& pc) {
         utils::filter_format format = (_version >= sstable_version_types::mc)
                                       ? utils::filter_format::m_format
                                       : utils::filter_format::k_l_format;
+        // Scylla metadata is read before the filter, so the feature flag is
+        // already available here.
+        if (has_scylla_component() && _components->scylla_metadata->has_feature(sstable_feature::BlockedBloomFilter)) {
+            format = utils::filter_format::m_blocked_format;
+        }
         _components->filter = utils::filter::create_filter(filter.hashes, std::move(bs), format);
     });
 }
@@ -1422,8 +1444,8 @@ future<> sstable::load(sstables::foreign_sstable_open_info info) noexcept {
     static_assert(std::is_nothrow_move_constructible_v<sstables::foreign_sstable_open_info>);
     return read_toc().then([this, info = std::move(info)] () mutable {
         _components = std::move(info.components);
-        _data_file = make_checked_file(_read_error_handler, info.data.to_file());
-        _index_file = make_checked_file(_read_error_handler, info.index.to_file());
+        _data_file = make_checked_file(_read_error_handler, make_component_io_counting_file(component_type::Data, info.data.to_file()));
+        _index_file = make_checked_file(_read_error_handler, make_component_io_counting_file(component_type::Index, info.index.to_file()));
         _shards = std::move(info.owners);
         validate_min_max_metadata();
         validate_max_local_deletion_time();
@@ -1561,7 +1583,6 @@ void maybe_add_summary_entry(summary& s, const dht::token& token, bytes_view key
     if (data_offset >= state.next_data_offset_to_write_summary) {
         auto entry_size = 8 + 2 + key.size();  // offset + key_size.size + key.size
         state.next_data_offset_to_write_summary += state.summary_byte_cost * entry_size;
-        s.add_summary_data(token.data());
         auto key_data = s.add_summary_data(key);
         s.entries.push_back({ token, key_data, index_offset });
     }
@@ -2096,6 +2117,17 @@ future<> sstable::move_to_new_dir(sstring new_dir, int64_t new_generation, bool
     });
 }
 
+future<> sstable::move_to_quarantine(bool do_sync_dirs) {
+    if (is_quarantine_dir(fs::path(_dir))) {
+        return make_ready_future<>();
+    }
+    auto quarantine_dir = get_dir() + "/" + quarantine_dir_basename();
+    sstlog.warn("Moving SSTable {} to quarantine in {}", get_filename(), quarantine_dir);
+    return sstable_touch_directory_io_check(quarantine_dir).then([this, quarantine_dir = std::move(quarantine_dir), do_sync_dirs] () mutable {
+        return move_to_new_dir(std::move(quarantine_dir), _generation, do_sync_dirs);
+    });
+}
+
 flat_mutation_reader_v2
 sstable::make_reader(
         schema_ptr schema,
@@ -2278,12 +2310,20 @@ component_type sstable::component_from_sstring(version_types v, sstring &s) {
 }
 
 input_stream<char> sstable::data_stream(uint64_t pos, size_t len, const io_priority_class& pc,
-        reader_permit permit, tracing::trace_state_ptr trace_state, lw_shared_ptr<file_input_stream_history> history) {
+        reader_permit permit, tracing::trace_state_ptr trace_state, lw_shared_ptr<file_input_stream_history> history,
+        stream_profile profile) {
     file_input_stream_options options;
-    options.buffer_size = sstable_buffer_size;
     options.io_priority_class = pc;
-    options.read_ahead = 4;
-    options.dynamic_adjustments = std::move(history);
+    if (profile == stream_profile::scan) {
+        // Two large buffers in flight keep the disk at sequential bandwidth
+        // while the consumer decompresses and parses the previous buffer.
+        options.buffer_size = sstable_buffer_size * 4;
+        options.read_ahead = 2;
+    } else {
+        options.buffer_size = sstable_buffer_size;
+        options.read_ahead = 4;
+        options.dynamic_adjustments = std::move(history);
+    }
 
     file f = make_tracked_file(_data_file, std::move(permit));
     if (trace_state.has_tracing()) {
@@ -3062,7 +3102,7 @@ sstable::sstable(schema_ptr schema,
     , _version(v)
     , _format(f)
     , _index_cache(std::make_unique<partition_index_cache>(
-            manager.get_cache_tracker().get_lru(), manager.get_cache_tracker().region()))
+            manager.get_cache_tracker().get_index_lru(), manager.get_cache_tracker().region()))
     , _now(now)
     , _read_error_handler(error_handler_gen(sstable_read_error))
     , _write_error_handler(error_handler_gen(sstable_write_error))
@@ -121,6 +121,10 @@ struct sstable_writer_config {
     utils::UUID run_identifier = utils::make_random_uuid();
     size_t summary_byte_cost;
     sstring origin;
+    // When set, overrides the schema's compressor for the data file, e.g.
+    // with an instance carrying a dictionary trained by compaction on the
+    // input data. Other compression parameters still come from the schema.
+    compressor_ptr compressor;
 
 private:
     explicit sstable_writer_config() {}
@@ -198,6 +202,12 @@ public:
     future<> set_generation(int64_t generation);
     future<> move_to_new_dir(sstring new_dir, int64_t generation, bool do_sync_dirs = true);
 
+    // Moves the sstable files into the quarantine subdirectory of the current
+    // directory. The in-memory object remains usable, but the sstable won't be
+    // picked up again on the next restart; the files are preserved for manual
+    // inspection or recovery.
+    future<> move_to_quarantine(bool do_sync_dirs = true);
+
     int64_t generation() const {
         return _generation;
     }
@@ -400,6 +410,15 @@ public:
         return dirpath.filename().string() == pending_delete_dir_basename().c_str();
     }
 
+    static sstring quarantine_dir_basename() {
+        return "quarantine";
+    }
+
+    static bool is_quarantine_dir(const fs::path& dirpath)
+    {
+        return dirpath.filename().string() == quarantine_dir_basename().c_str();
+    }
+
     const sstring& get_dir() const {
         return _dir;
     }
@@ -628,6 +647,13 @@ private:
 
     future<> create_data() noexcept;
 
+    // How a data_stream() is going to be consumed. A sequential scan
+    // (compaction, scrub, validation) reads the file front to back, so it
+    // pays off to issue fewer, larger reads and keep the next one in flight
+    // while the previous buffer is parsed; point reads stick to the smaller
+    // buffers and the adaptive read-ahead heuristics.
+    enum class stream_profile { point, scan };
+
     // Return an input_stream which reads exactly the specified byte range
     // from the data file (after uncompression, if the file is compressed).
     // Unlike data_read() below, this method does not read the entire byte
@@ -637,7 +663,8 @@ private:
     // about the buffer size to read, and where exactly to stop reading
     // (even when a large buffer size is used).
     input_stream<char> data_stream(uint64_t pos, size_t len, const io_priority_class& pc,
-            reader_permit permit, tracing::trace_state_ptr trace_state, lw_shared_ptr<file_input_stream_history> history);
+            reader_permit permit, tracing::trace_state_ptr trace_state, lw_shared_ptr<file_input_stream_history> history,
+            stream_profile profile = stream_profile::point);
 
     // Read exactly the specific byte range from the data file (after
     // uncompression, if the file is compressed). This can be used to read
@@ -22,6 +22,7 @@
 #include "log.hh"
 #include "sstables/sstables_manager.hh"
 #include "sstables/partition_index_cache.hh"
+#include "sstables/index_reader.hh"
 #include "sstables/sstables.hh"
 #include "db/config.hh"
 #include "gms/feature.hh"
@@ -34,6 +35,12 @@ logging::logger smlogger("sstables_manager");
 sstables_manager::sstables_manager(
     db::large_data_handler& large_data_handler, const db::config& dbcfg, gms::feature_service& feat, cache_tracker& ct)
     : _large_data_handler(large_data_handler), _db_config(dbcfg), _features(feat), _cache_tracker(ct) {
+    // Let the tracker see how much memory the index eviction domain holds.
+    // The sources are per-shard globals, so re-registration by another
+    // manager instance on the same shard is harmless.
+    _cache_tracker.register_index_bytes_source([] {
+        return partition_index_cache::shard_stats().used_bytes + index_page_cache_metrics.cached_bytes;
+    });
 }
 
 sstables_manager::~sstables_manager() {
@@ -470,7 +470,8 @@ enum sstable_feature : uint8_t {
     CorrectStaticCompact = 3, // See #4139
     CorrectEmptyCounters = 4, // See #4363
     CorrectUDTsInCollections = 5, // See #6130
-    End = 6,
+    BlockedBloomFilter = 6, // Filter.db bits are laid out in cache-line-sized blocks
+    End = 7,
 };
 
 // Scylla-specific features enabled for a particular sstable.
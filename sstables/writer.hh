@@ -260,6 +260,29 @@ inline void write_vint(W& out, T value) {
     return std::is_unsigned_v<T> ? write_unsigned_vint(out, value) : write_signed_vint(out, value);
 }
 
+// Models Writer on top of a fixed-size stack buffer. Row and cell headers
+// are serialized as a run of one-byte flags and vints; staging them here and
+// flushing once pays the destination's per-write bookkeeping once per run
+// instead of once per value. The caller must not write more than Capacity
+// bytes between flushes.
+template <size_t Capacity>
+class vint_batch_writer {
+    std::array<char, Capacity> _buf;
+    size_t _pos = 0;
+public:
+    void write(const char* data, size_t size) {
+        assert(_pos + size <= Capacity);
+        std::copy_n(data, size, _buf.data() + _pos);
+        _pos += size;
+    }
+    template <typename W>
+    requires Writer<W>
+    void flush(W& out) {
+        out.write(_buf.data(), _pos);
+        _pos = 0;
+    }
+};
+
 
 template <std::integral T, Writer W>
 void
@@ -0,0 +1,41 @@
+/*
+ * Copyright (C) 2021-present ScyllaDB
+ */
+
+/*
+ * This file is part of Scylla.
+ *
+ * Scylla is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Scylla is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Scylla.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+namespace streaming {
+
+// Commands sent along sstable component file chunks on the
+// STREAM_SSTABLE_FILES rpc stream. Each message carries the component
+// basename the chunk belongs to, the chunk itself, and one of the commands
+// below.
+enum class stream_files_cmd : uint8_t {
+    error,
+    file_data,
+    // All components of the current sstable have been sent, the receiver
+    // can load it.
+    end_of_sstable,
+    end_of_stream,
+};
+
+}
@@ -38,6 +38,9 @@
 
 #include <seastar/core/distributed.hh>
 #include "gms/gossiper.hh"
+#include "database.hh"
+#include "backlog_controller.hh"
+#include "compaction/compaction_manager.hh"
 #include "streaming/stream_manager.hh"
 #include "streaming/stream_result_future.hh"
 #include "log.hh"
@@ -70,9 +73,40 @@ stream_manager::stream_manager(sharded<database>& db,
 
         sm::make_derive("total_outgoing_bytes", [this] { return _total_outgoing_bytes; },
                         sm::description("Total number of bytes sent on this shard.")),
+
+        sm::make_gauge("receive_pressure", [this] { return stream_receive_pressure(); },
+                        sm::description("Receiver-side streaming pressure in [0, 1], derived from the compaction backlog and dirty memory. Incoming streams are paced when it approaches 1.")),
     });
 }
 
+float stream_manager::stream_receive_pressure() {
+    auto& local_db = db();
+    // The compaction controller saturates at normalization_factor; treat that
+    // point as full pressure. The backlog is infinite when compaction is
+    // disabled (e.g. during an initial rebuild), in which case it must not
+    // slow streaming down.
+    float compaction_pressure = 0;
+    auto backlog = local_db.get_compaction_manager().backlog();
+    if (!compaction_controller::backlog_disabled(backlog)) {
+        compaction_pressure = std::min(float(backlog / compaction_controller::normalization_factor), 1.0f);
+    }
+    auto dirty_pressure = std::min(float(local_db.dirty_memory_pressure()), 1.0f);
+    return std::max(compaction_pressure, dirty_pressure);
+}
+
+std::chrono::milliseconds stream_manager::stream_receive_delay() {
+    // Below the threshold the receiver keeps up on its own. Above it, ramp
+    // the delay linearly up to max_delay so the sender's effective rate
+    // follows the receiver's remaining headroom instead of dropping to zero.
+    constexpr float threshold = 0.75f;
+    constexpr auto max_delay = std::chrono::milliseconds(100);
+    auto pressure = stream_receive_pressure();
+    if (pressure < threshold) {
+        return std::chrono::milliseconds(0);
+    }
+    return std::chrono::milliseconds(int64_t(max_delay.count() * (pressure - threshold) / (1.0f - threshold)));
+}
+
 future<> stream_manager::start() {
     _gossiper.register_(shared_from_this());
     init_messaging_service_handler();
@@ -48,6 +48,7 @@
 #include <seastar/core/semaphore.hh>
 #include <seastar/core/metrics_registration.hh>
 #include <map>
+#include <chrono>
 
 namespace db {
 class system_distributed_keyspace;
@@ -139,6 +140,16 @@ public:
 
     semaphore& mutation_send_limiter() { return _mutation_send_limiter; }
 
+    // Receiver-side streaming pressure in [0, 1], derived from the local
+    // compaction backlog and dirty memory usage.
+    float stream_receive_pressure();
+
+    // Delay to insert before pulling more incoming stream fragments. Zero
+    // while stream_receive_pressure() is below the throttling threshold.
+    // Slowing down consumption fills the bounded rpc stream buffer and paces
+    // the sender, so an overloaded receiver is not pushed further behind.
+    std::chrono::milliseconds stream_receive_delay();
+
     void register_sending(shared_ptr<stream_result_future> result);
 
     void register_receiving(shared_ptr<stream_result_future> result);
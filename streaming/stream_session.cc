@@ -64,7 +64,11 @@
 #include "../db/view/view_update_generator.hh"
 #include "mutation_source_metadata.hh"
 #include "streaming/stream_mutation_fragments_cmd.hh"
+#include "streaming/stream_files_cmd.hh"
+#include "sstables/sstables.hh"
 #include "consumer.hh"
+#include <seastar/core/coroutine.hh>
+#include <seastar/core/fstream.hh>
 
 namespace streaming {
 
@@ -78,6 +82,112 @@ static sstables::offstrategy is_offstrategy_supported(streaming::stream_reason r
     return sstables::offstrategy(operations_supported.contains(reason));
 }
 
+// Receives whole sstable component files for one STREAM_SSTABLE_FILES request
+// and loads every complete sstable into the table. Runs on the shard the rpc
+// connection landed on; the sstables themselves are registered on
+// owner_shard, which - thanks to the sharding compatibility check performed
+// by the caller - is the only shard owning the tokens they contain.
+static future<> receive_sstable_files(sharded<stream_manager>& sm, utils::UUID plan_id, utils::UUID cf_id, unsigned owner_shard,
+        gms::inet_address from, rpc::source<sstring, bytes, rpc::optional<stream_files_cmd>> source) {
+    table& cf = sm.local().db().find_column_family(cf_id);
+    auto upload_dir = cf.dir() + "/upload";
+    co_await touch_directory(upload_dir);
+    std::optional<output_stream<char>> out;
+    sstring current_name;
+    std::optional<sstables::entry_descriptor> current_desc;
+    int64_t generation = 0;
+    std::vector<sstring> written;
+    bool got_end_of_stream = false;
+    std::exception_ptr ex;
+    try {
+        while (auto opt = co_await source()) {
+            auto& [name, chunk, cmd_opt] = *opt;
+            if (!cmd_opt) {
+                throw std::runtime_error("Sender did not send stream_files_cmd");
+            }
+            switch (*cmd_opt) {
+            case stream_files_cmd::file_data:
+                if (name != current_name) {
+                    if (out) {
+                        co_await out->close();
+                        out.reset();
+                    }
+                    auto desc = sstables::entry_descriptor::make_descriptor(upload_dir, name, cf.schema()->ks_name(), cf.schema()->cf_name());
+                    if (!current_desc) {
+                        // First component of a new sstable: allocate its
+                        // generation on the owning shard to keep generations
+                        // properly striped across shards.
+                        generation = co_await sm.invoke_on(owner_shard, [cf_id] (stream_manager& sm) {
+                            return int64_t(sm.db().find_column_family(cf_id).calculate_generation_for_new_table());
+                        });
+                    }
+                    current_desc = desc;
+                    current_name = name;
+                    auto path = sstables::sstable::filename(upload_dir, desc.ks, desc.cf, desc.version, generation, desc.format, desc.component);
+                    auto f = co_await open_file_dma(path, open_flags::wo | open_flags::create | open_flags::truncate);
+                    out = co_await make_file_output_stream(std::move(f));
+                    written.push_back(std::move(path));
+                }
+                co_await out->write(reinterpret_cast<const char*>(chunk.data()), chunk.size());
+                sm.local().update_progress(plan_id, from, progress_info::direction::IN, chunk.size());
+                break;
+            case stream_files_cmd::end_of_sstable: {
+                if (!current_desc) {
+                    throw std::runtime_error("Sender sent end_of_sstable without any component");
+                }
+                if (out) {
+                    co_await out->close();
+                    out.reset();
+                }
+                auto version = current_desc->version;
+                auto format = current_desc->format;
+                co_await sm.invoke_on(owner_shard, [cf_id, upload_dir, generation, version, format] (stream_manager& sm) -> future<> {
+                    table& cf = sm.db().find_column_family(cf_id);
+                    auto sst = cf.make_sstable(upload_dir, generation, version, format);
+                    co_await sst->load();
+                    co_await sst->move_to_new_dir(cf.dir(), generation, true);
+                    // It may overlap with existing sstables on higher levels.
+                    sst->set_sstable_level(0);
+                    co_await cf.add_sstable_and_update_cache(sst);
+                });
+                sslog.info("[Stream #{}] Loaded sstable received as files for ks={}, cf={}, generation={}",
+                        plan_id, cf.schema()->ks_name(), cf.schema()->cf_name(), generation);
+                current_desc.reset();
+                current_name = {};
+                written.clear();
+                break;
+            }
+            case stream_files_cmd::end_of_stream:
+                got_end_of_stream = true;
+                break;
+            case stream_files_cmd::error:
+                throw std::runtime_error("Sender failed to stream sstable files");
+            default:
+                throw std::runtime_error("Sender sent wrong stream_files_cmd");
+            }
+        }
+        if (!got_end_of_stream) {
+            throw std::runtime_error("Sender did not send end_of_stream");
+        }
+    } catch (...) {
+        ex = std::current_exception();
+    }
+    if (out) {
+        co_await out->close();
+    }
+    if (ex) {
+        // Remove the partially received components of the current sstable.
+        for (auto& path : written) {
+            try {
+                co_await remove_file(path);
+            } catch (...) {
+                sslog.warn("[Stream #{}] Failed to remove partially received {}: {}", plan_id, path, std::current_exception());
+            }
+        }
+        std::rethrow_exception(ex);
+    }
+}
+
 void stream_manager::init_messaging_service_handler() {
     auto& ms = _ms.local();
 
@@ -121,7 +231,21 @@ void stream_manager::init_messaging_service_handler() {
                 bool got_end_of_stream = false;
             };
             auto cmd_status = make_lw_shared<stream_mutation_fragments_cmd_status>();
-            auto get_next_mutation_fragment = [&sm = container(), source, plan_id, from, s, cmd_status, permit] () mutable {
+            auto get_next_mutation_fragment = [&sm = container(), source, plan_id, from, s, cmd_status, permit, nr_received = uint64_t(0)] () mutable {
+                // Check the local pressure periodically and slow down the
+                // consumption when the compaction backlog or dirty memory
+                // grows. The rpc stream buffer is bounded, so pausing here
+                // propagates to the sender and paces the whole session.
+                auto pace = make_ready_future<>();
+                if (++nr_received % 1024 == 0) {
+                    auto delay = sm.local().stream_receive_delay();
+                    if (delay.count()) {
+                        sslog.debug("[Stream #{}] Pacing incoming stream from {} by {} ms, receive_pressure={}",
+                                plan_id, from.addr, delay.count(), sm.local().stream_receive_pressure());
+                        pace = seastar::sleep(delay);
+                    }
+                }
+                return pace.then([&sm, source, plan_id, from, s, cmd_status, permit] () mutable {
                 return source().then([&sm, plan_id, from, s, cmd_status, permit] (std::optional<std::tuple<frozen_mutation_fragment, rpc::optional<stream_mutation_fragments_cmd>>> opt) mutable {
                     if (opt) {
                         auto cmd = std::get<1>(*opt);
@@ -154,6 +278,7 @@ void stream_manager::init_messaging_service_handler() {
                         return make_ready_future<mutation_fragment_opt>();
                     }
                 });
+                });
             };
             //FIXME: discarded future.
             (void)mutation_writer::distribute_reader_and_consume_on_shards(s,
@@ -185,6 +310,57 @@ void stream_manager::init_messaging_service_handler() {
         });
       });
     });
+    ms.register_stream_sstable_files([this] (const rpc::client_info& cinfo, UUID plan_id, UUID cf_id, unsigned sender_shard, unsigned sender_shard_count, unsigned sender_ignore_msb, stream_reason reason, rpc::source<sstring, bytes, rpc::optional<stream_files_cmd>> source) {
+        auto from = netw::messaging_service::get_source(cinfo);
+        auto sink = _ms.local().make_sink_for_stream_sstable_files(source);
+        table& cf = _db.local().find_column_family(cf_id);
+        const auto& sharder = cf.schema()->get_sharder();
+        // Received sstables are loaded verbatim, so every token they contain
+        // must map to the same shard here as on the sender, and nothing may
+        // depend on the receiver-side write path (view updates are checked by
+        // the sender, but guard here as well in case the schemas diverged).
+        bool acceptable = sharder.shard_count() == sender_shard_count
+                && sharder.sharding_ignore_msb() == sender_ignore_msb
+                && sender_shard < sender_shard_count
+                && cf.views().empty();
+        sslog.info("[Stream #{}] Got stream_sstable_files from {} for ks={}, cf={}, reason={}, acceptable={}",
+                plan_id, from.addr, cf.schema()->ks_name(), cf.schema()->cf_name(), reason, acceptable);
+        auto drain = [source] () mutable {
+            return repeat([source] () mutable {
+                return source().then([] (std::optional<std::tuple<sstring, bytes, rpc::optional<stream_files_cmd>>> opt) {
+                    return opt ? stop_iteration::no : stop_iteration::yes;
+                });
+            });
+        };
+        if (!acceptable) {
+            //FIXME: discarded future.
+            (void)sink(-2).then(drain).finally([sink] () mutable {
+                return sink.close();
+            }).handle_exception([plan_id, from] (std::exception_ptr ep) {
+                sslog.error("[Stream #{}] Failed to reject sstable files from {}: {}", plan_id, from.addr, ep);
+            });
+            return make_ready_future<rpc::sink<int32_t>>(sink);
+        }
+        //FIXME: discarded future.
+        (void)sink(0).then([this, plan_id, cf_id, sender_shard, from, source] () mutable {
+            return receive_sstable_files(container(), plan_id, cf_id, sender_shard, from.addr, std::move(source));
+        }).then_wrapped([plan_id, from, sink, drain] (future<> f) mutable {
+            int32_t status = 0;
+            if (f.failed()) {
+                sslog.error("[Stream #{}] Failed to receive sstable files from {}: {}", plan_id, from.addr, f.get_exception());
+                status = -1;
+            }
+            // Send the final status, then drain the source until end-of-stream
+            // so the rpc stream can be destroyed; the sender stops sending
+            // once it has seen a failure status.
+            return sink(status).then(std::move(drain)).finally([sink] () mutable {
+                return sink.close();
+            });
+        }).handle_exception([plan_id, from] (std::exception_ptr ep) {
+            sslog.error("[Stream #{}] Failed to respond on sstable files stream to {}: {}", plan_id, from.addr, ep);
+        });
+        return make_ready_future<rpc::sink<int32_t>>(sink);
+    });
     ms.register_stream_mutation_done([this] (const rpc::client_info& cinfo, UUID plan_id, dht::token_range_vector ranges, UUID cf_id, unsigned dst_cpu_id) {
         const auto& from = cinfo.retrieve_auxiliary<gms::inet_address>("baddr");
         return container().invoke_on(dst_cpu_id, [ranges = std::move(ranges), plan_id, cf_id, from] (auto& sm) mutable {
@@ -215,6 +391,7 @@ future<> stream_manager::uninit_messaging_service_handler() {
         ms.unregister_prepare_message(),
         ms.unregister_prepare_done_message(),
         ms.unregister_stream_mutation_fragments(),
+        ms.unregister_stream_sstable_files(),
         ms.unregister_stream_mutation_done(),
         ms.unregister_complete_message()).discard_result();
 }
@@ -43,6 +43,7 @@
 #include "streaming/stream_manager.hh"
 #include "streaming/stream_reason.hh"
 #include "streaming/stream_mutation_fragments_cmd.hh"
+#include "streaming/stream_files_cmd.hh"
 #include "mutation_reader.hh"
 #include "flat_mutation_reader.hh"
 #include "mutation_fragment_stream_validator.hh"
@@ -58,7 +59,11 @@
 #include <boost/icl/interval_set.hpp>
 #include "sstables/sstables.hh"
 #include "database.hh"
+#include "db/config.hh"
+#include "cdc/cdc_options.hh"
 #include "gms/feature_service.hh"
+#include <seastar/core/coroutine.hh>
+#include <seastar/core/fstream.hh>
 
 namespace streaming {
 
@@ -89,7 +94,8 @@ struct send_info {
     noncopyable_function<void(size_t)> update;
     send_info(netw::messaging_service& ms_, utils::UUID plan_id_, table& tbl_, reader_permit permit_,
               dht::token_range_vector ranges_, netw::messaging_service::msg_addr id_,
-              uint32_t dst_cpu_id_, stream_reason reason_, noncopyable_function<void(size_t)> update_fn)
+              uint32_t dst_cpu_id_, stream_reason reason_, sstables::sstable_list excluded_,
+              noncopyable_function<void(size_t)> update_fn)
         : ms(ms_)
         , plan_id(plan_id_)
         , cf_id(tbl_.schema()->id())
@@ -99,7 +105,8 @@ struct send_info {
         , cf(tbl_)
         , ranges(std::move(ranges_))
         , prs(dht::to_partition_ranges(ranges))
-        , reader(cf.make_streaming_reader(cf.schema(), std::move(permit_), prs))
+        , reader(excluded_.empty() ? cf.make_streaming_reader(cf.schema(), std::move(permit_), prs)
+                                   : cf.make_streaming_reader(cf.schema(), std::move(permit_), prs, std::move(excluded_)))
         , update(std::move(update_fn))
     {
     }
@@ -214,6 +221,172 @@ future<> send_mutation_fragments(lw_shared_ptr<send_info> si) {
  });
 }
 
+static bool can_stream_sstable_files(stream_manager& sm, table& cf, stream_reason reason) {
+    if (!sm.db().get_config().enable_file_based_streaming()) {
+        return false;
+    }
+    if (!sm.db().features().cluster_supports_file_based_streaming()) {
+        return false;
+    }
+    // Only whole-range movements onto a new owner can take sstables verbatim.
+    if (reason != stream_reason::bootstrap && reason != stream_reason::rebuild && reason != stream_reason::replace) {
+        return false;
+    }
+    // View updates and CDC log entries are generated on the receiver's write
+    // path, which file transfer bypasses.
+    if (!cf.views().empty() || cf.schema()->cdc_options().enabled()) {
+        return false;
+    }
+    return true;
+}
+
+// An sstable can be transferred verbatim only if every partition in it lies
+// within the transferred ranges; otherwise the receiver would acquire data it
+// does not own.
+static std::vector<sstables::shared_sstable> file_streamable_sstables(table& cf, const dht::token_range_vector& ranges) {
+    std::vector<sstables::shared_sstable> ssts;
+    for (auto& sst : *cf.get_sstables()) {
+        auto sst_range = dht::token_range::make(sst->get_first_decorated_key().token(), sst->get_last_decorated_key().token());
+        auto contained = boost::algorithm::any_of(ranges, [&sst_range] (const dht::token_range& range) {
+            return range.contains(sst_range, dht::token_comparator());
+        });
+        if (!contained) {
+            continue;
+        }
+        auto components = sst->all_components();
+        auto recognized = std::all_of(components.begin(), components.end(), [] (const std::pair<sstables::component_type, sstring>& c) {
+            return c.first != sstables::component_type::Unknown;
+        });
+        if (recognized) {
+            ssts.push_back(sst);
+        }
+    }
+    return ssts;
+}
+
+// Transfers the given sstables as whole component files. Returns true if the
+// receiver accepted and loaded them, false if it asked for the mutation-based
+// fallback.
+static future<bool> send_sstable_files(stream_manager& sm, table& cf, std::vector<sstables::shared_sstable> ssts,
+        utils::UUID plan_id, netw::messaging_service::msg_addr id, stream_reason reason) {
+    auto& sharder = cf.schema()->get_sharder();
+    auto [sink, source] = co_await sm.ms().make_sink_and_source_for_stream_sstable_files(
+            plan_id, cf.schema()->id(), this_shard_id(), sharder.shard_count(), sharder.sharding_ignore_msb(), reason, id);
+    bool accepted = false;
+    std::exception_ptr ex;
+    std::optional<future<>> source_op;
+    auto got_error_from_peer = make_lw_shared<bool>(false);
+    try {
+        auto status_opt = co_await source();
+        if (!status_opt) {
+            throw std::runtime_error(format("Peer {} closed the sstable files stream before acknowledging it", id.addr));
+        }
+        auto status = std::get<0>(*status_opt);
+        if (status == 0) {
+            accepted = true;
+            // Watch for an early failure status so an aborting receiver does
+            // not leave us blocked on a full sink.
+            source_op = repeat([source, got_error_from_peer] () mutable {
+                return source().then([got_error_from_peer] (std::optional<std::tuple<int32_t>> status_opt) {
+                    if (status_opt) {
+                        if (std::get<0>(*status_opt) != 0) {
+                            *got_error_from_peer = true;
+                        }
+                        return stop_iteration::no;
+                    }
+                    return stop_iteration::yes;
+                });
+            });
+            for (auto& sst : ssts) {
+                for (auto& [type, name] : sst->all_components()) {
+                    auto basename = sstables::sstable::component_basename(cf.schema()->ks_name(), cf.schema()->cf_name(),
+                            sst->get_version(), sst->generation(), sstables::sstable_format_types::big, type);
+                    auto f = co_await open_file_dma(sst->filename(type), open_flags::ro);
+                    auto size = co_await f.size();
+                    auto in = make_file_input_stream(std::move(f));
+                    std::exception_ptr read_ex;
+                    try {
+                        if (size == 0) {
+                            // Make sure even empty components exist on the receiver.
+                            co_await sink(basename, bytes(), stream_files_cmd::file_data);
+                        }
+                        while (true) {
+                            auto buf = co_await in.read_up_to(128 * 1024);
+                            if (buf.empty()) {
+                                break;
+                            }
+                            if (*got_error_from_peer) {
+                                throw std::runtime_error(format("Peer {} failed to process sstable files", id.addr));
+                            }
+                            sm.update_progress(plan_id, id.addr, progress_info::direction::OUT, buf.size());
+                            co_await sink(basename, bytes(reinterpret_cast<const int8_t*>(buf.get()), buf.size()), stream_files_cmd::file_data);
+                        }
+                    } catch (...) {
+                        read_ex = std::current_exception();
+                    }
+                    co_await in.close();
+                    if (read_ex) {
+                        std::rethrow_exception(read_ex);
+                    }
+                }
+                co_await sink(sstring(), bytes(), stream_files_cmd::end_of_sstable);
+                sslog.info("[Stream #{}] Sent sstable {} as files to {}", plan_id, sst->get_filename(), id.addr);
+            }
+            co_await sink(sstring(), bytes(), stream_files_cmd::end_of_stream);
+        } else if (status != -2) {
+            throw std::runtime_error(format("Unexpected status code {} from peer {} on sstable files stream", status, id.addr));
+        }
+    } catch (...) {
+        ex = std::current_exception();
+    }
+    if (ex) {
+        try {
+            co_await sink(sstring(), bytes(), stream_files_cmd::error);
+        } catch (...) {
+        }
+    }
+    co_await sink.close();
+    if (source_op) {
+        co_await std::move(*source_op);
+    } else {
+        // Fallback path: drain the source so the rpc stream can be destroyed.
+        while (co_await source()) {
+        }
+    }
+    if (!ex && *got_error_from_peer) {
+        ex = std::make_exception_ptr(std::runtime_error(format("Peer {} failed to process sstable files, plan_id={}", id.addr, plan_id)));
+    }
+    if (ex) {
+        std::rethrow_exception(ex);
+    }
+    co_return accepted;
+}
+
+// Runs the file-based phase if it applies. Returns the sstables that were
+// transferred as files, so that the mutation-based phase can skip them.
+static future<sstables::sstable_list> maybe_send_sstable_files(stream_manager& sm, table& cf, dht::token_range_vector ranges,
+        utils::UUID plan_id, netw::messaging_service::msg_addr id, stream_reason reason) {
+    if (!can_stream_sstable_files(sm, cf, reason)) {
+        co_return sstables::sstable_list();
+    }
+    auto candidates = file_streamable_sstables(cf, ranges);
+    if (candidates.empty()) {
+        co_return sstables::sstable_list();
+    }
+    uint64_t total_size = 0;
+    for (auto& sst : candidates) {
+        total_size += sst->bytes_on_disk();
+    }
+    sslog.info("[Stream #{}] Sending {} sstables ({} bytes) as files for ks={}, cf={} to {}",
+            plan_id, candidates.size(), total_size, cf.schema()->ks_name(), cf.schema()->cf_name(), id.addr);
+    if (!co_await send_sstable_files(sm, cf, candidates, plan_id, id, reason)) {
+        sslog.info("[Stream #{}] Peer {} cannot load sstable files for ks={}, cf={}, using mutation-based streaming",
+                plan_id, id.addr, cf.schema()->ks_name(), cf.schema()->cf_name());
+        co_return sstables::sstable_list();
+    }
+    co_return sstables::sstable_list(candidates.begin(), candidates.end());
+}
+
 future<> stream_transfer_task::execute() {
     auto plan_id = session->plan_id();
     auto cf_id = this->cf_id;
@@ -226,18 +399,21 @@ future<> stream_transfer_task::execute() {
     return sm.container().invoke_on_all([plan_id, cf_id, id, dst_cpu_id, ranges=this->_ranges, reason] (stream_manager& sm) mutable {
         auto& tbl = sm.db().find_column_family(cf_id);
       return sm.db().obtain_reader_permit(tbl, "stream-transfer-task", db::no_timeout).then([&sm, &tbl, plan_id, cf_id, id, dst_cpu_id, ranges=std::move(ranges), reason] (reader_permit permit) mutable {
-        auto si = make_lw_shared<send_info>(sm.ms(), plan_id, tbl, std::move(permit), std::move(ranges), id, dst_cpu_id, reason, [&sm, plan_id, addr = id.addr] (size_t sz) {
+        return maybe_send_sstable_files(sm, tbl, ranges, plan_id, id, reason).then(
+                [&sm, &tbl, plan_id, cf_id, id, dst_cpu_id, ranges = std::move(ranges), reason, permit = std::move(permit)] (sstables::sstable_list excluded) mutable {
+          auto si = make_lw_shared<send_info>(sm.ms(), plan_id, tbl, std::move(permit), std::move(ranges), id, dst_cpu_id, reason, std::move(excluded), [&sm, plan_id, addr = id.addr] (size_t sz) {
             sm.update_progress(plan_id, addr, streaming::progress_info::direction::OUT, sz);
-        });
-        return si->has_relevant_range_on_this_shard().then([si, plan_id, cf_id] (bool has_relevant_range_on_this_shard) {
+          });
+          return si->has_relevant_range_on_this_shard().then([si, plan_id, cf_id] (bool has_relevant_range_on_this_shard) {
             if (!has_relevant_range_on_this_shard) {
                 sslog.debug("[Stream #{}] stream_transfer_task: cf_id={}: ignore ranges on shard={}",
                         plan_id, cf_id, this_shard_id());
                 return make_ready_future<>();
             }
             return send_mutation_fragments(std::move(si));
-        }).finally([si] {
+          }).finally([si] {
             return si->reader.close();
+          });
         });
       });
     }).then([this, plan_id, cf_id, id, &sm] {
@@ -46,6 +46,7 @@
 #include <boost/range/adaptor/map.hpp>
 #include "utils/error_injection.hh"
 #include "utils/histogram_metrics_helper.hh"
+#include "utils/stall_free.hh"
 #include "utils/fb_utilities.hh"
 #include "mutation_source_metadata.hh"
 #include "gms/gossiper.hh"
@@ -266,6 +267,37 @@ flat_mutation_reader table::make_streaming_reader(schema_ptr schema, reader_perm
             std::move(trace_state), fwd, fwd_mr);
 }
 
+flat_mutation_reader
+table::make_streaming_reader(schema_ptr s, reader_permit permit,
+                           const dht::partition_range_vector& ranges,
+                           sstables::sstable_list excluded) const {
+    auto& slice = s->full_slice();
+    auto& pc = service::get_local_streaming_priority();
+
+    auto source = mutation_source([this, excluded = std::move(excluded)] (schema_ptr s, reader_permit permit, const dht::partition_range& range, const query::partition_slice& slice,
+                                      const io_priority_class& pc, tracing::trace_state_ptr trace_state, streamed_mutation::forwarding fwd, mutation_reader::forwarding fwd_mr) {
+        std::vector<flat_mutation_reader> readers;
+        readers.reserve(_memtables->size() + 1);
+        for (auto&& mt : *_memtables) {
+            readers.emplace_back(mt->make_flat_reader(s, permit, range, slice, pc, trace_state, fwd, fwd_mr));
+        }
+        // Filter against the live sstable list on every range, so that
+        // sstables flushed while earlier ranges were being streamed are
+        // still read, just like with the unfiltered overload above.
+        auto filtered = make_lw_shared<sstables::sstable_list>();
+        for (auto& sst : *_sstables->all()) {
+            if (!excluded.contains(sst)) {
+                filtered->insert(sst);
+            }
+        }
+        auto set = make_lw_shared<sstables::sstable_set>(sstables::make_partitioned_sstable_set(s, std::move(filtered)));
+        readers.emplace_back(set->make_range_sstable_reader(s, permit, range, slice, pc, std::move(trace_state), fwd, fwd_mr));
+        return make_combined_reader(s, std::move(permit), std::move(readers), fwd, fwd_mr);
+    });
+
+    return make_flat_multi_range_reader(s, std::move(permit), std::move(source), ranges, slice, pc, nullptr, mutation_reader::forwarding::no);
+}
+
 future<std::vector<locked_cell>> table::lock_counter_cells(const mutation& m, db::timeout_clock::time_point timeout) {
     assert(m.schema() == _counter_cell_locks->schema());
     return _counter_cell_locks->lock_cells(m.decorated_key(), partition_cells_range(m.partition()), timeout);
@@ -452,7 +484,7 @@ table::update_cache(lw_shared_ptr<memtable> m, std::vector<sstables::shared_ssta
         try_trigger_compaction();
     });
     if (cache_enabled()) {
-        co_return co_await _cache.update(std::move(adder), *m);
+        co_return co_await _cache.update(std::move(adder), *m, _config.cache_update_concurrency);
     } else {
         co_return co_await _cache.invalidate(std::move(adder)).then([m] { return m->clear_gently(); });
     }
@@ -711,58 +743,79 @@ table::stop() {
     });
 }
 
+// Slots for the capped per-table latency histograms (see
+// config::latency_metrics_table_limit), taken in table creation order on
+// each shard and returned when the table is destroyed, e.g. on drop.
+static thread_local unsigned latency_metrics_slots_in_use = 0;
+
 void table::set_metrics() {
     auto cf = column_family_label(_schema->cf_name());
     auto ks = keyspace_label(_schema->ks_name());
     namespace ms = seastar::metrics;
-    if (_config.enable_metrics_reporting) {
-        _metrics.add_group("column_family", {
-                ms::make_derive("memtable_switch", ms::description("Number of times flush has resulted in the memtable being switched out"), _stats.memtable_switch_count)(cf)(ks),
-                ms::make_counter("memtable_partition_writes", [this] () { return _stats.memtable_partition_insertions + _stats.memtable_partition_hits; }, ms::description("Number of write operations performed on partitions in memtables"))(cf)(ks),
-                ms::make_counter("memtable_partition_hits", _stats.memtable_partition_hits, ms::description("Number of times a write operation was issued on an existing partition in memtables"))(cf)(ks),
-                ms::make_counter("memtable_row_writes", _stats.memtable_app_stats.row_writes, ms::description("Number of row writes performed in memtables"))(cf)(ks),
-                ms::make_counter("memtable_row_hits", _stats.memtable_app_stats.row_hits, ms::description("Number of rows overwritten by write operations in memtables"))(cf)(ks),
-                ms::make_counter("memtable_range_tombstone_reads", _stats.memtable_range_tombstone_reads, ms::description("Number of range tombstones read from memtables"))(cf)(ks),
-                ms::make_counter("memtable_row_tombstone_reads", _stats.memtable_row_tombstone_reads, ms::description("Number of row tombstones read from memtables"))(cf)(ks),
-                ms::make_gauge("pending_tasks", ms::description("Estimated number of tasks pending for this column family"), _stats.pending_flushes)(cf)(ks),
-                ms::make_gauge("live_disk_space", ms::description("Live disk space used"), _stats.live_disk_space_used)(cf)(ks),
-                ms::make_gauge("total_disk_space", ms::description("Total disk space used"), _stats.total_disk_space_used)(cf)(ks),
-                ms::make_gauge("live_sstable", ms::description("Live sstable count"), _stats.live_sstable_count)(cf)(ks),
-                ms::make_gauge("pending_compaction", ms::description("Estimated number of compactions pending for this column family"), _stats.pending_compactions)(cf)(ks),
-                ms::make_gauge("pending_sstable_deletions",
-                        ms::description("Number of tasks waiting to delete sstables from a table"),
-                        [this] { return _sstable_deletion_sem.waiters(); })(cf)(ks)
-        });
-
-        // Metrics related to row locking
-        auto add_row_lock_metrics = [this, ks, cf] (row_locker::single_lock_stats& stats, sstring stat_name) {
-            _metrics.add_group("column_family", {
-                ms::make_total_operations(format("row_lock_{}_acquisitions", stat_name), stats.lock_acquisitions, ms::description(format("Row lock acquisitions for {} lock", stat_name)))(cf)(ks),
-                ms::make_queue_length(format("row_lock_{}_operations_currently_waiting_for_lock", stat_name), stats.operations_currently_waiting_for_lock, ms::description(format("Operations currently waiting for {} lock", stat_name)))(cf)(ks),
-                ms::make_histogram(format("row_lock_{}_waiting_time", stat_name), ms::description(format("Histogram representing time that operations spent on waiting for {} lock", stat_name)),
-                        [&stats] {return to_metrics_histogram(stats.estimated_waiting_for_lock);})(cf)(ks)
-            });
-        };
-        add_row_lock_metrics(_row_locker_stats.exclusive_row, "exclusive_row");
-        add_row_lock_metrics(_row_locker_stats.shared_row, "shared_row");
-        add_row_lock_metrics(_row_locker_stats.exclusive_partition, "exclusive_partition");
-        add_row_lock_metrics(_row_locker_stats.shared_partition, "shared_partition");
-
-        // View metrics are created only for base tables, so there's no point in adding them to views (which cannot act as base tables for other views)
-        if (!_schema->is_view()) {
-            _view_stats.register_stats();
-        }
-
-        if (_schema->ks_name() != db::system_keyspace::NAME && _schema->ks_name() != db::schema_tables::v3::NAME && _schema->ks_name() != "system_traces") {
+    auto is_internal_keyspace = _schema->ks_name() == db::system_keyspace::NAME
+            || _schema->ks_name() == db::schema_tables::v3::NAME
+            || _schema->ks_name() == "system_traces";
+    if (!_config.enable_metrics_reporting) {
+        // Replica-side latency visibility without the full per-table metric
+        // set: export only the read/write histograms, for a bounded number
+        // of user tables, so metric cardinality stays capped on nodes with
+        // many tables. The histograms themselves are recorded regardless.
+        if (!is_internal_keyspace && latency_metrics_slots_in_use < _config.latency_metrics_table_limit) {
+            ++latency_metrics_slots_in_use;
+            _uses_latency_metrics_slot = true;
             _metrics.add_group("column_family", {
                     ms::make_histogram("read_latency", ms::description("Read latency histogram"), [this] {return to_metrics_histogram(_stats.estimated_read);})(cf)(ks),
                     ms::make_histogram("write_latency", ms::description("Write latency histogram"), [this] {return to_metrics_histogram(_stats.estimated_write);})(cf)(ks),
-                    ms::make_histogram("cas_prepare_latency", ms::description("CAS prepare round latency histogram"), [this] {return to_metrics_histogram(_stats.estimated_cas_prepare);})(cf)(ks),
-                    ms::make_histogram("cas_propose_latency", ms::description("CAS accept round latency histogram"), [this] {return to_metrics_histogram(_stats.estimated_cas_accept);})(cf)(ks),
-                    ms::make_histogram("cas_commit_latency", ms::description("CAS learn round latency histogram"), [this] {return to_metrics_histogram(_stats.estimated_cas_learn);})(cf)(ks),
-                    ms::make_gauge("cache_hit_rate", ms::description("Cache hit rate"), [this] {return float(_global_cache_hit_rate);})(cf)(ks)
             });
         }
+        return;
+    }
+    _metrics.add_group("column_family", {
+            ms::make_derive("memtable_switch", ms::description("Number of times flush has resulted in the memtable being switched out"), _stats.memtable_switch_count)(cf)(ks),
+            ms::make_counter("memtable_partition_writes", [this] () { return _stats.memtable_partition_insertions + _stats.memtable_partition_hits; }, ms::description("Number of write operations performed on partitions in memtables"))(cf)(ks),
+            ms::make_counter("memtable_partition_hits", _stats.memtable_partition_hits, ms::description("Number of times a write operation was issued on an existing partition in memtables"))(cf)(ks),
+            ms::make_counter("memtable_row_writes", _stats.memtable_app_stats.row_writes, ms::description("Number of row writes performed in memtables"))(cf)(ks),
+            ms::make_counter("memtable_row_hits", _stats.memtable_app_stats.row_hits, ms::description("Number of rows overwritten by write operations in memtables"))(cf)(ks),
+            ms::make_counter("memtable_range_tombstone_reads", _stats.memtable_range_tombstone_reads, ms::description("Number of range tombstones read from memtables"))(cf)(ks),
+            ms::make_counter("memtable_row_tombstone_reads", _stats.memtable_row_tombstone_reads, ms::description("Number of row tombstones read from memtables"))(cf)(ks),
+            ms::make_gauge("pending_tasks", ms::description("Estimated number of tasks pending for this column family"), _stats.pending_flushes)(cf)(ks),
+            ms::make_gauge("live_disk_space", ms::description("Live disk space used"), _stats.live_disk_space_used)(cf)(ks),
+            ms::make_gauge("total_disk_space", ms::description("Total disk space used"), _stats.total_disk_space_used)(cf)(ks),
+            ms::make_gauge("live_sstable", ms::description("Live sstable count"), _stats.live_sstable_count)(cf)(ks),
+            ms::make_gauge("pending_compaction", ms::description("Estimated number of compactions pending for this column family"), _stats.pending_compactions)(cf)(ks),
+            ms::make_gauge("pending_sstable_deletions",
+                    ms::description("Number of tasks waiting to delete sstables from a table"),
+                    [this] { return _sstable_deletion_sem.waiters(); })(cf)(ks)
+    });
+
+    // Metrics related to row locking
+    auto add_row_lock_metrics = [this, ks, cf] (row_locker::single_lock_stats& stats, sstring stat_name) {
+        _metrics.add_group("column_family", {
+            ms::make_total_operations(format("row_lock_{}_acquisitions", stat_name), stats.lock_acquisitions, ms::description(format("Row lock acquisitions for {} lock", stat_name)))(cf)(ks),
+            ms::make_queue_length(format("row_lock_{}_operations_currently_waiting_for_lock", stat_name), stats.operations_currently_waiting_for_lock, ms::description(format("Operations currently waiting for {} lock", stat_name)))(cf)(ks),
+            ms::make_histogram(format("row_lock_{}_waiting_time", stat_name), ms::description(format("Histogram representing time that operations spent on waiting for {} lock", stat_name)),
+                    [&stats] {return to_metrics_histogram(stats.estimated_waiting_for_lock);})(cf)(ks)
+        });
+    };
+    add_row_lock_metrics(_row_locker_stats.exclusive_row, "exclusive_row");
+    add_row_lock_metrics(_row_locker_stats.shared_row, "shared_row");
+    add_row_lock_metrics(_row_locker_stats.exclusive_partition, "exclusive_partition");
+    add_row_lock_metrics(_row_locker_stats.shared_partition, "shared_partition");
+
+    // View metrics are created only for base tables, so there's no point in adding them to views (which cannot act as base tables for other views)
+    if (!_schema->is_view()) {
+        _view_stats.register_stats();
+    }
+
+    if (!is_internal_keyspace) {
+        _metrics.add_group("column_family", {
+                ms::make_histogram("read_latency", ms::description("Read latency histogram"), [this] {return to_metrics_histogram(_stats.estimated_read);})(cf)(ks),
+                ms::make_histogram("write_latency", ms::description("Write latency histogram"), [this] {return to_metrics_histogram(_stats.estimated_write);})(cf)(ks),
+                ms::make_histogram("cas_prepare_latency", ms::description("CAS prepare round latency histogram"), [this] {return to_metrics_histogram(_stats.estimated_cas_prepare);})(cf)(ks),
+                ms::make_histogram("cas_propose_latency", ms::description("CAS accept round latency histogram"), [this] {return to_metrics_histogram(_stats.estimated_cas_accept);})(cf)(ks),
+                ms::make_histogram("cas_commit_latency", ms::description("CAS learn round latency histogram"), [this] {return to_metrics_histogram(_stats.estimated_cas_learn);})(cf)(ks),
+                ms::make_gauge("cache_hit_rate", ms::description("Cache hit rate"), [this] {return float(_global_cache_hit_rate);})(cf)(ks)
+        });
     }
 }
 
@@ -834,6 +887,8 @@ table::update_sstable_lists_on_off_strategy_completion(const std::vector<sstable
     };
     auto permit = co_await seastar::get_units(_sstable_set_mutation_sem, 1);
     auto updater = row_cache::external_updater(sstable_lists_updater::make(*this, std::move(permit), old_maintenance_sstables, new_main_sstables));
+    auto old_main_list = _main_sstables;
+    auto old_maintenance_list = _maintenance_sstables;
 
     // row_cache::invalidate() is only used to synchronize sstable list updates, to prevent race conditions from occurring,
     // meaning nothing is actually invalidated.
@@ -841,6 +896,11 @@ table::update_sstable_lists_on_off_strategy_completion(const std::vector<sstable
     co_await _cache.invalidate(std::move(updater), std::move(empty_ranges));
     _cache.refresh_snapshot();
     rebuild_statistics();
+
+    // Tearing down a large sstable set can stall, so dismantle the replaced
+    // lists gently if we're their last owner.
+    co_await utils::clear_gently(old_main_list);
+    co_await utils::clear_gently(old_maintenance_list);
 }
 
 // Note: must run in a seastar thread
@@ -906,6 +966,7 @@ table::on_compaction_completion(sstables::compaction_completion_desc& desc) {
     };
     auto permit = seastar::get_units(_sstable_set_mutation_sem, 1).get0();
     auto updater = row_cache::external_updater(sstable_list_updater::make(*this, std::move(permit), desc));
+    auto old_main_list = _main_sstables;
 
     _cache.invalidate(std::move(updater), std::move(desc.ranges_for_cache_invalidation)).get();
 
@@ -915,6 +976,10 @@ table::on_compaction_completion(sstables::compaction_completion_desc& desc) {
 
     rebuild_statistics();
 
+    // Tearing down a large sstable set can stall, so dismantle the replaced
+    // list gently if we're its last owner.
+    utils::clear_gently(old_main_list).get();
+
     auto f = seastar::try_with_gate(_sstable_deletion_gate, [this, sstables_to_remove = desc.old_sstables] {
        return with_semaphore(_sstable_deletion_sem, 1, [sstables_to_remove = std::move(sstables_to_remove)] {
            return sstables::delete_atomically(std::move(sstables_to_remove));
@@ -971,6 +1036,68 @@ table::compact_sstables(sstables::compaction_descriptor descriptor, sstables::co
     });
 }
 
+future<>
+table::parallel_compact_sstables(std::vector<sstables::compaction_descriptor> descriptors, sstables::compaction_data& cdata) {
+    if (descriptors.empty() || descriptors.front().sstables.empty()) {
+        co_return;
+    }
+    // The sub-jobs share their input sstables, so an input may only be
+    // removed from the sstable set (and deleted) once every sub-job has
+    // rewritten its share of that sstable's data. Until then its outputs
+    // are still added eagerly, and replaced inputs are withheld.
+    struct coordinator {
+        // How many sub-jobs still compact each input sstable.
+        std::unordered_map<sstables::shared_sstable, unsigned> users;
+        // Serializes replacement, which yields while the set is rebuilt.
+        seastar::semaphore lock{1};
+        uint64_t end_size = 0;
+    };
+    auto coord = make_lw_shared<coordinator>();
+    for (auto& d : descriptors) {
+        for (auto& sst : d.sstables) {
+            coord->users[sst]++;
+        }
+    }
+    for (auto& d : descriptors) {
+        d.creator = [this] (shard_id dummy) {
+            auto sst = make_sstable();
+            return sst;
+        };
+        d.replacer = [this, coord, release_exhausted = d.release_exhausted] (sstables::compaction_completion_desc desc) {
+            auto permit = seastar::get_units(coord->lock, 1).get0();
+            auto e = std::remove_if(desc.old_sstables.begin(), desc.old_sstables.end(), [&] (const sstables::shared_sstable& sst) {
+                return --coord->users.at(sst) > 0;
+            });
+            desc.old_sstables.erase(e, desc.old_sstables.end());
+            if (desc.old_sstables.empty() && desc.new_sstables.empty()) {
+                return;
+            }
+            _compaction_strategy.notify_completion(desc.old_sstables, desc.new_sstables);
+            _compaction_manager.propagate_replacement(this, desc.old_sstables, desc.new_sstables);
+            this->on_compaction_completion(desc);
+            if (release_exhausted) {
+                release_exhausted(desc.old_sstables);
+            }
+        };
+    }
+    auto compaction_type = descriptors.front().options.type();
+    auto start_size = boost::accumulate(descriptors.front().sstables | boost::adaptors::transformed(std::mem_fn(&sstables::sstable::data_size)), uint64_t(0));
+
+    co_await parallel_for_each(descriptors, [this, coord, &cdata] (sstables::compaction_descriptor& d) {
+        return sstables::compact_sstables(std::move(d), cdata, as_table_state()).then([coord] (sstables::compaction_result res) {
+            coord->end_size += res.end_size;
+        });
+    });
+
+    // skip update if running without a query context, for example, when running a test case.
+    if (compaction_type != sstables::compaction_type::Compaction || !db::qctx) {
+        co_return;
+    }
+    auto ended_at = std::chrono::duration_cast<std::chrono::milliseconds>(db_clock::now().time_since_epoch()).count();
+    co_await db::system_keyspace::update_compaction_history(cdata.compaction_uuid, _schema->ks_name(), _schema->cf_name(), ended_at,
+        start_size, coord->end_size, std::unordered_map<int32_t, int64_t>{});
+}
+
 // Note: We assume that the column_family does not get destroyed during compaction.
 future<>
 table::compact_all_sstables() {
@@ -1265,6 +1392,9 @@ table::sstables_as_snapshot_source() {
 
 // define in .cc, since sstable is forward-declared in .hh
 table::~table() {
+    if (_uses_latency_metrics_slot) {
+        --latency_metrics_slots_in_use;
+    }
 }
 
 
@@ -1692,7 +1822,9 @@ future<> table::generate_and_propagate_view_updates(const schema_ptr& base,
             break;
         }
         tracing::trace(tr_state, "Generated {} view update mutations", updates.size());
-        auto units = seastar::consume_units(*_config.view_update_concurrency_semaphore, memory_usage_of(updates));
+        auto update_size = memory_usage_of(updates);
+        _view_stats.view_update_backlog_added_bytes += update_size;
+        auto units = seastar::consume_units(*_config.view_update_concurrency_semaphore, update_size);
         try {
             co_await db::view::mutate_MV(base_token, std::move(updates), _view_stats, *_config.cf_stats, tr_state,
                 std::move(units), service::allow_hints::yes, db::view::wait_for_all_updates::no);
@@ -1822,6 +1954,7 @@ future<> table::populate_views(
                 break;
             }
             size_t update_size = memory_usage_of(updates);
+            _view_stats.view_update_backlog_added_bytes += update_size;
             size_t units_to_wait_for = std::min(_config.view_update_concurrency_semaphore_limit, update_size);
             auto units = co_await seastar::get_units(*_config.view_update_concurrency_semaphore, units_to_wait_for);
             units.adopt(seastar::consume_units(*_config.view_update_concurrency_semaphore, update_size - units_to_wait_for));
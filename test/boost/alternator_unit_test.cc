@@ -24,6 +24,8 @@
 
 #include <seastar/util/defer.hh>
 #include <seastar/core/memory.hh>
+#include <algorithm>
+#include <random>
 #include "utils/base64.hh"
 #include "utils/rjson.hh"
 
@@ -51,6 +53,22 @@ BOOST_AUTO_TEST_CASE(test_base64_encode_decode) {
     }
 }
 
+// The encoder and decoder take a vectorized path for long enough inputs, so
+// also cover blobs well above the SIMD block size, at every alignment of the
+// scalar tail.
+BOOST_AUTO_TEST_CASE(test_base64_encode_decode_long) {
+    std::default_random_engine rng(std::random_device{}());
+    std::uniform_int_distribution<int> dist(0, 255);
+    for (size_t len = 1024; len < 1024 + 32; ++len) {
+        bytes blob(bytes::initialized_later(), len);
+        std::generate(blob.begin(), blob.end(), [&] { return static_cast<int8_t>(dist(rng)); });
+        std::string encoded = base64_encode(blob);
+        BOOST_REQUIRE_EQUAL(base64_decoded_len(encoded), len);
+        auto decoded = base64_decode(encoded);
+        BOOST_REQUIRE_EQUAL(bytes_view(blob), bytes_view(decoded));
+    }
+}
+
 BOOST_AUTO_TEST_CASE(test_base64_decoded_len) {
     for (auto& [str, encoded] : strings) {
         BOOST_REQUIRE_EQUAL(str.size(), base64_decoded_len(encoded));
@@ -425,6 +425,52 @@ SEASTAR_TEST_CASE(test_commitlog_reader){
         });
 }
 
+SEASTAR_TEST_CASE(test_commitlog_reader_compressed){
+    // entries repetitive enough that the LZ4 path actually engages
+    static const sstring payload(size_t(1024), 'z');
+    static auto count_mutations_in_segment = [] (sstring path) -> future<size_t> {
+        auto count = make_lw_shared<size_t>(0);
+        return db::commitlog::read_log_file(path, db::commitlog::descriptor::FILENAME_PREFIX, service::get_local_commitlog_priority(), [count](db::commitlog::buffer_and_replay_position buf_rp) {
+            auto&& [buf, rp] = buf_rp;
+            auto linearization_buffer = bytes_ostream();
+            auto in = buf.get_istream();
+            auto str = to_sstring_view(in.read_bytes_view(buf.size_bytes(), linearization_buffer));
+            BOOST_CHECK_EQUAL(str, payload);
+            (*count)++;
+            return make_ready_future<>();
+        }).then([count] {
+            return *count;
+        });
+    };
+    commitlog::config cfg;
+    cfg.commitlog_segment_size_in_mb = 1;
+    cfg.compress_entries = true;
+    return cl_test(cfg, [](commitlog& log) {
+            auto set = make_lw_shared<rp_set>();
+            auto uuid = utils::UUID_gen::get_time_UUID();
+            return do_until([set]() { return set->size() > 50; },
+                    [&log, uuid, set]() {
+                        return log.add_mutation(uuid, payload.size(), db::commitlog::force_sync::no, [](db::commitlog::output& dst) {
+                                    dst.write(payload.data(), payload.size());
+                                }).then([set](auto h) {
+                                    BOOST_CHECK_NE(db::replay_position(), h.rp());
+                                    set->put(std::move(h));
+                                });
+                    }).then([&log, set]() {
+                        auto segments = log.get_active_segment_names();
+                        BOOST_REQUIRE(!segments.empty());
+                        auto path = segments.front();
+                        commitlog::descriptor desc(path, db::commitlog::descriptor::FILENAME_PREFIX);
+                        BOOST_CHECK_GE(desc.ver, commitlog::descriptor::segment_version_3);
+                        return log.sync_all_segments().then([set, path] {
+                            return count_mutations_in_segment(path).then([set] (size_t replay_count) {
+                                BOOST_CHECK_EQUAL(set->size(), replay_count);
+                            });
+                        });
+                    });
+        });
+}
+
 static future<> corrupt_segment(sstring seg, uint64_t off, uint32_t value) {
     return open_file_dma(seg, open_flags::rw).then([off, value](file f) {
         size_t size = align_up<size_t>(off, 4096);
@@ -176,7 +176,7 @@ SEASTAR_TEST_CASE(test_insert_large_collection_values) {
 
             auto make_query_options = [] (cql_protocol_version_type version) {
                     return std::make_unique<cql3::query_options>(cql3::default_cql_config, db::consistency_level::ONE, std::nullopt,
-                            std::vector<cql3::raw_value_view>(), false,
+                            cql3::raw_value_view_vector(), false,
                             cql3::query_options::specific_options::DEFAULT, cql_serialization_format{version});
             };
 
@@ -110,6 +110,25 @@ BOOST_AUTO_TEST_CASE(test_basic_estimated) {
     BOOST_CHECK_EQUAL(validate_histogram(res, {5, 8, 10, 14, 20, 20, 20, 20, 20, 20, 20, 21}, {160, 192, 224, 256, 320, 384, 448, 512, 640, 768, 896, 1024}), "");
 }
 
+BOOST_AUTO_TEST_CASE(test_count_estimated_histogram) {
+    utils::count_estimated_histogram hist;
+    // With a precision of 1 the bucket limits are exactly the powers of two.
+    BOOST_CHECK_EQUAL(hist.NUM_BUCKETS, 8);
+    for (size_t i = 0; i < hist.NUM_BUCKETS; i++) {
+        BOOST_CHECK_EQUAL(hist.get_bucket_lower_limit(i), 1 << i);
+    }
+    hist.add(1);
+    hist.add(2);
+    hist.add(3);
+    hist.add(4);
+    hist.add(7);
+    hist.add(8);
+    hist.add(127);
+    hist.add(128);
+    hist.add(1000);
+    BOOST_CHECK_EQUAL(validate_histogram(hist, {1, 2, 2, 1, 0, 0, 1, 2}), "");
+}
+
 BOOST_AUTO_TEST_CASE(test_estimated_statistics) {
     utils::approx_exponential_histogram<128, 1024, 4> hist;
     hist.add(1);
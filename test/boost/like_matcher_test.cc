@@ -199,6 +199,18 @@ BOOST_AUTO_TEST_CASE(test_percent_multiple) {
     BOOST_TEST(!matches(bookends, u8"dark"));
 }
 
+BOOST_AUTO_TEST_CASE(test_percent_backtracking) {
+    auto m = matcher(u8"%ab%ab");
+    BOOST_TEST(matches(m, u8"abab"));
+    BOOST_TEST(matches(m, u8"ababab"));
+    BOOST_TEST(matches(m, u8"abxab"));
+    BOOST_TEST(matches(m, u8"xxabxxab"));
+    BOOST_TEST(!matches(m, u8""));
+    BOOST_TEST(!matches(m, u8"ab"));
+    BOOST_TEST(!matches(m, u8"abba"));
+    BOOST_TEST(!matches(m, u8"ababx"));
+}
+
 BOOST_AUTO_TEST_CASE(test_escape_underscore) {
     auto last = matcher(u8R"(a\_)");
     BOOST_TEST(matches(last, u8"a_"));
@@ -376,6 +376,31 @@ SEASTAR_TEST_CASE(test_loading_cache_loading_reloading_unprivileged) {
     });
 }
 
+SEASTAR_TEST_CASE(test_loading_cache_background_reload_coalescing) {
+    return seastar::async([] {
+        using namespace std::chrono;
+        load_count = 0;
+        auto slow_loader = [] (const int& k) {
+            ++load_count;
+            return seastar::sleep(200ms).then([] { return make_ready_future<sstring>(test_string); });
+        };
+        utils::loading_cache<int, sstring, 0, utils::loading_cache_reload_enabled::yes> loading_cache(num_loaders, 10s, 10ms, testlog, slow_loader);
+        auto stop_cache_reload = seastar::defer([&loading_cache] { loading_cache.stop().get(); });
+
+        loading_cache.get_ptr(0).discard_result().get();
+        BOOST_REQUIRE_EQUAL(load_count, 1);
+
+        // Let the entry go stale, then hammer it with reads while the slow background reload is running: the
+        // refresh-ahead reads and the reload timer must all coalesce into a single reload.
+        sleep(20ms).get();
+        for (int i = 0; i < 10; ++i) {
+            loading_cache.get_ptr(0).discard_result().get();
+            sleep(5ms).get();
+        }
+        BOOST_REQUIRE_EQUAL(load_count, 2);
+    });
+}
+
 SEASTAR_TEST_CASE(test_loading_cache_max_size_eviction) {
     return seastar::async([] {
         using namespace std::chrono;
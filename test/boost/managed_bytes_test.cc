@@ -56,7 +56,7 @@ struct fragmenting_allocation_strategy : standard_allocation_strategy {
 
 constexpr size_t alloc_size = 63;
 const std::vector<size_t> sizes = {
-    0, 1, 15, 16,
+    0, 1, 15, 16, 23, 24,
     alloc_size - 1, alloc_size, alloc_size + 1,
     alloc_size * 4 - 1, alloc_size * 4, alloc_size * 4 + 1,
 };
@@ -425,6 +425,36 @@ SEASTAR_THREAD_TEST_CASE(sstable_directory_unshared_sstables_sanity_unmatched_ge
   }).get();
 }
 
+// Test that a directory whose generations all map to a single shard is still loaded
+// correctly: the scan assigns all the work to one shard, the pending descriptors are
+// handed off to the others, and the opened SSTables end up on their owner shards.
+SEASTAR_THREAD_TEST_CASE(sstable_directory_unshared_sstables_sanity_skewed_generations) {
+  sstables::test_env::do_with_sharded_async([] (sharded<test_env>& env) {
+    auto dir = tmpdir();
+    for (shard_id i = 0; i < smp::count; ++i) {
+        env.invoke_on(i, [dir = dir.path(), i] (sstables::test_env& env) {
+            // this is why it is annoying for the internal functions in the test infrastructure to
+            // assume threaded execution
+            return seastar::async([dir, i, &env] {
+                // All generations are multiples of smp::count, so shard 0 scans everything.
+                make_sstable_for_this_shard(std::bind(new_sstable, std::ref(env), dir, (i + 1) * smp::count));
+            });
+        }).get();
+    }
+
+   with_sstable_directory(dir.path(), 1,
+            sstable_directory::need_mutate_level::no,
+            sstable_directory::lack_of_toc_fatal::yes,
+            sstable_directory::enable_dangerous_direct_import_of_cassandra_counters::no,
+            sstable_directory::allow_loading_materialized_view::no,
+            sstable_from_existing_file(env),
+            [] (sharded<sstables::sstable_directory>& sstdir) {
+    distributed_loader_for_tests::process_sstable_dir(sstdir).get();
+    verify_that_all_sstables_are_local(sstdir, smp::count).get();
+   });
+  }).get();
+}
+
 // Test that the sstable_dir object can keep the table alive against a drop
 SEASTAR_TEST_CASE(sstable_directory_test_table_lock_works) {
     return do_with_cql_env_thread([] (cql_test_env& e) {
@@ -62,6 +62,59 @@ SEASTAR_TEST_CASE(test_sstables_sstable_set_read_modify_write) {
     });
 }
 
+SEASTAR_TEST_CASE(test_partitioned_sstable_set_unleveled_selection) {
+    return test_env::do_with([] (test_env& env) {
+        simple_schema ss;
+        auto s = ss.schema();
+
+        auto keys = token_generation_for_current_shard(8);
+        int gen = 1;
+        auto make_unleveled = [&] (unsigned first, unsigned last) {
+            auto sst = env.make_sstable(s, "", gen++);
+            sstables::test(sst).set_values_for_leveled_strategy(0, /*level*/ 0, 0, keys[first].first, keys[last].first);
+            return sst;
+        };
+        auto singular = [&] (unsigned i) {
+            return dht::partition_range::make_singular(dht::ring_position(ss.make_pkey(keys[i].first)));
+        };
+        auto range = [&] (unsigned first, unsigned last) {
+            return dht::partition_range::make(
+                    {dht::ring_position(ss.make_pkey(keys[first].first))},
+                    {dht::ring_position(ss.make_pkey(keys[last].first))});
+        };
+        auto selected = [] (const sstables::sstable_set& set, const dht::partition_range& pr) {
+            auto ssts = set.select(pr);
+            return std::unordered_set<shared_sstable>(ssts.begin(), ssts.end());
+        };
+
+        auto set = make_sstable_set(s, make_lw_shared<sstable_list>());
+        auto sst1 = make_unleveled(0, 2);
+        auto sst2 = make_unleveled(1, 3);
+        auto sst3 = make_unleveled(5, 6);
+        set.insert(sst3);
+        set.insert(sst1);
+        set.insert(sst2);
+
+        BOOST_REQUIRE_EQUAL(set.select(query::full_partition_range).size(), 3);
+        BOOST_REQUIRE(selected(set, singular(0)) == std::unordered_set<shared_sstable>({sst1}));
+        BOOST_REQUIRE(selected(set, singular(2)) == std::unordered_set<shared_sstable>({sst1, sst2}));
+        BOOST_REQUIRE(selected(set, singular(4)) == std::unordered_set<shared_sstable>());
+        BOOST_REQUIRE(selected(set, singular(5)) == std::unordered_set<shared_sstable>({sst3}));
+        BOOST_REQUIRE(selected(set, range(0, 1)) == std::unordered_set<shared_sstable>({sst1, sst2}));
+        BOOST_REQUIRE(selected(set, range(4, 7)) == std::unordered_set<shared_sstable>({sst3}));
+        BOOST_REQUIRE(selected(set, range(7, 7)) == std::unordered_set<shared_sstable>());
+
+        // The index must survive a copy and an erase.
+        auto set2 = set;
+        set2.erase(sst2);
+        BOOST_REQUIRE(selected(set2, singular(2)) == std::unordered_set<shared_sstable>({sst1}));
+        BOOST_REQUIRE_EQUAL(set2.select(query::full_partition_range).size(), 2);
+        BOOST_REQUIRE(selected(set, singular(2)) == std::unordered_set<shared_sstable>({sst1, sst2}));
+
+        return make_ready_future<>();
+    });
+}
+
 SEASTAR_TEST_CASE(test_time_series_sstable_set_read_modify_write) {
     return test_setup::do_with_tmp_directory([] (test_env& env, sstring tmpdir_path) {
         simple_schema ss;
@@ -462,3 +462,19 @@ SEASTAR_THREAD_TEST_CASE(test_clear_gently_multi_nesting) {
     BOOST_CHECK(c.empty());
     BOOST_REQUIRE_EQUAL(cleared_gently, top_count * mid_count * count);
 }
+
+SEASTAR_THREAD_TEST_CASE(test_clear_gently_optional) {
+    std::optional<clear_gently_tracker<int>> empty;
+    utils::clear_gently(empty).get();
+    BOOST_CHECK(!empty);
+
+    int cleared_gently = 0;
+    std::optional<clear_gently_tracker<int>> o;
+    o.emplace(clear_gently_tracker<int>(17, [&cleared_gently] (int) {
+        cleared_gently++;
+    }));
+
+    utils::clear_gently(o).get();
+    BOOST_CHECK(!o);
+    BOOST_REQUIRE_EQUAL(cleared_gently, 1);
+}
@@ -118,7 +118,7 @@ SEASTAR_THREAD_TEST_CASE(test_response_request_reader) {
     BOOST_CHECK_EQUAL(to_bytes(req.read_value_view(version)), value);
 
     std::vector<sstring_view> names;
-    std::vector<cql3::raw_value_view> values;
+    cql3::raw_value_view_vector values;
     req.read_name_and_value_list(version, names, values);
     BOOST_CHECK_EQUAL(names, names_and_values | boost::adaptors::transformed([] (auto& name_and_value) {
         return sstring_view(name_and_value.first);
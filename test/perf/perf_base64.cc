@@ -0,0 +1,56 @@
+/*
+ * Copyright (C) 2021-present ScyllaDB
+ */
+
+/*
+ * This file is part of Scylla.
+ *
+ * Scylla is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Scylla is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Scylla.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "seastar/include/seastar/testing/perf_tests.hh"
+#include <seastar/testing/test_runner.hh>
+
+#include <random>
+
+#include "utils/base64.hh"
+
+// Sized after a typical Alternator binary (B) attribute in a blob-heavy
+// workload rather than after a whole sstable chunk.
+class base64 {
+public:
+    static constexpr size_t blob_size = 8 * 1024;
+private:
+    bytes _blob;
+    std::string _encoded;
+public:
+    base64() : _blob(bytes::initialized_later{}, blob_size) {
+        auto eng = seastar::testing::local_random_engine;
+        auto dist = std::uniform_int_distribution<int>{0, 255};
+        std::generate_n(_blob.begin(), blob_size, [&] { return static_cast<int8_t>(dist(eng)); });
+        _encoded = base64_encode(_blob);
+    }
+    bytes_view blob() const { return _blob; }
+    const std::string& encoded() const { return _encoded; }
+};
+
+PERF_TEST_F(base64, encode) {
+    perf_tests::do_not_optimize(base64_encode(blob()));
+    return blob_size;
+}
+
+PERF_TEST_F(base64, decode) {
+    perf_tests::do_not_optimize(base64_decode(encoded()));
+    return blob_size;
+}
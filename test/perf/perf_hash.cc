@@ -48,5 +48,18 @@ int main(int argc, char* argv[]) {
         sink += dst[1];
     });
 
+    std::cout << "Timing interleaved x4 hash (4 keys per iteration)...\n";
+
+    std::array<bytes_view, 4> keys = {src, src, src, src};
+
+    time_it([&] {
+        std::array<std::array<uint64_t,2>, 4> dst;
+        utils::murmur_hash::hash3_x64_128_x4(keys, seed, dst);
+        for (auto&& d : dst) {
+            sink += d[0];
+            sink += d[1];
+        }
+    });
+
     black_hole = sink;
 }
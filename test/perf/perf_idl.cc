@@ -71,4 +71,31 @@ PERF_TEST_F(frozen_mutation, apply_one_small_row)
     perf_tests::do_not_optimize(m);
 }
 
+namespace {
+
+// Counts the fragments of a partition view without retaining anything,
+// modelling handlers which walk the serialized form in place.
+class counting_partition_visitor : public mutation_partition_view_virtual_visitor {
+public:
+    uint64_t rows = 0;
+    uint64_t cells = 0;
+    virtual void accept_partition_tombstone(tombstone) override { }
+    virtual void accept_static_cell(column_id, atomic_cell) override { ++cells; }
+    virtual void accept_static_cell(column_id, collection_mutation_view) override { ++cells; }
+    virtual void accept_row_tombstone(range_tombstone) override { }
+    virtual void accept_row(position_in_partition_view, row_tombstone, row_marker, is_dummy, is_continuous) override { ++rows; }
+    virtual void accept_row_cell(column_id, atomic_cell) override { ++cells; }
+    virtual void accept_row_cell(column_id, collection_mutation_view) override { ++cells; }
+};
+
+}
+
+PERF_TEST_F(frozen_mutation, walk_one_small_row)
+{
+    counting_partition_visitor v;
+    frozen_one_small_row().partition().accept(schema()->get_column_mapping(), v);
+    perf_tests::do_not_optimize(v.rows);
+    perf_tests::do_not_optimize(v.cells);
+}
+
 }
@@ -72,7 +72,9 @@ static void execute_counter_update_for_key(cql_test_env& env, const bytes& key)
 };
 
 struct test_config {
-    enum class run_mode { read, write, del };
+    // put, query and batch_write drive the alternator PutItem, Query and
+    // BatchWriteItem request shapes and are only valid with --alternator.
+    enum class run_mode { read, write, del, put, query, batch_write };
     enum class frontend_type { cql, alternator };
 
     run_mode mode;
@@ -84,6 +86,7 @@ struct test_config {
     bool counters;
     bool flush_memtables;
     unsigned operations_per_shard = 0;
+    unsigned batch_size = 25;
 };
 
 std::ostream& operator<<(std::ostream& os, const test_config::run_mode& m) {
@@ -91,6 +94,9 @@ std::ostream& operator<<(std::ostream& os, const test_config::run_mode& m) {
         case test_config::run_mode::write: return os << "write";
         case test_config::run_mode::read: return os << "read";
         case test_config::run_mode::del: return os << "delete";
+        case test_config::run_mode::put: return os << "put";
+        case test_config::run_mode::query: return os << "query";
+        case test_config::run_mode::batch_write: return os << "batch_write";
     }
     abort();
 }
@@ -339,6 +345,92 @@ static std::vector<perf_result> test_alternator_write(service::client_state& sta
     }, cfg.concurrency, cfg.duration_in_seconds, cfg.operations_per_shard);
 }
 
+static std::vector<perf_result> test_alternator_put(service::client_state& state, alternator::executor& executor, test_config& cfg) {
+    return time_parallel([&] {
+        std::string prefix = R"(
+            {
+                "TableName": "alternator_table",
+                "Item": {
+                    "p": {
+                        "S": ")";
+        std::string postfix = R"("
+                    },
+                    "C0": {
+                        "S": "xxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxx"
+                    },
+                    "C1": {
+                        "S": "xxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxx"
+                    },
+                    "C2": {
+                        "S": "xxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxx"
+                    },
+                    "C3": {
+                        "S": "xxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxx"
+                    },
+                    "C4": {
+                        "S": "xxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxx"
+                    }
+                },
+                "ReturnValues": "NONE"
+            }
+        )";
+        auto key = std::to_string(make_random_seq(cfg));
+        // Chunked content is used to minimize string copying, and thus extra allocations
+        rjson::chunked_content content;
+        content.reserve(3);
+        content.emplace_back(prefix.data(), prefix.size(), deleter{});
+        content.emplace_back(key.data(), key.size(), deleter{});
+        content.emplace_back(postfix.data(), postfix.size(), deleter{});
+        return executor.put_item(state, tracing::trace_state_ptr(), empty_service_permit(), rjson::parse(std::move(content))).discard_result();
+    }, cfg.concurrency, cfg.duration_in_seconds, cfg.operations_per_shard);
+}
+
+static std::vector<perf_result> test_alternator_query(service::client_state& state, noncopyable_function<void()> flush_memtables,
+        alternator::executor& executor, test_config& cfg) {
+    create_alternator_partitions(state, std::move(flush_memtables), executor, cfg);
+    std::string prefix = R"(
+        {
+            "TableName": "alternator_table",
+            "KeyConditionExpression": "p = :p",
+            "ExpressionAttributeValues": {
+                ":p": {
+                    "S": ")";
+    std::string postfix = R"("
+                }
+            },
+            "ConsistentRead": false
+        }
+    )";
+    return time_parallel([&] {
+        auto key = std::to_string(make_random_seq(cfg));
+        // Chunked content is used to minimize string copying, and thus extra allocations
+        rjson::chunked_content content;
+        content.reserve(3);
+        content.emplace_back(prefix.data(), prefix.size(), deleter{});
+        content.emplace_back(key.data(), key.size(), deleter{});
+        content.emplace_back(postfix.data(), postfix.size(), deleter{});
+        return executor.query(state, tracing::trace_state_ptr(), empty_service_permit(), rjson::parse(std::move(content))).discard_result();
+    }, cfg.concurrency, cfg.duration_in_seconds, cfg.operations_per_shard);
+}
+
+static std::vector<perf_result> test_alternator_batch_write(service::client_state& state, alternator::executor& executor, test_config& cfg) {
+    return time_parallel([&] {
+        std::string requests;
+        for (unsigned i = 0; i < cfg.batch_size; ++i) {
+            if (i) {
+                requests += ",";
+            }
+            // The "#i" suffix keeps the keys within one batch distinct, as
+            // BatchWriteItem rejects duplicates.
+            requests += R"({"PutRequest": {"Item": {"p": {"S": ")"
+                    + std::to_string(make_random_seq(cfg)) + "#" + std::to_string(i)
+                    + R"("}, "C0": {"S": "xxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxx"}}}})";
+        }
+        std::string json = R"({"RequestItems": {"alternator_table": [)" + requests + "]}}";
+        return executor.batch_write_item(state, tracing::trace_state_ptr(), empty_service_permit(), rjson::parse(json)).discard_result();
+    }, cfg.concurrency, cfg.duration_in_seconds, cfg.operations_per_shard);
+}
+
 static std::vector<perf_result> test_alternator_delete(service::client_state& state, noncopyable_function<void()> flush_memtables,
         alternator::executor& executor, test_config& cfg) {
     create_alternator_partitions(state, std::move(flush_memtables), executor, cfg);
@@ -387,6 +479,12 @@ static std::vector<perf_result> do_alternator_test(std::string isolation_level,
             return test_alternator_write(state, executor, cfg);
         case test_config::run_mode::del:
             return test_alternator_delete(state, std::move(flush_memtables), executor, cfg);
+        case test_config::run_mode::put:
+            return test_alternator_put(state, executor, cfg);
+        case test_config::run_mode::query:
+            return test_alternator_query(state, std::move(flush_memtables), executor, cfg);
+        case test_config::run_mode::batch_write:
+            return test_alternator_batch_write(state, executor, cfg);
         };
     } catch (const alternator::api_error& e) {
         std::cout << "Alternator API error: " << e._msg << std::endl;
@@ -424,6 +522,10 @@ static std::vector<perf_result> do_cql_test(cql_test_env& env, test_config& cfg)
         }
     case test_config::run_mode::del:
         return test_delete(env, cfg);
+    case test_config::run_mode::put:
+    case test_config::run_mode::query:
+    case test_config::run_mode::batch_write:
+        throw std::runtime_error("--put, --query and --batch-write are only supported with --alternator");
     };
     abort();
 }
@@ -454,6 +556,9 @@ void write_json_result(std::string result_file, const test_config& cfg, perf_res
     case test_config::run_mode::read: test_type = "read"; break;
     case test_config::run_mode::write: test_type = "write"; break;
     case test_config::run_mode::del: test_type = "delete"; break;
+    case test_config::run_mode::put: test_type = "put"; break;
+    case test_config::run_mode::query: test_type = "query"; break;
+    case test_config::run_mode::batch_write: test_type = "batch_write"; break;
     }
     if (cfg.counters) {
         test_type += "_counters";
@@ -494,6 +599,10 @@ int main(int argc, char** argv) {
         ("partitions", bpo::value<unsigned>()->default_value(10000), "number of partitions")
         ("write", "test write path instead of read path")
         ("delete", "test delete path instead of read path")
+        ("put", "test the alternator PutItem path (requires --alternator)")
+        ("query", "test the alternator Query path (requires --alternator)")
+        ("batch-write", "test the alternator BatchWriteItem path (requires --alternator)")
+        ("batch-size", bpo::value<unsigned>()->default_value(25), "number of items per BatchWriteItem request")
         ("duration", bpo::value<unsigned>()->default_value(5), "test duration in seconds")
         ("query-single-key", "test reading with a single key instead of random keys")
         ("concurrency", bpo::value<unsigned>()->default_value(100), "workers per core")
@@ -535,9 +644,16 @@ int main(int argc, char** argv) {
                 cfg.mode = test_config::run_mode::write;
             } else if (app.configuration().contains("delete")) {
                 cfg.mode = test_config::run_mode::del;
+            } else if (app.configuration().contains("put")) {
+                cfg.mode = test_config::run_mode::put;
+            } else if (app.configuration().contains("query")) {
+                cfg.mode = test_config::run_mode::query;
+            } else if (app.configuration().contains("batch-write")) {
+                cfg.mode = test_config::run_mode::batch_write;
             } else {
                 cfg.mode = test_config::run_mode::read;
             };
+            cfg.batch_size = app.configuration()["batch-size"].as<unsigned>();
             if (app.configuration().contains("alternator")) {
                 cfg.frontend = test_config::frontend_type::alternator;
             } else {
@@ -57,6 +57,12 @@ future<> test_compaction(distributed<perf_sstable_test_env>& dt) {
     });
 }
 
+future<> test_compaction_with_reads(distributed<perf_sstable_test_env>& dt) {
+    // The input sets are generated inside the mapper, with the configured
+    // overlap, so there is no up-front fill_memtable() here.
+    return time_runs(iterations, parallelism, dt, &perf_sstable_test_env::compaction_with_reads);
+}
+
 future<> test_index_read(distributed<perf_sstable_test_env>& dt) {
     return time_runs(iterations, parallelism, dt, &perf_sstable_test_env::read_all_indexes);
 }
@@ -71,6 +77,7 @@ enum class test_modes {
     write,
     index_write,
     compaction,
+    compaction_with_reads,
 };
 
 static std::unordered_map<sstring, test_modes> test_mode = {
@@ -79,6 +86,7 @@ static std::unordered_map<sstring, test_modes> test_mode = {
     {"write", test_modes::write },
     {"index_write", test_modes::index_write },
     {"compaction", test_modes::compaction },
+    {"compaction_with_reads", test_modes::compaction_with_reads },
 };
 
 int main(int argc, char** argv) {
@@ -93,7 +101,11 @@ int main(int argc, char** argv) {
         ("num_columns", bpo::value<unsigned>()->default_value(5), "number of columns per row")
         ("column_size", bpo::value<unsigned>()->default_value(64), "size in bytes for each column")
         ("sstables", bpo::value<unsigned>()->default_value(1), "number of sstables (valid only for compaction mode)")
-        ("mode", bpo::value<sstring>()->default_value("index_write"), "one of: sequential_read, index_read, write, compaction, index_write (default)")
+        ("mode", bpo::value<sstring>()->default_value("index_write"), "one of: sequential_read, index_read, write, compaction, compaction_with_reads, index_write (default)")
+        ("overlap", bpo::value<double>()->default_value(0.5), "fraction of each input run's keys shared by all runs (compaction_with_reads mode)")
+        ("tombstone-ratio", bpo::value<double>()->default_value(0.0), "fraction of partitions written as purgeable tombstones (compaction_with_reads mode)")
+        ("partition-size-stdev", bpo::value<double>()->default_value(0.0), "stdev of the lognormal factor applied to column_size (compaction_with_reads mode)")
+        ("concurrent-reads", bpo::value<unsigned>()->default_value(8), "concurrent point-read fibers during compaction (compaction_with_reads mode)")
         ("testdir", bpo::value<sstring>()->default_value("/var/lib/scylla/perf-tests"), "directory in which to store the sstables")
         ("compaction-strategy", bpo::value<sstring>()->default_value("SizeTieredCompactionStrategy"), "compaction strategy to use, one of "
              "(SizeTieredCompactionStrategy, LeveledCompactionStrategy, DateTieredCompactionStrategy, TimeWindowCompactionStrategy)")
@@ -121,6 +133,10 @@ int main(int argc, char** argv) {
         }
         cfg.compaction_strategy = sstables::compaction_strategy::type(app.configuration()["compaction-strategy"].as<sstring>());
         cfg.timestamp_range = app.configuration()["timestamp-range"].as<api::timestamp_type>();
+        cfg.overlap = app.configuration()["overlap"].as<double>();
+        cfg.tombstone_ratio = app.configuration()["tombstone-ratio"].as<double>();
+        cfg.partition_size_stdev = app.configuration()["partition-size-stdev"].as<double>();
+        cfg.concurrent_reads = app.configuration()["concurrent-reads"].as<unsigned>();
         return test->start(std::move(cfg)).then([mode, dir, test] {
             engine().at_exit([test] { return test->stop(); });
             if ((mode == test_modes::index_read) ||
@@ -135,7 +151,8 @@ int main(int argc, char** argv) {
                         throw;
                     }
                 });
-            } else if ((mode == test_modes::index_write) || (mode == test_modes::write) || (mode == test_modes::compaction)) {
+            } else if ((mode == test_modes::index_write) || (mode == test_modes::write) || (mode == test_modes::compaction)
+                    || (mode == test_modes::compaction_with_reads)) {
                 return test_setup::create_empty_test_dir(dir);
             } else {
                 throw std::invalid_argument("Invalid mode");
@@ -149,6 +166,8 @@ int main(int argc, char** argv) {
                 return test_write(*test).then([test] {});
             } else if (mode == test_modes::compaction) {
                 return test_compaction(*test).then([test] {});
+            } else if (mode == test_modes::compaction_with_reads) {
+                return test_compaction_with_reads(*test).then([test] {});
             } else {
                 throw std::invalid_argument("Invalid mode");
             }
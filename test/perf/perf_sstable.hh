@@ -31,6 +31,7 @@
 #include "test/lib/sstable_utils.hh"
 #include "test/lib/test_services.hh"
 #include "test/lib/random_utils.hh"
+#include "utils/estimated_histogram.hh"
 #include <boost/accumulators/framework/accumulator_set.hpp>
 #include <boost/accumulators/framework/features.hpp>
 #include <boost/accumulators/statistics/mean.hpp>
@@ -53,6 +54,11 @@ public:
         sstring dir;
         sstables::compaction_strategy_type compaction_strategy;
         api::timestamp_type timestamp_range;
+        // Used by the compaction_with_reads mode only.
+        double overlap;                // fraction of each input run's keys shared by all runs
+        double tombstone_ratio;        // fraction of partitions written as (purgeable) tombstones
+        double partition_size_stdev;   // stdev of the lognormal factor applied to column_size
+        unsigned concurrent_reads;     // number of concurrent point-read fibers during compaction
     };
 
 private:
@@ -212,6 +218,115 @@ public:
         });
     }
 
+    // Like compaction(), but the input runs only partially overlap, a
+    // configurable fraction of the partitions are purgeable tombstones, the
+    // partition sizes follow a lognormal distribution, and point reads run
+    // against the input sstables while the compaction is in progress. The
+    // returned number is the compaction throughput; the concurrent read
+    // latency percentiles are printed per run.
+    future<double> compaction_with_reads(int idx) {
+        return test_setup::create_empty_test_dir(dir()).then([this, idx] {
+            return sstables::test_env::do_with_async_returning<double>([this, idx] (sstables::test_env& env) {
+                auto sst_gen = [this, gen = make_lw_shared<unsigned>(idx)] () mutable {
+                    return _env.make_sstable(s, dir(), (*gen)++, sstables::get_highest_sstable_version(), sstable::format_types::big, _cfg.buffer_size);
+                };
+
+                const auto per_sstable = unsigned(_cfg.partitions / _cfg.sstables);
+                const auto shared = unsigned(per_sstable * std::min(_cfg.overlap, 1.0));
+                const auto unique = per_sstable - shared;
+                // keys[0..shared) go into every input run; run i also gets its
+                // own slice of unique keys.
+                auto keys = make_local_keys(int(shared + unique * _cfg.sstables), s, _cfg.key_size);
+
+                std::lognormal_distribution<double> size_dist(0.0, _cfg.partition_size_stdev);
+                std::bernoulli_distribution tombstone_dist(_cfg.tombstone_ratio);
+                // Old enough to be purgeable regardless of gc_grace_seconds.
+                const auto purgeable_deletion_time = gc_clock::now() - s->gc_grace_seconds() - std::chrono::hours(24);
+
+                std::vector<shared_sstable> ssts;
+                for (auto i = 0u; i < _cfg.sstables; i++) {
+                    auto mt = make_lw_shared<memtable>(s);
+                    auto add_partition = [&] (const sstring& key) {
+                        auto mut = mutation(s, partition_key::from_deeply_exploded(*s, { key }));
+                        // Later runs win on the shared keys, like newer
+                        // memtable flushes over older ones.
+                        const api::timestamp_type ts = i;
+                        if (tombstone_dist(_generator)) {
+                            mut.partition().apply(tombstone(ts, purgeable_deletion_time));
+                        } else {
+                            for (auto& cdef : s->regular_columns()) {
+                                auto size = std::max(1u, unsigned(_cfg.column_size * size_dist(_generator)));
+                                mut.set_clustered_cell(clustering_key::make_empty(), cdef, atomic_cell::make_live(*utf8_type, ts, utf8_type->decompose(random_string(size))));
+                            }
+                        }
+                        mt->apply(std::move(mut));
+                    };
+                    for (auto k = 0u; k < shared; k++) {
+                        add_partition(keys.at(k));
+                    }
+                    for (auto k = 0u; k < unique; k++) {
+                        add_partition(keys.at(shared + i * unique + k));
+                    }
+                    auto sst = sst_gen();
+                    write_memtable_to_sstable_for_test(*mt, sst).get();
+                    sst->open_data().get();
+                    ssts.push_back(std::move(sst));
+                }
+
+                cache_tracker tracker;
+                cell_locker_stats cl_stats;
+                auto cm = make_lw_shared<compaction_manager>();
+                auto cf = make_lw_shared<column_family>(s, column_family_test_config(env.manager(), env.semaphore()), column_family::no_commitlog(), *cm, cl_stats, tracker);
+
+                utils::estimated_histogram read_hist;
+                bool stop_reads = false;
+                auto inputs = ssts; // compact_sstables() moves the descriptor's copy
+                auto readers = parallel_for_each(boost::irange(0u, _cfg.concurrent_reads), [&] (unsigned) {
+                    return seastar::async([&] {
+                        while (!stop_reads) {
+                            auto& key = keys.at(tests::random::get_int<size_t>(keys.size() - 1));
+                            auto dk = dht::decorate_key(*s, partition_key::from_deeply_exploded(*s, { key }));
+                            auto pr = dht::partition_range::make_singular(dk);
+                            auto& sst = inputs.at(tests::random::get_int<size_t>(inputs.size() - 1));
+                            auto start = perf_sstable_test_env::now();
+                            auto rd = sst->make_reader(s, _env.make_reader_permit(), pr, s->full_slice());
+                            auto close_rd = deferred_close(rd);
+                            read_mutation_from_flat_mutation_reader(rd).get();
+                            read_hist.add(std::chrono::duration_cast<std::chrono::microseconds>(perf_sstable_test_env::now() - start).count());
+                        }
+                    });
+                });
+
+                auto start = perf_sstable_test_env::now();
+
+                auto descriptor = sstables::compaction_descriptor(std::move(ssts), cf->get_sstable_set(), default_priority_class());
+                descriptor.creator = [sst_gen = std::move(sst_gen)] (unsigned dummy) mutable {
+                    return sst_gen();
+                };
+                descriptor.replacer = sstables::replacer_fn_no_op();
+                auto cdata = compaction_manager::create_compaction_data();
+                auto ret = sstables::compact_sstables(std::move(descriptor), cdata, cf->as_table_state()).get0();
+                auto end = perf_sstable_test_env::now();
+
+                stop_reads = true;
+                readers.get();
+
+                if (_cfg.concurrent_reads) {
+                    std::cout << format("shard {:2d}: {} concurrent reads: p50 {}us p95 {}us p99 {}us max {}us\n",
+                            this_shard_id(), read_hist.count(), read_hist.percentile(0.5), read_hist.percentile(0.95),
+                            read_hist.percentile(0.99), read_hist.max());
+                }
+
+                auto total_keys_written = std::accumulate(ret.new_sstables.begin(), ret.new_sstables.end(), uint64_t(0), [] (uint64_t n, const sstables::shared_sstable& sst) {
+                    return n + sst->get_estimated_key_count();
+                });
+
+                auto duration = std::chrono::duration<double>(end - start).count();
+                return total_keys_written / duration;
+            });
+        });
+    }
+
     future<double> read_all_indexes(int idx) {
         return do_with(test(_sst[0]), [this] (auto& sst) {
             const auto start = perf_sstable_test_env::now();
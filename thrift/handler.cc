@@ -180,6 +180,16 @@ std::string bytes_to_string(bytes_view v) {
     return { reinterpret_cast<const char*>(v.begin()), v.size() };
 }
 
+std::string bytes_to_string(managed_bytes_view v) {
+    std::string str;
+    str.reserve(v.size_bytes());
+    for (bytes_view fragment : fragment_range(v)) {
+        auto view = std::string_view(reinterpret_cast<const char*>(fragment.data()), fragment.size());
+        str.insert(str.end(), view.begin(), view.end());
+    }
+    return str;
+}
+
 std::string bytes_to_string(query::result_bytes_view v) {
     std::string str;
     str.reserve(v.size_bytes());
@@ -1025,7 +1035,7 @@ public:
                 throw make_exception<InvalidRequestException>("Compressed query strings are not supported");
             }
             auto& qp = _query_processor.local();
-            auto opts = std::make_unique<cql3::query_options>(qp.get_cql_config(), cl_from_thrift(consistency), std::nullopt, std::vector<cql3::raw_value_view>(),
+            auto opts = std::make_unique<cql3::query_options>(qp.get_cql_config(), cl_from_thrift(consistency), std::nullopt, cql3::raw_value_view_vector(),
                             false, cql3::query_options::specific_options::DEFAULT, cql_serialization_format::latest());
             auto f = qp.execute_direct(query, _query_state, *opts);
             return f.then([cob = std::move(cob), opts = std::move(opts)](auto&& ret) {
@@ -1193,6 +1203,13 @@ private:
                 }
 
             }
+            void accept_value(managed_bytes_view cell) {
+                auto& col = _metadata.get_names()[_column_id++];
+
+                Column& c = _columns.emplace_back();
+                c.__set_name(col->name->to_string());
+                c.__set_value(bytes_to_string(cell));
+            }
             void end_row() {
                 CqlRow& r = _rows.emplace_back();
                 r.__set_key(std::string());
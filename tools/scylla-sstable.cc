@@ -23,6 +23,8 @@
 #include <filesystem>
 #include <seastar/core/app-template.hh>
 #include <seastar/core/coroutine.hh>
+#include <seastar/core/smp.hh>
+#include <seastar/core/when_all.hh>
 #include <seastar/util/closeable.hh>
 
 #include "compaction/compaction.hh"
@@ -614,6 +616,95 @@ void validate_operation(schema_ptr schema, reader_permit permit, const std::vect
     });
 }
 
+struct validation_summary {
+    uint64_t sstables = 0;
+    uint64_t invalid = 0;
+    uint64_t bytes = 0;
+};
+
+// Validates the sstables assigned to this shard, one-by-one. Each shard loads
+// its own schema and sstables, so memory usage is bounded by the single
+// sstable being processed and only the small summary is sent back to shard 0.
+validation_summary validate_shard_sstables(const sstring& schema_file, const std::vector<sstring>& sstable_names) {
+    validation_summary summary;
+    if (sstable_names.empty()) {
+        return summary;
+    }
+
+    auto schema = tools::load_one_schema_from_file(std::filesystem::path(schema_file)).get();
+
+    db::config dbcfg;
+    gms::feature_service feature_service(gms::feature_config_from_db_config(dbcfg));
+    cache_tracker tracker;
+    sstables::sstables_manager sst_man(large_data_handler, dbcfg, feature_service, tracker);
+    auto close_sst_man = deferred_close(sst_man);
+
+    reader_concurrency_semaphore rcs_sem(reader_concurrency_semaphore::no_limits{}, app_name);
+    auto stop_semaphore = deferred_stop(rcs_sem);
+    const auto permit = rcs_sem.make_tracking_only_permit(schema.get(), app_name, db::no_timeout);
+
+    sstables::compaction_data info;
+
+    for (const auto& sst_name : sstable_names) {
+        auto sst = load_sstables(schema, sst_man, {sst_name}).front();
+
+        const auto start = std::chrono::steady_clock::now();
+        const auto valid = sstables::scrub_validate_mode_validate_reader(sst->make_crawling_reader_v1(schema, permit), info).get();
+        const auto duration = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        const auto bytes = sst->ondisk_data_size();
+        const auto mib = bytes / double(1 << 20);
+        sst_log.info("validated {}: {}, {:.2f} MiB in {:.2f}s ({:.2f} MiB/s)", sst->get_filename(), valid ? "valid" : "invalid",
+                mib, duration, duration > 0 ? mib / duration : 0.);
+
+        ++summary.sstables;
+        summary.invalid += !valid;
+        summary.bytes += bytes;
+    }
+
+    return summary;
+}
+
+int validate_parallel_operation(const sstring& schema_file, const std::vector<sstring>& sstable_names) {
+    std::vector<std::vector<sstring>> shard_sstable_names(smp::count);
+    for (size_t i = 0; i < sstable_names.size(); ++i) {
+        shard_sstable_names[i % smp::count].push_back(sstable_names[i]);
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+
+    std::vector<future<validation_summary>> shard_summaries;
+    shard_summaries.reserve(smp::count);
+    for (unsigned shard = 0; shard < smp::count; ++shard) {
+        shard_summaries.push_back(smp::submit_to(shard, [schema_file, names = std::move(shard_sstable_names[shard])] {
+            return async([&schema_file, &names] {
+                return validate_shard_sstables(schema_file, names);
+            });
+        }));
+    }
+
+    validation_summary total;
+    for (const auto& summary : when_all_succeed(shard_summaries.begin(), shard_summaries.end()).get0()) {
+        total.sstables += summary.sstables;
+        total.invalid += summary.invalid;
+        total.bytes += summary.bytes;
+    }
+
+    const auto duration = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    const auto mib = total.bytes / double(1 << 20);
+    sst_log.info("validated {} sstables on {} shards: {} invalid, {:.2f} MiB in {:.2f}s ({:.2f} MiB/s aggregate)",
+            total.sstables, smp::count, total.invalid, mib, duration, duration > 0 ? mib / duration : 0.);
+
+    return total.invalid ? 1 : 0;
+}
+
+// Never called, validate-parallel is dispatched in main(), before sstables
+// are loaded, so that each shard can load its own share of them.
+void validate_parallel_operation_placeholder(schema_ptr, reader_permit, const std::vector<sstables::shared_sstable>&, const partition_set&,
+        const options&, const operation_specific_options&) {
+    std::abort();
+}
+
 void check_flags_unusable_for_component_dump(const char* dump_name, const partition_set& partitions, const options& opts) {
     if (!partitions.empty()) {
         sst_log.warn("partition-filter is not supported for dump-{}, ignoring", dump_name);
@@ -1106,6 +1197,9 @@ const std::vector<operation> operations{
             sstable_consumer_operation<writetime_histogram_collecting_consumer>},
     {"custom", "Hackable custom operation for expert users, until scripting support is implemented.", sstable_consumer_operation<custom_consumer>},
     {"validate", "Validate sstable(s) with the mutation fragment stream validator, same as scrub in validate mode.", validate_operation},
+    {"validate-parallel",
+            "Like validate, but the sstable(s) are distributed across all reactor shards (see --smp) and read throughput is reported; exits with status 1 if any sstable is invalid.",
+            validate_parallel_operation_placeholder},
 };
 
 } // anonymous namespace
@@ -1153,6 +1247,9 @@ $ scylla-sstable --writetime-histogram --partition={{myhexpartitionkey}} /path/t
 
 # validate the specified sstables
 $ scylla-sstable --validate /path/to/md-123456-big-Data.db /path/to/md-123457-big-Data.db
+
+# validate many sstables in parallel, using 8 cores
+$ scylla-sstable --validate-parallel --smp=8 /path/to/*-Data.db
 )";
     app_cfg.description = format(description_template, app_name, boost::algorithm::join(operations | boost::adaptors::transformed([] (const auto& op) {
         if (op.available_options().empty()) {
@@ -1215,6 +1312,20 @@ $ scylla-sstable --validate /path/to/md-123456-big-Data.db /path/to/md-123457-bi
                 }
             }
 
+            if (operation.name() == "validate-parallel") {
+                if (!app_config.count("sstables")) {
+                    std::cerr << "error: no sstables specified on the command line\n";
+                    return 2;
+                }
+                if (opts.merge || opts.no_skips) {
+                    sst_log.warn("--merge and --no-skips are not supported for validate-parallel, ignoring");
+                }
+                if (app_config.count("partition") || app_config.count("partitions-file")) {
+                    sst_log.warn("partition-filter is not supported for validate-parallel, ignoring");
+                }
+                return validate_parallel_operation(app_config["schema-file"].as<sstring>(), app_config["sstables"].as<std::vector<sstring>>());
+            }
+
             schema_ptr schema;
             try {
                 schema = tools::load_one_schema_from_file(std::filesystem::path(app_config["schema-file"].as<sstring>())).get();
@@ -58,7 +58,7 @@ struct trace_state::params_values {
     struct prepared_statement_info {
         prepared_checked_weak_ptr statement;
         std::optional<std::vector<sstring_view>> query_option_names;
-        std::vector<cql3::raw_value_view> query_option_values;
+        cql3::raw_value_view_vector query_option_values;
         explicit prepared_statement_info(prepared_checked_weak_ptr statement) : statement(std::move(statement)) {}
     };
 
@@ -225,7 +225,7 @@ void trace_state::build_parameters_map() {
 
 void trace_state::build_parameters_map_for_one_prepared(const prepared_checked_weak_ptr& prepared_ptr,
         std::optional<std::vector<sstring_view>>& names_opt,
-        std::vector<cql3::raw_value_view>& values, const sstring& param_name_prefix) {
+        cql3::raw_value_view_vector& values, const sstring& param_name_prefix) {
     auto& params_map = _records->session_rec.parameters;
     size_t i = 0;
 
@@ -53,10 +53,10 @@
 #include "types.hh"
 #include "timestamp.hh"
 #include "inet_address_vectors.hh"
+#include "cql3/values.hh"
 
 namespace cql3{
 class query_options;
-struct raw_value_view;
 
 namespace statements {
 class prepared_statement;
@@ -433,7 +433,7 @@ private:
      */
     void build_parameters_map_for_one_prepared(const prepared_checked_weak_ptr& prepared_ptr,
             std::optional<std::vector<sstring_view>>& names_opt,
-            std::vector<cql3::raw_value_view>& values, const sstring& param_name_prefix);
+            cql3::raw_value_view_vector& values, const sstring& param_name_prefix);
 
     /**
      * The actual trace message storing method.
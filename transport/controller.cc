@@ -91,6 +91,7 @@ future<> controller::do_start_server() {
         cql_server_config.max_request_size = _mem_limiter.local().total_memory();
         cql_server_config.allow_shard_aware_drivers = cfg.enable_shard_aware_drivers();
         cql_server_config.sharding_ignore_msb = cfg.murmur3_partitioner_ignore_msb_bits();
+        cql_server_config.min_compression_size = cfg.native_transport_min_compression_size();
         if (cfg.native_shard_aware_transport_port.is_set()) {
             // Needed for "SUPPORTED" message
             cql_server_config.shard_aware_transport_port = cfg.native_shard_aware_transport_port();
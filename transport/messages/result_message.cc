@@ -72,6 +72,12 @@ std::ostream& operator<<(std::ostream& os, const result_message::rows& msg) {
                 _os << fragment;
             });
         }
+        void accept_value(managed_bytes_view value) {
+            _os << " ";
+            for (bytes_view fragment : fragment_range(value)) {
+                _os << fragment;
+            }
+        }
         void end_row() { _os << "}"; }
     };
     msg.rs().visit(visitor { os });
@@ -153,7 +153,7 @@ public:
         return cql3::raw_value_view::make_value(_in.read_view(len, exception_thrower()));
     }
 
-    void read_name_and_value_list(uint8_t version, std::vector<sstring_view>& names, std::vector<cql3::raw_value_view>& values) {
+    void read_name_and_value_list(uint8_t version, std::vector<sstring_view>& names, cql3::raw_value_view_vector& values) {
         uint16_t size = read_short();
         names.reserve(size);
         values.reserve(size);
@@ -171,7 +171,7 @@ public:
         }
     }
 
-    void read_value_view_list(uint8_t version, std::vector<cql3::raw_value_view>& values) {
+    void read_value_view_list(uint8_t version, cql3::raw_value_view_vector& values) {
         uint16_t size = read_short();
         values.reserve(size);
         for (uint16_t i = 0; i < size; i++) {
@@ -220,14 +220,14 @@ public:
     std::unique_ptr<cql3::query_options> read_options(uint8_t version, cql_serialization_format cql_ser_format, const cql3::cql_config& cql_config) {
         auto consistency = read_consistency();
         if (version == 1) {
-            return std::make_unique<cql3::query_options>(cql_config, consistency, std::nullopt, std::vector<cql3::raw_value_view>{},
+            return std::make_unique<cql3::query_options>(cql_config, consistency, std::nullopt, cql3::raw_value_view_vector{},
                 false, cql3::query_options::specific_options::DEFAULT, cql_ser_format);
         }
 
         assert(version >= 2);
 
         auto flags = enum_set<options_flag_enum>::from_mask(read_byte());
-        std::vector<cql3::raw_value_view> values;
+        cql3::raw_value_view_vector values;
         std::vector<sstring_view> names;
 
         if (flags.contains<options_flag::VALUES>()) {
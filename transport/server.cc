@@ -159,6 +159,7 @@ cql_server::cql_server(distributed<cql3::query_processor>& qp, auth::service& au
     , _config(config)
     , _max_request_size(config.max_request_size)
     , _max_concurrent_requests(db_cfg.max_concurrent_requests_per_shard)
+    , _memory_limiter(ml)
     , _memory_available(ml.get_semaphore())
     , _notifier(std::make_unique<event_notifier>(*this))
     , _auth_service(auth_service)
@@ -218,7 +219,16 @@ cql_server::cql_server(distributed<cql3::query_processor>& qp, auth::service& au
         sm::make_gauge("requests_memory_available", [this] { return _memory_available.current(); },
                         sm::description(
                             seastar::format("Holds the amount of available memory for admitting new requests (max is {}B)."
-                                            "Zero value indicates that our bottleneck is memory and more specifically - the memory quota allocated for the \"CQL transport\" component.", _max_request_size)))
+                                            "Zero value indicates that our bottleneck is memory and more specifically - the memory quota allocated for the \"CQL transport\" component.", _max_request_size))),
+
+        sm::make_gauge("batch_requests_blocked_memory_current",
+                        [this] { return _memory_limiter.get_semaphore(service::memory_limiter::admission_class::batch).waiters(); },
+                        sm::description("Holds the number of batch-workload requests that are currently blocked on the batch share of the memory quota. "
+                                        "Non-zero value indicates that batch ingestion is throttled; interactive requests are admitted from a separate share and are not affected.")),
+
+        sm::make_gauge("batch_requests_memory_available",
+                        [this] { return _memory_limiter.get_semaphore(service::memory_limiter::admission_class::batch).current(); },
+                        sm::description("Holds the amount of memory available for admitting new batch-workload requests."))
     };
 
     std::vector<sm::metric_definition> transport_metrics;
@@ -611,12 +621,22 @@ future<> cql_server::connection::process_request() {
             tracing_requested = tracing_request_type::no_write_on_close;
         }
 
+        // Admit the request against its service level's share of the memory
+        // budget, so batch ingestion queues behind other batch work instead
+        // of starving interactive tenants (and vice versa).
+        const auto admission_class = _client_state.get_workload_type() == service::client_state::workload_type::batch
+                ? service::memory_limiter::admission_class::batch
+                : service::memory_limiter::admission_class::interactive;
+
         auto op = f.opcode;
         auto stream = f.stream;
         auto mem_estimate = f.length * 2 + 8000; // Allow for extra copies and bookkeeping
-        if (mem_estimate > _server._max_request_size) {
+        // A request larger than its class's entire share could never be
+        // admitted, so reject it up front.
+        const auto max_admissible_size = std::min(_server._max_request_size, _server._memory_limiter.total_memory(admission_class));
+        if (mem_estimate > max_admissible_size) {
             write_response(make_error(stream, exceptions::exception_code::INVALID,
-                    format("request size too large (frame size {:d}; estimate {:d}; allowed {:d}", f.length, mem_estimate, _server._max_request_size),
+                    format("request size too large (frame size {:d}; estimate {:d}; allowed {:d}", f.length, mem_estimate, max_admissible_size),
                     tracing::trace_state_ptr()));
             return std::exchange(_ready_to_respond, make_ready_future<>()).then([this] {
                 return _read_buf.close();
@@ -633,9 +653,11 @@ future<> cql_server::connection::process_request() {
             });
         }
 
+        auto& memory_available = _server._memory_limiter.get_semaphore(admission_class);
+
         const auto shedding_timeout = std::chrono::milliseconds(50);
         auto fut = allow_shedding
-                ? get_units(_server._memory_available, mem_estimate, shedding_timeout).then_wrapped([this, length = f.length] (auto f) {
+                ? get_units(memory_available, mem_estimate, shedding_timeout).then_wrapped([this, length = f.length] (auto f) {
                     try {
                         return make_ready_future<semaphore_units<>>(f.get0());
                     } catch (semaphore_timed_out sto) {
@@ -648,8 +670,8 @@ future<> cql_server::connection::process_request() {
                         });
                     }
                 })
-                : get_units(_server._memory_available, mem_estimate);
-        if (_server._memory_available.waiters()) {
+                : get_units(memory_available, mem_estimate);
+        if (memory_available.waiters()) {
             if (allow_shedding && !_shedding_timer.armed()) {
                 _shedding_timer.arm(shedding_timeout);
             }
@@ -1004,7 +1026,7 @@ process_execute_internal(service::client_state& client_state, distributed<cql3::
     auto q_state = std::make_unique<cql_query_state>(client_state, trace_state, std::move(permit));
     auto& query_state = q_state->query_state;
     if (version == 1) {
-        std::vector<cql3::raw_value_view> values;
+        cql3::raw_value_view_vector values;
         in.read_value_view_list(version, values);
         auto consistency = in.read_consistency();
         q_state->options = std::make_unique<cql3::query_options>(qp.local().get_cql_config(), consistency, std::nullopt, values, false,
@@ -1075,7 +1097,7 @@ process_batch_internal(service::client_state& client_state, distributed<cql3::qu
     const unsigned n = in.read_short();
 
     std::vector<cql3::statements::batch_statement::single_statement> modifications;
-    std::vector<std::vector<cql3::raw_value_view>> values;
+    std::vector<cql3::raw_value_view_vector> values;
     std::unordered_map<cql3::prepared_cache_key_type, cql3::authorized_prepared_statements_cache::value_type> pending_authorization_entries;
 
     modifications.reserve(n);
@@ -1140,7 +1162,7 @@ process_batch_internal(service::client_state& client_state, distributed<cql3::qu
 
         modifications.emplace_back(std::move(modif_statement_ptr), needs_authorization);
 
-        std::vector<cql3::raw_value_view> tmp;
+        cql3::raw_value_view_vector tmp;
         in.read_value_view_list(version, tmp);
 
         auto stmt = ps->statement;
@@ -1436,6 +1458,9 @@ public:
             void accept_value(std::optional<query::result_bytes_view> cell) {
                 _response.write_value(cell);
             }
+            void accept_value(managed_bytes_view cell) {
+                _response.write_value(cell);
+            }
             void end_row() { }
 
             int64_t row_count() const { return _row_count; }
@@ -1491,11 +1516,34 @@ cql_server::connection::make_schema_change_event(const event::schema_change& eve
 
 void cql_server::connection::write_response(foreign_ptr<std::unique_ptr<cql_server::response>>&& response, service_permit permit, cql_compression compression)
 {
-    _ready_to_respond = _ready_to_respond.then([this, compression, response = std::move(response), permit = std::move(permit)] () mutable {
+    ++_pending_responses;
+    if (compression != cql_compression::none && response->size() < _server._config.min_compression_size) {
+        // The compression flag is per-frame, so tiny responses can simply be
+        // sent uncompressed - compressing them costs more than it saves.
+        compression = cql_compression::none;
+    }
+    // A response can be much larger than the request that produced it - a
+    // small SELECT may return a multi-MB page - and responses queue up here
+    // while a slow client drains its socket, charged only with their
+    // request's small memory permit. Debit the queued body from the memory
+    // pool, too: consume() never blocks, the stall happens at the
+    // request-read loop, which won't admit new requests until the backlog
+    // is written out.
+    auto response_size = response->size();
+    _server._memory_available.consume(response_size);
+    auto release = defer([this, response_size] () noexcept { _server._memory_available.signal(response_size); });
+    _ready_to_respond = _ready_to_respond.then([this, compression, response = std::move(response), permit = std::move(permit), release = std::move(release)] () mutable {
         auto message = response->make_message(_version, compression);
         message.on_delete([response = std::move(response)] { });
-        return _write_buf.write(std::move(message)).then([this] {
-            return _write_buf.flush();
+        return _write_buf.write(std::move(message)).finally([release = std::move(release)] {}).then([this] {
+            // Flush only once the last enqueued response has been written, so
+            // that responses completing in the same reactor poll are coalesced
+            // into a single socket write (and a single TCP segment when they
+            // fit). Requests completing later enqueue their own flush.
+            if (--_pending_responses == 0) {
+                return _write_buf.flush();
+            }
+            return make_ready_future<>();
         });
     });
 }
@@ -1772,6 +1820,14 @@ void cql_server::response::write_value(std::optional<query::result_bytes_view> v
     });
 }
 
+void cql_server::response::write_value(managed_bytes_view value)
+{
+    write_int(value.size_bytes());
+    for (bytes_view fragment : fragment_range(value)) {
+        _body.write(fragment);
+    }
+}
+
 class type_codec {
 private:
     enum class type_id : int16_t {
@@ -1912,23 +1968,34 @@ void cql_server::response::write(const cql3::metadata& m, bool no_metadata) {
         return;
     }
 
-    auto names_i = m.get_names().begin();
-
-    if (global_tables_spec) {
-        auto first_spec = *names_i;
-        write_string(first_spec->ks_name);
-        write_string(first_spec->cf_name);
-    }
+    auto& encoded_specs = m.encoded_column_specs();
+    if (!encoded_specs) {
+        // Encode the column specifications once, into a scratch response,
+        // and keep the bytes in the statement's shared column_info. Every
+        // following response of the same statement appends the ready-made
+        // buffer below instead of re-encoding each column specification -
+        // for narrow queries this section is a large share of the response.
+        response scratch(_stream, _opcode, tracing::trace_state_ptr());
+        auto names_i = m.get_names().begin();
+
+        if (global_tables_spec) {
+            auto first_spec = *names_i;
+            scratch.write_string(first_spec->ks_name);
+            scratch.write_string(first_spec->cf_name);
+        }
 
-    for (uint32_t i = 0; i < m.column_count(); ++i, ++names_i) {
-        lw_shared_ptr<cql3::column_specification> name = *names_i;
-        if (!global_tables_spec) {
-            write_string(name->ks_name);
-            write_string(name->cf_name);
+        for (uint32_t i = 0; i < m.column_count(); ++i, ++names_i) {
+            lw_shared_ptr<cql3::column_specification> name = *names_i;
+            if (!global_tables_spec) {
+                scratch.write_string(name->ks_name);
+                scratch.write_string(name->cf_name);
+            }
+            scratch.write_string(name->name->text());
+            type_codec::encode(scratch, name->type);
         }
-        write_string(name->name->text());
-        type_codec::encode(*this, name->type);
+        encoded_specs = to_bytes(scratch._body.linearize());
     }
+    _body.write(bytes_view(*encoded_specs));
 }
 
 void cql_server::response::write(const cql3::prepared_metadata& m, uint8_t version)
@@ -120,7 +120,11 @@ struct cql_query_state {
 
     cql_query_state(service::client_state& client_state, tracing::trace_state_ptr trace_state_ptr, service_permit permit)
         : query_state(client_state, std::move(trace_state_ptr), std::move(permit))
-    { }
+    {
+        // The transport keeps the raw frame around and can replay it on
+        // another shard (see connection::process_on_shard()).
+        query_state.set_bounce_to_shard_allowed(true);
+    }
 };
 
 struct cql_server_config {
@@ -131,6 +135,9 @@ struct cql_server_config {
     std::optional<uint16_t> shard_aware_transport_port;
     std::optional<uint16_t> shard_aware_transport_port_ssl;
     bool allow_shard_aware_drivers = true;
+    // Responses smaller than this are sent uncompressed even when the client
+    // negotiated compression, as the compression overhead exceeds the savings.
+    size_t min_compression_size = 64;
     smp_service_group bounce_request_smp_service_group = default_smp_service_group();
 };
 
@@ -166,6 +173,9 @@ private:
     cql_server_config _config;
     size_t _max_request_size;
     utils::updateable_value<uint32_t> _max_concurrent_requests;
+    service::memory_limiter& _memory_limiter;
+    // The interactive admission class share; responses are accounted here
+    // regardless of the request's class.
     semaphore& _memory_available;
     seastar::metrics::metric_groups _metrics;
     std::unique_ptr<event_notifier> _notifier;
@@ -202,6 +212,10 @@ private:
         timer<lowres_clock> _shedding_timer;
         bool _shed_incoming_requests = false;
         unsigned _request_cpu = 0;
+        // Responses enqueued to _ready_to_respond but not yet flushed. The
+        // output stream is flushed only when this drops to zero, so responses
+        // completing in one burst are written to the socket together.
+        size_t _pending_responses = 0;
 
         enum class tracing_request_type : uint8_t {
             not_requested,
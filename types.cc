@@ -853,6 +853,24 @@ struct is_byte_order_equal_visitor {
 
 bool abstract_type::is_byte_order_equal() const { return visit(*this, is_byte_order_equal_visitor{}); }
 
+namespace {
+// Types whose compare() orders serialized values the same way as unsigned
+// memcmp. Signed integral types don't qualify because negative values have
+// the sign bit set, nor do floats, timeuuids and uuids, which compare
+// selected bits before the rest of the value.
+struct is_byte_order_comparable_visitor {
+    bool operator()(const abstract_type&) { return false; }
+    bool operator()(const boolean_type_impl&) { return true; }
+    bool operator()(const string_type_impl&) { return true; }
+    bool operator()(const bytes_type_impl&) { return true; }
+    bool operator()(const date_type_impl&) { return true; }
+    bool operator()(const simple_date_type_impl&) { return true; }
+    bool operator()(const reversed_type_impl& t) { return t.underlying_type()->is_byte_order_comparable(); }
+};
+}
+
+bool abstract_type::is_byte_order_comparable() const { return visit(*this, is_byte_order_comparable_visitor{}); }
+
 static bool
 check_compatibility(const tuple_type_impl &t, const abstract_type& previous, bool (abstract_type::*predicate)(const abstract_type&) const);
 
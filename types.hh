@@ -568,6 +568,14 @@ public:
      * When returns false, nothing can be inferred.
      */
     bool is_byte_order_equal() const;
+
+    /**
+     * When returns true then comparing the byte representations of two values
+     * with unsigned memcmp orders them the same way as compare() does.
+     *
+     * When returns false, nothing can be inferred.
+     */
+    bool is_byte_order_comparable() const;
     sstring get_string(const bytes& b) const;
     sstring to_string(bytes_view bv) const {
         return to_string_impl(deserialize(bv));
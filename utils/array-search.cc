@@ -139,7 +139,7 @@ arch_target("avx2") unsigned array_search_x32_eq_impl(uint8_t val, const uint8_t
     unsigned len = 32 * nr;
     auto a = _mm256_set1_epi8(val);
     for (unsigned off = 0; off < len; off += 32) {
-        auto b = _mm256_lddqu_si256((__m256i*)arr);
+        auto b = _mm256_lddqu_si256((__m256i*)(arr + off));
         auto c = _mm256_cmpeq_epi8(a, b);
         unsigned m = _mm256_movemask_epi8(c);
         if (m != 0) {
@@ -149,6 +149,53 @@ arch_target("avx2") unsigned array_search_x32_eq_impl(uint8_t val, const uint8_t
     return len;
 }
 
+/*
+ * The AVX-512 version eats 8 keys per compare and gets the greater-than
+ * predicate back (see the grumble above), so the result is just the
+ * number of matches counted from the tail of the used part. The tail
+ * chunk of 4 (capacity is only guaranteed to be a multiple of 4) goes
+ * through the same compare with the upper lanes masked off.
+ */
+arch_target("avx512f") int array_search_gt_impl(int64_t val, const int64_t* array, const int capacity, const int size) {
+    int cnt = 0;
+
+    __m512i k = _mm512_set1_epi64(val);
+    int i = 0;
+    for (; i + 8 <= capacity; i += 8) {
+        cnt += __builtin_popcount(_mm512_cmpgt_epi64_mask(_mm512_loadu_si512((const void*)&array[i]), k));
+    }
+    if (i < capacity) {
+        auto v = _mm512_maskz_loadu_epi64(0x0f, (const void*)&array[i]);
+        cnt += __builtin_popcount(_mm512_mask_cmpgt_epi64_mask(0x0f, v, k));
+    }
+
+    return size - cnt;
+}
+
+/*
+ * AVX-512BW version -- one compare covers two 32-byte rows, with a
+ * half-masked compare for an odd trailing row.
+ */
+arch_target("avx512bw") unsigned array_search_x32_eq_impl(uint8_t val, const uint8_t* arr, int nr) {
+    unsigned len = 32 * nr;
+    auto a = _mm512_set1_epi8(val);
+    unsigned off = 0;
+    for (; off + 64 <= len; off += 64) {
+        uint64_t m = _mm512_cmpeq_epi8_mask(_mm512_loadu_si512((const void*)(arr + off)), a);
+        if (m != 0) {
+            return __builtin_ctzll(m) + off;
+        }
+    }
+    if (off < len) {
+        auto b = _mm512_maskz_loadu_epi8(0xffffffffull, (const void*)(arr + off));
+        uint64_t m = _mm512_cmpeq_epi8_mask(b, a) & 0xffffffffull;
+        if (m != 0) {
+            return __builtin_ctzll(m) + off;
+        }
+    }
+    return len;
+}
+
 #endif
 
 int array_search_gt(int64_t val, const int64_t* array, const int capacity, const int size) {
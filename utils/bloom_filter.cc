@@ -68,6 +68,22 @@ void for_each_index(hashed_key hk, int count, int64_t max, filter_format format,
     }
 }
 
+// m_blocked_format: one hash selects a cache-line-sized block, double hashing
+// derives all probes within it, so a lookup touches a single cache line of
+// the bitmap no matter how many hashes the filter uses.
+template<typename Func>
+void for_each_block_index(hashed_key hk, int count, int64_t max, Func&& func) {
+    auto h = hk.hash();
+    const auto block_count = uint64_t(max) / bloom_filter::block_bits;
+    const int64_t base = int64_t(h[1] % block_count) * bloom_filter::block_bits;
+    for (int i = 0; i < count; i++) {
+        auto bit = (h[0] + uint64_t(i) * h[1]) % bloom_filter::block_bits;
+        if (func(base + int64_t(bit)) == stop_iteration::yes) {
+            break;
+        }
+    }
+}
+
 bloom_filter::bloom_filter(int hashes, bitmap&& bs, filter_format format) noexcept
     : _bitset(std::move(bs))
     , _hash_count(hashes)
@@ -82,21 +98,31 @@ bloom_filter::~bloom_filter() noexcept {
 
 bool bloom_filter::is_present(hashed_key key) {
     bool result = true;
-    for_each_index(key, _hash_count, _bitset.size(), _format, [this, &result] (auto i) {
+    auto tester = [this, &result] (auto i) {
         if (!_bitset.test(i)) {
             result = false;
             return stop_iteration::yes;
         }
         return stop_iteration::no;
-    });
+    };
+    if (_format == filter_format::m_blocked_format) {
+        for_each_block_index(key, _hash_count, _bitset.size(), tester);
+    } else {
+        for_each_index(key, _hash_count, _bitset.size(), _format, tester);
+    }
     return result;
 }
 
 void bloom_filter::add(const bytes_view& key) {
-    for_each_index(make_hashed_key(key), _hash_count, _bitset.size(), _format, [this] (auto i) {
+    auto setter = [this] (auto i) {
         _bitset.set(i);
         return stop_iteration::no;
-    });
+    };
+    if (_format == filter_format::m_blocked_format) {
+        for_each_block_index(make_hashed_key(key), _hash_count, _bitset.size(), setter);
+    } else {
+        for_each_index(make_hashed_key(key), _hash_count, _bitset.size(), _format, setter);
+    }
 }
 
 bool bloom_filter::is_present(const bytes_view& key) {
@@ -110,6 +136,10 @@ filter_ptr create_filter(int hash, large_bitset&& bitset, filter_format format)
 filter_ptr create_filter(int hash, int64_t num_elements, int buckets_per, filter_format format) {
     int64_t num_bits = (num_elements * buckets_per) + bloom_calculations::EXCESS;
     num_bits = align_up<int64_t>(num_bits, 64);  // Seems to be implied in origin
+    if (format == filter_format::m_blocked_format) {
+        // The bitmap must be a whole number of blocks.
+        num_bits = align_up<int64_t>(num_bits, bloom_filter::block_bits);
+    }
     large_bitset bitset(num_bits);
     return std::make_unique<murmur3_bloom_filter>(hash, std::move(bitset), format);
 }
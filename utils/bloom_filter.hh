@@ -55,6 +55,9 @@ class bloom_filter: public i_filter {
 public:
     using bitmap = large_bitset;
 
+    // Block size of filter_format::m_blocked_format, in bits. One cache line.
+    static constexpr int64_t block_bits = 512;
+
 private:
     bitmap _bitset;
     int _hash_count;
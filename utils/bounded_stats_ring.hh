@@ -0,0 +1,90 @@
+/*
+ * Copyright (C) 2021-present ScyllaDB
+ */
+
+/*
+ * This file is part of Scylla.
+ *
+ * Scylla is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Scylla is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Scylla.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <vector>
+
+namespace utils {
+
+/**
+ * Fixed-capacity ring buffer of samples with incrementally maintained sum
+ * and sum of squares, so mean() and variance() are O(1). The buffer is
+ * allocated once at construction; add() never allocates.
+ */
+class bounded_stats_ring {
+private:
+    std::vector<long> _ring;
+    size_t _head = 0; // index of the oldest sample
+    size_t _size = 0;
+    long _sum = 0;
+    double _sum_sq = 0;
+public:
+    explicit bounded_stats_ring(size_t capacity)
+        : _ring(capacity) {
+    }
+
+    size_t size() const {
+        return _size;
+    }
+
+    void add(long i) {
+        if (_size == _ring.size()) {
+            auto& oldest = _ring[_head];
+            _sum -= oldest;
+            _sum_sq -= double(oldest) * oldest;
+            oldest = i;
+            _head = (_head + 1) % _ring.size();
+        } else {
+            _ring[(_head + _size) % _ring.size()] = i;
+            ++_size;
+        }
+        _sum += i;
+        _sum_sq += double(i) * i;
+    }
+
+    long sum() const {
+        return _sum;
+    }
+
+    double mean() const {
+        return _size > 0 ? double(_sum) / _size : 0;
+    }
+
+    // Population variance of the samples currently in the window.
+    double variance() const {
+        if (_size == 0) {
+            return 0;
+        }
+        auto m = mean();
+        // Clamp, since the incremental form can go slightly negative due
+        // to floating-point rounding.
+        return std::max(0.0, _sum_sq / _size - m * m);
+    }
+
+    // The idx-th sample, oldest first. idx must be < size().
+    long operator[](size_t idx) const {
+        return _ring[(_head + idx) % _ring.size()];
+    }
+};
+
+}
@@ -0,0 +1,160 @@
+/*
+ * Copyright (C) 2021-present ScyllaDB
+ */
+
+/*
+ * This file is part of Scylla.
+ *
+ * Scylla is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Scylla is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Scylla.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "utils/cpu_profiler.hh"
+
+#include <seastar/util/backtrace.hh>
+
+#include <algorithm>
+#include <map>
+#include <system_error>
+
+#include <pthread.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#ifndef sigev_notify_thread_id
+#define sigev_notify_thread_id _sigev_un._tid
+#endif
+
+namespace utils {
+
+// The signal used for sampling. SIGPROF is reserved for profiling and not
+// used by seastar (the stall detector uses a real-time signal).
+static constexpr int sampling_signal = SIGPROF;
+
+// The profiler owned by this shard's thread, for the signal handler.
+static thread_local cpu_profiler* local_profiler = nullptr;
+
+void cpu_profiler::signal_handler(int, siginfo_t*, void*) {
+    // Async-signal-safe: only frame walking and writes to the ring buffer.
+    auto* p = local_profiler;
+    if (!p || !p->_running) {
+        return;
+    }
+    auto& s = p->_samples[p->_head % max_samples];
+    s.sched_group = current_scheduling_group();
+    s.depth = 0;
+    backtrace([&s] (frame f) {
+        if (s.depth < max_depth) {
+            s.frames[s.depth++] = f.addr;
+        }
+    });
+    // Publish the slot only once it is fully written.
+    ++p->_head;
+}
+
+static void block_sampling_signal(bool block) {
+    sigset_t mask;
+    sigemptyset(&mask);
+    sigaddset(&mask, sampling_signal);
+    pthread_sigmask(block ? SIG_BLOCK : SIG_UNBLOCK, &mask, nullptr);
+}
+
+void cpu_profiler::start(std::chrono::milliseconds period) {
+    if (_running) {
+        stop();
+    }
+    struct sigaction sa{};
+    sa.sa_sigaction = &cpu_profiler::signal_handler;
+    sa.sa_flags = SA_SIGINFO | SA_RESTART;
+    if (sigaction(sampling_signal, &sa, nullptr) != 0) {
+        throw std::system_error(errno, std::system_category(), "sigaction");
+    }
+    if (!_samples) {
+        _samples = std::make_unique<sample[]>(max_samples);
+    }
+    local_profiler = this;
+
+    // A timer on this thread's CPU clock, delivering the signal to this
+    // thread only, so each shard samples and buffers independently.
+    sigevent sev{};
+    sev.sigev_notify = SIGEV_THREAD_ID;
+    sev.sigev_signo = sampling_signal;
+    sev.sigev_notify_thread_id = syscall(SYS_gettid);
+    if (timer_create(CLOCK_THREAD_CPUTIME_ID, &sev, &_timer) != 0) {
+        throw std::system_error(errno, std::system_category(), "timer_create");
+    }
+    auto secs = std::chrono::duration_cast<std::chrono::seconds>(period);
+    auto nsecs = std::chrono::duration_cast<std::chrono::nanoseconds>(period - secs);
+    itimerspec its{};
+    its.it_interval.tv_sec = secs.count();
+    its.it_interval.tv_nsec = nsecs.count();
+    its.it_value = its.it_interval;
+    _period = period;
+    _running = true;
+    if (timer_settime(_timer, 0, &its, nullptr) != 0) {
+        auto saved = errno;
+        stop();
+        throw std::system_error(saved, std::system_category(), "timer_settime");
+    }
+}
+
+void cpu_profiler::stop() {
+    if (!_running) {
+        return;
+    }
+    _running = false;
+    timer_delete(_timer);
+    // A signal may have been queued before the timer was deleted; the
+    // handler bails out on !_running, written above on the same thread.
+}
+
+cpu_profiler::~cpu_profiler() {
+    stop();
+    if (local_profiler == this) {
+        local_profiler = nullptr;
+    }
+}
+
+cpu_profiler::profile cpu_profiler::drain() {
+    profile result;
+    if (!_samples) {
+        return result;
+    }
+    block_sampling_signal(true);
+    auto head = _head;
+    auto first = _drained;
+    if (head - first > max_samples) {
+        result.dropped = head - first - max_samples;
+        first = head - max_samples;
+    }
+    std::map<std::pair<sstring, std::vector<uintptr_t>>, uint64_t> merged;
+    for (auto i = first; i < head; ++i) {
+        auto& s = _samples[i % max_samples];
+        auto frames = std::vector<uintptr_t>(s.frames, s.frames + s.depth);
+        ++merged[std::make_pair(s.sched_group.name(), std::move(frames))];
+    }
+    _drained = head;
+    block_sampling_signal(false);
+    result.stacks.reserve(merged.size());
+    for (auto& [key, count] : merged) {
+        result.stacks.push_back(stack_count{key.first, key.second, count});
+    }
+    return result;
+}
+
+cpu_profiler& get_local_cpu_profiler() {
+    static thread_local cpu_profiler the_profiler;
+    return the_profiler;
+}
+
+}
@@ -0,0 +1,106 @@
+/*
+ * Copyright (C) 2021-present ScyllaDB
+ */
+
+/*
+ * This file is part of Scylla.
+ *
+ * Scylla is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Scylla is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Scylla.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <seastar/core/scheduling.hh>
+#include <seastar/core/sstring.hh>
+
+#include "seastarx.hh"
+
+#include <chrono>
+#include <csignal>
+#include <ctime>
+#include <memory>
+#include <vector>
+
+namespace utils {
+
+// A per-shard sampling CPU profiler.
+//
+// When started, a POSIX timer on the shard thread's CPU-time clock delivers
+// a signal every sampling period of on-CPU time. The signal handler records
+// the current call stack and scheduling group into a fixed-size per-shard
+// ring buffer; draining the buffer merges the samples by call stack. The
+// timer counts CPU time, not wall-clock time, so idle shards take no
+// samples and the overhead is proportional to actual load.
+//
+// Frame addresses are recorded as the runtime addresses seastar prints in
+// its own stall reports, so the same offline symbolization tooling applies.
+class cpu_profiler {
+public:
+    static constexpr unsigned max_depth = 24;
+    // Must be a power of two. At the default 10ms period this buffers over
+    // ten seconds of samples on a fully busy shard.
+    static constexpr unsigned max_samples = 1024;
+
+    // One call stack observed on this shard, merged over all samples that
+    // shared it, attributed to the scheduling group it ran in.
+    struct stack_count {
+        sstring sched_group_name;
+        std::vector<uintptr_t> frames;
+        uint64_t count;
+    };
+
+    struct profile {
+        std::vector<stack_count> stacks;
+        // Samples overwritten in the ring buffer before they were drained.
+        uint64_t dropped = 0;
+    };
+
+private:
+    struct sample {
+        scheduling_group sched_group;
+        unsigned depth;
+        uintptr_t frames[max_depth];
+    };
+
+    timer_t _timer{};
+    bool _running = false;
+    std::chrono::milliseconds _period{0};
+    // Written only by the signal handler; drained with the signal blocked.
+    std::unique_ptr<sample[]> _samples;
+    uint64_t _head = 0;    // total samples taken; next slot is _head % max_samples
+    uint64_t _drained = 0; // value of _head at the last drain
+
+public:
+    ~cpu_profiler();
+
+    // (Re)starts sampling on this shard with the given period of on-CPU
+    // time. Throws std::system_error if the timer cannot be created.
+    void start(std::chrono::milliseconds period);
+    void stop();
+    bool running() const { return _running; }
+    std::chrono::milliseconds period() const { return _period; }
+
+    // Removes and returns the samples buffered on this shard since the last
+    // drain, merged by call stack. May be called whether or not the
+    // profiler is running.
+    profile drain();
+
+private:
+    static void signal_handler(int, siginfo_t*, void*);
+};
+
+// The profiler of the calling shard.
+cpu_profiler& get_local_cpu_profiler();
+
+}
@@ -380,6 +380,21 @@ inline time_estimated_histogram time_estimated_histogram_merge(time_estimated_hi
     return a.merge(b);
 }
 
+/*!
+ * \brief estimated histogram for small event counts (e.g. number of retries or
+ * contending requests). With a precision of 1 the buckets are exactly the
+ * powers of two: 1, 2, 4 ... 128, with everything above collected by the
+ * infinity bucket. Unlike utils::estimated_histogram the bucket index is
+ * computed with bit tricks, so adding a value costs no boundary search.
+ */
+class count_estimated_histogram : public approx_exponential_histogram<1, 128, 1> {
+public:
+    count_estimated_histogram& merge(const count_estimated_histogram& b) {
+        approx_exponential_histogram<1, 128, 1>::merge(b);
+        return *this;
+    }
+};
+
 struct estimated_histogram {
     using clock = std::chrono::steady_clock;
     using duration = clock::duration;
@@ -66,6 +66,12 @@ public:
     size_t size_bytes() const { return _size_bytes; }
     bool empty() const { return !_size_bytes; }
 
+    // Gives up ownership of the fragments, e.g. so that they can be reused.
+    std::vector<seastar::temporary_buffer<char>> release() && noexcept {
+        _size_bytes = 0;
+        return std::move(_fragments);
+    }
+
     // Linear complexity, invalidates views and istreams
     void remove_prefix(size_t n) noexcept {
         _size_bytes -= n;
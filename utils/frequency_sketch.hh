@@ -0,0 +1,123 @@
+/*
+ * Copyright (C) 2021-present ScyllaDB
+ */
+
+/*
+ * This file is part of Scylla.
+ *
+ * Scylla is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Scylla is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Scylla.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace utils {
+
+// A TinyLFU-style frequency sketch: a count-min sketch of 4-bit saturating
+// counters with periodic aging, as described in
+// "TinyLFU: A Highly Efficient Cache Admission Policy" (Einziger et al.).
+//
+// Tracks approximate access frequencies of a population of keys identified
+// by a 64-bit hash, in constant space. Once the number of recorded accesses
+// reaches the sample size, all counters are halved, so that estimates decay
+// and reflect recent popularity rather than the whole history.
+//
+// Estimates can over-count due to hash collisions, but never under-count
+// (modulo aging and counter saturation at 15).
+class frequency_sketch {
+    // Each uint64_t holds 16 4-bit counters. A key maps to one 64-byte
+    // aligned block of 8 words, and to one counter in each of 4 of those
+    // words, so that a single increment/estimate touches one cache line.
+    std::vector<uint64_t> _table;
+    uint64_t _mask; // Number of 8-word blocks, minus one. Power of two minus one.
+    uint64_t _accesses = 0;
+    uint64_t _sample_size;
+
+    static uint64_t mix(uint64_t h) noexcept {
+        // 64-bit finalizer from MurmurHash3.
+        h ^= h >> 33;
+        h *= 0xff51afd7ed558ccdull;
+        h ^= h >> 33;
+        h *= 0xc4ceb9fe1a85ec53ull;
+        h ^= h >> 33;
+        return h;
+    }
+
+    // Returns the index of the word and the bit offset of the i-th counter
+    // for the given hash.
+    std::pair<size_t, unsigned> counter_of(uint64_t h, unsigned i) const noexcept {
+        auto block = (h & _mask) * 8;
+        auto selector = h >> 32;
+        // Pick one of the 8 words and one of the 16 counters in it.
+        auto word = block + ((selector >> (i * 8)) & 7);
+        auto offset = ((selector >> (i * 8 + 3)) & 15) * 4;
+        return {word, unsigned(offset)};
+    }
+
+    void age() noexcept {
+        for (auto& w : _table) {
+            // Halve each 4-bit counter.
+            w = (w >> 1) & 0x7777777777777777ull;
+        }
+        _accesses /= 2;
+    }
+
+public:
+    // Creates a sketch able to track approximately `capacity` keys.
+    explicit frequency_sketch(size_t capacity) {
+        size_t blocks = 1;
+        while (blocks * 16 * 8 < capacity) {
+            blocks *= 2;
+        }
+        _table.resize(blocks * 8);
+        _mask = blocks - 1;
+        _sample_size = capacity * 10;
+    }
+
+    // Records an access to the key with the given hash.
+    void increment(uint64_t hash) noexcept {
+        auto h = mix(hash);
+        bool incremented = false;
+        for (unsigned i = 0; i < 4; ++i) {
+            auto [word, offset] = counter_of(h, i);
+            auto counter = (_table[word] >> offset) & 15;
+            if (counter < 15) {
+                _table[word] += uint64_t(1) << offset;
+                incremented = true;
+            }
+        }
+        if (incremented && ++_accesses >= _sample_size) {
+            age();
+        }
+    }
+
+    // Returns the estimated access frequency of the key with the given hash.
+    unsigned estimate(uint64_t hash) const noexcept {
+        auto h = mix(hash);
+        unsigned result = 15;
+        for (unsigned i = 0; i < 4; ++i) {
+            auto [word, offset] = counter_of(h, i);
+            result = std::min(result, unsigned((_table[word] >> offset) & 15));
+        }
+        return result;
+    }
+
+    size_t memory_size() const noexcept {
+        return _table.size() * sizeof(uint64_t);
+    }
+};
+
+}
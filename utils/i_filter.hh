@@ -51,6 +51,12 @@ using filter_ptr = std::unique_ptr<i_filter>;
 enum class filter_format {
     k_l_format,
     m_format,
+    // Same hashing as m_format, but all of a key's bits fall into a single
+    // cache-line-sized block of the bitmap, so a lookup costs one cache miss
+    // instead of one per hash. Slightly worse false positive rate for the
+    // same bitmap size. Scylla-specific on-disk layout; readers detect it
+    // via sstable_feature::BlockedBloomFilter.
+    m_blocked_format,
 };
 
 class hashed_key {
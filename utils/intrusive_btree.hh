@@ -1084,11 +1084,19 @@ struct searcher<K, Key, Hook, Compare, key_search::linear> {
     static key_index ge(const K& k, const node_base& node, const Compare& cmp, bool& match) {
         key_index i;
 
+        /*
+         * Keys are out-of-node objects, so every comparison below starts
+         * with a dependent cache miss. The keys[] array itself is already
+         * in cache, and to_key() is pure pointer arithmetics, so issue the
+         * prefetches for all keys up front to let their fetches overlap
+         * instead of serializing one per comparison.
+         */
+        for (i = 0; i < node.num_keys; i++) {
+            __builtin_prefetch(node.keys[i]->to_key<Key, Hook>());
+        }
+
         match = false;
         for (i = 0; i < node.num_keys; i++) {
-            if (i + 1 < node.num_keys) {
-                __builtin_prefetch(node.keys[i + 1]->to_key<Key, Hook>());
-            }
             auto x = cmp(k, *node.keys[i]->to_key<Key, Hook>());
             if (x <= 0) {
                 match = x == 0;
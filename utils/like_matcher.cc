@@ -22,99 +22,165 @@
 
 
 #include "like_matcher.hh"
+#include "utils/utf8.hh"
 
-#include <boost/regex/icu.hpp>
-#include <boost/locale/encoding.hpp>
-#include <string>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+#include <vector>
 
 namespace {
 
-using std::wstring;
+/// A compiled pattern is a sequence of elements, each either a literal byte
+/// run, a single-character wildcard ('_') or an any-substring wildcard ('%').
+/// Matching walks the elements with the classic greedy wildcard algorithm:
+/// on a mismatch, the last '%' seen extends by one byte and the elements
+/// after it retry.  Because a literal right after a '%' can only match at the
+/// positions where it occurs in the text, the retry jumps between those
+/// occurrences with a substring search instead of re-checking every offset;
+/// a '%literal%' pattern thus degenerates into a single substring scan.
+struct pattern_element {
+    enum class kind : uint8_t {
+        literal,     ///< Matches its bytes verbatim.
+        single_char, ///< '_': matches exactly one character.
+        any_string,  ///< '%': matches any substring, including an empty one.
+    };
+    kind k;
+    bytes lit; // Only used by kind::literal.
+};
 
-/// Processes a new pattern character, extending re with the equivalent regex pattern.
-void process_char(wchar_t c, wstring& re, bool& escaping) {
-    if (c == L'\\' && !escaping) {
-        escaping = true;
-        return;
-    }
-    switch (c) {
-    case L'.':
-    case L'[':
-    case L'\\':
-    case L'*':
-    case L'^':
-    case L'$':
-        // These are meant to match verbatim in LIKE, but they'd be special characters in regex --
-        // must escape them.
-        re.push_back(L'\\');
-        re.push_back(c);
-        break;
-    case L'_':
-    case L'%':
-        if (escaping) {
-            re.push_back(c);
-        } else { // LIKE wildcard.
-            re.push_back(L'.');
-            if (c == L'%') {
-                re.push_back(L'*');
-            }
-        }
-        break;
-    default:
-        re.push_back(c);
-        break;
+/// Returns the length of the UTF-8 sequence introduced by lead byte \c b.
+/// Bytes that cannot begin a sequence get length 1, so that matching always
+/// makes progress even on invalid text.
+size_t utf8_sequence_length(uint8_t b) {
+    if ((b & 0xe0) == 0xc0) {
+        return 2;
+    } else if ((b & 0xf0) == 0xe0) {
+        return 3;
+    } else if ((b & 0xf8) == 0xf0) {
+        return 4;
     }
-    escaping = false;
+    return 1;
 }
 
-/// Returns a regex string matching the given LIKE pattern.
-wstring regex_from_pattern(bytes_view pattern) {
-    if (pattern.empty()) {
-        return L"^$"; // Like SQL, empty pattern matches only empty text.
+/// Compiles a LIKE pattern into its element sequence.  Wildcards are ASCII
+/// bytes and UTF-8 is self-synchronizing, so the pattern can be tokenized
+/// byte by byte; consecutive '%'s collapse into one element.
+std::vector<pattern_element> compile_pattern(bytes_view pattern) {
+    if (!utils::utf8::validate(pattern)) {
+        throw std::invalid_argument("LIKE pattern is not valid UTF-8");
     }
-    using namespace boost::locale::conv;
-    wstring wpattern = utf_to_utf<wchar_t>(pattern.begin(), pattern.end(), stop);
-    if (wpattern.back() == L'\\') {
-        // Add an extra backslash, in case that last character is unescaped.  (If it is escaped, the
-        // extra backslash will be ignored.)
-        wpattern += L'\\';
-    }
-    wstring re;
-    re.reserve(wpattern.size() * 2); // Worst case: every element is a special character and must be escaped.
+    std::vector<pattern_element> elements;
+    bytes lit;
+    auto flush_literal = [&] {
+        if (!lit.empty()) {
+            elements.push_back(pattern_element{pattern_element::kind::literal, std::exchange(lit, {})});
+        }
+    };
     bool escaping = false;
-    for (const wchar_t c : wpattern) {
-        process_char(c, re, escaping);
+    for (auto b : pattern) {
+        if (escaping) {
+            lit.push_back(b);
+            escaping = false;
+        } else if (b == '\\') {
+            escaping = true;
+        } else if (b == '%') {
+            flush_literal();
+            if (elements.empty() || elements.back().k != pattern_element::kind::any_string) {
+                elements.push_back(pattern_element{pattern_element::kind::any_string, {}});
+            }
+        } else if (b == '_') {
+            flush_literal();
+            elements.push_back(pattern_element{pattern_element::kind::single_char, {}});
+        } else {
+            lit.push_back(b);
+        }
     }
-    return re;
+    if (escaping) {
+        // A trailing unescaped backslash matches itself.
+        lit.push_back('\\');
+    }
+    flush_literal();
+    return elements;
 }
 
 } // anonymous namespace
 
 class like_matcher::impl {
     bytes _pattern;
-    boost::u32regex _re; // Performs pattern matching.
+    std::vector<pattern_element> _elements;
   public:
     explicit impl(bytes_view pattern);
     bool operator()(bytes_view text) const;
     void reset(bytes_view pattern);
-  private:
-    void init_re() {
-        _re = boost::make_u32regex(regex_from_pattern(_pattern), boost::u32regex::basic | boost::u32regex::optimize);
-    }
 };
 
-like_matcher::impl::impl(bytes_view pattern) : _pattern(pattern) {
-    init_re();
+like_matcher::impl::impl(bytes_view pattern)
+        : _pattern(pattern), _elements(compile_pattern(pattern)) {
 }
 
 bool like_matcher::impl::operator()(bytes_view text) const {
-    return boost::u32regex_match(text.begin(), text.end(), _re);
+    using kind = pattern_element::kind;
+    const size_t n = text.size();
+    size_t ti = 0; // Current text position.
+    size_t ei = 0; // Current element.
+    std::optional<size_t> star_ei; // Last any_string element seen.
+    size_t star_ti = 0; // Text position from which that '%' currently lets the rest of the pattern run.
+    while (ti < n) {
+        if (ei < _elements.size()) {
+            const pattern_element& e = _elements[ei];
+            if (e.k == kind::any_string) {
+                star_ei = ei;
+                star_ti = ti;
+                ++ei;
+                continue;
+            } else if (e.k == kind::single_char) {
+                auto len = utf8_sequence_length(uint8_t(text[ti]));
+                if (ti + len <= n) {
+                    ti += len;
+                    ++ei;
+                    continue;
+                }
+            } else if (bytes_view(text).substr(ti).starts_with(bytes_view(e.lit))) {
+                ti += e.lit.size();
+                ++ei;
+                continue;
+            }
+        }
+        // Mismatch (or pattern exhausted with text left over): let the last
+        // '%' consume more of the text and retry the elements after it.
+        if (!star_ei) {
+            return false;
+        }
+        if (*star_ei == _elements.size() - 1) {
+            // The pattern ends with '%', which swallows the rest of the text.
+            return true;
+        }
+        ei = *star_ei + 1;
+        if (_elements[ei].k == kind::literal) {
+            // Jump straight to the next occurrence of the literal.
+            auto pos = text.find(bytes_view(_elements[ei].lit), star_ti + 1);
+            if (pos == bytes_view::npos) {
+                return false;
+            }
+            star_ti = pos;
+            ti = pos + _elements[ei].lit.size();
+            ++ei;
+        } else {
+            ti = ++star_ti;
+        }
+    }
+    // Text exhausted; the remaining elements must be able to match emptiness.
+    while (ei < _elements.size() && _elements[ei].k == kind::any_string) {
+        ++ei;
+    }
+    return ei == _elements.size();
 }
 
 void like_matcher::impl::reset(bytes_view pattern) {
     if (pattern != _pattern) {
         _pattern = bytes(pattern);
-        init_re();
+        _elements = compile_pattern(pattern);
     }
 }
 
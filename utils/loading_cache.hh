@@ -100,6 +100,12 @@ struct do_nothing_loading_cache_stats {
 /// it's going to be "loaded" in the context of get_XXX(key). As long as the value is cached get_XXX(key) is going to return the
 /// cached value immediately and reload it in the background every "refresh" time period as described above.
 ///
+/// On top of the periodic reload the cache applies a refresh-ahead policy on reads: when get_XXX(key) or find(key) hits
+/// an entry that is older than the "refresh" period the cached value is still returned immediately, but a background
+/// reload of this entry is started right away unless one is already running. This keeps the staleness of frequently read
+/// entries bound by the "refresh" period rather than by the reload timer resolution and makes it unlikely for such
+/// entries to ever reach the "expiration" period and have to be reloaded in the foreground of a client request.
+///
 /// \tparam Key type of the cache key
 /// \tparam Tp type of the cached value
 /// \tparam SectionHitThreshold number of hits after which a cache item is going to be moved to the privileged cache section.
@@ -137,6 +143,7 @@ private:
     loading_cache_clock_type::time_point _last_read;
     lru_entry* _lru_entry_ptr = nullptr; /// MRU item is at the front, LRU - at the back
     size_t _size = 0;
+    bool _reload_in_progress = false;
 
 public:
     timestamped_val(value_type val)
@@ -185,6 +192,14 @@ public:
         return _lru_entry_ptr;
     }
 
+    bool reload_in_progress() const noexcept {
+        return _reload_in_progress;
+    }
+
+    void set_reload_in_progress(bool in_progress) noexcept {
+        _reload_in_progress = in_progress;
+    }
+
 private:
     void touch() noexcept {
         assert(_lru_entry_ptr);
@@ -298,6 +313,7 @@ public:
                 return make_ready_future<value_ptr>(std::move(vp));
             }
 
+            maybe_refresh_in_background(ts_val_ptr);
             return make_ready_future<value_ptr>(std::move(ts_val_ptr));
         });
     }
@@ -400,13 +416,21 @@ private:
 
     template<typename KeyType, typename KeyHasher, typename KeyEqual>
     timestamped_val_ptr set_find(const KeyType& key, KeyHasher key_hasher_func, KeyEqual key_equal_func) noexcept {
-        return ready_entry_ptr(_loading_values.find(key, std::move(key_hasher_func), std::move(key_equal_func)));
+        auto tv_ptr = ready_entry_ptr(_loading_values.find(key, std::move(key_hasher_func), std::move(key_equal_func)));
+        if (tv_ptr) {
+            maybe_refresh_in_background(tv_ptr);
+        }
+        return tv_ptr;
     }
 
     // keep the default non-templated overloads to ease on the compiler for specifications
     // that do not require the templated find().
     timestamped_val_ptr set_find(const Key& key) noexcept {
-        return ready_entry_ptr(_loading_values.find(key));
+        auto tv_ptr = ready_entry_ptr(_loading_values.find(key));
+        if (tv_ptr) {
+            maybe_refresh_in_background(tv_ptr);
+        }
+        return tv_ptr;
     }
 
     bool caching_enabled() const {
@@ -446,6 +470,30 @@ private:
         }
     }
 
+    /// Refresh-ahead: an entry which went past its "refresh" period is served as is, but a background reload of it is
+    /// kicked off right away instead of waiting for the next reload timer tick. Concurrent attempts (from the timer or
+    /// from other reads) coalesce into a single reload in reload().
+    ///
+    /// \param ts_val_ptr entry that has just been read. Must be ready().
+    void maybe_refresh_in_background(const timestamped_val_ptr& ts_val_ptr) noexcept {
+        if constexpr (ReloadEnabled == loading_cache_reload_enabled::yes) {
+            if (ts_val_ptr->reload_in_progress() || loading_cache_clock_type::now() - ts_val_ptr->loaded() < _refresh) {
+                return;
+            }
+            try {
+                // Future is waited on indirectly in `stop()` (via `_timer_reads_gate`).
+                (void)with_gate(_timer_reads_gate, [this, ts_val_ptr] () mutable {
+                    _logger.trace("{}: refreshing the stale entry in the background", loading_values_type::to_key(ts_val_ptr));
+                    return reload(std::move(ts_val_ptr));
+                });
+            } catch (...) {
+                // Starting the background reload is a best-effort optimization. If it can't be started (e.g. the cache
+                // is being stopped) the entry is going to be either refreshed by the timer or reloaded in the foreground
+                // after it expires.
+            }
+        }
+    }
+
     future<> reload(timestamped_val_ptr ts_value_ptr) {
         const Key& key = loading_values_type::to_key(ts_value_ptr);
 
@@ -456,7 +504,16 @@ private:
             return make_ready_future<>();
         }
 
+        // Coalesce with an in-flight reload: both the timer and the refresh-ahead read path may notice that the same
+        // entry went stale.
+        if (ts_value_ptr->reload_in_progress()) {
+            _logger.trace("{}: the value is already being reloaded", key);
+            return make_ready_future<>();
+        }
+        ts_value_ptr->set_reload_in_progress(true);
+
         return _load(key).then_wrapped([this, ts_value_ptr = std::move(ts_value_ptr), &key] (auto&& f) mutable {
+            ts_value_ptr->set_reload_in_progress(false);
             // if the entry has been evicted by now - simply end here
             if (!ts_value_ptr->lru_entry_ptr()) {
                 _logger.trace("{}: entry was dropped during the reload", key);
@@ -39,6 +39,7 @@
 #include <seastar/core/with_scheduling_group.hh>
 #include <seastar/util/alloc_failure_injector.hh>
 #include <seastar/util/backtrace.hh>
+#include <seastar/util/defer.hh>
 #include <seastar/util/later.hh>
 
 #include "utils/logalloc.hh"
@@ -452,6 +453,10 @@ class tracker::impl {
     bool _reclaiming_enabled = true;
     size_t _reclamation_step = 1;
     bool _abort_on_bad_alloc = false;
+    // Idle defragmentation stops compacting a region once its closed
+    // segments reach this occupancy fraction. 1.0 means compact as long
+    // as forward progress is possible.
+    double _idle_compaction_target_occupancy = 1.0;
 private:
     // Prevents tracker's reclaimer from running while live. Reclaimer may be
     // invoked synchronously with allocator. This guard ensures that this
@@ -498,6 +503,8 @@ public:
     size_t non_lsa_used_space();
     // Set the minimum number of segments reclaimed during single reclamation cycle.
     void set_reclamation_step(size_t step_in_segments) { _reclamation_step = step_in_segments; }
+    // Set the occupancy fraction at which idle defragmentation stops compacting a region.
+    void set_idle_compaction_target_occupancy(double target) { _idle_compaction_target_occupancy = target; }
     size_t reclamation_step() const { return _reclamation_step; }
     // Abort on allocation failure from LSA
     void enable_abort_on_bad_alloc() { _abort_on_bad_alloc = true; }
@@ -871,15 +878,23 @@ public:
         uint64_t memory_freed;
         uint64_t memory_compacted;
         uint64_t memory_evicted;
+        uint64_t alloc_section_retries;
+        // Subset of segments_compacted/memory_compacted done by the
+        // idle-time defragmenter rather than under memory pressure.
+        size_t segments_compacted_on_idle;
+        uint64_t memory_compacted_on_idle;
     };
 private:
     stats _stats{};
+    bool _idle_compaction = false;
 public:
     const stats& statistics() const { return _stats; }
+    void set_idle_compaction(bool idle) { _idle_compaction = idle; }
     void on_segment_compaction(size_t used_size);
     void on_memory_allocation(size_t size);
     void on_memory_deallocation(size_t size);
     void on_memory_eviction(size_t size);
+    void on_alloc_section_retry() { ++_stats.alloc_section_retries; }
     size_t unreserved_free_segments() const { return _free_segments - std::min(_free_segments, _emergency_reserve_max); }
     size_t free_segments() const { return _free_segments; }
 };
@@ -1083,6 +1098,10 @@ void segment_pool::prime(size_t available_memory, size_t min_free_memory) {
 void segment_pool::on_segment_compaction(size_t used_size) {
     _stats.segments_compacted++;
     _stats.memory_compacted += used_size;
+    if (_idle_compaction) {
+        _stats.segments_compacted_on_idle++;
+        _stats.memory_compacted_on_idle += used_size;
+    }
 }
 
 void segment_pool::on_memory_allocation(size_t size) {
@@ -1628,8 +1647,11 @@ public:
             && _segment_descs.contains_above_min();
     }
 
-    bool is_idle_compactible() {
-        return is_compactible();
+    // Like is_compactible(), but also respects the idle compaction occupancy
+    // target: once the region's closed segments are on average at least
+    // target_occupancy full, idle defragmentation leaves the region alone.
+    bool is_idle_compactible(double target_occupancy) {
+        return is_compactible() && _closed_occupancy.used_fraction() < target_occupancy;
     }
 
     virtual void* alloc(allocation_strategy::migrate_fn migrator, size_t size, size_t alignment) override {
@@ -1918,6 +1940,7 @@ void tracker::configure(const config& cfg) {
             return _impl->compact_on_idle(check_for_work);
         });
     }
+    _impl->set_idle_compaction_target_occupancy(cfg.idle_compaction_target_occupancy);
 
     _impl->set_reclamation_step(cfg.lsa_reclamation_step);
     if (cfg.abort_on_lsa_bad_alloc) {
@@ -2221,20 +2244,24 @@ idle_cpu_handler_result tracker::impl::compact_on_idle(work_waiting_on_reactor c
     }
     segment_pool::reservation_goal open_emergency_pool(shard_segment_pool, 0);
 
-    auto cmp = [] (region::impl* c1, region::impl* c2) {
-        if (c1->is_idle_compactible() != c2->is_idle_compactible()) {
-            return !c1->is_idle_compactible();
+    auto target = _idle_compaction_target_occupancy;
+    auto cmp = [target] (region::impl* c1, region::impl* c2) {
+        if (c1->is_idle_compactible(target) != c2->is_idle_compactible(target)) {
+            return !c1->is_idle_compactible(target);
         }
         return c2->min_occupancy() < c1->min_occupancy();
     };
 
     boost::range::make_heap(_regions, cmp);
 
+    shard_segment_pool.set_idle_compaction(true);
+    auto clear_idle = defer([] () noexcept { shard_segment_pool.set_idle_compaction(false); });
+
     while (!check_for_work()) {
         boost::range::pop_heap(_regions, cmp);
         region::impl* r = _regions.back();
 
-        if (!r->is_idle_compactible()) {
+        if (!r->is_idle_compactible(target)) {
             return idle_cpu_handler_result::no_more_work;
         }
 
@@ -2448,6 +2475,14 @@ tracker::impl::impl() {
         sm::make_derive("memory_compacted", [] { return shard_segment_pool.statistics().memory_compacted; },
                         sm::description("Counts number of bytes which were copied as part of segment compaction.")),
 
+        sm::make_derive("segments_compacted_on_idle", [] { return shard_segment_pool.statistics().segments_compacted_on_idle; },
+                        sm::description("Counts a number of segments compacted by the idle-time defragmenter. "
+                                        "Subtract from \"segments_compacted\" to get the number of segments compacted under memory pressure.")),
+
+        sm::make_derive("memory_compacted_on_idle", [] { return shard_segment_pool.statistics().memory_compacted_on_idle; },
+                        sm::description("Counts number of bytes copied by the idle-time defragmenter. "
+                                        "Subtract from \"memory_compacted\" to get the number of bytes compacted under memory pressure.")),
+
         sm::make_derive("memory_allocated", [] { return shard_segment_pool.statistics().memory_allocated; },
                         sm::description("Counts number of bytes which were requested from LSA.")),
 
@@ -2456,6 +2491,9 @@ tracker::impl::impl() {
 
         sm::make_derive("memory_freed", [] { return shard_segment_pool.statistics().memory_freed; },
                         sm::description("Counts number of bytes which were requested to be freed in LSA.")),
+
+        sm::make_derive("alloc_section_retries", [] { return shard_segment_pool.statistics().alloc_section_retries; },
+                        sm::description("Counts number of times an allocating section was retried due to an allocation failure.")),
     });
 }
 
@@ -2672,6 +2710,7 @@ void allocating_section::reserve() {
 }
 
 void allocating_section::on_alloc_failure(logalloc::region& r) {
+    shard_segment_pool.on_alloc_section_retry();
     r.allocator().invalidate_references();
     if (shard_segment_pool.allocation_failure_flag()) {
         _lsa_reserve *= 2;
@@ -435,6 +435,10 @@ public:
         bool abort_on_lsa_bad_alloc;
         bool sanitizer_report_backtrace = false; // Better reports but slower
         size_t lsa_reclamation_step;
+        // Idle defragmentation stops compacting a region once its closed
+        // segments reach this occupancy fraction (1.0 = compact while
+        // forward progress is possible).
+        double idle_compaction_target_occupancy = 1.0;
         scheduling_group background_reclaim_sched_group;
     };
 
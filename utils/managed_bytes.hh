@@ -84,8 +84,21 @@ struct blob_storage {
 } __attribute__((packed));
 
 // A managed version of "bytes" (can be used with LSA).
+//
+// Values of up to max_inline_size bytes are stored inline, in the space
+// otherwise occupied by the blob_storage back-pointer, so small cells pay
+// no allocation and no pointer chase. Larger values live in an external
+// chain of blob_storage fragments, which the LSA compacts via blob_storage's
+// move constructor.
+//
+// The inline capacity is sized to fit the serialized form of the most
+// common atomic cell: flags (1) + timestamp (8) + an 8-byte value (int,
+// bigint, double, timestamp) = 17 bytes. Storing such cells inline keeps
+// them within the row's cell slot, with no blob_storage header and no
+// pointer to chase during scans; one byte of the object holds the size /
+// external-storage marker.
 class managed_bytes {
-    static constexpr size_t max_inline_size = 15;
+    static constexpr size_t max_inline_size = 23;
     struct small_blob {
         bytes_view::value_type data[max_inline_size];
         int8_t size; // -1 -> use blob_storage
@@ -167,6 +167,12 @@ void hash3_x64_128(InputIterator in, uint32_t length, uint64_t seed, std::array<
 
 void hash3_x64_128(bytes_view key, uint64_t seed, std::array<uint64_t, 2>& result);
 
+// Hashes four keys at once, advancing the four hash states in lockstep so
+// that their dependency chains overlap. Produces exactly the same results
+// as calling hash3_x64_128() on each key in turn, but is faster when
+// several keys are available up front.
+void hash3_x64_128_x4(const std::array<bytes_view, 4>& keys, uint64_t seed, std::array<std::array<uint64_t, 2>, 4>& results);
+
 } // namespace murmur_hash
 
 } // namespace utils
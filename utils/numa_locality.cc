@@ -0,0 +1,110 @@
+/*
+ * Copyright (C) 2021-present ScyllaDB
+ */
+
+/*
+ * This file is part of Scylla.
+ *
+ * Scylla is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Scylla is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Scylla.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "utils/numa_locality.hh"
+#include "log.hh"
+#include "seastarx.hh"
+
+#include <seastar/core/align.hh>
+#include <seastar/core/memory.hh>
+#include <seastar/core/metrics.hh>
+#include <seastar/core/smp.hh>
+
+#include <algorithm>
+
+#include <linux/mempolicy.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace utils {
+
+static logging::logger numalog("numa_locality");
+
+// The NUMA node backing the page at addr, or -1 if the kernel cannot tell
+// (no NUMA support, or the address is not mapped). For a mapped but not yet
+// faulted page the kernel faults it in from the calling thread, which on a
+// shard produces the same placement a real access would.
+static int numa_node_of_page(const void* addr) {
+    int node = -1;
+    if (syscall(__NR_get_mempolicy, &node, nullptr, 0ul, const_cast<void*>(addr), MPOL_F_NODE | MPOL_F_ADDR) != 0) {
+        return -1;
+    }
+    return node;
+}
+
+numa_locality_stats sample_numa_locality(size_t max_samples) {
+    numa_locality_stats result;
+#ifndef SEASTAR_DEFAULT_ALLOCATOR
+    unsigned cpu = 0;
+    unsigned node = 0;
+    if (syscall(SYS_getcpu, &cpu, &node, nullptr) != 0) {
+        return result;
+    }
+    result.node = int(node);
+    auto layout = memory::get_memory_layout();
+    auto page_size = uintptr_t(getpagesize());
+    auto start = align_up(layout.start, page_size);
+    if (layout.end <= start || max_samples == 0) {
+        return result;
+    }
+    auto pages = (layout.end - start) / page_size;
+    auto step = std::max(pages / max_samples, size_t(1)) * page_size;
+    for (auto addr = start; addr < layout.end && result.sampled_pages < max_samples; addr += step) {
+        ++result.sampled_pages;
+        auto n = numa_node_of_page(reinterpret_cast<const void*>(addr));
+        if (n < 0) {
+            ++result.unknown_pages;
+        } else if (n == result.node) {
+            ++result.local_pages;
+        } else {
+            ++result.remote_pages;
+        }
+    }
+#endif
+    return result;
+}
+
+static thread_local numa_locality_stats boot_stats;
+static thread_local seastar::metrics::metric_groups numa_metrics;
+
+void log_and_register_numa_locality_metrics() {
+    boot_stats = sample_numa_locality();
+    if (!boot_stats.valid()) {
+        numalog.debug("shard {}: cannot determine NUMA placement of shard memory", this_shard_id());
+        return;
+    }
+    if (boot_stats.remote_pages) {
+        numalog.warn("shard {} (NUMA node {}): {} of {} sampled memory pages are on a remote NUMA node; expect cross-socket memory traffic",
+                this_shard_id(), boot_stats.node, boot_stats.remote_pages, boot_stats.sampled_pages);
+    } else {
+        numalog.debug("shard {} (NUMA node {}): all {} sampled memory pages are local",
+                this_shard_id(), boot_stats.node, boot_stats.sampled_pages);
+    }
+    namespace sm = seastar::metrics;
+    numa_metrics.add_group("memory", {
+        sm::make_gauge("numa_local_pages", [] { return boot_stats.local_pages; },
+                sm::description("Pages of this shard's memory span sampled at startup that reside on the shard's local NUMA node.")),
+        sm::make_gauge("numa_remote_pages", [] { return boot_stats.remote_pages; },
+                sm::description("Pages of this shard's memory span sampled at startup that reside on a remote NUMA node.")),
+    });
+}
+
+}
@@ -0,0 +1,55 @@
+/*
+ * Copyright (C) 2021-present ScyllaDB
+ */
+
+/*
+ * This file is part of Scylla.
+ *
+ * Scylla is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Scylla is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Scylla.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace utils {
+
+// NUMA placement of a sample of this shard's memory span.
+struct numa_locality_stats {
+    int node = -1; // NUMA node of the CPU this shard runs on, -1 if unknown
+    uint64_t sampled_pages = 0;
+    uint64_t local_pages = 0;   // backed by memory on this shard's node
+    uint64_t remote_pages = 0;  // backed by memory on a different node
+    uint64_t unknown_pages = 0; // placement could not be determined
+
+    bool valid() const { return node >= 0 && sampled_pages > 0; }
+};
+
+// Samples up to max_samples evenly spaced pages of the calling shard's
+// memory span and asks the kernel which NUMA node backs each of them.
+// Remote pages mean cross-socket traffic on every miss, so on multi-socket
+// machines this is worth checking after startup. Returns an invalid result
+// when the span cannot be inspected (e.g. the default-allocator build, or
+// a kernel without NUMA support).
+numa_locality_stats sample_numa_locality(size_t max_samples = 1024);
+
+// Runs sample_numa_locality() on the calling shard, logs the outcome
+// (warning if any sampled page is remote) and exports the result as
+// per-shard metrics, so locality can be verified from dashboards. Shard
+// memory is never remapped after startup, so a single boot-time sample
+// stays representative.
+void log_and_register_numa_locality_metrics();
+
+}
@@ -19,6 +19,8 @@
  * along with Scylla.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <algorithm>
+
 #include "rate_limiter.hh"
 
 utils::rate_limiter::rate_limiter(size_t rate)
@@ -31,18 +33,61 @@ utils::rate_limiter::rate_limiter(size_t rate)
     }
 }
 
+size_t utils::rate_limiter::grant(size_t shares) const {
+    auto total = _shares;
+    for (auto* b : _buckets) {
+        total += b->_shares;
+    }
+    // Never grant zero, or a bucket with few shares would starve forever.
+    return std::max(size_t(1), _units_per_s * shares / total);
+}
+
 void utils::rate_limiter::on_timer() {
-    _sem.signal(_units_per_s - _sem.current());
+    auto refill = [] (semaphore& sem, size_t units) {
+        // A slice can shrink between ticks if shares are rebalanced, so the
+        // semaphore may already hold more than this tick's grant.
+        sem.signal(units - std::min(units, sem.current()));
+    };
+    for (auto* b : _buckets) {
+        refill(b->_sem, grant(b->_shares));
+    }
+    refill(_sem, grant(_shares));
 }
 
 future<> utils::rate_limiter::reserve(size_t u) {
     if (_units_per_s == 0) {
         return make_ready_future<>();
     }
-    if (u <= _units_per_s) {
+    auto slice = grant(_shares);
+    if (u <= slice) {
+        return _sem.wait(u);
+    }
+    auto n = std::min(u, slice);
+    auto r = u - n;
+    return _sem.wait(n).then([this, r] {
+        return reserve(r);
+    });
+}
+
+utils::rate_limiter::bucket::bucket(rate_limiter& parent, size_t shares)
+        : _parent(parent), _shares(shares) {
+    _parent._buckets.push_back(this);
+}
+
+utils::rate_limiter::bucket::~bucket() {
+    auto& buckets = _parent._buckets;
+    buckets.erase(std::find(buckets.begin(), buckets.end(), this));
+}
+
+future<> utils::rate_limiter::bucket::reserve(size_t u) {
+    if (_parent._units_per_s == 0) {
+        return make_ready_future<>();
+    }
+    auto slice = _parent.grant(_shares);
+    if (u <= slice) {
         return _sem.wait(u);
     }
-    auto n = std::min(u, _units_per_s);
+    auto n = std::min(u, slice);
     auto r = u - n;
     return _sem.wait(n).then([this, r] {
         return reserve(r);
@@ -21,6 +21,8 @@
 
 #pragma once
 
+#include <vector>
+
 #include <seastar/core/timer.hh>
 #include <seastar/core/semaphore.hh>
 #include <seastar/core/seastar.hh>
@@ -32,14 +34,50 @@ namespace utils {
  * 100% naive rate limiter. Consider it a placeholder
  * Will let you process X "units" per second, then reset this every s.
  * Obviously, accuracy is virtually non-existant and steady rate will fluctuate.
+ *
+ * Independent consumer classes can carve the budget up by creating child
+ * buckets. Each tick grants every bucket (and the limiter's own reserve()
+ * queue) its share-proportional slice of the per-second budget in one batch,
+ * so consumers throttled through different buckets do not steal each other's
+ * units and waiters are only woken once per tick.
  */
 class rate_limiter {
+public:
+    static constexpr size_t default_shares = 1000;
+
+    /**
+     * A share-weighted slice of a rate_limiter's budget. Must not outlive
+     * its parent limiter.
+     */
+    class bucket {
+        rate_limiter& _parent;
+        size_t _shares;
+        semaphore _sem {0};
+
+        friend class rate_limiter;
+    public:
+        bucket(rate_limiter& parent, size_t shares = default_shares);
+        ~bucket();
+        bucket(const bucket&) = delete;
+        future<> reserve(size_t u);
+        size_t shares() const {
+            return _shares;
+        }
+        /** Rebalances this bucket's slice; takes effect on the next tick. */
+        void set_shares(size_t shares) {
+            _shares = shares;
+        }
+    };
+
 private:
     timer<lowres_clock> _timer;
     size_t _units_per_s;
+    size_t _shares = default_shares;
     semaphore _sem {0};
+    std::vector<bucket*> _buckets;
 
     void on_timer();
+    size_t grant(size_t shares) const;
 public:
     rate_limiter(size_t rate);
     future<> reserve(size_t u);
@@ -39,17 +39,31 @@ class chunked_content_stream {
 private:
     chunked_content _content;
     chunked_content::iterator _current_chunk;
+    // Cursors into the current chunk. The parser consumes the input one
+    // character at a time, so Peek() and Take() must stay cheap - bare
+    // pointer operations - instead of going through the chunk's
+    // temporary_buffer on every byte.
+    const char* _pos = nullptr;
+    const char* _end = nullptr;
     // _count only needed for Tell(). 32 bits is enough, we don't allow
     // more than 16 MB requests anyway.
-    unsigned _count;
+    unsigned _count = 0;
 public:
     typedef char Ch;
     chunked_content_stream(chunked_content&& content)
         : _content(std::move(content))
         , _current_chunk(_content.begin())
-    {}
+    {
+        if (_current_chunk != _content.end()) {
+            _pos = _current_chunk->get();
+            _end = _pos + _current_chunk->size();
+        }
+    }
     bool eof() const {
-        return _current_chunk == _content.end();
+        // chunked_content holds no empty buffers, so running out of the
+        // current chunk's characters (below, in Take()) either positions the
+        // cursors on a non-empty chunk, or means the whole content is over.
+        return _pos == _end;
     }
     // Methods needed by rapidjson's Stream concept (see
     // https://rapidjson.org/classrapidjson_1_1_stream.html):
@@ -62,19 +76,26 @@ public:
             // anyway can't include bare null characters.
             return '\0';
         } else {
-            return *_current_chunk->begin();
+            return *_pos;
         }
     }
     char Take() {
         if (eof()) {
             return '\0';
         } else {
-            char ret = *_current_chunk->begin();
-            _current_chunk->trim_front(1);
+            char ret = *_pos++;
             ++_count;
-            if (_current_chunk->empty()) {
+            if (_pos == _end) {
+                // Free the chunk we've just finished parsing and move to the
+                // next one.
                 *_current_chunk = temporary_buffer<char>();
                 ++_current_chunk;
+                if (_current_chunk != _content.end()) {
+                    _pos = _current_chunk->get();
+                    _end = _pos + _current_chunk->size();
+                } else {
+                    _pos = _end = nullptr;
+                }
             }
             return ret;
         }
@@ -142,6 +163,15 @@ public:
     void Parse(chunked_content&& content) {
         // Note that content was moved into this function. The intention is
         // that we free every chunk we are done with.
+        // Content which arrived in a single contiguous buffer is parsed
+        // directly from it - rapidjson's memory stream walks the buffer
+        // with a bare pointer and takes optimized paths (e.g., for skipping
+        // whitespace) that the generic stream interface doesn't get.
+        if (content.size() == 1) {
+            auto chunk = std::move(content[0]);
+            Parse(chunk.get(), chunk.size());
+            return;
+        }
         chunked_content_stream is(std::move(content));
         Parse(is);
     }
@@ -0,0 +1,146 @@
+/*
+ * Copyright (C) 2021-present ScyllaDB
+ */
+
+/*
+ * This file is part of Scylla.
+ *
+ * Scylla is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Scylla is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Scylla.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "utils/stall_fingerprints.hh"
+#include "log.hh"
+
+#include <seastar/core/print.hh>
+#include <seastar/core/reactor.hh>
+#include <seastar/util/backtrace.hh>
+
+#include <algorithm>
+
+namespace utils {
+
+static logging::logger stall_logger("stall_fingerprints");
+
+static uint64_t fingerprint_hash(const uintptr_t* frames, unsigned depth) {
+    // FNV-1a over the raw frame addresses.
+    uint64_t h = 0xcbf29ce484222325ull;
+    for (unsigned i = 0; i < depth; ++i) {
+        h ^= frames[i];
+        h *= 0x100000001b3ull;
+    }
+    return h;
+}
+
+void stall_fingerprint_registry::record() noexcept {
+    // Runs in the stall detector's signal context: only frame walking and
+    // writes to the ring buffer.
+    auto& s = _ring[_head % ring_size];
+    s.sched_group = current_scheduling_group();
+    s.when = std::chrono::system_clock::now();
+    s.depth = 0;
+    backtrace([&s] (frame f) {
+        if (s.depth < max_depth) {
+            s.frames[s.depth++] = f.addr;
+        }
+    });
+    // Publish the slot only once it is fully written.
+    ++_head;
+}
+
+void stall_fingerprint_registry::drain_ring(bool log_new) {
+    auto head = _head;
+    auto first = _drained;
+    if (head - first > ring_size) {
+        _dropped += head - first - ring_size;
+        first = head - ring_size;
+    }
+    std::vector<uint64_t> drained_ids;
+    for (auto i = first; i < head; ++i) {
+        auto& s = _ring[i % ring_size];
+        auto id = fingerprint_hash(s.frames, s.depth);
+        auto [it, inserted] = _fingerprints.try_emplace(id);
+        auto& fp = it->second;
+        if (inserted) {
+            fp.id = id;
+            fp.sched_group_name = s.sched_group.name();
+            fp.frames.assign(s.frames, s.frames + s.depth);
+            fp.count = 0;
+            fp.first_seen = s.when;
+        }
+        fp.count++;
+        fp.last_seen = s.when;
+        if (std::find(drained_ids.begin(), drained_ids.end(), id) == drained_ids.end()) {
+            drained_ids.push_back(id);
+        }
+    }
+    _drained = head;
+    if (!log_new) {
+        return;
+    }
+    for (auto id : drained_ids) {
+        auto& fp = _fingerprints[id];
+        sstring bt;
+        for (auto addr : fp.frames) {
+            bt += format(" 0x{:x}", addr);
+        }
+        stall_logger.warn("Reactor stall fingerprint {:016x} in scheduling group \"{}\", seen {} times; backtrace:{}",
+                fp.id, fp.sched_group_name, fp.count, bt);
+    }
+}
+
+void stall_fingerprint_registry::start() {
+    if (_started) {
+        return;
+    }
+    if (!_ring) {
+        _ring = std::make_unique<sample[]>(ring_size);
+    }
+    engine().set_stall_detector_report_function([this] {
+        record();
+    });
+    // The report hook runs in signal context and cannot log or allocate, so
+    // the samples are folded into the registry and logged from a timer.
+    _drain_timer.set_callback([this] {
+        drain_ring(true);
+    });
+    _drain_timer.arm_periodic(std::chrono::seconds(1));
+    _started = true;
+}
+
+void stall_fingerprint_registry::stop() {
+    if (!_started) {
+        return;
+    }
+    _drain_timer.cancel();
+    // Restore the default stall report (a backtrace printed to stderr).
+    engine().set_stall_detector_report_function({});
+    _started = false;
+}
+
+std::vector<stall_fingerprint_registry::fingerprint> stall_fingerprint_registry::snapshot() {
+    drain_ring(false);
+    std::vector<fingerprint> result;
+    result.reserve(_fingerprints.size());
+    for (auto& [id, fp] : _fingerprints) {
+        result.push_back(fp);
+    }
+    return result;
+}
+
+stall_fingerprint_registry& get_local_stall_fingerprint_registry() {
+    static thread_local stall_fingerprint_registry the_registry;
+    return the_registry;
+}
+
+}
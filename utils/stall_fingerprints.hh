@@ -0,0 +1,101 @@
+/*
+ * Copyright (C) 2021-present ScyllaDB
+ */
+
+/*
+ * This file is part of Scylla.
+ *
+ * Scylla is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Scylla is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Scylla.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <seastar/core/lowres_clock.hh>
+#include <seastar/core/scheduling.hh>
+#include <seastar/core/sstring.hh>
+#include <seastar/core/timer.hh>
+
+#include "seastarx.hh"
+
+#include <chrono>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace utils {
+
+// A per-shard registry of reactor stall backtraces.
+//
+// Hooks into the seastar stall detector: every stall report captures the
+// stalled call stack and the scheduling group it ran in, and the backtrace
+// is hashed into a fingerprint so repeated stalls of the same origin are
+// counted rather than eyeballed in the log. Stalls are still logged - with
+// their fingerprint, so a log line can be matched to the accumulated
+// counts in the system.stall_fingerprints virtual table.
+class stall_fingerprint_registry {
+public:
+    static constexpr unsigned max_depth = 24;
+
+    struct fingerprint {
+        uint64_t id; // hash of the backtrace frames
+        sstring sched_group_name;
+        std::vector<uintptr_t> frames;
+        uint64_t count;
+        std::chrono::system_clock::time_point first_seen;
+        std::chrono::system_clock::time_point last_seen;
+    };
+
+private:
+    struct sample {
+        scheduling_group sched_group;
+        std::chrono::system_clock::time_point when;
+        unsigned depth;
+        uintptr_t frames[max_depth];
+    };
+
+    // Must be a power of two.
+    static constexpr unsigned ring_size = 256;
+
+    // Written only by the stall detector report hook, which runs in signal
+    // context on this shard's thread; drained from reactor context.
+    std::unique_ptr<sample[]> _ring;
+    uint64_t _head = 0;    // samples taken; next slot is _head % ring_size
+    uint64_t _drained = 0; // value of _head at the last drain
+    uint64_t _dropped = 0; // samples overwritten before they were drained
+
+    std::unordered_map<uint64_t, fingerprint> _fingerprints;
+    timer<lowres_clock> _drain_timer;
+    bool _started = false;
+
+public:
+    // Installs the stall detector report hook on this shard and starts a
+    // periodic task that logs newly seen stalls with their fingerprint.
+    void start();
+    void stop();
+
+    // Folds any buffered samples into the registry and returns a copy of
+    // the accumulated fingerprints of this shard.
+    std::vector<fingerprint> snapshot();
+
+    uint64_t dropped_samples() const { return _dropped; }
+
+private:
+    void record() noexcept; // the report hook; signal context
+    void drain_ring(bool log_new);
+};
+
+// The registry of the calling shard.
+stall_fingerprint_registry& get_local_stall_fingerprint_registry();
+
+}
@@ -22,6 +22,7 @@
 #pragma once
 
 #include <list>
+#include <optional>
 #include <algorithm>
 #include <seastar/core/thread.hh>
 #include <seastar/core/future.hh>
@@ -127,6 +128,9 @@ future<> clear_gently(T& o) noexcept;
 template <SmartPointer T>
 future<> clear_gently(T& o) noexcept;
 
+template <typename T>
+future<> clear_gently(std::optional<T>& o) noexcept;
+
 template <typename T, std::size_t N>
 future<> clear_gently(std::array<T, N>&a) noexcept;
 
@@ -193,6 +197,16 @@ future<> clear_gently(T& o) noexcept {
     return internal::clear_gently(*o);
 }
 
+template <typename T>
+future<> clear_gently(std::optional<T>& o) noexcept {
+    if (!o) {
+        return make_ready_future<>();
+    }
+    return internal::clear_gently(*o).then([&o] {
+        o.reset();
+    });
+}
+
 template <typename T, std::size_t N>
 future<> clear_gently(std::array<T, N>& a) noexcept {
     return do_for_each(a, [] (T& o) {
@@ -41,8 +41,12 @@
 
 #pragma once
 
+#include <algorithm>
 #include <cstdint>
 #include <map>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace utils {
 
@@ -247,4 +251,74 @@ struct streaming_histogram {
 #endif
 };
 
+/**
+ * Accumulates points destined for a streaming_histogram without paying the
+ * O(bins) nearest-pair scan on every new point. Points are spooled into a
+ * hash map of exact counts, so repeated values (e.g. seconds-resolution
+ * deletion times) are plain counter increments. The spool is drained into
+ * the backing histogram only when it overflows, and build() folds whatever
+ * is left before handing out the final histogram, trimmed to max_bin_size.
+ *
+ * As long as the number of distinct values stays within the spool, counts
+ * remain exact and no lossy bin merging happens at all.
+ */
+class streaming_histogram_builder {
+    // Exact per-value counts, drained into _hist in sorted batches.
+    std::unordered_map<double, uint64_t> _spool;
+    streaming_histogram _hist;
+    uint32_t _spool_size;
+public:
+    explicit streaming_histogram_builder(uint32_t max_bin_size = 0, uint32_t spool_factor = 10)
+        : _hist(max_bin_size)
+        , _spool_size(max_bin_size * spool_factor) {
+    }
+
+    void update(double p) {
+        update(p, 1);
+    }
+
+    void update(double p, uint64_t m) {
+        auto [it, inserted] = _spool.try_emplace(p, m);
+        if (!inserted) {
+            it->second += m;
+        } else if (_spool.size() >= _spool_size) {
+            flush();
+        }
+    }
+
+    /**
+     * Merges given builder into this one. Both spooled points and already
+     * folded bins of the other builder go through this builder's spool, so
+     * merging histograms with overlapping value sets is mostly hash-map
+     * increments.
+     */
+    void merge(streaming_histogram_builder& other) {
+        for (auto& e : other._spool) {
+            update(e.first, e.second);
+        }
+        for (auto& e : other._hist.bin) {
+            update(e.first, e.second);
+        }
+    }
+
+    /**
+     * Drains the spool into the backing histogram. Points are inserted in
+     * increasing order, matching the bin layout unbuffered insertion of a
+     * sorted stream would produce.
+     */
+    void flush() {
+        auto points = std::vector<std::pair<double, uint64_t>>(_spool.begin(), _spool.end());
+        std::sort(points.begin(), points.end());
+        for (auto& p : points) {
+            _hist.update(p.first, p.second);
+        }
+        _spool.clear();
+    }
+
+    streaming_histogram build() {
+        flush();
+        return std::move(_hist);
+    }
+};
+
 }
@@ -131,6 +131,14 @@ public:
 
     bool valid() const { return _valid; }
 
+    /// Forget all tracked items, starting a fresh window. Also recovers from
+    /// the invalid state.
+    void reset() noexcept {
+        _counters_map.clear();
+        _buckets.clear();
+        _valid = true;
+    }
+
     // returns true if item is a new one
     bool append(T item, unsigned inc = 1, unsigned err = 0) {
         return std::get<0>(append_return_all(std::move(item), inc, err));
@@ -365,7 +365,7 @@ internal::validate_partial(const uint8_t *data, size_t len) {
 } // namespace utils
 
 #elif defined(__x86_64__)
-#include <smmintrin.h>
+#include <immintrin.h>
 
 namespace utils {
 
@@ -426,8 +426,8 @@ alignas(16) static const int8_t s_ef_fe_tbl[] = {
 };
 
 // 5x faster than naive method
-partial_validation_results
-internal::validate_partial(const uint8_t *data, size_t len) {
+[[gnu::target("default")]] static partial_validation_results
+validate_partial_impl(const uint8_t *data, size_t len) {
     if (len >= 16) {
         __m128i prev_input = _mm_set1_epi8(0);
         __m128i prev_first_len = _mm_set1_epi8(0);
@@ -553,6 +553,124 @@ internal::validate_partial(const uint8_t *data, size_t len) {
     return validate_partial_naive(data, len);
 }
 
+/*
+ * AVX2 variant of the above: same range-based algorithm, 32 bytes per
+ * iteration. VPSHUFB looks up within each 128-bit lane independently, so the
+ * tables are broadcast to both lanes, and the byte shifts that feed the tail
+ * of the previous block need an extra cross-lane permute.
+ */
+
+[[gnu::target("avx2")]] static inline __m256i push_last_byte_of_a_to_b(__m256i a, __m256i b) {
+    return _mm256_alignr_epi8(b, _mm256_permute2x128_si256(a, b, 0x21), 15);
+}
+
+[[gnu::target("avx2")]] static inline __m256i push_last_2bytes_of_a_to_b(__m256i a, __m256i b) {
+    return _mm256_alignr_epi8(b, _mm256_permute2x128_si256(a, b, 0x21), 14);
+}
+
+[[gnu::target("avx2")]] static inline __m256i push_last_3bytes_of_a_to_b(__m256i a, __m256i b) {
+    return _mm256_alignr_epi8(b, _mm256_permute2x128_si256(a, b, 0x21), 13);
+}
+
+[[gnu::target("avx2")]] static partial_validation_results
+validate_partial_impl(const uint8_t *data, size_t len) {
+    if (len >= 32) {
+        __m256i prev_input = _mm256_set1_epi8(0);
+        __m256i prev_first_len = _mm256_set1_epi8(0);
+
+        // Cached tables, same contents in both lanes
+        const __m256i first_len_tbl = _mm256_broadcastsi128_si256(_mm_load_si128((const __m128i *)s_first_len_tbl));
+        const __m256i first_range_tbl = _mm256_broadcastsi128_si256(_mm_load_si128((const __m128i *)s_first_range_tbl));
+        const __m256i range_min_tbl = _mm256_broadcastsi128_si256(_mm_load_si128((const __m128i *)s_range_min_tbl));
+        const __m256i range_max_tbl = _mm256_broadcastsi128_si256(_mm_load_si128((const __m128i *)s_range_max_tbl));
+        const __m256i df_ee_tbl = _mm256_broadcastsi128_si256(_mm_load_si128((const __m128i *)s_df_ee_tbl));
+        const __m256i ef_fe_tbl = _mm256_broadcastsi128_si256(_mm_load_si128((const __m128i *)s_ef_fe_tbl));
+
+        __m256i error = _mm256_set1_epi8(0);
+
+        while (len >= 32) {
+            const __m256i input = _mm256_lddqu_si256((const __m256i *)data);
+
+            // high_nibbles = input >> 4
+            const __m256i high_nibbles =
+                _mm256_and_si256(_mm256_srli_epi16(input, 4), _mm256_set1_epi8(0x0F));
+
+            // first_len = legal character length minus 1
+            __m256i first_len = _mm256_shuffle_epi8(first_len_tbl, high_nibbles);
+
+            // First Byte: set range index to 8 for bytes within 0xC0 ~ 0xFF
+            __m256i range = _mm256_shuffle_epi8(first_range_tbl, high_nibbles);
+
+            // Second Byte: set range index to first_len
+            range = _mm256_or_si256(
+                    range, push_last_byte_of_a_to_b(prev_first_len, first_len));
+
+            // Third Byte: set range index to saturate_sub(first_len, 1)
+            __m256i tmp1, tmp2;
+            tmp1 = _mm256_subs_epu8(first_len, _mm256_set1_epi8(1));
+            tmp2 = _mm256_subs_epu8(prev_first_len, _mm256_set1_epi8(1));
+            range = _mm256_or_si256(range, push_last_2bytes_of_a_to_b(tmp2, tmp1));
+
+            // Fourth Byte: set range index to saturate_sub(first_len, 2)
+            tmp1 = _mm256_subs_epu8(first_len, _mm256_set1_epi8(2));
+            tmp2 = _mm256_subs_epu8(prev_first_len, _mm256_set1_epi8(2));
+            range = _mm256_or_si256(range, push_last_3bytes_of_a_to_b(tmp2, tmp1));
+
+            // Adjust Second Byte range for special First Bytes(E0,ED,F0,F4),
+            // see the table comments above
+            __m256i shift1, pos, range2;
+            shift1 = push_last_byte_of_a_to_b(prev_input, input);
+            pos = _mm256_sub_epi8(shift1, _mm256_set1_epi8(0xEF));
+            tmp1 = _mm256_subs_epu8(pos, _mm256_set1_epi8(char(240)));
+            range2 = _mm256_shuffle_epi8(df_ee_tbl, tmp1);
+            tmp2 = _mm256_adds_epu8(pos, _mm256_set1_epi8(112));
+            range2 = _mm256_add_epi8(range2, _mm256_shuffle_epi8(ef_fe_tbl, tmp2));
+
+            range = _mm256_add_epi8(range, range2);
+
+            // Load min and max values per calculated range index
+            __m256i minv = _mm256_shuffle_epi8(range_min_tbl, range);
+            __m256i maxv = _mm256_shuffle_epi8(range_max_tbl, range);
+
+            // Check value range
+            error = _mm256_or_si256(error, _mm256_cmpgt_epi8(minv, input));
+            error = _mm256_or_si256(error, _mm256_cmpgt_epi8(input, maxv));
+
+            prev_input = input;
+            prev_first_len = first_len;
+
+            data += 32;
+            len -= 32;
+        }
+
+        if (!_mm256_testz_si256(error, error)) {
+            return partial_validation_results{.error = true};
+        }
+
+        // Find previous token (not 80~BF)
+        int32_t token4 = _mm256_extract_epi32(prev_input, 7);
+        const int8_t *token = (const int8_t *)&token4;
+        int lookahead = 0;
+        if (token[3] > (int8_t)0xBF) {
+            lookahead = 1;
+        } else if (token[2] > (int8_t)0xBF) {
+            lookahead = 2;
+        } else if (token[1] > (int8_t)0xBF) {
+            lookahead = 3;
+        }
+        data -= lookahead;
+        len += lookahead;
+    }
+
+    // Continue with remaining bytes with naive method
+    return validate_partial_naive(data, len);
+}
+
+partial_validation_results
+internal::validate_partial(const uint8_t *data, size_t len) {
+    return validate_partial_impl(data, len);
+}
+
 } // namespace utf8
 
 } // namespace utils
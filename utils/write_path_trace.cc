@@ -0,0 +1,67 @@
+/*
+ * Copyright (C) 2021-present ScyllaDB
+ */
+
+/*
+ * This file is part of Scylla.
+ *
+ * Scylla is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Scylla is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Scylla.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "utils/write_path_trace.hh"
+
+#include <seastar/core/metrics.hh>
+
+namespace utils {
+
+static const std::array<sstring, write_path_tracer::num_stages> stage_names = {
+    "parse", "route", "replica_send", "commitlog_sync", "memtable_apply", "ack",
+};
+
+write_path_tracer::write_path_tracer() {
+    namespace sm = seastar::metrics;
+    static auto stage_label = sm::label("stage");
+    std::vector<sm::metric_definition> defs;
+    for (unsigned i = 0; i < num_stages; ++i) {
+        auto& h = _stage_hist[i];
+        // 128 buckets cover roughly 1ns to 37s.
+        h = estimated_histogram(128);
+        defs.emplace_back(sm::make_histogram("write_stage_latency",
+                sm::description("Latency of one write-path stage over sampled writes, in nanoseconds"),
+                {stage_label(stage_names[i])},
+                [&h] { return h.get_histogram(1024, 20); }));
+    }
+    _metrics.add_group("write_trace", std::move(defs));
+}
+
+void write_path_tracer::end(const slot& s) noexcept {
+    if (!s) {
+        return;
+    }
+    auto prev = s.start;
+    for (unsigned i = 0; i < num_stages; ++i) {
+        auto ts = s.stage_ts[i];
+        if (ts) {
+            _stage_hist[i].add(ts - prev);
+            prev = ts;
+        }
+    }
+}
+
+write_path_tracer& get_local_write_path_tracer() {
+    static thread_local write_path_tracer the_tracer;
+    return the_tracer;
+}
+
+}
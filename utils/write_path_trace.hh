@@ -0,0 +1,110 @@
+/*
+ * Copyright (C) 2021-present ScyllaDB
+ */
+
+/*
+ * This file is part of Scylla.
+ *
+ * Scylla is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Scylla is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Scylla.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <seastar/core/cacheline.hh>
+#include <seastar/core/metrics_registration.hh>
+
+#include "seastarx.hh"
+#include "utils/estimated_histogram.hh"
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+
+namespace utils {
+
+// Lightweight write-path stage tracing.
+//
+// Unlike full tracing (tracing/tracing.hh), which formats a string per
+// event, a sampled write gets one cacheline-sized slot of raw nanosecond
+// timestamps, one per pipeline stage, folded into per-stage latency
+// histograms when the request completes. A sampled request costs a few
+// clock reads; an unsampled one costs a counter increment. Coordinator-side
+// stages (parse, route, replica_send, ack) and replica-side stages
+// (commitlog_sync, memtable_apply) are recorded by separate slots, since
+// for most writes they run on different nodes.
+class write_path_tracer {
+public:
+    enum class stage : uint8_t {
+        parse,          // CQL text to AST
+        route,          // replica selection and response handler setup
+        replica_send,   // dispatching the mutation to live endpoints
+        commitlog_sync, // commitlog add_entry (replica side)
+        memtable_apply, // memtable apply (replica side)
+        ack,            // waiting for enough replica responses
+    };
+    static constexpr unsigned num_stages = 6;
+
+    // Timestamps of one sampled request, in nanoseconds on the steady
+    // clock. An inactive slot (start == 0) makes mark() and end() no-ops.
+    struct alignas(seastar::cache_line_size) slot {
+        int64_t start = 0;
+        std::array<int64_t, num_stages> stage_ts = {};
+
+        explicit operator bool() const noexcept { return start != 0; }
+
+        void mark(stage s) noexcept {
+            if (start) {
+                stage_ts[unsigned(s)] = now_ns();
+            }
+        }
+
+        static int64_t now_ns() noexcept {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now().time_since_epoch()).count();
+        }
+    };
+
+private:
+    unsigned _sample_rate = 0; // sample one in N requests; 0 disables
+    uint64_t _requests = 0;
+    std::array<estimated_histogram, num_stages> _stage_hist;
+    seastar::metrics::metric_groups _metrics;
+
+public:
+    write_path_tracer();
+
+    // Returns an active slot for one in every sample-rate requests.
+    slot begin() noexcept {
+        slot s;
+        if (_sample_rate && ++_requests % _sample_rate == 0) {
+            s.start = slot::now_ns();
+        }
+        return s;
+    }
+
+    // Folds the slot into the per-stage histograms. Each marked stage is
+    // charged the time since the previously marked stage, or since start.
+    void end(const slot& s) noexcept;
+
+    void set_sample_rate(unsigned one_in_n) noexcept { _sample_rate = one_in_n; }
+
+    const estimated_histogram& stage_histogram(stage s) const {
+        return _stage_hist[unsigned(s)];
+    }
+};
+
+// The tracer of the calling shard.
+write_path_tracer& get_local_write_path_tracer();
+
+}
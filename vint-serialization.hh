@@ -47,12 +47,48 @@
 
 #include "bytes.hh"
 
+#include <seastar/core/bitops.hh>
+#include <seastar/core/byteorder.hh>
+
+#include <algorithm>
 #include <cstdint>
+#include <limits>
 
 using vint_size_type = bytes::size_type;
 
 static constexpr size_t max_vint_length = 9;
 
+namespace vint_impl {
+
+// Accounts for the case that all bits are zero.
+inline vint_size_type count_leading_zero_bits(uint64_t n) noexcept {
+    if (n == 0) {
+        return vint_size_type(std::numeric_limits<uint64_t>::digits);
+    }
+
+    return vint_size_type(count_leading_zeros(n));
+}
+
+// The number of additional bytes that we need to read.
+inline vint_size_type count_extra_bytes(int8_t first_byte) noexcept {
+    // Sign extension.
+    const int64_t v(first_byte);
+
+    return count_leading_zero_bits(static_cast<uint64_t>(~v)) - vint_size_type(64 - 8);
+}
+
+// Mask for extracting from the first byte the part that is not used for indicating the total number of bytes.
+inline uint64_t first_byte_value_mask(vint_size_type extra_bytes_size) noexcept {
+    // Include the sentinel zero bit in the mask.
+    return uint64_t(0xff) >> extra_bytes_size;
+}
+
+inline constexpr int64_t decode_zigzag(uint64_t n) noexcept {
+    return static_cast<int64_t>((n >> 1) ^ -(n & 1));
+}
+
+}
+
 struct unsigned_vint final {
     using value_type = uint64_t;
 
@@ -76,3 +112,60 @@ struct signed_vint final {
 
     static vint_size_type serialized_size_from_first_byte(bytes::value_type first_byte);
 };
+
+//
+// The deserialization path is defined inline: the sstables row parser calls
+// it for every timestamp, ttl and length field, and an out-of-line call per
+// field is a measurable fraction of cold-read parsing CPU.
+//
+
+inline uint64_t unsigned_vint::deserialize(bytes_view v) {
+    auto src = v.data();
+    auto len = v.size();
+    const int8_t first_byte = *src;
+
+    // No additional bytes, since the most significant bit is not set.
+    if (first_byte >= 0) {
+        return uint64_t(first_byte);
+    }
+
+    const auto extra_bytes_size = vint_impl::count_extra_bytes(first_byte);
+
+    // Extract the bits not used for counting bytes.
+    auto result = uint64_t(first_byte) & vint_impl::first_byte_value_mask(extra_bytes_size);
+
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    uint64_t value;
+    // If we can overread do that. It is cheaper to have a single 64-bit read and
+    // then mask out the unneeded part than to do 8x 1 byte reads.
+    if (__builtin_expect(len >= sizeof(uint64_t) + 1, true)) {
+        std::copy_n(src + 1, sizeof(uint64_t), reinterpret_cast<int8_t*>(&value));
+    } else {
+        value = 0;
+        std::copy_n(src + 1, extra_bytes_size, reinterpret_cast<int8_t*>(&value));
+    }
+    value = be_to_cpu(value << (64 - (extra_bytes_size * 8)));
+    result <<= (extra_bytes_size * 8) % 64;
+    result |= value;
+#else
+    for (vint_size_type index = 0; index < extra_bytes_size; ++index) {
+        result <<= 8;
+        result |= (uint64_t(v[index + 1]) & uint64_t(0xff));
+    }
+#endif
+    return result;
+}
+
+inline vint_size_type unsigned_vint::serialized_size_from_first_byte(bytes::value_type first_byte) {
+    int8_t first_byte_casted = first_byte;
+    return 1 + (first_byte_casted >= 0 ? 0 : vint_impl::count_extra_bytes(first_byte_casted));
+}
+
+inline int64_t signed_vint::deserialize(bytes_view v) {
+    const auto un = unsigned_vint::deserialize(v);
+    return vint_impl::decode_zigzag(un);
+}
+
+inline vint_size_type signed_vint::serialized_size_from_first_byte(bytes::value_type first_byte) {
+    return unsigned_vint::serialized_size_from_first_byte(first_byte);
+}
@@ -68,6 +68,28 @@ private:
     }
 };
 
+// Streaming XXH3-based hasher. Unlike xx_hasher, which is typically fed one
+// small field at a time, this one is meant to be fed whole serialized buffers:
+// XXH3's long-input path processes them with SIMD at close to memory
+// bandwidth instead of per-field dispatch speed. Produces different digests
+// than xx_hasher, so the two are not interchangeable on the wire.
+class xx3_hasher {
+    XXH3_state_t _state;
+
+public:
+    explicit xx3_hasher(uint64_t seed = 0) noexcept {
+        XXH3_64bits_reset_withSeed(&_state, seed);
+    }
+
+    void update(const char* ptr, size_t length) noexcept {
+        XXH3_64bits_update(&_state, ptr, length);
+    }
+
+    uint64_t finalize_uint64() noexcept {
+        return XXH3_64bits_digest(&_state);
+    }
+};
+
 // Used to specialize templates in order to fix a bug
 // in handling null values: #4567
 class legacy_xx_hasher_without_null_digest : public xx_hasher {
@@ -19,21 +19,62 @@
  * along with Scylla.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <algorithm>
+#include <cmath>
+#include <memory>
+
 #include <seastar/core/aligned_buffer.hh>
 
 // We need to use experimental features of the zstd library (to allocate compression/decompression context),
 // which are available only when the library is linked statically.
 #define ZSTD_STATIC_LINKING_ONLY
 #include "zstd.h"
+#include "zdict.h"
 
 #include "compress.hh"
+#include "utils/base64.hh"
 #include "utils/class_registrator.hh"
 
 static const sstring COMPRESSION_LEVEL = "compression_level";
+// Bounds of the compression level band used for backlog-driven auto-tuning
+// (see adjust_for_backlog()). When set to different values, compaction picks
+// a level within the band: the upper end while the compaction backlog is low,
+// sliding towards the lower (faster) end as the backlog grows. The selected
+// level is recorded in the output sstable's compression parameters.
+static const sstring COMPRESSION_LEVEL_MIN = "compression_level_min";
+static const sstring COMPRESSION_LEVEL_MAX = "compression_level_max";
+// A zstd dictionary trained on samples of the compressed data, base64-encoded.
+// Not meant to be set by the user; it is added by the write path when
+// dictionary training is enabled and read back from the sstable's
+// compression metadata on the decompression side.
+static const sstring DICTIONARY = "dictionary";
+// When "true", compaction trains a dictionary on samples of the input data
+// and compresses the output with it. Small chunks compress considerably
+// better against a dictionary, at no extra cost on the read path.
+static const sstring DICTIONARY_TRAINING = "dictionary_training";
 static const sstring COMPRESSOR_NAME = compressor::namespace_prefix + "ZstdCompressor";
 
 class zstd_processor : public compressor {
     int _compression_level = 3;
+    // Level band for backlog-driven auto-tuning; both default to
+    // _compression_level, which disables the tuning.
+    int _compression_level_min = 3;
+    int _compression_level_max = 3;
+    int _chunk_len;
+    bool _dictionary_training = false;
+    // Trained dictionary, when present. Kept around so that options() can
+    // report it and it gets persisted with the sstable.
+    bytes _dictionary;
+
+    struct cdict_deleter {
+        void operator()(ZSTD_CDict* d) const { ZSTD_freeCDict(d); }
+    };
+    struct ddict_deleter {
+        void operator()(ZSTD_DDict* d) const { ZSTD_freeDDict(d); }
+    };
+    // Digested forms of _dictionary, for compression and decompression respectively.
+    std::unique_ptr<ZSTD_CDict, cdict_deleter> _cdict;
+    std::unique_ptr<ZSTD_DDict, ddict_deleter> _ddict;
 
     // Manages memory for the compression context.
     std::unique_ptr<char[], free_deleter> _cctx_raw;
@@ -53,40 +94,68 @@ public:
                     size_t output_len) const override;
     size_t compress_max_size(size_t input_len) const override;
 
+    bool wants_dictionary_training() const override;
+    ptr_type train_dictionary(const std::vector<bytes>& samples) const override;
+    ptr_type adjust_for_backlog(float pressure) const override;
+
     std::set<sstring> option_names() const override;
     std::map<sstring, sstring> options() const override;
 };
 
 zstd_processor::zstd_processor(const opt_getter& opts)
     : compressor(COMPRESSOR_NAME) {
-    auto level = opts(COMPRESSION_LEVEL);
-    if (level) {
+    auto parse_level = [&] (const sstring& option, int fallback) {
+        auto level = opts(option);
+        if (!level) {
+            return fallback;
+        }
+        int value;
         try {
-            _compression_level = std::stoi(*level);
+            value = std::stoi(*level);
         } catch (const std::exception& e) {
             throw exceptions::syntax_exception(
-                format("Invalid integer value {} for {}", *level, COMPRESSION_LEVEL));
+                format("Invalid integer value {} for {}", *level, option));
         }
 
         auto min_level = ZSTD_minCLevel();
         auto max_level = ZSTD_maxCLevel();
-        if (min_level > _compression_level || _compression_level > max_level) {
+        if (min_level > value || value > max_level) {
             throw exceptions::configuration_exception(
-                format("{} must be between {} and {}, got {}", COMPRESSION_LEVEL, min_level, max_level, _compression_level));
+                format("{} must be between {} and {}, got {}", option, min_level, max_level, value));
         }
+        return value;
+    };
+    _compression_level = parse_level(COMPRESSION_LEVEL, _compression_level);
+    _compression_level_min = parse_level(COMPRESSION_LEVEL_MIN, _compression_level);
+    _compression_level_max = parse_level(COMPRESSION_LEVEL_MAX, _compression_level);
+    if (_compression_level_min > _compression_level_max) {
+        throw exceptions::configuration_exception(
+            format("{} ({}) must not be greater than {} ({})",
+                   COMPRESSION_LEVEL_MIN, _compression_level_min, COMPRESSION_LEVEL_MAX, _compression_level_max));
     }
 
     auto chunk_len_kb = opts(compression_parameters::CHUNK_LENGTH_KB);
     if (!chunk_len_kb) {
         chunk_len_kb = opts(compression_parameters::CHUNK_LENGTH_KB_ERR);
     }
-    auto chunk_len = chunk_len_kb
+    _chunk_len = chunk_len_kb
        // This parameter has already been validated.
        ? std::stoi(*chunk_len_kb) * 1024
        : compression_parameters::DEFAULT_CHUNK_LENGTH;
 
+    if (auto dict = opts(DICTIONARY)) {
+        _dictionary = base64_decode(*dict);
+        _cdict.reset(ZSTD_createCDict(_dictionary.data(), _dictionary.size(), _compression_level));
+        _ddict.reset(ZSTD_createDDict(_dictionary.data(), _dictionary.size()));
+        if (!_cdict || !_ddict) {
+            throw std::runtime_error("Unable to load ZSTD compression dictionary");
+        }
+    }
+
     // We assume that the uncompressed input length is always <= chunk_len.
-    auto cparams = ZSTD_getCParams(_compression_level, chunk_len, 0);
+    // The dictionary size is part of the estimate, as referencing a dictionary
+    // may select larger compression parameters than the chunk length alone.
+    auto cparams = ZSTD_getCParams(_compression_level, _chunk_len, _dictionary.size());
     auto cctx_size = ZSTD_estimateCCtxSize_usingCParams(cparams);
     // According to the ZSTD documentation, pointer to the context buffer must be 8-bytes aligned.
     _cctx_raw = allocate_aligned_buffer<char>(cctx_size, 8);
@@ -101,10 +170,20 @@ zstd_processor::zstd_processor(const opt_getter& opts)
     if (!_cctx) {
         throw std::runtime_error("Unable to initialize ZSTD decompression context");
     }
+
+    if (auto training = opts(DICTIONARY_TRAINING)) {
+        if (*training != "true" && *training != "false") {
+            throw exceptions::configuration_exception(
+                format("{} must be \"true\" or \"false\", got {}", DICTIONARY_TRAINING, *training));
+        }
+        _dictionary_training = *training == "true";
+    }
 }
 
 size_t zstd_processor::uncompress(const char* input, size_t input_len, char* output, size_t output_len) const {
-    auto ret = ZSTD_decompressDCtx(_dctx, output, output_len, input, input_len);
+    auto ret = _ddict
+        ? ZSTD_decompress_usingDDict(_dctx, output, output_len, input, input_len, _ddict.get())
+        : ZSTD_decompressDCtx(_dctx, output, output_len, input, input_len);
     if (ZSTD_isError(ret)) {
         throw std::runtime_error( format("ZSTD decompression failure: {}", ZSTD_getErrorName(ret)));
     }
@@ -113,7 +192,9 @@ size_t zstd_processor::uncompress(const char* input, size_t input_len, char* out
 
 
 size_t zstd_processor::compress(const char* input, size_t input_len, char* output, size_t output_len) const {
-    auto ret = ZSTD_compressCCtx(_cctx, output, output_len, input, input_len, _compression_level);
+    auto ret = _cdict
+        ? ZSTD_compress_usingCDict(_cctx, output, output_len, input, input_len, _cdict.get())
+        : ZSTD_compressCCtx(_cctx, output, output_len, input, input_len, _compression_level);
     if (ZSTD_isError(ret)) {
         throw std::runtime_error( format("ZSTD compression failure: {}", ZSTD_getErrorName(ret)));
     }
@@ -124,12 +205,94 @@ size_t zstd_processor::compress_max_size(size_t input_len) const {
     return ZSTD_compressBound(input_len);
 }
 
+bool zstd_processor::wants_dictionary_training() const {
+    return _dictionary_training;
+}
+
+compressor::ptr_type zstd_processor::train_dictionary(const std::vector<bytes>& samples) const {
+    // ZDICT works best when the training set is ~100x the dictionary size;
+    // with the sample budget used by the write path a 64 KiB dictionary is a
+    // good fit for chunk sizes in the 4-64 KiB range.
+    static constexpr size_t max_dict_size = 64 * 1024;
+
+    size_t total = 0;
+    for (auto& s : samples) {
+        total += s.size();
+    }
+    // Don't bother training a dictionary larger than the data it describes.
+    if (total < max_dict_size) {
+        return nullptr;
+    }
+
+    // ZDICT wants all samples in one contiguous buffer.
+    auto buf = std::make_unique<char[]>(total);
+    std::vector<size_t> sizes;
+    sizes.reserve(samples.size());
+    auto dst = buf.get();
+    for (auto& s : samples) {
+        dst = std::copy_n(reinterpret_cast<const char*>(s.data()), s.size(), dst);
+        sizes.push_back(s.size());
+    }
+
+    bytes dict(bytes::initialized_later(), max_dict_size);
+    auto len = ZDICT_trainFromBuffer(dict.data(), dict.size(), buf.get(), sizes.data(), unsigned(sizes.size()));
+    if (ZDICT_isError(len)) {
+        return nullptr;
+    }
+    dict.resize(len);
+
+    auto opts = options();
+    opts[DICTIONARY] = sstring(base64_encode(dict));
+    opts[compression_parameters::CHUNK_LENGTH_KB] = to_sstring(_chunk_len / 1024);
+    return ::make_shared<zstd_processor>([&opts] (const sstring& key) -> opt_string {
+        auto i = opts.find(key);
+        if (i == opts.end()) {
+            return std::nullopt;
+        }
+        return i->second;
+    });
+}
+
+compressor::ptr_type zstd_processor::adjust_for_backlog(float pressure) const {
+    if (_compression_level_min == _compression_level_max) {
+        return nullptr;
+    }
+    pressure = std::clamp(pressure, 0.f, 1.f);
+    // Idle -> best ratio at the top of the band; fully backlogged -> fastest.
+    auto level = _compression_level_max - int(std::lround(pressure * (_compression_level_max - _compression_level_min)));
+    if (level == _compression_level) {
+        return nullptr;
+    }
+
+    auto opts = options();
+    opts[COMPRESSION_LEVEL] = std::to_string(level);
+    opts[compression_parameters::CHUNK_LENGTH_KB] = to_sstring(_chunk_len / 1024);
+    return ::make_shared<zstd_processor>([&opts] (const sstring& key) -> opt_string {
+        auto i = opts.find(key);
+        if (i == opts.end()) {
+            return std::nullopt;
+        }
+        return i->second;
+    });
+}
+
 std::set<sstring> zstd_processor::option_names() const {
-    return {COMPRESSION_LEVEL};
+    return {COMPRESSION_LEVEL, COMPRESSION_LEVEL_MIN, COMPRESSION_LEVEL_MAX, DICTIONARY, DICTIONARY_TRAINING};
 }
 
 std::map<sstring, sstring> zstd_processor::options() const {
-    return {{COMPRESSION_LEVEL, std::to_string(_compression_level)}};
+    std::map<sstring, sstring> opts{{COMPRESSION_LEVEL, std::to_string(_compression_level)}};
+    if (_compression_level_min != _compression_level_max) {
+        opts.emplace(COMPRESSION_LEVEL_MIN, std::to_string(_compression_level_min));
+        opts.emplace(COMPRESSION_LEVEL_MAX, std::to_string(_compression_level_max));
+    }
+    if (_dictionary_training) {
+        opts.emplace(DICTIONARY_TRAINING, "true");
+    }
+    if (!_dictionary.empty()) {
+        opts.emplace(DICTIONARY, sstring(base64_encode(_dictionary)));
+    }
+    return opts;
 }
 
 static const class_registrator<compressor, zstd_processor, const compressor::opt_getter&>